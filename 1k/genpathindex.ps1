@@ -0,0 +1,32 @@
+# generate the resource index for FileUtils::loadResourceIndex
+# .\genpathindex.ps1 -s resDir -o indexFile
+param(
+    [Parameter(Mandatory=$true, ValueFromPipeline=$true)]
+    [string]$srcPath,
+    [Parameter(Mandatory=$true, ValueFromPipeline=$true)]
+    [string]$outputPath
+)
+
+if(!$srcPath -or !(Test-Path $srcPath -PathType Container)) {
+    throw "genpathindex.ps1: The source directory $srcPath not exist"
+}
+
+$srcPath = (Resolve-Path $srcPath).Path.TrimEnd('/', '\')
+$outputFull = [System.IO.Path]::GetFullPath($outputPath)
+
+# one path relative to the resource root per line, always '/' separated
+$lines = Get-ChildItem -Path $srcPath -Recurse -File -Force | Where-Object {
+    $_.FullName -ne $outputFull
+} | ForEach-Object {
+    $_.FullName.Substring($srcPath.Length + 1).Replace('\', '/')
+} | Sort-Object
+
+$outputDir = Split-Path $outputFull -Parent
+if (!(Test-Path $outputDir -PathType Container)) {
+    New-Item $outputDir -ItemType Directory 1>$null
+}
+
+$content = "# axmol resource index`n" + ($lines -join "`n") + "`n"
+[System.IO.File]::WriteAllText($outputFull, $content, [System.Text.UTF8Encoding]::new($false))
+
+Write-Host "genpathindex.ps1: $($lines.Count) files indexed to $outputFull"
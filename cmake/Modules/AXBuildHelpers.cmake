@@ -44,6 +44,30 @@ function(ax_sync_target_res ax_target)
     endif()
 endfunction()
 
+# generate the FileUtils resource index of FOLDER to OUTPUT after resources are synced
+function(ax_gen_resource_index ax_target)
+    set(oneValueArgs FOLDER OUTPUT SYNC_TARGET_ID)
+    cmake_parse_arguments(opt "" "${oneValueArgs}" "" ${ARGN})
+
+    if (NOT DEFINED opt_SYNC_TARGET_ID)
+        set(sync_target_name "SYNC_RESOURCE-${ax_target}")
+    else()
+        set(sync_target_name "SYNC_RESOURCE-${ax_target}-${opt_SYNC_TARGET_ID}")
+    endif()
+
+    if(NOT TARGET ${sync_target_name})
+        message(WARNING "SyncResource targe for ${ax_target} is not defined")
+        return()
+    endif()
+
+    get_filename_component(folder_abs ${opt_FOLDER} ABSOLUTE)
+    get_filename_component(output_abs ${opt_OUTPUT} ABSOLUTE)
+    add_custom_command(TARGET ${sync_target_name} POST_BUILD
+        COMMAND ${PWSH_PROG} ARGS ${_AX_ROOT}/1k/genpathindex.ps1
+            -s ${folder_abs} -o ${output_abs}
+    )
+endfunction()
+
 if (NOT COMMAND set_xcode_property)
     # This little macro lets you set any XCode specific property, from ios.toolchain.cmake
     function(set_xcode_property TARGET XCODE_PROPERTY XCODE_VALUE)
@@ -64,6 +64,7 @@ function(ax_link_cxx_prebuilt APP_NAME AX_ROOT_DIR AX_PREBUILT_DIR)
     ax_config_pred(${APP_NAME} AX_ENABLE_MEDIA)
     ax_config_pred(${APP_NAME} AX_ENABLE_AUDIO)
     ax_config_pred(${APP_NAME} AX_ENABLE_CONSOLE)
+    ax_config_pred(${APP_NAME} AX_ENABLE_NULL_DRIVER)
 
     if (AX_ISA_SIMD MATCHES "sse")
         target_compile_definitions(${APP_NAME} PRIVATE AX_USE_SSE=1)
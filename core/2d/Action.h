@@ -48,6 +48,34 @@ enum
  * @{
  */
 
+/** @struct ActionBatchTween
+ * @brief The start value, delta and easing of a simple interval action on one node property.
+ * Actions which can describe themselves this way are evaluated by the ActionManager in batches,
+ * together with all the other running actions on the same property, instead of being stepped one by one.
+ * @since axmol-2.2
+ */
+struct ActionBatchTween
+{
+    enum class Property : uint8_t
+    {
+        Position,    // setPosition3D, stacks with other position changes if AX_ENABLE_STACKABLE_ACTIONS
+        Scale,       // setScaleX/Y/Z
+        Rotation,    // setRotationSkewX/Y
+        Rotation3D,  // setRotation3D
+        Opacity,     // setOpacity, x only
+        Count
+    };
+
+    /** An easing function of the tweenfunc family, param is the rate or period of the parameterized ones. */
+    using EaseFunc = float (*)(float time, float param);
+
+    Property property = Property::Position;
+    Vec3 from;
+    Vec3 delta;
+    EaseFunc ease   = nullptr;  // linear if null
+    float easeParam = 0;
+};
+
 /**
  * @brief Base class for Action objects.
  */
@@ -118,6 +146,17 @@ public:
      * @param time A value between 0 and 1.
      */
     virtual void update(float time);
+
+    /** Describes the running action as a tween of a node property, called once it was started with its target.
+     * The ActionManager then evaluates it in a batch instead of calling step(), so only actions whose step()
+     * does nothing but apply the tween may return true.
+     *
+     * @param tween The tween to fill.
+     * @return False, if the action has to be stepped.
+     * @since axmol-2.2
+     */
+    virtual bool getBatchTween(ActionBatchTween& tween) const { return false; }
+
     /** Return certain target.
      *
      * @return A certain target.
@@ -179,6 +218,10 @@ protected:
     int _tag;
     /** The action flag field. To categorize action into certain groups.*/
     unsigned int _flags;
+    /** The slot of the action in the ActionManager batches, or -1 if it's stepped. */
+    int _batchIndex;
+
+    friend class ActionManager;
 
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(Action);
@@ -36,6 +36,8 @@ THE SOFTWARE.
 #include "2d/ActionEase.h"
 #include "2d/TweenFunction.h"
 
+#include <typeinfo>
+
 namespace ax
 {
 
@@ -102,6 +104,17 @@ ActionInterval* ActionEase::getInnerAction()
     return _inner;
 }
 
+bool ActionEase::getInnerBatchTween(ActionBatchTween& tween, ActionBatchTween::EaseFunc ease, float param) const
+{
+    // eases of eases are stepped
+    if (!_inner || !_inner->getBatchTween(tween) || tween.ease)
+        return false;
+
+    tween.ease      = ease;
+    tween.easeParam = param;
+    return true;
+}
+
 //
 // EaseRateAction
 //
@@ -136,23 +149,28 @@ bool EaseRateAction::initWithAction(ActionInterval* action, float rate)
 // NOTE: Converting these macros into Templates is desirable, but please see
 // issue #16159 [https://github.com/cocos2d/cocos2d-x/pull/16159] for further info
 //
-#define EASE_TEMPLATE_IMPL(CLASSNAME, TWEEN_FUNC, REVERSE_CLASSNAME)         \
-    CLASSNAME* CLASSNAME::create(ax::ActionInterval* action)            \
-    {                                                                        \
-        CLASSNAME* ease = new CLASSNAME();                                   \
-        if (ease->initWithAction(action))                                    \
-            ease->autorelease();                                             \
-        else                                                                 \
-            AX_SAFE_DELETE(ease);                                            \
-        return ease;                                                         \
-    }                                                                        \
-    CLASSNAME* CLASSNAME::clone() const                                      \
-    {                                                                        \
-        if (_inner)                                                          \
-            return CLASSNAME::create(_inner->clone());                       \
-        return nullptr;                                                      \
-    }                                                                        \
-    void CLASSNAME::update(float time) { _inner->update(TWEEN_FUNC(time)); } \
+#define EASE_TEMPLATE_IMPL(CLASSNAME, TWEEN_FUNC, REVERSE_CLASSNAME)                             \
+    CLASSNAME* CLASSNAME::create(ax::ActionInterval* action)                                     \
+    {                                                                                            \
+        CLASSNAME* ease = new CLASSNAME();                                                       \
+        if (ease->initWithAction(action))                                                        \
+            ease->autorelease();                                                                 \
+        else                                                                                     \
+            AX_SAFE_DELETE(ease);                                                                \
+        return ease;                                                                             \
+    }                                                                                            \
+    CLASSNAME* CLASSNAME::clone() const                                                          \
+    {                                                                                            \
+        if (_inner)                                                                              \
+            return CLASSNAME::create(_inner->clone());                                           \
+        return nullptr;                                                                          \
+    }                                                                                            \
+    void CLASSNAME::update(float time) { _inner->update(TWEEN_FUNC(time)); }                     \
+    bool CLASSNAME::getBatchTween(ActionBatchTween& tween) const                                 \
+    {                                                                                            \
+        return typeid(*this) == typeid(CLASSNAME) &&                                             \
+               getInnerBatchTween(tween, [](float time, float) { return TWEEN_FUNC(time); }, 0); \
+    }                                                                                            \
     ActionEase* CLASSNAME::reverse() const { return REVERSE_CLASSNAME::create(_inner->reverse()); }
 
 EASE_TEMPLATE_IMPL(EaseExponentialIn, tweenfunc::expoEaseIn, EaseExponentialOut);
@@ -187,23 +205,28 @@ EASE_TEMPLATE_IMPL(EaseCubicActionInOut, tweenfunc::cubicEaseInOut, EaseCubicAct
 // NOTE: Converting these macros into Templates is desirable, but please see
 // issue #16159 [https://github.com/cocos2d/cocos2d-x/pull/16159] for further info
 //
-#define EASERATE_TEMPLATE_IMPL(CLASSNAME, TWEEN_FUNC)                               \
-    CLASSNAME* CLASSNAME::create(ax::ActionInterval* action, float rate)       \
-    {                                                                               \
-        CLASSNAME* ease = new CLASSNAME();                                          \
-        if (ease->initWithAction(action, rate))                                     \
-            ease->autorelease();                                                    \
-        else                                                                        \
-            AX_SAFE_DELETE(ease);                                                   \
-        return ease;                                                                \
-    }                                                                               \
-    CLASSNAME* CLASSNAME::clone() const                                             \
-    {                                                                               \
-        if (_inner)                                                                 \
-            return CLASSNAME::create(_inner->clone(), _rate);                       \
-        return nullptr;                                                             \
-    }                                                                               \
-    void CLASSNAME::update(float time) { _inner->update(TWEEN_FUNC(time, _rate)); } \
+#define EASERATE_TEMPLATE_IMPL(CLASSNAME, TWEEN_FUNC)                                                             \
+    CLASSNAME* CLASSNAME::create(ax::ActionInterval* action, float rate)                                          \
+    {                                                                                                             \
+        CLASSNAME* ease = new CLASSNAME();                                                                        \
+        if (ease->initWithAction(action, rate))                                                                   \
+            ease->autorelease();                                                                                  \
+        else                                                                                                      \
+            AX_SAFE_DELETE(ease);                                                                                 \
+        return ease;                                                                                              \
+    }                                                                                                             \
+    CLASSNAME* CLASSNAME::clone() const                                                                           \
+    {                                                                                                             \
+        if (_inner)                                                                                               \
+            return CLASSNAME::create(_inner->clone(), _rate);                                                     \
+        return nullptr;                                                                                           \
+    }                                                                                                             \
+    void CLASSNAME::update(float time) { _inner->update(TWEEN_FUNC(time, _rate)); }                               \
+    bool CLASSNAME::getBatchTween(ActionBatchTween& tween) const                                                  \
+    {                                                                                                             \
+        return typeid(*this) == typeid(CLASSNAME) &&                                                              \
+               getInnerBatchTween(tween, [](float time, float param) { return TWEEN_FUNC(time, param); }, _rate); \
+    }                                                                                                             \
     EaseRateAction* CLASSNAME::reverse() const { return CLASSNAME::create(_inner->reverse(), 1.f / _rate); }
 
 // NOTE: the original code used the same class for the `reverse()` method
@@ -230,23 +253,28 @@ bool EaseElastic::initWithAction(ActionInterval* action, float period /* = 0.3f*
 // NOTE: Converting these macros into Templates is desirable, but please see
 // issue #16159 [https://github.com/cocos2d/cocos2d-x/pull/16159] for further info
 //
-#define EASEELASTIC_TEMPLATE_IMPL(CLASSNAME, TWEEN_FUNC, REVERSE_CLASSNAME)                 \
-    CLASSNAME* CLASSNAME::create(ax::ActionInterval* action, float period /* = 0.3f*/) \
-    {                                                                                       \
-        CLASSNAME* ease = new CLASSNAME();                                                  \
-        if (ease->initWithAction(action, period))                                           \
-            ease->autorelease();                                                            \
-        else                                                                                \
-            AX_SAFE_DELETE(ease);                                                           \
-        return ease;                                                                        \
-    }                                                                                       \
-    CLASSNAME* CLASSNAME::clone() const                                                     \
-    {                                                                                       \
-        if (_inner)                                                                         \
-            return CLASSNAME::create(_inner->clone(), _period);                             \
-        return nullptr;                                                                     \
-    }                                                                                       \
-    void CLASSNAME::update(float time) { _inner->update(TWEEN_FUNC(time, _period)); }       \
+#define EASEELASTIC_TEMPLATE_IMPL(CLASSNAME, TWEEN_FUNC, REVERSE_CLASSNAME)                                         \
+    CLASSNAME* CLASSNAME::create(ax::ActionInterval* action, float period /* = 0.3f*/)                              \
+    {                                                                                                               \
+        CLASSNAME* ease = new CLASSNAME();                                                                          \
+        if (ease->initWithAction(action, period))                                                                   \
+            ease->autorelease();                                                                                    \
+        else                                                                                                        \
+            AX_SAFE_DELETE(ease);                                                                                   \
+        return ease;                                                                                                \
+    }                                                                                                               \
+    CLASSNAME* CLASSNAME::clone() const                                                                             \
+    {                                                                                                               \
+        if (_inner)                                                                                                 \
+            return CLASSNAME::create(_inner->clone(), _period);                                                     \
+        return nullptr;                                                                                             \
+    }                                                                                                               \
+    void CLASSNAME::update(float time) { _inner->update(TWEEN_FUNC(time, _period)); }                               \
+    bool CLASSNAME::getBatchTween(ActionBatchTween& tween) const                                                    \
+    {                                                                                                               \
+        return typeid(*this) == typeid(CLASSNAME) &&                                                                \
+               getInnerBatchTween(tween, [](float time, float param) { return TWEEN_FUNC(time, param); }, _period); \
+    }                                                                                                               \
     EaseElastic* CLASSNAME::reverse() const { return REVERSE_CLASSNAME::create(_inner->reverse(), _period); }
 
 EASEELASTIC_TEMPLATE_IMPL(EaseElasticIn, tweenfunc::elasticEaseIn, EaseElasticOut);
@@ -73,6 +73,9 @@ public:
     bool initWithAction(ActionInterval* action);
 
 protected:
+    /** Describes the inner action eased by ease, if it can be batched and isn't eased already. */
+    bool getInnerBatchTween(ActionBatchTween& tween, ActionBatchTween::EaseFunc ease, float param) const;
+
     /** The inner action */
     ActionInterval* _inner;
 
@@ -122,21 +125,22 @@ private:
 // NOTE: Converting these macros into Templates is desirable, but please see
 // issue #16159 [https://github.com/cocos2d/cocos2d-x/pull/16159] for further info
 //
-#define EASE_TEMPLATE_DECL_CLASS(CLASSNAME)               \
-    class AX_DLL CLASSNAME : public ActionEase            \
-    {                                                     \
-    public:                                               \
-        virtual ~CLASSNAME() {}                           \
-        CLASSNAME() {}                                    \
-                                                          \
-    public:                                               \
-        static CLASSNAME* create(ActionInterval* action); \
-        virtual CLASSNAME* clone() const override;        \
-        virtual void update(float time) override;         \
-        virtual ActionEase* reverse() const override;     \
-                                                          \
-    private:                                              \
-        AX_DISALLOW_COPY_AND_ASSIGN(CLASSNAME);           \
+#define EASE_TEMPLATE_DECL_CLASS(CLASSNAME)                                 \
+    class AX_DLL CLASSNAME : public ActionEase                              \
+    {                                                                       \
+    public:                                                                 \
+        virtual ~CLASSNAME() {}                                             \
+        CLASSNAME() {}                                                      \
+                                                                            \
+    public:                                                                 \
+        static CLASSNAME* create(ActionInterval* action);                   \
+        virtual CLASSNAME* clone() const override;                          \
+        virtual void update(float time) override;                           \
+        virtual bool getBatchTween(ActionBatchTween& tween) const override; \
+        virtual ActionEase* reverse() const override;                       \
+                                                                            \
+    private:                                                                \
+        AX_DISALLOW_COPY_AND_ASSIGN(CLASSNAME);                             \
     };
 
 /**
@@ -374,20 +378,21 @@ EASE_TEMPLATE_DECL_CLASS(EaseCubicActionInOut);
 // issue #16159 [https://github.com/cocos2d/cocos2d-x/pull/16159] for further info
 //
 
-#define EASERATE_TEMPLATE_DECL_CLASS(CLASSNAME)                       \
-    class AX_DLL CLASSNAME : public EaseRateAction                    \
-    {                                                                 \
-    public:                                                           \
-        virtual ~CLASSNAME() {}                                       \
-        CLASSNAME() {}                                                \
-                                                                      \
-        static CLASSNAME* create(ActionInterval* action, float rate); \
-        virtual CLASSNAME* clone() const override;                    \
-        virtual void update(float time) override;                     \
-        virtual EaseRateAction* reverse() const override;             \
-                                                                      \
-    private:                                                          \
-        AX_DISALLOW_COPY_AND_ASSIGN(CLASSNAME);                       \
+#define EASERATE_TEMPLATE_DECL_CLASS(CLASSNAME)                             \
+    class AX_DLL CLASSNAME : public EaseRateAction                          \
+    {                                                                       \
+    public:                                                                 \
+        virtual ~CLASSNAME() {}                                             \
+        CLASSNAME() {}                                                      \
+                                                                            \
+        static CLASSNAME* create(ActionInterval* action, float rate);       \
+        virtual CLASSNAME* clone() const override;                          \
+        virtual void update(float time) override;                           \
+        virtual bool getBatchTween(ActionBatchTween& tween) const override; \
+        virtual EaseRateAction* reverse() const override;                   \
+                                                                            \
+    private:                                                                \
+        AX_DISALLOW_COPY_AND_ASSIGN(CLASSNAME);                             \
     };
 
 /**
@@ -470,6 +475,7 @@ private:
         static CLASSNAME* create(ActionInterval* action, float rate = 0.3f); \
         virtual CLASSNAME* clone() const override;                           \
         virtual void update(float time) override;                            \
+        virtual bool getBatchTween(ActionBatchTween& tween) const override;  \
         virtual EaseElastic* reverse() const override;                       \
                                                                              \
     private:                                                                 \
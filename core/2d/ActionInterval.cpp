@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "2d/ActionInterval.h"
 
 #include <stdarg.h>
+#include <typeinfo>
 
 #include "2d/Sprite.h"
 #include "2d/Node.h"
@@ -952,6 +953,18 @@ void RotateTo::update(float time)
     }
 }
 
+bool RotateTo::getBatchTween(ActionBatchTween& tween) const
+{
+    // subclasses may update differently
+    if (typeid(*this) != typeid(RotateTo))
+        return false;
+
+    tween.property = _is3D ? ActionBatchTween::Property::Rotation3D : ActionBatchTween::Property::Rotation;
+    tween.from     = _startAngle;
+    tween.delta    = _diffAngle;
+    return true;
+}
+
 RotateTo* RotateTo::reverse() const
 {
     AXASSERT(false, "RotateTo doesn't support the 'reverse' method");
@@ -1097,6 +1110,17 @@ void RotateBy::update(float time)
     }
 }
 
+bool RotateBy::getBatchTween(ActionBatchTween& tween) const
+{
+    if (typeid(*this) != typeid(RotateBy))
+        return false;
+
+    tween.property = _is3D ? ActionBatchTween::Property::Rotation3D : ActionBatchTween::Property::Rotation;
+    tween.from     = _startAngle;
+    tween.delta    = _deltaAngle;
+    return true;
+}
+
 RotateBy* RotateBy::reverse() const
 {
     if (_is3D)
@@ -1189,6 +1213,17 @@ void MoveBy::update(float t)
     }
 }
 
+bool MoveBy::getBatchTween(ActionBatchTween& tween) const
+{
+    if (typeid(*this) != typeid(MoveBy) && typeid(*this) != typeid(MoveTo))
+        return false;
+
+    tween.property = ActionBatchTween::Property::Position;
+    tween.from     = _startPosition;
+    tween.delta    = _positionDelta;
+    return true;
+}
+
 //
 // MoveTo
 //
@@ -1920,6 +1955,17 @@ void ScaleTo::update(float time)
     }
 }
 
+bool ScaleTo::getBatchTween(ActionBatchTween& tween) const
+{
+    if (typeid(*this) != typeid(ScaleTo) && typeid(*this) != typeid(ScaleBy))
+        return false;
+
+    tween.property = ActionBatchTween::Property::Scale;
+    tween.from.set(_startScaleX, _startScaleY, _startScaleZ);
+    tween.delta.set(_deltaX, _deltaY, _deltaZ);
+    return true;
+}
+
 //
 // ScaleBy
 //
@@ -2205,6 +2251,17 @@ void FadeTo::update(float time)
     }
 }
 
+bool FadeTo::getBatchTween(ActionBatchTween& tween) const
+{
+    if (typeid(*this) != typeid(FadeTo) && typeid(*this) != typeid(FadeIn) && typeid(*this) != typeid(FadeOut))
+        return false;
+
+    tween.property = ActionBatchTween::Property::Opacity;
+    tween.from.x   = _fromOpacity;
+    tween.delta.x  = static_cast<float>(_toOpacity - _fromOpacity);
+    return true;
+}
+
 //
 // TintTo
 //
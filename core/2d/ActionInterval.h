@@ -119,6 +119,8 @@ protected:
     bool _firstTick;
     bool _done;
 
+    friend class ActionManager;
+
 protected:
     bool sendUpdateEventToScript(float dt, Action* actionObject);
 };
@@ -433,6 +435,7 @@ public:
      * @param time In seconds.
      */
     virtual void update(float time) override;
+    virtual bool getBatchTween(ActionBatchTween& tween) const override;
 
     RotateTo();
     virtual ~RotateTo() {}
@@ -508,6 +511,7 @@ public:
      * @param time In seconds.
      */
     virtual void update(float time) override;
+    virtual bool getBatchTween(ActionBatchTween& tween) const override;
 
     RotateBy();
     virtual ~RotateBy() {}
@@ -568,6 +572,7 @@ public:
      * @param time in seconds
      */
     virtual void update(float time) override;
+    virtual bool getBatchTween(ActionBatchTween& tween) const override;
 
     MoveBy() : _is3D(false) {}
     virtual ~MoveBy() {}
@@ -1034,6 +1039,7 @@ public:
      * @param time In seconds.
      */
     virtual void update(float time) override;
+    virtual bool getBatchTween(ActionBatchTween& tween) const override;
 
     ScaleTo() {}
     virtual ~ScaleTo() {}
@@ -1189,6 +1195,7 @@ public:
      * @param time In seconds.
      */
     virtual void update(float time) override;
+    virtual bool getBatchTween(ActionBatchTween& tween) const override;
 
     FadeTo() {}
     virtual ~FadeTo() {}
@@ -31,16 +31,143 @@ THE SOFTWARE.
 #include "2d/ActionManager.h"
 #include "2d/Node.h"
 #include "2d/Action.h"
+#include "2d/ActionInterval.h"
 #include "base/Scheduler.h"
 #include "base/Macros.h"
+#include "base/Tracing.h"
 
 namespace ax
 {
+
+namespace
+{
+constexpr int BATCH_PROPERTY_BITS = 3;
+constexpr int BATCH_PROPERTY_MASK = (1 << BATCH_PROPERTY_BITS) - 1;
+
+// elapsed += dt * speed, time = elapsed / duration clamped to [0, 1], as ActionInterval::step does
+void advanceBatch(float dt, size_t count, float* elapsed, const float* speeds, const float* durations, float* times)
+{
+    size_t i = 0;
+#if defined(AX_SSE_INTRINSICS)
+    const auto vdt  = _mm_set1_ps(dt);
+    const auto zero = _mm_setzero_ps();
+    const auto one  = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4)
+    {
+        auto e = _mm_add_ps(_mm_loadu_ps(elapsed + i), _mm_mul_ps(vdt, _mm_loadu_ps(speeds + i)));
+        _mm_storeu_ps(elapsed + i, e);
+        _mm_storeu_ps(times + i, _mm_max_ps(zero, _mm_min_ps(one, _mm_div_ps(e, _mm_loadu_ps(durations + i)))));
+    }
+#elif defined(AX_NEON_INTRINSICS) && AX_64BITS
+    const auto vdt  = vdupq_n_f32(dt);
+    const auto zero = vdupq_n_f32(0.0f);
+    const auto one  = vdupq_n_f32(1.0f);
+    for (; i + 4 <= count; i += 4)
+    {
+        auto e = vaddq_f32(vld1q_f32(elapsed + i), vmulq_f32(vdt, vld1q_f32(speeds + i)));
+        vst1q_f32(elapsed + i, e);
+        vst1q_f32(times + i, vmaxq_f32(zero, vminq_f32(one, vdivq_f32(e, vld1q_f32(durations + i)))));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        elapsed[i] += dt * speeds[i];
+        times[i] = std::max(0.0f, std::min(1.0f, elapsed[i] / durations[i]));
+    }
+}
+
+// values = from + deltas * times
+void lerpBatch(size_t count, const float* from, const float* deltas, const float* times, float* values)
+{
+    size_t i = 0;
+#if defined(AX_SSE_INTRINSICS)
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(values + i,
+                      _mm_add_ps(_mm_loadu_ps(from + i), _mm_mul_ps(_mm_loadu_ps(deltas + i), _mm_loadu_ps(times + i))));
+#elif defined(AX_NEON_INTRINSICS)
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(values + i, vaddq_f32(vld1q_f32(from + i), vmulq_f32(vld1q_f32(deltas + i), vld1q_f32(times + i))));
+#endif
+    for (; i < count; ++i)
+        values[i] = from[i] + deltas[i] * times[i];
+}
+
+// applies the entries which are neither removed nor paused, by index since apply may add or remove actions
+template <typename _Fn>
+void applyBatch(ActionBatch& batch, size_t count, _Fn&& apply)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (batch.actions[i] && !(batch.flags[i] & ActionBatch::PAUSED))
+            apply(batch.targets[i], i);
+    }
+}
+
+// moves the entries of the running actions to the front, in the order they were added, so that of two tweens of
+// the same property of a node the most recent one is still applied last, moved(action, index) updates their index
+template <typename _Fn>
+void compactBatch(ActionBatch& batch, _Fn&& moved)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < batch.actions.size(); ++i)
+    {
+        auto action = batch.actions[i];
+        if (!action)
+            continue;
+
+        if (count != i)
+        {
+            auto move = [i, count](auto& v) { v[count] = v[i]; };
+            move(batch.actions);
+            move(batch.targets);
+            move(batch.flags);
+            move(batch.elapsed);
+            move(batch.durations);
+            move(batch.speeds);
+            move(batch.times);
+            move(batch.eases);
+            move(batch.easeParams);
+            for (int c = 0; c < 3; ++c)
+            {
+                move(batch.from[c]);
+                move(batch.deltas[c]);
+                move(batch.values[c]);
+                move(batch.previous[c]);
+            }
+            moved(action, count);
+        }
+        ++count;
+    }
+
+    auto resize = [count](auto& v) { v.resize(count); };
+    resize(batch.actions);
+    resize(batch.targets);
+    resize(batch.flags);
+    resize(batch.elapsed);
+    resize(batch.durations);
+    resize(batch.speeds);
+    resize(batch.times);
+    resize(batch.eases);
+    resize(batch.easeParams);
+    for (int c = 0; c < 3; ++c)
+    {
+        resize(batch.from[c]);
+        resize(batch.deltas[c]);
+        resize(batch.values[c]);
+        resize(batch.previous[c]);
+    }
+}
+}  // namespace
 //
 // singleton stuff
 //
 
-ActionManager::ActionManager() : _currentTarget(nullptr), _currentTargetSalvaged(false) {}
+ActionManager::ActionManager()
+    : _currentTarget(nullptr)
+    , _currentTargetSalvaged(false)
+    , _batchingEnabled(true)
+    , _batchesDirty(false)
+{}
 
 ActionManager::~ActionManager()
 {
@@ -74,6 +201,12 @@ void ActionManager::removeActionAtIndex(ssize_t index,
         element.currentActionSalvaged = true;
     }
 
+    if (action->_batchIndex >= 0)
+    {
+        removeBatchedAction(action);
+        --element.batchedActions;
+    }
+
     element.actions.erase(index);
 
     // update actionIndex in case we are in tick. looping over the actions
@@ -102,6 +235,7 @@ void ActionManager::pauseTarget(Node* target)
     if (it != _targets.end())
     {
         it->second.paused = true;
+        pauseBatchedActions(it->second, true);
     }
 }
 
@@ -111,6 +245,7 @@ void ActionManager::resumeTarget(Node* target)
     if (it != _targets.end())
     {
         it->second.paused = false;
+        pauseBatchedActions(it->second, false);
     }
 }
 
@@ -121,6 +256,7 @@ Vector<Node*> ActionManager::pauseAllRunningActions()
     for (auto& [target, element] : _targets)
     {
         element.paused = true;
+        pauseBatchedActions(element, true);
         idsWithActions.pushBack(const_cast<Node*>(target));
     }
 
@@ -155,10 +291,25 @@ void ActionManager::addAction(Action* action, Node* target, bool paused)
     auto& actionHandle = actionIt->second;
     reserveActionCapacity(actionHandle);
 
+    // batched only while all the actions of the node are, the batches are applied before the stepped actions
+    const bool batchable = _batchingEnabled && actionHandle.batchedActions == actionHandle.actions.size();
+
     AXASSERT(!actionHandle.actions.contains(action), "action already be added!");
     actionHandle.actions.pushBack(action);
 
     action->startWithTarget(target);
+
+    ActionBatchTween tween;
+    if (batchable && action->getBatchTween(tween))
+    {
+        // zero durations are left to ActionInterval::step, which completes them in the first frame
+        auto duration = static_cast<ActionInterval*>(action)->getDuration();
+        if (duration > 0)
+        {
+            addBatchedAction(action, tween, actionHandle.paused, duration);
+            ++actionHandle.batchedActions;
+        }
+    }
 }
 
 // remove
@@ -191,6 +342,16 @@ void ActionManager::removeTargetActionHandle(std::unordered_map<Node*, ActionHan
         element.currentActionSalvaged = true;
     }
 
+    if (element.batchedActions)
+    {
+        for (auto action : element.actions)
+        {
+            if (action->_batchIndex >= 0)
+                removeBatchedAction(action);
+        }
+        element.batchedActions = 0;
+    }
+
     element.actions.clear();
     if (_currentTarget == &element)
     {
@@ -205,6 +366,16 @@ void ActionManager::removeTargetActionHandle(std::unordered_map<Node*, ActionHan
 
 void ActionManager::eraseTargetActionHandle(std::unordered_map<Node*, ActionHandle>::iterator& actionIt)
 {
+    auto& element = actionIt->second;
+    if (element.batchedActions)
+    {
+        for (auto action : element.actions)
+        {
+            if (action->_batchIndex >= 0)
+                removeBatchedAction(action);
+        }
+    }
+
     actionIt->first->release();
     actionIt = _targets.erase(actionIt);
 }
@@ -392,25 +563,31 @@ ssize_t ActionManager::getNumberOfRunningActions() const
 // main loop
 void ActionManager::update(float dt)
 {
+    AX_TRACE_ZONE("ActionManager::update");
+
+    // the batched actions of a node were all added before its stepped ones, so they are applied first
+    updateBatches(dt);
+
     for (auto actionIt = _targets.begin(); actionIt != _targets.end();)
     {
         auto elt               = &actionIt->second;
         _currentTarget         = elt;
         _currentTargetSalvaged = false;
 
-        if (!_currentTarget->paused)
+        if (!_currentTarget->paused && _currentTarget->batchedActions < _currentTarget->actions.size())
         {
             // The 'actions' MutableArray may change while inside this loop.
             for (_currentTarget->actionIndex = 0; _currentTarget->actionIndex < _currentTarget->actions.size();
                  _currentTarget->actionIndex++)
             {
-                _currentTarget->currentAction =
-                    static_cast<Action*>(_currentTarget->actions[_currentTarget->actionIndex]);
-                if (_currentTarget->currentAction == nullptr)
+                auto action = static_cast<Action*>(_currentTarget->actions[_currentTarget->actionIndex]);
+                if (action == nullptr || action->_batchIndex >= 0)
                 {
                     continue;
                 }
 
+                _currentTarget->currentAction = action;
+
                 _currentTarget->currentActionSalvaged = false;
 
                 _currentTarget->currentAction->step(dt);
@@ -454,4 +631,209 @@ void ActionManager::update(float dt)
     _currentTarget = nullptr;
 }
 
+// batches
+
+void ActionManager::addBatchedAction(Action* action, const ActionBatchTween& tween, bool paused, float duration)
+{
+    const auto property = static_cast<int>(tween.property);
+    auto& batch         = _batches[property];
+
+    action->_batchIndex = static_cast<int>(batch.actions.size() << BATCH_PROPERTY_BITS) | property;
+
+    batch.actions.push_back(action);
+    batch.targets.push_back(action->getTarget());
+    batch.flags.push_back(paused ? ActionBatch::PAUSED : 0);
+    batch.elapsed.push_back(0.0f);
+    batch.durations.push_back(duration);
+    batch.speeds.push_back(0.0f);
+    batch.times.push_back(0.0f);
+    batch.eases.push_back(tween.ease);
+    batch.easeParams.push_back(tween.easeParam);
+
+    const float from[]   = {tween.from.x, tween.from.y, tween.from.z};
+    const float deltas[] = {tween.delta.x, tween.delta.y, tween.delta.z};
+    for (int c = 0; c < 3; ++c)
+    {
+        batch.from[c].push_back(from[c]);
+        batch.deltas[c].push_back(deltas[c]);
+        batch.values[c].push_back(from[c]);
+        batch.previous[c].push_back(from[c]);
+    }
+}
+
+void ActionManager::removeBatchedAction(Action* action)
+{
+    const auto property = action->_batchIndex & BATCH_PROPERTY_MASK;
+    const auto index    = static_cast<size_t>(action->_batchIndex >> BATCH_PROPERTY_BITS);
+    action->_batchIndex = -1;
+
+    // compacted once per frame, keeping the order of the other entries
+    _batches[property].actions[index] = nullptr;
+    _batchesDirty                     = true;
+}
+
+void ActionManager::pauseBatchedActions(ActionHandle& element, bool paused)
+{
+    if (!element.batchedActions)
+        return;
+
+    for (auto action : element.actions)
+    {
+        if (action->_batchIndex < 0)
+            continue;
+
+        auto& batch = _batches[action->_batchIndex & BATCH_PROPERTY_MASK];
+        auto index  = static_cast<size_t>(action->_batchIndex >> BATCH_PROPERTY_BITS);
+        if (paused)
+        {
+            batch.flags[index] |= ActionBatch::PAUSED;
+            batch.speeds[index] = 0.0f;
+        }
+        else
+        {
+            batch.flags[index] &= ~ActionBatch::PAUSED;
+            batch.speeds[index] = (batch.flags[index] & ActionBatch::STARTED) ? 1.0f : 0.0f;
+        }
+    }
+}
+
+void ActionManager::compactBatches()
+{
+    _batchesDirty = false;
+    for (int property = 0; property < (int)ActionBatchTween::Property::Count; ++property)
+    {
+        compactBatch(_batches[property], [property](Action* action, size_t index) {
+            action->_batchIndex = static_cast<int>(index << BATCH_PROPERTY_BITS) | property;
+        });
+    }
+}
+
+void ActionManager::updateBatches(float dt)
+{
+    AX_TRACE_ZONE("ActionManager::updateBatches");
+
+    using Property = ActionBatchTween::Property;
+    if (_batchesDirty)
+        compactBatches();
+
+    for (int property = 0; property < (int)Property::Count; ++property)
+    {
+        auto& batch      = _batches[property];
+        const auto count = batch.actions.size();
+        if (!count)
+            continue;
+
+        auto times = batch.times.data();
+        advanceBatch(dt, count, batch.elapsed.data(), batch.speeds.data(), batch.durations.data(), times);
+
+        auto eases      = batch.eases.data();
+        auto easeParams = batch.easeParams.data();
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (eases[i])
+                times[i] = eases[i](times[i], easeParams[i]);
+        }
+
+        // keep the actions in sync for getElapsed()
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!batch.actions[i] || (batch.flags[i] & ActionBatch::PAUSED))
+                continue;
+
+            batch.flags[i] |= ActionBatch::STARTED;
+            batch.speeds[i] = 1.0f;
+
+            auto interval        = static_cast<ActionInterval*>(batch.actions[i]);
+            interval->_firstTick = false;
+            interval->_elapsed   = batch.elapsed[i];
+        }
+
+        switch (static_cast<Property>(property))
+        {
+        case Property::Position:
+#if AX_ENABLE_STACKABLE_ACTIONS
+            // the same stacking as MoveBy::update, the start follows position changes made by others
+            applyBatch(batch, count, [&batch](Node* target, size_t i) {
+                Vec3 current = target->getPosition3D();
+                Vec3 start(batch.from[0][i], batch.from[1][i], batch.from[2][i]);
+                Vec3 previous(batch.previous[0][i], batch.previous[1][i], batch.previous[2][i]);
+                Vec3 delta(batch.deltas[0][i], batch.deltas[1][i], batch.deltas[2][i]);
+                start       = start + (current - previous);
+                Vec3 newPos = start + (delta * batch.times[i]);
+                target->setPosition3D(newPos);
+                for (int c = 0; c < 3; ++c)
+                {
+                    batch.from[c][i]     = (&start.x)[c];
+                    batch.previous[c][i] = (&newPos.x)[c];
+                }
+            });
+#else
+            for (int c = 0; c < 3; ++c)
+                lerpBatch(count, batch.from[c].data(), batch.deltas[c].data(), times, batch.values[c].data());
+            applyBatch(batch, count, [&batch](Node* target, size_t i) {
+                target->setPosition3D(Vec3(batch.values[0][i], batch.values[1][i], batch.values[2][i]));
+            });
+#endif  // AX_ENABLE_STACKABLE_ACTIONS
+            break;
+        case Property::Scale:
+            for (int c = 0; c < 3; ++c)
+                lerpBatch(count, batch.from[c].data(), batch.deltas[c].data(), times, batch.values[c].data());
+            applyBatch(batch, count, [&batch](Node* target, size_t i) {
+                target->setScaleX(batch.values[0][i]);
+                target->setScaleY(batch.values[1][i]);
+                target->setScaleZ(batch.values[2][i]);
+            });
+            break;
+        case Property::Rotation:
+            for (int c = 0; c < 2; ++c)
+                lerpBatch(count, batch.from[c].data(), batch.deltas[c].data(), times, batch.values[c].data());
+            applyBatch(batch, count, [&batch](Node* target, size_t i) {
+#if defined(AX_ENABLE_PHYSICS)
+                if (batch.from[0][i] == batch.from[1][i] && batch.deltas[0][i] == batch.deltas[1][i])
+                {
+                    target->setRotation(batch.values[0][i]);
+                    return;
+                }
+#endif  // defined(AX_ENABLE_PHYSICS)
+                target->setRotationSkewX(batch.values[0][i]);
+                target->setRotationSkewY(batch.values[1][i]);
+            });
+            break;
+        case Property::Rotation3D:
+            for (int c = 0; c < 3; ++c)
+                lerpBatch(count, batch.from[c].data(), batch.deltas[c].data(), times, batch.values[c].data());
+            applyBatch(batch, count, [&batch](Node* target, size_t i) {
+                target->setRotation3D(Vec3(batch.values[0][i], batch.values[1][i], batch.values[2][i]));
+            });
+            break;
+        case Property::Opacity:
+            lerpBatch(count, batch.from[0].data(), batch.deltas[0].data(), times, batch.values[0].data());
+            applyBatch(batch, count, [&batch](Node* target, size_t i) {
+                target->setOpacity(static_cast<uint8_t>(batch.values[0][i]));
+            });
+            break;
+        default:
+            break;
+        }
+    }
+
+    // finish the completed actions like the step loop does, removals are deferred until all batches are done
+    for (auto& batch : _batches)
+    {
+        for (size_t i = 0; i < batch.actions.size(); ++i)
+        {
+            auto action = batch.actions[i];
+            if (!action || (batch.flags[i] & ActionBatch::PAUSED) || batch.elapsed[i] < batch.durations[i])
+                continue;
+
+            static_cast<ActionInterval*>(action)->_done = true;
+            action->stop();
+            removeAction(action);
+        }
+    }
+
+    if (_batchesDirty)
+        compactBatches();
+}
+
 }
@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "2d/Action.h"
 #include "base/Vector.h"
 #include "base/Object.h"
+#include "base/axstd.h"
 
 namespace ax
 {
@@ -42,11 +43,39 @@ struct ActionHandle
 {
     Vector<Action*> actions;
     int actionIndex;
+    int batchedActions;  // how many of the actions are evaluated by the batches
     Action* currentAction;
     bool currentActionSalvaged;
     bool paused;
 };
 
+/** The running actions tweening one node property, stored as arrays per field so they can be evaluated
+ * in tight loops. The entries are in the order the actions were added, those of removed actions are nulled and
+ * compacted once per frame.
+ */
+struct ActionBatch
+{
+    enum Flags : uint8_t
+    {
+        STARTED = 1,
+        PAUSED  = 2,
+    };
+
+    axstd::pod_vector<Action*> actions;
+    axstd::pod_vector<Node*> targets;
+    axstd::pod_vector<uint8_t> flags;
+    axstd::pod_vector<float> elapsed;
+    axstd::pod_vector<float> durations;
+    axstd::pod_vector<float> speeds;  // 1 while elapsed advances, 0 before the first tick and while paused
+    axstd::pod_vector<float> times;   // eased time of the current frame
+    axstd::pod_vector<ActionBatchTween::EaseFunc> eases;
+    axstd::pod_vector<float> easeParams;
+    axstd::pod_vector<float> from[3];
+    axstd::pod_vector<float> deltas[3];
+    axstd::pod_vector<float> values[3];
+    axstd::pod_vector<float> previous[3];  // the position last set, to stack with other moves
+};
+
 /**
  * @addtogroup actions
  * @{
@@ -61,6 +90,11 @@ struct ActionHandle
     - When you want to run an action where the target is different from a Node.
     - When you want to pause / resume the actions.
 
+ Actions which describe themselves with Action::getBatchTween (MoveTo, ScaleTo, RotateTo, FadeTo and their By
+ variants, alone or in one ease action) are not stepped: they are kept in one ActionBatch per node property and
+ evaluated together before the other actions of the frame. An action is only batched while all the actions of its
+ node are, so the actions of a node are still applied in the order they were added.
+
  @since v0.8
  */
 class AX_DLL ActionManager : public Object
@@ -200,6 +234,12 @@ public:
      */
     virtual void update(float dt);
 
+    /** Enables evaluating the actions added from now on in batches when they support it, enabled by default.
+     * @since axmol-2.2
+     */
+    void setBatchingEnabled(bool enabled) { _batchingEnabled = enabled; }
+    bool isBatchingEnabled() const { return _batchingEnabled; }
+
 protected:
     // declared in ActionManager.m
     void removeTargetActionHandle(std::unordered_map<Node*, ActionHandle>::iterator& actionIt);
@@ -212,10 +252,20 @@ protected:
 
     void eraseTargetActionHandle(std::unordered_map<Node*, ActionHandle>::iterator& actionIt);
 
+    void addBatchedAction(Action* action, const ActionBatchTween& tween, bool paused, float duration);
+    void removeBatchedAction(Action* action);
+    void pauseBatchedActions(ActionHandle& element, bool paused);
+    void compactBatches();
+    void updateBatches(float dt);
+
 protected:
     std::unordered_map<Node*, ActionHandle> _targets;
     ActionHandle* _currentTarget;
     bool _currentTargetSalvaged;
+
+    ActionBatch _batches[(int)ActionBatchTween::Property::Count];
+    bool _batchingEnabled;
+    bool _batchesDirty;
 };
 
 // end of actions group
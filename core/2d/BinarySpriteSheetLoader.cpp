@@ -0,0 +1,661 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/BinarySpriteSheetLoader.h"
+
+#include "platform/FileUtils.h"
+#include "2d/AutoPolygon.h"
+#include "2d/SpriteFrameCache.h"
+#include "base/NinePatchImageParser.h"
+#include "base/NS.h"
+#include "base/Macros.h"
+#include "base/Director.h"
+#include "base/Utils.h"
+#include "renderer/Texture2D.h"
+#include "renderer/TextureCache.h"
+
+#include "mio/mio.hpp"
+
+#include <algorithm>
+#include <string.h>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ax
+{
+
+namespace
+{
+struct BinarySheetHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t frameCount;
+    uint32_t nameCount;
+    float textureWidth;  // of the polygon texture coordinates
+    float textureHeight;
+    uint32_t pixelFormat;  // backend::PixelFormat, NONE for the texture cache default
+    uint32_t textureName;  // offset in the strings
+    uint32_t textureNameLength;
+    uint32_t framesOffset;
+    uint32_t namesOffset;
+    uint32_t meshOffset;
+    uint32_t meshSize;
+    uint32_t stringsOffset;
+    uint32_t stringsSize;
+    uint32_t reserved2;
+};
+static_assert(sizeof(BinarySheetHeader) == 64, "BinarySheetHeader must not be padded");
+
+enum BinarySheetFrameFlags : uint32_t
+{
+    FRAME_ROTATED    = 1,
+    FRAME_ANCHOR     = 1 << 1,
+    FRAME_POLYGON    = 1 << 2,
+    FRAME_NINE_PATCH = 1 << 3,
+};
+
+struct BinarySheetFrame
+{
+    float rect[4];  // in pixels
+    float offset[2];
+    float sourceSize[2];
+    float anchor[2];  // FRAME_ANCHOR
+    uint32_t flags;
+    uint32_t mesh;         // index in the mesh integers of the vertices, followed by the uvs and the indices
+    uint32_t vertexCount;  // 2 per vertex, as SpriteSheetLoader::initializePolygonInfo takes them
+    uint32_t uvCount;
+    uint32_t indexCount;
+};
+static_assert(sizeof(BinarySheetFrame) == 60, "BinarySheetFrame must not be padded");
+
+struct BinarySheetName
+{
+    uint32_t offset;
+    uint32_t length;
+    uint32_t frame;
+};
+static_assert(sizeof(BinarySheetName) == 12, "BinarySheetName must not be padded");
+
+constexpr uint32_t BINARY_SHEET_MAGIC   = 0x46535841;  // "AXSF"
+constexpr uint16_t BINARY_SHEET_VERSION = 2;
+
+// same names as PlistSpriteSheetLoader
+constexpr std::pair<std::string_view, backend::PixelFormat> s_pixelFormats[] = {
+    {"RGBA8888"sv, backend::PixelFormat::RGBA8}, {"RGBA4444"sv, backend::PixelFormat::RGBA4},
+    {"RGB5A1"sv, backend::PixelFormat::RGB5A1},  {"RGBA5551"sv, backend::PixelFormat::RGB5A1},
+    {"RGB565"sv, backend::PixelFormat::RGB565},  {"R8"sv, backend::PixelFormat::R8},
+    {"RG8"sv, backend::PixelFormat::RG8},        {"RGB888"sv, backend::PixelFormat::RGB8},
+};
+
+/*
+ * The content of a sheet file, memory mapped unless the file isn't a plain one, i.e. inside the apk.
+ */
+class SheetFile
+{
+public:
+    bool open(std::string_view fullPath)
+    {
+        std::error_code error;
+        _mapping.map(std::string{fullPath}, error);
+        if (!error)
+            return true;
+
+        _content = FileUtils::getInstance()->getDataFromFile(fullPath);
+        return !_content.isNull();
+    }
+
+    const uint8_t* data() const
+    {
+        return _mapping.is_mapped() ? reinterpret_cast<const uint8_t*>(_mapping.data()) : _content.getBytes();
+    }
+    std::size_t size() const { return _mapping.is_mapped() ? _mapping.size() : static_cast<std::size_t>(_content.getSize()); }
+
+private:
+    mio::mmap_source _mapping;
+    Data _content;
+};
+}  // namespace
+
+/*
+ * A sheet whose ranges were all checked, so a truncated or foreign file is never read out of bounds.
+ */
+class BinarySpriteSheetView
+{
+public:
+    bool init(const uint8_t* data, std::size_t size)
+    {
+        if (!data || size < sizeof(BinarySheetHeader))
+            return false;
+        memcpy(&_header, data, sizeof(_header));
+        if (_header.magic != BINARY_SHEET_MAGIC || _header.version != BINARY_SHEET_VERSION)
+            return false;
+
+        auto inRange = [size](uint64_t offset, uint64_t length) {
+            return offset % 4 == 0 && offset + length <= size;
+        };
+        if (!inRange(_header.framesOffset, uint64_t{_header.frameCount} * sizeof(BinarySheetFrame)) ||
+            !inRange(_header.namesOffset, uint64_t{_header.nameCount} * sizeof(BinarySheetName)) ||
+            !inRange(_header.meshOffset, _header.meshSize) || !inRange(_header.stringsOffset, _header.stringsSize) ||
+            uint64_t{_header.textureName} + _header.textureNameLength > _header.stringsSize)
+            return false;
+
+        auto pixelFormat = static_cast<backend::PixelFormat>(_header.pixelFormat);
+        if (pixelFormat >= backend::PixelFormat::COUNT && pixelFormat != backend::PixelFormat::NONE)
+            return false;
+
+        _data = data;
+        for (uint32_t i = 0; i < _header.frameCount; ++i)
+        {
+            auto frame = getFrame(i);
+            if ((frame.flags & FRAME_POLYGON) &&
+                (uint64_t{frame.mesh} + frame.vertexCount + frame.uvCount + frame.indexCount) * sizeof(int32_t) >
+                    _header.meshSize)
+                return false;
+        }
+        for (uint32_t i = 0; i < _header.nameCount; ++i)
+        {
+            auto name = getName(i);
+            if (name.frame >= _header.frameCount || uint64_t{name.offset} + name.length > _header.stringsSize)
+                return false;
+        }
+        return true;
+    }
+
+    const BinarySheetHeader& getHeader() const { return _header; }
+
+    BinarySheetFrame getFrame(uint32_t index) const
+    {
+        BinarySheetFrame frame;
+        memcpy(&frame, _data + _header.framesOffset + index * sizeof(frame), sizeof(frame));
+        return frame;
+    }
+
+    BinarySheetName getName(uint32_t index) const
+    {
+        BinarySheetName name;
+        memcpy(&name, _data + _header.namesOffset + index * sizeof(name), sizeof(name));
+        return name;
+    }
+
+    std::string_view getString(uint32_t offset, uint32_t length) const
+    {
+        return {reinterpret_cast<const char*>(_data + _header.stringsOffset + offset), length};
+    }
+
+    std::vector<int> getMesh(uint32_t index, uint32_t count) const
+    {
+        std::vector<int> values(count);
+        if (count)
+            memcpy(values.data(), _data + _header.meshOffset + index * sizeof(int32_t), count * sizeof(int32_t));
+        return values;
+    }
+
+private:
+    const uint8_t* _data = nullptr;
+    BinarySheetHeader _header;
+};
+
+static bool openSheet(std::string_view fullPath, SheetFile& file, BinarySpriteSheetView& sheet)
+{
+    if (!file.open(fullPath))
+    {
+        AXLOGW("SpriteFrameCache: can not read {}", fullPath);
+        return false;
+    }
+    if (!sheet.init(file.data(), file.size()))
+    {
+        AXLOGW("SpriteFrameCache: {} is not a binary sprite sheet, or was written by another version", fullPath);
+        return false;
+    }
+    return true;
+}
+
+void BinarySpriteSheetLoader::load(std::string_view filePath, SpriteFrameCache& cache)
+{
+    AXASSERT(!filePath.empty(), "sprite sheet filename should not be empty");
+
+    const auto fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
+    if (fullPath.empty())
+    {
+        AXLOGW("SpriteFrameCache: can not find {}", filePath);
+        return;
+    }
+
+    SheetFile file;
+    BinarySpriteSheetView sheet;
+    if (openSheet(fullPath, file, sheet))
+        addSpriteFrames(sheet, getTexturePath(sheet, filePath), filePath, cache);
+}
+
+void BinarySpriteSheetLoader::load(std::string_view filePath, Texture2D* texture, SpriteFrameCache& cache)
+{
+    SheetFile file;
+    BinarySpriteSheetView sheet;
+    if (openSheet(FileUtils::getInstance()->fullPathForFilename(filePath), file, sheet))
+        addSpriteFrames(sheet, texture, filePath, cache);
+}
+
+void BinarySpriteSheetLoader::load(std::string_view filePath,
+                                   std::string_view textureFileName,
+                                   SpriteFrameCache& cache)
+{
+    AXASSERT(!textureFileName.empty(), "texture name should not be null");
+
+    SheetFile file;
+    BinarySpriteSheetView sheet;
+    if (openSheet(FileUtils::getInstance()->fullPathForFilename(filePath), file, sheet))
+        addSpriteFrames(sheet, textureFileName, filePath, cache);
+}
+
+void BinarySpriteSheetLoader::load(const Data& content, Texture2D* texture, SpriteFrameCache& cache)
+{
+    if (content.isNull())
+    {
+        return;
+    }
+
+    BinarySpriteSheetView sheet;
+    if (!sheet.init(content.getBytes(), static_cast<std::size_t>(content.getSize())))
+    {
+        AXLOGW("SpriteFrameCache: the content is not a binary sprite sheet");
+        return;
+    }
+    addSpriteFrames(sheet, texture, "by#addSpriteFramesWithFileContent()", cache);
+}
+
+void BinarySpriteSheetLoader::reload(std::string_view filePath, SpriteFrameCache& cache)
+{
+    SheetFile file;
+    BinarySpriteSheetView sheet;
+    if (!openSheet(FileUtils::getInstance()->fullPathForFilename(filePath), file, sheet))
+        return;
+
+    const auto texturePath = getTexturePath(sheet, filePath);
+
+    Texture2D* texture = nullptr;
+    if (Director::getInstance()->getTextureCache()->reloadTexture(texturePath))
+    {
+        texture = Director::getInstance()->getTextureCache()->getTextureForKey(texturePath);
+    }
+
+    if (texture)
+    {
+        reloadSpriteFrames(sheet, texture, filePath, cache);
+    }
+    else
+    {
+        AXLOGD("SpriteFrameCache: Couldn't load texture");
+    }
+}
+
+std::string BinarySpriteSheetLoader::getTexturePath(const BinarySpriteSheetView& sheet, std::string_view sheetPath)
+{
+    const auto& header     = sheet.getHeader();
+    const auto textureName = sheet.getString(header.textureName, header.textureNameLength);
+    if (!textureName.empty())
+    {
+        // build texture path relative to the sheet
+        return FileUtils::getInstance()->fullPathFromRelativeFile(textureName, sheetPath);
+    }
+
+    // build texture path by replacing file extension
+    std::string texturePath{sheetPath};
+    const auto startPos = texturePath.find_last_of('.');
+    if (startPos != std::string::npos)
+    {
+        texturePath.erase(startPos);
+    }
+    texturePath.append(".png");
+
+    AXLOGD("SpriteFrameCache: Trying to use file {} as texture", texturePath);
+    return texturePath;
+}
+
+SpriteFrame* BinarySpriteSheetLoader::createSpriteFrame(const BinarySpriteSheetView& sheet,
+                                                        uint32_t frameIndex,
+                                                        Texture2D* texture)
+{
+    const auto frame      = sheet.getFrame(frameIndex);
+    const Vec2 sourceSize = Vec2(frame.sourceSize[0], frame.sourceSize[1]);
+
+    auto spriteFrame = SpriteFrame::createWithTexture(
+        texture, Rect(frame.rect[0], frame.rect[1], frame.rect[2], frame.rect[3]), (frame.flags & FRAME_ROTATED) != 0,
+        Vec2(frame.offset[0], frame.offset[1]), sourceSize);
+
+    if (frame.flags & FRAME_POLYGON)
+    {
+        const auto& header = sheet.getHeader();
+        auto vertices      = sheet.getMesh(frame.mesh, frame.vertexCount);
+        auto verticesUV    = sheet.getMesh(frame.mesh + frame.vertexCount, frame.uvCount);
+        auto indices       = sheet.getMesh(frame.mesh + frame.vertexCount + frame.uvCount, frame.indexCount);
+
+        PolygonInfo info;
+        initializePolygonInfo(Vec2(header.textureWidth, header.textureHeight), sourceSize, vertices, verticesUV,
+                              indices, info);
+        spriteFrame->setPolygonInfo(info);
+    }
+    if (frame.flags & FRAME_ANCHOR)
+    {
+        spriteFrame->setAnchorPoint(Vec2(frame.anchor[0], frame.anchor[1]));
+    }
+    return spriteFrame;
+}
+
+void BinarySpriteSheetLoader::addSpriteFrames(const BinarySpriteSheetView& sheet,
+                                              Texture2D* texture,
+                                              std::string_view sheetPath,
+                                              SpriteFrameCache& cache)
+{
+    auto spriteSheet    = std::make_shared<SpriteSheet>();
+    spriteSheet->format = getFormat();
+    spriteSheet->path   = sheetPath;
+
+    const auto& header = sheet.getHeader();
+    std::vector<SpriteFrame*> spriteFrames(header.frameCount, nullptr);  // shared by a frame and its aliases
+
+    auto textureFileName = Director::getInstance()->getTextureCache()->getTextureFilePath(texture);
+    Image* image         = nullptr;
+    NinePatchImageParser parser;
+    for (uint32_t i = 0; i < header.nameCount; ++i)
+    {
+        const auto name      = sheet.getName(i);
+        const auto frameName = sheet.getString(name.offset, name.length);
+        if (cache.findFrame(frameName))
+        {
+            continue;
+        }
+
+        auto& spriteFrame = spriteFrames[name.frame];
+        if (!spriteFrame)
+        {
+            spriteFrame = createSpriteFrame(sheet, name.frame, texture);
+            if (sheet.getFrame(name.frame).flags & FRAME_NINE_PATCH)
+            {
+                if (image == nullptr)
+                {
+                    image = new Image();
+                    image->initWithImageFile(textureFileName);
+                }
+                parser.setSpriteFrameInfo(image, spriteFrame->getRectInPixels(), spriteFrame->isRotated());
+                cache.addSpriteFrameCapInset(spriteFrame, parser.parseCapInset(), texture);
+            }
+        }
+
+        cache.insertFrame(spriteSheet, frameName, spriteFrame);
+    }
+
+    spriteSheet->full = true;
+
+    AX_SAFE_DELETE(image);
+}
+
+void BinarySpriteSheetLoader::addSpriteFrames(const BinarySpriteSheetView& sheet,
+                                              std::string_view texturePath,
+                                              std::string_view sheetPath,
+                                              SpriteFrameCache& cache)
+{
+    Texture2D* texture     = nullptr;
+    const auto pixelFormat = static_cast<backend::PixelFormat>(sheet.getHeader().pixelFormat);
+    if (pixelFormat != backend::PixelFormat::NONE)
+    {
+        texture = Director::getInstance()->getTextureCache()->addImage(texturePath, pixelFormat);
+    }
+    else
+    {
+        texture = Director::getInstance()->getTextureCache()->addImage(texturePath);
+    }
+
+    if (texture)
+    {
+        addSpriteFrames(sheet, texture, sheetPath, cache);
+    }
+    else
+    {
+        AXLOGD("SpriteFrameCache: Couldn't load texture");
+    }
+}
+
+void BinarySpriteSheetLoader::reloadSpriteFrames(const BinarySpriteSheetView& sheet,
+                                                 Texture2D* texture,
+                                                 std::string_view sheetPath,
+                                                 SpriteFrameCache& cache)
+{
+    auto spriteSheet    = std::make_shared<SpriteSheet>();
+    spriteSheet->format = getFormat();
+    spriteSheet->path   = sheetPath;
+
+    const auto& header = sheet.getHeader();
+    std::vector<SpriteFrame*> spriteFrames(header.frameCount, nullptr);
+    for (uint32_t i = 0; i < header.nameCount; ++i)
+    {
+        const auto name      = sheet.getName(i);
+        const auto frameName = sheet.getString(name.offset, name.length);
+
+        cache.eraseFrame(frameName);
+
+        auto& spriteFrame = spriteFrames[name.frame];
+        if (!spriteFrame)
+            spriteFrame = createSpriteFrame(sheet, name.frame, texture);
+
+        cache.insertFrame(spriteSheet, frameName, spriteFrame);
+    }
+}
+
+bool BinarySpriteSheetLoader::convertFromPlist(std::string_view plistPath, std::string_view outputPath)
+{
+    auto fileUtils      = FileUtils::getInstance();
+    const auto fullPath = fileUtils->fullPathForFilename(plistPath);
+    if (fullPath.empty())
+    {
+        AXLOGW("BinarySpriteSheetLoader: can not find {}", plistPath);
+        return false;
+    }
+
+    std::vector<uint8_t> output;
+    if (!encodePlist(fileUtils->getValueMapFromFile(fullPath), output))
+    {
+        AXLOGW("BinarySpriteSheetLoader: {} is not a supported sprite sheet", plistPath);
+        return false;
+    }
+    return FileUtils::writeBinaryToFile(output.data(), output.size(), outputPath);
+}
+
+bool BinarySpriteSheetLoader::encodePlist(const ValueMap& dictionary, std::vector<uint8_t>& output)
+{
+    auto framesIt = dictionary.find("frames"sv);
+    if (framesIt == dictionary.end() || framesIt->second.getType() != Value::Type::MAP)
+        return false;
+
+    BinarySheetHeader header{};
+    header.magic       = BINARY_SHEET_MAGIC;
+    header.version     = BINARY_SHEET_VERSION;
+    header.pixelFormat = static_cast<uint32_t>(backend::PixelFormat::NONE);
+
+    int format = 0;
+    std::string textureName;
+    auto metaIt = dictionary.find("metadata"sv);
+    if (metaIt != dictionary.end() && metaIt->second.getType() == Value::Type::MAP)
+    {
+        const auto& metadataDict = metaIt->second.asValueMap();
+        format                   = optValue(metadataDict, "format"sv).asInt();
+        textureName              = optValue(metadataDict, "textureFileName"sv).asString();
+        if (metadataDict.find("size"sv) != metadataDict.end())
+        {
+            const auto textureSize = SizeFromString(optValue(metadataDict, "size"sv).asStringRef());
+            header.textureWidth    = textureSize.width;
+            header.textureHeight   = textureSize.height;
+        }
+
+        const auto pixelFormatName = optValue(metadataDict, "pixelFormat"sv).asStringRef();
+        for (auto&& [name, pixelFormat] : s_pixelFormats)
+        {
+            if (name == pixelFormatName)
+                header.pixelFormat = static_cast<uint32_t>(pixelFormat);
+        }
+    }
+    if (format < 0 || format > 3)
+        return false;
+
+    std::vector<BinarySheetFrame> frames;
+    std::vector<BinarySheetName> names;
+    std::vector<int32_t> mesh;
+    std::string strings;
+    std::unordered_map<std::string, uint32_t> stringOffsets;
+    std::unordered_set<std::string_view> nameSet;
+
+    auto addString = [&](std::string_view str) {
+        auto it = stringOffsets.find(std::string{str});
+        if (it != stringOffsets.end())
+            return it->second;
+        auto offset = static_cast<uint32_t>(strings.size());
+        strings.append(str);
+        stringOffsets.emplace(str, offset);
+        return offset;
+    };
+    auto addName = [&](std::string_view name, uint32_t frame) {
+        if (!nameSet.emplace(name).second)
+        {
+            AXLOGW("WARNING: an alias with name {} already exists", name);
+            return;
+        }
+        names.push_back({addString(name), static_cast<uint32_t>(name.length()), frame});
+    };
+    auto addMesh = [&](const std::vector<int>& values) {
+        mesh.insert(mesh.end(), values.begin(), values.end());
+        return static_cast<uint32_t>(values.size());
+    };
+
+    // in name order, so converting the same plist twice gives the same file
+    const auto& framesDict = framesIt->second.asValueMap();
+    std::vector<std::string_view> frameNames;
+    frameNames.reserve(framesDict.size());
+    for (auto&& iter : framesDict)
+        frameNames.emplace_back(iter.first);
+    std::sort(frameNames.begin(), frameNames.end());
+
+    if (!textureName.empty())
+    {
+        header.textureName       = addString(textureName);
+        header.textureNameLength = static_cast<uint32_t>(textureName.length());
+    }
+
+    for (auto frameName : frameNames)
+    {
+        const auto& frameDict = framesDict.find(frameName)->second.asValueMap();
+        BinarySheetFrame frame{};
+        Rect rect;
+        Vec2 offset, sourceSize;
+        if (format == 0)
+        {
+            rect       = Rect(optValue(frameDict, "x"sv).asFloat(), optValue(frameDict, "y"sv).asFloat(),
+                              optValue(frameDict, "width"sv).asFloat(), optValue(frameDict, "height"sv).asFloat());
+            offset     = Vec2(optValue(frameDict, "offsetX"sv).asFloat(), optValue(frameDict, "offsetY"sv).asFloat());
+            sourceSize = Vec2((float)std::abs(optValue(frameDict, "originalWidth"sv).asInt()),
+                              (float)std::abs(optValue(frameDict, "originalHeight"sv).asInt()));
+        }
+        else if (format == 1 || format == 2)
+        {
+            rect       = RectFromString(optValue(frameDict, "frame"sv).asStringRef());
+            offset     = PointFromString(optValue(frameDict, "offset"sv).asStringRef());
+            sourceSize = SizeFromString(optValue(frameDict, "sourceSize"sv).asStringRef());
+            if (format == 2 && optValue(frameDict, "rotated"sv).asBool())
+                frame.flags |= FRAME_ROTATED;
+        }
+        else
+        {
+            const auto spriteSize  = SizeFromString(optValue(frameDict, "spriteSize"sv).asStringRef());
+            const auto textureRect = RectFromString(optValue(frameDict, "textureRect"sv).asStringRef());
+            rect       = Rect(textureRect.origin.x, textureRect.origin.y, spriteSize.width, spriteSize.height);
+            offset     = PointFromString(optValue(frameDict, "spriteOffset"sv).asStringRef());
+            sourceSize = SizeFromString(optValue(frameDict, "spriteSourceSize"sv).asStringRef());
+            if (optValue(frameDict, "textureRotated"sv).asBool())
+                frame.flags |= FRAME_ROTATED;
+
+            if (frameDict.find("vertices"sv) != frameDict.end())
+            {
+                using ax::utils::parseIntegerList;
+                frame.flags |= FRAME_POLYGON;
+                frame.mesh        = static_cast<uint32_t>(mesh.size());
+                frame.vertexCount = addMesh(parseIntegerList(optValue(frameDict, "vertices"sv).asStringRef()));
+                frame.uvCount     = addMesh(parseIntegerList(optValue(frameDict, "verticesUV"sv).asStringRef()));
+                frame.indexCount  = addMesh(parseIntegerList(optValue(frameDict, "triangles"sv).asStringRef()));
+            }
+            if (frameDict.find("anchor"sv) != frameDict.end())
+            {
+                const auto anchor = PointFromString(optValue(frameDict, "anchor"sv).asStringRef());
+                frame.flags |= FRAME_ANCHOR;
+                frame.anchor[0] = anchor.x;
+                frame.anchor[1] = anchor.y;
+            }
+        }
+        if (NinePatchImageParser::isNinePatchImage(frameName))
+            frame.flags |= FRAME_NINE_PATCH;
+
+        frame.rect[0]       = rect.origin.x;
+        frame.rect[1]       = rect.origin.y;
+        frame.rect[2]       = rect.size.width;
+        frame.rect[3]       = rect.size.height;
+        frame.offset[0]     = offset.x;
+        frame.offset[1]     = offset.y;
+        frame.sourceSize[0] = sourceSize.x;
+        frame.sourceSize[1] = sourceSize.y;
+
+        const auto frameIndex = static_cast<uint32_t>(frames.size());
+        frames.push_back(frame);
+        addName(frameName, frameIndex);
+        const auto& aliases = optValue(frameDict, "aliases"sv);
+        if (format == 3 && aliases.getType() == Value::Type::VECTOR)
+        {
+            for (auto&& alias : aliases.asValueVector())
+                addName(alias.asStringRef(), frameIndex);
+        }
+    }
+
+    strings.resize((strings.size() + 3) & ~std::size_t{3});
+
+    header.frameCount    = static_cast<uint32_t>(frames.size());
+    header.nameCount     = static_cast<uint32_t>(names.size());
+    header.framesOffset  = sizeof(header);
+    header.namesOffset   = header.framesOffset + header.frameCount * sizeof(BinarySheetFrame);
+    header.meshOffset    = header.namesOffset + header.nameCount * sizeof(BinarySheetName);
+    header.meshSize      = static_cast<uint32_t>(mesh.size() * sizeof(int32_t));
+    header.stringsOffset = header.meshOffset + header.meshSize;
+    header.stringsSize   = static_cast<uint32_t>(strings.size());
+
+    output.resize(header.stringsOffset + header.stringsSize);
+    auto write = [&output](uint32_t offset, const void* data, std::size_t size) {
+        if (size)
+            memcpy(output.data() + offset, data, size);
+    };
+    write(0, &header, sizeof(header));
+    write(header.framesOffset, frames.data(), frames.size() * sizeof(BinarySheetFrame));
+    write(header.namesOffset, names.data(), names.size() * sizeof(BinarySheetName));
+    write(header.meshOffset, mesh.data(), header.meshSize);
+    write(header.stringsOffset, strings.data(), strings.size());
+    return true;
+}
+
+}
@@ -0,0 +1,90 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "2d/SpriteSheetLoader.h"
+#include "base/Value.h"
+#include "base/Data.h"
+
+namespace ax
+{
+
+class BinarySpriteSheetView;
+
+/**
+ * Loads sprite sheets converted from plists by convertFromPlist. The file is memory mapped and its
+ * frames are read in place: rects, offsets and polygon meshes are stored as numbers, and each frame
+ * name, alias or texture name is stored once in a string table.
+ *
+ * Layout, little endian: BinarySheetHeader, then the frames, the names in the order of their frames,
+ * the mesh integers and the strings, all 4 bytes aligned.
+ */
+class BinarySpriteSheetLoader : public SpriteSheetLoader
+{
+public:
+    static constexpr uint32_t FORMAT = SpriteSheetFormat::BINARY;
+
+    uint32_t getFormat() override { return FORMAT; }
+    void load(std::string_view filePath, SpriteFrameCache& cache) override;
+    void load(std::string_view filePath, Texture2D* texture, SpriteFrameCache& cache) override;
+    void load(std::string_view filePath, std::string_view textureFileName, SpriteFrameCache& cache) override;
+    void load(const Data& content, Texture2D* texture, SpriteFrameCache& cache) override;
+    void reload(std::string_view filePath, SpriteFrameCache& cache) override;
+
+    /**
+     * Converts a plist sprite sheet (any format supported by PlistSpriteSheetLoader), i.e. at build time.
+     * @return false if the plist has no frames or the output can't be written.
+     */
+    static bool convertFromPlist(std::string_view plistPath, std::string_view outputPath);
+
+    /** Encodes the dictionary of a plist sprite sheet, see convertFromPlist. */
+    static bool encodePlist(const ValueMap& dictionary, std::vector<uint8_t>& output);
+
+protected:
+    void addSpriteFrames(const BinarySpriteSheetView& sheet,
+                         Texture2D* texture,
+                         std::string_view sheetPath,
+                         SpriteFrameCache& cache);
+
+    void addSpriteFrames(const BinarySpriteSheetView& sheet,
+                         std::string_view texturePath,
+                         std::string_view sheetPath,
+                         SpriteFrameCache& cache);
+
+    void reloadSpriteFrames(const BinarySpriteSheetView& sheet,
+                            Texture2D* texture,
+                            std::string_view sheetPath,
+                            SpriteFrameCache& cache);
+
+    SpriteFrame* createSpriteFrame(const BinarySpriteSheetView& sheet, uint32_t frameIndex, Texture2D* texture);
+
+    /* The texture stored in the sheet relative to it, else the sheet path with a .png extension. */
+    static std::string getTexturePath(const BinarySpriteSheetView& sheet, std::string_view sheetPath);
+};
+
+}
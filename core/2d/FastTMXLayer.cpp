@@ -58,6 +58,14 @@ const int FastTMXLayer::FAST_TMX_ORIENTATION_ORTHO = 0;
 const int FastTMXLayer::FAST_TMX_ORIENTATION_HEX   = 1;
 const int FastTMXLayer::FAST_TMX_ORIENTATION_ISO   = 2;
 
+#ifdef AX_FAST_TILEMAP_32_BIT_INDICES
+using TileIndex                     = unsigned int;
+static const auto TILE_INDEX_FORMAT = CustomCommand::IndexFormat::U_INT;
+#else
+using TileIndex                     = unsigned short;
+static const auto TILE_INDEX_FORMAT = CustomCommand::IndexFormat::U_SHORT;
+#endif
+
 // FastTMXLayer - init & alloc & dealloc
 FastTMXLayer* FastTMXLayer::create(TMXTilesetInfo* tilesetInfo, TMXLayerInfo* layerInfo, TMXMapInfo* mapInfo)
 {
@@ -120,22 +128,24 @@ FastTMXLayer::~FastTMXLayer()
     AX_SAFE_RELEASE(_tileSet);
     AX_SAFE_RELEASE(_texture);
     AX_SAFE_FREE(_tiles);
-    AX_SAFE_RELEASE(_vertexBuffer);
-    AX_SAFE_RELEASE(_indexBuffer);
 
-    for (auto&& e : _customCommands)
-    {
-        AX_SAFE_RELEASE(e.second->getPipelineDescriptor().programState);
-        delete e.second;
-    }
+    releaseChunks();
+    AX_SAFE_RELEASE(_indexBuffer);
+    AX_SAFE_RELEASE(_programState);
 }
 
 void FastTMXLayer::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
-    updateTotalQuads();
+    // opacity or the whole tile array changed
+    if (_quadsDirty)
+    {
+        for (auto&& e : _chunks)
+            e.second.quadsDirty = true;
+        _quadsDirty = false;
+    }
 
     auto cam = Camera::getVisitingCamera();
-    if (flags != 0 || _dirty || _quadsDirty || !_cameraPositionDirty.fuzzyEquals(cam->getPosition(), _tileSet->_tileSize.x) ||
+    if (flags != 0 || _dirty || !_cameraPositionDirty.fuzzyEquals(cam->getPosition(), _tileSet->_tileSize.x) ||
         _cameraZoomDirty != cam->getZoom())
     {
         _cameraPositionDirty = cam->getPosition();
@@ -156,23 +166,104 @@ void FastTMXLayer::draw(Renderer* renderer, const Mat4& transform, uint32_t flag
         rect = RectApplyTransform(rect, inv);
 
         updateTiles(rect);
-        updateIndexBuffer();
-        updatePrimitives();
         _dirty = false;
     }
 
+    if (_visibleChunks.empty())
+        return;
+
+    updateIndexBuffer();
+    updateProgramState();
+
     const auto& projectionMat = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
     Mat4 finalMat             = projectionMat * _modelViewTransform;
-    for (const auto& e : _customCommands)
+    _programState->setUniform(_mvpMatrixLocaiton, finalMat.m, sizeof(finalMat.m));
+
+    ++_drawCounter;
+    updateDrawRanges();
+    if (!_drawInLayerOrder)
+    {
+        for (auto&& range : _drawRanges)
+            renderer->addCommand(range.chunk->command);
+    }
+    else
+    {
+        // the ranges draw from the vertex buffers of their chunks
+        for (size_t i = 0; i < _drawRanges.size(); ++i)
+        {
+            if (i == _bandCommands.size())
+            {
+                auto command = new CustomCommand();
+                command->getPipelineDescriptor().programState = _programState;
+                command->init(_globalZOrder, _texture->hasPremultipliedAlpha() ? BlendFunc::ALPHA_PREMULTIPLIED
+                                                                               : BlendFunc::ALPHA_NON_PREMULTIPLIED);
+                _bandCommands.emplace_back(command);
+            }
+
+            auto& range  = _drawRanges[i];
+            auto command = _bandCommands[i];
+            command->setIndexBuffer(_indexBuffer, TILE_INDEX_FORMAT);
+            command->setVertexBuffer(range.chunk->command->getVertexBuffer());
+            command->setIndexDrawInfo(range.firstQuad * 6, range.quadCount * 6);
+            renderer->addCommand(command);
+        }
+    }
+
+    evictChunks();
+}
+
+void FastTMXLayer::updateDrawRanges()
+{
+    _drawRanges.clear();
+    for (auto key : _visibleChunks)
     {
-        if (e.second->getIndexDrawCount() > 0)
+        auto& chunk     = getChunk((int)(key >> 32), (int)(uint32_t)key);
+        chunk.lastDrawn = _drawCounter;
+        if (chunk.quadsDirty)
+            updateChunkQuads(chunk);
+
+        if (!chunk.command || chunk.bands.empty())
+            continue;
+
+        if (!_drawInLayerOrder)
         {
-            auto mvpmatrixLocation = e.second->getPipelineDescriptor().programState->getUniformLocation("u_MVPMatrix");
-            e.second->getPipelineDescriptor().programState->setUniform(mvpmatrixLocation, finalMat.m,
-                                                                       sizeof(finalMat.m));
-            renderer->addCommand(e.second);
+            auto& last = chunk.bands.back();
+            _drawRanges.push_back({&chunk, 0, 0, 0, last.firstQuad + last.quadCount});
+            continue;
         }
+        for (auto&& band : chunk.bands)
+            _drawRanges.push_back({&chunk, band.vertexZ, band.y, band.firstQuad, band.quadCount});
     }
+
+    if (!_drawInLayerOrder)
+        return;
+
+    // like the whole layer would draw its tiles: by vertexZ, then row by row, and the chunks of a row from left to
+    // right, which is how the quads of each chunk are sorted already
+    std::sort(_drawRanges.begin(), _drawRanges.end(), [](const TileDrawRange& lhs, const TileDrawRange& rhs) {
+        if (lhs.vertexZ != rhs.vertexZ)
+            return lhs.vertexZ < rhs.vertexZ;
+        if (lhs.y != rhs.y)
+            return lhs.y < rhs.y;
+        return lhs.chunk->x < rhs.chunk->x;
+    });
+
+    // the bands following each other in a chunk are drawn together
+    size_t count = 0;
+    for (auto&& range : _drawRanges)
+    {
+        if (count > 0)
+        {
+            auto& last = _drawRanges[count - 1];
+            if (last.chunk == range.chunk && last.firstQuad + last.quadCount == range.firstQuad)
+            {
+                last.quadCount += range.quadCount;
+                continue;
+            }
+        }
+        _drawRanges[count++] = range;
+    }
+    _drawRanges.resize(count);
 }
 
 void FastTMXLayer::updateTiles(const Rect& culledRect)
@@ -225,13 +316,6 @@ void FastTMXLayer::updateTiles(const Rect& culledRect)
         // AXASSERT(0, "TMX invalid value");
     }
 
-    _indicesVertexZNumber.clear();
-
-    for (const auto& iter : _indicesVertexZOffsets)
-    {
-        _indicesVertexZNumber[iter.first] = iter.second;
-    }
-
     int yBegin = static_cast<int>(std::max(0.f, visibleTiles.origin.y - tilesOverY));
     int yEnd =
         static_cast<int>(std::min(_layerSize.height, visibleTiles.origin.y + visibleTiles.size.height + tilesOverY));
@@ -239,58 +323,52 @@ void FastTMXLayer::updateTiles(const Rect& culledRect)
     int xEnd =
         static_cast<int>(std::min(_layerSize.width, visibleTiles.origin.x + visibleTiles.size.width + tilesOverX));
 
-    for (int y = yBegin; y < yEnd; ++y)
-    {
-        for (int x = xBegin; x < xEnd; ++x)
-        {
-            int tileIndex = getTileIndexByPos(x, y);
-            if (_tiles[tileIndex] == 0)
-                continue;
-
-            int vertexZ = getVertexZForPos(Vec2((float)x, (float)y));
-            auto iter   = _indicesVertexZNumber.find(vertexZ);
-            int offset  = iter->second;
-            iter->second++;
+    // bigger tiles overlap the tiles next to them, and tiles sorted by vertexZ aren't sorted by chunk
+    _drawInLayerOrder = _useAutomaticVertexZ || tilesOverX > 0 || tilesOverY > 0;
 
-            auto quadIndex = static_cast<decltype(_indices)::value_type>(_tileToQuadIndex[tileIndex]);
-            _indices[6 * offset + 0] = quadIndex * 4 + 0;
-            _indices[6 * offset + 1] = quadIndex * 4 + 1;
-            _indices[6 * offset + 2] = quadIndex * 4 + 2;
-            _indices[6 * offset + 3] = quadIndex * 4 + 3;
-            _indices[6 * offset + 4] = quadIndex * 4 + 2;
-            _indices[6 * offset + 5] = quadIndex * 4 + 1;
-
-        }  // for x
-    }      // for y
+    _visibleChunks.clear();
+    if (xBegin >= xEnd || yBegin >= yEnd)
+        return;
 
-    for (const auto& iter : _indicesVertexZOffsets)
+    // row by row, the drawing order of the chunks when their tiles don't overlap
+    for (int y = yBegin / _chunkSize; y <= (yEnd - 1) / _chunkSize; ++y)
     {
-        _indicesVertexZNumber[iter.first] -= iter.second;
-        if (_indicesVertexZNumber[iter.first] == 0)
+        for (int x = xBegin / _chunkSize; x <= (xEnd - 1) / _chunkSize; ++x)
         {
-            _indicesVertexZNumber.erase(iter.first);
+            _visibleChunks.emplace_back(getChunkKey(x, y));
         }
     }
 }
 
-void FastTMXLayer::updateVertexBuffer()
+void FastTMXLayer::updateIndexBuffer()
 {
-    unsigned int vertexBufferSize = (unsigned int)(sizeof(V3F_C4B_T2F) * _totalQuads.size() * 4);
-    if (!_vertexBuffer)
+    const int maxQuads = _chunkSize * _chunkSize;
+    if (_indexBuffer && _indexBufferQuads >= maxQuads)
+        return;
+
+    std::vector<TileIndex> indices(maxQuads * 6);
+    for (int i = 0; i < maxQuads; ++i)
     {
-        _vertexBuffer = backend::DriverBase::getInstance()->newBuffer(vertexBufferSize, backend::BufferType::VERTEX, backend::BufferUsage::STATIC);
+        indices[6 * i + 0] = static_cast<TileIndex>(i * 4 + 0);
+        indices[6 * i + 1] = static_cast<TileIndex>(i * 4 + 1);
+        indices[6 * i + 2] = static_cast<TileIndex>(i * 4 + 2);
+        indices[6 * i + 3] = static_cast<TileIndex>(i * 4 + 3);
+        indices[6 * i + 4] = static_cast<TileIndex>(i * 4 + 2);
+        indices[6 * i + 5] = static_cast<TileIndex>(i * 4 + 1);
     }
-    _vertexBuffer->updateData(&_totalQuads[0], vertexBufferSize);
-}
 
-void FastTMXLayer::updateIndexBuffer()
-{
-    auto indexBufferSize = (sizeof(decltype(_indices)::value_type) * _indices.size());
-    if (!_indexBuffer)
+    auto indexBufferSize = sizeof(TileIndex) * indices.size();
+    AX_SAFE_RELEASE(_indexBuffer);
+    _indexBuffer = backend::DriverBase::getInstance()->newBuffer(indexBufferSize, backend::BufferType::INDEX,
+                                                                 backend::BufferUsage::STATIC);
+    _indexBuffer->updateData(indices.data(), indexBufferSize);
+    _indexBufferQuads = maxQuads;
+
+    for (auto&& e : _chunks)
     {
-        _indexBuffer = backend::DriverBase::getInstance()->newBuffer(indexBufferSize, backend::BufferType::INDEX, backend::BufferUsage::DYNAMIC);
+        if (e.second.command)
+            e.second.command->setIndexBuffer(_indexBuffer, TILE_INDEX_FORMAT);
     }
-    _indexBuffer->updateData(&_indices[0], indexBufferSize);
 }
 
 // FastTMXLayer - setup Tiles
@@ -332,7 +410,7 @@ void FastTMXLayer::setupTiles()
 
     _screenTileCount = (int)(_screenGridSize.width * _screenGridSize.height);
 
-    if (!_tileSet->_animationInfo.empty())
+    if (_tiles && !_tileSet->_animationInfo.empty())
     {
         /// FastTMXLayer: anim support
         for (int y = 0; y < _layerSize.height; y++)
@@ -427,216 +505,337 @@ Mat4 FastTMXLayer::tileToNodeTransform()
     }
 }
 
-void FastTMXLayer::updatePrimitives()
+void FastTMXLayer::updateProgramState()
 {
-    auto blendfunc =
-        _texture->hasPremultipliedAlpha() ? BlendFunc::ALPHA_PREMULTIPLIED : BlendFunc::ALPHA_NON_PREMULTIPLIED;
-    for (const auto& iter : _indicesVertexZNumber)
+    if (_programState)
+        return;
+
+    // one program state for all chunks, they share the texture and the transform
+    if (_useAutomaticVertexZ)
+    {
+        auto* program = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR_ALPHA_TEST);
+        _programState = new backend::ProgramState(program);
+        _alphaValueLocation = _programState->getUniformLocation("u_alpha_value");
+        _programState->setUniform(_alphaValueLocation, &_alphaFuncValue, sizeof(_alphaFuncValue));
+    }
+    else
     {
-        int start = _indicesVertexZOffsets.at(iter.first);
+        auto* program = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR);
+        _programState = new backend::ProgramState(program);
+    }
 
-        auto commandIter = _customCommands.find(iter.first);
-        if (_customCommands.end() == commandIter)
-        {
-            auto command = new CustomCommand();
-            command->setVertexBuffer(_vertexBuffer);
+    _mvpMatrixLocaiton = _programState->getUniformLocation("u_MVPMatrix");
+    _textureLocation   = _programState->getUniformLocation("u_tex0");
+    _programState->setTexture(_textureLocation, 0, _texture->getBackendTexture());
+}
 
-#ifdef AX_FAST_TILEMAP_32_BIT_INDICES
-            CustomCommand::IndexFormat indexFormat = CustomCommand::IndexFormat::U_INT;
-#else
-            CustomCommand::IndexFormat indexFormat = CustomCommand::IndexFormat::U_SHORT;
-#endif
-            command->setIndexBuffer(_indexBuffer, indexFormat);
+void FastTMXLayer::setOpacity(uint8_t opacity)
+{
+    Node::setOpacity(opacity);
+    _quadsDirty = true;
+}
 
-            command->setIndexDrawInfo(start * 6, iter.second * 6);
+void FastTMXLayer::updateChunkQuads(TileChunk& chunk)
+{
+    chunk.quadsDirty = false;
+    chunk.bands.clear();
+    if (!_tiles && chunk.tiles.empty())
+        return;
 
-            auto& pipelineDescriptor = command->getPipelineDescriptor();
+    auto color = Color4B::WHITE;
+    color.a    = getDisplayedOpacity();
 
-            if (_useAutomaticVertexZ)
-            {
-                AX_SAFE_RELEASE(pipelineDescriptor.programState);
-                auto* program =
-                    backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR_ALPHA_TEST);
-                auto programState               = new backend::ProgramState(program);
-                pipelineDescriptor.programState = programState;
-                _alphaValueLocation             = pipelineDescriptor.programState->getUniformLocation("u_alpha_value");
-                pipelineDescriptor.programState->setUniform(_alphaValueLocation, &_alphaFuncValue,
-                                                            sizeof(_alphaFuncValue));
-            }
-            else
-            {
-                AX_SAFE_RELEASE(pipelineDescriptor.programState);
-                auto* program     = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR);
-                auto programState = new backend::ProgramState(program);
-                pipelineDescriptor.programState = programState;
-            }
+    if (_texture->hasPremultipliedAlpha())
+    {
+        auto alpha = color.a / 255.0f;
+        color.r    = static_cast<uint8_t>(color.r * alpha);
+        color.g    = static_cast<uint8_t>(color.g * alpha);
+        color.b    = static_cast<uint8_t>(color.b * alpha);
+    }
 
-            _mvpMatrixLocaiton = pipelineDescriptor.programState->getUniformLocation("u_MVPMatrix");
-            _textureLocation   = pipelineDescriptor.programState->getUniformLocation("u_tex0");
-            pipelineDescriptor.programState->setTexture(_textureLocation, 0, _texture->getBackendTexture());
-            command->init(_globalZOrder, blendfunc);
+    const int xBegin = chunk.x * _chunkSize;
+    const int yBegin = chunk.y * _chunkSize;
+    const int xEnd   = std::min(xBegin + _chunkSize, (int)_layerSize.width);
+    const int yEnd   = std::min(yBegin + _chunkSize, (int)_layerSize.height);
+    auto tileAt      = [&](int x, int y) {
+        return _tiles ? _tiles[getTileIndexByPos(x, y)] : chunk.tiles[(y - yBegin) * _chunkSize + (x - xBegin)];
+    };
 
-            _customCommands[iter.first] = command;
-        }
-        else
+    // quads are sorted by vertexZ then row, so count the tiles of each band first
+    std::map<std::pair<int /*vertexZ*/, int /*y*/>, int /*offset to quads*/> bandOffsets;
+    for (int y = yBegin; y < yEnd; ++y)
+    {
+        for (int x = xBegin; x < xEnd; ++x)
         {
-            commandIter->second->setIndexDrawInfo(start * 6, iter.second * 6);
+            if (tileAt(x, y) != 0)
+                ++bandOffsets[{getVertexZForPos(Vec2((float)x, (float)y)), y}];
         }
     }
-}
 
-void FastTMXLayer::setOpacity(uint8_t opacity)
-{
-    Node::setOpacity(opacity);
-    _quadsDirty = true;
-}
+    int quadCount = 0;
+    chunk.bands.reserve(bandOffsets.size());
+    for (auto&& bandOffset : bandOffsets)
+    {
+        chunk.bands.push_back({bandOffset.first.first, bandOffset.first.second, quadCount, bandOffset.second});
+        std::swap(quadCount, bandOffset.second);
+        quadCount += bandOffset.second;
+    }
 
-void FastTMXLayer::updateTotalQuads()
-{
-    if (_quadsDirty)
+    if (quadCount == 0)
     {
-        Vec2 tileSize = AX_SIZE_PIXELS_TO_POINTS(_tileSet->_tileSize);
-        Vec2 texSize  = _tileSet->_imageSize;
-        _tileToQuadIndex.clear();
-        _totalQuads.resize(int(_layerSize.width * _layerSize.height));
-        _indices.resize(6 * int(_layerSize.width * _layerSize.height));
-        _tileToQuadIndex.resize(int(_layerSize.width * _layerSize.height), -1);
-        _indicesVertexZOffsets.clear();
-
-        auto color = Color4B::WHITE;
-        color.a    = getDisplayedOpacity();
-
-        if (_texture->hasPremultipliedAlpha())
+        releaseChunkQuads(chunk);
+        chunk.quadsDirty = false;
+        return;
+    }
+
+    _chunkQuads.resize(quadCount);
+    for (int y = yBegin; y < yEnd; ++y)
+    {
+        for (int x = xBegin; x < xEnd; ++x)
         {
-            auto alpha = color.a / 255.0f;
-            color.r    = static_cast<uint8_t>(color.r * alpha);
-            color.g    = static_cast<uint8_t>(color.g * alpha);
-            color.b    = static_cast<uint8_t>(color.b * alpha);
+            uint32_t tileGID = tileAt(x, y);
+            if (tileGID == 0)
+                continue;
+
+            int quadIndex = bandOffsets[{getVertexZForPos(Vec2((float)x, (float)y)), y}]++;
+            setupTileQuad(_chunkQuads[quadIndex], x, y, tileGID, color);
         }
+    }
 
-        int quadIndex = 0;
-        for (int y = 0; y < _layerSize.height; ++y)
+    auto vertexBufferSize = sizeof(V3F_C4B_T2F_Quad) * quadCount;
+    auto vertexBuffer     = chunk.command ? chunk.command->getVertexBuffer() : nullptr;
+    if (!vertexBuffer || vertexBuffer->getSize() < vertexBufferSize)
+    {
+        vertexBuffer = backend::DriverBase::getInstance()->newBuffer(vertexBufferSize, backend::BufferType::VERTEX,
+                                                                     backend::BufferUsage::STATIC);
+        if (!chunk.command)
         {
-            for (int x = 0; x < _layerSize.width; ++x)
-            {
-                int tileIndex = getTileIndexByPos(x, y);
-                int tileGID   = _tiles[tileIndex];
+            chunk.command = new CustomCommand();
+            chunk.command->setIndexBuffer(_indexBuffer, TILE_INDEX_FORMAT);
+            chunk.command->getPipelineDescriptor().programState = _programState;
+            chunk.command->init(_globalZOrder, _texture->hasPremultipliedAlpha() ? BlendFunc::ALPHA_PREMULTIPLIED
+                                                                                 : BlendFunc::ALPHA_NON_PREMULTIPLIED);
+        }
+        chunk.command->setVertexBuffer(vertexBuffer);
+        vertexBuffer->release();
+    }
+    vertexBuffer->updateData(_chunkQuads.data(), vertexBufferSize);
+    chunk.command->setIndexDrawInfo(0, quadCount * 6);
+}
 
-                if (tileGID == 0)
-                    continue;
+void FastTMXLayer::setupTileQuad(V3F_C4B_T2F_Quad& quad, int x, int y, uint32_t tileGID, const Color4B& color)
+{
+    Vec2 tileSize = AX_SIZE_PIXELS_TO_POINTS(_tileSet->_tileSize);
+    Vec2 texSize  = _tileSet->_imageSize;
 
-                _tileToQuadIndex[tileIndex] = quadIndex;
+    Vec3 nodePos(float(x), float(y), 0);
+    _tileToNodeTransform.transformPoint(&nodePos);
 
-                auto& quad = _totalQuads[quadIndex];
+    float left, right, top, bottom;
+    float z = (float)getVertexZForPos(Vec2((float)x, (float)y));
 
-                Vec3 nodePos(float(x), float(y), 0);
-                _tileToNodeTransform.transformPoint(&nodePos);
+    // vertices
+    if (tileGID & kTMXTileDiagonalFlag)
+    {
+        left   = nodePos.x;
+        right  = nodePos.x + tileSize.height;
+        bottom = nodePos.y + tileSize.width;
+        top    = nodePos.y;
+    }
+    else
+    {
+        left   = nodePos.x;
+        right  = nodePos.x + tileSize.width;
+        bottom = nodePos.y + tileSize.height;
+        top    = nodePos.y;
+    }
 
-                float left, right, top, bottom, z;
+    if (tileGID & kTMXTileVerticalFlag)
+        std::swap(top, bottom);
+    if (tileGID & kTMXTileHorizontalFlag)
+        std::swap(left, right);
 
-                int zPos  = getVertexZForPos(Vec2((float)x, (float)y));
-                z         = (float)zPos;
-                auto iter = _indicesVertexZOffsets.find(zPos);
-                if (iter == _indicesVertexZOffsets.end())
-                {
-                    _indicesVertexZOffsets[zPos] = 1;
-                }
-                else
-                {
-                    iter->second++;
-                }
-                // vertices
-                if (tileGID & kTMXTileDiagonalFlag)
-                {
-                    left   = nodePos.x;
-                    right  = nodePos.x + tileSize.height;
-                    bottom = nodePos.y + tileSize.width;
-                    top    = nodePos.y;
-                }
-                else
-                {
-                    left   = nodePos.x;
-                    right  = nodePos.x + tileSize.width;
-                    bottom = nodePos.y + tileSize.height;
-                    top    = nodePos.y;
-                }
+    if (tileGID & kTMXTileDiagonalFlag)
+    {
+        // FIXME: not working correctly
+        quad.bl.vertices.x = left;
+        quad.bl.vertices.y = bottom;
+        quad.bl.vertices.z = z;
+        quad.br.vertices.x = left;
+        quad.br.vertices.y = top;
+        quad.br.vertices.z = z;
+        quad.tl.vertices.x = right;
+        quad.tl.vertices.y = bottom;
+        quad.tl.vertices.z = z;
+        quad.tr.vertices.x = right;
+        quad.tr.vertices.y = top;
+        quad.tr.vertices.z = z;
+    }
+    else
+    {
+        quad.bl.vertices.x = left;
+        quad.bl.vertices.y = bottom;
+        quad.bl.vertices.z = z;
+        quad.br.vertices.x = right;
+        quad.br.vertices.y = bottom;
+        quad.br.vertices.z = z;
+        quad.tl.vertices.x = left;
+        quad.tl.vertices.y = top;
+        quad.tl.vertices.z = z;
+        quad.tr.vertices.x = right;
+        quad.tr.vertices.y = top;
+        quad.tr.vertices.z = z;
+    }
+
+    // texcoords
+    Rect tileTexture = _tileSet->getRectForGID(tileGID);
+    left             = (tileTexture.origin.x / texSize.width);
+    right            = left + (tileTexture.size.width / texSize.width);
+    bottom           = (tileTexture.origin.y / texSize.height);
+    top              = bottom + (tileTexture.size.height / texSize.height);
+
+    // issue#1085 OpenGL sub-pixel horizontal-vertical lines pixel-tolerance fix.
+    float ptx = 1.0 / (_tileSet->_imageSize.x * tileSize.x);
+    float pty = 1.0 / (_tileSet->_imageSize.y * tileSize.y);
+
+    quad.bl.texCoords.u = left + ptx;
+    quad.bl.texCoords.v = bottom + pty;
+    quad.br.texCoords.u = right - ptx;
+    quad.br.texCoords.v = bottom + pty;
+    quad.tl.texCoords.u = left + ptx;
+    quad.tl.texCoords.v = top - pty;
+    quad.tr.texCoords.u = right - ptx;
+    quad.tr.texCoords.v = top - pty;
+
+    quad.bl.colors = color;
+    quad.br.colors = color;
+    quad.tl.colors = color;
+    quad.tr.colors = color;
+}
 
-                if (tileGID & kTMXTileVerticalFlag)
-                    std::swap(top, bottom);
-                if (tileGID & kTMXTileHorizontalFlag)
-                    std::swap(left, right);
+void FastTMXLayer::releaseChunkQuads(TileChunk& chunk)
+{
+    // the command owns the vertex buffer
+    delete chunk.command;
+    chunk.command    = nullptr;
+    chunk.quadsDirty = true;
+    chunk.bands.clear();
+}
 
-                if (tileGID & kTMXTileDiagonalFlag)
-                {
-                    // FIXME: not working correctly
-                    quad.bl.vertices.x = left;
-                    quad.bl.vertices.y = bottom;
-                    quad.bl.vertices.z = z;
-                    quad.br.vertices.x = left;
-                    quad.br.vertices.y = top;
-                    quad.br.vertices.z = z;
-                    quad.tl.vertices.x = right;
-                    quad.tl.vertices.y = bottom;
-                    quad.tl.vertices.z = z;
-                    quad.tr.vertices.x = right;
-                    quad.tr.vertices.y = top;
-                    quad.tr.vertices.z = z;
-                }
-                else
-                {
-                    quad.bl.vertices.x = left;
-                    quad.bl.vertices.y = bottom;
-                    quad.bl.vertices.z = z;
-                    quad.br.vertices.x = right;
-                    quad.br.vertices.y = bottom;
-                    quad.br.vertices.z = z;
-                    quad.tl.vertices.x = left;
-                    quad.tl.vertices.y = top;
-                    quad.tl.vertices.z = z;
-                    quad.tr.vertices.x = right;
-                    quad.tr.vertices.y = top;
-                    quad.tr.vertices.z = z;
-                }
+void FastTMXLayer::releaseChunks()
+{
+    for (auto&& e : _chunks)
+        delete e.second.command;
+    _chunks.clear();
+    _visibleChunks.clear();
+    _drawRanges.clear();
+    for (auto command : _bandCommands)
+        delete command;
+    _bandCommands.clear();
+    _dirty = true;
+}
 
-                // texcoords
-                Rect tileTexture = _tileSet->getRectForGID(tileGID);
-                left             = (tileTexture.origin.x / texSize.width);
-                right            = left + (tileTexture.size.width / texSize.width);
-                bottom           = (tileTexture.origin.y / texSize.height);
-                top              = bottom + (tileTexture.size.height / texSize.height);
-
-                // issue#1085 OpenGL sub-pixel horizontal-vertical lines pixel-tolerance fix.
-                float ptx = 1.0 / (_tileSet->_imageSize.x * tileSize.x);
-                float pty = 1.0 / (_tileSet->_imageSize.y * tileSize.y);
-
-                quad.bl.texCoords.u = left + ptx;
-                quad.bl.texCoords.v = bottom + pty;
-                quad.br.texCoords.u = right - ptx;
-                quad.br.texCoords.v = bottom + pty;
-                quad.tl.texCoords.u = left + ptx;
-                quad.tl.texCoords.v = top - pty;
-                quad.tr.texCoords.u = right - ptx;
-                quad.tr.texCoords.v = top - pty;
-
-                quad.bl.colors = color;
-                quad.br.colors = color;
-                quad.tl.colors = color;
-                quad.tr.colors = color;
-
-                ++quadIndex;
+FastTMXLayer::TileChunk& FastTMXLayer::getChunk(int x, int y)
+{
+    auto [it, inserted] = _chunks.try_emplace(getChunkKey(x, y));
+    auto& chunk         = it->second;
+    if (inserted)
+    {
+        chunk.x = x;
+        chunk.y = y;
+        if (!_tiles && _tileChunkLoader)
+        {
+            chunk.tiles.resize(_chunkSize * _chunkSize, 0U);
+            if (!_tileChunkLoader(x, y, std::span{chunk.tiles}))
+            {
+                AXLOGW("FastTMXLayer: failed to load chunk {},{} of layer {}", x, y, _layerName);
+                std::fill(chunk.tiles.begin(), chunk.tiles.end(), 0U);
             }
         }
+    }
+    return chunk;
+}
 
-        int offset = 0;
-        for (auto&& vertexZOffset : _indicesVertexZOffsets)
+void FastTMXLayer::evictChunks()
+{
+    const size_t budget = std::max((size_t)std::max(_maxResidentChunks, 0), _visibleChunks.size());
+    if (_chunks.size() <= budget)
+        return;
+
+    std::vector<TileChunk*> candidates;
+    candidates.reserve(_chunks.size());
+    for (auto&& e : _chunks)
+    {
+        if (e.second.lastDrawn != _drawCounter)
+            candidates.emplace_back(&e.second);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const TileChunk* lhs, const TileChunk* rhs) { return lhs->lastDrawn < rhs->lastDrawn; });
+
+    size_t count = _chunks.size() - budget;
+    for (auto chunk : candidates)
+    {
+        if (count == 0)
+            break;
+        --count;
+
+        // the edits of a streamed chunk only live in memory
+        if (chunk->tilesModified)
+            releaseChunkQuads(*chunk);
+        else
         {
-            std::swap(offset, vertexZOffset.second);
-            offset += vertexZOffset.second;
+            delete chunk->command;
+            _chunks.erase(getChunkKey(chunk->x, chunk->y));
         }
-        updateVertexBuffer();
+    }
+}
 
-        _quadsDirty = false;
+int FastTMXLayer::getResidentChunkCount() const
+{
+    int count = 0;
+    for (auto&& e : _chunks)
+    {
+        if (e.second.command)
+            ++count;
     }
+    return count;
+}
+
+void FastTMXLayer::setChunkSize(int chunkSize)
+{
+#ifndef AX_FAST_TILEMAP_32_BIT_INDICES
+    // 16 bit indices address at most 128x128 quads
+    chunkSize = std::min(chunkSize, 128);
+#endif
+    chunkSize = std::max(chunkSize, 1);
+    if (chunkSize == _chunkSize)
+        return;
+
+    _chunkSize = chunkSize;
+    releaseChunks();
+}
+
+void FastTMXLayer::setTileChunkLoader(const Vec2& layerSize, TileChunkLoader loader)
+{
+    AXASSERT(loader, "FastTMXLayer: invalid tile chunk loader");
+
+    // the animated tiles were collected from the tiles which are released now
+    if (_tileAnimManager)
+    {
+        _tileAnimManager->stopAll();
+        AX_SAFE_RELEASE_NULL(_tileAnimManager);
+    }
+    _animTileCoord.clear();
+
+    AX_SAFE_FREE(_tiles);
+    _tileChunkLoader = std::move(loader);
+    _layerSize       = layerSize;
+
+    this->setContentSize(
+        AX_SIZE_PIXELS_TO_POINTS(Vec2(_layerSize.width * _mapTileSize.width, _layerSize.height * _mapTileSize.height)));
+    this->tileToNodeTransform();
+
+    releaseChunks();
 }
 
 // removing / getting tiles
@@ -645,7 +844,7 @@ Sprite* FastTMXLayer::getTileAt(const Vec2& tileCoordinate)
     AXASSERT(tileCoordinate.x < _layerSize.width && tileCoordinate.y < _layerSize.height && tileCoordinate.x >= 0 &&
                  tileCoordinate.y >= 0,
              "TMXLayer: invalid position");
-    AXASSERT(_tiles, "TMXLayer: the tiles map has been released");
+    AXASSERT(_tiles || _tileChunkLoader, "TMXLayer: the tiles map has been released");
 
     TMXTileFlags flags;
     Sprite* tile = nullptr;
@@ -688,12 +887,12 @@ int FastTMXLayer::getTileGIDAt(const Vec2& tileCoordinate, TMXTileFlags* flags /
     AXASSERT(tileCoordinate.x < _layerSize.width && tileCoordinate.y < _layerSize.height && tileCoordinate.x >= 0 &&
                  tileCoordinate.y >= 0,
              "TMXLayer: invalid position");
-    AXASSERT(_tiles, "TMXLayer: the tiles map has been released");
+    AXASSERT(_tiles || _tileChunkLoader, "TMXLayer: the tiles map has been released");
 
     int idx = static_cast<int>(((int)tileCoordinate.x + (int)tileCoordinate.y * _layerSize.width));
 
     // Bits on the far end of the 32-bit global tile ID are used for tile flags
-    int tile = _tiles[idx];
+    int tile = getFlaggedTileGIDByIndex(idx);
     auto it  = _spriteContainer.find(idx);
 
     // converted to sprite.
@@ -775,11 +974,40 @@ void FastTMXLayer::removeTileAt(const Vec2& tileCoordinate)
 
 void FastTMXLayer::setFlaggedTileGIDByIndex(int index, uint32_t gid)
 {
-    if (gid == _tiles[index])
-        return;
-    _tiles[index] = gid;
-    _quadsDirty   = true;
-    _dirty        = true;
+    const int x = index % (int)_layerSize.width;
+    const int y = index / (int)_layerSize.width;
+
+    if (_tiles)
+    {
+        if (gid == _tiles[index])
+            return;
+        _tiles[index] = gid;
+    }
+    else
+    {
+        auto& chunk = getChunk(x / _chunkSize, y / _chunkSize);
+        auto& tile  = chunk.tiles[(y % _chunkSize) * _chunkSize + x % _chunkSize];
+        if (gid == tile)
+            return;
+        tile                = gid;
+        chunk.tilesModified = true;
+    }
+
+    // only the chunk of the tile is rebuilt
+    auto it = _chunks.find(getChunkKey(x / _chunkSize, y / _chunkSize));
+    if (it != _chunks.end())
+        it->second.quadsDirty = true;
+}
+
+uint32_t FastTMXLayer::getFlaggedTileGIDByIndex(int index)
+{
+    if (_tiles)
+        return _tiles[index];
+
+    const int x = index % (int)_layerSize.width;
+    const int y = index / (int)_layerSize.width;
+    auto& chunk = getChunk(x / _chunkSize, y / _chunkSize);
+    return chunk.tiles[(y % _chunkSize) * _chunkSize + x % _chunkSize];
 }
 
 void FastTMXLayer::removeChild(Node* node, bool cleanup)
@@ -854,7 +1082,7 @@ void FastTMXLayer::setTileGID(int gid, const Vec2& tileCoordinate, TMXTileFlags
     AXASSERT(tileCoordinate.x < _layerSize.width && tileCoordinate.y < _layerSize.height && tileCoordinate.x >= 0 &&
                  tileCoordinate.y >= 0,
              "TMXLayer: invalid position");
-    AXASSERT(_tiles, "TMXLayer: the tiles map has been released");
+    AXASSERT(_tiles || _tileChunkLoader, "TMXLayer: the tiles map has been released");
     AXASSERT(gid == 0 || gid >= _tileSet->_firstGid, "TMXLayer: invalid gid");
 
     TMXTileFlags currentFlags;
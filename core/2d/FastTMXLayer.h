@@ -29,6 +29,8 @@ THE SOFTWARE.
 #pragma once
 
 #include <unordered_map>
+#include <functional>
+#include <span>
 #include "2d/Node.h"
 #include "2d/TMXXMLParser.h"
 #include "renderer/CustomCommand.h"
@@ -54,7 +56,7 @@ class Buffer;
  */
 
 /**
- * !!! uncomment if you want reduce bandwidth of GPU, then the tiled layer size will be limited to 128x128
+ * !!! comment out if you want reduce bandwidth of GPU, then the chunk size of a layer will be limited to 128x128
 */
 #define AX_FAST_TILEMAP_32_BIT_INDICES 1
 
@@ -80,6 +82,11 @@ class Buffer;
  different
  * value, like 0.5.
 
+ * The layer is split into chunks of getChunkSize() x getChunkSize() tiles. Only the chunks intersecting the camera are
+ * built and drawn, chunks which went off-screen are released once more than getMaxResidentChunks() are kept and rebuilt
+ * when they become visible again. Changing a tile only rebuilds its chunk. When tiles are bigger than the map grid or
+ * use an automatic vertexZ, the chunks are drawn interleaved row by row, so the tiles overlap as in a single batch.
+
  * For further information, please see the programming guide:
  * http://www.cocos2d-iphone.org/wiki/doku.php/prog_guide:tiled_maps
 
@@ -95,6 +102,15 @@ public:
     static const int FAST_TMX_ORIENTATION_HEX;
     static const int FAST_TMX_ORIENTATION_ISO;
 
+    /** Default size of the chunks a layer is split into, in tiles */
+    static const int DEFAULT_CHUNK_SIZE = 32;
+
+    /** Loads the tiles of the chunk at (chunkX, chunkY), e.g. from a file on disk.
+     * gids is zero filled and holds getChunkSize() * getChunkSize() tiles in row-major order; tiles of the chunk
+     * beyond the layer size are ignored. Returns false if the chunk couldn't be loaded, it is then left empty.
+     */
+    using TileChunkLoader = std::function<bool(int chunkX, int chunkY, std::span<uint32_t> gids)>;
+
     /** Creates a FastTMXLayer with an tileset info, a layer info and a map info.
      *
      * @param tilesetInfo An tileset info.
@@ -216,6 +232,39 @@ public:
         _quadsDirty = true;
     };
 
+    /** Streams the tiles of a layer of the given size from a loader instead of keeping all of them in memory.
+     * The current tiles of the layer are released and getTiles() returns nullptr afterwards. Chunks are loaded when
+     * they become visible or one of their tiles is accessed, and dropped again on eviction unless a tile of them
+     * has been changed. Tile animations aren't supported on streamed layers.
+     *
+     * @param layerSize The size of the layer in tiles.
+     * @param loader The function loading the tiles of a chunk.
+     */
+    void setTileChunkLoader(const Vec2& layerSize, TileChunkLoader loader);
+
+    /** Sets the size of the chunks the layer is split into, in tiles.
+     * Releases all chunks, with a tile chunk loader it must be set before the loader.
+     *
+     * @param chunkSize The chunk size in tiles, default is DEFAULT_CHUNK_SIZE.
+     */
+    void setChunkSize(int chunkSize);
+
+    /** Gets the size of the chunks the layer is split into, in tiles. */
+    int getChunkSize() const { return _chunkSize; }
+
+    /** Sets how many chunks may stay in memory, the least recently drawn chunks beyond this budget are released.
+     * Chunks visible in the current frame are never released.
+     *
+     * @param count The number of chunks, default is 64.
+     */
+    void setMaxResidentChunks(int count) { _maxResidentChunks = count; }
+
+    /** Gets how many chunks may stay in memory. */
+    int getMaxResidentChunks() const { return _maxResidentChunks; }
+
+    /** Gets the number of chunks whose vertices are currently built. */
+    int getResidentChunkCount() const;
+
     /** Tileset information for the layer.
      *
      * @return Tileset information for the layer.
@@ -303,6 +352,43 @@ public:
                                                      TMXMapInfo* mapInfo);
 
 protected:
+    /** The quads of a chunk in one row of tiles with the same vertexZ */
+    struct TileBand
+    {
+        int vertexZ   = 0;
+        int y         = 0;
+        int firstQuad = 0;
+        int quadCount = 0;
+    };
+
+    /** A square of tiles with its own vertex buffer and draw command */
+    struct TileChunk
+    {
+        /** chunk coordinate, in chunks */
+        int x = 0;
+        int y = 0;
+        bool quadsDirty    = true;
+        bool tilesModified = false;
+        /** value of _drawCounter when the chunk was last drawn */
+        unsigned int lastDrawn = 0;
+        /** tiles of a streamed chunk, empty if the layer keeps all its tiles in _tiles */
+        std::vector<uint32_t> tiles;
+        /** owns the vertex buffer of the chunk, nullptr if the chunk has no vertices */
+        CustomCommand* command = nullptr;
+        /** the quads of the chunk by vertexZ and row, in the order of the vertex buffer */
+        std::vector<TileBand> bands;
+    };
+
+    /** Quads of a chunk drawn by one command */
+    struct TileDrawRange
+    {
+        TileChunk* chunk;
+        int vertexZ;
+        int y;
+        int firstQuad;
+        int quadCount;
+    };
+
     virtual void setOpacity(uint8_t opacity) override;
 
     void updateTiles(const Rect& culledRect);
@@ -318,15 +404,23 @@ protected:
 
     // Flip flags is packed into gid
     void setFlaggedTileGIDByIndex(int index, uint32_t gid);
-
-    //
-    void updateTotalQuads();
+    uint32_t getFlaggedTileGIDByIndex(int index);
 
     int getTileIndexByPos(int x, int y) const { return x + y * (int)_layerSize.width; }
 
-    void updateVertexBuffer();
+    static uint64_t getChunkKey(int x, int y) { return (uint64_t)(uint32_t)x << 32 | (uint32_t)y; }
+    /** Returns the chunk at the chunk coordinate, creates it and loads its tiles if needed */
+    TileChunk& getChunk(int x, int y);
+    void updateChunkQuads(TileChunk& chunk);
+    void setupTileQuad(V3F_C4B_T2F_Quad& quad, int x, int y, uint32_t tileGID, const Color4B& color);
+    void releaseChunkQuads(TileChunk& chunk);
+    void releaseChunks();
+    void evictChunks();
+    /** Builds the visible chunks and lists their quads in drawing order in _drawRanges */
+    void updateDrawRanges();
+
     void updateIndexBuffer();
-    void updatePrimitives();
+    void updateProgramState();
 
     //! name of the layer
     std::string _layerName;
@@ -370,22 +464,29 @@ protected:
     Vec2 _cameraPositionDirty = {INFINITY, INFINITY};
     float _cameraZoomDirty;
 
-    std::vector<int> _tileToQuadIndex;
-    std::vector<V3F_C4B_T2F_Quad> _totalQuads;
-#ifdef AX_FAST_TILEMAP_32_BIT_INDICES
-    std::vector<unsigned int> _indices;
-#else
-    std::vector<unsigned short> _indices;
-#endif
-    std::map<int /*vertexZ*/, int /*offset to _indices by quads*/> _indicesVertexZOffsets;
-    std::unordered_map<int /*vertexZ*/, int /*number to quads*/> _indicesVertexZNumber;
+    int _chunkSize         = DEFAULT_CHUNK_SIZE;
+    int _maxResidentChunks = 64;
+    unsigned int _drawCounter = 0;
+    std::unordered_map<uint64_t /*chunk key*/, TileChunk> _chunks;
+    /** keys of the chunks intersecting the camera, in drawing order */
+    std::vector<uint64_t> _visibleChunks;
+    /** tiles overlap their neighbours or are sorted by vertexZ, so the visible chunks are drawn interleaved by band
+     * to keep the drawing order of the whole layer */
+    bool _drawInLayerOrder = false;
+    std::vector<TileDrawRange> _drawRanges;
+    /** draw the ranges of the chunks drawn interleaved */
+    std::vector<CustomCommand*> _bandCommands;
+    TileChunkLoader _tileChunkLoader;
+    /** scratch memory to build the vertices of a chunk */
+    std::vector<V3F_C4B_T2F_Quad> _chunkQuads;
     bool _dirty = true;
 
-    backend::Buffer* _vertexBuffer = nullptr;
-    backend::Buffer* _indexBuffer  = nullptr;
+    /** shared by all chunks, they draw their quads from the start of their vertex buffer */
+    backend::Buffer* _indexBuffer = nullptr;
+    int _indexBufferQuads         = 0;
+    backend::ProgramState* _programState = nullptr;
 
     float _alphaFuncValue = 0.f;
-    std::unordered_map<int, CustomCommand*> _customCommands;
 
     backend::UniformLocation _mvpMatrixLocaiton;
     backend::UniformLocation _textureLocation;
@@ -37,6 +37,7 @@
 #include "base/EventListenerCustom.h"
 #include "base/EventDispatcher.h"
 #include "base/EventType.h"
+#include "base/AsyncTaskPool.h"
 
 #include "simdjson/simdjson.h"
 #include "zlib.h"
@@ -53,6 +54,121 @@ const int FontAtlas::CacheTextureHeight    = 512;
 const char* FontAtlas::CMD_PURGE_FONTATLAS = "__ax_PURGE_FONTATLAS";
 const char* FontAtlas::CMD_RESET_FONTATLAS = "__ax_RESET_FONTATLAS";
 
+// Returns a bitmap owned by the caller. The bitmap of a glyph without outline lives in the FreeType glyph slot, which
+// the next glyph loaded overwrites, the outline ones are blended into a buffer of their own.
+static uint8_t* takeGlyphBitmap(const FontFreeType* renderer, uint8_t* bitmap, int width, int height)
+{
+    if (!bitmap || width <= 0 || height <= 0)
+        return nullptr;
+    if (renderer->getOutlineSize() > 0)
+        return bitmap;
+
+    auto copy = new uint8_t[width * height];
+    memcpy(copy, bitmap, width * height);
+    return copy;
+}
+
+void SkylinePacker::reset(int width, int height)
+{
+    _width  = width;
+    _height = height;
+    _skyline.clear();
+    _skyline.emplace_back(Segment{0, 0, width});
+}
+
+void SkylinePacker::reset(int width, int height, int x, int top, int y)
+{
+    _width  = width;
+    _height = height;
+    _skyline.clear();
+    x = std::clamp(x, 0, width);
+    if (x > 0)
+        _skyline.emplace_back(Segment{0, top, x});
+    if (x < width)
+        _skyline.emplace_back(Segment{x, y, width - x});
+}
+
+int SkylinePacker::fitAt(size_t index, int width, int height) const
+{
+    if (_skyline[index].x + width > _width)
+        return -1;
+
+    // the rectangle rests on the highest segment under it
+    int y         = 0;
+    int remaining = width;
+    for (size_t i = index; remaining > 0; ++i)
+    {
+        y = (std::max)(y, _skyline[i].y);
+        if (y + height > _height)
+            return -1;
+        remaining -= _skyline[i].width;
+    }
+    return y;
+}
+
+bool SkylinePacker::insert(int width, int height, int& outX, int& outY)
+{
+    size_t bestIndex = _skyline.size();
+    int bestBottom   = (std::numeric_limits<int>::max)();
+    int bestWidth    = 0;
+    for (size_t i = 0; i < _skyline.size(); ++i)
+    {
+        int y = fitAt(i, width, height);
+        if (y < 0)
+            continue;
+        if (y + height < bestBottom || (y + height == bestBottom && _skyline[i].width < bestWidth))
+        {
+            bestIndex  = i;
+            bestBottom = y + height;
+            bestWidth  = _skyline[i].width;
+            outY       = y;
+        }
+    }
+    if (bestIndex == _skyline.size())
+        return false;
+
+    outX = _skyline[bestIndex].x;
+    _skyline.insert(_skyline.begin() + bestIndex, Segment{outX, bestBottom, width});
+
+    // cut the segments now under the new one
+    const int right = outX + width;
+    for (size_t i = bestIndex + 1; i < _skyline.size();)
+    {
+        auto& segment = _skyline[i];
+        if (segment.x >= right)
+            break;
+        int overlap = right - segment.x;
+        if (segment.width > overlap)
+        {
+            segment.x += overlap;
+            segment.width -= overlap;
+            break;
+        }
+        _skyline.erase(_skyline.begin() + i);
+    }
+
+    // merge the neighbours of equal height
+    for (size_t i = 1; i < _skyline.size();)
+    {
+        if (_skyline[i - 1].y == _skyline[i].y)
+        {
+            _skyline[i - 1].width += _skyline[i].width;
+            _skyline.erase(_skyline.begin() + i);
+        }
+        else
+            ++i;
+    }
+    return true;
+}
+
+int SkylinePacker::getUsedHeight() const
+{
+    int height = 0;
+    for (auto&& segment : _skyline)
+        height = (std::max)(height, segment.y);
+    return height;
+}
+
 void FontAtlas::loadFontAtlas(std::string_view fontatlasFile, hlookup::string_map<FontAtlas*>& outAtlasMap)
 {
     using namespace simdjson;
@@ -193,6 +309,7 @@ FontAtlas::~FontAtlas()
 #endif
 
     _font->release();
+    AX_SAFE_RELEASE(_asyncFontFreeType);
     releaseTextures();
 
     AX_SAFE_DELETE_ARRAY(_currentPageData);
@@ -217,6 +334,13 @@ void FontAtlas::initWithSettings(void* opaque /*simdjson::ondemand::document*/)
     _currentPageOrigX = static_cast<float>(settings["pageX"].get_double());
     _currentPageOrigY = static_cast<float>(settings["pageY"].get_double());
 
+    // older assets store the position in the last row of a shelf, keep the whole row
+    _packer.reset(_width, _height, static_cast<int>(_currentPageOrigX),
+                  static_cast<int>(_currentPageOrigY + _lineHeight) + _letterPadding + _letterEdgeExtend,
+                  static_cast<int>(_currentPageOrigY));
+    _currentPageOrigX = 0;
+    _currentPageOrigY = static_cast<float>(_packer.getUsedHeight());
+
     // letters
     FontLetterDefinition tempDef;
     tempDef.rotated         = false;
@@ -250,10 +374,10 @@ void FontAtlas::reset()
 {
     releaseTextures();
 
-    _currLineHeight   = 0;
     _currentPageOrigX = 0;
     _currentPageOrigY = 0;
     _letterDefinitions.clear();
+    _pageLastUse.clear();
 
     reinit();
 }
@@ -325,8 +449,13 @@ void FontAtlas::findNewCharacters(const std::u32string& u32Text, std::unordered_
     else
     {
         for (auto&& charCode : u32Text)
-            if (_letterDefinitions.find(charCode) == _letterDefinitions.end())
+        {
+            auto it = _letterDefinitions.find(charCode);
+            if (it == _letterDefinitions.end())
                 charset.insert(charCode);
+            else if (it->second.width > 0 && static_cast<size_t>(it->second.textureID) < _pageLastUse.size())
+                _pageLastUse[it->second.textureID] = _frame;
+        }
     }
 }
 
@@ -340,6 +469,8 @@ bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
     if (!_currentPageData)
         reinit();
 
+    _frame = Director::getInstance()->getTotalFrames();
+
     std::unordered_set<char32_t> charCodeSet;
     findNewCharacters(utf32Text, charCodeSet);
     if (charCodeSet.empty())
@@ -347,103 +478,190 @@ bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
         return false;
     }
 
-    int adjustForDistanceMap = _letterPadding / 2;
-    int adjustForExtend      = _letterEdgeExtend / 2;
-    int bitmapWidth          = 0;
-    int bitmapHeight         = 0;
-    int glyphHeight;
-    Rect tempRect;
-    FontLetterDefinition tempDef;
+    std::vector<GlyphBitmap> glyphs;
+    glyphs.reserve(charCodeSet.size());
+    for (auto&& charCode : charCodeSet)
+    {
+        rasterizeGlyph(glyphs.emplace_back(GlyphBitmap{charCode, nullptr, 0, 0, Rect::ZERO, 0, _fontFreeType}));
+    }
+    addGlyphs(glyphs);
 
-    auto pixelFormat = _pixelFormat;
+    return true;
+}
 
-    int startY = (int)_currentPageOrigY;
+void FontAtlas::prepareLetterDefinitionsAsync(const std::u32string& utf32Text)
+{
+    if (_fontFreeType == nullptr)
+    {
+        return;
+    }
 
+    if (!_currentPageData)
+        reinit();
+
+    if (!_asyncFontFreeType)
+    {
+        // FreeType faces can't be shared between threads
+        _asyncFontFreeType = _fontFreeType->clone();
+        if (!_asyncFontFreeType)
+            return;
+        _asyncFontFreeType->retain();
+    }
+
+    _frame = Director::getInstance()->getTotalFrames();
+
+    std::unordered_set<char32_t> charCodeSet;
+    findNewCharacters(utf32Text, charCodeSet);
+
+    auto glyphs = std::make_shared<std::vector<GlyphBitmap>>();
     for (auto&& charCode : charCodeSet)
     {
-        auto missingIt             = _missingGlyphFallbackFonts.find(charCode);
-        uint8_t* bitmap            = nullptr;
-        FontFreeType* charRenderer = _fontFreeType;
-        if (missingIt == _missingGlyphFallbackFonts.end())
-        {
-            FontFaceInfo* fallbackFaceInfo = nullptr;
-            bitmap = charRenderer->getGlyphBitmap(charCode, bitmapWidth, bitmapHeight, tempRect, tempDef.xAdvance,
-                                                  &fallbackFaceInfo);
-            if (!bitmap && fallbackFaceInfo)
+        if (_asyncCharCodes.insert(charCode).second)
+            glyphs->emplace_back(GlyphBitmap{charCode, nullptr, 0, 0, Rect::ZERO, 0, _fontFreeType});
+    }
+    if (glyphs->empty())
+    {
+        return;
+    }
+
+    auto font = _asyncFontFreeType;
+    this->retain();
+    AsyncTaskPool::getInstance()->enqueue(
+        AsyncTaskPool::TaskType::TASK_OTHER,
+        [this, glyphs](void*) {
+            _frame = Director::getInstance()->getTotalFrames();
+
+            // drop the glyphs that labels rasterized meanwhile
+            size_t count = 0;
+            for (auto&& glyph : *glyphs)
             {
-                auto fallbackIt = _missingFallbackFonts.find(fallbackFaceInfo->family);
-                if (fallbackIt != _missingFallbackFonts.end())
-                {
-                    charRenderer = fallbackIt->second;
-                }
+                _asyncCharCodes.erase(glyph.charCode);
+                if (glyph.renderer && _letterDefinitions.find(glyph.charCode) == _letterDefinitions.end())
+                    (*glyphs)[count++] = glyph;
                 else
+                    delete[] glyph.bitmap;
+            }
+            glyphs->resize(count);
+            if (!glyphs->empty())
+                addGlyphs(*glyphs);
+
+            this->release();
+        },
+        nullptr,
+        [font, glyphs]() {
+            for (auto&& glyph : *glyphs)
+            {
+                if (!font->hasGlyph(glyph.charCode))
                 {
-                    charRenderer = FontFreeType::createWithFaceInfo(fallbackFaceInfo, _fontFreeType);
-                    if (charRenderer)
-                        _missingFallbackFonts.insert(fallbackFaceInfo->family, charRenderer);
+                    // left to prepareLetterDefinitions, which looks up the fallback fonts
+                    glyph.renderer = nullptr;
+                    continue;
                 }
+                auto bitmap =
+                    font->getGlyphBitmap(glyph.charCode, glyph.width, glyph.height, glyph.rect, glyph.xAdvance);
+                glyph.bitmap = takeGlyphBitmap(font, bitmap, glyph.width, glyph.height);
+            }
+        });
+}
 
+void FontAtlas::rasterizeGlyph(GlyphBitmap& glyph)
+{
+    auto charCode              = glyph.charCode;
+    auto missingIt             = _missingGlyphFallbackFonts.find(charCode);
+    FontFreeType* charRenderer = _fontFreeType;
+    if (missingIt == _missingGlyphFallbackFonts.end())
+    {
+        FontFaceInfo* fallbackFaceInfo = nullptr;
+        glyph.bitmap = charRenderer->getGlyphBitmap(charCode, glyph.width, glyph.height, glyph.rect, glyph.xAdvance,
+                                                    &fallbackFaceInfo);
+        if (!glyph.bitmap && fallbackFaceInfo)
+        {
+            auto fallbackIt = _missingFallbackFonts.find(fallbackFaceInfo->family);
+            if (fallbackIt != _missingFallbackFonts.end())
+            {
+                charRenderer = fallbackIt->second;
+            }
+            else
+            {
+                charRenderer = FontFreeType::createWithFaceInfo(fallbackFaceInfo, _fontFreeType);
                 if (charRenderer)
-                {
-                    unsigned int glyphIndex = fallbackFaceInfo->currentGlyphIndex;
-                    bitmap =
-                        charRenderer->getGlyphBitmapByIndex(glyphIndex, bitmapWidth, bitmapHeight, tempRect, tempDef.xAdvance);
-                    _missingGlyphFallbackFonts.emplace(charCode, std::make_pair(charRenderer, glyphIndex));
-                }
+                    _missingFallbackFonts.insert(fallbackFaceInfo->family, charRenderer);
             }
-        }
-        else
-        {  // found fallback font for missing charas, getGlyphBitmap without fallback
-            charRenderer = missingIt->second.first;
-            unsigned int glyphIndex = missingIt->second.second;
-            bitmap = charRenderer->getGlyphBitmapByIndex(glyphIndex, bitmapWidth, bitmapHeight, tempRect, tempDef.xAdvance);
-        }
-        if (bitmap && bitmapWidth > 0 && bitmapHeight > 0)
-        {
-            tempDef.validDefinition = true;
-            tempDef.width           = tempRect.size.width + _letterPadding + _letterEdgeExtend;
-            tempDef.height          = tempRect.size.height + _letterPadding + _letterEdgeExtend;
-            tempDef.offsetX         = tempRect.origin.x - adjustForDistanceMap - adjustForExtend;
-            tempDef.offsetY         = _fontAscender + tempRect.origin.y - adjustForDistanceMap - adjustForExtend;
 
-            if (_currentPageOrigX + tempDef.width > _width)
+            if (charRenderer)
             {
-                _currentPageOrigY += _currLineHeight;
-                _currLineHeight   = 0;
-                _currentPageOrigX = 0;
-                if (_currentPageOrigY + _lineHeight + _letterPadding + _letterEdgeExtend >= _height)
-                {
-                    updateTextureContent(pixelFormat, startY);
+                unsigned int glyphIndex = fallbackFaceInfo->currentGlyphIndex;
+                glyph.bitmap = charRenderer->getGlyphBitmapByIndex(glyphIndex, glyph.width, glyph.height, glyph.rect,
+                                                                   glyph.xAdvance);
+                _missingGlyphFallbackFonts.emplace(charCode, std::make_pair(charRenderer, glyphIndex));
+            }
+        }
+    }
+    else
+    {  // found fallback font for missing charas, getGlyphBitmap without fallback
+        charRenderer            = missingIt->second.first;
+        unsigned int glyphIndex = missingIt->second.second;
+        glyph.bitmap =
+            charRenderer->getGlyphBitmapByIndex(glyphIndex, glyph.width, glyph.height, glyph.rect, glyph.xAdvance);
+    }
+    glyph.renderer = charRenderer;
+    if (charRenderer)
+        glyph.bitmap = takeGlyphBitmap(charRenderer, glyph.bitmap, glyph.width, glyph.height);
+}
 
-                    startY = 0;
+void FontAtlas::addGlyphs(std::vector<GlyphBitmap>& glyphs)
+{
+    int adjustForDistanceMap = _letterPadding / 2;
+    int adjustForExtend      = _letterEdgeExtend / 2;
+    int extend               = _letterPadding + _letterEdgeExtend;
 
-                    addNewPage();
-                }
-            }
-            glyphHeight = static_cast<int>(bitmapHeight) + _letterPadding + _letterEdgeExtend;
-            if (glyphHeight > _currLineHeight)
+    // the tallest glyphs first, so the shorter ones fill the steps of the skyline
+    std::sort(glyphs.begin(), glyphs.end(),
+              [](const GlyphBitmap& a, const GlyphBitmap& b) { return a.height > b.height; });
+
+    FontLetterDefinition tempDef;
+    tempDef.rotated = false;
+
+    for (auto&& glyph : glyphs)
+    {
+        int x = 0, y = 0;
+        bool packed = false;
+        int packedWidth  = static_cast<int>(glyph.rect.size.width) + extend + 1;
+        int packedHeight = glyph.height + extend;
+        if (glyph.bitmap && glyph.width > 0 && glyph.height > 0)
+        {
+            packed = _packer.insert(packedWidth, packedHeight, x, y);
+            if (!packed)
             {
-                _currLineHeight = glyphHeight;
+                nextPage();
+                packed = _packer.insert(packedWidth, packedHeight, x, y);
             }
-            charRenderer->renderCharAt(_currentPageData, (int)_currentPageOrigX + adjustForExtend,
-                                       (int)_currentPageOrigY + adjustForExtend, bitmap, bitmapWidth, bitmapHeight,
-                                        _width, _height);
-
-            tempDef.U         = _currentPageOrigX;
-            tempDef.V         = _currentPageOrigY;
-            tempDef.textureID = _currentPage;
-            _currentPageOrigX += tempDef.width + 1;
+        }
+
+        tempDef.xAdvance = glyph.xAdvance;
+        if (packed)
+        {
+            glyph.renderer->renderCharAt(_currentPageData, x + adjustForExtend, y + adjustForExtend, glyph.bitmap,
+                                         glyph.width, glyph.height, _width, _height);
+            // renderCharAt frees the outline bitmaps only
+            if (glyph.renderer->getOutlineSize() <= 0)
+                delete[] glyph.bitmap;
+            _dirtyTop    = (std::min)(_dirtyTop, y);
+            _dirtyBottom = (std::max)(_dirtyBottom, y + packedHeight);
+
+            tempDef.validDefinition = true;
+            tempDef.offsetX         = glyph.rect.origin.x - adjustForDistanceMap - adjustForExtend;
+            tempDef.offsetY         = _fontAscender + glyph.rect.origin.y - adjustForDistanceMap - adjustForExtend;
+            tempDef.textureID       = _currentPage;
             // take from pixels to points
-            tempDef.width   = tempDef.width / _scaleFactor;
-            tempDef.height  = tempDef.height / _scaleFactor;
-            tempDef.U       = tempDef.U / _scaleFactor;
-            tempDef.V       = tempDef.V / _scaleFactor;
-            tempDef.rotated = false;
+            tempDef.width  = (glyph.rect.size.width + extend) / _scaleFactor;
+            tempDef.height = (glyph.rect.size.height + extend) / _scaleFactor;
+            tempDef.U      = x / _scaleFactor;
+            tempDef.V      = y / _scaleFactor;
         }
         else
         {
-            if (bitmap)
-                delete[] bitmap;
+            delete[] glyph.bitmap;
 
             tempDef.validDefinition = !!tempDef.xAdvance;
             tempDef.width           = 0;
@@ -453,23 +671,79 @@ bool FontAtlas::prepareLetterDefinitions(const std::u32string& utf32Text)
             tempDef.offsetX         = 0;
             tempDef.offsetY         = 0;
             tempDef.textureID       = 0;
-            tempDef.rotated         = false;
-            _currentPageOrigX += 1;
         }
 
-        _letterDefinitions[charCode] = tempDef;
+        _letterDefinitions[glyph.charCode] = tempDef;
     }
 
-    updateTextureContent(pixelFormat, startY);
+    updateTextureContent();
+    _currentPageOrigY = static_cast<float>(_packer.getUsedHeight());
+}
 
-    return true;
+void FontAtlas::nextPage()
+{
+    updateTextureContent();
+
+    int page = findEvictablePage();
+    if (page < 0)
+        addNewPage();
+    else
+        evictPage(page);
 }
 
-void FontAtlas::updateTextureContent(backend::PixelFormat format, int startY)
+int FontAtlas::findEvictablePage() const
 {
-    auto data = _currentPageData + (_width * (int)startY << _strideShift);
-    _atlasTextures[_currentPage]->updateWithSubData(data, 0, startY, _width,
-                                                    (std::min)((int)_currentPageOrigY - startY + _currLineHeight, _height));
+    if (_maxPageCount <= 0 || static_cast<int>(_atlasTextures.size()) < _maxPageCount)
+        return -1;
+
+    // the least recently used page. The pages used in the previous frame are still on screen, labels visited
+    // later in this frame draw them again
+    int page = -1;
+    for (int i = 0; i < static_cast<int>(_pageLastUse.size()); ++i)
+    {
+        if (i != _currentPage && _pageLastUse[i] + 1 < _frame &&
+            (page < 0 || _pageLastUse[i] < _pageLastUse[page]))
+            page = i;
+    }
+    return page;
+}
+
+void FontAtlas::markPageUsed(int page)
+{
+    if (static_cast<size_t>(page) < _pageLastUse.size())
+        _pageLastUse[page] = Director::getInstance()->getTotalFrames();
+}
+
+void FontAtlas::evictPage(int page)
+{
+    for (auto it = _letterDefinitions.begin(); it != _letterDefinitions.end();)
+    {
+        if (it->second.textureID == page && it->second.width > 0)
+            it = _letterDefinitions.erase(it);
+        else
+            ++it;
+    }
+
+    // the texture stays, so do the batch nodes of the labels, which are laid out again on their next visit
+    memset(_currentPageData, 0, _currentPageDataSize);
+    _currentPage       = page;
+    _pageLastUse[page] = _frame;
+    _currentPageOrigY  = 0;
+    _packer.reset(_width, _height);
+    _dirtyTop    = _height;
+    _dirtyBottom = 0;
+    ++_evictionCount;
+}
+
+void FontAtlas::updateTextureContent()
+{
+    if (_dirtyTop < _dirtyBottom)
+    {
+        auto data = _currentPageData + (_width * _dirtyTop << _strideShift);
+        _atlasTextures[_currentPage]->updateWithSubData(data, 0, _dirtyTop, _width, _dirtyBottom - _dirtyTop);
+    }
+    _dirtyTop    = _height;
+    _dirtyBottom = 0;
 }
 
 void FontAtlas::addNewPage()
@@ -478,6 +752,9 @@ void FontAtlas::addNewPage()
     addNewPageWithData(_currentPageData, _currentPageDataSize);
 
     _currentPageOrigY = 0;
+    _packer.reset(_width, _height);
+    _dirtyTop    = _height;
+    _dirtyBottom = 0;
 }
 
 void FontAtlas::addNewPageWithData(const uint8_t* data, size_t size)
@@ -494,6 +771,9 @@ void FontAtlas::addNewPageWithData(const uint8_t* data, size_t size)
 
     setTexture(++_currentPage, texture);
     texture->release();
+
+    _pageLastUse.resize(_currentPage + 1);
+    _pageLastUse[_currentPage] = _frame;
 }
 
 void FontAtlas::setTexture(unsigned int slot, Texture2D* texture)
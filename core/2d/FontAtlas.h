@@ -32,6 +32,8 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "platform/PlatformMacros.h"
 #include "base/Object.h"
@@ -63,6 +65,40 @@ struct FontLetterDefinition
     bool rotated;
 };
 
+/**
+ * Bottom-left skyline packer for the glyphs of a font atlas page.
+ * The skyline is the top outline of the placed rectangles, which lets a glyph fill the gap beside a taller one
+ * where a row shelf wastes the space up to the tallest glyph of the row.
+ */
+class AX_DLL SkylinePacker
+{
+public:
+    void reset(int width, int height);
+
+    /** Marks the area above a skyline made of [0, x) at height top and [x, width) at height y as used. */
+    void reset(int width, int height, int x, int top, int y);
+
+    /** Finds the lowest, then leftmost, place of a width x height rectangle, returns false if the page is full. */
+    bool insert(int width, int height, int& outX, int& outY);
+
+    /** The height under the highest part of the skyline. */
+    int getUsedHeight() const;
+
+protected:
+    struct Segment
+    {
+        int x;
+        int y;
+        int width;
+    };
+
+    int fitAt(size_t index, int width, int height) const;
+
+    std::vector<Segment> _skyline;
+    int _width  = 0;
+    int _height = 0;
+};
+
 class AX_DLL FontAtlas : public Object
 {
 public:
@@ -87,6 +123,29 @@ public:
 
     bool prepareLetterDefinitions(const std::u32string& utf16String);
 
+    /**
+     * Rasterizes the new glyphs of a text on a worker thread, then packs and uploads them on the main thread
+     * once they are ready. Use it to warm up the atlas with text that is about to be shown, such as incoming chat
+     * messages; labels laid out before the glyphs arrive rasterize them synchronously as usual.
+     */
+    void prepareLetterDefinitionsAsync(const std::u32string& utf32Text);
+
+    /**
+     * Bounds the number of atlas pages. Once reached, the page least recently used by labels is cleared and
+     * reused for new glyphs, and the labels still showing its glyphs are laid out again.
+     * Pages laid out or drawn in the current or the previous frame are never cleared, so the limit may be exceeded
+     * while more pages are on screen.
+     * @param count The maximum number of pages, 0 for unbounded (default).
+     */
+    void setMaxPageCount(int count) { _maxPageCount = count; }
+    int getMaxPageCount() const { return _maxPageCount; }
+
+    /** Records that a label draws glyphs of a page in this frame, so the page isn't evicted while on screen. */
+    void markPageUsed(int page);
+
+    /** How many times a page was cleared to make room, letter definitions taken before then may be stale. */
+    unsigned int getEvictionCount() const { return _evictionCount; }
+
     const auto& getLetterDefinitions() const { return _letterDefinitions; }
 
     const std::unordered_map<unsigned int, Texture2D*>& getTextures() const { return _atlasTextures; }
@@ -138,6 +197,29 @@ protected:
 
     void findNewCharacters(const std::u32string& u32Text, std::unordered_set<char32_t>& charCodeSet);
 
+    struct GlyphBitmap
+    {
+        char32_t charCode;
+        uint8_t* bitmap;
+        int width;
+        int height;
+        Rect rect;
+        int xAdvance;
+        FontFreeType* renderer;
+    };
+
+    /** Rasterizes the glyph into a bitmap of its own, so it stays valid while more glyphs are rasterized. */
+    void rasterizeGlyph(GlyphBitmap& glyph);
+
+    /** Packs rasterized glyphs into the pages, takes the ownership of their bitmaps. */
+    void addGlyphs(std::vector<GlyphBitmap>& glyphs);
+
+    void nextPage();
+
+    int findEvictablePage() const;
+
+    void evictPage(int page);
+
     /**
      * Scale each font letter by scaleFactor.
      *
@@ -145,7 +227,8 @@ protected:
      */
     void scaleFontLetterDefinition(float scaleFactor);
 
-    void updateTextureContent(backend::PixelFormat format, int startY);
+    /** Uploads the rows of the current page written since the last upload. */
+    void updateTextureContent();
 
     std::unordered_map<unsigned int, Texture2D*> _atlasTextures;
     std::unordered_map<char32_t, FontLetterDefinition> _letterDefinitions;
@@ -169,15 +252,29 @@ protected:
     uint8_t* _currentPageData         = nullptr;
     int _currentPageDataSize          = 0;
 
+    // the used height of the current page, _currentPageOrigX is always 0 since the skyline packing
     float _currentPageOrigX = 0;
     float _currentPageOrigY = 0;
     int _letterPadding      = 0;
     int _letterEdgeExtend   = 0;
 
+    SkylinePacker _packer;
+    int _dirtyTop    = 0;
+    int _dirtyBottom = 0;
+
+    // the frame each page was last used in, for the LRU eviction
+    std::vector<unsigned int> _pageLastUse;
+    unsigned int _frame         = 0;
+    int _maxPageCount           = 0;
+    unsigned int _evictionCount = 0;
+
+    // a FreeType face of our own for prepareLetterDefinitionsAsync and the characters it is working on
+    FontFreeType* _asyncFontFreeType = nullptr;
+    std::unordered_set<char32_t> _asyncCharCodes;
+
     int _fontAscender                               = 0;
     EventListenerCustom* _rendererRecreatedListener = nullptr;
     bool _antialiasEnabled                          = true;
-    int _currLineHeight                             = 0;
 
     friend class Label;
 };
@@ -149,6 +149,22 @@ FontFreeType* FontFreeType::create(std::string_view fontName,
     return nullptr;
 }
 
+FontFreeType* FontFreeType::clone() const
+{
+    FontFreeType* tempFont = new FontFreeType(_distanceFieldEnabled, _outlineSize / AX_CONTENT_SCALE_FACTOR());
+
+    tempFont->setGlyphCollection(_usedGlyphs, _customGlyphs);
+
+    if (tempFont->initWithFontPath(_fontName, _faceSize))
+    {
+        tempFont->autorelease();
+        return tempFont;
+    }
+
+    delete tempFont;
+    return nullptr;
+}
+
 bool FontFreeType::initFreeType()
 {
     if (!_FTInitialized)
@@ -469,6 +485,11 @@ unsigned char* FontFreeType::getGlyphBitmap(char32_t charCode,
     return getGlyphBitmapByIndex(glyphIndex, outWidth, outHeight, outRect, xAdvance);
 }
 
+bool FontFreeType::hasGlyph(char32_t charCode) const
+{
+    return FT_Get_Char_Index(_fontFace, static_cast<FT_ULong>(charCode)) != 0;
+}
+
 unsigned char* FontFreeType::getGlyphBitmapByIndex(unsigned int glyphIndex,
                                                    int& outWidth,
                                                    int& outHeight,
@@ -101,6 +101,12 @@ public:
 
     static FontFreeType* createWithFaceInfo(FontFaceInfo* info, FontFreeType* mainFont);
 
+    /**
+     * Create a font with the same settings but its own FreeType face, so glyphs can be rasterized with it on
+     * another thread while this one stays in use.
+     */
+    FontFreeType* clone() const;
+
     static void shutdownFreeType();
 
     bool isDistanceFieldEnabled() const { return _distanceFieldEnabled; }
@@ -125,6 +131,8 @@ public:
                                   int& xAdvance,
                                   FontFaceInfo** ppFallbackInfo = nullptr);
 
+    bool hasGlyph(char32_t charCode) const;
+
     unsigned char* getGlyphBitmapByIndex(unsigned int glyphIndex,
                                          int& outWidth,
                                          int& outHeight,
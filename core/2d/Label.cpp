@@ -500,6 +500,7 @@ Label::Label(TextHAlignment hAlignment /* = TextHAlignment::LEFT */,
     : _textSprite(nullptr)
     , _shadowNode(nullptr)
     , _fontAtlas(nullptr)
+    , _fontAtlasEvictionCount(0)
     , _reusedLetter(nullptr)
     , _horizontalKernings(nullptr)
     , _boldEnabled(false)
@@ -525,6 +526,7 @@ Label::Label(TextHAlignment hAlignment /* = TextHAlignment::LEFT */,
             }
             _batchNodes.clear();
             _batchCommands.clear();
+            _layoutCache.valid = false;
 
             if (_fontAtlas)
             {
@@ -586,6 +588,7 @@ void Label::reset()
     _batchNodes.clear();
     _batchCommands.clear();
     _lettersInfo.clear();
+    _layoutCache.valid = false;
     if (_fontAtlas)
     {
         FontAtlasCache::releaseFontAtlas(_fontAtlas);
@@ -792,7 +795,8 @@ void Label::setFontAtlas(FontAtlas* atlas, bool distanceFieldEnabled /* = false
         _batchNodes.clear();
         FontAtlasCache::releaseFontAtlas(_fontAtlas);
     }
-    _fontAtlas = atlas;
+    _fontAtlas         = atlas;
+    _layoutCache.valid = false;
 
     if (_reusedLetter == nullptr)
     {
@@ -944,7 +948,7 @@ void Label::setString(std::string_view text)
         std::u32string utf32String;
         if (StringUtils::UTF8ToUTF32(_utf8Text, utf32String))
         {
-            _utf32Text = utf32String;
+            _utf32Text = std::move(utf32String);
         }
     }
 }
@@ -1092,6 +1096,7 @@ bool Label::alignText()
     do
     {
         _fontAtlas->prepareLetterDefinitions(_utf32Text);
+        _fontAtlasEvictionCount = _fontAtlas->getEvictionCount();
         auto& textures = _fontAtlas->getTextures();
         auto size      = textures.size();
         if (size > static_cast<size_t>(_batchNodes.size()))
@@ -1123,7 +1128,6 @@ bool Label::alignText()
 
         _lengthOfString    = 0;
         _textDesiredHeight = 0.f;
-        _linesWidth.clear();
         if (_maxLineWidth > 0.f && !_lineBreakWithoutSpaces)
         {
             multilineTextWrapByWord();
@@ -1193,16 +1197,91 @@ bool Label::isHorizontalClamped(float letterPositionX, int lineIndex)
     }
 }
 
-bool Label::updateQuads()
+int Label::reuseQuads()
 {
-    bool ret = true;
-    for (auto&& batchNode : _batchNodes)
+    auto& cache = _layoutCache;
+    // letter sprites may have changed the quads they own
+    int count = (cache.quadsValid && _letters.empty()) ? cache.reusedLetters : 0;
+    cache.quadsValid = false;
+
+    bool clamped = _labelWidth > 0.f || _labelHeight > 0.f;
+    if (count > 0 && (cache.evictionCount != _fontAtlasEvictionCount || cache.batchNodeCount != static_cast<std::size_t>(_batchNodes.size()) ||
+                      cache.overflow != _overflow || cache.labelDimensions != Vec2(_labelWidth, _labelHeight)))
+        count = 0;
+    // clamped letters depend on where they are in the label, the others may simply be moved
+    float offsetY = _letterOffsetY - cache.letterOffsetY;
+    if (count > 0 && clamped &&
+        (offsetY != 0.f || cache.contentSize != _contentSize || cache.tailoredTopY != _tailoredTopY ||
+         cache.tailoredBottomY != _tailoredBottomY))
+        count = 0;
+
+    int kept = 0;
+    for (; kept < count; ++kept)
     {
-        batchNode->getTextureAtlas()->removeAllQuads();
+        auto& letterInfo = _lettersInfo[kept];
+        if (letterInfo.valid && (static_cast<std::size_t>(letterInfo.lineIndex) >= cache.linesOffsetX.size() ||
+                                 (clamped && _linesOffsetX[letterInfo.lineIndex] !=
+                                                 cache.linesOffsetX[letterInfo.lineIndex])))
+            break;
     }
 
-    for (int ctr = 0; ctr < _lengthOfString; ++ctr)
+    // the quads are appended in letter order, so the ones of the kept letters come first in every atlas
+    std::vector<ssize_t> quadCounts(_batchNodes.size(), 0);
+    for (int ctr = 0; ctr < kept; ++ctr)
+    {
+        auto& letterInfo = _lettersInfo[ctr];
+        if (letterInfo.valid && letterInfo.atlasIndex >= 0)
+        {
+            auto textureID = _fontAtlas->_letterDefinitions[letterInfo.utf32Char].textureID;
+            quadCounts[textureID] = std::max(quadCounts[textureID], static_cast<ssize_t>(letterInfo.atlasIndex) + 1);
+        }
+    }
+    for (ssize_t i = 0, size = _batchNodes.size(); i < size; ++i)
+    {
+        if (quadCounts[i] > static_cast<ssize_t>(_batchNodes.at(i)->getTextureAtlas()->getTotalQuads()))
+            kept = 0;
+    }
+    for (ssize_t i = 0, size = _batchNodes.size(); i < size; ++i)
+    {
+        auto textureAtlas = _batchNodes.at(i)->getTextureAtlas();
+        if (kept == 0)
+            textureAtlas->removeAllQuads();
+        else
+            textureAtlas->removeQuadsAtIndex(quadCounts[i], textureAtlas->getTotalQuads() - quadCounts[i]);
+    }
+
+    // follow the alignment of their lines
+    for (int ctr = 0; ctr < kept; ++ctr)
+    {
+        auto& letterInfo = _lettersInfo[ctr];
+        if (!letterInfo.valid || letterInfo.atlasIndex < 0)
+            continue;
+        float offsetX = _linesOffsetX[letterInfo.lineIndex] - cache.linesOffsetX[letterInfo.lineIndex];
+        if (offsetX == 0.f && offsetY == 0.f)
+            continue;
+        auto textureID    = _fontAtlas->_letterDefinitions[letterInfo.utf32Char].textureID;
+        auto textureAtlas = _batchNodes.at(textureID)->getTextureAtlas();
+        auto quad         = textureAtlas->getQuads()[letterInfo.atlasIndex];
+        for (auto vertex : {&quad.tl, &quad.bl, &quad.tr, &quad.br})
+        {
+            vertex->vertices.x += offsetX;
+            vertex->vertices.y += offsetY;
+        }
+        textureAtlas->updateQuad(quad, letterInfo.atlasIndex);
+    }
+
+    return kept;
+}
+
+bool Label::updateQuads()
+{
+    bool ret = true;
+    // the letters of the unchanged prefix of the text keep their quads
+    int reused = reuseQuads();
+
+    for (int ctr = reused; ctr < _lengthOfString; ++ctr)
     {
+        _lettersInfo[ctr].atlasIndex = -1;
         if (_lettersInfo[ctr].valid)
         {
             auto& letterDef = _fontAtlas->_letterDefinitions[_lettersInfo[ctr].utf32Char];
@@ -1269,6 +1348,21 @@ bool Label::updateQuads()
         }
     }
 
+    if (ret)
+    {
+        auto& cache           = _layoutCache;
+        cache.quadsValid      = true;
+        cache.evictionCount   = _fontAtlasEvictionCount;
+        cache.batchNodeCount  = _batchNodes.size();
+        cache.overflow        = _overflow;
+        cache.labelDimensions = Vec2(_labelWidth, _labelHeight);
+        cache.contentSize     = _contentSize;
+        cache.letterOffsetY   = _letterOffsetY;
+        cache.tailoredTopY    = _tailoredTopY;
+        cache.tailoredBottomY = _tailoredBottomY;
+        cache.linesOffsetX    = _linesOffsetX;
+    }
+
     return ret;
 }
 
@@ -1676,6 +1770,7 @@ void Label::updateContent()
         {
             _batchNodes.clear();
             _batchCommands.clear();
+            _layoutCache.valid = false;
             AX_SAFE_RELEASE_NULL(_reusedLetter);
             FontAtlasCache::releaseFontAtlas(_fontAtlas);
             _fontAtlas = nullptr;
@@ -1690,12 +1785,7 @@ void Label::updateContent()
 
     if (_fontAtlas)
     {
-        std::u32string utf32String;
-        if (StringUtils::UTF8ToUTF32(_utf8Text, utf32String))
-        {
-            _utf32Text = utf32String;
-        }
-
+        // _utf32Text was converted by setString already
         computeHorizontalKernings(_utf32Text);
         updateFinished = alignText();
     }
@@ -1936,20 +2026,14 @@ void Label::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
     {
         return;
     }
-    // Don't do calculate the culling if the transform was not updated
+    // Don't do calculate the culling if neither the transform nor the view projection was updated
     bool transformUpdated = flags & FLAGS_TRANSFORM_DIRTY;
 #if AX_USE_CULLING
-    auto visitingCamera = Camera::getVisitingCamera();
-    auto defaultCamera  = Camera::getDefaultCamera();
-    if (visitingCamera == defaultCamera)
+    auto cullingVersion = renderer->getCullingVersion();
+    if (transformUpdated || cullingVersion != _insideBoundsVersion)
     {
-        _insideBounds = (transformUpdated || visitingCamera->isViewProjectionUpdated())
-                            ? renderer->checkVisibility(transform, _contentSize)
-                            : _insideBounds;
-    }
-    else
-    {
-        _insideBounds = renderer->checkVisibility(transform, _contentSize);
+        _insideBounds        = renderer->checkVisibility(transform, _contentSize);
+        _insideBoundsVersion = cullingVersion;
     }
 
     if (_insideBounds)
@@ -1994,12 +2078,16 @@ void Label::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 
             updateBlendState();
 
-            for (auto&& batchNode : _batchNodes)
+            for (ssize_t page = 0, size = _batchNodes.size(); page < size; ++page)
             {
-                auto textureAtlas = batchNode->getTextureAtlas();
+                auto textureAtlas = _batchNodes.at(page)->getTextureAtlas();
                 if (!textureAtlas->getTotalQuads())
                     continue;
 
+                // a static label isn't laid out again, keep its pages from being evicted while it's drawn
+                if (_fontAtlas)
+                    _fontAtlas->markPageUsed(static_cast<int>(page));
+
                 auto& batch = _batchCommands[i++];
                 for (auto&& command : batch.getCommandArray())
                 {
@@ -2039,7 +2127,8 @@ void Label::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t pare
         return;
     }
 
-    if (_systemFontDirty || _contentDirty)
+    if (_systemFontDirty || _contentDirty ||
+        (_fontAtlas && _fontAtlas->getEvictionCount() != _fontAtlasEvictionCount))
     {
         // Label overflow shrink fix #566
         if (_overflow == Overflow::SHRINK && this->getRenderingFontSize() < _originalFontSize)
@@ -2773,6 +2862,43 @@ void Label::updateFontScale()
     }
 }
 
+int Label::findLayoutCheckpoint(float contentScaleFactor) const
+{
+    auto& cache = _layoutCache;
+    if (!cache.valid || cache.fontAtlas != _fontAtlas || cache.fontScale != _fontScale ||
+        cache.maxLineWidth != _maxLineWidth || cache.lineHeight != _lineHeight || cache.lineSpacing != _lineSpacing ||
+        cache.additionalKerning != _additionalKerning || cache.contentScaleFactor != contentScaleFactor ||
+        cache.enableWrap != _enableWrap || cache.lineBreakWithoutSpaces != _lineBreakWithoutSpaces)
+        return -1;
+
+    auto length = std::min(cache.text.size(), _utf32Text.size());
+    auto prefix = std::mismatch(_utf32Text.begin(), _utf32Text.begin() + length, cache.text.begin()).first -
+                  _utf32Text.begin();
+    // the kerning with the first changed letter moves the next letter of the one before it
+    int lastLetter = static_cast<int>(prefix) - 1;
+    if (lastLetter < 0)
+        return -1;
+
+    auto& checkpoints = cache.checkpoints;
+    auto it           = std::upper_bound(checkpoints.begin(), checkpoints.end(), lastLetter,
+                                         [](int index, const LayoutCheckpoint& checkpoint) { return index < checkpoint.index; });
+    if (it == checkpoints.begin())
+        return -1;
+    --it;
+
+    // the line the changed token starts on depends on whether it fits on the line before
+    if (_enableWrap && _maxLineWidth > 0.f)
+    {
+        int lineIndex = it->lineIndex - 1;
+        if (lineIndex < 0)
+            return -1;
+        it = std::lower_bound(checkpoints.begin(), it, lineIndex,
+                              [](const LayoutCheckpoint& checkpoint, int line) { return checkpoint.lineIndex < line; });
+    }
+
+    return static_cast<int>(it - checkpoints.begin());
+}
+
 bool Label::multilineTextWrap(const std::function<int(const std::u32string&, int, int)>& nextTokenLen)
 {
     int textLen               = getStringLength();
@@ -2791,11 +2917,55 @@ bool Label::multilineTextWrap(const std::function<int(const std::u32string&, int
     FontLetterDefinition letterDef;
     Vec2 letterPosition;
     bool nextChangeSize = true;
+    int index           = 0;
 
     this->updateFontScale();
 
-    for (int index = 0; index < textLen;)
+    // resume from the last token the changes of the text can't have moved
+    auto& cache         = _layoutCache;
+    auto& checkpoints   = cache.checkpoints;
+    int checkpointIndex = findLayoutCheckpoint(contentScaleFactor);
+    if (checkpointIndex >= 0)
+    {
+        auto& checkpoint    = checkpoints[checkpointIndex];
+        index               = checkpoint.index;
+        lineIndex           = checkpoint.lineIndex;
+        nextTokenX          = checkpoint.nextTokenX;
+        nextTokenY          = checkpoint.nextTokenY;
+        letterRight         = checkpoint.letterRight;
+        nextWhitespaceWidth = checkpoint.nextWhitespaceWidth;
+        highestY            = checkpoint.highestY;
+        lowestY             = checkpoint.lowestY;
+        nextChangeSize      = checkpoint.nextChangeSize;
+        checkpoints.resize(checkpointIndex);
+        _linesWidth.resize(lineIndex);
+    }
+    else
     {
+        checkpoints.clear();
+        _linesWidth.clear();
+    }
+    cache.valid                  = true;
+    cache.text                   = _utf32Text;
+    cache.fontAtlas              = _fontAtlas;
+    cache.fontScale              = _fontScale;
+    cache.maxLineWidth           = _maxLineWidth;
+    cache.lineHeight             = _lineHeight;
+    cache.lineSpacing            = _lineSpacing;
+    cache.additionalKerning      = _additionalKerning;
+    cache.contentScaleFactor     = contentScaleFactor;
+    cache.enableWrap             = _enableWrap;
+    cache.lineBreakWithoutSpaces = _lineBreakWithoutSpaces;
+    cache.reusedLetters          = index;
+
+    while (index < textLen)
+    {
+        // a token restarted on a new line replaces the checkpoint of its first try
+        if (checkpoints.empty() || checkpoints.back().index != index)
+            checkpoints.emplace_back();
+        checkpoints.back() = {index,       lineIndex,           nextTokenX, nextTokenY,
+                              letterRight, nextWhitespaceWidth, highestY,   lowestY, nextChangeSize};
+
         char32_t character = _utf32Text[index];
         if (character == StringUtils::UnicodeCharacters::NewLine)
         {
@@ -3004,24 +3174,19 @@ bool Label::isHorizontalClamp()
 
 void Label::shrinkLabelToContentSize(const std::function<bool(void)>& lambda)
 {
-    float fontSize = this->getRenderingFontSize();
-
-    int i                     = 0;
-    auto letterDefinition     = _fontAtlas->_letterDefinitions;
-    auto tempLetterDefinition = letterDefinition;
-    float originalLineHeight  = _lineHeight;
-    bool flag                 = true;
-    while (lambda())
+    if (!lambda())
     {
-        ++i;
-        float newFontSize = fontSize - i;
-        flag              = false;
-        if (newFontSize <= 0)
-        {
-            break;
-        }
-        float scale = newFontSize / fontSize;
-        std::swap(_fontAtlas->_letterDefinitions, tempLetterDefinition);
+        return;
+    }
+
+    float fontSize           = this->getRenderingFontSize();
+    auto letterDefinition    = _fontAtlas->_letterDefinitions;
+    float originalLineHeight = _lineHeight;
+
+    // lays the text out with the font size reduced by step
+    auto isClampedAt = [&](int step) {
+        float scale                    = (fontSize - step) / fontSize;
+        _fontAtlas->_letterDefinitions = letterDefinition;
         _fontAtlas->scaleFontLetterDefinition(scale);
         this->setLineHeight(originalLineHeight * scale);
         if (_maxLineWidth > 0.f && !_lineBreakWithoutSpaces)
@@ -3033,17 +3198,37 @@ void Label::shrinkLabelToContentSize(const std::function<bool(void)>& lambda)
             multilineTextWrapByChar();
         }
         computeAlignmentOffset();
-        tempLetterDefinition = letterDefinition;
-    }
-    this->setLineHeight(originalLineHeight);
-    std::swap(_fontAtlas->_letterDefinitions, letterDefinition);
+        return lambda();
+    };
 
-    if (!flag)
+    // the text only gets smaller with the font, so binary search the smallest step which fits,
+    // rather than laying it out once per step; without any, the font shrinks to nothing
+    int low  = 1;
+    int high = static_cast<int>(std::ceil(fontSize)) - 1;
+    int step = high + 1;
+    while (low <= high)
     {
-        if (fontSize - i >= 0)
+        int middle = (low + high) / 2;
+        if (isClampedAt(middle))
         {
-            this->scaleFontSize(fontSize - i);
+            low = middle + 1;
         }
+        else
+        {
+            step = middle;
+            high = middle - 1;
+        }
+    }
+
+    this->setLineHeight(originalLineHeight);
+    _fontAtlas->_letterDefinitions = std::move(letterDefinition);
+    // laid out with the scaled letters
+    _layoutCache.valid         = false;
+    _layoutCache.reusedLetters = 0;
+
+    if (fontSize - step >= 0)
+    {
+        this->scaleFontSize(fontSize - step);
     }
 }
 
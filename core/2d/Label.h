@@ -746,6 +746,51 @@ protected:
         int lineIndex;
     };
 
+    /** The state of multilineTextWrap when it starts a token, to resume the layout from there. */
+    struct LayoutCheckpoint
+    {
+        int index;
+        int lineIndex;
+        float nextTokenX;
+        float nextTokenY;
+        float letterRight;
+        float nextWhitespaceWidth;
+        float highestY;
+        float lowestY;
+        bool nextChangeSize;
+    };
+
+    /** What the last layout depended on, so that a new string only lays out the letters after the prefix it
+     * shares with the old one, and the quads of the letters before stay in the batch nodes. */
+    struct LayoutCache
+    {
+        bool valid = false;
+        std::u32string text;
+        std::vector<LayoutCheckpoint> checkpoints;
+        FontAtlas* fontAtlas     = nullptr;
+        float fontScale          = 0.f;
+        float maxLineWidth       = 0.f;
+        float lineHeight         = 0.f;
+        float lineSpacing        = 0.f;
+        float additionalKerning  = 0.f;
+        float contentScaleFactor = 0.f;
+        bool enableWrap             = false;
+        bool lineBreakWithoutSpaces = false;
+        //! the letters before it kept their layout in the last multilineTextWrap
+        int reusedLetters = 0;
+
+        bool quadsValid = false;
+        unsigned int evictionCount = 0;
+        std::size_t batchNodeCount = 0;
+        Overflow overflow          = Overflow::NONE;
+        Vec2 labelDimensions;
+        Vec2 contentSize;
+        float letterOffsetY   = 0.f;
+        float tailoredTopY    = 0.f;
+        float tailoredBottomY = 0.f;
+        std::vector<float> linesOffsetX;
+    };
+
     struct BatchCommand
     {
         BatchCommand();
@@ -789,6 +834,8 @@ protected:
     void recordPlaceholderInfo(int letterIndex, char32_t utf16Char);
 
     bool updateQuads();
+    int findLayoutCheckpoint(float contentScaleFactor) const;
+    int reuseQuads();
 
     void createSpriteForSystemFont(const FontDefinition& fontDef);
     void createShadowSpriteForSystemFont(const FontDefinition& fontDef);
@@ -839,6 +886,8 @@ protected:
     bool _blendFuncDirty;
     /// whether or not the label was inside bounds the previous frame
     bool _insideBounds;
+    /// culling version of the view projection _insideBounds was computed with
+    uint32_t _insideBoundsVersion = 0;
     bool _isOpacityModifyRGB;
     bool _enableWrap;
 
@@ -894,6 +943,8 @@ protected:
     Sprite* _shadowNode;
     int* _horizontalKernings;
     FontAtlas* _fontAtlas;
+    //! the eviction count of the atlas when the letters were laid out
+    unsigned int _fontAtlasEvictionCount;
     //! used for optimization
     Sprite* _reusedLetter;
     DrawNode* _underlineNode;
@@ -921,6 +972,8 @@ protected:
     std::vector<float> _linesWidth;
     std::vector<float> _linesOffsetX;
 
+    LayoutCache _layoutCache;
+
     QuadCommand _quadCommand;
 
     std::vector<BatchCommand> _batchCommands;
@@ -44,6 +44,7 @@ THE SOFTWARE.
 #include "2d/Scene.h"
 #include "2d/Component.h"
 #include "renderer/Material.h"
+#include "renderer/Renderer.h"
 #include "math/TransformUtils.h"
 #include "renderer/backend/ProgramManager.h"
 #include "renderer/backend/ProgramStateRegistry.h"
@@ -66,6 +67,14 @@ namespace ax
 // reordered.
 std::uint32_t Node::s_globalOrderOfArrival = 0;
 int Node::__attachedNodeCount              = 0;
+std::uint32_t Node::s_visitEpoch           = 0;
+int Node::s_parallelVisitDepth             = 0;
+
+static inline std::uint32_t nextVisitEpoch(std::uint32_t epoch)
+{
+    // 0 means no precomputed transform
+    return ++epoch != 0 ? epoch : 1;
+}
 
 // MARK: Constructor, Destructor, Init
 
@@ -258,6 +267,7 @@ void Node::setSkewX(float skewX)
 
     _skewX            = skewX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateSubtreeBounds();
 }
 
 float Node::getSkewY() const
@@ -272,6 +282,7 @@ void Node::setSkewY(float skewY)
 
     _skewY            = skewY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateSubtreeBounds();
 }
 
 void Node::setLocalZOrder(int z)
@@ -324,6 +335,7 @@ void Node::setRotation(float rotation)
 
     _rotationZ_X = _rotationZ_Y = rotation;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateSubtreeBounds();
 
     updateRotationQuat();
 }
@@ -339,6 +351,7 @@ void Node::setRotation3D(const Vec3& rotation)
         return;
 
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateSubtreeBounds();
 
     _rotationX = rotation.x;
     _rotationY = rotation.y;
@@ -392,6 +405,7 @@ void Node::setRotationQuat(const Quaternion& quat)
     _rotationQuat = quat;
     updateRotation3D();
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateSubtreeBounds();
 }
 
 Quaternion Node::getRotationQuat() const
@@ -406,6 +420,7 @@ void Node::setRotationSkewX(float rotationX)
 
     _rotationZ_X      = rotationX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateSubtreeBounds();
 
     updateRotationQuat();
 }
@@ -422,6 +437,7 @@ void Node::setRotationSkewY(float rotationY)
 
     _rotationZ_Y      = rotationY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateSubtreeBounds();
 
     updateRotationQuat();
 }
@@ -441,6 +457,7 @@ void Node::setScale(float scale)
 
     _scaleX = _scaleY = _scaleZ = scale;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateSubtreeBounds();
 }
 
 /// scaleX getter
@@ -458,6 +475,7 @@ void Node::setScale(float scaleX, float scaleY)
     _scaleX           = scaleX;
     _scaleY           = scaleY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateSubtreeBounds();
 }
 
 /// scaleX setter
@@ -468,6 +486,7 @@ void Node::setScaleX(float scaleX)
 
     _scaleX           = scaleX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateSubtreeBounds();
 }
 
 /// scaleY getter
@@ -484,6 +503,7 @@ void Node::setScaleZ(float scaleZ)
 
     _scaleZ           = scaleZ;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateSubtreeBounds();
 }
 
 /// scaleY getter
@@ -500,6 +520,7 @@ void Node::setScaleY(float scaleY)
 
     _scaleY           = scaleY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateSubtreeBounds();
 }
 
 /// position getter
@@ -529,6 +550,7 @@ void Node::setPosition(float x, float y)
     _position.y = y;
 
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateSubtreeBounds();
     _usingNormalizedPosition                            = false;
 }
 
@@ -574,6 +596,7 @@ void Node::setPositionZ(float positionZ)
         return;
 
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateSubtreeBounds();
 
     _positionZ = positionZ;
 }
@@ -594,6 +617,7 @@ void Node::setPositionNormalized(const Vec2& position)
     _usingNormalizedPosition = true;
     _normalizedPositionDirty = true;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateSubtreeBounds();
 }
 
 ssize_t Node::getChildrenCount() const
@@ -615,6 +639,8 @@ void Node::setVisible(bool visible)
         _visible = visible;
         if (_visible)
             _transformUpdated = _transformDirty = _inverseDirty = true;
+        if (_parent)
+            _parent->invalidateSubtreeBounds();
     }
 }
 
@@ -636,6 +662,7 @@ void Node::setAnchorPoint(const Vec2& point)
         _anchorPoint = point;
         _anchorPointInPoints.set(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        invalidateSubtreeBounds();
     }
 }
 
@@ -653,6 +680,14 @@ void Node::setContentSize(const Vec2& size)
 
         _anchorPointInPoints.set(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
         _transformUpdated = _transformDirty = _inverseDirty = _contentSizeDirty = true;
+        invalidateSubtreeBounds();
+
+        // children placed with normalized positions move along with the content size
+        for (auto&& child : _children)
+        {
+            if (child->_usingNormalizedPosition)
+                child->_subtreeBoundsDirty = true;
+        }
     }
 }
 
@@ -672,9 +707,13 @@ bool Node::isRunning() const
 /// parent setter
 void Node::setParent(Node* parent)
 {
+    if (_parent)
+        _parent->invalidateSubtreeBounds();
     _parent           = parent;
     _normalizedPositionDirty = true;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    _subtreeBoundsDirty = false;
+    invalidateSubtreeBounds();
 }
 
 /// isRelativeAnchorPoint getter
@@ -690,6 +729,7 @@ void Node::setIgnoreAnchorPointForPosition(bool newValue)
     {
         _ignoreAnchorPointForPosition = newValue;
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        invalidateSubtreeBounds();
     }
 }
 
@@ -1231,6 +1271,27 @@ void Node::visit()
 
 uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFlags)
 {
+    if (_precomputedEpoch != 0)
+    {
+        // consume the transform computed by a parallel visit, it's valid only if computed with the same inputs
+        bool valid = _precomputedEpoch == s_visitEpoch && _precomputedParentTransform == &parentTransform &&
+                     _precomputedParentFlags == parentFlags && !_transformUpdated && !_contentSizeDirty &&
+                     !_normalizedPositionDirty;
+        _precomputedEpoch = 0;
+        if (valid)
+            return _precomputedFlags;
+
+        // the precompute cleared the dirty state of a transform nobody used, e.g. for a culled subtree, so it's
+        // still pending. The transform below may differ, so do the ones of children computed from it, they keep
+        // their pending flags the same way when visited.
+        parentFlags |= _precomputedFlags & FLAGS_DIRTY_MASK;
+        for (auto&& child : _children)
+            child->_precomputedParentTransform = nullptr;
+    }
+
+    // the dirty flags of the visits which skipped this subtree still apply
+    parentFlags |= _culledParentFlags;
+
     if (_usingNormalizedPosition)
     {
         AXASSERT(_parent, "setPositionNormalized() doesn't work with orphan nodes");
@@ -1249,6 +1310,8 @@ uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFl
     if (!isVisitableByVisitingCamera())
         return parentFlags;
 
+    _culledParentFlags = 0;
+
     uint32_t flags = parentFlags;
     flags |= (_transformUpdated ? FLAGS_TRANSFORM_DIRTY : 0);
     flags |= (_contentSizeDirty ? FLAGS_CONTENT_SIZE_DIRTY : 0);
@@ -1292,13 +1355,31 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
     if (!_children.empty())
     {
         sortAllChildren();
+
+        if (_subtreeCullingEnabled)
+            flags |= FLAGS_CULL_SUBTREES;
+
+        CullingPlanes culling;
+        if (flags & FLAGS_CULL_SUBTREES)
+            culling.init(_director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION) * _modelViewTransform);
+
+        bool parallelVisit = _parallelVisitEnabled && s_parallelVisitDepth == 0 && _children.size() > 1;
+        if (parallelVisit)
+        {
+            precomputeChildrenTransforms(flags);
+            ++s_parallelVisitDepth;
+        }
+
         // draw children zOrder < 0
         for (auto size = _children.size(); i < size; ++i)
         {
             auto node = _children.at(i);
 
             if (node && node->_localZOrder < 0)
-                node->visit(renderer, _modelViewTransform, flags);
+            {
+                if (!(flags & FLAGS_CULL_SUBTREES) || !node->cullSubtree(culling, flags))
+                    node->visit(renderer, _modelViewTransform, flags);
+            }
             else
                 break;
         }
@@ -1307,7 +1388,17 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
             this->draw(renderer, _modelViewTransform, flags);
 
         for (auto it = _children.cbegin() + i, itCend = _children.cend(); it != itCend; ++it)
-            (*it)->visit(renderer, _modelViewTransform, flags);
+        {
+            if (!(flags & FLAGS_CULL_SUBTREES) || !(*it)->cullSubtree(culling, flags))
+                (*it)->visit(renderer, _modelViewTransform, flags);
+        }
+
+        if (parallelVisit)
+        {
+            --s_parallelVisitDepth;
+            // invalidate the transforms which were not consumed
+            s_visitEpoch = nextVisitEpoch(s_visitEpoch);
+        }
     }
     else if (visibleByCamera)
     {
@@ -1322,6 +1413,162 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
     // _orderOfArrival = 0;
 }
 
+void Node::setParallelVisitEnabled(bool enabled, int maxThreads)
+{
+    _parallelVisitEnabled    = enabled;
+    _parallelVisitMaxThreads = maxThreads;
+}
+
+void Node::precomputeChildrenTransforms(uint32_t flags)
+{
+    s_visitEpoch = nextVisitEpoch(s_visitEpoch);
+
+    auto epoch = s_visitEpoch;
+    _director->getJobSystem()->parallelFor(
+        _children.size(),
+        [this, flags, epoch](size_t index) { _children.at(index)->precomputeTransforms(_modelViewTransform, flags, epoch); },
+        _parallelVisitMaxThreads);
+}
+
+void Node::precomputeTransforms(const Mat4& parentTransform, uint32_t parentFlags, uint32_t epoch)
+{
+    // invisible nodes are not visited, see Node::visit
+    if (!_visible)
+        return;
+
+    auto flags = processParentFlags(parentTransform, parentFlags);
+
+    _precomputedParentTransform = &parentTransform;
+    _precomputedParentFlags     = parentFlags;
+    _precomputedFlags           = flags;
+    _precomputedEpoch           = epoch;
+
+    for (auto&& child : _children)
+        child->precomputeTransforms(_modelViewTransform, flags, epoch);
+}
+
+void Node::setSubtreeCullingEnabled(bool enabled)
+{
+    _subtreeCullingEnabled = enabled;
+}
+
+Rect Node::getSubtreeBoundingBox()
+{
+    if (_subtreeBoundsDirty)
+        updateSubtreeBounds();
+
+    if (_subtreeUnbounded || _subtreeBoundsMin.x > _subtreeBoundsMax.x)
+        return Rect::ZERO;
+    return Rect(_subtreeBoundsMin.x, _subtreeBoundsMin.y, _subtreeBoundsMax.x - _subtreeBoundsMin.x,
+                _subtreeBoundsMax.y - _subtreeBoundsMin.y);
+}
+
+void Node::invalidateSubtreeBounds()
+{
+    // a dirty node always has dirty ancestors, so the walk stops at the first one
+    for (auto node = this; node && !node->_subtreeBoundsDirty; node = node->_parent)
+        node->_subtreeBoundsDirty = true;
+}
+
+void Node::updateSubtreeBounds()
+{
+    if (_usingNormalizedPosition && _parent)
+    {
+        // resolve the normalized position now, processParentFlags does it only when this node is visited
+        auto& s = _parent->getContentSize();
+        Vec2 position(_normalizedPosition.x * s.width, _normalizedPosition.y * s.height);
+        if (_normalizedPositionDirty || !position.equals(_position))
+        {
+            _position         = position;
+            _transformUpdated = _transformDirty = _inverseDirty = true;
+            _normalizedPositionDirty                            = false;
+        }
+    }
+
+    // local bounds, empty when min > max
+    float boundsMin[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+    float boundsMax[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    _subtreeUnbounded  = false;
+
+    if (_contentSize.width != 0 || _contentSize.height != 0)
+    {
+        boundsMin[0] = boundsMin[1] = boundsMin[2] = boundsMax[2] = 0;
+        boundsMax[0] = _contentSize.width;
+        boundsMax[1] = _contentSize.height;
+    }
+    else if (_children.empty())
+    {
+        // nothing tells where a leaf without content size draws
+        _subtreeUnbounded = true;
+    }
+
+    for (auto&& child : _children)
+    {
+        if (_subtreeUnbounded)
+            break;
+        if (!child->_visible)
+            continue;
+        if (child->_subtreeBoundsDirty)
+            child->updateSubtreeBounds();
+
+        _subtreeUnbounded = child->_subtreeUnbounded;
+        auto& childMin    = child->_subtreeBoundsMin;
+        auto& childMax    = child->_subtreeBoundsMax;
+        if (childMin.x <= childMax.x)
+        {
+            boundsMin[0] = std::min(boundsMin[0], childMin.x);
+            boundsMin[1] = std::min(boundsMin[1], childMin.y);
+            boundsMin[2] = std::min(boundsMin[2], childMin.z);
+            boundsMax[0] = std::max(boundsMax[0], childMax.x);
+            boundsMax[1] = std::max(boundsMax[1], childMax.y);
+            boundsMax[2] = std::max(boundsMax[2], childMax.z);
+        }
+    }
+
+    _subtreeBoundsDirty = false;
+
+    if (_subtreeUnbounded || boundsMin[0] > boundsMax[0])
+    {
+        _subtreeBoundsMin.set(FLT_MAX, FLT_MAX, FLT_MAX);
+        _subtreeBoundsMax.set(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        return;
+    }
+
+    // transforms the box to the parent space, see "Transforming Axis-Aligned Bounding Boxes", Graphics Gems
+    const float* m = getNodeToParentTransform().m;
+    float parentMin[3], parentMax[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        parentMin[i] = parentMax[i] = m[12 + i];
+        for (int j = 0; j < 3; ++j)
+        {
+            float a = m[j * 4 + i] * boundsMin[j];
+            float b = m[j * 4 + i] * boundsMax[j];
+            parentMin[i] += std::min(a, b);
+            parentMax[i] += std::max(a, b);
+        }
+    }
+    _subtreeBoundsMin.set(parentMin);
+    _subtreeBoundsMax.set(parentMax);
+}
+
+bool Node::cullSubtree(const CullingPlanes& culling, uint32_t parentFlags)
+{
+    // invisible nodes are not visited, see Node::visit
+    if (!_visible)
+        return false;
+
+    if (_subtreeBoundsDirty)
+        updateSubtreeBounds();
+
+    if (_subtreeUnbounded || culling.intersects(_subtreeBoundsMin, _subtreeBoundsMax))
+        return false;
+
+    // the transforms below are not updated, keep the flags for the next visit
+    _culledParentFlags |= parentFlags & FLAGS_DIRTY_MASK;
+    return true;
+}
+
 Mat4 Node::transform(const Mat4& parentTransform)
 {
     return parentTransform * this->getNodeToParentTransform();
@@ -1803,6 +2050,7 @@ void Node::setNodeToParentTransform(const Mat4& transform)
     _transform        = transform;
     _transformDirty   = false;
     _transformUpdated = true;
+    invalidateSubtreeBounds();
 
     if (_additionalTransform)
         // _additionalTransform[1] has a copy of lastest transform
@@ -1838,6 +2086,7 @@ void Node::setAdditionalTransform(const Mat4* additionalTransform)
         _additionalTransform[0] = *additionalTransform;
     }
     _transformUpdated = _additionalTransformDirty = _inverseDirty = true;
+    invalidateSubtreeBounds();
 }
 
 void Node::setAdditionalTransform(const Mat4& additionalTransform)
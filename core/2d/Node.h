@@ -59,6 +59,7 @@ class ComponentContainer;
 class EventDispatcher;
 class Scene;
 class Renderer;
+struct CullingPlanes;
 class Director;
 class Material;
 class Camera;
@@ -126,6 +127,7 @@ public:
         FLAGS_TRANSFORM_DIRTY    = (1 << 0),
         FLAGS_CONTENT_SIZE_DIRTY = (1 << 1),
         FLAGS_RENDER_AS_3D       = (1 << 3),
+        FLAGS_CULL_SUBTREES      = (1 << 4),
 
         FLAGS_DIRTY_MASK = (FLAGS_TRANSFORM_DIRTY | FLAGS_CONTENT_SIZE_DIRTY),
     };
@@ -1142,6 +1144,55 @@ public:
     virtual void visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags);
     virtual void visit();
 
+    /**
+     * Sets whether the transforms of the children subtrees are updated in parallel on the JobSystem
+     * before they are drawn. Useful for a Scene or a Layer with many independent children subtrees.
+     * The children are still drawn on the rendering thread in the same order, so the draw order doesn't change.
+     * Nested nodes with parallel visit enabled are handled by the outermost one.
+     *
+     * @param enabled Whether parallel visit is enabled.
+     * @param maxThreads The max number of threads including the rendering thread, -1 means all JobSystem workers.
+     */
+    void setParallelVisitEnabled(bool enabled, int maxThreads = -1);
+
+    /**
+     * Whether the transforms of the children subtrees are updated in parallel.
+     *
+     * @return true if parallel visit is enabled.
+     */
+    bool isParallelVisitEnabled() const { return _parallelVisitEnabled; }
+
+    /**
+     * Sets whether the children subtrees which are out of the view are skipped when this node is visited,
+     * it applies to the whole subtree of this node, for any camera and for RenderTexture targets.
+     * The bounds of each subtree are cached and refreshed when a transform, a content size or a child
+     * in it changes, so the visit cost of a large and mostly static scene scales with what is visible.
+     * Nodes are bounded by their content size, leaf nodes with an empty content size (e.g. a DrawNode or a
+     * ParticleSystem) are never culled, nor are their ancestors. Nodes which draw outside of a non-empty
+     * content size shouldn't be placed in a culled subtree.
+     *
+     * @param enabled Whether subtree culling is enabled.
+     * @since axmol-2.2
+     */
+    void setSubtreeCullingEnabled(bool enabled);
+
+    /**
+     * Whether the children subtrees which are out of the view are skipped.
+     *
+     * @return true if subtree culling is enabled.
+     * @since axmol-2.2
+     */
+    bool isSubtreeCullingEnabled() const { return _subtreeCullingEnabled; }
+
+    /**
+     * Returns the bounding box of the content of this node and of its visible descendants,
+     * in its parent's coordinate system. The result is cached until the subtree changes.
+     *
+     * @return The bounding box of the subtree, a zero rect when the subtree has no content or is unbounded.
+     * @since axmol-2.2
+     */
+    Rect getSubtreeBoundingBox();
+
     /** Returns the Scene that contains the Node.
      It returns `nullptr` if the node doesn't belong to any Scene.
      This function recursively calls parent->getScene() until parent is a Scene object. The results are not cached. It
@@ -1879,6 +1930,18 @@ protected:
     Mat4 transform(const Mat4& parentTransform);
     uint32_t processParentFlags(const Mat4& parentTransform, uint32_t parentFlags);
 
+    /// update the transforms of the children subtrees in parallel, results are consumed by processParentFlags
+    void precomputeChildrenTransforms(uint32_t flags);
+    /// called from worker threads, updates the transforms of this subtree
+    void precomputeTransforms(const Mat4& parentTransform, uint32_t parentFlags, uint32_t epoch);
+
+    /// marks the cached subtree bounds of this node and of its ancestors as dirty
+    void invalidateSubtreeBounds();
+    /// refreshes the cached subtree bounds, in the parent space
+    void updateSubtreeBounds();
+    /// returns true and skips this subtree if its bounds are out of the view
+    bool cullSubtree(const CullingPlanes& culling, uint32_t parentFlags);
+
     virtual void updateCascadeOpacity();
     virtual void disableCascadeOpacity();
     virtual void updateCascadeColor();
@@ -2025,6 +2088,28 @@ protected:
 
     backend::ProgramState* _programState = nullptr;
 
+    // parallel visit
+    bool _parallelVisitEnabled   = false;
+    int _parallelVisitMaxThreads = -1;
+
+    // transform precomputed by a parallel visit, valid when _precomputedEpoch == s_visitEpoch. When it isn't used,
+    // the dirty flags in _precomputedFlags are applied again by the next visit
+    const Mat4* _precomputedParentTransform = nullptr;
+    uint32_t _precomputedParentFlags        = 0;
+    uint32_t _precomputedFlags              = 0;
+    uint32_t _precomputedEpoch              = 0;
+
+    static std::uint32_t s_visitEpoch;
+    static int s_parallelVisitDepth;
+
+    // subtree culling, the bounds are in the parent space and empty when min > max
+    bool _subtreeCullingEnabled = false;
+    bool _subtreeBoundsDirty    = true;
+    bool _subtreeUnbounded      = false;  ///< contains a leaf without content size, never culled
+    uint32_t _culledParentFlags = 0;  ///< dirty flags of the visits which skipped this subtree
+    Vec3 _subtreeBoundsMin;
+    Vec3 _subtreeBoundsMax;
+
 // Physics:remaining backwardly compatible
 #if defined(AX_ENABLE_PHYSICS)
     PhysicsBody* _physicsBody;
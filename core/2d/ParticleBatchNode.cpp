@@ -38,7 +38,7 @@
 #include "renderer/QuadCommand.h"
 #include "renderer/Renderer.h"
 #include "renderer/TextureAtlas.h"
-#include "base/Profiling.h"
+#include "base/Tracing.h"
 #include "base/UTF8.h"
 #include "base/Utils.h"
 #include "renderer/Shaders.h"
@@ -426,7 +426,7 @@ void ParticleBatchNode::removeAllChildrenWithCleanup(bool doCleanup)
 
 void ParticleBatchNode::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
-    AX_PROFILER_START("CCParticleBatchNode - draw");
+    AX_TRACE_ZONE("ParticleBatchNode::draw");
 
     if (_textureAtlas->getTotalQuads() == 0)
         return;
@@ -454,8 +454,6 @@ void ParticleBatchNode::draw(Renderer* renderer, const Mat4& transform, uint32_t
     }
 
     renderer->addCommand(&_customCommand);
-
-    AX_PROFILER_STOP("CCParticleBatchNode - draw");
 }
 
 void ParticleBatchNode::increaseAtlasCapacityTo(ssize_t quantity)
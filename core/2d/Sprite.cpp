@@ -1072,18 +1072,13 @@ void Sprite::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
     setMVPMatrixUniform();
 
 #if AX_USE_CULLING
-    // Don't calculate the culling if the transform was not updated
-    auto visitingCamera = Camera::getVisitingCamera();
-    auto defaultCamera  = Camera::getDefaultCamera();
-    if (visitingCamera == nullptr)
-        _insideBounds = true;
-    else if (visitingCamera == defaultCamera)
-        _insideBounds = ((flags & FLAGS_TRANSFORM_DIRTY) || visitingCamera->isViewProjectionUpdated())
-                            ? renderer->checkVisibility(transform, _contentSize)
-                            : _insideBounds;
-    else
-        // XXX: this always return true since
-        _insideBounds = renderer->checkVisibility(transform, _contentSize);
+    // Don't calculate the culling if neither the transform nor the view projection was updated
+    auto cullingVersion = renderer->getCullingVersion();
+    if ((flags & FLAGS_TRANSFORM_DIRTY) || cullingVersion != _insideBoundsVersion)
+    {
+        _insideBounds        = renderer->checkVisibility(transform, _contentSize);
+        _insideBoundsVersion = cullingVersion;
+    }
 
     if (_insideBounds)
 #endif
@@ -728,6 +728,7 @@ protected:
     bool _flippedY = false;  /// Whether the sprite is flipped vertically or not
 
     bool _insideBounds = true;  /// whether or not the sprite was inside bounds the previous frame
+    uint32_t _insideBoundsVersion = 0;  /// culling version of the view projection _insideBounds was computed with
 
     std::string _fileName;
     int _fileType = 0;
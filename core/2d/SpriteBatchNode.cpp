@@ -32,7 +32,7 @@ THE SOFTWARE.
 #include "base/Types.h"
 #include "2d/Sprite.h"
 #include "base/Director.h"
-#include "base/Profiling.h"
+#include "base/Tracing.h"
 #include "base/UTF8.h"
 #include "renderer/TextureCache.h"
 #include "renderer/Renderer.h"
@@ -171,7 +171,7 @@ SpriteBatchNode::~SpriteBatchNode()
 // don't call visit on it's children
 void SpriteBatchNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
 {
-    AX_PROFILER_START_CATEGORY(kProfilerCategoryBatchSprite, "CCSpriteBatchNode - visit");
+    AX_TRACE_ZONE("SpriteBatchNode::visit");
 
     // CAREFUL:
     // This visit is almost identical to CocosNode#visit
@@ -203,8 +203,6 @@ void SpriteBatchNode::visit(Renderer* renderer, const Mat4& parentTransform, uin
         // FIX ME: Why need to set _orderOfArrival to 0??
         // Please refer to https://github.com/cocos2d/cocos2d-x/pull/6920
         //    setOrderOfArrival(0);
-
-        AX_PROFILER_STOP_CATEGORY(kProfilerCategoryBatchSprite, "CCSpriteBatchNode - visit");
     }
 }
 
@@ -57,6 +57,7 @@ struct SpriteSheetFormat
     enum : uint32_t
     {
         PLIST  = 1,
+        BINARY = 2,
         CUSTOM = 1000
     };
 };
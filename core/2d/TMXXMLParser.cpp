@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include <unordered_map>
 #include <sstream>
 #include <regex>
+#include <climits>
 //  #include "2d/TMXTiledMap.h"
 #include "base/ZipUtils.h"
 #include "base/Director.h"
@@ -158,6 +159,7 @@ TMXMapInfo::TMXMapInfo()
     , _staggerAxis(TMXStaggerAxis_Y)
     , _staggerIndex(TMXStaggerIndex_Even)
     , _hexSideLength(0)
+    , _infinite(false)
     , _mapSize(Vec2::ZERO)
     , _tileSize(Vec2::ZERO)
     , _parentElement(0)
@@ -206,6 +208,122 @@ bool TMXMapInfo::parseXMLFile(std::string_view xmlFilename)
     return parser.parse(xmlFilename, SAXParser::ParseOption::TRIM_WHITESPACE);
 }
 
+uint32_t* TMXMapInfo::decodeTileData(size_t tilesAmount)
+{
+    auto currentString = getCurrentString();
+
+    if (_layerAttribs & TMXLayerAttribBase64)
+    {
+        auto buffer = utils::base64Decode(currentString);
+        if (buffer.empty())
+        {
+            AXLOGW("TiledMap: decode data error");
+            return nullptr;
+        }
+
+        if (_layerAttribs & (TMXLayerAttribGzip | TMXLayerAttribZlib))
+        {
+            ssize_t sizeHint = tilesAmount * sizeof(uint32_t);
+
+            buffer = ZipUtils::decompressGZ(std::span{buffer}, static_cast<int>(sizeHint));
+            AXASSERT(buffer.size() == sizeHint, "inflatedLen should be equal to sizeHint!");
+
+            if (buffer.empty())
+            {
+                AXLOGW("TiledMap: inflate data error");
+                return nullptr;
+            }
+        }
+
+        // never hand out less than the layer needs, missing tiles are empty
+        if (buffer.size() < tilesAmount * sizeof(uint32_t))
+            buffer.resize(tilesAmount * sizeof(uint32_t), 0);
+
+        return reinterpret_cast<uint32_t*>(buffer.release_pointer());
+    }
+
+    // csv
+    std::vector<std::string> gidTokens;
+    std::stringstream filestr;
+    filestr << currentString;
+    std::string sRow;
+    while (std::getline(filestr, sRow, '\n'))
+    {
+        std::string sGID;
+        std::istringstream rowstr(sRow);
+        while (std::getline(rowstr, sGID, ','))
+        {
+            gidTokens.emplace_back(sGID);
+        }
+    }
+
+    // 32-bits per gid
+    axstd::pod_vector<uint32_t> buffer(std::max(tilesAmount, gidTokens.size()), 0U);
+    uint32_t* bufferPtr = buffer.data();
+    for (const auto& gidToken : gidTokens)
+    {
+        auto tileGid = (uint32_t)strtoul(gidToken.c_str(), nullptr, 10);
+        *bufferPtr   = tileGid;
+        bufferPtr++;
+    }
+
+    return buffer.release_pointer();
+}
+
+void TMXMapInfo::mergeLayerChunks(TMXLayerInfo* layer)
+{
+    // bounds of all chunks in tile coordinates, they may be negative
+    int minX = 0, minY = 0, maxX = static_cast<int>(_mapSize.width), maxY = static_cast<int>(_mapSize.height);
+    if (!_layerChunks.empty())
+    {
+        minX = minY = INT_MAX;
+        maxX = maxY = INT_MIN;
+        for (auto&& chunk : _layerChunks)
+        {
+            minX = std::min(minX, chunk.x);
+            minY = std::min(minY, chunk.y);
+            maxX = std::max(maxX, chunk.x + chunk.width);
+            maxY = std::max(maxY, chunk.y + chunk.height);
+        }
+    }
+
+    const int width  = maxX - minX;
+    const int height = maxY - minY;
+
+    axstd::pod_vector<uint32_t> tiles(static_cast<size_t>(width) * height, 0U);
+    for (auto&& chunk : _layerChunks)
+    {
+        for (int row = 0; row < chunk.height; ++row)
+        {
+            memcpy(&tiles[static_cast<size_t>(chunk.y - minY + row) * width + (chunk.x - minX)],
+                   chunk.tiles.data() + static_cast<size_t>(row) * chunk.width, chunk.width * sizeof(uint32_t));
+        }
+    }
+    _layerChunks.clear();
+
+    AX_SAFE_FREE(layer->_tiles);
+    layer->_tiles = tiles.release_pointer();
+
+    // Layers are laid out from the bottom edge of the map, shift the merged layer so that the tile at
+    // (minX, minY) lands where Tiled shows it.
+    const float dw = _mapSize.width - width;
+    const float dh = _mapSize.height - height;
+    switch (_orientation)
+    {
+    case TMXOrientationOrtho:
+        layer->_offset += Vec2(static_cast<float>(minX), minY - dh);
+        break;
+    case TMXOrientationIso:
+        layer->_offset += Vec2(minX + dw / 2 - dh, minY - dw / 2 - dh);
+        break;
+    default:
+        if (minX != 0 || minY != 0 || dw != 0 || dh != 0)
+            AXLOGW("TMXFormat: infinite layer '{}' isn't positioned for orientation {}", layer->_name, _orientation);
+        break;
+    }
+    layer->_layerSize.set(static_cast<float>(width), static_cast<float>(height));
+}
+
 // the XML parser calls here with all the elements
 void TMXMapInfo::startElement(void* /*ctx*/, const char* name, const char** atts)
 {
@@ -271,6 +389,8 @@ void TMXMapInfo::startElement(void* /*ctx*/, const char* name, const char** atts
         auto hexSideLength = attributeDict["hexsidelength"].asInt();
         tmxMapInfo->setHexSideLength(hexSideLength);
 
+        tmxMapInfo->setInfinite(attributeDict["infinite"].asInt() != 0);
+
         Vec2 s;
         s.width  = attributeDict["width"].asFloat();
         s.height = attributeDict["height"].asFloat();
@@ -351,11 +471,21 @@ void TMXMapInfo::startElement(void* /*ctx*/, const char* name, const char** atts
             TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
             Vec2 layerSize      = layer->_layerSize;
             uint32_t gid        = static_cast<uint32_t>(attributeDict["gid"].asUnsignedInt());
-            int tilesAmount     = static_cast<int>(layerSize.width * layerSize.height);
 
-            if (_xmlTileIndex < tilesAmount)
+            if (tmxMapInfo->isInfinite())
             {
-                layer->_tiles[_xmlTileIndex++] = gid;
+                if (!_layerChunks.empty() && _xmlTileIndex < static_cast<int>(_layerChunks.back().tiles.size()))
+                {
+                    _layerChunks.back().tiles[_xmlTileIndex++] = gid;
+                }
+            }
+            else
+            {
+                int tilesAmount = static_cast<int>(layerSize.width * layerSize.height);
+                if (_xmlTileIndex < tilesAmount)
+                {
+                    layer->_tiles[_xmlTileIndex++] = gid;
+                }
             }
         }
         else
@@ -440,10 +570,17 @@ void TMXMapInfo::startElement(void* /*ctx*/, const char* name, const char** atts
         std::string encoding    = attributeDict["encoding"].asString();
         std::string compression = attributeDict["compression"].asString();
 
+        // the encoding is per layer, don't decode with the flags of the previous one
+        tmxMapInfo->setLayerAttribs(0);
+
         if (encoding == "")
         {
             tmxMapInfo->setLayerAttribs(tmxMapInfo->getLayerAttribs() | TMXLayerAttribNone);
 
+            // the tiles of infinite layers are read chunk by chunk
+            if (tmxMapInfo->isInfinite())
+                return;
+
             TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
             Vec2 layerSize      = layer->_layerSize;
             auto tilesAmount     = static_cast<size_t>(layerSize.width * layerSize.height);
@@ -477,6 +614,19 @@ void TMXMapInfo::startElement(void* /*ctx*/, const char* name, const char** atts
             tmxMapInfo->setStoringCharacters(true);
         }
     }
+    else if (elementName == "chunk")
+    {
+        TMXChunkInfo chunk;
+        chunk.x      = attributeDict["x"].asInt();
+        chunk.y      = attributeDict["y"].asInt();
+        chunk.width  = std::max(0, attributeDict["width"].asInt());
+        chunk.height = std::max(0, attributeDict["height"].asInt());
+        chunk.tiles.resize(static_cast<size_t>(chunk.width) * chunk.height, 0U);
+        _layerChunks.emplace_back(std::move(chunk));
+
+        _xmlTileIndex = 0;
+        tmxMapInfo->setCurrentString("");
+    }
     else if (elementName == "object")
     {
         TMXObjectGroup* objectGroup = tmxMapInfo->getObjectGroups().back();
@@ -690,76 +840,21 @@ void TMXMapInfo::endElement(void* /*ctx*/, const char* name)
 
     if (elementName == "data")
     {
-        if (tmxMapInfo->getLayerAttribs() & TMXLayerAttribBase64)
+        if (tmxMapInfo->isInfinite())
         {
             tmxMapInfo->setStoringCharacters(false);
-
-            TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
-            auto currentString = tmxMapInfo->getCurrentString();
-
-            auto buffer = utils::base64Decode(currentString);
-            if (buffer.empty())
-            {
-                AXLOGW("TiledMap: decode data error");
-                return;
-            }
-
-            if (tmxMapInfo->getLayerAttribs() & (TMXLayerAttribGzip | TMXLayerAttribZlib))
-            {
-                Vec2 s                  = layer->_layerSize;
-                // int sizeHint = s.width * s.height * sizeof(uint32_t);
-                ssize_t sizeHint = s.width * s.height * sizeof(unsigned int);
-
-                buffer = ZipUtils::decompressGZ(std::span{buffer}, static_cast<int>(sizeHint));
-                AXASSERT(buffer.size() == sizeHint, "inflatedLen should be equal to sizeHint!");
-
-                if (buffer.empty())
-                {
-                    AXLOGW("TiledMap: inflate data error");
-                    return;
-                }
-
-                layer->_tiles = reinterpret_cast<uint32_t*>(buffer.release_pointer());
-            }
-            else
-            {
-                layer->_tiles = reinterpret_cast<uint32_t*>(buffer.release_pointer());
-            }
-
+            mergeLayerChunks(tmxMapInfo->getLayers().back());
             tmxMapInfo->setCurrentString("");
         }
-        else if (tmxMapInfo->getLayerAttribs() & TMXLayerAttribCSV)
+        else if (tmxMapInfo->getLayerAttribs() & (TMXLayerAttribBase64 | TMXLayerAttribCSV))
         {
-            TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
-
             tmxMapInfo->setStoringCharacters(false);
-            auto currentString = tmxMapInfo->getCurrentString();
 
-            std::vector<std::string> gidTokens;
-            std::stringstream filestr;
-            filestr << currentString;
-            std::string sRow;
-            while (std::getline(filestr, sRow, '\n'))
-            {
-                std::string sGID;
-                std::istringstream rowstr(sRow);
-                while (std::getline(rowstr, sGID, ','))
-                {
-                    gidTokens.emplace_back(sGID);
-                }
-            }
-
-            // 32-bits per gid
-            axstd::pod_vector<uint32_t> buffer(gidTokens.size());
-            uint32_t* bufferPtr = buffer.data();
-            for (const auto& gidToken : gidTokens)
-            {
-                auto tileGid = (uint32_t)strtoul(gidToken.c_str(), nullptr, 10);
-                *bufferPtr   = tileGid;
-                bufferPtr++;
-            }
+            TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
+            Vec2 s              = layer->_layerSize;
 
-            layer->_tiles = buffer.release_pointer();
+            if (auto tiles = decodeTileData(static_cast<size_t>(s.width * s.height)))
+                layer->_tiles = tiles;
 
             tmxMapInfo->setCurrentString("");
         }
@@ -768,6 +863,20 @@ void TMXMapInfo::endElement(void* /*ctx*/, const char* name)
             _xmlTileIndex = 0;
         }
     }
+    else if (elementName == "chunk")
+    {
+        if (!_layerChunks.empty() && (tmxMapInfo->getLayerAttribs() & (TMXLayerAttribBase64 | TMXLayerAttribCSV)))
+        {
+            auto& chunk = _layerChunks.back();
+            if (auto tiles = decodeTileData(chunk.tiles.size()))
+            {
+                memcpy(chunk.tiles.data(), tiles, chunk.tiles.size() * sizeof(uint32_t));
+                free(tiles);
+            }
+        }
+        _xmlTileIndex = 0;
+        tmxMapInfo->setCurrentString("");
+    }
     else if (elementName == "map")
     {
         // The map element has ended
@@ -305,6 +305,10 @@ public:
     int getHexSideLength() const { return _hexSideLength; }
     void setHexSideLength(int hexSideLength) { _hexSideLength = hexSideLength; }
 
+    /// whether the map is infinite, its layers are then stored as chunks in the TMX file
+    bool isInfinite() const { return _infinite; }
+    void setInfinite(bool infinite) { _infinite = infinite; }
+
     /// map width & height
     const Vec2& getMapSize() const { return _mapSize; }
     void setMapSize(const Vec2& mapSize) { _mapSize = mapSize; }
@@ -373,8 +377,23 @@ public:
     std::string_view getExternalTilesetFileName() const { return _externalTilesetFilename; }
 
 protected:
+    /** tiles of one <chunk> element of an infinite map layer, in tile coordinates */
+    struct TMXChunkInfo
+    {
+        int x      = 0;
+        int y      = 0;
+        int width  = 0;
+        int height = 0;
+        std::vector<uint32_t> tiles;
+    };
+
     void internalInit(std::string_view tmxFileName, std::string_view resourcePath);
 
+    /** Decodes the base64 or csv tile data collected in the current string, returns a malloc'ed array or nullptr. */
+    uint32_t* decodeTileData(size_t tilesAmount);
+    /** Merges the parsed chunks of an infinite layer into a single tile array covering their bounds. */
+    void mergeLayerChunks(TMXLayerInfo* layer);
+
     /// map orientation
     int _orientation;
     /// map staggerAxis
@@ -383,6 +402,8 @@ protected:
     int _staggerIndex;
     /// map hexsidelength
     int _hexSideLength;
+    /// map is infinite
+    bool _infinite;
     /// map width & height
     Vec2 _mapSize;
     /// tiles width & height
@@ -405,6 +426,8 @@ protected:
     ValueMap _properties;
     //! xml format tile index
     int _xmlTileIndex;
+    //! chunks of the infinite layer being parsed
+    std::vector<TMXChunkInfo> _layerChunks;
 
     //! tmx filename
     std::string _TMXFileName;
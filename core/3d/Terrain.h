@@ -465,6 +465,11 @@ public:
      */
     Vec2 getTerrainSize() const { return Vec2(static_cast<float>(_imageWidth), static_cast<float>(_imageHeight)); }
 
+    /**
+     * get the distance between two adjacent vertices of the terrain
+     */
+    float getMapScale() const { return _terrainData._mapScale; }
+
     /**
      * get the terrain's height data
      */
@@ -32,6 +32,7 @@
 #include <thread>
 #include "base/Director.h"
 #include "base/Scheduler.h"
+#include "base/Tracing.h"
 
 #include "audio/AudioDecoderManager.h"
 #include "audio/AudioDecoder.h"
@@ -54,6 +55,8 @@ AudioCache::AudioCache()
     , _duration(0.0f)
     , _alBufferId(INVALID_AL_BUFFER_ID)
     , _queBufferFrames(0)
+    , _queBufferCount(QUEUEBUFFER_NUM)
+    , _queBufferTime(QUEUEBUFFER_TIME_STEP)
     , _state(State::INITIAL)
     , _isDestroyed(std::make_shared<bool>(false))
     , _id(++__idIndex)
@@ -61,11 +64,6 @@ AudioCache::AudioCache()
     , _isSkipReadDataTask(false)
 {
     AXLOGV("AudioCache() {}, id={}", fmt::ptr(this), _id);
-    for (int i = 0; i < QUEUEBUFFER_NUM; ++i)
-    {
-        _queBuffers[i]    = nullptr;
-        _queBufferSize[i] = 0;
-    }
 }
 
 AudioCache::~AudioCache()
@@ -99,13 +97,6 @@ AudioCache::~AudioCache()
         AXLOGW("AudioCache ({}), id={}, buffer isn't ready, state={}", fmt::ptr(this), _id, (int)_state);
     }
 
-    if (_queBufferFrames > 0)
-    {
-        for (int index = 0; index < QUEUEBUFFER_NUM; ++index)
-        {
-            free(_queBuffers[index]);
-        }
-    }
     AXLOGV("~AudioCache() {}, id={}, end", fmt::ptr(this), _id);
     _readDataTaskMutex.unlock();
 }
@@ -113,6 +104,7 @@ AudioCache::~AudioCache()
 void AudioCache::readDataTask(unsigned int selfId)
 {
     // Note: It's in sub thread
+    AX_TRACE_ZONE("AudioCache::readDataTask");
     AXLOGV("readDataTask begin, cache id={}", selfId);
 
     _readDataTaskMutex.lock();
@@ -289,17 +281,16 @@ void AudioCache::readDataTask(unsigned int selfId)
         }
         else
         {
-            _queBufferFrames = sampleRate * QUEUEBUFFER_TIME_STEP;
+            _queBufferFrames = sampleRate * _queBufferTime;
             BREAK_IF_ERR_LOG(_queBufferFrames == 0, "_queBufferFrames == 0");
 
             const uint32_t queBufferBytes = decoder->framesToBytes(_queBufferFrames);
 
-            for (int index = 0; index < QUEUEBUFFER_NUM; ++index)
+            _queBuffers.resize(_queBufferCount);
+            for (auto&& queBuffer : _queBuffers)
             {
-                _queBuffers[index]    = (char*)malloc(queBufferBytes);
-                _queBufferSize[index] = queBufferBytes;
-
-                decoder->readFixedFrames(_queBufferFrames, _queBuffers[index]);
+                queBuffer.resize(queBufferBytes);
+                decoder->readFixedFrames(_queBufferFrames, queBuffer.data());
             }
 
             _state = State::READY;
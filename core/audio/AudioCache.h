@@ -84,9 +84,11 @@ protected:
     /*Queue buffer related stuff
      *  Streaming in OpenAL when sizeInBytes greater then PCMDATA_CACHEMAXSIZE
      */
-    char* _queBuffers[QUEUEBUFFER_NUM];
-    ALsizei _queBufferSize[QUEUEBUFFER_NUM];
+    std::vector<std::vector<char>> _queBuffers;
     uint32_t _queBufferFrames;
+    // assigned by AudioEngineImpl::preload from AudioEngine::setStreamingBuffers
+    int _queBufferCount;
+    float _queBufferTime;
 
     std::mutex _playCallbackMutex;
     std::vector<std::function<void()>> _playCallbacks;
@@ -106,6 +108,7 @@ protected:
 
     friend class AudioEngineImpl;
     friend class AudioPlayer;
+    friend class AudioStreamer;
 };
 
 }
@@ -27,6 +27,7 @@
 #include "platform/PlatformConfig.h"
 
 #include "audio/AudioEngine.h"
+#include <algorithm>
 #include <condition_variable>
 #include <queue>
 #include "platform/FileUtils.h"
@@ -50,7 +51,9 @@ const float AudioEngine::TIME_UNKNOWN   = -1.0f;
 hlookup::string_map<std::list<AUDIO_ID>> AudioEngine::_audioPathIDMap;
 // profileName,ProfileHelper
 hlookup::string_map<AudioEngine::ProfileHelper> AudioEngine::_audioPathProfileHelperMap;
-unsigned int AudioEngine::_maxInstances                        = MAX_AUDIOINSTANCES;
+unsigned int AudioEngine::_maxInstances                        = MAX_VIRTUAL_AUDIOINSTANCES;
+int AudioEngine::_streamingBufferCount                         = QUEUEBUFFER_NUM;
+float AudioEngine::_streamingBufferTime                        = QUEUEBUFFER_TIME_STEP;
 AudioEngine::ProfileHelper* AudioEngine::_defaultProfileHelper = nullptr;
 std::unordered_map<AUDIO_ID, AudioEngine::AudioInfo> AudioEngine::_audioIDInfoMap;
 AudioEngineImpl* AudioEngine::_audioEngineImpl = nullptr;
@@ -58,7 +61,12 @@ AudioEngineImpl* AudioEngine::_audioEngineImpl = nullptr;
 bool AudioEngine::_isEnabled                                  = true;
 
 AudioEngine::AudioInfo::AudioInfo()
-    : profileHelper(nullptr), volume(1.0f), loop(false), duration(TIME_UNKNOWN), state(AudioState::INITIALIZING)
+    : profileHelper(nullptr)
+    , volume(1.0f)
+    , loop(false)
+    , priority(0)
+    , duration(TIME_UNKNOWN)
+    , state(AudioState::INITIALIZING)
 {}
 
 AudioEngine::AudioInfo::~AudioInfo() {}
@@ -161,7 +169,7 @@ AUDIO_ID AudioEngine::play2d(std::string_view filePath, const AudioPlayerSetting
             volume = 1.0f;
         }
 
-        ret = _audioEngineImpl->play2d(filePath, settings.loop, volume, settings.time);
+        ret = _audioEngineImpl->play2d(filePath, settings.loop, volume, settings.time, settings.priority);
         if (ret != INVALID_AUDIO_ID)
         {
             _audioPathIDMap[filePath.data()].emplace_back(ret);
@@ -170,6 +178,7 @@ AUDIO_ID AudioEngine::play2d(std::string_view filePath, const AudioPlayerSetting
             auto& audioRef    = _audioIDInfoMap[ret];
             audioRef.volume   = volume;
             audioRef.loop     = settings.loop;
+            audioRef.priority = settings.priority;
             audioRef.filePath = it->first;
 
             if (profileHelper)
@@ -216,6 +225,38 @@ void AudioEngine::setVolume(AUDIO_ID audioID, float volume)
     }
 }
 
+void AudioEngine::setPriority(AUDIO_ID audioID, int priority)
+{
+    auto it = _audioIDInfoMap.find(audioID);
+    if (it != _audioIDInfoMap.end() && it->second.priority != priority)
+    {
+        _audioEngineImpl->setPriority(audioID, priority);
+        it->second.priority = priority;
+    }
+}
+
+int AudioEngine::getPriority(AUDIO_ID audioID)
+{
+    auto it = _audioIDInfoMap.find(audioID);
+    if (it != _audioIDInfoMap.end())
+    {
+        return it->second.priority;
+    }
+
+    AXLOGW("AudioEngine::getPriority-->The audio instance {} is non-existent", audioID);
+    return 0;
+}
+
+bool AudioEngine::isVirtual(AUDIO_ID audioID)
+{
+    auto it = _audioIDInfoMap.find(audioID);
+    if (it != _audioIDInfoMap.end())
+    {
+        return _audioEngineImpl->isVirtual(audioID);
+    }
+    return false;
+}
+
 void AudioEngine::pause(AUDIO_ID audioID)
 {
     auto it = _audioIDInfoMap.find(audioID);
@@ -400,7 +441,7 @@ void AudioEngine::setFinishCallback(AUDIO_ID audioID, const std::function<void(A
 
 bool AudioEngine::setMaxAudioInstance(int maxInstances)
 {
-    if (maxInstances > 0 && maxInstances <= MAX_AUDIOINSTANCES)
+    if (maxInstances > 0 && maxInstances <= MAX_VIRTUAL_AUDIOINSTANCES)
     {
         _maxInstances = maxInstances;
         return true;
@@ -509,6 +550,30 @@ void AudioEngine::addTask(const std::function<void()>& task)
     Director::getInstance()->getJobSystem()->enqueue(task);
 }
 
+void AudioEngine::setStreamingBuffers(int bufferCount, float bufferTime)
+{
+    _streamingBufferCount = std::clamp(bufferCount, 2, 16);
+    _streamingBufferTime  = std::clamp(bufferTime, 0.01f, 1.0f);
+}
+
+AudioStreamStats AudioEngine::getStreamingStats()
+{
+    if (_audioEngineImpl)
+    {
+        return _audioEngineImpl->getStreamingStats();
+    }
+    return AudioStreamStats{};
+}
+
+AudioVoiceStats AudioEngine::getVoiceStats()
+{
+    if (_audioEngineImpl)
+    {
+        return _audioEngineImpl->getVoiceStats();
+    }
+    return AudioVoiceStats{};
+}
+
 int AudioEngine::getPlayingAudioCount()
 {
     return static_cast<int>(_audioIDInfoMap.size());
@@ -29,6 +29,7 @@
 #include "platform/PlatformConfig.h"
 #include "platform/PlatformMacros.h"
 #include "audio/AudioMacros.h"
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <string>
@@ -57,6 +58,33 @@ struct AX_DLL AudioPlayerSettings
     bool loop = false; // Whether audio instance loop or not.
     float volume = 1.0f; // Volume value (range from 0.0 to 1.0).
     float time = 0.0f; // The initial time offset when play audio
+    int priority = 0; // Audio instances with a higher priority keep or take the OpenAL sources first.
+};
+
+/**
+ * @struct AudioStreamStats
+ *
+ * @brief Counters of the audio streaming thread, which refills the queued buffers of every streaming audio instance.
+ * @js NA
+ */
+struct AX_DLL AudioStreamStats
+{
+    unsigned int activeStreams = 0; // Streaming audio instances currently refilled.
+    uint64_t buffersQueued = 0; // Buffers refilled and queued since the audio engine was initialized.
+    uint64_t underruns = 0; // Times a source ran out of queued data before it was refilled.
+};
+
+/**
+ * @struct AudioVoiceStats
+ *
+ * @brief Counters of the voices of AudioEngine.
+ * @js NA
+ */
+struct AX_DLL AudioVoiceStats
+{
+    unsigned int realVoices = 0; // Audio instances playing on an OpenAL source.
+    unsigned int virtualVoices = 0; // Audio instances only advancing their playback position.
+    uint64_t stolenVoices = 0; // Times a playing instance gave its source up to a more important new one.
 };
 
 /**
@@ -91,6 +119,10 @@ class AudioEngineImpl;
  *
  * @brief Offers a interface to play audio.
  *
+ * The OpenAL sources, MAX_AUDIOINSTANCES of them, are given to the audio instances with the highest priority, then
+ * the highest volume. The other audio instances, and the inaudible ones, are virtual voices: they keep advancing their
+ * playback position without playing, and play again from there once they get a source.
+ *
  * @note Make sure to call AudioEngine::end() when the audio engine is not needed anymore to release resources.
  * @js NA
  */
@@ -189,6 +221,31 @@ public:
      */
     static float getVolume(AUDIO_ID audioID);
 
+    /**
+     * Sets the priority of an audio instance, an instance with a higher priority keeps or takes an OpenAL source
+     * before the instances with a lower one.
+     *
+     * @param audioID An audioID returned by the play2d function.
+     * @param priority The priority, default is 0.
+     */
+    static void setPriority(AUDIO_ID audioID, int priority);
+
+    /**
+     * Gets the priority of an audio instance.
+     *
+     * @param audioID An audioID returned by the play2d function.
+     * @return The priority.
+     */
+    static int getPriority(AUDIO_ID audioID);
+
+    /**
+     * Checks whether an audio instance is a virtual voice, which advances its playback position without an OpenAL
+     * source, because it's inaudible or more important instances use all the sources.
+     *
+     * @param audioID An audioID returned by the play2d function.
+     */
+    static bool isVirtual(AUDIO_ID audioID);
+
     /**
      * Pause an audio instance.
      *
@@ -267,8 +324,9 @@ public:
 
     /**
      * Sets the maximum number of simultaneous audio instance for AudioEngine.
+     * Instances beyond the MAX_AUDIOINSTANCES OpenAL sources play as virtual voices.
      *
-     * @param maxInstances The maximum number of simultaneous audio instance.
+     * @param maxInstances The maximum number of simultaneous audio instance, up to MAX_VIRTUAL_AUDIOINSTANCES.
      */
     static bool setMaxAudioInstance(int maxInstances);
 
@@ -317,6 +375,33 @@ public:
      */
     static void preload(std::string_view filePath, std::function<void(bool isSuccess)> callback);
 
+    /**
+     * Sets how audio files too large to be cached are streamed.
+     * Each streaming audio instance queues bufferCount buffers of bufferTime seconds each, so the queue covers
+     * bufferCount * bufferTime seconds. A longer queue survives longer stalls of the streaming thread, at the
+     * cost of memory and latency of setCurrentTime.
+     *
+     * @param bufferCount The number of queued buffers, clamped to [2, 16], default is 3.
+     * @param bufferTime The duration of one buffer in seconds, clamped to [0.01, 1.0], default is 0.05.
+     * @note Applies to audio files loaded afterwards, call uncache to reload an already cached file.
+     */
+    static void setStreamingBuffers(int bufferCount, float bufferTime);
+
+    /** Gets the number of queued buffers of streaming audio instances. */
+    static int getStreamingBufferCount() { return _streamingBufferCount; }
+
+    /** Gets the duration in seconds of one queued buffer of streaming audio instances. */
+    static float getStreamingBufferTime() { return _streamingBufferTime; }
+
+    /**
+     * Gets the counters of the audio streaming thread, the underruns count tells whether the streaming buffers
+     * are too short.
+     */
+    static AudioStreamStats getStreamingStats();
+
+    /** Gets the counts of real and virtual voices. */
+    static AudioVoiceStats getVoiceStats();
+
     /**
      * Gets playing audio count.
      */
@@ -355,6 +440,7 @@ protected:
 
         float volume;
         bool loop;
+        int priority;
         float duration;
         AudioState state;
 
@@ -379,6 +465,9 @@ protected:
 
     static unsigned int _maxInstances;
 
+    static int _streamingBufferCount;
+    static float _streamingBufferTime;
+
     static ProfileHelper* _defaultProfileHelper;
 
     static AudioEngineImpl* _audioEngineImpl;
@@ -52,6 +52,14 @@ static ALCdevice* s_ALDevice       = nullptr;
 static ALCcontext* s_ALContext     = nullptr;
 static ax::AudioEngineImpl* s_instance = nullptr;
 
+// players with a volume up to this are inaudible, they don't need a source
+static constexpr float INAUDIBLE_VOLUME = 0.001f;
+
+static bool isMoreImportant(int lhsPriority, float lhsVolume, int rhsPriority, float rhsVolume)
+{
+    return lhsPriority != rhsPriority ? lhsPriority > rhsPriority : lhsVolume > rhsVolume;
+}
+
 static void ccALPauseDevice()
 {
     AXLOGD("{}", "===> ccALPauseDevice");
@@ -315,7 +323,8 @@ ALvoid ax::AudioEngineImpl::myAlSourceNotificationCallback(ALuint sid, ALuint no
         player = e.second;
         if (player->_alSource == sid && player->_streamingSource)
         {
-            player->wakeupRotateThread();
+            s_instance->_streamer->wakeup();
+            break;
         }
     }
     s_instance->_threadMutex.unlock();
@@ -325,7 +334,8 @@ ALvoid ax::AudioEngineImpl::myAlSourceNotificationCallback(ALuint sid, ALuint no
 namespace ax
 {
 
-AudioEngineImpl::AudioEngineImpl() : _scheduled(false), _currentAudioID(0), _scheduler(nullptr)
+AudioEngineImpl::AudioEngineImpl()
+    : _stolenVoices(0), _voicesDirty(false), _scheduled(false), _currentAudioID(0), _scheduler(nullptr)
 {
     s_instance = this;
 }
@@ -337,6 +347,9 @@ AudioEngineImpl::~AudioEngineImpl()
         _scheduler->unschedule(AX_SCHEDULE_SELECTOR(AudioEngineImpl::update), this);
     }
 
+    // stop the streaming thread before the sources and the context it uses are destroyed
+    _streamer.reset();
+
     if (s_ALContext)
     {
         alDeleteSources(MAX_AUDIOINSTANCES, _alSources);
@@ -456,6 +469,7 @@ bool AudioEngineImpl::init()
 #endif
             // ================ Workaround end ================ //
 
+            _streamer           = std::make_unique<AudioStreamer>();
             _scheduler          = Director::getInstance()->getScheduler();
             ret                 = AudioDecoderManager::init();
             const char* vender  = alGetString(AL_VENDOR);
@@ -504,9 +518,11 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
     {
         audioCache = new AudioCache();  // hlookup_second(it);
         _audioCaches.emplace(filePath, std::unique_ptr<AudioCache>(audioCache));
-        audioCache->_fileFullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
-        unsigned int cacheId      = audioCache->_id;
-        auto isCacheDestroyed     = audioCache->_isDestroyed;
+        audioCache->_fileFullPath   = FileUtils::getInstance()->fullPathForFilename(filePath);
+        audioCache->_queBufferCount = AudioEngine::_streamingBufferCount;
+        audioCache->_queBufferTime  = AudioEngine::_streamingBufferTime;
+        unsigned int cacheId        = audioCache->_id;
+        auto isCacheDestroyed       = audioCache->_isDestroyed;
         AudioEngine::addTask([audioCache, cacheId, isCacheDestroyed]() {
             if (*isCacheDestroyed)
             {
@@ -529,17 +545,22 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
     return audioCache;
 }
 
-AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float volume, float time)
+AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float volume, float time, int priority)
 {
     if (s_ALDevice == nullptr)
     {
         return AudioEngine::INVALID_AUDIO_ID;
     }
 
-    ALuint alSource = findValidSource();
-    if (alSource == AL_INVALID)
+    // Without a source, the player starts as a virtual voice
+    ALuint alSource = AL_INVALID;
+    if (volume > INAUDIBLE_VOLUME)
     {
-        return AudioEngine::INVALID_AUDIO_ID;
+        alSource = findValidSource();
+        if (alSource == AL_INVALID)
+        {
+            alSource = stealSource(priority, volume);
+        }
     }
 
     auto player = new AudioPlayer;
@@ -549,8 +570,11 @@ AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float vol
     }
 
     player->_alSource = alSource;
+    player->_virtual  = alSource == AL_INVALID;
+    player->_priority = priority;
     player->_loop     = loop;
     player->_volume   = volume;
+    player->_streamer = _streamer.get();
     if (time > 0.0f)
     {
         player->_currTime  = time;
@@ -591,7 +615,20 @@ void AudioEngineImpl::_play2d(AudioCache* cache, AUDIO_ID audioID)
     // Note: It maybe in sub thread or main thread :(
     if (!*cache->_isDestroyed && cache->_state == AudioCache::State::READY)
     {
-        if (player->play2d())
+        bool playing = true;
+        _voicesDirty = true;
+        if (player->_virtual)
+        {
+            // advances its playback position until _updateVoices gives it a source
+            player->startVirtualClock();
+            player->_ready = true;
+        }
+        else
+        {
+            playing = player->play2d();
+        }
+
+        if (playing)
         {
             _scheduler->runOnAxmolThread([audioID]() {
                 if (AudioEngine::_audioIDInfoMap.find(audioID) != AudioEngine::_audioIDInfoMap.end())
@@ -620,6 +657,34 @@ ALuint AudioEngineImpl::findValidSource()
     return sourceId;
 }
 
+ALuint AudioEngineImpl::stealSource(int priority, float volume)
+{
+    std::unique_lock<std::recursive_mutex> lck(_threadMutex);
+    AudioPlayer* victim = nullptr;
+    for (auto&& item : _audioPlayers)
+    {
+        auto player = item.second;
+        if (player->_virtual || !player->_ready || player->_removeByAudioEngine)
+            continue;
+
+        if (victim == nullptr ||
+            isMoreImportant(victim->_priority, victim->_volume, player->_priority, player->_volume))
+        {
+            victim = player;
+        }
+    }
+
+    if (victim == nullptr || !isMoreImportant(priority, volume, victim->_priority, victim->_volume))
+    {
+        return AL_INVALID;
+    }
+
+    auto alSource = victim->_alSource;
+    victim->virtualize();
+    ++_stolenVoices;
+    return alSource;
+}
+
 void AudioEngineImpl::setVolume(AUDIO_ID audioID, float volume)
 {
     std::unique_lock<std::recursive_mutex> lck(_threadMutex);
@@ -627,12 +692,13 @@ void AudioEngineImpl::setVolume(AUDIO_ID audioID, float volume)
     if (iter == _audioPlayers.end())
         return;
 
-    auto player = iter->second;
+    auto player  = iter->second;
+    _voicesDirty = true;
     lck.unlock();
 
     player->_volume = volume;
 
-    if (player->_ready)
+    if (player->_ready && !player->_virtual)
     {
         alSourcef(player->_alSource, AL_GAIN, volume);
 
@@ -644,6 +710,28 @@ void AudioEngineImpl::setVolume(AUDIO_ID audioID, float volume)
     }
 }
 
+void AudioEngineImpl::setPriority(AUDIO_ID audioID, int priority)
+{
+    std::unique_lock<std::recursive_mutex> lck(_threadMutex);
+    auto iter = _audioPlayers.find(audioID);
+    if (iter == _audioPlayers.end())
+        return;
+
+    // takes effect on the next update of the voices
+    iter->second->_priority = priority;
+    _voicesDirty            = true;
+}
+
+bool AudioEngineImpl::isVirtual(AUDIO_ID audioID)
+{
+    std::unique_lock<std::recursive_mutex> lck(_threadMutex);
+    auto iter = _audioPlayers.find(audioID);
+    if (iter == _audioPlayers.end())
+        return false;
+
+    return iter->second->_virtual;
+}
+
 void AudioEngineImpl::setLoop(AUDIO_ID audioID, bool loop)
 {
     std::unique_lock<std::recursive_mutex> lck(_threadMutex);
@@ -655,7 +743,7 @@ void AudioEngineImpl::setLoop(AUDIO_ID audioID, bool loop)
 
     lck.unlock();
 
-    if (player->_ready)
+    if (player->_ready && !player->_virtual)
     {
         if (player->_streamingSource)
         {
@@ -692,10 +780,21 @@ bool AudioEngineImpl::pause(AUDIO_ID audioID)
     if (iter == _audioPlayers.end())
         return false;
 
-    auto player = iter->second;
+    auto player  = iter->second;
+    _voicesDirty = true;
+
+    if (player->_virtual && player->_ready)
+    {
+        // keeps the playback position reached until now
+        player->updateVirtual();
+    }
 
     lck.unlock();
 
+    player->_paused = true;
+    if (player->_virtual)
+        return true;
+
     bool ret = true;
     alSourcePause(player->_alSource);
 
@@ -718,6 +817,17 @@ bool AudioEngineImpl::resume(AUDIO_ID audioID)
         return false;
 
     auto player = iter->second;
+
+    player->_paused = false;
+    _voicesDirty    = true;
+    if (player->_virtual)
+    {
+        player->startVirtualClock();
+        // play on a source again now if it's important enough
+        _updateVoices();
+        return true;
+    }
+
     lck.unlock();
 
     alSourcePlay(player->_alSource);
@@ -745,6 +855,9 @@ void AudioEngineImpl::stop(AUDIO_ID audioID)
     // Call '_updatePlayersState' method to cleanup immediately since the schedule may be cancelled without any
     // notification.
     _updatePlayers(true);
+
+    // hand the source over to a virtual voice
+    _updateVoices();
 }
 
 void AudioEngineImpl::stopAll()
@@ -791,7 +904,12 @@ float AudioEngineImpl::getCurrentTime(AUDIO_ID audioID)
     auto player = it->second;
     if (player->_ready)
     {
-        if (player->_streamingSource)
+        if (player->_virtual)
+        {
+            player->updateVirtual();
+            ret = player->getTime();
+        }
+        else if (player->_streamingSource)
         {
             ret = player->getTime();
         }
@@ -827,7 +945,7 @@ bool AudioEngineImpl::setCurrentTime(AUDIO_ID audioID, float time)
             break;
         }
 
-        if (player->_streamingSource)
+        if (player->_streamingSource || player->_virtual)
         {
             ret = player->setTime(time);
             break;
@@ -872,7 +990,39 @@ void AudioEngineImpl::setFinishCallback(AUDIO_ID audioID,
 void AudioEngineImpl::update(float /*dt*/)
 {
     std::unique_lock<std::recursive_mutex> lck(_threadMutex);
+    for (auto&& item : _audioPlayers)
+    {
+        auto player = item.second;
+        if (player->_virtual && player->_ready)
+            player->updateVirtual();
+    }
+
     _updatePlayers(false);
+    _updateVoices();
+}
+
+AudioVoiceStats AudioEngineImpl::getVoiceStats()
+{
+    std::unique_lock<std::recursive_mutex> lck(_threadMutex);
+    AudioVoiceStats stats;
+    for (auto&& item : _audioPlayers)
+    {
+        auto player = item.second;
+        if (player->_removeByAudioEngine)
+            continue;
+
+        if (player->_virtual)
+            ++stats.virtualVoices;
+        else
+            ++stats.realVoices;
+    }
+    stats.stolenVoices = _stolenVoices;
+    return stats;
+}
+
+AudioStreamStats AudioEngineImpl::getStreamingStats() const
+{
+    return _streamer ? _streamer->getStats() : AudioStreamStats{};
 }
 
 void AudioEngineImpl::_updatePlayers(bool forStop)
@@ -894,7 +1044,9 @@ void AudioEngineImpl::_updatePlayers(bool forStop)
 
             it = _audioPlayers.erase(it);
             delete player;
-            _unusedSourcesPool.push(alSource);
+            if (alSource != AL_INVALID)
+                _unusedSourcesPool.push(alSource);
+            _voicesDirty = true;
         }
         else if (player->_ready && player->isFinished())
         {
@@ -922,7 +1074,9 @@ void AudioEngineImpl::_updatePlayers(bool forStop)
             // clear cache when audio player finsihed properly
             player->setCache(nullptr);
             delete player;
-            _unusedSourcesPool.push(alSource);
+            if (alSource != AL_INVALID)
+                _unusedSourcesPool.push(alSource);
+            _voicesDirty = true;
         }
         else
         {
@@ -947,6 +1101,83 @@ void AudioEngineImpl::_updatePlayers(bool forStop)
         _unscheduleUpdate();
 }
 
+void AudioEngineImpl::_updateVoices()
+{
+    // the ranking only changes with the players and their priority, volume or pause state
+    if (!_voicesDirty)
+        return;
+    _voicesDirty = false;
+
+    // players still loading keep their source
+    std::vector<AudioPlayer*> voices;
+    size_t sources = _unusedSourcesPool.size();
+    bool balanced  = true;
+    for (auto&& item : _audioPlayers)
+    {
+        auto player = item.second;
+        if (!player->_ready || player->_removeByAudioEngine || player->isFinished())
+            continue;
+
+        const bool audible = player->_volume > INAUDIBLE_VOLUME;
+        if (player->_virtual)
+            balanced = balanced && (!audible || player->_paused);
+        else
+        {
+            balanced = balanced && audible;
+            ++sources;
+        }
+        voices.emplace_back(player);
+    }
+
+    // all the audible voices are real already
+    if (balanced)
+        return;
+
+    // the most important first, on a tie the real voices stay real, then the oldest players
+    std::sort(voices.begin(), voices.end(), [](const AudioPlayer* lhs, const AudioPlayer* rhs) {
+        if (lhs->_priority != rhs->_priority || lhs->_volume != rhs->_volume)
+            return isMoreImportant(lhs->_priority, lhs->_volume, rhs->_priority, rhs->_volume);
+        if (lhs->_virtual != rhs->_virtual)
+            return !lhs->_virtual;
+        return lhs->_id < rhs->_id;
+    });
+
+    // release the sources of the voices which turn virtual, before giving them to the voices which turn real
+    std::vector<AudioPlayer*> realized;
+    for (auto player : voices)
+    {
+        const bool eligible = player->_volume > INAUDIBLE_VOLUME && !(player->_virtual && player->_paused);
+        const bool real     = eligible && sources > 0;
+        if (real)
+        {
+            --sources;
+            if (player->_virtual)
+                realized.emplace_back(player);
+        }
+        else if (!player->_virtual)
+        {
+            auto alSource = player->_alSource;
+            player->virtualize();
+            _unusedSourcesPool.push(alSource);
+        }
+    }
+
+    for (auto player : realized)
+    {
+        ALuint alSource = findValidSource();
+        if (alSource == AL_INVALID)
+        {
+            // try again on the next update
+            _voicesDirty = true;
+            break;
+        }
+
+        // a failed play2d keeps the source until _updatePlayers removes the player
+        if (!player->realize(alSource) && player->_virtual)
+            _unusedSourcesPool.push(alSource);
+    }
+}
+
 void AudioEngineImpl::_unscheduleUpdate()
 {
     if (_scheduled)
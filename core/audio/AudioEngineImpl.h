@@ -31,11 +31,13 @@
 
 #    include <unordered_map>
 #    include <queue>
+#    include <memory>
 
 #    include "base/Object.h"
 #    include "audio/AudioMacros.h"
 #    include "audio/AudioCache.h"
 #    include "audio/AudioPlayer.h"
+#    include "audio/AudioStreamer.h"
 
 namespace ax
 {
@@ -49,8 +51,10 @@ public:
     ~AudioEngineImpl();
 
     bool init();
-    AUDIO_ID play2d(std::string_view fileFullPath, bool loop, float volume, float time);
+    AUDIO_ID play2d(std::string_view fileFullPath, bool loop, float volume, float time, int priority);
     void setVolume(AUDIO_ID audioID, float volume);
+    void setPriority(AUDIO_ID audioID, int priority);
+    bool isVirtual(AUDIO_ID audioID);
     void setLoop(AUDIO_ID audioID, bool loop);
     bool pause(AUDIO_ID audioID);
     bool resume(AUDIO_ID audioID);
@@ -66,12 +70,19 @@ public:
     AudioCache* preload(std::string_view filePath, std::function<void(bool)> callback);
     void update(float dt);
 
+    AudioStreamStats getStreamingStats() const;
+    AudioVoiceStats getVoiceStats();
+
 private:
     // query players state per frame and dispatch finish callback if possible
     void _updatePlayers(bool forStop);
     void _play2d(AudioCache* cache, AUDIO_ID audioID);
     void _unscheduleUpdate();
+    // gives the sources to the most important audible players, the others become virtual voices
+    void _updateVoices();
     ALuint findValidSource();
+    // takes the source of the least important player, if it's less important than a new player
+    ALuint stealSource(int priority, float volume);
 #if defined(__APPLE__) && !AX_USE_ALSOFT
     static ALvoid myAlSourceNotificationCallback(ALuint sid, ALuint notificationID, ALvoid* userData);
 #endif
@@ -87,9 +98,17 @@ private:
     std::unordered_map<AUDIO_ID, AudioPlayer*> _audioPlayers;
     std::recursive_mutex _threadMutex;
 
+    // refills the queued buffers of all streaming players
+    std::unique_ptr<AudioStreamer> _streamer;
+
     // finish callbacks
     std::vector<std::function<void()>> _finishCallbacks;
 
+    uint64_t _stolenVoices;
+
+    // a priority, volume or pause state or the set of players changed since the voices were last updated
+    bool _voicesDirty;
+
     bool _scheduled;
 
     AUDIO_ID _currentAudioID;
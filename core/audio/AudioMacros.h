@@ -33,6 +33,9 @@
 #define QUEUEBUFFER_NUM (3)
 #define QUEUEBUFFER_TIME_STEP (0.05f)
 
+// audio instances beyond the OpenAL sources (MAX_AUDIOINSTANCES) play as virtual voices
+#define MAX_VIRTUAL_AUDIOINSTANCES (1024)
+
 #define QUOTEME_(x) #x
 #define QUOTEME(x) QUOTEME_(x)
 
@@ -30,10 +30,9 @@
 #include "audio/AudioPlayer.h"
 #include "audio/AudioCache.h"
 #include "platform/FileUtils.h"
-#include "audio/AudioDecoder.h"
-#include "audio/AudioDecoderManager.h"
+#include "audio/AudioStreamer.h"
 
-#include "yasio/thread_name.hpp"
+#include <cmath>
 
 namespace ax
 {
@@ -49,18 +48,19 @@ AudioPlayer::AudioPlayer()
     , _isDestroyed(false)
     , _removeByAudioEngine(false)
     , _ready(false)
+    , _alSource(AL_INVALID)
+    , _virtual(false)
+    , _virtualFinished(false)
+    , _paused(false)
+    , _priority(0)
+    , _virtualClockTime(0.0f)
     , _currTime(0.0f)
     , _streamingSource(false)
-    , _rotateBufferThread(nullptr)
+    , _streamer(nullptr)
     , _timeDirty(false)
-    , _isRotateThreadExited(false)
-#if defined(__APPLE__)
-    , _needWakeupRotateThread(false)
-#endif
+    , _streamFinished(false)
     , _id(++__playerIdIndex)
-{
-    memset(_bufferIds, 0, sizeof(_bufferIds));
-}
+{}
 
 AudioPlayer::~AudioPlayer()
 {
@@ -69,7 +69,7 @@ AudioPlayer::~AudioPlayer()
 
     if (_streamingSource)
     {
-        alDeleteBuffers(QUEUEBUFFER_NUM, _bufferIds);
+        alDeleteBuffers(static_cast<ALsizei>(_bufferIds.size()), _bufferIds.data());
     }
 }
 
@@ -99,40 +99,31 @@ void AudioPlayer::destroy()
             }
         }
 
-        if (_streamingSource)
+        if (_streamingSource && !_virtual)
         {
-            if (_rotateBufferThread != nullptr)
+            if (_streamer != nullptr)
             {
-                while (!_isRotateThreadExited)
-                {
-                    _sleepCondition.notify_one();
-                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
-                }
-
-                if (_rotateBufferThread->joinable())
-                {
-                    _rotateBufferThread->join();
-                }
-
-                delete _rotateBufferThread;
-                _rotateBufferThread = nullptr;
-                AXLOGV("{}", "rotateBufferThread exited!");
+                _streamer->remove(this);
+                AXLOGV("{}", "removed from audio streamer!");
 
 #if AX_TARGET_PLATFORM == AX_PLATFORM_IOS
                 // some specific OpenAL implement defects existed on iOS platform
                 // refer to: https://github.com/cocos2d/cocos2d-x/issues/18597
                 ALint sourceState;
                 ALint bufferProcessed = 0;
+                ALint bufferQueued    = 0;
                 alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
                 if (sourceState == AL_PLAYING)
                 {
                     alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
-                    while (bufferProcessed < QUEUEBUFFER_NUM)
+                    alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &bufferQueued);
+                    while (bufferProcessed < bufferQueued)
                     {
                         std::this_thread::sleep_for(std::chrono::milliseconds(2));
                         alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
                     }
-                    alSourceUnqueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
+                    std::vector<ALuint> unqueued(bufferQueued);
+                    alSourceUnqueueBuffers(_alSource, bufferQueued, unqueued.data());
                     CHECK_AL_ERROR_DEBUG();
                 }
                 AXLOGV("{}", "UnqueueBuffers Before alSourceStop");
@@ -141,12 +132,15 @@ void AudioPlayer::destroy()
         }
     } while (false);
 
-    AXLOGV("{}", "Before alSourceStop");
-    alSourceStop(_alSource);
-    CHECK_AL_ERROR_DEBUG();
-    AXLOGV("{}", "Before alSourcei");
-    alSourcei(_alSource, AL_BUFFER, 0);
-    CHECK_AL_ERROR_DEBUG();
+    if (!_virtual)
+    {
+        AXLOGV("{}", "Before alSourceStop");
+        alSourceStop(_alSource);
+        CHECK_AL_ERROR_DEBUG();
+        AXLOGV("{}", "Before alSourcei");
+        alSourcei(_alSource, AL_BUFFER, 0);
+        CHECK_AL_ERROR_DEBUG();
+    }
 
     _removeByAudioEngine = true;
 
@@ -198,15 +192,18 @@ bool AudioPlayer::play2d()
         }
         else
         {
-            alGenBuffers(QUEUEBUFFER_NUM, _bufferIds);
+            auto& queBuffers = _audioCache->_queBuffers;
+            _bufferIds.resize(queBuffers.size());
+            alGenBuffers(static_cast<ALsizei>(_bufferIds.size()), _bufferIds.data());
 
             auto alError = alGetError();
             if (alError == AL_NO_ERROR)
             {
-                for (int index = 0; index < QUEUEBUFFER_NUM; ++index)
+                // Starting at an offset, the streamer fills the buffers from there instead
+                for (size_t index = 0; index < queBuffers.size() && !_timeDirty; ++index)
                 {
-                    alBufferData(_bufferIds[index], _audioCache->_format, _audioCache->_queBuffers[index],
-                                 _audioCache->_queBufferSize[index], _audioCache->_sampleRate);
+                    alBufferData(_bufferIds[index], _audioCache->_format, queBuffers[index].data(),
+                                 static_cast<ALsizei>(queBuffers[index].size()), _audioCache->_sampleRate);
                 }
                 CHECK_AL_ERROR_DEBUG();
             }
@@ -218,26 +215,38 @@ bool AudioPlayer::play2d()
             _streamingSource = true;
         }
 
-        {
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed)
-                break;
+        // the streamer queues the buffers filled from _currTime and starts playing
+        const bool streamFromOffset = _streamingSource && _timeDirty;
 
-            if (_streamingSource)
+        if (_streamingSource)
+        {
+            // To continuously stream audio from a source without interruption, buffer queuing is required.
+            if (!streamFromOffset)
             {
-                // To continuously stream audio from a source without interruption, buffer queuing is required.
-                alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
+                alSourceQueueBuffers(_alSource, static_cast<ALsizei>(_bufferIds.size()), _bufferIds.data());
                 CHECK_AL_ERROR_DEBUG();
-                _rotateBufferThread = new std::thread(&AudioPlayer::rotateBufferThread, this,
-                                                      _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1);
             }
             else
             {
-                alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
+                // a recycled or virtualized source is left stopped, which the streamer takes for a finished
+                // stream, it only fills and starts sources in the initial state
+                alSourceRewind(_alSource);
                 CHECK_AL_ERROR_DEBUG();
             }
+        }
+        else
+        {
+            alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
+            CHECK_AL_ERROR_DEBUG();
+        }
 
+        if (!streamFromOffset)
             alSourcePlay(_alSource);
+
+        if (_streamingSource)
+        {
+            // destroy waits for _play2dMutex, so the stream is always removed after it was added
+            _streamer->add(this, _audioCache->_queBufferFrames * static_cast<int>(_bufferIds.size()) + 1);
         }
 
         auto alError = alGetError();
@@ -247,15 +256,18 @@ bool AudioPlayer::play2d()
             break;
         }
 
-        ALint state;
-        alGetSourcei(_alSource, AL_SOURCE_STATE, &state);
-        if (state != AL_PLAYING)
-             AXLOGE("state isn't playing, {}, {}, cache id={}, player id={}", state, _audioCache->_fileFullPath,
-                  _audioCache->_id, _id);
-
-        // OpenAL framework: sometime when switch audio too fast, the result state will error, but there is no any
-        // alError, so just skip for workaround.
-        assert(state == AL_PLAYING);
+        if (!streamFromOffset)
+        {
+            ALint state;
+            alGetSourcei(_alSource, AL_SOURCE_STATE, &state);
+            if (state != AL_PLAYING)
+                AXLOGE("state isn't playing, {}, {}, cache id={}, player id={}", state, _audioCache->_fileFullPath,
+                       _audioCache->_id, _id);
+
+            // OpenAL framework: sometime when switch audio too fast, the result state will error, but there is no
+            // any alError, so just skip for workaround.
+            assert(state == AL_PLAYING);
+        }
 
         if (!_streamingSource && _currTime >= 0.0f)
         {
@@ -275,159 +287,91 @@ bool AudioPlayer::play2d()
     return ret;
 }
 
-// rotateBufferThread is used to rotate alBufferData for _alSource when playing big audio file
-void AudioPlayer::rotateBufferThread(int offsetFrame)
+void AudioPlayer::virtualize()
 {
-    yasio::set_thread_name("axmol-audio");
+    std::unique_lock<std::mutex> lck(_play2dMutex);
+    if (_isDestroyed || _virtual)
+        return;
 
-    char* tmpBuffer           = nullptr;
-    auto& fullPath            = _audioCache->_fileFullPath;
-    AudioDecoder* decoder     = AudioDecoderManager::createDecoder(fullPath);
-    long long rotateSleepTime = static_cast<long long>(QUEUEBUFFER_TIME_STEP * 1000) / 2;
-    do
+    if (_streamingSource)
     {
-        BREAK_IF(decoder == nullptr || !decoder->open(fullPath));
-
-        uint32_t framesRead         = 0;
-        const uint32_t framesToRead = _audioCache->_queBufferFrames;
-        const uint32_t bufferSize   = decoder->framesToBytes(framesToRead);
-#if AX_USE_ALSOFT
-        const auto sourceFormat = decoder->getSourceFormat();
-#endif
-        tmpBuffer = (char*)malloc(bufferSize);
-        memset(tmpBuffer, 0, bufferSize);
-
-        if (offsetFrame != 0)
-        {
-            decoder->seek(offsetFrame);
-        }
-
-        ALint sourceState;
-        ALint bufferProcessed = 0;
-        bool needToExitThread = false;
-
-        while (!_isDestroyed)
-        {
-            alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
-            if (sourceState == AL_PLAYING)
-            {
-                alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
-                while (bufferProcessed > 0)
-                {
-                    bufferProcessed--;
-                    if (_timeDirty)
-                    {
-                        _timeDirty  = false;
-                        offsetFrame = _currTime * decoder->getSampleRate() * decoder->getChannelCount();
-                        decoder->seek(offsetFrame);
-                    }
-                    else
-                    {
-                        _currTime += QUEUEBUFFER_TIME_STEP;
-                        if (_currTime > _audioCache->_duration)
-                        {
-                            if (_loop)
-                            {
-                                _currTime = 0.0f;
-                            }
-                            else
-                            {
-                                _currTime = _audioCache->_duration;
-                            }
-                        }
-                    }
+        _streamer->remove(this);
+        // the streamer fills the buffers from _currTime once the player plays on a source again
+        _timeDirty = true;
+    }
+    else
+    {
+        alGetSourcef(_alSource, AL_SEC_OFFSET, &_currTime);
+    }
 
-                    framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
+    alSourceStop(_alSource);
+    alSourcei(_alSource, AL_BUFFER, 0);
+    CHECK_AL_ERROR_DEBUG();
 
-                    if (framesRead == 0)
-                    {
-                        if (_loop)
-                        {
-                            decoder->seek(0);
-                            framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-                        }
-                        else
-                        {
-                            needToExitThread = true;
-                            break;
-                        }
-                    }
-                    /*
-                     While the source is playing, alSourceUnqueueBuffers can be called to remove buffers which have
-                     already played. Those buffers can then be filled with new data or discarded. New or refilled
-                     buffers can then be attached to the playing source using alSourceQueueBuffers. As long as there is
-                     always a new buffer to play in the queue, the source will continue to play.
-                     */
-                    ALuint bid;
-                    alSourceUnqueueBuffers(_alSource, 1, &bid);
-#if AX_USE_ALSOFT
-                    if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
-                        alBufferi(bid, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, decoder->getSamplesPerBlock());
-#endif
-                    alBufferData(bid, _audioCache->_format, tmpBuffer, decoder->framesToBytes(framesRead),
-                                 decoder->getSampleRate());
-                    alSourceQueueBuffers(_alSource, 1, &bid);
-                }
-            }
-            /* Make sure the source hasn't underrun */
-            else if (sourceState != AL_PAUSED)
-            {
-                ALint queued;
+    if (!_bufferIds.empty())
+    {
+        alDeleteBuffers(static_cast<ALsizei>(_bufferIds.size()), _bufferIds.data());
+        _bufferIds.clear();
+    }
 
-                /* If no buffers are queued, playback is finished */
-                alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &queued);
-                if (queued == 0)
-                {
-                    needToExitThread = true;
-                }
-                else
-                {
-                    alSourcePlay(_alSource);
-                    if (alGetError() != AL_NO_ERROR)
-                    {
-                        AXLOGE("{}", "Error restarting playback!");
-                        needToExitThread = true;
-                    }
-                }
-            }
+    _alSource       = AL_INVALID;
+    _virtual        = true;
+    _streamFinished = false;
+    startVirtualClock();
+}
 
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed || needToExitThread)
-            {
-                break;
-            }
-#if defined(__APPLE__)
-            if (!_needWakeupRotateThread)
-            {
-                _sleepCondition.wait_for(lk, std::chrono::milliseconds(rotateSleepTime));
-            }
+bool AudioPlayer::realize(ALuint alSource)
+{
+    {
+        std::unique_lock<std::mutex> lck(_play2dMutex);
+        if (_isDestroyed || !_virtual)
+            return false;
 
-            _needWakeupRotateThread = false;
-#else
-            _sleepCondition.wait_for(lk, std::chrono::milliseconds(rotateSleepTime));
-#endif
+        _alSource = alSource;
+        _virtual  = false;
+        if (_currTime > 0.0f)
+        {
+            _timeDirty = true;
         }
+    }
 
-    } while (false);
+    return play2d();
+}
 
-    AXLOGV("{}", "Exit rotate buffer thread ...");
-    AudioDecoderManager::destroyDecoder(decoder);
-    free(tmpBuffer);
-    _isRotateThreadExited = true;
+void AudioPlayer::startVirtualClock()
+{
+    _virtualClockStart = std::chrono::steady_clock::now();
+    _virtualClockTime  = _currTime;
 }
 
-#if defined(__APPLE__)
-void AudioPlayer::wakeupRotateThread()
+void AudioPlayer::updateVirtual()
 {
-    _needWakeupRotateThread = true;
-    _sleepCondition.notify_all();
+    if (_paused || _virtualFinished || _audioCache == nullptr)
+        return;
+
+    const float duration = _audioCache->_duration;
+    const float elapsed  = std::chrono::duration<float>(std::chrono::steady_clock::now() - _virtualClockStart).count();
+    _currTime = _virtualClockTime + elapsed;
+    if (_currTime >= duration)
+    {
+        if (_loop && duration > 0.0f)
+        {
+            _currTime = std::fmod(_currTime, duration);
+        }
+        else
+        {
+            _currTime        = duration;
+            _virtualFinished = true;
+        }
+    }
 }
-#endif
 
 bool AudioPlayer::isFinished() const
 {
-    if (_streamingSource)
-        return _isRotateThreadExited;
+    if (_virtual)
+        return _virtualFinished;
+    else if (_streamingSource)
+        return _streamFinished;
     else
     {
         ALint sourceState;
@@ -454,6 +398,8 @@ bool AudioPlayer::setTime(float time)
 
         _currTime  = time;
         _timeDirty = true;
+        if (_virtual)
+            startVirtualClock();
 
         return true;
     }
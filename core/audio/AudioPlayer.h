@@ -29,9 +29,10 @@
 #include "platform/PlatformConfig.h"
 
 #include <string>
-#include <condition_variable>
+#include <atomic>
+#include <chrono>
 #include <mutex>
-#include <thread>
+#include <vector>
 
 #include "audio/AudioMacros.h"
 #include "platform/PlatformMacros.h"
@@ -42,6 +43,7 @@ namespace ax
 
 class AudioCache;
 class AudioEngineImpl;
+class AudioStreamer;
 
 class AX_DLL AudioPlayer
 {
@@ -62,11 +64,16 @@ public:
 
 protected:
     void setCache(AudioCache* cache);
-    void rotateBufferThread(int offsetFrame);
     bool play2d();
-#if defined(__APPLE__)
-    void wakeupRotateThread();
-#endif
+
+    // Gives the source up, the player keeps advancing its playback position as a virtual voice
+    void virtualize();
+    // Plays on alSource again from the playback position of the virtual voice
+    bool realize(ALuint alSource);
+    // Starts timing the virtual voice from _currTime, when it's virtualized, resumed or seeked
+    void startVirtualClock();
+    // Sets _currTime from the wall clock, so the voice keeps time while the scheduler is scaled or paused
+    void updateVirtual();
 
     AudioCache* _audioCache;
 
@@ -79,23 +86,28 @@ protected:
     bool _ready;
     ALuint _alSource;
 
+    // virtual voice related stuff, _alSource is AL_INVALID while virtual
+    bool _virtual;
+    bool _virtualFinished;
+    bool _paused;
+    int _priority;
+    std::chrono::steady_clock::time_point _virtualClockStart;
+    float _virtualClockTime;
+
     // play by circular buffer
     float _currTime;
     bool _streamingSource;
-    ALuint _bufferIds[QUEUEBUFFER_NUM];
-    std::thread* _rotateBufferThread;
-    std::condition_variable _sleepCondition;
-    std::mutex _sleepMutex;
+    std::vector<ALuint> _bufferIds;
+    // refills _bufferIds of all streaming players, see AudioStreamer
+    AudioStreamer* _streamer;
     bool _timeDirty;
-    bool _isRotateThreadExited;
-#if defined(__APPLE__)
-    std::atomic_bool _needWakeupRotateThread;
-#endif
+    std::atomic_bool _streamFinished;
 
     std::mutex _play2dMutex;
 
     unsigned int _id;
     friend class AudioEngineImpl;
+    friend class AudioStreamer;
 };
 
 }
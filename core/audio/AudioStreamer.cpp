@@ -0,0 +1,421 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#define LOG_TAG "AudioStreamer"
+
+#include "audio/AudioStreamer.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "audio/AudioCache.h"
+#include "audio/AudioDecoder.h"
+#include "audio/AudioDecoderManager.h"
+#include "audio/AudioPlayer.h"
+#include "base/Tracing.h"
+
+#include "yasio/thread_name.hpp"
+
+namespace ax
+{
+
+AudioStreamer::AudioStreamer()
+    : _needWakeup(false)
+    , _stopped(false)
+    , _servicedPlayer(nullptr)
+    , _activeStreams(0)
+    , _buffersQueued(0)
+    , _underruns(0)
+{}
+
+AudioStreamer::~AudioStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lck(_mutex);
+        _stopped = true;
+    }
+    _condition.notify_all();
+
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+
+    for (auto&& stream : _streams)
+    {
+        closeStream(stream);
+    }
+    _streams.clear();
+    _pendingStreams.clear();
+}
+
+void AudioStreamer::add(AudioPlayer* player, int offsetFrame)
+{
+    std::lock_guard<std::mutex> lck(_mutex);
+
+    auto& stream       = _pendingStreams.emplace_back();
+    stream.player      = player;
+    stream.offsetFrame = offsetFrame;
+    stream.deadline    = clock::now();
+    stream.nextService = stream.deadline;
+    _players.push_back(player);
+    _activeStreams = static_cast<unsigned int>(_players.size());
+
+    if (!_thread.joinable())
+    {
+        _thread = std::thread(&AudioStreamer::threadLoop, this);
+    }
+
+    _needWakeup = true;
+    _condition.notify_one();
+}
+
+void AudioStreamer::remove(AudioPlayer* player)
+{
+    std::unique_lock<std::mutex> lck(_mutex);
+
+    auto it = std::find(_players.begin(), _players.end(), player);
+    if (it == _players.end())
+        return;
+    _players.erase(it);
+    _activeStreams = static_cast<unsigned int>(_players.size());
+
+    auto pending = std::find_if(_pendingStreams.begin(), _pendingStreams.end(),
+                                [player](const Stream& stream) { return stream.player == player; });
+    if (pending != _pendingStreams.end())
+    {
+        // the thread hasn't seen it yet
+        _pendingStreams.erase(pending);
+        return;
+    }
+
+    // the thread skips the stream from now on and closes it on its next pass
+    _removedPlayers.push_back(player);
+    _servicedCondition.wait(lck, [this, player] { return _servicedPlayer != player; });
+
+    _needWakeup = true;
+    _condition.notify_one();
+}
+
+void AudioStreamer::wakeup()
+{
+    // Don't lock _mutex, it may be called by an OpenAL thread while the streaming thread waits on OpenAL
+    _needWakeup = true;
+    _condition.notify_all();
+}
+
+AudioStreamStats AudioStreamer::getStats() const
+{
+    AudioStreamStats stats;
+    stats.activeStreams = _activeStreams;
+    stats.buffersQueued = _buffersQueued;
+    stats.underruns     = _underruns;
+    return stats;
+}
+
+void AudioStreamer::threadLoop()
+{
+    yasio::set_thread_name("axmol-audio");
+    Tracer::setThreadName("axmol-audio");
+
+    std::unique_lock<std::mutex> lck(_mutex);
+    while (!_stopped)
+    {
+        applyPendingStreams();
+        if (_streams.empty())
+        {
+            _condition.wait(lck, [this] { return _stopped || !_pendingStreams.empty(); });
+            continue;
+        }
+
+        // refill the streams closest to running out of queued data first
+        std::sort(_streams.begin(), _streams.end(),
+                  [](const Stream& lhs, const Stream& rhs) { return lhs.deadline < rhs.deadline; });
+
+        auto isRemoved = [this](AudioPlayer* player) {
+            return std::find(_removedPlayers.begin(), _removedPlayers.end(), player) != _removedPlayers.end();
+        };
+
+        auto wakeTime = clock::time_point::max();
+        for (auto it = _streams.begin(); it != _streams.end();)
+        {
+            auto player = it->player;
+            if (isRemoved(player))
+            {
+                ++it;
+                continue;
+            }
+
+            // decode without the lock, remove waits for _servicedPlayer to be reset
+            _servicedPlayer = player;
+            lck.unlock();
+            const bool playing = serviceStream(*it, clock::now());
+            lck.lock();
+
+            if (playing || isRemoved(player))
+            {
+                // a stream removed meanwhile is closed by the next pass
+                if (playing)
+                    wakeTime = (std::min)(wakeTime, it->nextService);
+                ++it;
+            }
+            else
+            {
+                player->_streamFinished = true;
+                closeStream(*it);
+                it = _streams.erase(it);
+                _players.erase(std::find(_players.begin(), _players.end(), player));
+                _activeStreams = static_cast<unsigned int>(_players.size());
+            }
+            _servicedPlayer = nullptr;
+            _servicedCondition.notify_all();
+        }
+
+        if (_streams.empty())
+            continue;
+
+        wakeTime = (std::max)(wakeTime, clock::now() + std::chrono::milliseconds(1));
+        _condition.wait_until(lck, wakeTime, [this] { return _stopped || _needWakeup.exchange(false); });
+    }
+
+    AXLOGV("{}", "Exit audio streaming thread ...");
+}
+
+void AudioStreamer::applyPendingStreams()
+{
+    for (auto player : _removedPlayers)
+    {
+        auto it = std::find_if(_streams.begin(), _streams.end(),
+                               [player](const Stream& stream) { return stream.player == player; });
+        closeStream(*it);
+        _streams.erase(it);
+    }
+    _removedPlayers.clear();
+
+    std::move(_pendingStreams.begin(), _pendingStreams.end(), std::back_inserter(_streams));
+    _pendingStreams.clear();
+}
+
+bool AudioStreamer::serviceStream(Stream& stream, clock::time_point now)
+{
+    auto player                 = stream.player;
+    auto cache                  = player->_audioCache;
+    auto& fullPath              = cache->_fileFullPath;
+    const uint32_t framesToRead = cache->_queBufferFrames;
+    const ALuint alSource       = player->_alSource;
+
+    if (stream.decoder == nullptr)
+    {
+        stream.decoder = AudioDecoderManager::createDecoder(fullPath);
+        if (stream.decoder == nullptr || !stream.decoder->open(fullPath))
+        {
+            AXLOGE("Fail to open decoder for streaming {}", fullPath);
+            return false;
+        }
+
+        stream.buffer.resize(stream.decoder->framesToBytes(framesToRead));
+        if (stream.offsetFrame != 0)
+        {
+            stream.decoder->seek(stream.offsetFrame);
+        }
+    }
+
+    auto decoder          = stream.decoder;
+    const auto sampleRate = decoder->getSampleRate();
+    auto framesToTime     = [sampleRate](int64_t frames) {
+        return std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double>(static_cast<double>(frames) / sampleRate));
+    };
+
+    ALint sourceState = AL_INITIAL;
+    ALint queued      = 0;
+    alGetSourcei(alSource, AL_SOURCE_STATE, &sourceState);
+    alGetSourcei(alSource, AL_BUFFERS_QUEUED, &queued);
+
+    if (sourceState == AL_STOPPED)
+    {
+        /* If no buffers are queued, or all the data was played, playback is finished */
+        if (queued == 0 || stream.eof)
+            return false;
+
+        ++_underruns;
+        AXLOGW("Streaming {} underrun, the source ran out of queued buffers", fullPath);
+    }
+
+    if (queued == 0 && (sourceState == AL_INITIAL || sourceState == AL_PAUSED))
+    {
+        // AudioPlayer::play2d left the buffers for the streamer to fill from the playback position
+        for (auto bid : player->_bufferIds)
+        {
+            auto framesRead = readFrames(stream, false);
+            if (framesRead == 0)
+                break;
+            queueFrames(stream, bid, framesRead);
+        }
+
+        alGetSourcei(alSource, AL_BUFFERS_QUEUED, &queued);
+        if (queued == 0)
+            return false;
+
+        if (sourceState == AL_INITIAL)
+        {
+            alSourcePlay(alSource);
+            sourceState = AL_PLAYING;
+        }
+    }
+    else if (sourceState == AL_PLAYING || sourceState == AL_STOPPED)
+    {
+        ALint bufferProcessed = 0;
+        alGetSourcei(alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
+        while (bufferProcessed > 0 && !stream.eof)
+        {
+            AX_TRACE_ZONE("AudioStreamer::rotateBuffer");
+            auto framesRead = readFrames(stream, true);
+            if (framesRead == 0)
+                break;
+
+            /*
+             While the source is playing, alSourceUnqueueBuffers can be called to remove buffers which have
+             already played. Those buffers can then be filled with new data or discarded. New or refilled
+             buffers can then be attached to the playing source using alSourceQueueBuffers. As long as there is
+             always a new buffer to play in the queue, the source will continue to play.
+             */
+            ALuint bid;
+            alSourceUnqueueBuffers(alSource, 1, &bid);
+            queueFrames(stream, bid, framesRead);
+            --bufferProcessed;
+        }
+
+        /* Make sure the source hasn't underrun */
+        if (sourceState == AL_STOPPED)
+        {
+            // a stopped source replays its whole queue, drop the buffers holding played data
+            ALuint bid;
+            for (; bufferProcessed > 0; --bufferProcessed)
+                alSourceUnqueueBuffers(alSource, 1, &bid);
+
+            alGetSourcei(alSource, AL_BUFFERS_QUEUED, &queued);
+            if (queued == 0)
+                return false;
+
+            alSourcePlay(alSource);
+            if (alGetError() != AL_NO_ERROR)
+            {
+                AXLOGE("{}", "Error restarting playback!");
+                return false;
+            }
+        }
+    }
+
+    // Paused: nothing gets processed, just poll the state
+    if (sourceState != AL_PLAYING && sourceState != AL_STOPPED)
+    {
+        stream.deadline    = clock::time_point::max();
+        stream.nextService = now + framesToTime(framesToRead / 2);
+        return true;
+    }
+
+    ALint sampleOffset = 0;
+    alGetSourcei(alSource, AL_BUFFERS_QUEUED, &queued);
+    alGetSourcei(alSource, AL_SAMPLE_OFFSET, &sampleOffset);
+
+    // The offset counts from the head of the queue, so the source runs dry once it reaches the end of the queue,
+    // and its head buffer gets processed, available for a refill, at the next multiple of framesToRead.
+    const int64_t queuedFrames  = static_cast<int64_t>(queued) * framesToRead;
+    const int64_t headRemaining = framesToRead - sampleOffset % framesToRead;
+    stream.deadline    = now + framesToTime((std::max)(queuedFrames - sampleOffset, int64_t{0}));
+    stream.nextService = now + framesToTime(headRemaining) + std::chrono::milliseconds(1);
+    return true;
+}
+
+uint32_t AudioStreamer::readFrames(Stream& stream, bool advanceTime)
+{
+    auto player                 = stream.player;
+    auto cache                  = player->_audioCache;
+    auto decoder                = stream.decoder;
+    const uint32_t framesToRead = cache->_queBufferFrames;
+
+    if (player->_timeDirty)
+    {
+        player->_timeDirty = false;
+        stream.offsetFrame = static_cast<int>(player->_currTime * decoder->getSampleRate());
+        decoder->seek(stream.offsetFrame);
+    }
+    else if (advanceTime)
+    {
+        player->_currTime += cache->_queBufferTime;
+        if (player->_currTime > cache->_duration)
+        {
+            if (player->_loop)
+            {
+                player->_currTime = 0.0f;
+            }
+            else
+            {
+                player->_currTime = cache->_duration;
+            }
+        }
+    }
+
+    uint32_t framesRead = decoder->readFixedFrames(framesToRead, stream.buffer.data());
+    if (framesRead == 0)
+    {
+        if (player->_loop)
+        {
+            decoder->seek(0);
+            framesRead = decoder->readFixedFrames(framesToRead, stream.buffer.data());
+        }
+        else
+        {
+            // let the queued data play out, the stream finishes when the source stops
+            stream.eof = true;
+        }
+    }
+    return framesRead;
+}
+
+void AudioStreamer::queueFrames(Stream& stream, ALuint bid, uint32_t framesRead)
+{
+    auto decoder          = stream.decoder;
+    const ALuint alSource = stream.player->_alSource;
+#if AX_USE_ALSOFT
+    const auto sourceFormat = decoder->getSourceFormat();
+    if (sourceFormat == AUDIO_SOURCE_FORMAT::ADPCM || sourceFormat == AUDIO_SOURCE_FORMAT::IMA_ADPCM)
+        alBufferi(bid, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, decoder->getSamplesPerBlock());
+#endif
+    alBufferData(bid, stream.player->_audioCache->_format, stream.buffer.data(), decoder->framesToBytes(framesRead),
+                 decoder->getSampleRate());
+    alSourceQueueBuffers(alSource, 1, &bid);
+
+    ++_buffersQueued;
+}
+
+void AudioStreamer::closeStream(Stream& stream)
+{
+    AudioDecoderManager::destroyDecoder(stream.decoder);
+    stream.decoder = nullptr;
+}
+
+}
+#undef LOG_TAG
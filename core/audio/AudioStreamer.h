@@ -0,0 +1,123 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "platform/PlatformConfig.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "audio/AudioEngine.h"
+#include "audio/alconfig.h"
+
+namespace ax
+{
+
+class AudioPlayer;
+class AudioDecoder;
+
+/**
+ * Refills the queued buffers of all streaming AudioPlayers from a single thread.
+ *
+ * Every pass services the streams in deadline order, the deadline of a stream being the time its source runs out of
+ * queued data, then sleeps until the earliest time a queued buffer of any stream is processed. Replaces the thread
+ * per streaming player, so playing many long sounds doesn't spawn as many threads waking up every 25ms.
+ *
+ * The streams are decoded without holding the lock add and remove take, they only queue the change for the next pass.
+ */
+class AX_DLL AudioStreamer
+{
+public:
+    AudioStreamer();
+    ~AudioStreamer();
+
+    /**
+     * Starts refilling the buffers queued on the source of player, the thread is started on the first call.
+     *
+     * @param offsetFrame The frame to decode from, past the data already queued by AudioPlayer::play2d.
+     */
+    void add(AudioPlayer* player, int offsetFrame);
+
+    /**
+     * Stops refilling the buffers of player. The streaming thread no longer touches player when it returns, it waits
+     * if the thread is servicing player.
+     */
+    void remove(AudioPlayer* player);
+
+    /** Wakes the streaming thread up, for notifications that a queued buffer was processed. */
+    void wakeup();
+
+    AudioStreamStats getStats() const;
+
+protected:
+    using clock = std::chrono::steady_clock;
+
+    struct Stream
+    {
+        AudioPlayer* player   = nullptr;
+        AudioDecoder* decoder = nullptr;
+        int offsetFrame       = 0;
+        bool eof              = false;
+        std::vector<char> buffer;
+        clock::time_point deadline;
+        clock::time_point nextService;
+    };
+
+    void threadLoop();
+
+    // applies the streams queued by add and remove, called with _mutex locked
+    void applyPendingStreams();
+
+    // returns false when the stream is finished
+    bool serviceStream(Stream& stream, clock::time_point now);
+    // decodes the next buffer into stream.buffer, returns 0 at the end of a stream which doesn't loop
+    uint32_t readFrames(Stream& stream, bool advanceTime);
+    void queueFrames(Stream& stream, ALuint bid, uint32_t framesRead);
+    void closeStream(Stream& stream);
+
+    std::thread _thread;
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    std::condition_variable _servicedCondition;
+    std::vector<Stream> _streams;  // only used by the streaming thread
+    std::atomic_bool _needWakeup;
+    bool _stopped;
+
+    // guarded by _mutex
+    std::vector<Stream> _pendingStreams;
+    std::vector<AudioPlayer*> _removedPlayers;
+    std::vector<AudioPlayer*> _players;  // the players of _streams and _pendingStreams, not removed yet
+    AudioPlayer* _servicedPlayer;
+
+    std::atomic<unsigned int> _activeStreams;
+    std::atomic<uint64_t> _buffersQueued;
+    std::atomic<uint64_t> _underruns;
+};
+
+}
@@ -50,7 +50,7 @@ THE SOFTWARE.
 #include "base/IMEDispatcher.h"
 #include "base/Map.h"
 #include "base/NS.h"
-#include "base/Profiling.h"
+#include "base/Tracing.h"
 #include "base/Properties.h"
 #include "base/Object.h"
 #include "base/RefPtr.h"
@@ -231,6 +231,10 @@ THE SOFTWARE.
     #include "platform/wasm/StdC-wasm.h"
 #endif // AX_TARGET_PLATFORM == AX_PLATFORM_WASM
 
+#if defined(AX_ENABLE_NULL_DRIVER)
+#    include "platform/GLViewNull.h"
+#endif
+
 // script_support
 #include "base/ScriptSupport.h"
 
@@ -237,14 +237,13 @@ THE SOFTWARE.
 #    define AX_NODE_DEBUG_VERIFY_EVENT_LISTENERS 0
 #endif
 
-/** @def AX_ENABLE_PROFILERS
- * If enabled, will activate various profilers within cocos2d. This statistical data will be output to the console
- * once per second showing average time (in milliseconds) required to execute the specific routine(s).
- * Useful for debugging purposes only. It is recommended to leave it disabled.
- * To enable set it to a value different than 0. Disabled by default.
+/** @def AX_ENABLE_TRACING
+ * If enabled, AX_TRACE_ZONE scopes in the engine can be recorded with ax::Tracer and exported as a Chrome trace.
+ * Recording is still off at runtime until Tracer::start() is called, a disabled zone costs one relaxed atomic load.
+ * To strip all zones from the build set it to 0. Enabled by default.
  */
-#ifndef AX_ENABLE_PROFILERS
-#    define AX_ENABLE_PROFILERS 0
+#ifndef AX_ENABLE_TRACING
+#    define AX_ENABLE_TRACING 1
 #endif
 
 /** Enable Lua engine debug log. */
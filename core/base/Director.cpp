@@ -57,6 +57,7 @@ THE SOFTWARE.
 #include "base/Logging.h"
 #include "base/AutoreleasePool.h"
 #include "base/Configuration.h"
+#include "base/Tracing.h"
 #ifndef AX_CORE_PROFILE
 #    include "base/AsyncTaskPool.h"
 #endif
@@ -119,6 +120,8 @@ bool Director::init()
     // FPS
     _lastUpdate = std::chrono::steady_clock::now();
 
+    Tracer::setThreadName("axmol-main");
+
     auto concurrency = Configuration::getInstance()->getValue("axmol.concurrency", Value{-1}).asInt();
     _jobSystem = new JobSystem(concurrency);
 
@@ -274,6 +277,8 @@ void Director::setGLDefaultValues()
 // Draw the Scene
 void Director::drawScene()
 {
+    AX_TRACE_ZONE("Director::drawScene");
+
     _renderer->beginFrame();
 
     // calculate "global" dt
@@ -281,12 +286,14 @@ void Director::drawScene()
 
     if (_glView)
     {
+        AX_TRACE_ZONE("Director::pollEvents");
         _glView->pollEvents();
     }
 
     // tick before glClear: issue #533
     if (!_paused)
     {
+        AX_TRACE_ZONE("Director::update");
         _eventDispatcher->dispatchEvent(_eventBeforeUpdate);
         _scheduler->update(_deltaTime);
         _eventDispatcher->dispatchEvent(_eventAfterUpdate);
@@ -310,14 +317,20 @@ void Director::drawScene()
     {
 #if (defined(AX_ENABLE_PHYSICS) || (defined(AX_ENABLE_3D_PHYSICS) && AX_ENABLE_BULLET_INTEGRATION) || \
      defined(AX_ENABLE_NAVMESH))
-        _runningScene->stepPhysicsAndNavigation(_deltaTime);
+        {
+            AX_TRACE_ZONE("Director::stepPhysicsAndNavigation");
+            _runningScene->stepPhysicsAndNavigation(_deltaTime);
+        }
 #endif
         // clear draw stats
         _renderer->clearDrawStats();
 
         // render the scene
         if (_glView)
+        {
+            AX_TRACE_ZONE("Director::visit");
             _glView->renderScene(_runningScene, _renderer);
+        }
 
         _eventDispatcher->dispatchEvent(_eventAfterVisit);
     }
@@ -348,6 +361,7 @@ void Director::drawScene()
     // swap buffers
     if (_glView)
     {
+        AX_TRACE_ZONE("Director::swapBuffers");
         _glView->swapBuffers();
     }
 
@@ -1055,6 +1069,10 @@ void Director::reset()
 
     FontFreeType::shutdownFreeType();
 
+    // the async texture decode tasks use FileUtils
+    if (_textureCache)
+        _textureCache->waitForQuit();
+
     // purge all managed caches
     AnimationCache::destroyInstance();
     SpriteFrameCache::destroyInstance();
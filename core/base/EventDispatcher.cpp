@@ -41,6 +41,7 @@
 #include "2d/Scene.h"
 #include "base/Director.h"
 #include "base/EventType.h"
+#include "base/Tracing.h"
 #include "2d/Camera.h"
 #include "2d/ProtectedNode.h"
 
@@ -966,6 +967,8 @@ void EventDispatcher::dispatchEvent(Event* event, bool forced)
     if (!_isEnabled && !forced)
         return;
 
+    AX_TRACE_ZONE("EventDispatcher::dispatchEvent");
+
     updateDirtyFlagForSceneGraph();
 
     DispatchGuard guard(_inDispatch);
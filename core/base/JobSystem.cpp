@@ -25,6 +25,7 @@
 
 #include "base/JobSystem.h"
 #include "base/Director.h"
+#include "base/Tracing.h"
 #include "yasio/thread_name.hpp"
 
 #include <queue>
@@ -34,6 +35,7 @@
 #include <future>
 #include <functional>
 #include <stdexcept>
+#include <atomic>
 
 namespace ax
 {
@@ -48,6 +50,7 @@ public:
             workers.emplace_back([this, thread_data] {
                 thread_data->init();
                 yasio::set_thread_name(thread_data->name());
+                Tracer::setThreadName(thread_data->name());
                 for (;;)
                 {
                     std::function<void(JobThreadData*)> task;
@@ -60,6 +63,7 @@ public:
                         this->tasks.pop();
                     }
 
+                    AX_TRACE_ZONE("JobSystem::task");
                     task(thread_data.get());
                 }
                 thread_data->finz();
@@ -174,6 +178,7 @@ JobSystem::JobSystem(std::span<std::shared_ptr<JobThreadData>> tdds)
 void JobSystem::init(const std::span<std::shared_ptr<JobThreadData>>& tdds)
 {
     _mainThreadData = new MainThreadData();
+    _threadCount    = static_cast<int>(tdds.size());
     if (!tdds.empty())
         _executor = new JobExecutor(tdds);
 }
@@ -233,6 +238,50 @@ void JobSystem::enqueue(std::function<void()> task, std::function<void()> done)
         taskw(_mainThreadData);
 }
 
+void JobSystem::parallelFor(size_t count, std::function<void(size_t)> func, int maxThreads)
+{
+    if (count == 0)
+        return;
+
+    int nHelpers = maxThreads < 0 ? _threadCount : (std::min)(maxThreads - 1, _threadCount);
+    nHelpers     = (std::min)(nHelpers, static_cast<int>(count) - 1);
+    if (!_executor || nHelpers <= 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+            func(i);
+        return;
+    }
+
+    // the state is shared with the helpers, which may be scheduled after all indices were processed
+    struct ParallelState
+    {
+        std::function<void(size_t)> func;
+        size_t count;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+    };
+    auto state   = std::make_shared<ParallelState>();
+    state->func  = std::move(func);
+    state->count = count;
+
+    auto work = [](ParallelState* state) {
+        size_t index;
+        while ((index = state->next.fetch_add(1, std::memory_order_relaxed)) < state->count)
+        {
+            state->func(index);
+            state->done.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    for (int i = 0; i < nHelpers; ++i)
+        _executor->enqueue_v([state, work](JobThreadData*) { work(state.get()); });
+
+    work(state.get());
+
+    while (state->done.load(std::memory_order_acquire) < count)
+        std::this_thread::yield();
+}
+
 #pragma endregion
 
 }
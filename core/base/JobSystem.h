@@ -102,12 +102,23 @@ public:
     void enqueue(std::function<void()> task, std::function<void()> done);
     void enqueue(std::shared_ptr<JobThreadTask> task);
 
+    /**
+     * Invokes func(index) for each index in [0, count) and waits for all of them to complete.
+     * The calling thread takes part in the work, so it makes progress even when all workers are busy.
+     * @param maxThreads The max number of threads to use including the calling thread, -1 means all workers.
+     */
+    void parallelFor(size_t count, std::function<void(size_t)> func, int maxThreads = -1);
+
+    /** Gets the number of worker threads. */
+    int getThreadCount() const { return _threadCount; }
+
  protected:
     void init(const std::span<std::shared_ptr<JobThreadData>>& tdds);
 
 private:
     JobExecutor* _executor{nullptr};
     JobThreadData* _mainThreadData{nullptr};
+    int _threadCount{0};
 };
 
 }
@@ -197,108 +197,6 @@ It should work same as apples CFSwapInt32LittleToHost(..)
 #define AX_SWAP_INT32_BIG_TO_HOST(i)    ((AX_HOST_IS_BIG_ENDIAN == true) ? (i) : AX_SWAP32(i))
 #define AX_SWAP_INT16_BIG_TO_HOST(i)    ((AX_HOST_IS_BIG_ENDIAN == true) ? (i) : AX_SWAP16(i))
 
-/**********************/
-/** Profiling Macros **/
-/**********************/
-#if AX_ENABLE_PROFILERS
-
-#    define AX_PROFILER_DISPLAY_TIMERS() ax::Profiler::getInstance()->displayTimers()
-#    define AX_PROFILER_PURGE_ALL()      ax::Profiler::getInstance()->releaseAllTimers()
-
-#    define AX_PROFILER_START(__name__)  ax::ProfilingBeginTimingBlock(__name__)
-#    define AX_PROFILER_STOP(__name__)   ax::ProfilingEndTimingBlock(__name__)
-#    define AX_PROFILER_RESET(__name__)  ax::ProfilingResetTimingBlock(__name__)
-
-#    define AX_PROFILER_START_CATEGORY(__cat__, __name__)   \
-        do                                                  \
-        {                                                   \
-            if (__cat__)                                    \
-                ax::ProfilingBeginTimingBlock(__name__); \
-        } while (0)
-#    define AX_PROFILER_STOP_CATEGORY(__cat__, __name__)  \
-        do                                                \
-        {                                                 \
-            if (__cat__)                                  \
-                ax::ProfilingEndTimingBlock(__name__); \
-        } while (0)
-#    define AX_PROFILER_RESET_CATEGORY(__cat__, __name__)   \
-        do                                                  \
-        {                                                   \
-            if (__cat__)                                    \
-                ax::ProfilingResetTimingBlock(__name__); \
-        } while (0)
-
-#    define AX_PROFILER_START_INSTANCE(__id__, __name__)                                       \
-        do                                                                                     \
-        {                                                                                      \
-            ax::ProfilingBeginTimingBlock(                                                  \
-                ax::String::createWithFormat("%08X - %s", __id__, __name__)->getCString()); \
-        } while (0)
-#    define AX_PROFILER_STOP_INSTANCE(__id__, __name__)                                        \
-        do                                                                                     \
-        {                                                                                      \
-            ax::ProfilingEndTimingBlock(                                                    \
-                ax::String::createWithFormat("%08X - %s", __id__, __name__)->getCString()); \
-        } while (0)
-#    define AX_PROFILER_RESET_INSTANCE(__id__, __name__)                                       \
-        do                                                                                     \
-        {                                                                                      \
-            ax::ProfilingResetTimingBlock(                                                  \
-                ax::String::createWithFormat("%08X - %s", __id__, __name__)->getCString()); \
-        } while (0)
-
-#else
-
-#    define AX_PROFILER_DISPLAY_TIMERS() \
-        do                               \
-        {                                \
-        } while (0)
-#    define AX_PROFILER_PURGE_ALL() \
-        do                          \
-        {                           \
-        } while (0)
-
-#    define AX_PROFILER_START(__name__) \
-        do                              \
-        {                               \
-        } while (0)
-#    define AX_PROFILER_STOP(__name__) \
-        do                             \
-        {                              \
-        } while (0)
-#    define AX_PROFILER_RESET(__name__) \
-        do                              \
-        {                               \
-        } while (0)
-
-#    define AX_PROFILER_START_CATEGORY(__cat__, __name__) \
-        do                                                \
-        {                                                 \
-        } while (0)
-#    define AX_PROFILER_STOP_CATEGORY(__cat__, __name__) \
-        do                                               \
-        {                                                \
-        } while (0)
-#    define AX_PROFILER_RESET_CATEGORY(__cat__, __name__) \
-        do                                                \
-        {                                                 \
-        } while (0)
-
-#    define AX_PROFILER_START_INSTANCE(__id__, __name__) \
-        do                                               \
-        {                                                \
-        } while (0)
-#    define AX_PROFILER_STOP_INSTANCE(__id__, __name__) \
-        do                                              \
-        {                                               \
-        } while (0)
-#    define AX_PROFILER_RESET_INSTANCE(__id__, __name__) \
-        do                                               \
-        {                                                \
-        } while (0)
-
-#endif
-
 /*********************************/
 /** 64bits Program Sense Macros **/
 /*********************************/
@@ -31,10 +31,30 @@ THE SOFTWARE.
 #include "base/Macros.h"
 #include "base/Director.h"
 #include "base/ScriptSupport.h"
+#include "base/Tracing.h"
 
 namespace ax
 {
 
+namespace
+{
+enum TimerState : uint8_t
+{
+    TIMER_UNSCHEDULED,
+    TIMER_PENDING,     // in Scheduler::_pendingTimers
+    TIMER_WHEEL,       // in a slot of Scheduler::_timerWheel
+    TIMER_FRAME,       // in Scheduler::_frameTimers
+    TIMER_PAUSED,      // in no list, Timer::_deadline is the time left to its next trigger
+    TIMER_TRIGGERING,  // in no list, its callback is running
+};
+
+inline uint64_t toTimerTick(double time, int ticksPerSecond)
+{
+    double tick = time * ticksPerSecond;
+    return tick <= 0 ? 0 : tick >= 0x1p62 ? (uint64_t(1) << 62) : static_cast<uint64_t>(tick);
+}
+}  // namespace
+
 // implementation Timer
 
 Timer::Timer()
@@ -47,7 +67,9 @@ Timer::Timer()
     , _delay(0.0f)
     , _interval(0.0f)
     , _aborted(false)
-{}
+{
+    _link.timer = this;
+}
 
 void Timer::setupTimerWithInterval(float seconds, unsigned int repeat, float delay)
 {
@@ -218,8 +240,6 @@ const int Scheduler::PRIORITY_NON_SYSTEM_MIN = PRIORITY_SYSTEM + 1;
 
 Scheduler::Scheduler()
     : _timeScale(1.0f)
-    , _currentTarget(nullptr)
-    , _currentTargetSalvaged(false)
     , _indexMapLocked(false)
 #if AX_ENABLE_SCRIPT_BINDING
     , _scriptHandlerEntries(20)
@@ -254,10 +274,53 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
     AXASSERT(target, "Argument target must be non-nullptr");
     AXASSERT(!key.empty(), "key should not be empty!");
 
+    auto& handle = getTimerHandle(target, paused);
+
+    // an exhausted timer is running its last trigger, it's replaced by a new one
+    auto timerIt = handle.callbacks.find(key);
+    if (timerIt != handle.callbacks.end() && !timerIt->second->isExhausted())
+    {
+        AXLOGD("Scheduler#schedule. Reiniting timer with interval {:.4f}, repeat {}, delay {:.4f}", interval, repeat,
+              delay);
+        timerIt->second->setupTimerWithInterval(interval, repeat, delay);
+        restartTimer(timerIt->second);
+        return;
+    }
+
+    TimerTargetCallback* timer = new TimerTargetCallback();
+    timer->initWithCallback(this, callback, target, key, interval, repeat, delay);
+    if (timerIt != handle.callbacks.end())
+        timerIt.value() = timer;
+    else
+        handle.callbacks.emplace(key, timer);
+    addTimer(handle, timer);
+}
+
+void Scheduler::unschedule(std::string_view key, void* target)
+{
+    // explicit handle nil arguments when removing an object
+    if (target == nullptr || key.empty())
+    {
+        return;
+    }
+
+    auto timerIt = _timersMap.find(target);
+    if (timerIt != _timersMap.end())
+    {
+        auto& callbacks = timerIt->second.callbacks;
+        auto callbackIt = callbacks.find(key);
+        if (callbackIt != callbacks.end())
+            removeTimer(callbackIt->second);
+    }
+}
+
+TimerHandle& Scheduler::getTimerHandle(void* target, bool paused)
+{
     auto timerIt = _timersMap.find(target);
     if (timerIt == _timersMap.end())
     {
-        timerIt = _timersMap.emplace(target, TimerHandle{}).first;
+        timerIt                = _timersMap.try_emplace(target).first;
+        timerIt->second.target = target;
 
         // Is this the 1st element ? Then set the pause level to all the selectors of this target
         timerIt->second.paused = paused;
@@ -266,80 +329,265 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
     {
         AXASSERT(timerIt->second.paused == paused, "element's paused should be paused!");
     }
+    return timerIt->second;
+}
+
+void Scheduler::addTimer(TimerHandle& handle, Timer* timer)
+{
+    // the handle takes the reference of the new timer
+    timer->_handle      = &handle;
+    timer->_handleIndex = static_cast<uint32_t>(handle.timers.size());
+    handle.timers.emplace_back(timer);
+
+    timer->_state = TIMER_PENDING;
+    _pendingTimers.pushBack(&timer->_link);
+}
+
+void Scheduler::restartTimer(Timer* timer)
+{
+    // a triggering timer stops triggering, see triggerTimer()
+    timer->_link.unlink();
+    timer->_state = TIMER_PENDING;
+    _pendingTimers.pushBack(&timer->_link);
+}
 
-    auto& timers = timerIt->second.timers;
-    if (timers.empty())
+void Scheduler::removeTimer(Timer* timer)
+{
+    auto& handle = *timer->_handle;
+
+    timer->_link.unlink();
+    timer->_state  = TIMER_UNSCHEDULED;
+    timer->_handle = nullptr;
+    timer->setAborted();
+
+    if (auto callback = dynamic_cast<TimerTargetCallback*>(timer))
     {
-        timers.reserve(10);
+        // the key may belong to a newer timer already
+        auto callbackIt = handle.callbacks.find(callback->getKey());
+        if (callbackIt != handle.callbacks.end() && callbackIt->second == callback)
+            handle.callbacks.erase(callbackIt);
     }
-    else
+
+    auto last                          = handle.timers.back();
+    handle.timers[timer->_handleIndex] = last;
+    last->_handleIndex                 = timer->_handleIndex;
+    handle.timers.resize(handle.timers.size() - 1);
+
+    if (handle.timers.empty())
+        _timersMap.erase(handle.target);
+
+    timer->release();
+}
+
+void Scheduler::removeAllTimers(TimerHandle& handle)
+{
+    // the handle is destroyed with its last timer, and releasing a timer may unschedule more of them
+    auto target = handle.target;
+    for (auto timerIt = _timersMap.find(target); timerIt != _timersMap.end(); timerIt = _timersMap.find(target))
+        removeTimer(timerIt->second.timers.back());
+}
+
+void Scheduler::pauseTimers(TimerHandle& handle)
+{
+    for (auto timer : handle.timers)
     {
-        auto timerIt = std::find_if(timers.begin(), timers.end(), [&key](Timer* const itimer) {
-            TimerTargetCallback* timer = dynamic_cast<TimerTargetCallback*>(itimer);
-            return timer && !timer->isExhausted() && key == timer->getKey();
-        });
-        if (timerIt != timers.end())
+        if (timer->_state == TIMER_WHEEL || timer->_state == TIMER_FRAME)
         {
-            AXLOGD("Scheduler#schedule. Reiniting timer with interval {:.4f}, repeat {}, delay {:.4f}", interval, repeat,
-                  delay);
-            (*timerIt)->setupTimerWithInterval(interval, repeat, delay);
-            return;
+            timer->_link.unlink();
+            timer->_deadline = timer->_state == TIMER_WHEEL ? timer->_deadline - _timerTime : 0;
+            timer->_state    = TIMER_PAUSED;
         }
     }
+}
 
-    TimerTargetCallback* timer = new TimerTargetCallback();
-    timer->initWithCallback(this, callback, target, key, interval, repeat, delay);
-    timers.pushBack(timer);
-    timer->release();
+void Scheduler::resumeTimers(TimerHandle& handle)
+{
+    for (auto timer : handle.timers)
+    {
+        if (timer->_state == TIMER_PAUSED)
+        {
+            timer->_deadline += _timerTime;
+            insertTimer(timer);
+        }
+    }
 }
 
-void Scheduler::unschedule(std::string_view key, void* target)
+void Scheduler::activateTimer(Timer* timer)
 {
-    // explicit handle nil arguments when removing an object
-    if (target == nullptr || key.empty())
+    // the time counts from now, as Timer::update() ignores the time of its first call
+    timer->_deadline = timer->_useDelay ? timer->_delay : timer->_interval;
+    if (timer->_handle->paused)
     {
+        timer->_state = TIMER_PAUSED;
+    }
+    else
+    {
+        timer->_deadline += _timerTime;
+        insertTimer(timer);
+    }
+}
+
+void Scheduler::insertTimer(Timer* timer)
+{
+    if (!timer->_useDelay && timer->_interval <= 0)
+    {
+        timer->_state = TIMER_FRAME;
+        _frameTimers.pushBack(&timer->_link);
         return;
     }
 
-    auto timerIt = _timersMap.find(target);
-    if (timerIt != _timersMap.end())
+    // the slot is relative to the next tick to process, a far timer goes to a higher level and moves down as the
+    // wheel turns. The deadline is checked when a slot is processed, so a timer can be early in the wheel, never late.
+    auto tick  = std::max(toTimerTick(timer->_deadline, TIMER_TICKS_PER_SECOND), _timerTick);
+    auto delta = tick - _timerTick;
+    int level  = 0;
+    if (delta >= (uint64_t(1) << 32))
+    {
+        tick  = _timerTick + (uint64_t(1) << 32) - 1;
+        level = 3;
+    }
+    else if (delta >= (1 << 24))
+        level = 3;
+    else if (delta >= (1 << 16))
+        level = 2;
+    else if (delta >= (1 << 8))
+        level = 1;
+
+    timer->_state = TIMER_WHEEL;
+    _timerWheel[level][(tick >> (level * 8)) & (TIMER_WHEEL_SLOTS - 1)].pushBack(&timer->_link);
+}
+
+void Scheduler::triggerTimer(Timer* timer)
+{
+    // keeps the timer alive if its callback unschedules it
+    timer->retain();
+    timer->_state = TIMER_TRIGGERING;
+
+    // a timer behind by more than an interval catches up in this frame, as in Timer::update()
+    bool delayed = false;
+    for (;;)
+    {
+        timer->_timesExecuted += 1;  // important to increment before call trigger
+        float dt;
+        if (timer->_useDelay)
+        {
+            dt               = timer->_delay;
+            timer->_useDelay = false;
+            delayed          = true;
+        }
+        else if (timer->_interval > 0)
+        {
+            dt = timer->_interval;
+        }
+        else
+        {
+            // a timer without interval triggers once more with the rest of the frame after its delay
+            dt      = static_cast<float>(_timerTime - timer->_deadline);
+            delayed = false;
+        }
+        timer->trigger(dt);
+
+        // the callback may have unscheduled or restarted the timer
+        if (timer->_state != TIMER_TRIGGERING)
+            break;
+
+        if (timer->isExhausted())
+        {
+            removeTimer(timer);
+            break;
+        }
+
+        // then it's triggered every frame
+        if (timer->_interval <= 0)
+        {
+            if (delayed)
+                continue;
+            break;
+        }
+
+        timer->_deadline += timer->_interval;
+        if (timer->_deadline > _timerTime || timer->_handle->paused)
+            break;
+    }
+
+    if (timer->_state == TIMER_TRIGGERING)
     {
-        auto& timerHandle = timerIt->second;
-        for (int i = 0; i < timerHandle.timers.size(); ++i)
+        if (timer->_handle->paused)
         {
-            TimerTargetCallback* timer = dynamic_cast<TimerTargetCallback*>(timerHandle.timers[i]);
+            timer->_deadline -= _timerTime;
+            timer->_state = TIMER_PAUSED;
+        }
+        else
+            insertTimer(timer);
+    }
 
-            if (timer && key == timer->getKey())
+    timer->release();
+}
+
+void Scheduler::updateTimers(float dt)
+{
+    _timerTime += dt;
+
+    // the timers without interval, the ones which are unscheduled or paused by a callback leave the local list
+    TimerLink frameTimers;
+    _frameTimers.spliceTo(frameTimers);
+    while (!frameTimers.empty())
+    {
+        auto timer = frameTimers.next->timer;
+        timer->_link.unlink();
+        _frameTimers.pushBack(&timer->_link);
+
+        timer->retain();
+        timer->_timesExecuted += 1;  // important to increment before call trigger
+        timer->trigger(dt);
+        if (timer->_state == TIMER_FRAME && timer->isExhausted())
+            removeTimer(timer);
+        timer->release();
+    }
+
+    // turn the wheel up to the current tick, the slot of the current tick is processed again by the next update
+    // since its timers may not be due yet
+    const auto lastTick = toTimerTick(_timerTime, TIMER_TICKS_PER_SECOND);
+    for (;;)
+    {
+        const auto tick = _timerTick;
+
+        // when the lower levels wrap, the next slot of a level moves down
+        for (int level = 1; level < TIMER_WHEEL_LEVELS && (tick & ((uint64_t(1) << (level * 8)) - 1)) == 0; ++level)
+        {
+            TimerLink timers;
+            _timerWheel[level][(tick >> (level * 8)) & (TIMER_WHEEL_SLOTS - 1)].spliceTo(timers);
+            while (!timers.empty())
             {
-                if (timer == timerHandle.currentTimer && (!timer->isAborted()))
-                {
-                    timer->retain();
-                    timer->setAborted();
-                }
-
-                timerHandle.timers.erase(i);
-
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (timerHandle.timerIndex >= i)
-                {
-                    timerHandle.timerIndex--;
-                }
-
-                if (timerHandle.timers.empty())
-                {
-                    if (_currentTarget == &timerHandle)
-                    {
-                        _currentTargetSalvaged = true;
-                    }
-                    else
-                    {
-                        _timersMap.erase(timerIt);
-                    }
-                }
-
-                return;
+                auto timer = timers.next->timer;
+                timer->_link.unlink();
+                insertTimer(timer);
             }
         }
+
+        TimerLink timers;
+        _timerWheel[0][tick & (TIMER_WHEEL_SLOTS - 1)].spliceTo(timers);
+        while (!timers.empty())
+        {
+            auto timer = timers.next->timer;
+            timer->_link.unlink();
+            if (timer->_deadline <= _timerTime)
+                triggerTimer(timer);
+            else
+                insertTimer(timer);
+        }
+
+        if (tick >= lastTick)
+            break;
+        ++_timerTick;
+    }
+
+    // the timers scheduled before or during this update start counting now
+    while (!_pendingTimers.empty())
+    {
+        auto timer = _pendingTimers.next->timer;
+        timer->_link.unlink();
+        activateTimer(timer);
     }
 }
 
@@ -451,13 +699,9 @@ bool Scheduler::isScheduled(std::string_view key, const void* target) const
     if (timerIt == _timersMap.end())
         return false;
 
-    auto&& timers    = timerIt->second.timers;
-    const bool found = !timers.empty() && std::find_if(timers.begin(), timers.end(), [&key](Timer* const itimer) {
-                                              auto timer = dynamic_cast<TimerTargetCallback*>(itimer);
-                                              return (timer && !timer->isExhausted() && key == timer->getKey());
-                                          }) != timers.end();
-
-    return found;
+    auto&& callbacks = timerIt->second.callbacks;
+    auto callbackIt  = callbacks.find(key);
+    return callbackIt != callbacks.end() && !callbackIt->second->isExhausted();
 }
 
 void Scheduler::unscheduleUpdate(void* target)
@@ -495,9 +739,9 @@ void Scheduler::unscheduleAll()
 void Scheduler::unscheduleAllWithMinPriority(int minPriority)
 {
     // Custom Selectors
-    for (auto timerIt = _timersMap.begin(); timerIt != _timersMap.end();)
+    while (!_timersMap.empty())
     {
-        unscheduleAllForTarget(timerIt);
+        unscheduleAllForTarget(_timersMap.begin()->first);
     }
 
     for (auto&& entry : _waitList)
@@ -548,31 +792,7 @@ void Scheduler::unscheduleAllForTarget(void* target)
     // Custom Selectors
     auto timerIt = _timersMap.find(target);
     if (timerIt != _timersMap.end())
-        unscheduleAllForTarget(timerIt);
-    else
-        unscheduleUpdate(target);
-}
-
-void Scheduler::unscheduleAllForTarget(std::unordered_map<void*, TimerHandle>::iterator& timerIt)
-{
-    auto const target = timerIt->first;
-    auto& timerHandle = timerIt->second;
-    if (timerHandle.timers.contains(timerHandle.currentTimer) && (!timerHandle.currentTimer->isAborted()))
-    {
-        timerHandle.currentTimer->retain();
-        timerHandle.currentTimer->setAborted();
-    }
-    timerHandle.timers.clear();
-
-    if (_currentTarget == &timerHandle)
-    {
-        _currentTargetSalvaged = true;
-        ++timerIt;
-    }
-    else
-    {
-        timerIt = _timersMap.erase(timerIt);
-    }
+        removeAllTimers(timerIt->second);
 
     unscheduleUpdate(target);
 }
@@ -606,9 +826,10 @@ void Scheduler::resumeTarget(void* target)
 
     // custom selectors
     auto timerIt = _timersMap.find(target);
-    if (timerIt != _timersMap.end())
+    if (timerIt != _timersMap.end() && timerIt->second.paused)
     {
         timerIt->second.paused = false;
+        resumeTimers(timerIt->second);
     }
 
     // update selector
@@ -625,9 +846,10 @@ void Scheduler::pauseTarget(void* target)
 
     // custom selectors
     auto timerIt = _timersMap.find(target);
-    if (timerIt != _timersMap.end())
+    if (timerIt != _timersMap.end() && !timerIt->second.paused)
     {
         timerIt->second.paused = true;
+        pauseTimers(timerIt->second);
     }
 
     // update selector
@@ -671,7 +893,11 @@ std::set<void*> Scheduler::pauseAllTargetsWithMinPriority(int minPriority)
     // Custom Selectors
     for (auto& [target, timerHandle] : _timersMap)
     {
-        timerHandle.paused = true;
+        if (!timerHandle.paused)
+        {
+            timerHandle.paused = true;
+            pauseTimers(timerHandle);
+        }
         idsWithSelectors.insert(target);
     }
 
@@ -732,6 +958,8 @@ void Scheduler::removeAllPendingActions()
 // main loop
 void Scheduler::update(float dt)
 {
+    AX_TRACE_ZONE("Scheduler::update");
+
     // active waitlist
     if (!_waitList.empty())
         activeWaitList();
@@ -776,42 +1004,7 @@ void Scheduler::update(float dt)
     }
 
     // Iterate over all the custom selectors
-    for (auto it = _timersMap.begin(); it != _timersMap.end();)
-    {
-        auto elt               = &it->second;
-        _currentTarget         = elt;
-        _currentTargetSalvaged = false;
-
-        if (!_currentTarget->paused)
-        {
-            // The 'timers' array may change while inside this loop
-            for (elt->timerIndex = 0; elt->timerIndex < elt->timers.size(); ++(elt->timerIndex))
-            {
-                elt->currentTimer = elt->timers[elt->timerIndex];
-                AXASSERT(!elt->currentTimer->isAborted(), "An aborted timer should not be updated");
-
-                elt->currentTimer->update(dt);
-
-                if (elt->currentTimer->isAborted())
-                {
-                    // The currentTimer told the remove itself. To prevent the timer from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    elt->currentTimer->release();
-                }
-
-                elt->currentTimer = nullptr;
-            }
-        }
-
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
-        if (_currentTargetSalvaged && _currentTarget->timers.empty())
-        {
-            it = _timersMap.erase(it);
-        }
-        else
-            ++it;
-    }
+    updateTimers(dt);
 
     // delete all updates that are removed in update
     for (auto&& sched : _updateDeleteVector)
@@ -823,7 +1016,6 @@ void Scheduler::update(float dt)
     _updateDeleteVector.clear();
 
     _indexMapLocked = false;
-    _currentTarget  = nullptr;
 
 #if AX_ENABLE_SCRIPT_BINDING
     //
@@ -877,44 +1069,25 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
 {
     AXASSERT(target, "Argument target must be non-nullptr");
 
-    auto timerIt = _timersMap.find(target);
-
-    if (timerIt == _timersMap.end())
-    {
-        timerIt = _timersMap.emplace(target, TimerHandle{}).first;
-
-        // Is this the 1st element ? Then set the pause level to all the selectors of this target
-        timerIt->second.paused = paused;
-    }
-    else
-    {
-        AXASSERT(timerIt->second.paused == paused, "element's paused should be paused.");
-    }
+    auto& handle = getTimerHandle(target, paused);
 
-    auto&& timers = timerIt->second.timers;
-    if (timers.empty())
-    {
-        timers.reserve(10);
-    }
-    else
+    // selectors are few per target, they're looked up among its timers
+    for (auto timer : handle.timers)
     {
-        auto timerIt = std::find_if(timers.begin(), timers.end(), [selector](Timer* const itimer) {
-            TimerTargetSelector* timer = dynamic_cast<TimerTargetSelector*>(itimer);
-            return timer && !timer->isExhausted() && selector == timer->getSelector();
-        });
-        if (timerIt != timers.end())
+        auto selectorTimer = dynamic_cast<TimerTargetSelector*>(timer);
+        if (selectorTimer && !selectorTimer->isExhausted() && selector == selectorTimer->getSelector())
         {
             AXLOGD("Scheduler#schedule. Reiniting timer with interval {:.4}, repeat {}, delay {:.4f}", interval, repeat,
                   delay);
-            (*timerIt)->setupTimerWithInterval(interval, repeat, delay);
+            selectorTimer->setupTimerWithInterval(interval, repeat, delay);
+            restartTimer(selectorTimer);
             return;
         }
     }
 
     TimerTargetSelector* timer = new TimerTargetSelector();
     timer->initWithSelector(this, selector, target, interval, repeat, delay);
-    timers.pushBack(timer);
-    timer->release();
+    addTimer(handle, timer);
 }
 
 void Scheduler::schedule(SEL_SCHEDULE selector, Object* target, float interval, bool paused)
@@ -934,13 +1107,10 @@ bool Scheduler::isScheduled(SEL_SCHEDULE selector, const Object* target) const
     }
 
     auto&& timers = timerIt->second.timers;
-    const auto found =
-        !timers.empty() && std::find_if(timers.begin(), timers.end(), [selector](Timer* const itimer) {
-                               auto timer = dynamic_cast<TimerTargetSelector*>(itimer);
-                               return (timer && !timer->isExhausted() && selector == timer->getSelector());
-                           }) != timers.end();
-
-    return found;
+    return std::find_if(timers.begin(), timers.end(), [selector](Timer* const itimer) {
+               auto timer = dynamic_cast<TimerTargetSelector*>(itimer);
+               return (timer && !timer->isExhausted() && selector == timer->getSelector());
+           }) != timers.end();
 }
 
 void Scheduler::unschedule(SEL_SCHEDULE selector, Object* target)
@@ -954,44 +1124,21 @@ void Scheduler::unschedule(SEL_SCHEDULE selector, Object* target)
     auto timerIt = _timersMap.find(target);
     if (timerIt != _timersMap.end())
     {
-        auto& timerHandle = timerIt->second;
-        auto&& timers     = timerHandle.timers;
-        for (int i = 0; i < timers.size(); ++i)
+        // an exhausted timer running its last trigger may have been rescheduled, the new one is unscheduled first
+        TimerTargetSelector* found = nullptr;
+        for (auto timer : timerIt->second.timers)
         {
-            TimerTargetSelector* timer = dynamic_cast<TimerTargetSelector*>(timers[i]);
-
-            if (timer && selector == timer->getSelector())
+            auto selectorTimer = dynamic_cast<TimerTargetSelector*>(timer);
+            if (selectorTimer && selector == selectorTimer->getSelector())
             {
-                if (timer == timerHandle.currentTimer && !timer->isAborted())
-                {
-                    timer->retain();
-                    timer->setAborted();
-                }
-
-                timers.erase(i);
-
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (timerHandle.timerIndex >= i)
-                {
-                    timerHandle.timerIndex--;
-                }
-
-                if (timers.empty())
-                {
-                    if (_currentTarget == &timerHandle)
-                    {
-                        _currentTargetSalvaged = true;
-                    }
-                    else
-                    {
-                        _timersMap.erase(timerIt);
-                    }
-                }
-
-                return;
+                found = selectorTimer;
+                if (!selectorTimer->isExhausted())
+                    break;
             }
         }
+
+        if (found)
+            removeTimer(found);
     }
 }
-
 }
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include <mutex>
 #include <set>
 #include "base/axstd.h"
+#include "base/hlookup.h"
 #include "base/Object.h"
 #include "base/Vector.h"
 
@@ -40,14 +41,58 @@ namespace ax
 {
 
 class Scheduler;
+class Timer;
+struct TimerHandle;
 
 typedef std::function<void(float)> ccSchedulerFunc;
 
 /**
  * @cond
  */
+
+// intrusive links of the scheduler timer lists, a list is circular around a sentinel without timer
+struct TimerLink
+{
+    TimerLink* prev = this;
+    TimerLink* next = this;
+    Timer* timer    = nullptr;
+
+    TimerLink() = default;
+    TimerLink(const TimerLink&) = delete;
+    TimerLink& operator=(const TimerLink&) = delete;
+
+    bool empty() const { return next == this; }
+    bool linked() const { return next != this; }
+    void unlink()
+    {
+        prev->next = next;
+        next->prev = prev;
+        prev = next = this;
+    }
+    void pushBack(TimerLink* link)
+    {
+        link->prev = prev;
+        link->next = this;
+        prev->next = link;
+        prev       = link;
+    }
+    // moves all the links of this list to the end of another one
+    void spliceTo(TimerLink& list)
+    {
+        if (empty())
+            return;
+        next->prev      = list.prev;
+        prev->next      = &list;
+        list.prev->next = next;
+        list.prev       = prev;
+        prev = next = this;
+    }
+};
+
 class AX_DLL Timer : public Object
 {
+    friend class Scheduler;
+
 protected:
     Timer();
 
@@ -73,6 +118,13 @@ protected:
     float _delay;
     float _interval;
     bool _aborted;
+
+    // Scheduler bookkeeping
+    TimerLink _link;
+    TimerHandle* _handle = nullptr;  // nullptr once unscheduled
+    double _deadline     = 0;        // scheduler time of the next trigger, time left to it while paused
+    uint32_t _handleIndex = 0;
+    uint8_t _state        = 0;
 };
 
 class AX_DLL TimerTargetSelector : public Timer
@@ -171,10 +223,10 @@ struct SchedHandle
 
 struct TimerHandle
 {
-    Vector<Timer*> timers;
-    int timerIndex;
-    Timer* currentTimer;
-    bool paused;
+    void* target = nullptr;
+    axstd::pod_vector<Timer*> timers;                     // retained, unordered
+    hlookup::string_map<TimerTargetCallback*> callbacks;  // the callback timers by key
+    bool paused = false;
 };
 
 #if AX_ENABLE_SCRIPT_BINDING
@@ -192,6 +244,10 @@ There are 2 different types of callbacks (selectors):
 The 'custom selectors' should be avoided when possible. It is faster, and consumes less memory to use the 'update
 selector'.
 
+Custom selectors with an interval are kept in a hierarchical timing wheel, so the cost of a frame depends on the
+timers which trigger in it rather than on the number of scheduled ones. Scheduling and unscheduling a callback by
+key are constant time, selectors are looked up among the timers of their target.
+
 */
 class AX_DLL Scheduler : public Object
 {
@@ -511,7 +567,18 @@ protected:
 
     void activeWaitList();
 
-    void unscheduleAllForTarget(std::unordered_map<void*, TimerHandle>::iterator& timerIt);
+    TimerHandle& getTimerHandle(void* target, bool paused);
+    void addTimer(TimerHandle& handle, Timer* timer);
+    void restartTimer(Timer* timer);
+    void removeTimer(Timer* timer);
+    void removeAllTimers(TimerHandle& handle);
+    void pauseTimers(TimerHandle& handle);
+    void resumeTimers(TimerHandle& handle);
+
+    void activateTimer(Timer* timer);
+    void insertTimer(Timer* timer);
+    void triggerTimer(Timer* timer);
+    void updateTimers(float dt);
 
     float _timeScale;
 
@@ -531,8 +598,17 @@ protected:
 
     // Used for "selectors with interval"
     std::unordered_map<void*, TimerHandle> _timersMap;
-    struct TimerHandle* _currentTarget;
-    bool _currentTargetSalvaged;
+
+    // the timers of the interval selectors are in a timing wheel of 4 levels of 256 slots, a tick of the wheel is
+    // 1/TIMER_TICKS_PER_SECOND seconds and a slot of a level spans 256 slots of the level below
+    static constexpr int TIMER_TICKS_PER_SECOND = 256;
+    static constexpr int TIMER_WHEEL_LEVELS     = 4;
+    static constexpr int TIMER_WHEEL_SLOTS      = 256;
+    TimerLink _timerWheel[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    uint64_t _timerTick = 0;  // the tick of the wheel to process next
+    double _timerTime   = 0;  // the scaled time elapsed in update(), in seconds
+    TimerLink _frameTimers;    // timers without interval, triggered every frame
+    TimerLink _pendingTimers;  // new or restarted timers, they start at the end of the next update
     // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
     bool _indexMapLocked;
 
@@ -0,0 +1,264 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "base/Tracing.h"
+#include "base/JsonWriter.h"
+#include "platform/FileUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ax
+{
+
+namespace
+{
+struct TraceEvent
+{
+    const TraceZoneInfo* zone;
+    int64_t start;
+    int64_t duration;
+};
+
+// Single producer ring, only the owner thread writes events and head.
+struct ThreadTraceBuffer
+{
+    ThreadTraceBuffer(uint32_t capacity, uint32_t tid)
+        : events(new TraceEvent[capacity]), mask(capacity - 1), tid(tid)
+    {}
+
+    std::unique_ptr<TraceEvent[]> events;
+    uint32_t mask;
+    uint32_t tid;
+    std::atomic<uint64_t> head{0};
+    std::atomic<bool> retired{false};
+    std::string name;
+};
+
+struct TraceRegistry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadTraceBuffer>> buffers;
+    uint32_t capacity{Tracer::DEFAULT_EVENTS_PER_THREAD};
+    uint32_t nextTid{1};
+};
+
+// Intentionally leaked, thread_local slots may be destroyed after static destruction has started.
+TraceRegistry& registry()
+{
+    static TraceRegistry* s_registry = new TraceRegistry();
+    return *s_registry;
+}
+
+struct ThreadTraceSlot
+{
+    ~ThreadTraceSlot()
+    {
+        if (buffer)
+            buffer->retired.store(true, std::memory_order_release);
+    }
+    ThreadTraceBuffer* buffer{nullptr};
+    std::string name;
+};
+
+thread_local ThreadTraceSlot t_traceSlot;
+
+ThreadTraceBuffer* threadBuffer()
+{
+    auto buffer = t_traceSlot.buffer;
+    if (!buffer)
+    {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffer = reg.buffers.emplace_back(std::make_unique<ThreadTraceBuffer>(reg.capacity, reg.nextTid++)).get();
+        buffer->name       = t_traceSlot.name;
+        t_traceSlot.buffer = buffer;
+    }
+    return buffer;
+}
+
+uint32_t roundUpPowerOfTwo(uint32_t value)
+{
+    uint32_t result = 64;
+    while (result < value && result < (1u << 30))
+        result <<= 1;
+    return result;
+}
+
+// Copies the live events of a buffer which may still be written by its owner thread, events overwritten
+// while copying are dropped, including the slot of the event a live owner may be writing right now.
+void snapshot(const ThreadTraceBuffer* buffer, std::vector<TraceEvent>& out)
+{
+    const uint64_t inflight = buffer->retired.load(std::memory_order_acquire) ? 0 : 1;
+    const uint64_t capacity = uint64_t{buffer->mask} + 1;
+    const uint64_t head     = buffer->head.load(std::memory_order_acquire);
+    const uint64_t first    = head > capacity ? head - capacity : 0;
+
+    const auto offset = out.size();
+    for (uint64_t i = first; i < head; ++i)
+        out.push_back(buffer->events[i & buffer->mask]);
+
+    const uint64_t latest = buffer->head.load(std::memory_order_acquire) + inflight;
+    if (latest > first + capacity)
+    {
+        const auto overwritten = (std::min)(latest - capacity - first, head - first);
+        out.erase(out.begin() + offset, out.begin() + offset + static_cast<ptrdiff_t>(overwritten));
+    }
+}
+}  // namespace
+
+std::atomic<bool> Tracer::s_enabled{false};
+
+void Tracer::start(uint32_t eventsPerThread)
+{
+    {
+        auto& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.capacity = roundUpPowerOfTwo(eventsPerThread);
+    }
+    s_enabled.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::stop()
+{
+    s_enabled.store(false, std::memory_order_relaxed);
+}
+
+void Tracer::clear()
+{
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::erase_if(reg.buffers, [](const std::unique_ptr<ThreadTraceBuffer>& buffer) {
+        return buffer->retired.load(std::memory_order_acquire);
+    });
+    for (auto& buffer : reg.buffers)
+        buffer->head.store(0, std::memory_order_release);
+}
+
+void Tracer::setThreadName(std::string_view name)
+{
+    // the buffer is only allocated once the thread records its first zone
+    t_traceSlot.name = name;
+    if (auto buffer = t_traceSlot.buffer)
+    {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        buffer->name = name;
+    }
+}
+
+size_t Tracer::getEventCount()
+{
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    size_t count = 0;
+    for (auto& buffer : reg.buffers)
+        count += static_cast<size_t>(
+            (std::min)(buffer->head.load(std::memory_order_acquire), uint64_t{buffer->mask} + 1));
+    return count;
+}
+
+int64_t Tracer::now()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void Tracer::record(const TraceZoneInfo* zone, int64_t start, int64_t end)
+{
+    auto buffer      = threadBuffer();
+    const auto index = buffer->head.load(std::memory_order_relaxed);
+
+    auto& event    = buffer->events[index & buffer->mask];
+    event.zone     = zone;
+    event.start    = start;
+    event.duration = end - start;
+
+    buffer->head.store(index + 1, std::memory_order_release);
+}
+
+std::string Tracer::toChromeTrace()
+{
+    JsonWriter<false> writer;
+    writer.writeStartObject();
+    writer.writeString("displayTimeUnit", "ms");
+    writer.writeStartArray("traceEvents");
+
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    std::vector<std::vector<TraceEvent>> events(reg.buffers.size());
+    int64_t origin = INT64_MAX;
+    for (size_t i = 0; i < reg.buffers.size(); ++i)
+    {
+        snapshot(reg.buffers[i].get(), events[i]);
+        for (auto& event : events[i])
+            origin = (std::min)(origin, event.start);
+    }
+
+    for (size_t i = 0; i < reg.buffers.size(); ++i)
+    {
+        auto& buffer = *reg.buffers[i];
+        const auto tid = static_cast<int>(buffer.tid);
+        if (!buffer.name.empty())
+        {
+            writer.writeStartObject();
+            writer.writeString("name", "thread_name");
+            writer.writeString("ph", "M");
+            writer.writeNumber("pid", 1);
+            writer.writeNumber("tid", tid);
+            writer.writeStartObject("args");
+            writer.writeString("name", buffer.name);
+            writer.writeEndObject();
+            writer.writeEndObject();
+        }
+
+        for (auto& event : events[i])
+        {
+            writer.writeStartObject();
+            writer.writeString("name", event.zone->name);
+            writer.writeString("cat", "axmol");
+            writer.writeString("ph", "X");
+            writer.writeNumber("ts", static_cast<double>(event.start - origin) / 1000.0);
+            writer.writeNumber("dur", static_cast<double>(event.duration) / 1000.0);
+            writer.writeNumber("pid", 1);
+            writer.writeNumber("tid", tid);
+            writer.writeEndObject();
+        }
+    }
+
+    writer.writeEndArray();
+    writer.writeEndObject();
+    return std::string{static_cast<std::string_view>(writer)};
+}
+
+bool Tracer::saveChromeTrace(std::string_view fullPath)
+{
+    return FileUtils::getInstance()->writeStringToFile(toChromeTrace(), fullPath);
+}
+
+}  // namespace ax
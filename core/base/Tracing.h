@@ -0,0 +1,155 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "base/Config.h"
+#include "platform/PlatformMacros.h"
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+namespace ax
+{
+
+/** Static description of a trace zone, one instance per call site. */
+struct TraceZoneInfo
+{
+    const char* name;
+    const char* file;
+    int line;
+};
+
+/**
+ * @class Tracer
+ * Records scoped trace zones into per-thread ring buffers and exports them in the Chrome trace event format,
+ * which can be opened with chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Recording is off by default, a disabled zone costs one relaxed atomic load. Each thread only ever writes its own
+ * buffer, so recording takes no lock; the registry mutex is taken once per thread when its buffer is created and
+ * when exporting. When a buffer is full the oldest events are overwritten.
+ *
+ * @code
+ * Tracer::start();
+ * // ... run some frames
+ * Tracer::stop();
+ * Tracer::saveChromeTrace(FileUtils::getInstance()->getWritablePath() + "axmol.trace.json");
+ * @endcode
+ */
+class AX_DLL Tracer
+{
+public:
+    /** The default ring buffer capacity (in events) of each thread. */
+    static constexpr uint32_t DEFAULT_EVENTS_PER_THREAD = 16384;
+
+    /**
+     * Starts recording.
+     * @param eventsPerThread The ring buffer capacity for threads that do not have a buffer yet, rounded up to a power
+     * of two.
+     */
+    static void start(uint32_t eventsPerThread = DEFAULT_EVENTS_PER_THREAD);
+
+    /** Stops recording, recorded events are kept until clear() is called. */
+    static void stop();
+
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /** Drops all recorded events, should be called while recording is stopped. */
+    static void clear();
+
+    /** Names the calling thread in exported traces. */
+    static void setThreadName(std::string_view name);
+
+    /** Gets the number of events currently held by all thread buffers. */
+    static size_t getEventCount();
+
+    /** Exports all recorded events as a Chrome trace JSON document. */
+    static std::string toChromeTrace();
+
+    /** Exports all recorded events to a Chrome trace JSON file. */
+    static bool saveChromeTrace(std::string_view fullPath);
+
+    /** Gets the trace clock in nanoseconds. */
+    static int64_t now();
+
+    /** Records a complete zone for the calling thread, times are in nanoseconds of the trace clock. */
+    static void record(const TraceZoneInfo* zone, int64_t start, int64_t end);
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+/** Records the enclosing scope as a zone when tracing is enabled, see AX_TRACE_ZONE. */
+class TraceZone
+{
+public:
+    explicit TraceZone(const TraceZoneInfo* zone) : _zone(Tracer::isEnabled() ? zone : nullptr)
+    {
+        if (_zone)
+            _start = Tracer::now();
+    }
+    ~TraceZone()
+    {
+        if (_zone)
+            Tracer::record(_zone, _start, Tracer::now());
+    }
+
+    TraceZone(const TraceZone&)            = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+    const TraceZoneInfo* _zone;
+    int64_t _start{0};
+};
+
+}  // namespace ax
+
+// end of base group
+/// @}
+
+#define AX_TRACE_CONCAT_(a, b) a##b
+#define AX_TRACE_CONCAT(a, b)  AX_TRACE_CONCAT_(a, b)
+
+/** @def AX_TRACE_ZONE
+ * Traces the enclosing scope, the name must be a string literal.
+ * Compiles to nothing when AX_ENABLE_TRACING is 0.
+ */
+#if AX_ENABLE_TRACING
+#    define AX_TRACE_ZONE(__name__)                                                                            \
+        static constexpr ::ax::TraceZoneInfo AX_TRACE_CONCAT(__axTraceZoneInfo, __LINE__){__name__, __FILE__, \
+                                                                                           __LINE__};          \
+        ::ax::TraceZone AX_TRACE_CONCAT(__axTraceZone, __LINE__)(&AX_TRACE_CONCAT(__axTraceZoneInfo, __LINE__))
+#else
+#    define AX_TRACE_ZONE(__name__) \
+        do                          \
+        {                           \
+        } while (0)
+#endif
@@ -317,4 +317,15 @@ void MathUtil::transformIndices(uint16_t* dst, const uint16_t* src, size_t count
 #endif
 }
 
+void MathUtil::transformIndices(uint32_t* dst, const uint16_t* src, size_t count, uint32_t offset)
+{
+#if defined(AX_SSE_INTRINSICS)
+    MathUtilSSE::transformIndices(dst, src, count, offset);
+#elif defined(AX_NEON_INTRINSICS) && AX_64BITS
+    MathUtilNeon::transformIndices(dst, src, count, offset);
+#else
+    MathUtilC::transformIndices(dst, src, count, offset);
+#endif
+}
+
 NS_AX_MATH_END
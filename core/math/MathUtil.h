@@ -121,6 +121,7 @@ private:
 
     static void transformVertices(V3F_C4B_T2F* dst, const V3F_C4B_T2F* src, size_t count, const Mat4& transform);
     static void transformIndices(uint16_t* dst, const uint16_t* src, size_t count, uint16_t offset);
+    static void transformIndices(uint32_t* dst, const uint16_t* src, size_t count, uint32_t offset);
 };
 
 NS_AX_MATH_END
@@ -219,6 +219,17 @@ public:
             ++src;
         }
     }
+
+    inline static void transformIndices(uint32_t* dst, const uint16_t* src, size_t count, uint32_t offset)
+    {
+        auto end = dst + count;
+        while (dst < end)
+        {
+            *dst = *src + offset;
+            ++dst;
+            ++src;
+        }
+    }
 };
 
 NS_AX_MATH_END
@@ -279,6 +279,32 @@ struct MathUtilNeon
             --count;
         }
     }
+
+    inline static void transformIndices(uint32_t* dst, const uint16_t* src, size_t count, uint32_t offset)
+    {
+        auto off = vdupq_n_u32(offset);
+
+        // Process 8 indices at a time, widening them to 32 bits
+        while (count >= 8)
+        {
+            uint16x8_t v = vld1q_u16(src);
+            vst1q_u32(dst, vaddq_u32(vmovl_u16(vget_low_u16(v)), off));
+            vst1q_u32(dst + 4, vaddq_u32(vmovl_high_u16(v), off));
+
+            dst += 8;
+            src += 8;
+            count -= 8;
+        }
+
+        // Process remaining indices one by one
+        while (count > 0)
+        {
+            *dst = *src + offset;
+            ++dst;
+            ++src;
+            --count;
+        }
+    }
 #else
     inline static void transformVertices(ax::V3F_C4B_T2F* dst,
                                          const ax::V3F_C4B_T2F* src,
@@ -269,6 +269,30 @@ struct MathUtilSSE
             dst[rounded_count + i] = src[rounded_count + i] + offset;
         }
     }
+
+    static void transformIndices(uint32_t* dst, const uint16_t* src, size_t count, uint32_t offset)
+    {
+        __m128i offset_vector = _mm_set1_epi32(offset);
+        __m128i zero          = _mm_setzero_si128();
+        size_t remainder      = count % 8;
+        size_t rounded_count  = count - remainder;
+
+        for (size_t i = 0; i < rounded_count; i += 8)
+        {
+            __m128i current_values = _mm_loadu_si128((__m128i*)(src + i));  // Load 8 values.
+            // Widen them to 32 bits and add offset.
+            __m128i lo = _mm_add_epi32(_mm_unpacklo_epi16(current_values, zero), offset_vector);
+            __m128i hi = _mm_add_epi32(_mm_unpackhi_epi16(current_values, zero), offset_vector);
+            _mm_storeu_si128((__m128i*)(dst + i), lo);  // Store the result.
+            _mm_storeu_si128((__m128i*)(dst + i + 4), hi);
+        }
+
+        // If count is not divisible by 8, add offset for the remainder elements one by one.
+        for (size_t i = 0; i < remainder; ++i)
+        {
+            dst[rounded_count + i] = src[rounded_count + i] + offset;
+        }
+    }
 };
 
 #endif
@@ -26,10 +26,14 @@
 #include "navmesh/NavMesh.h"
 #if defined(AX_ENABLE_NAVMESH)
 
+#    include "base/Director.h"
+#    include "base/JobSystem.h"
 #    include "platform/FileUtils.h"
 #    include "renderer/Renderer.h"
 #    include "recast/DetourCommon.h"
 #    include "recast/DetourDebugDraw.h"
+#    include <atomic>
+#    include <chrono>
 #    include <sstream>
 
 namespace ax
@@ -90,6 +94,35 @@ static unsigned char* parseRow(unsigned char* buf, unsigned char* bufEnd, char*
 static const int TILECACHESET_MAGIC   = 'T' << 24 | 'S' << 16 | 'E' << 8 | 'T';  //'TSET';
 static const int TILECACHESET_VERSION = 1;
 static const int MAX_AGENTS           = 128;
+static const int MAX_POLYS            = 256;
+static const int MAX_SMOOTH           = 2048;
+static const float QUERY_EXTENTS[3]   = {2.0f, 4.0f, 2.0f};
+static const int EXPECTED_LAYERS_PER_TILE = 4;
+static const int MAX_LAYERS_PER_TILE      = 32;
+
+struct NavMesh::AsyncQuery
+{
+    enum class Type
+    {
+        PATH,
+        RAYCAST,
+        NEAREST_POLY,
+    };
+
+    Type type;
+    Vec3 start;
+    Vec3 end;
+    // the sliced path search keeps a pointer to the filter until it's finalized
+    dtQueryFilter filter;
+    dtPolyRef startRef{0};
+    bool searching{false};
+    bool found{false};
+    Vec3 point;
+    std::vector<Vec3> pathPoints;
+    FindPathCallback pathCallback;
+    RaycastCallback raycastCallback;
+    FindNearestPolyCallback nearestPolyCallback;
+};
 
 NavMesh* NavMesh::create(std::string_view navFilePath, std::string_view geomFilePath)
 {
@@ -103,6 +136,18 @@ NavMesh* NavMesh::create(std::string_view navFilePath, std::string_view geomFile
     return nullptr;
 }
 
+NavMesh* NavMesh::create(const NavMeshGeometry& geometry, const NavMeshBuildSettings& settings)
+{
+    auto ref = new NavMesh();
+    if (ref->initWithGeometry(geometry, settings))
+    {
+        ref->autorelease();
+        return ref;
+    }
+    AX_SAFE_DELETE(ref);
+    return nullptr;
+}
+
 NavMesh::NavMesh()
     : _navMesh(nullptr)
     , _navMeshQuery(nullptr)
@@ -112,6 +157,9 @@ NavMesh::NavMesh()
     , _compressor(nullptr)
     , _meshProcess(nullptr)
     , _geomData(nullptr)
+    , _asyncQueryBudget(4096)
+    , _tileCountX(0)
+    , _tileCountY(0)
     , _isDebugDrawEnabled(false)
 {}
 
@@ -121,6 +169,8 @@ NavMesh::~NavMesh()
     dtFreeCrowd(_crowed);
     dtFreeNavMesh(_navMesh);
     dtFreeNavMeshQuery(_navMeshQuery);
+    for (auto&& slot : _asyncQuerySlots)
+        dtFreeNavMeshQuery(slot.navMeshQuery);
     AX_SAFE_DELETE(_allocator);
     AX_SAFE_DELETE(_compressor);
     AX_SAFE_DELETE(_meshProcess);
@@ -177,32 +227,8 @@ bool NavMesh::loadNavMeshFile()
         return false;
     }
 
-    _navMesh = dtAllocNavMesh();
-    if (!_navMesh)
-    {
-        return false;
-    }
-    dtStatus status = _navMesh->init(&header.meshParams);
-    if (dtStatusFailed(status))
-    {
-        return false;
-    }
-
-    _tileCache = dtAllocTileCache();
-    if (!_tileCache)
-    {
-        return false;
-    }
-
-    _allocator   = new LinearAllocator(32000);
-    _compressor  = new FastLZCompressor();
-    _meshProcess = new MeshProcess(_geomData);
-    status       = _tileCache->init(&header.cacheParams, _allocator, _compressor, _meshProcess);
-
-    if (dtStatusFailed(status))
-    {
+    if (!initTileCache(header.meshParams, header.cacheParams))
         return false;
-    }
 
     // Read tiles.
     for (int i = 0; i < header.numTiles; ++i)
@@ -225,18 +251,226 @@ bool NavMesh::loadNavMeshFile()
             _tileCache->buildNavMeshTile(tile, _navMesh);
     }
 
+    initCrowd(header.cacheParams);
+    // duDebugDrawNavMesh(&_debugDraw, *_navMesh, DU_DRAWNAVMESH_OFFMESHCONS);
+    return true;
+}
+
+bool NavMesh::initWithGeometry(const NavMeshGeometry& geometry, const NavMeshBuildSettings& settings)
+{
+    if (geometry.getTriangles().empty() || settings.tileSize <= 0 || settings.tileSize > 255)
+        return false;
+
+    _buildGeometry             = geometry;
+    _buildSettings             = settings;
+    _geomData                  = new GeomData;
+    _geomData->offMeshConCount = 0;
+
+    const auto& aabb      = geometry.getAABB();
+    const float tileWidth = settings.tileSize * settings.cellSize;
+    _tileCountX           = std::max(1, static_cast<int>(std::ceil((aabb._max.x - aabb._min.x) / tileWidth)));
+    _tileCountY           = std::max(1, static_cast<int>(std::ceil((aabb._max.z - aabb._min.z) / tileWidth)));
+
+    // the tile and poly ids share the 22 bits of a dtPolyRef which aren't the salt
+    int tileBits =
+        std::min(static_cast<int>(dtIlog2(dtNextPow2(_tileCountX * _tileCountY * EXPECTED_LAYERS_PER_TILE))), 14);
+
+    dtTileCacheParams cacheParams;
+    memset(&cacheParams, 0, sizeof(cacheParams));
+    dtVcopy(cacheParams.orig, &aabb._min.x);
+    cacheParams.cs                     = settings.cellSize;
+    cacheParams.ch                     = settings.cellHeight;
+    cacheParams.width                  = settings.tileSize;
+    cacheParams.height                 = settings.tileSize;
+    cacheParams.walkableHeight         = settings.agentHeight;
+    cacheParams.walkableRadius         = settings.agentRadius;
+    cacheParams.walkableClimb          = settings.agentMaxClimb;
+    cacheParams.maxSimplificationError = 1.3f;
+    cacheParams.maxTiles               = 1 << tileBits;
+    cacheParams.maxObstacles           = settings.maxObstacles;
+
+    dtNavMeshParams meshParams;
+    memset(&meshParams, 0, sizeof(meshParams));
+    dtVcopy(meshParams.orig, &aabb._min.x);
+    meshParams.tileWidth  = tileWidth;
+    meshParams.tileHeight = tileWidth;
+    meshParams.maxTiles   = 1 << tileBits;
+    meshParams.maxPolys   = 1 << (22 - tileBits);
+
+    if (!initTileCache(meshParams, cacheParams))
+        return false;
+
+    buildTiles(0, 0, _tileCountX - 1, _tileCountY - 1);
+    initCrowd(cacheParams);
+    return true;
+}
+
+bool NavMesh::initTileCache(const dtNavMeshParams& meshParams, const dtTileCacheParams& cacheParams)
+{
+    _navMesh = dtAllocNavMesh();
+    if (!_navMesh)
+    {
+        return false;
+    }
+    dtStatus status = _navMesh->init(&meshParams);
+    if (dtStatusFailed(status))
+    {
+        return false;
+    }
+
+    _tileCache = dtAllocTileCache();
+    if (!_tileCache)
+    {
+        return false;
+    }
+
+    // the tile cache builds a tile in the allocator, which doesn't grow
+    _allocator   = new LinearAllocator(std::max(32000, cacheParams.width * cacheParams.height * 14));
+    _compressor  = new FastLZCompressor();
+    _meshProcess = new MeshProcess(_geomData);
+    status       = _tileCache->init(&cacheParams, _allocator, _compressor, _meshProcess);
+
+    return dtStatusSucceed(status);
+}
+
+void NavMesh::initCrowd(const dtTileCacheParams& cacheParams)
+{
     // create crowed
     _crowed = dtAllocCrowd();
-    _crowed->init(MAX_AGENTS, header.cacheParams.walkableRadius, _navMesh);
+    _crowed->init(MAX_AGENTS, cacheParams.walkableRadius, _navMesh);
 
     // create NavMeshQuery
     _navMeshQuery = dtAllocNavMeshQuery();
     _navMeshQuery->init(_navMesh, 2048);
 
     _agentList.assign(MAX_AGENTS, nullptr);
-    _obstacleList.assign(header.cacheParams.maxObstacles, nullptr);
-    // duDebugDrawNavMesh(&_debugDraw, *_navMesh, DU_DRAWNAVMESH_OFFMESHCONS);
-    return true;
+    _obstacleList.assign(cacheParams.maxObstacles, nullptr);
+}
+
+void NavMesh::rebuildTiles(const NavMeshGeometry& geometry, const AABB& bounds)
+{
+    if (!_tileCache || _tileCountX == 0)
+        return;
+
+    _buildGeometry = geometry;
+
+    // the spans next to the changes are eroded by the agent radius too
+    const auto* params    = _tileCache->getParams();
+    const float tileWidth = params->width * params->cs;
+    const float margin    = params->walkableRadius + params->cs;
+    auto tileAt           = [&](float pos, int axis) {
+        return static_cast<int>(std::floor((pos - params->orig[axis]) / tileWidth));
+    };
+    int minX = std::max(0, tileAt(bounds._min.x - margin, 0));
+    int minY = std::max(0, tileAt(bounds._min.z - margin, 2));
+    int maxX = std::min(_tileCountX - 1, tileAt(bounds._max.x + margin, 0));
+    int maxY = std::min(_tileCountY - 1, tileAt(bounds._max.z + margin, 2));
+    if (minX > maxX || minY > maxY)
+        return;
+
+    buildTiles(minX, minY, maxX, maxY);
+
+    // the obstacles only mark the tiles which existed when they were added, so add them to the new ones again
+    for (auto&& iter : _obstacleList)
+    {
+        if (!iter || !iter->getOwner())
+            continue;
+        Mat4 mat  = iter->getOwner()->getNodeToWorldTransform();
+        int tileX = tileAt(mat.m[12], 0);
+        int tileY = tileAt(mat.m[14], 2);
+        int reach = static_cast<int>(std::ceil(iter->getRadius() / tileWidth));
+        if (tileX + reach < minX || tileX - reach > maxX || tileY + reach < minY || tileY - reach > maxY)
+            continue;
+        iter->removeFrom(_tileCache);
+        iter->addTo(_tileCache);
+    }
+}
+
+void NavMesh::buildTiles(int minX, int minY, int maxX, int maxY)
+{
+    using namespace std::chrono;
+
+    struct TileBuild
+    {
+        int x;
+        int y;
+        std::vector<int> triangles;
+        std::vector<std::pair<unsigned char*, int>> layers;
+        float milliseconds;
+    };
+
+    auto start            = steady_clock::now();
+    const auto* params    = _tileCache->getParams();
+    const float tileWidth = params->width * params->cs;
+    const int columns     = maxX - minX + 1;
+    std::vector<TileBuild> builds;
+    for (int y = minY; y <= maxY; ++y)
+    {
+        for (int x = minX; x <= maxX; ++x)
+            builds.push_back({x, y, {}, {}, 0.0f});
+    }
+
+    // bin the triangles to the tiles whose border they may reach, the builder drops the ones which don't
+    const float margin     = params->walkableRadius + 4 * params->cs;
+    const auto& vertices   = _buildGeometry.getTriangles();
+    const int numTriangles = static_cast<int>(vertices.size() / 3);
+    for (int i = 0; i < numTriangles; ++i)
+    {
+        const Vec3* v = &vertices[i * 3];
+        float tminX   = std::min({v[0].x, v[1].x, v[2].x}) - margin - params->orig[0];
+        float tmaxX   = std::max({v[0].x, v[1].x, v[2].x}) + margin - params->orig[0];
+        float tminZ   = std::min({v[0].z, v[1].z, v[2].z}) - margin - params->orig[2];
+        float tmaxZ   = std::max({v[0].z, v[1].z, v[2].z}) + margin - params->orig[2];
+        int x0        = std::max(minX, static_cast<int>(std::floor(tminX / tileWidth)));
+        int x1        = std::min(maxX, static_cast<int>(std::floor(tmaxX / tileWidth)));
+        int y0        = std::max(minY, static_cast<int>(std::floor(tminZ / tileWidth)));
+        int y1        = std::min(maxY, static_cast<int>(std::floor(tmaxZ / tileWidth)));
+        for (int y = y0; y <= y1; ++y)
+        {
+            for (int x = x0; x <= x1; ++x)
+                builds[(y - minY) * columns + (x - minX)].triangles.push_back(i);
+        }
+    }
+
+    Director::getInstance()->getJobSystem()->parallelFor(builds.size(), [&](size_t index) {
+        auto& build    = builds[index];
+        auto tileStart = steady_clock::now();
+        buildNavMeshTileLayers(_buildGeometry, build.triangles, _buildSettings, *params, build.x, build.y, _compressor,
+                               build.layers);
+        build.milliseconds = duration<float, std::milli>(steady_clock::now() - tileStart).count();
+    });
+
+    auto rasterized = steady_clock::now();
+    _buildReport.tiles.clear();
+
+    // the tile cache and navmesh aren't thread safe, the tiles are swapped on this thread
+    for (auto&& build : builds)
+    {
+        dtCompressedTileRef compressedTiles[MAX_LAYERS_PER_TILE];
+        int count = _tileCache->getTilesAt(build.x, build.y, compressedTiles, MAX_LAYERS_PER_TILE);
+        for (int i = 0; i < count; ++i)
+            _tileCache->removeTile(compressedTiles[i], nullptr, nullptr);
+
+        const dtMeshTile* meshTiles[MAX_LAYERS_PER_TILE];
+        count = _navMesh->getTilesAt(build.x, build.y, meshTiles, MAX_LAYERS_PER_TILE);
+        for (int i = 0; i < count; ++i)
+            _navMesh->removeTile(_navMesh->getTileRef(meshTiles[i]), nullptr, nullptr);
+
+        for (auto&& layer : build.layers)
+        {
+            dtCompressedTileRef tile = 0;
+            if (dtStatusFailed(_tileCache->addTile(layer.first, layer.second, DT_COMPRESSEDTILE_FREE_DATA, &tile)))
+                dtFree(layer.first);
+        }
+        if (!build.layers.empty())
+            _tileCache->buildNavMeshTilesAt(build.x, build.y, _navMesh);
+
+        _buildReport.tiles.push_back({build.x, build.y, static_cast<int>(build.layers.size()), build.milliseconds});
+    }
+
+    auto end                           = steady_clock::now();
+    _buildReport.rasterizeMilliseconds = duration<float, std::milli>(rasterized - start).count();
+    _buildReport.totalMilliseconds     = duration<float, std::milli>(end - start).count();
 }
 
 bool NavMesh::loadGeomFile()
@@ -494,6 +728,9 @@ void NavMesh::update(float dt)
     if (_crowed)
         _crowed->update(dt, nullptr);
 
+    // the queries must be done before the tile cache rebuilds any tile of the navmesh
+    updateAsyncQueries();
+
     if (_tileCache)
         _tileCache->update(dt, _navMesh);
 
@@ -510,10 +747,146 @@ void NavMesh::update(float dt)
     }
 }
 
+// Iterates over the path to find smooth path on the detail mesh surface.
+static void smoothPath(dtNavMeshQuery* navMeshQuery,
+                       const dtNavMesh* navMesh,
+                       const dtQueryFilter* filter,
+                       dtPolyRef startRef,
+                       const float* start,
+                       const float* end,
+                       dtPolyRef* polys,
+                       int npolys,
+                       std::vector<Vec3>& pathPoints)
+{
+    float iterPos[3], targetPos[3];
+    navMeshQuery->closestPointOnPoly(startRef, start, iterPos, 0);
+    navMeshQuery->closestPointOnPoly(polys[npolys - 1], end, targetPos, 0);
+
+    static const float STEP_SIZE = 0.5f;
+    static const float SLOP      = 0.01f;
+
+    int nsmoothPath = 0;
+    // dtVcopy(&m_smoothPath[m_nsmoothPath * 3], iterPos);
+    // m_nsmoothPath++;
+
+    pathPoints.emplace_back(Vec3(iterPos[0], iterPos[1], iterPos[2]));
+    nsmoothPath++;
+
+    // Move towards target a small advancement at a time until target reached or
+    // when ran out of memory to store the path.
+    while (npolys && nsmoothPath < MAX_SMOOTH)
+    {
+        // Find location to steer towards.
+        float steerPos[3];
+        unsigned char steerPosFlag;
+        dtPolyRef steerPosRef;
+
+        if (!getSteerTarget(navMeshQuery, iterPos, targetPos, SLOP, polys, npolys, steerPos, steerPosFlag,
+                            steerPosRef))
+            break;
+
+        bool endOfPath         = (steerPosFlag & DT_STRAIGHTPATH_END) ? true : false;
+        bool offMeshConnection = (steerPosFlag & DT_STRAIGHTPATH_OFFMESH_CONNECTION) ? true : false;
+
+        // Find movement delta.
+        float delta[3], len;
+        dtVsub(delta, steerPos, iterPos);
+        len = dtMathSqrtf(dtVdot(delta, delta));
+        // If the steer target is end of path or off-mesh link, do not move past the location.
+        if ((endOfPath || offMeshConnection) && len < STEP_SIZE)
+            len = 1;
+        else
+            len = STEP_SIZE / len;
+        float moveTgt[3];
+        dtVmad(moveTgt, iterPos, delta, len);
+
+        // Move
+        float result[3];
+        dtPolyRef visited[16];
+        int nvisited = 0;
+        navMeshQuery->moveAlongSurface(polys[0], iterPos, moveTgt, filter, result, visited, &nvisited, 16);
+
+        npolys = fixupCorridor(polys, npolys, MAX_POLYS, visited, nvisited);
+        npolys = fixupShortcuts(polys, npolys, navMeshQuery);
+
+        float h = 0;
+        navMeshQuery->getPolyHeight(polys[0], result, &h);
+        result[1] = h;
+        dtVcopy(iterPos, result);
+
+        // Handle end of path and off-mesh links when close enough.
+        if (endOfPath && inRange(iterPos, steerPos, SLOP, 1.0f))
+        {
+            // Reached end of path.
+            dtVcopy(iterPos, targetPos);
+            if (nsmoothPath < MAX_SMOOTH)
+            {
+                // dtVcopy(&m_smoothPath[m_nsmoothPath * 3], iterPos);
+                // m_nsmoothPath++;
+                pathPoints.emplace_back(Vec3(iterPos[0], iterPos[1], iterPos[2]));
+                nsmoothPath++;
+            }
+            break;
+        }
+        else if (offMeshConnection && inRange(iterPos, steerPos, SLOP, 1.0f))
+        {
+            // Reached off-mesh connection.
+            float startPos[3], endPos[3];
+
+            // Advance the path up to and over the off-mesh connection.
+            dtPolyRef prevRef = 0, polyRef = polys[0];
+            int npos = 0;
+            while (npos < npolys && polyRef != steerPosRef)
+            {
+                prevRef = polyRef;
+                polyRef = polys[npos];
+                npos++;
+            }
+            for (int i = npos; i < npolys; ++i)
+                polys[i - npos] = polys[i];
+            npolys -= npos;
+
+            // Handle the connection.
+            dtStatus status = navMesh->getOffMeshConnectionPolyEndPoints(prevRef, polyRef, startPos, endPos);
+            if (dtStatusSucceed(status))
+            {
+                if (nsmoothPath < MAX_SMOOTH)
+                {
+                    // dtVcopy(&m_smoothPath[m_nsmoothPath * 3], startPos);
+                    // m_nsmoothPath++;
+                    pathPoints.emplace_back(Vec3(startPos[0], startPos[1], startPos[2]));
+                    nsmoothPath++;
+                    // Hack to make the dotted path not visible during off-mesh connection.
+                    if (nsmoothPath & 1)
+                    {
+                        // dtVcopy(&m_smoothPath[m_nsmoothPath * 3], startPos);
+                        // m_nsmoothPath++;
+                        pathPoints.emplace_back(Vec3(startPos[0], startPos[1], startPos[2]));
+                        nsmoothPath++;
+                    }
+                }
+                // Move position at the other side of the off-mesh link.
+                dtVcopy(iterPos, endPos);
+                float eh = 0.0f;
+                navMeshQuery->getPolyHeight(polys[0], iterPos, &eh);
+                iterPos[1] = eh;
+            }
+        }
+
+        // Store results.
+        if (nsmoothPath < MAX_SMOOTH)
+        {
+            // dtVcopy(&m_smoothPath[m_nsmoothPath * 3], iterPos);
+            // m_nsmoothPath++;
+
+            pathPoints.emplace_back(Vec3(iterPos[0], iterPos[1], iterPos[2]));
+            nsmoothPath++;
+        }
+    }
+}
+
 void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>& pathPoints)
 {
-    static const int MAX_POLYS  = 256;
-    static const int MAX_SMOOTH = 2048;
     float ext[3];
     ext[0] = 2;
     ext[1] = 4;
@@ -527,138 +900,206 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
     _navMeshQuery->findPath(startRef, endRef, &start.x, &end.x, &filter, polys, &npolys, MAX_POLYS);
 
     if (npolys)
-    {
-        //// Iterate over the path to find smooth path on the detail mesh surface.
-        // dtPolyRef polys[MAX_POLYS];
-        // memcpy(polys, polys, sizeof(dtPolyRef)*npolys);
-        // int npolys = npolys;
+        smoothPath(_navMeshQuery, _navMesh, &filter, startRef, &start.x, &end.x, polys, npolys, pathPoints);
+}
 
-        float iterPos[3], targetPos[3];
-        _navMeshQuery->closestPointOnPoly(startRef, &start.x, iterPos, 0);
-        _navMeshQuery->closestPointOnPoly(polys[npolys - 1], &end.x, targetPos, 0);
+void NavMesh::findPathAsync(const Vec3& start, const Vec3& end, FindPathCallback callback)
+{
+    auto query          = std::make_unique<AsyncQuery>();
+    query->type         = AsyncQuery::Type::PATH;
+    query->start        = start;
+    query->end          = end;
+    query->pathCallback = std::move(callback);
+    enqueueAsyncQuery(std::move(query));
+}
 
-        static const float STEP_SIZE = 0.5f;
-        static const float SLOP      = 0.01f;
+void NavMesh::raycastAsync(const Vec3& start, const Vec3& end, RaycastCallback callback)
+{
+    auto query             = std::make_unique<AsyncQuery>();
+    query->type            = AsyncQuery::Type::RAYCAST;
+    query->start           = start;
+    query->end             = end;
+    query->raycastCallback = std::move(callback);
+    enqueueAsyncQuery(std::move(query));
+}
 
-        int nsmoothPath = 0;
-        // dtVcopy(&m_smoothPath[m_nsmoothPath * 3], iterPos);
-        // m_nsmoothPath++;
+void NavMesh::findNearestPolyAsync(const Vec3& pos, FindNearestPolyCallback callback)
+{
+    auto query                 = std::make_unique<AsyncQuery>();
+    query->type                = AsyncQuery::Type::NEAREST_POLY;
+    query->start               = pos;
+    query->nearestPolyCallback = std::move(callback);
+    enqueueAsyncQuery(std::move(query));
+}
 
-        pathPoints.emplace_back(Vec3(iterPos[0], iterPos[1], iterPos[2]));
-        nsmoothPath++;
+void NavMesh::cancelAsyncQueries()
+{
+    _asyncQueries.clear();
+    for (auto&& slot : _asyncQuerySlots)
+    {
+        // an unfinished sliced search is left as is, the next initSlicedFindPath on the slot resets it
+        slot.current.reset();
+        slot.completed.clear();
+    }
+}
 
-        // Move towards target a small advancement at a time until target reached or
-        // when ran out of memory to store the path.
-        while (npolys && nsmoothPath < MAX_SMOOTH)
-        {
-            // Find location to steer towards.
-            float steerPos[3];
-            unsigned char steerPosFlag;
-            dtPolyRef steerPosRef;
+size_t NavMesh::getAsyncQueryCount() const
+{
+    size_t count = _asyncQueries.size();
+    for (auto&& slot : _asyncQuerySlots)
+    {
+        if (slot.current)
+            ++count;
+    }
+    return count;
+}
 
-            if (!getSteerTarget(_navMeshQuery, iterPos, targetPos, SLOP, polys, npolys, steerPos, steerPosFlag,
-                                steerPosRef))
-                break;
+void NavMesh::enqueueAsyncQuery(std::unique_ptr<AsyncQuery> query)
+{
+    if (!_navMesh)
+        return;
 
-            bool endOfPath         = (steerPosFlag & DT_STRAIGHTPATH_END) ? true : false;
-            bool offMeshConnection = (steerPosFlag & DT_STRAIGHTPATH_OFFMESH_CONNECTION) ? true : false;
-
-            // Find movement delta.
-            float delta[3], len;
-            dtVsub(delta, steerPos, iterPos);
-            len = dtMathSqrtf(dtVdot(delta, delta));
-            // If the steer target is end of path or off-mesh link, do not move past the location.
-            if ((endOfPath || offMeshConnection) && len < STEP_SIZE)
-                len = 1;
-            else
-                len = STEP_SIZE / len;
-            float moveTgt[3];
-            dtVmad(moveTgt, iterPos, delta, len);
-
-            // Move
-            float result[3];
-            dtPolyRef visited[16];
-            int nvisited = 0;
-            _navMeshQuery->moveAlongSurface(polys[0], iterPos, moveTgt, &filter, result, visited, &nvisited, 16);
-
-            npolys = fixupCorridor(polys, npolys, MAX_POLYS, visited, nvisited);
-            npolys = fixupShortcuts(polys, npolys, _navMeshQuery);
-
-            float h = 0;
-            _navMeshQuery->getPolyHeight(polys[0], result, &h);
-            result[1] = h;
-            dtVcopy(iterPos, result);
-
-            // Handle end of path and off-mesh links when close enough.
-            if (endOfPath && inRange(iterPos, steerPos, SLOP, 1.0f))
+    if (_asyncQuerySlots.empty())
+    {
+        // one query per thread which takes part in servicing, the main thread included
+        _asyncQuerySlots.resize(Director::getInstance()->getJobSystem()->getThreadCount() + 1);
+        for (auto&& slot : _asyncQuerySlots)
+        {
+            slot.navMeshQuery = dtAllocNavMeshQuery();
+            slot.navMeshQuery->init(_navMesh, 2048);
+        }
+    }
+    _asyncQueries.emplace_back(std::move(query));
+}
+
+void NavMesh::updateAsyncQueries()
+{
+    if (getAsyncQueryCount() == 0)
+        return;
+
+    const int slotCount  = static_cast<int>(_asyncQuerySlots.size());
+    const int slotBudget = std::max(1, _asyncQueryBudget / slotCount);
+    const size_t queued  = _asyncQueries.size();
+    std::atomic<size_t> next{0};
+
+    Director::getInstance()->getJobSystem()->parallelFor(_asyncQuerySlots.size(), [&](size_t index) {
+        auto& slot = _asyncQuerySlots[index];
+        int budget = slotBudget;
+        while (budget > 0)
+        {
+            if (!slot.current)
             {
-                // Reached end of path.
-                dtVcopy(iterPos, targetPos);
-                if (nsmoothPath < MAX_SMOOTH)
-                {
-                    // dtVcopy(&m_smoothPath[m_nsmoothPath * 3], iterPos);
-                    // m_nsmoothPath++;
-                    pathPoints.emplace_back(Vec3(iterPos[0], iterPos[1], iterPos[2]));
-                    nsmoothPath++;
-                }
-                break;
+                size_t queryIndex = next.fetch_add(1, std::memory_order_relaxed);
+                if (queryIndex >= queued)
+                    break;
+                slot.current = std::move(_asyncQueries[queryIndex]);
             }
-            else if (offMeshConnection && inRange(iterPos, steerPos, SLOP, 1.0f))
-            {
-                // Reached off-mesh connection.
-                float startPos[3], endPos[3];
+            // a path search which runs out of budget stays in the slot until next frame
+            if (!stepAsyncQuery(slot.navMeshQuery, slot.current.get(), budget))
+                break;
+            slot.completed.emplace_back(std::move(slot.current));
+        }
+    });
 
-                // Advance the path up to and over the off-mesh connection.
-                dtPolyRef prevRef = 0, polyRef = polys[0];
-                int npos = 0;
-                while (npos < npolys && polyRef != steerPosRef)
-                {
-                    prevRef = polyRef;
-                    polyRef = polys[npos];
-                    npos++;
-                }
-                for (int i = npos; i < npolys; ++i)
-                    polys[i - npos] = polys[i];
-                npolys -= npos;
+    _asyncQueries.erase(_asyncQueries.begin(), _asyncQueries.begin() + std::min(next.load(), queued));
 
-                // Handle the connection.
-                dtStatus status = _navMesh->getOffMeshConnectionPolyEndPoints(prevRef, polyRef, startPos, endPos);
-                if (dtStatusSucceed(status))
-                {
-                    if (nsmoothPath < MAX_SMOOTH)
-                    {
-                        // dtVcopy(&m_smoothPath[m_nsmoothPath * 3], startPos);
-                        // m_nsmoothPath++;
-                        pathPoints.emplace_back(Vec3(startPos[0], startPos[1], startPos[2]));
-                        nsmoothPath++;
-                        // Hack to make the dotted path not visible during off-mesh connection.
-                        if (nsmoothPath & 1)
-                        {
-                            // dtVcopy(&m_smoothPath[m_nsmoothPath * 3], startPos);
-                            // m_nsmoothPath++;
-                            pathPoints.emplace_back(Vec3(startPos[0], startPos[1], startPos[2]));
-                            nsmoothPath++;
-                        }
-                    }
-                    // Move position at the other side of the off-mesh link.
-                    dtVcopy(iterPos, endPos);
-                    float eh = 0.0f;
-                    _navMeshQuery->getPolyHeight(polys[0], iterPos, &eh);
-                    iterPos[1] = eh;
-                }
-            }
+    std::vector<std::unique_ptr<AsyncQuery>> completed;
+    for (auto&& slot : _asyncQuerySlots)
+    {
+        std::move(slot.completed.begin(), slot.completed.end(), std::back_inserter(completed));
+        slot.completed.clear();
+    }
 
-            // Store results.
-            if (nsmoothPath < MAX_SMOOTH)
-            {
-                // dtVcopy(&m_smoothPath[m_nsmoothPath * 3], iterPos);
-                // m_nsmoothPath++;
+    // the callbacks are free to queue or cancel queries
+    for (auto&& query : completed)
+    {
+        switch (query->type)
+        {
+        case AsyncQuery::Type::PATH:
+            if (query->pathCallback)
+                query->pathCallback(query->pathPoints);
+            break;
+        case AsyncQuery::Type::RAYCAST:
+            if (query->raycastCallback)
+                query->raycastCallback(query->found, query->point);
+            break;
+        case AsyncQuery::Type::NEAREST_POLY:
+            if (query->nearestPolyCallback)
+                query->nearestPolyCallback(query->found, query->point);
+            break;
+        }
+    }
+}
 
-                pathPoints.emplace_back(Vec3(iterPos[0], iterPos[1], iterPos[2]));
-                nsmoothPath++;
-            }
+bool NavMesh::stepAsyncQuery(dtNavMeshQuery* navMeshQuery, AsyncQuery* query, int& budget)
+{
+    switch (query->type)
+    {
+    case AsyncQuery::Type::NEAREST_POLY:
+    {
+        dtPolyRef ref = 0;
+        navMeshQuery->findNearestPoly(&query->start.x, QUERY_EXTENTS, &query->filter, &ref, &query->point.x);
+        query->found = ref != 0;
+        budget -= 1;
+        return true;
+    }
+    case AsyncQuery::Type::RAYCAST:
+    {
+        dtPolyRef startRef = 0;
+        navMeshQuery->findNearestPoly(&query->start.x, QUERY_EXTENTS, &query->filter, &startRef, 0);
+        budget -= 1;
+        if (!startRef)
+        {
+            // off the navmesh, blocked right away
+            query->found = true;
+            query->point = query->start;
+            return true;
+        }
+
+        float t = 0.0f, hitNormal[3];
+        dtPolyRef polys[MAX_POLYS];
+        int npolys = 0;
+        navMeshQuery->raycast(startRef, &query->start.x, &query->end.x, &query->filter, &t, hitNormal, polys, &npolys,
+                              MAX_POLYS);
+        budget -= npolys;
+        query->found = t <= 1.0f;
+        query->point = query->found ? query->start + (query->end - query->start) * t : query->end;
+        return true;
+    }
+    case AsyncQuery::Type::PATH:
+    {
+        if (!query->searching)
+        {
+            dtPolyRef endRef = 0;
+            navMeshQuery->findNearestPoly(&query->start.x, QUERY_EXTENTS, &query->filter, &query->startRef, 0);
+            navMeshQuery->findNearestPoly(&query->end.x, QUERY_EXTENTS, &query->filter, &endRef, 0);
+            budget -= 2;
+            if (dtStatusFailed(navMeshQuery->initSlicedFindPath(query->startRef, endRef, &query->start.x,
+                                                                &query->end.x, &query->filter)))
+                return true;
+            query->searching = true;
         }
+
+        int doneIters   = 0;
+        dtStatus status = navMeshQuery->updateSlicedFindPath(std::max(budget, 1), &doneIters);
+        budget -= std::max(doneIters, 1);
+        if (dtStatusInProgress(status))
+            return false;
+
+        dtPolyRef polys[MAX_POLYS];
+        int npolys       = 0;
+        query->searching = false;
+        navMeshQuery->finalizeSlicedFindPath(polys, &npolys, MAX_POLYS);
+        if (npolys)
+        {
+            smoothPath(navMeshQuery, _navMesh, &query->filter, query->startRef, &query->start.x, &query->end.x, polys,
+                       npolys, query->pathPoints);
+            budget -= static_cast<int>(query->pathPoints.size());
+        }
+        return true;
+    }
     }
+    return true;
 }
 
 }
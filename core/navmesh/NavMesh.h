@@ -36,10 +36,14 @@
 #    include "recast/DetourNavMeshQuery.h"
 #    include "recast/DetourCrowd.h"
 #    include "recast/DetourTileCache.h"
+#    include <deque>
+#    include <functional>
+#    include <memory>
 #    include <string>
 #    include <vector>
 
 #    include "navmesh/NavMeshAgent.h"
+#    include "navmesh/NavMeshBuilder.h"
 #    include "navmesh/NavMeshDebugDraw.h"
 #    include "navmesh/NavMeshObstacle.h"
 #    include "navmesh/NavMeshUtils.h"
@@ -64,6 +68,27 @@ public:
     */
     static NavMesh* create(std::string_view navFilePath, std::string_view geomFilePath);
 
+    /**
+    Create navmesh from geometry, the tiles are rasterized in parallel on the job system.
+
+    @param geometry The triangles the navmesh is built from, the tile grid covers their bounds.
+    @param settings The voxel and agent sizes.
+    */
+    static NavMesh* create(const NavMeshGeometry& geometry,
+                           const NavMeshBuildSettings& settings = NavMeshBuildSettings());
+
+    /**
+    Rebuild the tiles overlapping bounds after the geometry changed there, only for navmesh created from geometry.
+    The tile grid doesn't grow, so geometry out of the original bounds is ignored.
+
+    @param geometry The triangles the navmesh is built from from now on.
+    @param bounds The bounds of the changes in world coordinate system.
+    */
+    void rebuildTiles(const NavMeshGeometry& geometry, const AABB& bounds);
+
+    /** Gets the build time of the tiles built by the last create or rebuildTiles. */
+    const NavMeshBuildReport& getBuildReport() const { return _buildReport; }
+
     /** update navmesh. */
     void update(float dt);
 
@@ -97,11 +122,70 @@ public:
     */
     void findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>& pathPoints);
 
+    /** The callback of findPathAsync, pathPoints is empty when no path was found. */
+    using FindPathCallback = std::function<void(const std::vector<Vec3>& pathPoints)>;
+
+    /** The callback of raycastAsync, hitPoint is the end position when nothing was hit. */
+    using RaycastCallback = std::function<void(bool hit, const Vec3& hitPoint)>;
+
+    /** The callback of findNearestPolyAsync. */
+    using FindNearestPolyCallback = std::function<void(bool found, const Vec3& nearestPoint)>;
+
+    /**
+    find a path on navmesh without blocking the calling thread
+
+    The queued queries are serviced by update() on the job system, and their callbacks are invoked
+    on the main thread, in no particular order, once their results are ready.
+    A path whose search spans frames fails if tiles of it are rebuilt meanwhile, in that case
+    pathPoints is empty and the path should be requested again.
+
+    @param start The start search position in world coordinate system.
+    @param end The end search position in world coordinate system.
+    @param callback Receives the key points of path.
+    */
+    void findPathAsync(const Vec3& start, const Vec3& end, FindPathCallback callback);
+
+    /**
+    cast a walkability ray along the navmesh surface without blocking the calling thread
+
+    @param start The start position, which must be on the navmesh, in world coordinate system.
+    @param end The end position in world coordinate system.
+    @param callback Receives whether a wall was hit and where.
+    */
+    void raycastAsync(const Vec3& start, const Vec3& end, RaycastCallback callback);
+
+    /**
+    find the nearest point on navmesh without blocking the calling thread
+
+    @param pos The position in world coordinate system.
+    @param callback Receives the nearest point on navmesh.
+    */
+    void findNearestPolyAsync(const Vec3& pos, FindNearestPolyCallback callback);
+
+    /** Drops all the queued async queries, their callbacks won't be invoked. */
+    void cancelAsyncQueries();
+
+    /** Gets the number of async queries which have not completed yet. */
+    size_t getAsyncQueryCount() const;
+
+    /**
+    Sets the max number of search iterations spent on async queries per frame, 4096 by default.
+    The budget is shared by all the worker threads, a path search which runs out of it resumes next frame.
+    */
+    void setAsyncQueryBudget(int maxIterations) { _asyncQueryBudget = maxIterations; }
+
+    /** Gets the max number of search iterations spent on async queries per frame. */
+    int getAsyncQueryBudget() const { return _asyncQueryBudget; }
+
     NavMesh();
     virtual ~NavMesh();
 
 protected:
     bool initWithFilePath(std::string_view navFilePath, std::string_view geomFilePath);
+    bool initWithGeometry(const NavMeshGeometry& geometry, const NavMeshBuildSettings& settings);
+    bool initTileCache(const dtNavMeshParams& meshParams, const dtTileCacheParams& cacheParams);
+    void initCrowd(const dtTileCacheParams& cacheParams);
+    void buildTiles(int minX, int minY, int maxX, int maxY);
     bool read();
     bool loadNavMeshFile();
     bool loadGeomFile();
@@ -110,6 +194,17 @@ protected:
     void drawObstacles();
     void drawOffMeshConnections();
 
+    struct AsyncQuery;
+    struct AsyncQuerySlot
+    {
+        dtNavMeshQuery* navMeshQuery{nullptr};
+        std::unique_ptr<AsyncQuery> current;
+        std::vector<std::unique_ptr<AsyncQuery>> completed;
+    };
+    void enqueueAsyncQuery(std::unique_ptr<AsyncQuery> query);
+    void updateAsyncQueries();
+    bool stepAsyncQuery(dtNavMeshQuery* navMeshQuery, AsyncQuery* query, int& budget);
+
 protected:
     dtNavMesh* _navMesh;
     dtNavMeshQuery* _navMeshQuery;
@@ -122,6 +217,14 @@ protected:
 
     std::vector<NavMeshAgent*> _agentList;
     std::vector<NavMeshObstacle*> _obstacleList;
+    std::deque<std::unique_ptr<AsyncQuery>> _asyncQueries;
+    std::vector<AsyncQuerySlot> _asyncQuerySlots;
+    int _asyncQueryBudget;
+    NavMeshGeometry _buildGeometry;
+    NavMeshBuildSettings _buildSettings;
+    NavMeshBuildReport _buildReport;
+    int _tileCountX;
+    int _tileCountY;
     NavMeshDebugDraw _debugDraw;
     std::string _navFilePath;
     std::string _geomFilePath;
@@ -0,0 +1,733 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "navmesh/NavMeshBuilder.h"
+#if defined(AX_ENABLE_NAVMESH)
+
+#    include "3d/Bundle3D.h"
+#    include "3d/MeshRenderer.h"
+#    include "3d/Terrain.h"
+#    include "recast/DetourCommon.h"
+#    include "recast/DetourTileCacheBuilder.h"
+#    include <algorithm>
+#    include <cmath>
+#    include <deque>
+
+namespace ax
+{
+
+void NavMeshGeometry::addTriangles(const std::vector<Vec3>& triangles, const Mat4& transform)
+{
+    _triangles.reserve(_triangles.size() + triangles.size() - triangles.size() % 3);
+    for (size_t i = 0; i + 2 < triangles.size(); i += 3)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            Vec3 v = triangles[i + j];
+            transform.transformPoint(&v);
+            _triangles.emplace_back(v);
+            _aabb.updateMinMax(&v, 1);
+        }
+    }
+}
+
+void NavMeshGeometry::addMeshRenderer(MeshRenderer* renderer, std::string_view modelPath)
+{
+    addTriangles(Bundle3D::getTrianglesList(modelPath), renderer->getNodeToWorldTransform());
+}
+
+void NavMeshGeometry::addTerrain(Terrain* terrain)
+{
+    // the same grid as the vertices of the terrain
+    auto heights   = terrain->getHeightData();
+    auto size      = terrain->getTerrainSize();
+    int width      = static_cast<int>(size.width);
+    int height     = static_cast<int>(size.height);
+    float mapScale = terrain->getMapScale();
+    auto vertexAt  = [&](int x, int z) {
+        return Vec3(x * mapScale - width / 2 * mapScale, heights[z * width + x], z * mapScale - height / 2 * mapScale);
+    };
+
+    std::vector<Vec3> triangles;
+    triangles.reserve(static_cast<size_t>(std::max(width - 1, 0)) * std::max(height - 1, 0) * 6);
+    for (int z = 0; z + 1 < height; ++z)
+    {
+        for (int x = 0; x + 1 < width; ++x)
+        {
+            triangles.emplace_back(vertexAt(x, z));
+            triangles.emplace_back(vertexAt(x, z + 1));
+            triangles.emplace_back(vertexAt(x + 1, z));
+
+            triangles.emplace_back(vertexAt(x, z + 1));
+            triangles.emplace_back(vertexAt(x + 1, z + 1));
+            triangles.emplace_back(vertexAt(x + 1, z));
+        }
+    }
+    addTriangles(triangles, terrain->getNodeToWorldTransform());
+}
+
+void NavMeshGeometry::clear()
+{
+    _triangles.clear();
+    _aabb.reset();
+}
+
+// A trimmed down version of the voxelization of Recast, which isn't part of the vendored sources:
+// the triangles are rasterized to spans, filtered by the agent's size, then partitioned to 2.5D layers
+// which DetourTileCache turns to navmesh tiles.
+namespace
+{
+const int SPAN_MAX_HEIGHT = 0x1fff;
+const int NOT_CONNECTED   = -1;
+const int MAX_LAYERS      = 32;
+const int MAX_LAYER_RANGE = 250;
+const int DIR_X[4]        = {-1, 0, 1, 0};
+const int DIR_Y[4]        = {0, 1, 0, -1};
+
+struct Span
+{
+    int smin;
+    int smax;
+    unsigned char area;
+};
+
+struct CompactSpan
+{
+    int y;
+    int h;
+    int con[4];
+    unsigned char area;
+    unsigned char layer;
+};
+
+struct CompactCell
+{
+    int index;
+    int count;
+};
+
+struct TileField
+{
+    int width;
+    int height;
+    float bmin[3];
+    float bmax[3];
+    float cs;
+    float ch;
+    std::vector<std::vector<Span>> columns;
+    std::vector<CompactCell> cells;
+    std::vector<CompactSpan> spans;
+};
+
+// Splits the polygon in by the plane axis = x, out1 is the part below it.
+void dividePoly(const float* in, int nin, float* out1, int* nout1, float* out2, int* nout2, float x, int axis)
+{
+    float d[12];
+    for (int i = 0; i < nin; ++i)
+        d[i] = x - in[i * 3 + axis];
+
+    int m = 0, n = 0;
+    for (int i = 0, j = nin - 1; i < nin; j = i, ++i)
+    {
+        bool ina = d[j] >= 0;
+        bool inb = d[i] >= 0;
+        if (ina != inb)
+        {
+            float s = d[j] / (d[j] - d[i]);
+            for (int k = 0; k < 3; ++k)
+                out1[m * 3 + k] = out2[n * 3 + k] = in[j * 3 + k] + (in[i * 3 + k] - in[j * 3 + k]) * s;
+            ++m;
+            ++n;
+            // the points on the plane have just been added to both
+            if (d[i] > 0)
+                dtVcopy(out1 + 3 * m++, in + i * 3);
+            else if (d[i] < 0)
+                dtVcopy(out2 + 3 * n++, in + i * 3);
+        }
+        else
+        {
+            if (d[i] >= 0)
+            {
+                dtVcopy(out1 + 3 * m++, in + i * 3);
+                if (d[i] != 0)
+                    continue;
+            }
+            dtVcopy(out2 + 3 * n++, in + i * 3);
+        }
+    }
+    *nout1 = m;
+    *nout2 = n;
+}
+
+void addSpan(std::vector<Span>& column, int smin, int smax, unsigned char area, int flagMergeThreshold)
+{
+    Span span{smin, smax, area};
+    auto iter = column.begin();
+    while (iter != column.end())
+    {
+        if (iter->smin > span.smax)
+            break;
+        if (iter->smax < span.smin)
+        {
+            ++iter;
+            continue;
+        }
+        // merge the overlapping span, the walkable top surface wins
+        span.smin = std::min(span.smin, iter->smin);
+        span.smax = std::max(span.smax, iter->smax);
+        if (std::abs(span.smax - iter->smax) <= flagMergeThreshold)
+            span.area = std::max(span.area, iter->area);
+        iter = column.erase(iter);
+    }
+    column.insert(iter, span);
+}
+
+void rasterizeTriangle(TileField& field, const float* v0, const float* v1, const float* v2, unsigned char area,
+                       int flagMergeThreshold)
+{
+    float tmin[3], tmax[3];
+    dtVcopy(tmin, v0);
+    dtVcopy(tmax, v0);
+    dtVmin(tmin, v1);
+    dtVmin(tmin, v2);
+    dtVmax(tmax, v1);
+    dtVmax(tmax, v2);
+    if (!dtOverlapBounds(field.bmin, field.bmax, tmin, tmax))
+        return;
+
+    const float ics = 1.0f / field.cs;
+    const float ich = 1.0f / field.ch;
+    const float by  = field.bmax[1] - field.bmin[1];
+    int y0          = dtClamp(static_cast<int>((tmin[2] - field.bmin[2]) * ics), -1, field.height - 1);
+    int y1          = dtClamp(static_cast<int>((tmax[2] - field.bmin[2]) * ics), 0, field.height - 1);
+
+    float buf[7 * 3 * 4];
+    float *in = buf, *inrow = buf + 7 * 3, *p1 = inrow + 7 * 3, *p2 = p1 + 7 * 3;
+    dtVcopy(in, v0);
+    dtVcopy(in + 3, v1);
+    dtVcopy(in + 6, v2);
+    int nvin = 3, nvrow = 0;
+
+    for (int y = y0; y <= y1; ++y)
+    {
+        // clip the rest of the polygon to the row
+        float cz = field.bmin[2] + y * field.cs;
+        dividePoly(in, nvin, inrow, &nvrow, p1, &nvin, cz + field.cs, 2);
+        std::swap(in, p1);
+        if (nvrow < 3 || y < 0)
+            continue;
+
+        float minX = inrow[0], maxX = inrow[0];
+        for (int i = 1; i < nvrow; ++i)
+        {
+            minX = std::min(minX, inrow[i * 3]);
+            maxX = std::max(maxX, inrow[i * 3]);
+        }
+        int x0 = static_cast<int>((minX - field.bmin[0]) * ics);
+        int x1 = static_cast<int>((maxX - field.bmin[0]) * ics);
+        if (x1 < 0 || x0 >= field.width)
+            continue;
+        x0 = dtClamp(x0, -1, field.width - 1);
+        x1 = dtClamp(x1, 0, field.width - 1);
+
+        int nv = 0, nv2 = nvrow;
+        for (int x = x0; x <= x1; ++x)
+        {
+            // clip the rest of the row to the cell
+            float cx = field.bmin[0] + x * field.cs;
+            dividePoly(inrow, nv2, p1, &nv, p2, &nv2, cx + field.cs, 0);
+            std::swap(inrow, p2);
+            if (nv < 3 || x < 0)
+                continue;
+
+            float smin = p1[1], smax = p1[1];
+            for (int i = 1; i < nv; ++i)
+            {
+                smin = std::min(smin, p1[i * 3 + 1]);
+                smax = std::max(smax, p1[i * 3 + 1]);
+            }
+            smin -= field.bmin[1];
+            smax -= field.bmin[1];
+            if (smax < 0.0f || smin > by)
+                continue;
+            smin = std::max(smin, 0.0f);
+            smax = std::min(smax, by);
+
+            int ismin = dtClamp(static_cast<int>(std::floor(smin * ich)), 0, SPAN_MAX_HEIGHT);
+            int ismax = dtClamp(static_cast<int>(std::ceil(smax * ich)), ismin + 1, SPAN_MAX_HEIGHT);
+            addSpan(field.columns[x + y * field.width], ismin, ismax, area, flagMergeThreshold);
+        }
+    }
+}
+
+void filterSpans(TileField& field, int walkableHeight, int walkableClimb)
+{
+    const int w = field.width;
+    const int h = field.height;
+
+    // obstacles low enough to step over, like stairs and curbs, become walkable
+    for (auto&& column : field.columns)
+    {
+        bool previousWalkable      = false;
+        unsigned char previousArea = DT_TILECACHE_NULL_AREA;
+        int previousTop            = 0;
+        for (auto&& span : column)
+        {
+            bool walkable = span.area != DT_TILECACHE_NULL_AREA;
+            if (!walkable && previousWalkable && std::abs(span.smax - previousTop) <= walkableClimb)
+                span.area = previousArea;
+            previousWalkable = walkable;
+            previousArea     = span.area;
+            previousTop      = span.smax;
+        }
+    }
+
+    // ledges and steep slopes
+    for (int y = 0; y < h; ++y)
+    {
+        for (int x = 0; x < w; ++x)
+        {
+            auto& column = field.columns[x + y * w];
+            for (size_t i = 0; i < column.size(); ++i)
+            {
+                auto& span = column[i];
+                if (span.area == DT_TILECACHE_NULL_AREA)
+                    continue;
+
+                int bot   = span.smax;
+                int top   = i + 1 < column.size() ? column[i + 1].smin : SPAN_MAX_HEIGHT;
+                int minh  = SPAN_MAX_HEIGHT;
+                int asmin = span.smax, asmax = span.smax;
+                for (int dir = 0; dir < 4; ++dir)
+                {
+                    int dx = x + DIR_X[dir];
+                    int dy = y + DIR_Y[dir];
+                    if (dx < 0 || dy < 0 || dx >= w || dy >= h)
+                    {
+                        minh = std::min(minh, -walkableClimb - bot);
+                        continue;
+                    }
+
+                    auto& neighbors = field.columns[dx + dy * w];
+                    int nbot        = -walkableClimb;
+                    int ntop        = neighbors.empty() ? SPAN_MAX_HEIGHT : neighbors.front().smin;
+                    if (std::min(top, ntop) - std::max(bot, nbot) > walkableHeight)
+                        minh = std::min(minh, nbot - bot);
+
+                    for (size_t k = 0; k < neighbors.size(); ++k)
+                    {
+                        nbot = neighbors[k].smax;
+                        ntop = k + 1 < neighbors.size() ? neighbors[k + 1].smin : SPAN_MAX_HEIGHT;
+                        if (std::min(top, ntop) - std::max(bot, nbot) > walkableHeight)
+                        {
+                            minh = std::min(minh, nbot - bot);
+                            if (std::abs(nbot - bot) <= walkableClimb)
+                            {
+                                asmin = std::min(asmin, nbot);
+                                asmax = std::max(asmax, nbot);
+                            }
+                        }
+                    }
+                }
+
+                if (minh < -walkableClimb || (asmax - asmin) > walkableClimb)
+                    span.area = DT_TILECACHE_NULL_AREA;
+            }
+        }
+    }
+
+    // not enough clearance above
+    for (auto&& column : field.columns)
+    {
+        for (size_t i = 0; i < column.size(); ++i)
+        {
+            int top = i + 1 < column.size() ? column[i + 1].smin : SPAN_MAX_HEIGHT;
+            if (top - column[i].smax < walkableHeight)
+                column[i].area = DT_TILECACHE_NULL_AREA;
+        }
+    }
+}
+
+void buildCompactSpans(TileField& field, int walkableHeight, int walkableClimb)
+{
+    const int w = field.width;
+    const int h = field.height;
+
+    // the open space above the walkable spans
+    field.cells.resize(w * h);
+    for (int i = 0; i < w * h; ++i)
+    {
+        auto& column         = field.columns[i];
+        field.cells[i].index = static_cast<int>(field.spans.size());
+        for (size_t k = 0; k < column.size(); ++k)
+        {
+            if (column[k].area == DT_TILECACHE_NULL_AREA)
+                continue;
+            int top = k + 1 < column.size() ? column[k + 1].smin : SPAN_MAX_HEIGHT;
+            field.spans.push_back({column[k].smax, top - column[k].smax,
+                                   {NOT_CONNECTED, NOT_CONNECTED, NOT_CONNECTED, NOT_CONNECTED},
+                                   column[k].area,
+                                   0xff});
+        }
+        field.cells[i].count = static_cast<int>(field.spans.size()) - field.cells[i].index;
+    }
+
+    for (int y = 0; y < h; ++y)
+    {
+        for (int x = 0; x < w; ++x)
+        {
+            const auto& cell = field.cells[x + y * w];
+            for (int i = cell.index; i < cell.index + cell.count; ++i)
+            {
+                auto& span = field.spans[i];
+                for (int dir = 0; dir < 4; ++dir)
+                {
+                    int nx = x + DIR_X[dir];
+                    int ny = y + DIR_Y[dir];
+                    if (nx < 0 || ny < 0 || nx >= w || ny >= h)
+                        continue;
+                    const auto& ncell = field.cells[nx + ny * w];
+                    for (int k = ncell.index; k < ncell.index + ncell.count; ++k)
+                    {
+                        const auto& nspan = field.spans[k];
+                        int bot           = std::max(span.y, nspan.y);
+                        int top           = std::min(span.y + span.h, nspan.y + nspan.h);
+                        if (top - bot >= walkableHeight && std::abs(nspan.y - span.y) <= walkableClimb)
+                        {
+                            span.con[dir] = k;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Drops the spans closer than the agent radius to a wall or ledge, with a chamfer distance transform.
+void erodeWalkableArea(TileField& field, int walkableRadius)
+{
+    const int w = field.width;
+    const int h = field.height;
+    std::vector<unsigned char> dist(field.spans.size(), 0xff);
+
+    for (size_t i = 0; i < field.spans.size(); ++i)
+    {
+        int connected = 0;
+        for (int dir = 0; dir < 4; ++dir)
+        {
+            if (field.spans[i].con[dir] != NOT_CONNECTED)
+                ++connected;
+        }
+        if (connected != 4)
+            dist[i] = 0;
+    }
+
+    auto relax = [&](int i, int neighbor, int cost) {
+        int nd = std::min(dist[neighbor] + cost, 255);
+        if (nd < dist[i])
+            dist[i] = static_cast<unsigned char>(nd);
+    };
+
+    for (int y = 0; y < h; ++y)
+    {
+        for (int x = 0; x < w; ++x)
+        {
+            const auto& cell = field.cells[x + y * w];
+            for (int i = cell.index; i < cell.index + cell.count; ++i)
+            {
+                const auto& span = field.spans[i];
+                if (int a = span.con[0]; a != NOT_CONNECTED)
+                {
+                    relax(i, a, 2);
+                    if (int aa = field.spans[a].con[3]; aa != NOT_CONNECTED)
+                        relax(i, aa, 3);
+                }
+                if (int a = span.con[3]; a != NOT_CONNECTED)
+                {
+                    relax(i, a, 2);
+                    if (int aa = field.spans[a].con[2]; aa != NOT_CONNECTED)
+                        relax(i, aa, 3);
+                }
+            }
+        }
+    }
+
+    for (int y = h - 1; y >= 0; --y)
+    {
+        for (int x = w - 1; x >= 0; --x)
+        {
+            const auto& cell = field.cells[x + y * w];
+            for (int i = cell.index; i < cell.index + cell.count; ++i)
+            {
+                const auto& span = field.spans[i];
+                if (int a = span.con[2]; a != NOT_CONNECTED)
+                {
+                    relax(i, a, 2);
+                    if (int aa = field.spans[a].con[1]; aa != NOT_CONNECTED)
+                        relax(i, aa, 3);
+                }
+                if (int a = span.con[1]; a != NOT_CONNECTED)
+                {
+                    relax(i, a, 2);
+                    if (int aa = field.spans[a].con[0]; aa != NOT_CONNECTED)
+                        relax(i, aa, 3);
+                }
+            }
+        }
+    }
+
+    const int threshold = walkableRadius * 2;
+    for (size_t i = 0; i < field.spans.size(); ++i)
+    {
+        if (dist[i] < threshold)
+            field.spans[i].area = DT_TILECACHE_NULL_AREA;
+    }
+}
+
+struct LayerInfo
+{
+    int hmin;
+    int hmax;
+};
+
+// Flood fills the connected walkable spans to layers which hold at most one span per column,
+// so overlapping floors end up in separate layers. The spans of the border are left out of the layers,
+// the connections to them become the portals to the neighbor tiles.
+std::vector<LayerInfo> partitionLayers(TileField& field, int borderSize)
+{
+    const int w = field.width;
+    const int h = field.height;
+    std::vector<LayerInfo> layers;
+    std::vector<int> columnOf(field.spans.size());
+    std::vector<unsigned char> inside(field.spans.size());
+    for (int i = 0; i < w * h; ++i)
+    {
+        int x = i % w, y = i / w;
+        bool isInside = x >= borderSize && y >= borderSize && x < w - borderSize && y < h - borderSize;
+        for (int k = field.cells[i].index; k < field.cells[i].index + field.cells[i].count; ++k)
+        {
+            columnOf[k] = i;
+            inside[k]   = isInside;
+        }
+    }
+
+    std::vector<unsigned char> occupied(w * h);
+    std::deque<int> open;
+    for (size_t seed = 0; seed < field.spans.size() && layers.size() < MAX_LAYERS; ++seed)
+    {
+        auto& seedSpan = field.spans[seed];
+        if (seedSpan.area == DT_TILECACHE_NULL_AREA || seedSpan.layer != 0xff || !inside[seed])
+            continue;
+
+        const auto layerId = static_cast<unsigned char>(layers.size());
+        LayerInfo layer{seedSpan.y, seedSpan.y};
+        std::fill(occupied.begin(), occupied.end(), 0);
+        seedSpan.layer           = layerId;
+        occupied[columnOf[seed]] = 1;
+        open.push_back(static_cast<int>(seed));
+        while (!open.empty())
+        {
+            int i = open.front();
+            open.pop_front();
+            for (int dir = 0; dir < 4; ++dir)
+            {
+                int a = field.spans[i].con[dir];
+                if (a == NOT_CONNECTED)
+                    continue;
+                auto& nspan = field.spans[a];
+                if (nspan.area == DT_TILECACHE_NULL_AREA || nspan.layer != 0xff || !inside[a] ||
+                    occupied[columnOf[a]])
+                    continue;
+                // the heights of a layer are stored in bytes
+                int hmin = std::min(layer.hmin, nspan.y);
+                int hmax = std::max(layer.hmax, nspan.y);
+                if (hmax - hmin > MAX_LAYER_RANGE)
+                    continue;
+                layer.hmin            = hmin;
+                layer.hmax            = hmax;
+                nspan.layer           = layerId;
+                occupied[columnOf[a]] = 1;
+                open.push_back(a);
+            }
+        }
+        layers.emplace_back(layer);
+    }
+    return layers;
+}
+}  // namespace
+
+void buildNavMeshTileLayers(const NavMeshGeometry& geometry,
+                            const std::vector<int>& triangles,
+                            const NavMeshBuildSettings& settings,
+                            const dtTileCacheParams& params,
+                            int tx,
+                            int ty,
+                            dtTileCacheCompressor* compressor,
+                            std::vector<std::pair<unsigned char*, int>>& layers)
+{
+    const float cs           = params.cs;
+    const float ch           = params.ch;
+    const int walkableHeight = static_cast<int>(std::ceil(settings.agentHeight / ch));
+    const int walkableClimb  = static_cast<int>(std::floor(settings.agentMaxClimb / ch));
+    const int walkableRadius = static_cast<int>(std::ceil(settings.agentRadius / cs));
+    const int borderSize     = walkableRadius + 3;
+    const int tileSize       = params.width;
+    const float tileWidth    = tileSize * cs;
+    const auto& aabb         = geometry.getAABB();
+
+    // the border lets the spans at the edges of the tile see their neighbors
+    TileField field;
+    field.width   = tileSize + borderSize * 2;
+    field.height  = tileSize + borderSize * 2;
+    field.cs      = cs;
+    field.ch      = ch;
+    field.bmin[0] = params.orig[0] + tx * tileWidth - borderSize * cs;
+    field.bmin[1] = params.orig[1];
+    field.bmin[2] = params.orig[2] + ty * tileWidth - borderSize * cs;
+    field.bmax[0] = params.orig[0] + (tx + 1) * tileWidth + borderSize * cs;
+    field.bmax[1] = std::max(aabb._max.y, params.orig[1] + ch);
+    field.bmax[2] = params.orig[2] + (ty + 1) * tileWidth + borderSize * cs;
+    field.columns.resize(field.width * field.height);
+
+    const float walkableThreshold = std::cos(AX_DEGREES_TO_RADIANS(settings.agentMaxSlope));
+    const auto& vertices          = geometry.getTriangles();
+    for (int triangle : triangles)
+    {
+        const Vec3& v0 = vertices[triangle * 3];
+        const Vec3& v1 = vertices[triangle * 3 + 1];
+        const Vec3& v2 = vertices[triangle * 3 + 2];
+        Vec3 normal;
+        Vec3::cross(v1 - v0, v2 - v0, &normal);
+        normal.normalize();
+        auto area = normal.y > walkableThreshold ? DT_TILECACHE_WALKABLE_AREA : DT_TILECACHE_NULL_AREA;
+        rasterizeTriangle(field, &v0.x, &v1.x, &v2.x, area, walkableClimb);
+    }
+
+    filterSpans(field, walkableHeight, walkableClimb);
+    buildCompactSpans(field, walkableHeight, walkableClimb);
+    erodeWalkableArea(field, walkableRadius);
+    auto layerInfos = partitionLayers(field, borderSize);
+
+    const int lw = tileSize;
+    const int lh = tileSize;
+    std::vector<unsigned char> heights(lw * lh), areas(lw * lh), cons(lw * lh);
+    int tlayer = 0;
+    for (size_t layerId = 0; layerId < layerInfos.size(); ++layerId)
+    {
+        const auto& info = layerInfos[layerId];
+        std::fill(heights.begin(), heights.end(), 0xff);
+        std::fill(areas.begin(), areas.end(), DT_TILECACHE_NULL_AREA);
+        std::fill(cons.begin(), cons.end(), 0);
+
+        int minx = lw, maxx = -1, miny = lh, maxy = -1;
+        for (int y = 0; y < lh; ++y)
+        {
+            for (int x = 0; x < lw; ++x)
+            {
+                int cx           = x + borderSize;
+                int cy           = y + borderSize;
+                const auto& cell = field.cells[cx + cy * field.width];
+                for (int i = cell.index; i < cell.index + cell.count; ++i)
+                {
+                    const auto& span = field.spans[i];
+                    if (span.layer != layerId)
+                        continue;
+
+                    int idx      = x + y * lw;
+                    heights[idx] = static_cast<unsigned char>(span.y - info.hmin);
+                    areas[idx]   = span.area;
+                    minx         = std::min(minx, x);
+                    maxx         = std::max(maxx, x);
+                    miny         = std::min(miny, y);
+                    maxy         = std::max(maxy, y);
+
+                    unsigned char portal = 0, con = 0;
+                    for (int dir = 0; dir < 4; ++dir)
+                    {
+                        int a = span.con[dir];
+                        if (a == NOT_CONNECTED)
+                            continue;
+                        const auto& nspan = field.spans[a];
+                        if (nspan.area == DT_TILECACHE_NULL_AREA)
+                            continue;
+                        if (nspan.layer != layerId)
+                        {
+                            // the heights must match on both sides of the portal
+                            portal |= static_cast<unsigned char>(1 << dir);
+                            if (nspan.y > info.hmin)
+                                heights[idx] = static_cast<unsigned char>(
+                                    std::max<int>(heights[idx], std::min(nspan.y - info.hmin, 0xfe)));
+                        }
+                        else
+                        {
+                            int nx = x + DIR_X[dir];
+                            int ny = y + DIR_Y[dir];
+                            if (nx >= 0 && ny >= 0 && nx < lw && ny < lh)
+                                con |= static_cast<unsigned char>(1 << dir);
+                        }
+                    }
+                    cons[idx] = static_cast<unsigned char>((portal << 4) | con);
+                }
+            }
+        }
+
+        // the layer only covers the border of the tile
+        if (maxx < minx)
+            continue;
+
+        dtTileCacheLayerHeader header;
+        header.magic   = DT_TILECACHE_MAGIC;
+        header.version = DT_TILECACHE_VERSION;
+        header.tx      = tx;
+        header.ty      = ty;
+        header.tlayer  = tlayer;
+        header.bmin[0] = field.bmin[0] + borderSize * cs;
+        header.bmin[1] = field.bmin[1] + info.hmin * ch;
+        header.bmin[2] = field.bmin[2] + borderSize * cs;
+        header.bmax[0] = field.bmax[0] - borderSize * cs;
+        header.bmax[1] = field.bmin[1] + info.hmax * ch;
+        header.bmax[2] = field.bmax[2] - borderSize * cs;
+        header.hmin    = static_cast<unsigned short>(info.hmin);
+        header.hmax    = static_cast<unsigned short>(info.hmax);
+        header.width   = static_cast<unsigned char>(lw);
+        header.height  = static_cast<unsigned char>(lh);
+        header.minx    = static_cast<unsigned char>(minx);
+        header.maxx    = static_cast<unsigned char>(maxx);
+        header.miny    = static_cast<unsigned char>(miny);
+        header.maxy    = static_cast<unsigned char>(maxy);
+
+        unsigned char* data = nullptr;
+        int dataSize        = 0;
+        if (dtStatusSucceed(
+                dtBuildTileCacheLayer(compressor, &header, heights.data(), areas.data(), cons.data(), &data, &dataSize)))
+        {
+            layers.emplace_back(data, dataSize);
+            ++tlayer;
+        }
+    }
+}
+
+}
+
+#endif  // AX_ENABLE_NAVMESH
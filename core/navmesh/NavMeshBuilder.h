@@ -0,0 +1,149 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CCNAV_MESH_BUILDER_H__
+#define __CCNAV_MESH_BUILDER_H__
+
+#include "base/Config.h"
+#if defined(AX_ENABLE_NAVMESH)
+
+#    include "3d/AABB.h"
+#    include "math/Mat4.h"
+#    include "math/Vec3.h"
+#    include "recast/DetourTileCache.h"
+#    include <string_view>
+#    include <vector>
+
+namespace ax
+{
+
+/**
+ * @addtogroup 3d
+ * @{
+ */
+class MeshRenderer;
+class Terrain;
+
+/** @brief NavMeshBuildSettings: The parameters of building a tiled navmesh from geometry at runtime. */
+struct NavMeshBuildSettings
+{
+    /** The xz size of the voxels the geometry is rasterized to. */
+    float cellSize = 0.3f;
+    /** The y size of the voxels the geometry is rasterized to. */
+    float cellHeight = 0.2f;
+    /** The min height of ceilings agents can walk under. */
+    float agentHeight = 2.0f;
+    /** The min distance to walls of the walkable area. */
+    float agentRadius = 0.6f;
+    /** The max height of ledges agents can step up. */
+    float agentMaxClimb = 0.9f;
+    /** The max slope agents can walk on, in degrees. */
+    float agentMaxSlope = 45.0f;
+    /** The xz size of tiles in cells, at most 255. */
+    int tileSize = 48;
+    /** The max number of NavMeshObstacle. */
+    int maxObstacles = 128;
+};
+
+/** @brief NavMeshBuildReport: The time spent building the tiles of a navmesh. */
+struct NavMeshBuildReport
+{
+    struct Tile
+    {
+        int x;
+        int y;
+        int layers;
+        /** The time spent rasterizing the tile, on the worker thread which built it. */
+        float milliseconds;
+    };
+
+    std::vector<Tile> tiles;
+    /** The wall time spent rasterizing the tiles in parallel. */
+    float rasterizeMilliseconds = 0.0f;
+    /** The wall time of the whole build, including adding the tiles to the navmesh. */
+    float totalMilliseconds = 0.0f;
+};
+
+/** @brief NavMeshGeometry: The triangles a navmesh is built from, in world coordinate system. */
+class AX_DLL NavMeshGeometry
+{
+public:
+    /**
+    add a triangle list
+
+    @param triangles Every 3 vertices are a triangle, counter-clockwise when seen from above.
+    @param transform The transform from the vertices to world coordinate system.
+    */
+    void addTriangles(const std::vector<Vec3>& triangles, const Mat4& transform = Mat4::IDENTITY);
+
+    /**
+    add the triangles of a model, placed where the renderer is
+
+    The vertices of a MeshRenderer only live in GPU buffers, so they are read again from the model file,
+    like Physics3DShape meshes do.
+
+    @param renderer The renderer of the model.
+    @param modelPath The model file the renderer was created from.
+    */
+    void addMeshRenderer(MeshRenderer* renderer, std::string_view modelPath);
+
+    /** add the triangles of the height map of a terrain, placed where the terrain is. */
+    void addTerrain(Terrain* terrain);
+
+    /** remove all the triangles. */
+    void clear();
+
+    const std::vector<Vec3>& getTriangles() const { return _triangles; }
+
+    /** Gets the bounds of all the triangles. */
+    const AABB& getAABB() const { return _aabb; }
+
+protected:
+    std::vector<Vec3> _triangles;
+    AABB _aabb;
+};
+
+/**
+Internal method, rasterizes the triangles overlapping a tile and its border into compressed tile cache layers.
+It only reads its arguments, so tiles can be built in parallel.
+
+@param triangles The indices of the triangles of geometry overlapping the tile.
+@param layers Receives the compressed layers, allocated with dtAlloc.
+*/
+void buildNavMeshTileLayers(const NavMeshGeometry& geometry,
+                            const std::vector<int>& triangles,
+                            const NavMeshBuildSettings& settings,
+                            const dtTileCacheParams& params,
+                            int tx,
+                            int ty,
+                            dtTileCacheCompressor* compressor,
+                            std::vector<std::pair<unsigned char*, int>>& layers);
+
+/** @} */
+
+}
+
+#endif  // AX_ENABLE_NAVMESH
+
+#endif  // __CCNAV_MESH_BUILDER_H__
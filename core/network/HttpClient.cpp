@@ -118,6 +118,11 @@ HttpClient::HttpClient()
     , _dispatchOnWorkThread(false)
     , _timeoutForConnect(30)
     , _timeoutForRead(60)
+    , _keepAliveEnabled(true)
+    , _keepAliveTimeout(30)
+    , _pipeliningDepth(1)
+    , _openedConnectionCount(0)
+    , _dispatchScheduled(false)
     , _cookie(nullptr)
     , _clearResponsePredicate(nullptr)
 {
@@ -143,6 +148,13 @@ HttpClient::~HttpClient()
     _scheduler->unscheduleAllForTarget(this);
     delete _service;
 
+    for (auto& conn : _connections)
+    {
+        for (auto response : conn.responses)
+            response->release();
+        conn.responses.clear();
+    }
+
     clearPendingResponseQueue();
     clearFinishedResponseQueue();
     if (_cookie)
@@ -182,6 +194,7 @@ void HttpClient::tickInput()
 void HttpClient::handleNetworkStatusChanged()
 {
     _service->set_option(YOPT_S_DNS_DIRTY, 1);
+    closeIdleConnections();
 }
 
 void HttpClient::setNameServers(std::string_view servers)
@@ -201,8 +214,59 @@ void HttpClient::send(HttpRequest* request)
 
     auto response = new HttpResponse(request);
     response->setLocation(request->getUrl(), false);
-    processResponse(response, -1);
-    response->release();
+    if (response->validateUri())
+    {
+        _pendingResponseQueue.emplace_back(response);
+        schedulePendingResponses();
+    }
+    else
+        finishResponse(response);
+}
+
+void HttpClient::setKeepAliveEnabled(bool enabled)
+{
+    _keepAliveEnabled = enabled;
+    if (!enabled)
+        closeIdleConnections();
+}
+
+void HttpClient::setKeepAliveTimeout(int seconds)
+{
+    _keepAliveTimeout = (std::max)(seconds, 0);
+}
+
+void HttpClient::setPipeliningDepth(int depth)
+{
+    _pipeliningDepth = (std::max)(depth, 1);
+}
+
+void HttpClient::closeIdleConnections()
+{
+    _service->schedule(std::chrono::microseconds(0), [this](io_service& s) {
+        for (int i = 0; i < HttpClient::MAX_CHANNELS; ++i)
+        {
+            auto& conn = _connections[i];
+            if (conn.transport && conn.responses.empty() && !conn.closing)
+            {
+                conn.closing = true;
+                s.close(i);
+            }
+        }
+        return true;
+    });
+}
+
+void HttpClient::schedulePendingResponses()
+{
+    // coalesce a burst of send calls into one dispatch on the network thread
+    if (!_dispatchScheduled.exchange(true))
+    {
+        _service->schedule(std::chrono::microseconds(0), [this](io_service&) {
+            _dispatchScheduled = false;
+            dispatchPendingResponses();
+            return true;
+        });
+    }
 }
 
 int HttpClient::tryTakeAvailChannel()
@@ -217,190 +281,381 @@ int HttpClient::tryTakeAvailChannel()
     return -1;
 }
 
-void HttpClient::processResponse(HttpResponse* response, int channelIndex)
+static std::string makeConnectionKey(const Uri& uri)
 {
-    response->retain();
+    return fmt::format("{}://{}:{}", uri.getScheme(), uri.getHost(), uri.getPort());
+}
 
-    if (response->validateUri())
-    {
-        if (channelIndex == -1)
-            channelIndex = tryTakeAvailChannel();
+static bool isPipelinable(HttpResponse* response)
+{
+    // only idempotent requests are safe to resend when the server closes a pipelined connection
+    return response->getHttpRequest()->getRequestType() == HttpRequest::Type::GET;
+}
 
-        if (channelIndex != -1)
-        {
-            auto channelHandle = _service->channel_at(channelIndex);
-            auto& requestUri = response->getRequestUri();
-            channelHandle->ud_.ptr = response;
-            _service->set_option(YOPT_C_REMOTE_ENDPOINT, channelIndex, requestUri.getHost().data(),
-                                 (int)requestUri.getPort());
-            if (requestUri.isSecure())
-                _service->open(channelIndex, YCK_SSL_CLIENT);
-            else
-                _service->open(channelIndex, YCK_TCP_CLIENT);
-        }
+void HttpClient::dispatchPendingResponses()
+{
+    if (_service->is_stopping())
+        return;
+
+    int closingConnections = 0;
+    for (auto& conn : _connections)
+        if (conn.closing)
+            ++closingConnections;
+
+    auto lck = _pendingResponseQueue.get_lock();
+    for (auto it = _pendingResponseQueue.unsafe_begin(); it != _pendingResponseQueue.unsafe_end();)
+    {
+        if (dispatchResponse(*it, closingConnections))
+            it = _pendingResponseQueue.unsafe_erase(it);
         else
-            _pendingResponseQueue.emplace_back(response);
+            ++it;
     }
-    else
-        finishResponse(response);
 }
 
-void HttpClient::handleNetworkEvent(yasio::io_event* event)
+bool HttpClient::dispatchResponse(HttpResponse* response, int& closingConnections)
 {
-    int channelIndex       = event->cindex();
-    auto channel           = _service->channel_at(event->cindex());
-    HttpResponse* response = (HttpResponse*)channel->ud_.ptr;
-    assert(response);
+    auto key = makeConnectionKey(response->getRequestUri());
 
-    bool responseFinished = response->isFinished();
-    switch (event->kind())
+    if (_keepAliveEnabled)
     {
-    case YEK_ON_PACKET:
-        if (!responseFinished)
+        // prefer an idle connection to the same origin, then the least busy pipelined one
+        const int depth = isPipelinable(response) ? _pipeliningDepth.load() : 1;
+        int candidate   = -1;
+        for (int i = 0; i < HttpClient::MAX_CHANNELS; ++i)
         {
-            auto&& pkt = event->packet_view();
-            response->handleInput(pkt.data(), pkt.size());
+            auto& conn = _connections[i];
+            if (!conn.transport || conn.closing || conn.key != key)
+                continue;
+            if (conn.responses.empty())
+            {
+                candidate = i;
+                break;
+            }
+            if (static_cast<int>(conn.responses.size()) < depth && isPipelinable(conn.responses.back()) &&
+                (candidate == -1 || conn.responses.size() < _connections[candidate].responses.size()))
+                candidate = i;
         }
-        if (response->isFinished())
+        if (candidate != -1)
         {
-            response->updateInternalCode(yasio::errc::eof);
-            _service->close(event->cindex());
+            enqueueRequest(candidate, response);
+            return true;
         }
-        break;
-    case YEK_ON_OPEN:
-        if (event->status() == 0)
+    }
+
+    int channelIndex = tryTakeAvailChannel();
+    if (channelIndex != -1)
+    {
+        openConnection(channelIndex, std::move(key), response);
+        return true;
+    }
+
+    // all channels are in use, wait for a closing one or reclaim an idle connection to another origin
+    if (closingConnections > 0)
+    {
+        --closingConnections;
+        return false;
+    }
+    for (int i = 0; i < HttpClient::MAX_CHANNELS; ++i)
+    {
+        auto& conn = _connections[i];
+        if (conn.transport && conn.responses.empty() && !conn.closing)
         {
-            obstream obs;
-            bool usePostData = false;
-            auto request     = response->getHttpRequest();
-            switch (request->getRequestType())
-            {
-            case HttpRequest::Type::GET:
-                obs.write_bytes("GET");
-                break;
-            case HttpRequest::Type::PATCH:
-                obs.write_bytes("PATCH");
-                usePostData = true;
-                break;
-            case HttpRequest::Type::POST:
-                obs.write_bytes("POST");
-                usePostData = true;
-                break;
-            case HttpRequest::Type::DELETE:
-                obs.write_bytes("DELETE");
-                break;
-            case HttpRequest::Type::PUT:
-                obs.write_bytes("PUT");
-                usePostData = true;
-                break;
-            default:
-                obs.write_bytes("GET");
-                break;
-            }
-            obs.write_bytes(" ");
+            conn.closing = true;
+            _service->close(i);
+            break;
+        }
+    }
+    return false;
+}
 
-            auto& uri = response->getRequestUri();
-            obs.write_bytes(uri.getPathEtc());
+void HttpClient::openConnection(int channelIndex, std::string key, HttpResponse* response)
+{
+    auto& conn = _connections[channelIndex];
+    conn.key   = std::move(key);
+    conn.responses.emplace_back(response);
+
+    auto& requestUri = response->getRequestUri();
+    _service->set_option(YOPT_C_REMOTE_ENDPOINT, channelIndex, requestUri.getHost().data(),
+                         (int)requestUri.getPort());
+    if (requestUri.isSecure())
+        _service->open(channelIndex, YCK_SSL_CLIENT);
+    else
+        _service->open(channelIndex, YCK_TCP_CLIENT);
+    ++_openedConnectionCount;
+}
 
-            obs.write_bytes(" HTTP/1.1\r\n");
+void HttpClient::enqueueRequest(int channelIndex, HttpResponse* response)
+{
+    auto& conn = _connections[channelIndex];
+    conn.responses.emplace_back(response);
+    writeRequest(conn.transport, response);
+    if (conn.responses.size() == 1)
+        startReadTimer(channelIndex);  // replaces the idle timer
+}
 
-            obs.write_bytes("Host: ");
-            obs.write_bytes(uri.getHost());
+void HttpClient::writeRequest(yasio::transport_handle_t transport, HttpResponse* response)
+{
+    obstream obs;
+    bool usePostData = false;
+    auto request     = response->getHttpRequest();
+    switch (request->getRequestType())
+    {
+    case HttpRequest::Type::GET:
+        obs.write_bytes("GET");
+        break;
+    case HttpRequest::Type::PATCH:
+        obs.write_bytes("PATCH");
+        usePostData = true;
+        break;
+    case HttpRequest::Type::POST:
+        obs.write_bytes("POST");
+        usePostData = true;
+        break;
+    case HttpRequest::Type::DELETE:
+        obs.write_bytes("DELETE");
+        break;
+    case HttpRequest::Type::PUT:
+        obs.write_bytes("PUT");
+        usePostData = true;
+        break;
+    default:
+        obs.write_bytes("GET");
+        break;
+    }
+    obs.write_bytes(" ");
+
+    auto& uri = response->getRequestUri();
+    obs.write_bytes(uri.getPathEtc());
+
+    obs.write_bytes(" HTTP/1.1\r\n");
+
+    obs.write_bytes("Host: ");
+    obs.write_bytes(uri.getHost());
+    obs.write_bytes("\r\n");
+
+    // process custom headers
+    struct HeaderFlag
+    {
+        enum
+        {
+            UESR_AGENT   = 1,
+            CONTENT_TYPE = 1 << 1,
+            ACCEPT       = 1 << 2,
+            CONNECTION   = 1 << 3,
+        };
+    };
+    int headerFlags = 0;
+    auto& headers   = request->getHeaders();
+    if (!headers.empty())
+    {
+        using namespace cxx17;  // for string_view literal
+        for (auto&& header : headers)
+        {
+            obs.write_bytes(header);
             obs.write_bytes("\r\n");
 
-            // process custom headers
-            struct HeaderFlag
-            {
-                enum
-                {
-                    UESR_AGENT   = 1,
-                    CONTENT_TYPE = 1 << 1,
-                    ACCEPT       = 1 << 2,
-                };
-            };
-            int headerFlags = 0;
-            auto& headers   = request->getHeaders();
-            if (!headers.empty())
-            {
-                using namespace cxx17;  // for string_view literal
-                for (auto&& header : headers)
-                {
-                    obs.write_bytes(header);
-                    obs.write_bytes("\r\n");
-
-                    if (cxx20::ic::starts_with(cxx17::string_view{header}, "User-Agent:"_sv))
-                        headerFlags |= HeaderFlag::UESR_AGENT;
-                    else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Content-Type:"_sv))
-                        headerFlags |= HeaderFlag::CONTENT_TYPE;
-                    else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Accept:"_sv))
-                        headerFlags |= HeaderFlag::ACCEPT;
-                }
-            }
+            if (cxx20::ic::starts_with(cxx17::string_view{header}, "User-Agent:"_sv))
+                headerFlags |= HeaderFlag::UESR_AGENT;
+            else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Content-Type:"_sv))
+                headerFlags |= HeaderFlag::CONTENT_TYPE;
+            else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Accept:"_sv))
+                headerFlags |= HeaderFlag::ACCEPT;
+            else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Connection:"_sv))
+                headerFlags |= HeaderFlag::CONNECTION;
+        }
+    }
 
-            if (_cookie)
-            {
-                auto cookies = _cookie->checkAndGetFormatedMatchCookies(uri);
-                if (!cookies.empty())
-                {
-                    obs.write_bytes("Cookie: ");
-                    obs.write_bytes(cookies);
-                }
-            }
+    if (_cookie)
+    {
+        auto cookies = _cookie->checkAndGetFormatedMatchCookies(uri);
+        if (!cookies.empty())
+        {
+            obs.write_bytes("Cookie: ");
+            obs.write_bytes(cookies);
+        }
+    }
 
-            if (!(headerFlags & HeaderFlag::UESR_AGENT))
-                obs.write_bytes("User-Agent: yasio-http\r\n");
+    if (!(headerFlags & HeaderFlag::UESR_AGENT))
+        obs.write_bytes("User-Agent: yasio-http\r\n");
 
-            if (!(headerFlags & HeaderFlag::ACCEPT))
-                obs.write_bytes("Accept: */*;q=0.8\r\n");
+    if (!(headerFlags & HeaderFlag::ACCEPT))
+        obs.write_bytes("Accept: */*;q=0.8\r\n");
 
-            if (usePostData)
-            {
-                if (!(headerFlags & HeaderFlag::CONTENT_TYPE))
-                    obs.write_bytes("Content-Type: application/x-www-form-urlencoded;charset=UTF-8\r\n");
-
-                char strContentLength[128] = {0};
-                auto requestData           = request->getRequestData();
-                auto requestDataSize       = request->getRequestDataSize();
-                snprintf(strContentLength, sizeof(strContentLength), "Content-Length: %d\r\n\r\n",
-                         static_cast<int>(requestDataSize));
-                obs.write_bytes(strContentLength);
-
-                if (requestData && requestDataSize > 0)
-                    obs.write_bytes(cxx17::string_view{requestData, static_cast<size_t>(requestDataSize)});
-            }
-            else
-            {
-                obs.write_bytes("\r\n");
-            }
+    // HTTP/1.1 connections are persistent unless told otherwise
+    if (!(headerFlags & HeaderFlag::CONNECTION) && !_keepAliveEnabled)
+        obs.write_bytes("Connection: close\r\n");
 
-            _service->write(event->transport(), std::move(obs.buffer()));
+    if (usePostData)
+    {
+        if (!(headerFlags & HeaderFlag::CONTENT_TYPE))
+            obs.write_bytes("Content-Type: application/x-www-form-urlencoded;charset=UTF-8\r\n");
+
+        char strContentLength[128] = {0};
+        auto requestData           = request->getRequestData();
+        auto requestDataSize       = request->getRequestDataSize();
+        snprintf(strContentLength, sizeof(strContentLength), "Content-Length: %d\r\n\r\n",
+                 static_cast<int>(requestDataSize));
+        obs.write_bytes(strContentLength);
+
+        if (requestData && requestDataSize > 0)
+            obs.write_bytes(cxx17::string_view{requestData, static_cast<size_t>(requestDataSize)});
+    }
+    else
+    {
+        obs.write_bytes("\r\n");
+    }
+
+    _service->write(transport, std::move(obs.buffer()));
+}
+
+void HttpClient::startReadTimer(int channelIndex)
+{
+    auto& timerForRead = _service->channel_at(channelIndex)->get_user_timer();
+    timerForRead.cancel();
+    timerForRead.expires_from_now(std::chrono::seconds(this->_timeoutForRead));
+    timerForRead.async_wait([this, channelIndex](io_service& s) {
+        auto& conn = _connections[channelIndex];
+        if (!conn.responses.empty())
+            conn.responses.front()->updateInternalCode(yasio::errc::read_timeout);
+        conn.closing = true;
+        s.close(channelIndex);  // timeout
+        return true;
+    });
+}
 
-            auto& timerForRead = channel->get_user_timer();
-            timerForRead.cancel();
-            timerForRead.expires_from_now(std::chrono::seconds(this->_timeoutForRead));
-            timerForRead.async_wait([=](io_service& s) {
-                response->updateInternalCode(yasio::errc::read_timeout);
-                s.close(channelIndex);  // timeout
-                return true;
-            });
+void HttpClient::startIdleTimer(int channelIndex)
+{
+    auto& timerForIdle = _service->channel_at(channelIndex)->get_user_timer();
+    timerForIdle.cancel();
+    timerForIdle.expires_from_now(std::chrono::seconds(this->_keepAliveTimeout));
+    timerForIdle.async_wait([this, channelIndex](io_service& s) {
+        auto& conn = _connections[channelIndex];
+        if (conn.responses.empty())
+        {
+            conn.closing = true;
+            s.close(channelIndex);
+        }
+        return true;
+    });
+}
+
+void HttpClient::handleNetworkEvent(yasio::io_event* event)
+{
+    int channelIndex = event->cindex();
+    auto& conn       = _connections[channelIndex];
+    assert(!conn.key.empty());
+
+    switch (event->kind())
+    {
+    case YEK_ON_PACKET:
+    {
+        auto&& pkt = event->packet_view();
+        handleNetworkInput(channelIndex, pkt.data(), pkt.size());
+        break;
+    }
+    case YEK_ON_OPEN:
+        if (event->status() == 0)
+        {
+            conn.transport = event->transport();
+            for (auto response : conn.responses)
+                writeRequest(conn.transport, response);
+            startReadTimer(channelIndex);
         }
         else
         {
-            handleNetworkEOF(response, channel, event->status());
+            handleNetworkClose(channelIndex, event->status());
         }
         break;
     case YEK_ON_CLOSE:
-        handleNetworkEOF(response, channel, event->status());
+        handleNetworkClose(channelIndex, event->status());
         break;
     }
 }
 
-void HttpClient::handleNetworkEOF(HttpResponse* response, yasio::io_channel* channel, int internalErrorCode)
+void HttpClient::handleNetworkInput(int channelIndex, const char* data, size_t len)
+{
+    auto& conn         = _connections[channelIndex];
+    bool anyFinished   = false;
+    while (len > 0 && !conn.responses.empty())
+    {
+        auto response = conn.responses.front();
+        auto consumed = response->handleInput(data, len);
+        conn.bytesReceived += consumed;
+        data += consumed;
+        len -= consumed;
+        if (!response->isFinished())
+            break;
+
+        conn.responses.pop_front();
+        conn.bytesReceived = 0;
+        ++conn.requestsServed;
+        anyFinished = true;
+
+        if (!_keepAliveEnabled || !response->shouldKeepAlive())
+            conn.closing = true;  // remaining pipelined requests are resent on close
+
+        response->updateInternalCode(yasio::errc::eof);
+        handleNetworkEOF(response);
+    }
+
+    // bytes nobody asked for, the connection is out of sync
+    if (len > 0)
+        conn.closing = true;
+
+    if (conn.closing)
+        _service->close(channelIndex);
+    else if (anyFinished)
+    {
+        if (conn.responses.empty())
+            startIdleTimer(channelIndex);
+        else
+            startReadTimer(channelIndex);
+        dispatchPendingResponses();
+    }
+}
+
+void HttpClient::handleNetworkClose(int channelIndex, int internalErrorCode)
 {
-    channel->ud_.ptr = nullptr;
+    auto& conn = _connections[channelIndex];
+    _service->channel_at(channelIndex)->get_user_timer().cancel();
+
+    std::deque<HttpResponse*> responses;
+    responses.swap(conn.responses);
+    const bool reused           = conn.requestsServed > 0;
+    const size_t bytesReceived  = conn.bytesReceived;
+    conn.key.clear();
+    conn.transport      = nullptr;
+    conn.bytesReceived  = 0;
+    conn.requestsServed = 0;
+    conn.closing        = false;
+
+    // recycle channel
+    _availChannelQueue.push_front(channelIndex);
+
+    if (!responses.empty())
+    {
+        // pipelined requests which got no answer are resent in their original order
+        for (auto it = responses.rbegin(); it != std::prev(responses.rend()); ++it)
+            _pendingResponseQueue.push_front(*it);
+
+        // the server may drop an idle connection at the moment we reuse it, retry once on a new one
+        auto response = responses.front();
+        if (reused && bytesReceived == 0 && response->getInternalCode() == 0)
+            _pendingResponseQueue.push_front(response);
+        else
+        {
+            response->handleEOF();
+            response->updateInternalCode(internalErrorCode);
+            handleNetworkEOF(response);
+        }
+    }
 
-    channel->get_user_timer().cancel();
-    response->updateInternalCode(internalErrorCode);
+    // try process pending response
+    dispatchPendingResponses();
+}
+
+void HttpClient::handleNetworkEOF(HttpResponse* response)
+{
     auto responseCode = response->getResponseCode();
     switch (responseCode)
     {
@@ -409,28 +664,11 @@ void HttpClient::handleNetworkEOF(HttpResponse* response, yasio::io_channel* cha
     case 307:
         if (response->tryRedirect())
         {
-            processResponse(response, channel->index());
-            response->release();
+            _pendingResponseQueue.push_front(response);
             break;
         }
     default:
         finishResponse(response);
-
-        // try process pending response
-        auto lck = _pendingResponseQueue.get_lock();
-        if (!_pendingResponseQueue.unsafe_empty())
-        {
-            auto pendingResponse = _pendingResponseQueue.unsafe_front();
-            _pendingResponseQueue.unsafe_pop_front();
-            lck.unlock();
-
-            processResponse(pendingResponse, channel->index());
-            pendingResponse->release();
-        }
-        else
-        {  // recycle channel
-            _availChannelQueue.push_front(channel->index());
-        }
     }
 }
 
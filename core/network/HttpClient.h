@@ -32,6 +32,7 @@
 #include <thread>
 #include <condition_variable>
 #include <deque>
+#include <atomic>
 
 #include "base/Scheduler.h"
 #include "network/HttpRequest.h"
@@ -150,6 +151,47 @@ public:
      */
     int getTimeoutForRead();
 
+    /**
+     * Enable or disable persistent connections, enabled by default.
+     * Connections are keyed by scheme, host and port, an idle one is reused by
+     * the next request to the same origin instead of opening a new connection.
+     *
+     * @since axmol-2.2
+     */
+    void setKeepAliveEnabled(bool enabled);
+    bool isKeepAliveEnabled() const { return _keepAliveEnabled; }
+
+    /**
+     * Set how many seconds an idle persistent connection is kept open, 30 by default.
+     *
+     * @since axmol-2.2
+     */
+    void setKeepAliveTimeout(int seconds);
+    int getKeepAliveTimeout() const { return _keepAliveTimeout; }
+
+    /**
+     * Set how many GET requests may be in flight on one persistent connection.
+     * 1 by default, which disables pipelining.
+     *
+     * @since axmol-2.2
+     */
+    void setPipeliningDepth(int depth);
+    int getPipeliningDepth() const { return _pipeliningDepth; }
+
+    /**
+     * Close all idle persistent connections.
+     *
+     * @since axmol-2.2
+     */
+    void closeIdleConnections();
+
+    /**
+     * Get how many connections were opened since the HttpClient was created.
+     *
+     * @since axmol-2.2
+     */
+    unsigned int getOpenedConnectionCount() const { return _openedConnectionCount; }
+
     HttpCookie* getCookie() const { return _cookie; }
 
     std::recursive_mutex& getCookieFileMutex() { return _cookieFileMutex; }
@@ -201,13 +243,42 @@ private:
     HttpClient();
     virtual ~HttpClient();
 
-    void processResponse(HttpResponse* response, int channelIndex);
+    /* A persistent connection, owned by the network thread */
+    struct Connection
+    {
+        std::string key;  // scheme://host:port, empty while the channel is free
+        yasio::transport_handle_t transport = nullptr;
+        std::deque<HttpResponse*> responses;  // in-flight responses, in request order
+        size_t bytesReceived = 0;             // bytes received for the front response
+        int requestsServed   = 0;
+        bool closing         = false;
+    };
+
+    void schedulePendingResponses();
+
+    void dispatchPendingResponses();
+
+    bool dispatchResponse(HttpResponse* response, int& closingConnections);
+
+    void openConnection(int channelIndex, std::string key, HttpResponse* response);
+
+    void enqueueRequest(int channelIndex, HttpResponse* response);
+
+    void writeRequest(yasio::transport_handle_t transport, HttpResponse* response);
+
+    void startReadTimer(int channelIndex);
+
+    void startIdleTimer(int channelIndex);
 
     int tryTakeAvailChannel();
 
     void handleNetworkEvent(yasio::io_event* event);
 
-    void handleNetworkEOF(HttpResponse* response, yasio::io_channel* channel, int internalErrorCode);
+    void handleNetworkInput(int channelIndex, const char* data, size_t len);
+
+    void handleNetworkClose(int channelIndex, int internalErrorCode);
+
+    void handleNetworkEOF(HttpResponse* response);
 
     void tickInput();
 
@@ -235,6 +306,14 @@ private:
 
     ConcurrentDeque<int> _availChannelQueue;
 
+    Connection _connections[MAX_CHANNELS];
+
+    std::atomic<bool> _keepAliveEnabled;
+    std::atomic<int> _keepAliveTimeout;
+    std::atomic<int> _pipeliningDepth;
+    std::atomic<unsigned int> _openedConnectionCount;
+    std::atomic<bool> _dispatchScheduled;
+
     std::string _cookieFilename;
     std::recursive_mutex _cookieFileMutex;
 
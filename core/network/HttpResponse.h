@@ -144,15 +144,37 @@ private:
      */
     bool isFinished() const { return _finished; }
 
-    void handleInput(const char* d, size_t n)
+    /**
+     * Feed received bytes to the parser, returns how many of them belong to this response.
+     * The parser pauses at the end of the message, so any trailing bytes are the next
+     * pipelined response on the same connection.
+     */
+    size_t handleInput(const char* d, size_t n)
     {
         enum llhttp_errno err = llhttp_execute(&_context, d, n);
         if (err != HPE_OK)
         {
             _finished = true;
+            if (err == HPE_PAUSED)
+                return static_cast<size_t>(llhttp_get_error_pos(&_context) - d);
         }
+        return n;
     }
 
+    /**
+     * The connection was closed by peer, completes responses whose body is delimited by EOF.
+     */
+    void handleEOF()
+    {
+        if (!_finished)
+            llhttp_finish(&_context);
+    }
+
+    /**
+     * Whether the connection can be reused after this response completed.
+     */
+    bool shouldKeepAlive() const { return _responseCode != -1 && llhttp_should_keep_alive(&_context); }
+
     bool tryRedirect()
     {
         if ((_redirectCount < HttpRequest::MAX_REDIRECT_COUNT))
@@ -261,7 +283,7 @@ private:
         auto thiz           = (HttpResponse*)context->data;
         thiz->_responseCode = context->status_code;
         thiz->_finished     = true;
-        return 0;
+        return HPE_PAUSED;
     }
 
 protected:
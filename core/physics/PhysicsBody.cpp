@@ -111,6 +111,9 @@ PhysicsBody::PhysicsBody()
     , _recordedAngle(0.0)
     , _recordScaleX(1.f)
     , _recordScaleY(1.f)
+    , _syncedAngle(0.0)
+    , _synced(false)
+    , _previousAngle(0.0)
     , _fixedUpdate(false)
 {
     _name = COMPONENT_NAME;
@@ -923,6 +926,11 @@ void PhysicsBody::beforeSimulation(const Mat4& parentToWorldTransform,
                                    float scaleY,
                                    float rotation)
 {
+    // the node wasn't moved since the last sync, the body keeps its simulated state
+    if (_synced && std::equal(std::begin(nodeToWorldTransform.m), std::end(nodeToWorldTransform.m),
+                              std::begin(_syncedTransform.m)))
+        return;
+
     if (_recordScaleX != scaleX || _recordScaleY != scaleY)
     {
         _recordScaleX = scaleX;
@@ -951,13 +959,29 @@ void PhysicsBody::beforeSimulation(const Mat4& parentToWorldTransform,
         _offset.x = worldPosition.x - _owner->getPositionX();
         _offset.y = worldPosition.y - _owner->getPositionY();
     }
+
+    _syncedTransform  = nodeToWorldTransform;
+    _syncedAngle      = cpBodyGetAngle(_cpBody);
+    _synced           = true;
+    _previousPosition = getPosition();
+    _previousAngle    = _syncedAngle;
 }
 
-void PhysicsBody::afterSimulation(const Mat4& parentToWorldTransform, float parentRotation)
+void PhysicsBody::afterSimulation(const Mat4& parentToWorldTransform, float parentRotation, float interpolation)
 {
+    auto position = getPosition();
+    auto angle    = cpBodyGetAngle(_cpBody);
+    if (interpolation < 1.f)
+    {
+        position = _previousPosition.lerp(position, interpolation);
+        angle    = _previousAngle + (angle - _previousAngle) * interpolation;
+    }
+
+    if (_recordPosX == position.x && _recordPosY == position.y && _syncedAngle == angle)
+        return;
+
     // set Node position
-    auto tmp = getPosition();
-    Vec3 positionInParent(tmp.x, tmp.y, 0.f);
+    Vec3 positionInParent(position.x, position.y, 0.f);
     if (_recordPosX != positionInParent.x || _recordPosY != positionInParent.y)
     {
         parentToWorldTransform.getInversed().transformVector(positionInParent.x, positionInParent.y, positionInParent.z,
@@ -965,8 +989,31 @@ void PhysicsBody::afterSimulation(const Mat4& parentToWorldTransform, float pare
         _owner->setPosition(positionInParent.x - _offset.x, positionInParent.y - _offset.y);
     }
 
-    // set Node rotation
-    _owner->setRotation(getRotation() - parentRotation);
+    // set Node rotation, recorded like setRotation() does, so that beforeSimulation() sees the user changing it back
+    float rotation    = -angle * 180.0 / M_PI - _rotationOffset;
+    _recordedAngle    = angle;
+    _recordedRotation = rotation;
+    _owner->setRotation(rotation - parentRotation);
+
+    // record what the node shows now, so that the next beforeSimulation() leaves the body alone
+    auto& nodeToParentTransform = _owner->getNodeToParentTransform();
+    if (_owner->getAnchorPoint() != Vec2::ANCHOR_MIDDLE)
+    {
+        Vec3 center;
+        nodeToParentTransform.transformPoint(_ownerCenterOffset, &center);
+        _offset.x = center.x - _owner->getPositionX();
+        _offset.y = center.y - _owner->getPositionY();
+    }
+    _syncedTransform = parentToWorldTransform * nodeToParentTransform;
+    _syncedAngle     = angle;
+    _recordPosX      = position.x;
+    _recordPosY      = position.y;
+}
+
+void PhysicsBody::recordFixedStep()
+{
+    _previousPosition = getPosition();
+    _previousAngle    = cpBodyGetAngle(_cpBody);
 }
 
 void PhysicsBody::onEnter()
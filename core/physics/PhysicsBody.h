@@ -568,7 +568,8 @@ protected:
                           float scaleX,
                           float scaleY,
                           float rotation);
-    void afterSimulation(const Mat4& parentToWorldTransform, float parentRotation);
+    void afterSimulation(const Mat4& parentToWorldTransform, float parentRotation, float interpolation);
+    void recordFixedStep();
 
 protected:
     std::vector<PhysicsJoint*> _joints;
@@ -613,6 +614,15 @@ protected:
     float _recordPosX;
     float _recordPosY;
 
+    // the owner's node to world transform and the body angle when they were last synced, either way
+    Mat4 _syncedTransform;
+    double _syncedAngle;
+    bool _synced;
+
+    // the body at the previous fixed step, rendered transforms are interpolated from it
+    Vec2 _previousPosition;
+    double _previousAngle;
+
     // fixed update state
     bool _fixedUpdate;
 
@@ -559,7 +559,8 @@ void PhysicsWorld::addBody(PhysicsBody* body)
 
     addBodyOrDelay(body);
     _bodies.pushBack(body);
-    body->_world = this;
+    body->_world  = this;
+    body->_synced = false;
     body->setFixedUpdate(_fixedRate > 0);
 }
 
@@ -933,8 +934,7 @@ void PhysicsWorld::update(float delta, bool userCall /* = false*/)
         updateBodies();
     }
 
-    auto sceneToWorldTransform = _scene->getNodeToParentTransform();
-    beforeSimulation(_scene, sceneToWorldTransform, 1.f, 1.f, 0.f);
+    beforeSimulation();
 
     if (!_delayAddJoints.empty() || !_delayRemoveJoints.empty())
     {
@@ -966,6 +966,8 @@ void PhysicsWorld::update(float delta, bool userCall /* = false*/)
                 _updateTime -= step;
                 for (auto&& body : _bodies)
                 {
+                    if (_interpolationEnabled)
+                        body->recordFixedStep();
                     body->fixedUpdate(dt);
                 }
                 _scene->fixedUpdate(dt);
@@ -1001,9 +1003,7 @@ void PhysicsWorld::update(float delta, bool userCall /* = false*/)
         debugDraw();
     }
 
-    // Update physics position, should loop as the same sequence as node tree.
-    // PhysicsWorld::afterSimulation() will depend on the sequence.
-    afterSimulation(_scene, sceneToWorldTransform, 0.f);
+    afterSimulation(!userCall && _fixedRate && _interpolationEnabled ? _updateTime * _fixedRate : 1.f);
 
     if (_postUpdateCallback)
         _postUpdateCallback();  // fix #11154
@@ -1031,6 +1031,7 @@ PhysicsWorld::PhysicsWorld()
     , _updateTime(0.0f)
     , _substeps(1)
     , _fixedRate(0)
+    , _interpolationEnabled(false)
     , _cpSpace(nullptr)
     , _updateBodyTransform(false)
     , _scene(nullptr)
@@ -1055,41 +1056,68 @@ PhysicsWorld::~PhysicsWorld()
     AX_SAFE_RELEASE_NULL(_debugDraw);
 }
 
-void PhysicsWorld::beforeSimulation(Node* node,
-                                    const Mat4& parentToWorldTransform,
-                                    float nodeParentScaleX,
-                                    float nodeParentScaleY,
-                                    float parentRotation)
+const PhysicsWorld::NodeToWorld* PhysicsWorld::getParentToWorld(Node* node)
 {
-    auto scaleX   = nodeParentScaleX * node->getScaleX();
-    auto scaleY   = nodeParentScaleY * node->getScaleY();
-    auto rotation = parentRotation + node->getRotation();
+    if (node == _scene)
+        return &_sceneParentToWorld;
+
+    auto parent = node->getParent();
+    if (!parent)
+        return nullptr;
+
+    auto it = _nodeToWorldCache.find(parent);
+    if (it != _nodeToWorldCache.end())
+        return &it->second;
+
+    auto grandParentToWorld = getParentToWorld(parent);
+    if (!grandParentToWorld)
+        return nullptr;
+
+    auto& parentToWorld     = _nodeToWorldCache[parent];
+    parentToWorld.transform = grandParentToWorld->transform * parent->getNodeToParentTransform();
+    parentToWorld.scaleX    = grandParentToWorld->scaleX * parent->getScaleX();
+    parentToWorld.scaleY    = grandParentToWorld->scaleY * parent->getScaleY();
+    parentToWorld.rotation  = grandParentToWorld->rotation + parent->getRotation();
+    return &parentToWorld;
+}
 
-    auto nodeToWorldTransform = parentToWorldTransform * node->getNodeToParentTransform();
+void PhysicsWorld::beforeSimulation()
+{
+    // only the ancestors of the bodies are visited, the parent of the scene is the scene itself as it always was
+    _sceneParentToWorld = {_scene->getNodeToParentTransform(), 1.f, 1.f, 0.f};
+    _nodeToWorldCache.clear();
 
-    auto physicsBody = node->getPhysicsBody();
-    if (physicsBody)
+    for (auto&& body : _bodies)
     {
-        physicsBody->beforeSimulation(parentToWorldTransform, nodeToWorldTransform, scaleX, scaleY, rotation);
-    }
+        auto owner         = body->getOwner();
+        auto parentToWorld = owner ? getParentToWorld(owner) : nullptr;
+        if (!parentToWorld)
+            continue;
 
-    for (auto&& child : node->getChildren())
-        beforeSimulation(child, nodeToWorldTransform, scaleX, scaleY, rotation);
+        body->beforeSimulation(parentToWorld->transform, parentToWorld->transform * owner->getNodeToParentTransform(),
+                               parentToWorld->scaleX * owner->getScaleX(), parentToWorld->scaleY * owner->getScaleY(),
+                               parentToWorld->rotation + owner->getRotation());
+    }
 }
 
-void PhysicsWorld::afterSimulation(Node* node, const Mat4& parentToWorldTransform, float parentRotation)
+void PhysicsWorld::afterSimulation(float interpolation)
 {
-    auto nodeToWorldTransform = parentToWorldTransform * node->getNodeToParentTransform();
-    auto nodeRotation         = parentRotation + node->getRotation();
+    // the parents are resolved before any node is moved, like the scene graph walk this replaced did
+    _sceneParentToWorld = {_scene->getNodeToParentTransform(), 1.f, 1.f, 0.f};
+    _nodeToWorldCache.clear();
 
-    auto physicsBody = node->getPhysicsBody();
-    if (physicsBody)
+    _bodyParentsToWorld.clear();
+    for (auto&& body : _bodies)
     {
-        physicsBody->afterSimulation(parentToWorldTransform, parentRotation);
+        auto owner = body->getOwner();
+        _bodyParentsToWorld.push_back(owner ? getParentToWorld(owner) : nullptr);
     }
 
-    for (auto&& child : node->getChildren())
-        afterSimulation(child, nodeToWorldTransform, nodeRotation);
+    for (ssize_t i = 0; i < _bodies.size(); ++i)
+    {
+        if (auto parentToWorld = _bodyParentsToWorld[i])
+            _bodies.at(i)->afterSimulation(parentToWorld->transform, parentToWorld->rotation, interpolation);
+    }
 }
 
 void PhysicsWorld::setPostUpdateCallback(const std::function<void()>& callback)
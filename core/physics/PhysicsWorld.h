@@ -31,6 +31,7 @@
 #if defined(AX_ENABLE_PHYSICS)
 
 #    include <list>
+#    include <unordered_map>
 #    include "base/Vector.h"
 #    include "math/Math.h"
 #    include "physics/PhysicsBody.h"
@@ -342,6 +343,16 @@ public:
     /** get the number of substeps */
     int getFixedUpdateRate() const { return _fixedRate; }
 
+    /**
+     * Blend the transforms of the nodes between the last two fixed steps, by the time left until the next one.
+     * The nodes are rendered up to one fixed step behind the simulation, but move smoothly at low fixed update rates.
+     * Only used with a fixed update rate, default value is false.
+     */
+    void setInterpolationEnabled(bool enabled) { _interpolationEnabled = enabled; }
+
+    /** Whether the transforms of the nodes are interpolated between fixed steps. */
+    bool isInterpolationEnabled() const { return _interpolationEnabled; }
+
     /**
      * Set the debug draw mask of this physics world.
      *
@@ -427,6 +438,7 @@ protected:
     float _updateTime;
     int _substeps;
     int _fixedRate;
+    bool _interpolationEnabled;
     cpSpace* _cpSpace;
 
     bool _updateBodyTransform;
@@ -452,12 +464,24 @@ protected:
     PhysicsWorld();
     virtual ~PhysicsWorld();
 
-    void beforeSimulation(Node* node,
-                          const Mat4& parentToWorldTransform,
-                          float nodeParentScaleX,
-                          float nodeParentScaleY,
-                          float parentRotation);
-    void afterSimulation(Node* node, const Mat4& parentToWorldTransform, float parentRotation);
+    struct NodeToWorld
+    {
+        Mat4 transform;
+        float scaleX;
+        float scaleY;
+        float rotation;
+    };
+
+    // the parent transforms of the bodies' owners, shared by siblings, nullptr if the owner isn't in the scene
+    const NodeToWorld* getParentToWorld(Node* node);
+
+    void beforeSimulation();
+    void afterSimulation(float interpolation);
+
+    // cleared by each simulation pass
+    std::unordered_map<Node*, NodeToWorld> _nodeToWorldCache;
+    NodeToWorld _sceneParentToWorld;
+    std::vector<const NodeToWorld*> _bodyParentsToWorld;
 
     friend class Node;
     friend class Sprite;
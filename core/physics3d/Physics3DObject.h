@@ -58,6 +58,14 @@ class Physics3DObject;
  */
 struct AX_DLL Physics3DCollisionInfo
 {
+    /** Whether the objects started touching in this step, kept touching or stopped touching. */
+    enum class ContactState
+    {
+        BEGIN,
+        PERSIST,
+        END,  // collisionPointList is empty
+    };
+
     struct CollisionPoint
     {
         Vec3 localPositionOnA;
@@ -70,6 +78,7 @@ struct AX_DLL Physics3DCollisionInfo
     Physics3DObject* objA;
     Physics3DObject* objB;
     std::vector<CollisionPoint> collisionPointList;
+    ContactState state = ContactState::BEGIN;
 };
 /**
  * @brief Inherit from Object, base class
@@ -27,6 +27,8 @@
 #include "physics3d/Physics3D.h"
 #include "renderer/Renderer.h"
 
+#include <algorithm>
+
 #if defined(AX_ENABLE_3D_PHYSICS)
 
 #    if (AX_ENABLE_BULLET_INTEGRATION)
@@ -38,6 +40,7 @@ Physics3DWorld::Physics3DWorld()
     : _needCollisionChecking(false)
     , _collisionCheckingFlag(false)
     , _needGhostPairCallbackChecking(false)
+    , _numContacts(0)
     , _btPhyiscsWorld(nullptr)
     , _collisionConfiguration(nullptr)
     , _dispatcher(nullptr)
@@ -159,6 +162,7 @@ void Physics3DWorld::removePhysics3DObject(Physics3DObject* physicsObj)
         {
             _btPhyiscsWorld->removeCollisionObject(static_cast<Physics3DCollider*>(physicsObj)->getGhostObject());
         }
+        removeContactPairs(physicsObj);
         physicsObj->release();
         _objects.erase(it);
         _collisionCheckingFlag         = true;
@@ -181,6 +185,7 @@ void Physics3DWorld::removeAllPhysics3DObjects()
         it->release();
     }
     _objects.clear();
+    _contactPairs.clear();
     _collisionCheckingFlag         = true;
     _needGhostPairCallbackChecking = true;
 }
@@ -274,6 +279,8 @@ void Physics3DWorld::stepSimulate(float dt)
         }
         if (needCollisionChecking())
             collisionChecking();
+        else
+            _contactPairs.clear();
     }
 }
 
@@ -330,24 +337,41 @@ bool Physics3DWorld::sweepShape(Physics3DShape* shape,
 
 Physics3DObject* Physics3DWorld::getPhysicsObject(const btCollisionObject* btObj)
 {
-    for (auto&& it : _objects)
-    {
-        if (it->getObjType() == Physics3DObject::PhysicsObjType::RIGID_BODY)
-        {
-            if (static_cast<Physics3DRigidBody*>(it)->getRigidBody() == btObj)
-                return it;
-        }
-        else if (it->getObjType() == Physics3DObject::PhysicsObjType::COLLIDER)
-        {
-            if (static_cast<Physics3DCollider*>(it)->getGhostObject() == btObj)
-                return it;
-        }
-    }
-    return nullptr;
+    // set by Physics3DRigidBody and Physics3DCollider
+    return btObj ? static_cast<Physics3DObject*>(btObj->getUserPointer()) : nullptr;
+}
+
+void Physics3DWorld::setContactCallback(const ContactCallbackFunc& func)
+{
+    _contactCallback       = func;
+    _collisionCheckingFlag = true;
+}
+
+void Physics3DWorld::removeContactPairs(Physics3DObject* physicsObj)
+{
+    // so that no END contact is reported for a released object
+    std::erase_if(_contactPairs, [physicsObj](const ContactPair& pair) {
+        return pair.objA == physicsObj || pair.objB == physicsObj;
+    });
 }
 
 void Physics3DWorld::collisionChecking()
 {
+    // pairs are ordered by their objects regardless of which one is body0 of the manifold
+    auto pairLess = [](const ContactPair& lhs, const ContactPair& rhs) {
+        return std::minmax(lhs.objA, lhs.objB) < std::minmax(rhs.objA, rhs.objB);
+    };
+    auto nextContact = [this]() -> Physics3DCollisionInfo& {
+        if (_numContacts == _contacts.size())
+            _contacts.emplace_back();
+        auto& ci = _contacts[_numContacts++];
+        ci.collisionPointList.clear();
+        return ci;
+    };
+
+    _numContacts = 0;
+    _stepContactPairs.clear();
+
     int numManifolds = _dispatcher->getNumManifolds();
     for (int i = 0; i < numManifolds; ++i)
     {
@@ -355,43 +379,88 @@ void Physics3DWorld::collisionChecking()
         int numContacts                       = contactManifold->getNumContacts();
         if (0 < numContacts)
         {
-            const btCollisionObject* obA = static_cast<const btCollisionObject*>(contactManifold->getBody0());
-            const btCollisionObject* obB = static_cast<const btCollisionObject*>(contactManifold->getBody1());
-            Physics3DObject* poA         = getPhysicsObject(obA);
-            Physics3DObject* poB         = getPhysicsObject(obB);
-            if (poA->needCollisionCallback() || poB->needCollisionCallback())
+            Physics3DObject* poA = getPhysicsObject(contactManifold->getBody0());
+            Physics3DObject* poB = getPhysicsObject(contactManifold->getBody1());
+            if (!poA || !poB ||
+                (!_contactCallback && !poA->needCollisionCallback() && !poB->needCollisionCallback()))
+                continue;
+
+            auto& ci = nextContact();
+            ci.objA  = poA;
+            ci.objB  = poB;
+            ci.state = Physics3DCollisionInfo::ContactState::PERSIST;
+            for (int c = 0; c < numContacts; ++c)
             {
-                Physics3DCollisionInfo ci;
-                ci.objA = poA;
-                ci.objB = poB;
-                for (int c = 0; c < numContacts; ++c)
-                {
-                    btManifoldPoint& pt                       = contactManifold->getContactPoint(c);
-                    Physics3DCollisionInfo::CollisionPoint cp = {
-                        convertbtVector3ToVec3(pt.m_localPointA), convertbtVector3ToVec3(pt.m_positionWorldOnA),
-                        convertbtVector3ToVec3(pt.m_localPointB), convertbtVector3ToVec3(pt.m_positionWorldOnB),
-                        convertbtVector3ToVec3(pt.m_normalWorldOnB)};
-                    ci.collisionPointList.emplace_back(cp);
-                }
-
-                if (poA->needCollisionCallback())
-                {
-                    poA->getCollisionCallback()(ci);
-                }
-                if (poB->needCollisionCallback())
-                {
-                    poB->getCollisionCallback()(ci);
-                }
+                btManifoldPoint& pt = contactManifold->getContactPoint(c);
+                ci.collisionPointList.push_back(
+                    {convertbtVector3ToVec3(pt.m_localPointA), convertbtVector3ToVec3(pt.m_positionWorldOnA),
+                     convertbtVector3ToVec3(pt.m_localPointB), convertbtVector3ToVec3(pt.m_positionWorldOnB),
+                     convertbtVector3ToVec3(pt.m_normalWorldOnB)});
             }
+            _stepContactPairs.push_back({poA, poB, _numContacts - 1});
         }
     }
+
+    // compare with the pairs of the last step, both sorted, to find the ones which begin and end
+    std::sort(_stepContactPairs.begin(), _stepContactPairs.end(), pairLess);
+    size_t numPairs = _contactPairs.size();
+    for (size_t cur = 0, last = 0; cur < _stepContactPairs.size() || last < numPairs;)
+    {
+        if (last == numPairs ||
+            (cur < _stepContactPairs.size() && pairLess(_stepContactPairs[cur], _contactPairs[last])))
+        {
+            _contacts[_stepContactPairs[cur++].contactIndex].state = Physics3DCollisionInfo::ContactState::BEGIN;
+        }
+        else if (cur == _stepContactPairs.size() || pairLess(_contactPairs[last], _stepContactPairs[cur]))
+        {
+            auto& pair = _contactPairs[last++];
+            auto& ci   = nextContact();
+            ci.objA    = pair.objA;
+            ci.objB    = pair.objB;
+            ci.state   = Physics3DCollisionInfo::ContactState::END;
+        }
+        else
+        {
+            // the same pair may have several manifolds
+            auto& pair = _stepContactPairs[cur];
+            while (cur < _stepContactPairs.size() && !pairLess(pair, _stepContactPairs[cur]))
+                ++cur;
+            ++last;
+        }
+    }
+    _stepContactPairs.erase(std::unique(_stepContactPairs.begin(), _stepContactPairs.end(),
+                                        [&pairLess](const ContactPair& lhs, const ContactPair& rhs) {
+                                            return !pairLess(lhs, rhs);
+                                        }),
+                            _stepContactPairs.end());
+    _contactPairs.swap(_stepContactPairs);
+
+    // the objects only receive touching pairs, as they always did
+    for (size_t i = 0; i < _numContacts; ++i)
+    {
+        const auto& ci = _contacts[i];
+        if (ci.state == Physics3DCollisionInfo::ContactState::END)
+            continue;
+
+        if (ci.objA->needCollisionCallback())
+        {
+            ci.objA->getCollisionCallback()(ci);
+        }
+        if (ci.objB->needCollisionCallback())
+        {
+            ci.objB->getCollisionCallback()(ci);
+        }
+    }
+
+    if (_contactCallback && _numContacts)
+        _contactCallback(std::span<const Physics3DCollisionInfo>(_contacts.data(), _numContacts));
 }
 
 bool Physics3DWorld::needCollisionChecking()
 {
     if (_collisionCheckingFlag)
     {
-        _needCollisionChecking = false;
+        _needCollisionChecking = _contactCallback != nullptr;
         for (auto&& it : _objects)
         {
             if (it->getCollisionCallback() != nullptr)
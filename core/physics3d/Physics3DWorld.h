@@ -30,6 +30,11 @@
 #include "math/Math.h"
 #include "base/Object.h"
 #include "base/Config.h"
+#include "physics3d/Physics3DObject.h"
+
+#include <functional>
+#include <span>
+#include <vector>
 
 #if defined(AX_ENABLE_3D_PHYSICS)
 
@@ -88,6 +93,8 @@ public:
         Physics3DObject* hitObj;
     };
 
+    typedef std::function<void(std::span<const Physics3DCollisionInfo> contacts)> ContactCallbackFunc;
+
     /**
      * Creates a Physics3DWorld with Physics3DWorldDes.
      *
@@ -131,6 +138,16 @@ public:
     /** Internal method, the updater of debug drawing, need called each frame. */
     void debugDraw(ax::Renderer* renderer);
 
+    /**
+     * Set the callback receiving all the contacts of a step at once, after the collision callbacks of the objects.
+     * Besides the touching pairs, which begin or persist, it receives the pairs which stopped touching with
+     * ContactState::END. The contacts are only valid during the callback.
+     */
+    void setContactCallback(const ContactCallbackFunc& func);
+
+    /** Get the contact callback function. */
+    const ContactCallbackFunc& getContactCallback() const { return _contactCallback; }
+
     /** Get the list of Physics3DObjects. */
     const std::vector<Physics3DObject*>& getPhysicsObjects() const { return _objects; }
 
@@ -153,6 +170,7 @@ public:
 
     bool init(Physics3DWorldDes* info);
 
+    /** Get the Physics3DObject owning a bullet object, O(1). */
     Physics3DObject* getPhysicsObject(const btCollisionObject* btObj);
 
     void collisionChecking();
@@ -161,6 +179,14 @@ public:
 
 protected:
     void removePhysics3DConstraintFromBullet(Physics3DConstraint* constraint);
+    void removeContactPairs(Physics3DObject* physicsObj);
+
+    struct ContactPair
+    {
+        Physics3DObject* objA;
+        Physics3DObject* objB;
+        size_t contactIndex;
+    };
 
     std::vector<Physics3DObject*> _objects;
     std::vector<Physics3DConstraint*> _constraints;
@@ -169,6 +195,12 @@ protected:
     bool _collisionCheckingFlag;
     bool _needGhostPairCallbackChecking;
 
+    std::vector<ContactPair> _contactPairs;        // the touching pairs of the last step, sorted
+    std::vector<ContactPair> _stepContactPairs;    // the touching pairs of the current step
+    std::vector<Physics3DCollisionInfo> _contacts;  // reused for every step, _numContacts of them are valid
+    size_t _numContacts;
+    ContactCallbackFunc _contactCallback;
+
 #        if (AX_ENABLE_BULLET_INTEGRATION)
     btDynamicsWorld* _btPhyiscsWorld;
     btDefaultCollisionConfiguration* _collisionConfiguration;
@@ -547,6 +547,47 @@ void FileUtils::purgeCachedEntries()
     _fullPathCacheDir.clear();
 }
 
+bool FileUtils::loadResourceIndex(std::string_view indexFile)
+{
+    std::string indexPath{indexFile};
+    if (!isAbsolutePath(indexPath))
+        indexPath.insert(0, _defaultResRootPath);
+
+    std::string content;
+    if (getContents(indexPath, &content) != Status::OK)
+    {
+        AXLOGW("FileUtils: failed to load resource index {}", indexPath);
+        return false;
+    }
+
+    hlookup::string_set index;
+    std::string_view lines{content};
+    while (!lines.empty())
+    {
+        auto eol  = lines.find('\n');
+        auto line = lines.substr(0, eol);
+        lines.remove_prefix(eol == std::string_view::npos ? lines.size() : eol + 1);
+
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (!line.empty() && line[0] != '#')
+            index.emplace(line);
+    }
+
+    DECLARE_GUARD;
+    _resourceIndex = std::move(index);
+    _fullPathCache.clear();
+    _fullPathCacheDir.clear();
+    return !_resourceIndex.empty();
+}
+
+void FileUtils::unloadResourceIndex()
+{
+    DECLARE_GUARD;
+    _resourceIndex.clear();
+    _fullPathCache.clear();
+}
+
 std::string FileUtils::getStringFromFile(std::string_view filename) const
 {
     std::string s;
@@ -683,17 +724,27 @@ std::string FileUtils::fullPathForFilename(std::string_view filename) const
     }
 
     // Already Cached ?
-    auto cacheIter = _fullPathCache.find(filename);
-    if (cacheIter != _fullPathCache.end())
+    std::string fullpath;
+    if (_fullPathCache.find(filename, fullpath))
     {
-        return cacheIter->second;
+        return fullpath;
     }
 
-    std::string fullpath;
-
+    // paths with dot segments are left to the file system, the index only holds normalized paths
+    const bool useIndex = !_resourceIndex.empty() && filename.find("./") == std::string_view::npos;
     for (const auto& searchIt : _searchPathArray)
     {
-        fullpath = this->getPathForFilename(filename, searchIt);
+        if (useIndex && searchIt.starts_with(_defaultResRootPath))
+        {
+            auto relativePath = std::string_view{searchIt}.substr(_defaultResRootPath.length());
+            fullpath.assign(relativePath).append(filename);
+            if (_resourceIndex.find(fullpath) != _resourceIndex.end())
+                fullpath.insert(0, _defaultResRootPath);
+            else
+                fullpath.clear();
+        }
+        else
+            fullpath = this->getPathForFilename(filename, searchIt);
 
         if (!fullpath.empty())
         {
@@ -729,12 +780,7 @@ std::string FileUtils::fullPathForDirectory(std::string_view dir) const
     else
     {
         // Already Cached ?
-        auto cacheIter = _fullPathCacheDir.find(dir);
-        if (cacheIter != _fullPathCacheDir.end())
-        {
-            result = cacheIter->second;
-        }
-        else
+        if (!_fullPathCacheDir.find(dir, result))
         {
             std::string longdir{dir};
 
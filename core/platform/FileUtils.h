@@ -36,6 +36,7 @@ THE SOFTWARE.
 
 #include "platform/IFileStream.h"
 #include "platform/PlatformMacros.h"
+#include "platform/PathCache.h"
 #include "base/Types.h"
 #include "base/Value.h"
 #include "base/Data.h"
@@ -767,10 +768,27 @@ public:
                                            std::function<void(std::vector<std::string>)> callback) const;
 #endif
     /** Returns the full path cache. */
-    const hlookup::string_map<std::string> getFullPathCache() const { return _fullPathCache; }
+    const hlookup::string_map<std::string> getFullPathCache() const { return _fullPathCache.toMap(); }
 
     /** Returns the full path cache. */
-    const hlookup::string_map<std::string> getFullPathCacheDir() const { return _fullPathCacheDir; }
+    const hlookup::string_map<std::string> getFullPathCacheDir() const { return _fullPathCacheDir.toMap(); }
+
+    /**
+     * Loads an index of the files under the default resource root path, one path relative to the root per line,
+     * as generated at build time by 1k/genpathindex.ps1.
+     * While an index is loaded, relative file lookups in search paths under the default resource root are answered
+     * from the index instead of probing the file system, so the index must list every packaged file.
+     * Should be called on the main thread before any asset loading threads are started.
+     * @param indexFile The index file, a relative path is resolved against the default resource root path.
+     * @return true if the index was loaded.
+     */
+    bool loadResourceIndex(std::string_view indexFile);
+
+    /** Unloads the resource index, lookups probe the file system again. */
+    void unloadResourceIndex();
+
+    /** Checks whether a resource index is loaded. */
+    bool isResourceIndexLoaded() const { return !_resourceIndex.empty(); }
 
     /**
      *  Checks whether a file exists without considering search paths and resolution orders.
@@ -863,15 +881,20 @@ protected:
 
     /**
      *  The full path cache for normal files. When a file is found, it will be added into this cache.
-     *  This variable is used for improving the performance of file search.
+     *  This variable is used for improving the performance of file search, lookups are lock-free.
      */
-    mutable hlookup::string_map<std::string> _fullPathCache;
+    mutable PathCache _fullPathCache;
 
     /**
      *  The full path cache for directories. When a diretory is found, it will be added into this cache.
-     *  This variable is used for improving the performance of file search.
+     *  This variable is used for improving the performance of file search, lookups are lock-free.
+     */
+    mutable PathCache _fullPathCacheDir;
+
+    /**
+     *  The files under the default resource root path, see loadResourceIndex.
      */
-    mutable hlookup::string_map<std::string> _fullPathCacheDir;
+    hlookup::string_set _resourceIndex;
 
     /**
      * Writable path.
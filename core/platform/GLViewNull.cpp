@@ -0,0 +1,76 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "platform/GLViewNull.h"
+#include "renderer/backend/DriverBase.h"
+
+namespace ax
+{
+
+GLViewNull* GLViewNull::create(std::string_view viewName)
+{
+    return GLViewNull::createWithRect(viewName, ax::Rect(0, 0, 960, 640));
+}
+
+GLViewNull* GLViewNull::createWithRect(std::string_view viewName, const ax::Rect& rect, float frameZoomFactor)
+{
+    auto ret = new GLViewNull;
+    if (ret->initWithRect(viewName, rect, frameZoomFactor))
+    {
+        ret->autorelease();
+        return ret;
+    }
+    AX_SAFE_DELETE(ret);
+    return nullptr;
+}
+
+bool GLViewNull::initWithRect(std::string_view viewName, const ax::Rect& rect, float frameZoomFactor)
+{
+    backend::DriverBase::setDriverType(backend::DriverType::Null);
+    if (backend::DriverBase::getDriverType() != backend::DriverType::Null)
+    {
+        AXLOGE("GLViewNull: the null render driver is unavailable");
+        return false;
+    }
+
+    setViewName(viewName);
+
+    _frameZoomFactor = frameZoomFactor;
+
+    Vec2 frameSize = rect.size * frameZoomFactor;
+    setFrameSize(frameSize.width, frameSize.height);
+
+    return true;
+}
+
+void GLViewNull::end()
+{
+    _shouldClose = true;
+
+    // Release self, same as the windowed views
+    release();
+}
+
+}  // namespace ax
@@ -0,0 +1,84 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "platform/GLView.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/**
+ * @brief A windowless view for headless runs, i.e. CPU-side benchmarks and CI.
+ * Creating it selects the null render driver, so it must happen before any other GLView
+ * is attached to the Director. Requires a build with AX_ENABLE_NULL_DRIVER.
+ */
+class AX_DLL GLViewNull : public GLView
+{
+public:
+    static GLViewNull* create(std::string_view viewName);
+    static GLViewNull* createWithRect(std::string_view viewName, const Rect& rect, float frameZoomFactor = 1.0f);
+
+    /* override functions */
+    bool isOpenGLReady() override { return true; }
+    void end() override;
+    void swapBuffers() override {}
+    void setIMEKeyboardState(bool /*open*/) override {}
+    bool windowShouldClose() override { return _shouldClose; }
+
+    float getFrameZoomFactor() const override { return _frameZoomFactor; }
+
+#if (AX_TARGET_PLATFORM == AX_PLATFORM_WIN32)
+    HWND getWin32Window() override { return nullptr; }
+#endif /* (AX_TARGET_PLATFORM == AX_PLATFORM_WIN32) */
+
+#if (AX_TARGET_PLATFORM == AX_PLATFORM_MAC)
+    void* getCocoaWindow() override { return nullptr; }
+    void* getNSGLContext() override { return nullptr; }
+#endif /* (AX_TARGET_PLATFORM == AX_PLATFORM_MAC) */
+
+#if (AX_TARGET_PLATFORM == AX_PLATFORM_LINUX)
+    void* getX11Window() override { return nullptr; }
+    void* getX11Display() override { return nullptr; }
+#endif /* (AX_TARGET_PLATFORM == AX_PLATFORM_LINUX) */
+
+protected:
+    GLViewNull() = default;
+
+    bool initWithRect(std::string_view viewName, const Rect& rect, float frameZoomFactor);
+
+    float _frameZoomFactor = 1.0f;
+    bool _shouldClose      = false;
+};
+
+// end of platform group
+/// @}
+
+}  // namespace ax
@@ -27,6 +27,7 @@ THE SOFTWARE.
 
 #include "platform/Image.h"
 #include "renderer/backend/PixelFormatUtils.h"
+#include "renderer/backend/PixelKernels.h"
 
 #include <string>
 #include <ctype.h>
@@ -2592,23 +2593,11 @@ void Image::premultiplyAlpha()
              || (_pixelFormat == backend::PixelFormat::RG8),
               "The pixel format should be RGBA8888 or RG88.");
 
-    if (_pixelFormat ==  backend::PixelFormat::RGBA8) {
-        unsigned int* fourBytes = (unsigned int*)_data;
-        for (int i = 0; i < _width * _height; i++)
-        {
-            uint8_t* p   = _data + i * 4;
-            fourBytes[i] = AX_RGB_PREMULTIPLY_ALPHA(p[0], p[1], p[2], p[3]);
-        }
-    }
+    const size_t pixelCount = static_cast<size_t>(_width) * _height;
+    if (_pixelFormat == backend::PixelFormat::RGBA8)
+        backend::PixelKernels::getKernels().premultiplyAlphaRGBA8(_data, pixelCount);
     else
-    {
-        uint16_t* twoBytes = (uint16_t*)_data;
-        for (int i = 0; i < _width * _height; i++)
-        {
-            uint8_t* p   = _data + i * 2;
-            twoBytes[i] = ((p[0] * p[1] + 1) >> 8) | (p[1] << 8);
-        }
-    }
+        backend::PixelKernels::getKernels().premultiplyAlphaRG8(_data, pixelCount);
 
     _hasPremultipliedAlpha = true;
 #else
@@ -2616,26 +2605,11 @@ void Image::premultiplyAlpha()
 #endif
 }
 
-static inline uint8_t clamp(int x)
-{
-    return (uint8_t)(x >= 0 ? (x < 255 ? x : 255) : 0);
-}
-
 void Image::reversePremultipliedAlpha()
 {
     AXASSERT(_pixelFormat == backend::PixelFormat::RGBA8, "The pixel format should be RGBA8888!");
 
-    unsigned int* fourBytes = (unsigned int*)_data;
-    for (int i = 0; i < _width * _height; i++)
-    {
-        uint8_t* p = _data + i * 4;
-        if (p[3] > 0)
-        {
-            fourBytes[i] = clamp(int(std::ceil((p[0] * 255.0f) / p[3]))) |
-                           clamp(int(std::ceil((p[1] * 255.0f) / p[3]))) << 8 |
-                           clamp(int(std::ceil((p[2] * 255.0f) / p[3]))) << 16 | p[3] << 24;
-        }
-    }
+    backend::PixelKernels::getKernels().reversePremultipliedAlphaRGBA8(_data, static_cast<size_t>(_width) * _height);
 
     _hasPremultipliedAlpha = false;
 }
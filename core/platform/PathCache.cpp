@@ -0,0 +1,228 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "platform/PathCache.h"
+
+#include <thread>
+#include <vector>
+
+namespace ax
+{
+
+static constexpr size_t kInitialCapacity = 256;
+
+// spreads the threads over the reader slots, so concurrent lookups don't write to the same cache line
+static size_t threadIndex()
+{
+    static std::atomic<size_t> nextIndex{0};
+    thread_local size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+struct PathCache::Entry
+{
+    size_t hash;
+    std::string key;
+    std::string value;
+};
+
+struct PathCache::Table
+{
+    explicit Table(size_t capacity) : slots(new std::atomic<const Entry*>[capacity]), mask(capacity - 1)
+    {
+        for (size_t i = 0; i < capacity; ++i)
+            slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+    std::unique_ptr<std::atomic<const Entry*>[]> slots;
+    size_t mask;
+};
+
+struct PathCache::Generation
+{
+    Generation() { table.store(tables.emplace_back(std::make_unique<Table>(kInitialCapacity)).get()); }
+
+    std::atomic<Table*> table;
+    std::atomic<size_t> count{0};
+
+    // owned by the writer, outgrown tables stay alive for concurrent lookups
+    std::vector<std::unique_ptr<Table>> tables;
+    std::vector<std::unique_ptr<Entry>> entries;
+};
+
+PathCache::PathCache() : _current(std::make_unique<Generation>())
+{
+    _generation.store(_current.get());
+}
+
+PathCache::~PathCache() {}
+
+const PathCache::Entry* PathCache::findEntry(const Generation* gen, std::string_view key, size_t hash)
+{
+    // the table is at most half full, so probing always ends at an empty slot
+    auto table = gen->table.load(std::memory_order_acquire);
+    for (size_t i = hash & table->mask;; i = (i + 1) & table->mask)
+    {
+        auto entry = table->slots[i].load(std::memory_order_acquire);
+        if (!entry)
+            return nullptr;
+        if (entry->hash == hash && entry->key == key)
+            return entry;
+    }
+}
+
+const PathCache::Generation* PathCache::acquireGeneration(std::atomic<size_t>*& readers) const
+{
+    auto& slot = _readerSlots[threadIndex() % kReaderSlots];
+    for (;;)
+    {
+        // seq_cst pairs with clear(): either the writer sees this reader under the epoch before its flip, or this
+        // reader sees the flip and the generation published before it
+        auto epoch = _epoch.load();
+        readers    = &slot.readers[epoch & 1];
+        readers->fetch_add(1);
+        if (_epoch.load() == epoch)
+            return _generation.load();
+        readers->fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void PathCache::releaseGeneration(std::atomic<size_t>* readers)
+{
+    readers->fetch_sub(1, std::memory_order_release);
+}
+
+bool PathCache::reclaimRetired()
+{
+    if (!_retired)
+        return true;
+
+    // the retired generation was current before the last epoch flip, lookups starting since can't reach it
+    const auto parity = (_epoch.load(std::memory_order_relaxed) - 1) & 1;
+    for (auto& slot : _readerSlots)
+    {
+        if (slot.readers[parity].load() != 0)
+            return false;
+    }
+    _retired.reset();
+    return true;
+}
+
+void PathCache::insertEntry(Table* table, const Entry* entry)
+{
+    size_t i = entry->hash & table->mask;
+    while (table->slots[i].load(std::memory_order_relaxed))
+        i = (i + 1) & table->mask;
+    table->slots[i].store(entry, std::memory_order_release);
+}
+
+bool PathCache::find(std::string_view key, std::string& value) const
+{
+    std::atomic<size_t>* readers;
+    auto entry = findEntry(acquireGeneration(readers), key, std::hash<std::string_view>{}(key));
+    if (entry)
+        value = entry->value;
+    releaseGeneration(readers);
+    return entry != nullptr;
+}
+
+bool PathCache::contains(std::string_view key) const
+{
+    std::atomic<size_t>* readers;
+    auto entry = findEntry(acquireGeneration(readers), key, std::hash<std::string_view>{}(key));
+    releaseGeneration(readers);
+    return entry != nullptr;
+}
+
+void PathCache::emplace(std::string_view key, std::string_view value)
+{
+    const auto hash = std::hash<std::string_view>{}(key);
+
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    reclaimRetired();
+
+    auto gen = _current.get();
+    if (findEntry(gen, key, hash))
+        return;
+
+    auto table = gen->table.load(std::memory_order_relaxed);
+    if ((gen->entries.size() + 1) * 2 > table->capacity())
+    {
+        auto grown = gen->tables.emplace_back(std::make_unique<Table>(table->capacity() * 2)).get();
+        for (auto& entry : gen->entries)
+            insertEntry(grown, entry.get());
+        gen->table.store(grown, std::memory_order_release);
+        table = grown;
+    }
+
+    auto entry = gen->entries.emplace_back(new Entry{hash, std::string{key}, std::string{value}}).get();
+    insertEntry(table, entry);
+    gen->count.store(gen->entries.size(), std::memory_order_relaxed);
+}
+
+void PathCache::clear()
+{
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    if (!_current->entries.empty())
+    {
+        // the generation retired by the previous clear() only waits for the lookups it had in flight, which end
+        // quickly, so that the retired generation is always the one of the previous epoch
+        while (!reclaimRetired())
+            std::this_thread::yield();
+
+        _retired = std::move(_current);
+        _current = std::make_unique<Generation>();
+        _generation.store(_current.get());
+        _epoch.fetch_add(1);
+    }
+    reclaimRetired();
+}
+
+size_t PathCache::size() const
+{
+    std::atomic<size_t>* readers;
+    auto count = acquireGeneration(readers)->count.load(std::memory_order_relaxed);
+    releaseGeneration(readers);
+    return count;
+}
+
+hlookup::string_map<std::string> PathCache::toMap() const
+{
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    hlookup::string_map<std::string> result;
+    for (auto& entry : _current->entries)
+        result.emplace(entry->key, entry->value);
+    return result;
+}
+
+bool PathCache::isReclaimPending() const
+{
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    return _retired != nullptr;
+}
+
+}  // namespace ax
@@ -0,0 +1,114 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "platform/PlatformMacros.h"
+#include "base/hlookup.h"
+
+namespace ax
+{
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/**
+ * @class PathCache
+ * A read-mostly string to string map used by FileUtils to cache resolved paths.
+ *
+ * Lookups take no lock and don't allocate: entries are immutable once published into an insert-only open
+ * addressing table, which is swapped for a larger copy when it gets half full. Inserts are serialized by a mutex.
+ *
+ * clear() publishes an empty generation, retires the previous one and starts a new epoch. Lookups announce themselves
+ * under the epoch they start in, in a slot of their thread padded to its own cache line. The retired generation is
+ * freed by the writer once no lookup of the previous epoch is in flight: lookups of the new epoch can only reach the
+ * current generation, so it doesn't take a moment without any lookup.
+ */
+class AX_DLL PathCache
+{
+public:
+    PathCache();
+    ~PathCache();
+
+    PathCache(const PathCache&)            = delete;
+    PathCache& operator=(const PathCache&) = delete;
+
+    /** Copies the cached value of key to value, returns false when key isn't cached. */
+    bool find(std::string_view key, std::string& value) const;
+
+    bool contains(std::string_view key) const;
+
+    /** Caches value for key, an existing entry is kept as is. */
+    void emplace(std::string_view key, std::string_view value);
+
+    void clear();
+
+    size_t size() const;
+
+    /** Returns a copy of all entries. */
+    hlookup::string_map<std::string> toMap() const;
+
+    /** Returns whether a cleared generation still waits for the lookups in flight to be freed. */
+    bool isReclaimPending() const;
+
+private:
+    struct Entry;
+    struct Table;
+    struct Generation;
+
+    static const Entry* findEntry(const Generation* gen, std::string_view key, size_t hash);
+    static void insertEntry(Table* table, const Entry* entry);
+
+    // lookups in flight of the threads sharing the slot, by parity of the epoch they started in
+    struct alignas(64) ReaderSlot
+    {
+        std::atomic<size_t> readers[2]{};
+    };
+    static constexpr size_t kReaderSlots = 16;
+
+    const Generation* acquireGeneration(std::atomic<size_t>*& readers) const;
+    static void releaseGeneration(std::atomic<size_t>* readers);
+    bool reclaimRetired();
+
+    std::atomic<Generation*> _generation;
+    std::unique_ptr<Generation> _current;
+    std::unique_ptr<Generation> _retired;
+    std::atomic<size_t> _epoch{0};
+    mutable ReaderSlot _readerSlots[kReaderSlots];
+    mutable std::mutex _writeMutex;
+};
+
+// end of platform group
+/// @}
+
+}  // namespace ax
@@ -103,7 +103,15 @@ public:
 
     const Mat4& getMV() const { return _mv; }
 
+    /**
+     Get the key RenderQueue::sort ordered the command with: queue group, global Z or depth, then batching order.
+     Only valid for the commands of the sorted queue groups, until the next sort.
+     */
+    uint64_t getSortKey() const { return _sortKey; }
+
 protected:
+    friend class RenderQueue;
+
     /**Constructor.*/
     RenderCommand();
     /**Destructor.*/
@@ -117,6 +125,9 @@ protected:
     /** Commands are sort by global Z order. */
     float _globalOrder = 0.f;
 
+    /** Packed sort key written by RenderQueue::sort. */
+    uint64_t _sortKey = 0;
+
     /** Transparent flag. */
     bool _isTransparent = true;
 
@@ -42,6 +42,7 @@
 #include "base/EventDispatcher.h"
 #include "base/EventListenerCustom.h"
 #include "base/EventType.h"
+#include "base/Tracing.h"
 #include "2d/Camera.h"
 #include "2d/Scene.h"
 #include "xxhash.h"
@@ -53,14 +54,66 @@ namespace ax
 {
 
 // helper
-static bool compareRenderCommand(RenderCommand* a, RenderCommand* b)
-{
-    return a->getGlobalOrder() < b->getGlobalOrder();
-}
+// RenderCommand sort key: | queue group:3 | global Z or depth:32 | run:13 | material:16 |
+// A run is a sequence of batchable TrianglesCommands, every other command gets a run of its own so that commands
+// are only grouped by material between two of them.
+static constexpr int SORT_KEY_GROUP_SHIFT    = 61;
+static constexpr int SORT_KEY_ORDER_SHIFT    = 29;
+static constexpr int SORT_KEY_RUN_SHIFT      = 16;
+static constexpr uint32_t SORT_KEY_MAX_RUN   = (1u << 13) - 1;
+static constexpr uint32_t SORT_KEY_MATERIAL  = 0xFFFF;
+// Below that, the histograms cost more than std::stable_sort
+static constexpr size_t RADIX_SORT_THRESHOLD = 64;
+
+// Maps a float to an unsigned integer with the same ordering
+static inline uint32_t toSortableBits(float value)
+{
+    // -0 and +0 compare equal
+    if (value == 0.f)
+        return 0x80000000u;
+
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+// Stable LSD radix sort, one pass per key byte, skipping the bytes all keys share
+template <typename _Ty>
+static void radixSort(axstd::pod_vector<_Ty>& items, axstd::pod_vector<_Ty>& scratch)
+{
+    const auto count = items.size();
+    uint32_t histograms[sizeof(uint64_t)][256] = {};
+    for (auto& item : items)
+    {
+        for (int digit = 0; digit < (int)sizeof(uint64_t); ++digit)
+            ++histograms[digit][(item.key >> (digit * 8)) & 0xFF];
+    }
 
-static bool compare3DCommand(RenderCommand* a, RenderCommand* b)
-{
-    return a->getDepth() > b->getDepth();
+    scratch.resize(count);
+    auto src = items.data();
+    auto dst = scratch.data();
+    for (int digit = 0; digit < (int)sizeof(uint64_t); ++digit)
+    {
+        auto& histogram = histograms[digit];
+        const int shift = digit * 8;
+        if (histogram[(src[0].key >> shift) & 0xFF] == count)
+            continue;
+
+        uint32_t offset = 0;
+        for (auto& bucket : histogram)
+        {
+            auto bucketSize = bucket;
+            bucket          = offset;
+            offset += bucketSize;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+            dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+        std::swap(src, dst);
+    }
+
+    if (src != items.data())
+        memcpy(items.data(), src, count * sizeof(_Ty));
 }
 
 // queue
@@ -108,15 +161,74 @@ ssize_t RenderQueue::size() const
     return result;
 }
 
-void RenderQueue::sort()
+void RenderQueue::sort(bool byMaterial)
 {
     // Don't sort _queue0, it already comes sorted
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::TRANSPARENT_3D]),
-                     std::end(_commands[QUEUE_GROUP::TRANSPARENT_3D]), compare3DCommand);
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_NEG]), std::end(_commands[QUEUE_GROUP::GLOBALZ_NEG]),
-                     compareRenderCommand);
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_POS]), std::end(_commands[QUEUE_GROUP::GLOBALZ_POS]),
-                     compareRenderCommand);
+    sortGroup(QUEUE_GROUP::TRANSPARENT_3D, false);
+    sortGroup(QUEUE_GROUP::GLOBALZ_NEG, byMaterial);
+    sortGroup(QUEUE_GROUP::GLOBALZ_POS, byMaterial);
+    if (byMaterial)
+        sortGroup(QUEUE_GROUP::GLOBALZ_ZERO, true);
+}
+
+void RenderQueue::sortGroup(QUEUE_GROUP group, bool byMaterial)
+{
+    auto& commands = _commands[group];
+    if (commands.size() < 2)
+        return;
+
+    _sortItems.resize(commands.size());
+
+    const uint64_t groupKey = uint64_t(group) << SORT_KEY_GROUP_SHIFT;
+    uint32_t run            = 0;
+    bool sorted             = true;
+    uint64_t prevKey        = 0;
+    for (size_t i = 0; i < commands.size(); ++i)
+    {
+        auto command = commands[i];
+
+        uint64_t key = groupKey;
+        if (group == QUEUE_GROUP::TRANSPARENT_3D)  // back to front
+            key |= uint64_t(~toSortableBits(command->getDepth())) << SORT_KEY_ORDER_SHIFT;
+        else if (group != QUEUE_GROUP::GLOBALZ_ZERO)
+            key |= uint64_t(toSortableBits(command->getGlobalOrder())) << SORT_KEY_ORDER_SHIFT;
+
+        if (byMaterial)
+        {
+            uint32_t materialID = 0;
+            if (command->getType() == RenderCommand::Type::TRIANGLES_COMMAND && !command->isSkipBatching())
+                materialID = static_cast<TrianglesCommand*>(command)->getMaterialID();
+
+            if (materialID != Renderer::MATERIAL_ID_DO_NOT_BATCH)
+                key |= (uint64_t(run) << SORT_KEY_RUN_SHIFT) | (materialID & SORT_KEY_MATERIAL);
+            else
+            {
+                key |= uint64_t(++run) << SORT_KEY_RUN_SHIFT;
+                ++run;
+            }
+        }
+
+        sorted &= prevKey <= key;
+        prevKey           = key;
+        command->_sortKey = key;
+        _sortItems[i]     = {key, command};
+    }
+
+    // Too many commands splitting the runs, keep the scene graph order of equal global Z
+    if (run > SORT_KEY_MAX_RUN)
+        return sortGroup(group, false);
+
+    if (sorted)
+        return;
+
+    if (commands.size() < RADIX_SORT_THRESHOLD)
+        std::stable_sort(_sortItems.begin(), _sortItems.end(),
+                         [](const SortItem& a, const SortItem& b) { return a.key < b.key; });
+    else
+        radixSort(_sortItems, _sortScratch);
+
+    for (size_t i = 0; i < commands.size(); ++i)
+        commands[i] = _sortItems[i].command;
 }
 
 RenderCommand* RenderQueue::operator[](ssize_t index) const
@@ -199,9 +311,7 @@ Renderer::~Renderer()
 void Renderer::init()
 {
     // Should invoke _triangleCommandBufferManager.init() first.
-    _triangleCommandBufferManager.init();
-    _vertexBuffer = _triangleCommandBufferManager.getVertexBuffer();
-    _indexBuffer  = _triangleCommandBufferManager.getIndexBuffer();
+    setupBatchBuffers();
 
     auto driver    = backend::DriverBase::getInstance();
     _commandBuffer = driver->newCommandBuffer();
@@ -216,6 +326,58 @@ void Renderer::init()
     _commandBuffer->setDepthStencilState(_depthStencilState);
 }
 
+void Renderer::setBatchIndexFormat(backend::IndexFormat format)
+{
+    AXASSERT(!_isRendering, "Cannot change batch index format while rendering");
+    AXASSERT(format == backend::IndexFormat::U_SHORT || format == backend::IndexFormat::U_INT, "Invalid index format");
+
+    if (format == backend::IndexFormat::U_INT &&
+        !backend::DriverBase::getInstance()->checkForFeatureSupported(backend::FeatureType::ELEMENT_INDEX_UINT))
+    {
+        AXLOGW("Renderer: 32-bit indices not supported by device, batching with 16-bit indices");
+        format = backend::IndexFormat::U_SHORT;
+    }
+
+    if (_batchIndexFormat == format)
+        return;
+
+    _batchIndexFormat = format;
+
+    // The buffers haven't been created yet, Renderer::init will do it
+    if (_vertexBuffer)
+        setupBatchBuffers();
+}
+
+void Renderer::setupBatchBuffers()
+{
+    if (_batchIndexFormat == backend::IndexFormat::U_INT)
+    {
+        _batchIndexSize    = sizeof(uint32_t);
+        _batchVBOSize      = VBO_SIZE_U32;
+        _batchIndexVBOSize = INDEX_VBO_SIZE_U32;
+    }
+    else
+    {
+        _batchIndexSize    = sizeof(uint16_t);
+        _batchVBOSize      = VBO_SIZE;
+        _batchIndexVBOSize = INDEX_VBO_SIZE;
+    }
+
+#ifdef AX_USE_METAL
+    _verts.resize(_batchVBOSize);
+    _verts.shrink_to_fit();
+    _indices.resize(_batchIndexVBOSize * _batchIndexSize);
+    _indices.shrink_to_fit();
+#endif
+
+    _triangleCommandBufferManager.init(_batchVBOSize * sizeof(V3F_C4B_T2F), _batchIndexVBOSize * _batchIndexSize);
+    _vertexBuffer = _triangleCommandBufferManager.getVertexBuffer();
+    _indexBuffer  = _triangleCommandBufferManager.getIndexBuffer();
+
+    _queuedTotalIndexCount = _queuedTotalVertexCount = 0;
+    _queuedIndexCount = _queuedVertexCount = 0;
+}
+
 backend::RenderTarget* Renderer::getOffscreenRenderTarget() {
     if (_offscreenRT != nullptr) return _offscreenRT;
     return (_offscreenRT = backend::DriverBase::getInstance()->newRenderTarget());
@@ -299,18 +461,17 @@ void Renderer::processRenderCommand(RenderCommand* command)
         auto cmd = static_cast<TrianglesCommand*>(command);
 
         // flush own queue when buffer is full
-        if (_queuedTotalVertexCount + cmd->getVertexCount() > VBO_SIZE ||
-            _queuedTotalIndexCount + cmd->getIndexCount() > INDEX_VBO_SIZE)
+        if (_queuedTotalVertexCount + cmd->getVertexCount() > _batchVBOSize ||
+            _queuedTotalIndexCount + cmd->getIndexCount() > _batchIndexVBOSize)
         {
-            AXASSERT(cmd->getVertexCount() >= 0 && cmd->getVertexCount() < VBO_SIZE,
+            AXASSERT(cmd->getVertexCount() >= 0 && cmd->getVertexCount() < _batchVBOSize,
                      "VBO for vertex is not big enough, please break the data down or use customized render command");
-            AXASSERT(cmd->getIndexCount() >= 0 && cmd->getIndexCount() < INDEX_VBO_SIZE,
+            AXASSERT(cmd->getIndexCount() >= 0 && cmd->getIndexCount() < _batchIndexVBOSize,
                      "VBO for index is not big enough, please break the data down or use customized render command");
             drawBatchedTriangles();
 
             _queuedTotalIndexCount = _queuedTotalVertexCount = 0;
 #ifdef AX_USE_METAL
-            _queuedIndexCount = _queuedVertexCount = 0;
             _triangleCommandBufferManager.prepareNextBuffer();
             _vertexBuffer = _triangleCommandBufferManager.getVertexBuffer();
             _indexBuffer  = _triangleCommandBufferManager.getIndexBuffer();
@@ -319,10 +480,8 @@ void Renderer::processRenderCommand(RenderCommand* command)
 
         // queue it
         _queuedTriangleCommands.emplace_back(cmd);
-#ifdef AX_USE_METAL
         _queuedIndexCount += cmd->getIndexCount();
         _queuedVertexCount += cmd->getVertexCount();
-#endif
         _queuedTotalVertexCount += cmd->getVertexCount();
         _queuedTotalIndexCount += cmd->getIndexCount();
     }
@@ -404,15 +563,20 @@ void Renderer::doVisitRenderQueue(const std::vector<RenderCommand*>& renderComma
 
 void Renderer::render()
 {
+    AX_TRACE_ZONE("Renderer::render");
+
     // TODO: setup camera or MVP
     _isRendering = true;
     //    if (_glViewAssigned)
     {
         // Process render commands
         // 1. Sort render commands based on ID
-        for (auto&& renderqueue : _renderGroups)
         {
-            renderqueue.sort();
+            AX_TRACE_ZONE("Renderer::sort");
+            for (auto&& renderqueue : _renderGroups)
+            {
+                renderqueue.sort(_sortByMaterial);
+            }
         }
         visitRenderQueue(_renderGroups[0]);
     }
@@ -433,6 +597,9 @@ void Renderer::endFrame()
     _triangleCommandBufferManager.putbackAllBuffers();
     _vertexBuffer = _triangleCommandBufferManager.getVertexBuffer();
     _indexBuffer  = _triangleCommandBufferManager.getIndexBuffer();
+#else
+    _vertexBuffer->nextStreamFrame();
+    _indexBuffer->nextStreamFrame();
 #endif
     _queuedTotalIndexCount  = 0;
     _queuedTotalVertexCount = 0;
@@ -588,19 +755,30 @@ void Renderer::setViewPort(int x, int y, unsigned int w, unsigned int h)
     _viewport.height = h;
 }
 
-void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset)
+void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd,
+                                      unsigned int vertexBufferOffset,
+                                      V3F_C4B_T2F* vertices,
+                                      uint8_t* indices)
 {
-    auto destVertices = &_verts[_filledVertex];
+    auto destVertices = vertices + _filledVertex;
     auto srcVertices = cmd->getVertices();
     auto vertexCount = cmd->getVertexCount();
     auto&& modelView = cmd->getModelView();
     MathUtil::transformVertices(destVertices, srcVertices, vertexCount, modelView);
 
-    auto destIndices = &_indices[_filledIndex];
     auto srcIndices = cmd->getIndices();
     auto indexCount = cmd->getIndexCount();
     auto offset = vertexBufferOffset + _filledVertex;
-    MathUtil::transformIndices(destIndices, srcIndices, indexCount, int(offset));
+    if (_batchIndexFormat == backend::IndexFormat::U_INT)
+    {
+        auto destIndices = reinterpret_cast<uint32_t*>(indices) + _filledIndex;
+        MathUtil::transformIndices(destIndices, srcIndices, indexCount, uint32_t(offset));
+    }
+    else
+    {
+        auto destIndices = reinterpret_cast<uint16_t*>(indices) + _filledIndex;
+        MathUtil::transformIndices(destIndices, srcIndices, indexCount, uint16_t(offset));
+    }
 
     _filledVertex += vertexCount;
     _filledIndex += indexCount;
@@ -615,9 +793,28 @@ void Renderer::drawBatchedTriangles()
 #ifdef AX_USE_METAL
     unsigned int vertexBufferFillOffset = _queuedTotalVertexCount - _queuedVertexCount;
     unsigned int indexBufferFillOffset  = _queuedTotalIndexCount - _queuedIndexCount;
+    std::size_t vertexStreamOffset      = 0;
+    std::size_t indexStreamOffset       = 0;
+    auto vertices                       = _verts.data();
+    auto indices                        = _indices.data();
 #else
+    if (_queuedVertexCount == 0 || _queuedIndexCount == 0)
+    {
+        _queuedTriangleCommands.clear();
+        _queuedIndexCount = _queuedVertexCount = 0;
+        return;
+    }
+
+    // Write straight to the stream buffers: each flush gets its own region, so the driver doesn't have to
+    // wait for the previous draws reading the buffers
     unsigned int vertexBufferFillOffset = 0;
     unsigned int indexBufferFillOffset  = 0;
+    std::size_t vertexStreamOffset      = 0;
+    std::size_t indexStreamOffset       = 0;
+    auto vertices                       = static_cast<V3F_C4B_T2F*>(
+        _vertexBuffer->mapStream(_queuedVertexCount * sizeof(V3F_C4B_T2F), vertexStreamOffset));
+    auto indices =
+        static_cast<uint8_t*>(_indexBuffer->mapStream(_queuedIndexCount * _batchIndexSize, indexStreamOffset));
 #endif
 
     _triBatchesToDraw[0].offset        = indexBufferFillOffset;
@@ -636,7 +833,7 @@ void Renderer::drawBatchedTriangles()
         auto currentMaterialID = cmd->getMaterialID();
         const bool batchable   = !cmd->isSkipBatching();
 
-        fillVerticesAndIndices(cmd, vertexBufferFillOffset);
+        fillVerticesAndIndices(cmd, vertexBufferFillOffset, vertices, indices);
 
         // in the same batch ?
         if (batchable && (prevMaterialID == currentMaterialID || firstCommand))
@@ -677,18 +874,22 @@ void Renderer::drawBatchedTriangles()
     }
     batchesTotal++;
 #ifdef AX_USE_METAL
-    _vertexBuffer->updateSubData(_verts, vertexBufferFillOffset * sizeof(_verts[0]), _filledVertex * sizeof(_verts[0]));
-    _indexBuffer->updateSubData(_indices, indexBufferFillOffset * sizeof(_indices[0]),
-                                _filledIndex * sizeof(_indices[0]));
+    _vertexBuffer->updateSubData(_verts.data(), vertexBufferFillOffset * sizeof(_verts[0]),
+                                 _filledVertex * sizeof(_verts[0]));
+    _indexBuffer->updateSubData(_indices.data(), indexBufferFillOffset * _batchIndexSize,
+                                _filledIndex * _batchIndexSize);
+    _uploadedBytes += _filledVertex * sizeof(_verts[0]) + _filledIndex * _batchIndexSize;
 #else
-    _vertexBuffer->updateData(_verts, _filledVertex * sizeof(_verts[0]));
-    _indexBuffer->updateData(_indices, _filledIndex * sizeof(_indices[0]));
+    _vertexBuffer->unmapStream(_filledVertex * sizeof(V3F_C4B_T2F));
+    _indexBuffer->unmapStream(_filledIndex * _batchIndexSize);
+    gatherStreamStats(_vertexBuffer);
+    gatherStreamStats(_indexBuffer);
 #endif
 
     /************** 2: Draw *************/
     beginRenderPass();
 
-    _commandBuffer->setVertexBuffer(_vertexBuffer);
+    _commandBuffer->setVertexBuffer(_vertexBuffer, vertexStreamOffset);
     _commandBuffer->setIndexBuffer(_indexBuffer);
 
     for (int i = 0; i < batchesTotal; ++i)
@@ -697,8 +898,8 @@ void Renderer::drawBatchedTriangles()
         _commandBuffer->updatePipelineState(_currentRT, drawInfo.cmd->getPipelineDescriptor());
         auto& pipelineDescriptor = drawInfo.cmd->getPipelineDescriptor();
         _commandBuffer->setProgramState(pipelineDescriptor.programState);
-        _commandBuffer->drawElements(backend::PrimitiveType::TRIANGLE, backend::IndexFormat::U_SHORT,
-                                     drawInfo.indicesToDraw, drawInfo.offset * sizeof(_indices[0]));
+        _commandBuffer->drawElements(backend::PrimitiveType::TRIANGLE, _batchIndexFormat, drawInfo.indicesToDraw,
+                                     indexStreamOffset + drawInfo.offset * _batchIndexSize);
 
         _drawnBatches++;
         _drawnVertices += _triBatchesToDraw[i].indicesToDraw;
@@ -709,12 +910,23 @@ void Renderer::drawBatchedTriangles()
     /************** 3: Cleanup *************/
     _queuedTriangleCommands.clear();
 
-#ifdef AX_USE_METAL
     _queuedIndexCount  = 0;
     _queuedVertexCount = 0;
+#ifndef AX_USE_METAL
+    // Metal keeps filling the same buffers until the frame ends, each stream region starts over
+    _queuedTotalIndexCount  = 0;
+    _queuedTotalVertexCount = 0;
 #endif
 }
 
+void Renderer::gatherStreamStats(backend::Buffer* buffer)
+{
+    auto& stats = buffer->getStreamStats();
+    _uploadedBytes += stats.uploadedBytes;
+    _streamStalls += stats.stalls;
+    buffer->resetStreamStats();
+}
+
 void Renderer::drawCustomCommand(RenderCommand* command)
 {
     auto cmd = static_cast<CustomCommand*>(command);
@@ -786,38 +998,50 @@ void Renderer::flushTriangles()
 }
 
 // helpers
-bool Renderer::checkVisibility(const Mat4& transform, const Vec2& size)
+void CullingPlanes::init(const Mat4& mvp)
 {
-    auto director = Director::getInstance();
-    auto scene    = director->getRunningScene();
-
-    // If draw to Rendertexture, return true directly.
-    //  only cull the default camera. The culling algorithm is valid for default camera.
-    if (!scene || (scene && scene->_defaultCamera != Camera::getVisitingCamera()))
-        return true;
+    // rows of the column major matrix, a point is inside when -w <= x <= w and -w <= y <= w
+    const float* m = mvp.m;
+    for (int i = 0; i < 2; ++i)
+    {
+        planes[i * 2].set(m[3] + m[i], m[7] + m[4 + i], m[11] + m[8 + i], m[15] + m[12 + i]);
+        planes[i * 2 + 1].set(m[3] - m[i], m[7] - m[4 + i], m[11] - m[8 + i], m[15] - m[12 + i]);
+    }
+}
 
-    Rect visibleRect(director->getVisibleOrigin(), director->getVisibleSize());
+bool CullingPlanes::intersects(const Vec3& min, const Vec3& max) const
+{
+    const Vec3 center((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f);
+    const Vec3 extent((max.x - min.x) * 0.5f, (max.y - min.y) * 0.5f, (max.z - min.z) * 0.5f);
+    for (auto& p : planes)
+    {
+        // the box is outside when even its farthest corner is behind the plane
+        float d = p.x * center.x + p.y * center.y + p.z * center.z + p.w;
+        float r = fabsf(p.x) * extent.x + fabsf(p.y) * extent.y + fabsf(p.z) * extent.z;
+        if (d + r < 0)
+            return false;
+    }
+    return true;
+}
 
-    // transform center point to screen space
-    float hSizeX = size.width / 2;
-    float hSizeY = size.height / 2;
-    Vec3 v3p(hSizeX, hSizeY, 0);
-    transform.transformPoint(&v3p);
-    Vec2 v2p = Camera::getVisitingCamera()->projectGL(v3p);
+bool Renderer::checkVisibility(const Mat4& transform, const Vec2& size)
+{
+    auto& projection = Director::getInstance()->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
 
-    // convert content size to world coordinates
-    float wshw = std::max(fabsf(hSizeX * transform.m[0] + hSizeY * transform.m[4]),
-                          fabsf(hSizeX * transform.m[0] - hSizeY * transform.m[4]));
-    float wshh = std::max(fabsf(hSizeX * transform.m[1] + hSizeY * transform.m[5]),
-                          fabsf(hSizeX * transform.m[1] - hSizeY * transform.m[5]));
+    CullingPlanes culling;
+    culling.init(projection * transform);
+    return culling.intersects(Vec3::ZERO, Vec3(size.width, size.height, 0));
+}
 
-    // enlarge visible rect half size in screen coord
-    visibleRect.origin.x -= wshw;
-    visibleRect.origin.y -= wshh;
-    visibleRect.size.width += wshw * 2;
-    visibleRect.size.height += wshh * 2;
-    bool ret = visibleRect.containsPoint(v2p);
-    return ret;
+uint32_t Renderer::getCullingVersion()
+{
+    auto& projection = Director::getInstance()->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    if (memcmp(projection.m, _cullingMatrix.m, sizeof(_cullingMatrix.m)) != 0)
+    {
+        _cullingMatrix = projection;
+        ++_cullingVersion;
+    }
+    return _cullingVersion;
 }
 
 void Renderer::readPixels(backend::RenderTarget* rt,
@@ -950,17 +1174,30 @@ void Renderer::setScissorRect(float x, float y, float width, float height)
 
 // TriangleCommandBufferManager
 Renderer::TriangleCommandBufferManager::~TriangleCommandBufferManager()
+{
+    releaseBuffers();
+}
+
+void Renderer::TriangleCommandBufferManager::init(std::size_t vertexBufferSize, std::size_t indexBufferSize)
+{
+    releaseBuffers();
+
+    _vertexBufferSize = vertexBufferSize;
+    _indexBufferSize  = indexBufferSize;
+    createBuffer();
+}
+
+void Renderer::TriangleCommandBufferManager::releaseBuffers()
 {
     for (auto&& vertexBuffer : _vertexBufferPool)
         vertexBuffer->release();
+    _vertexBufferPool.clear();
 
     for (auto&& indexBuffer : _indexBufferPool)
         indexBuffer->release();
-}
+    _indexBufferPool.clear();
 
-void Renderer::TriangleCommandBufferManager::init()
-{
-    createBuffer();
+    _currentBufferIndex = 0;
 }
 
 void Renderer::TriangleCommandBufferManager::putbackAllBuffers()
@@ -994,17 +1231,18 @@ void Renderer::TriangleCommandBufferManager::createBuffer()
 {
     auto driver = backend::DriverBase::getInstance();
 
-    // Not initializing the buffer before passing it to updateData for Android/OpenGL ES.
-    // This change does fix the Android/OpenGL ES performance problem
-    // If for some reason we get reports of performance issues on OpenGL implementations,
-    // then we can just add pre-processor checks for OpenGL and have the updateData() allocate the full size after buffer creation.
-    auto vertexBuffer = driver->newBuffer(Renderer::VBO_SIZE * sizeof(_verts[0]), backend::BufferType::VERTEX,
-                                          backend::BufferUsage::DYNAMIC);
+#ifdef AX_USE_METAL
+    // Dynamic metal buffers already rotate MAX_INFLIGHT_BUFFER copies per frame
+    constexpr auto usage = backend::BufferUsage::DYNAMIC;
+#else
+    // Ring of MAX_INFLIGHT_BUFFER segments written through mapStream, see drawBatchedTriangles
+    constexpr auto usage = backend::BufferUsage::STREAM;
+#endif
+    auto vertexBuffer = driver->newBuffer(_vertexBufferSize, backend::BufferType::VERTEX, usage);
     if (!vertexBuffer)
         return;
 
-    auto indexBuffer = driver->newBuffer(Renderer::INDEX_VBO_SIZE * sizeof(_indices[0]), backend::BufferType::INDEX,
-                                         backend::BufferUsage::DYNAMIC);
+    auto indexBuffer = driver->newBuffer(_indexBufferSize, backend::BufferType::INDEX, usage);
     if (!indexBuffer)
     {
         vertexBuffer->release();
@@ -32,6 +32,7 @@
 #include <optional>
 
 #include "platform/PlatformMacros.h"
+#include "base/axstd.h"
 #include "renderer/RenderCommand.h"
 #include "renderer/backend/Types.h"
 #include "renderer/backend/ProgramManager.h"
@@ -99,8 +100,12 @@ public:
     void emplace_back(RenderCommand* command);
     /**Return the number of render commands.*/
     ssize_t size() const;
-    /**Sort the render commands.*/
-    void sort();
+    /**
+     Sort the render commands by their packed sort key, see RenderCommand::getSortKey.
+     @param byMaterial Also group the 2D commands of equal global Z by material, so that more of them are batched.
+     Commands which aren't batchable keep their relative order, see Renderer::setSortByMaterial.
+     */
+    void sort(bool byMaterial = false);
     /**Treat sorted commands as an array, access them one by one.*/
     RenderCommand* operator[](ssize_t index) const;
     /**Clear all rendered commands.*/
@@ -113,9 +118,21 @@ public:
     ssize_t getSubQueueSize(QUEUE_GROUP group) const { return _commands[group].size(); }
 
 protected:
+    struct SortItem
+    {
+        uint64_t key;
+        RenderCommand* command;
+    };
+
+    void sortGroup(QUEUE_GROUP group, bool byMaterial);
+
     /**The commands in the render queue.*/
     std::vector<RenderCommand*> _commands[QUEUE_COUNT];
 
+    /**Scratch buffers of sort, kept to avoid allocations every frame.*/
+    axstd::pod_vector<SortItem> _sortItems;
+    axstd::pod_vector<SortItem> _sortScratch;
+
     /**Cull state.*/
     bool _isCullEnabled;
     /**Depth test enable state.*/
@@ -126,6 +143,20 @@ protected:
 
 class GroupCommandManager;
 
+/**
+ * The left, right, bottom and top clip planes of a model view projection matrix,
+ * used to reject boxes which are outside of the render target.
+ * @since axmol-2.2
+ */
+struct AX_DLL CullingPlanes
+{
+    void init(const Mat4& mvp);
+    /** Whether the box [min, max] in model space may be visible */
+    bool intersects(const Vec3& min, const Vec3& max) const;
+
+    Vec4 planes[4];
+};
+
 /* Class responsible for the rendering in.
 
 Whenever possible prefer to use `TrianglesCommand` objects since the renderer will automatically batch them.
@@ -137,6 +168,10 @@ public:
     static const int VBO_SIZE = 65536;
     /**The max number of indices in a index buffer.*/
     static const int INDEX_VBO_SIZE = VBO_SIZE * 6 / 4;
+    /**The max number of vertices in a vertex buffer object when batching with 32-bit indices.*/
+    static const int VBO_SIZE_U32 = VBO_SIZE * 4;
+    /**The max number of indices in a index buffer when batching with 32-bit indices.*/
+    static const int INDEX_VBO_SIZE_U32 = VBO_SIZE_U32 * 6 / 4;
     /**The rendercommands which can be batched will be saved into a list, this is the reserved size of this list.*/
     static const int BATCH_TRIAGCOMMAND_RESERVED_SIZE = 64;
     /**Reserved for material id, which means that the command could not be batched.*/
@@ -183,8 +218,36 @@ public:
     ssize_t getDrawnVertices() const { return _drawnVertices; }
     /* RenderCommands (except) TrianglesCommand should update this value */
     void addDrawnVertices(ssize_t number) { _drawnVertices += number; };
+    /* returns the number of bytes written to the batch buffers in the last frame */
+    size_t getUploadedBytes() const { return _uploadedBytes; }
+    /* returns how many times the batcher waited for the GPU to release a stream buffer segment in the last frame */
+    size_t getStreamStalls() const { return _streamStalls; }
     /* clear draw stats */
-    void clearDrawStats() { _drawnBatches = _drawnVertices = 0; }
+    void clearDrawStats() { _drawnBatches = _drawnVertices = _uploadedBytes = _streamStalls = 0; }
+
+    /**
+     * Set the index format used to batch `TrianglesCommand` objects.
+     * With backend::IndexFormat::U_SHORT (the default) a batch is flushed every 65536 vertices,
+     * backend::IndexFormat::U_INT allows VBO_SIZE_U32 vertices per batch, so that large 2D scenes
+     * need fewer flushes and draw calls.
+     * Falls back to backend::IndexFormat::U_SHORT if the device can't draw with 32-bit indices.
+     * @note Can't be changed while rendering.
+     */
+    void setBatchIndexFormat(backend::IndexFormat format);
+
+    /** Get the index format used to batch `TrianglesCommand` objects. */
+    backend::IndexFormat getBatchIndexFormat() const { return _batchIndexFormat; }
+
+    /**
+     * Group the batchable `TrianglesCommand` objects of equal global Z by material, so that they are merged in fewer
+     * draw calls. Other commands, e.g. a RenderTexture's begin and end, still split the commands around them.
+     * Disabled by default: overlapping sprites with the same global Z may then be drawn in another order than
+     * the scene graph's.
+     */
+    void setSortByMaterial(bool enabled) { _sortByMaterial = enabled; }
+
+    /** Whether batchable commands of equal global Z are grouped by material. */
+    bool isSortByMaterial() const { return _sortByMaterial; }
 
     /**
      Set render targets. If not set, will use default render targets. It will effect all commands.
@@ -409,9 +472,19 @@ public:
 
     backend::CommandBuffer* getCommandBuffer() const { return _commandBuffer ; }
 
-    /** returns whether or not a rectangle is visible or not */
+    /**
+     * Returns whether or not a rectangle is visible, tested against the view projection on the top of
+     * the director projection stack, so it works for any camera and for RenderTexture targets.
+     */
     bool checkVisibility(const Mat4& transform, const Vec2& size);
 
+    /**
+     * Returns a number which changes whenever the view projection used by checkVisibility changes,
+     * nodes may keep their previous visibility while it and their transform are unchanged.
+     * @since axmol-2.2
+     */
+    uint32_t getCullingVersion();
+
     /** read pixels from RenderTarget or screen framebuffer */
     void readPixels(backend::RenderTarget* rt, std::function<void(const backend::PixelBufferDescriptor&)> callback);
 
@@ -435,9 +508,12 @@ protected:
 
         /**
          * Create a new vertex buffer and a index buffer and push it to cache.
+         * Any buffer created by a previous call is released.
+         * @param vertexBufferSize The size in bytes of each vertex buffer.
+         * @param indexBufferSize The size in bytes of each index buffer.
          * @note Should invoke firstly.
          */
-        void init();
+        void init(std::size_t vertexBufferSize, std::size_t indexBufferSize);
 
         /**
          * Reset avalable buffer index to zero.
@@ -457,8 +533,11 @@ protected:
 
     private:
         void createBuffer();
+        void releaseBuffers();
 
-        int _currentBufferIndex = 0;
+        int _currentBufferIndex       = 0;
+        std::size_t _vertexBufferSize = 0;
+        std::size_t _indexBufferSize  = 0;
         std::vector<backend::Buffer*> _vertexBufferPool;
         std::vector<backend::Buffer*> _indexBufferPool;
     };
@@ -485,7 +564,13 @@ protected:
     void visitRenderQueue(RenderQueue& queue);
     void doVisitRenderQueue(const std::vector<RenderCommand*>&);
 
-    void fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset);
+    void fillVerticesAndIndices(const TrianglesCommand* cmd,
+                                unsigned int vertexBufferOffset,
+                                V3F_C4B_T2F* vertices,
+                                uint8_t* indices);
+    void gatherStreamStats(backend::Buffer* buffer);
+
+    void setupBatchBuffers();
 
     void pushStateBlock();
 
@@ -497,6 +582,10 @@ protected:
     CullMode _cullMode = CullMode::NONE;
     Winding _winding   = Winding::COUNTER_CLOCK_WISE;  // default front face is CCW in GL
 
+    // view projection seen by the last getCullingVersion call
+    Mat4 _cullingMatrix      = Mat4::ZERO;
+    uint32_t _cullingVersion = 0;
+
     std::stack<int> _commandGroupStack;
 
     std::vector<RenderQueue> _renderGroups;
@@ -508,9 +597,14 @@ protected:
 
     std::vector<GroupCommand*> _groupCommandPool;
 
-    // for TrianglesCommand
-    V3F_C4B_T2F _verts[VBO_SIZE];
-    unsigned short _indices[INDEX_VBO_SIZE];
+    // for TrianglesCommand, staged on metal only, other backends write to the mapped stream buffers
+    axstd::pod_vector<V3F_C4B_T2F> _verts;
+    axstd::pod_vector<uint8_t> _indices;  // uint16_t or uint32_t depends on _batchIndexFormat
+    backend::IndexFormat _batchIndexFormat = backend::IndexFormat::U_SHORT;
+    bool _sortByMaterial                   = false;
+    unsigned int _batchIndexSize           = sizeof(uint16_t);
+    unsigned int _batchVBOSize             = VBO_SIZE;
+    unsigned int _batchIndexVBOSize        = INDEX_VBO_SIZE;
     backend::Buffer* _vertexBuffer = nullptr;
     backend::Buffer* _indexBuffer  = nullptr;
     TriangleCommandBufferManager _triangleCommandBufferManager;
@@ -543,6 +637,8 @@ protected:
     // stats
     size_t _drawnBatches  = 0;
     size_t _drawnVertices = 0;
+    size_t _uploadedBytes = 0;
+    size_t _streamStalls  = 0;
     // the flag for checking whether renderer is rendering
     bool _isRendering      = false;
     bool _isDepthTestFor2D = false;
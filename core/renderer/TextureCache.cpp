@@ -33,12 +33,14 @@ THE SOFTWARE.
 #include <stack>
 #include <cctype>
 #include <list>
+#include <chrono>
 
 #include "renderer/Texture2D.h"
 #include "base/Macros.h"
 #include "base/UTF8.h"
 #include "base/Director.h"
 #include "base/Scheduler.h"
+#include "base/Tracing.h"
 #include "platform/FileUtils.h"
 #include "base/Utils.h"
 #include "base/NinePatchImageParser.h"
@@ -63,109 +65,95 @@ std::string TextureCache::getETC1AlphaFileSuffix()
     return s_etc1AlphaFileSuffix;
 }
 
-TextureCache::TextureCache() : _loadingThread(nullptr), _needQuit(false), _asyncRefCount(0) {}
-
-TextureCache::~TextureCache()
-{
-    AXLOGD("deallocing TextureCache: {}", fmt::ptr(this));
-
-    for (auto&& texture : _textures)
-        texture.second->release();
-
-    AX_SAFE_DELETE(_loadingThread);
-}
-
-std::string TextureCache::getDescription() const
-{
-    return fmt::format("<TextureCache | Number of textures = {}>", static_cast<int>(_textures.size()));
-}
-
 struct TextureCache::AsyncStruct
 {
 public:
-    AsyncStruct(std::string_view fn, const std::function<void(Texture2D*)>& f, std::string_view key)
+    struct Callback
+    {
+        std::function<void(Texture2D*)> func;
+        std::string key;
+    };
+
+    AsyncStruct(std::string_view fn, int prio, uint64_t seq)
         : filename(fn)
-        , callback(f)
-        , callbackKey(key)
         , pixelFormat(Texture2D::getDefaultAlphaPixelFormat())
+        , priority(prio)
+        , sequence(seq)
         , loadSuccess(false)
     {}
 
     std::string filename;
-    std::function<void(Texture2D*)> callback;
-    std::string callbackKey;
+    // all the callbacks of the requests for this file, only accessed on the GL thread
+    std::vector<Callback> callbacks;
     Image image;
     Image imageAlpha;
     backend::PixelFormat pixelFormat;
+    // guarded by _requestMutex while the request is pending
+    int priority;
+    uint64_t sequence;
     bool loadSuccess;
 };
 
-/**
- The addImageAsync logic follow the steps:
- - find the image has been add or not, if not add an AsyncStruct to _requestQueue  (GL thread)
- - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to
- _responseQueue (Load thread)
- - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL
- thread)
-
- the Critical Area include these members:
- - _requestQueue: locked by _requestMutex
- - _responseQueue: locked by _responseMutex
-
- the object's life time:
- - AsyncStruct: construct and destruct in GL thread
- - image data: new in Load thread, delete in GL thread(by Image instance)
+TextureCache::TextureCache()
+    : _needQuit(false)
+    , _asyncRefCount(0)
+    , _decodeConcurrency(0)
+    , _runningDecodeTasks(0)
+    , _requestSequence(0)
+    , _uploadBudget(0.004f)
+{}
 
- Note:
- - all AsyncStruct referenced in _asyncStructQueue, for unbind function use.
+TextureCache::~TextureCache()
+{
+    AXLOGD("deallocing TextureCache: {}", fmt::ptr(this));
 
- How to deal add image many times?
- - At first, this situation is abnormal, we only ensure the logic is correct.
- - If the image has been loaded, the after load image call will return immediately.
- - If the image request is in queue already, there will be more than one request in queue,
- - In addImageAsyncCallback, will deduplicate the request to ensure only create one texture.
+    waitForQuit();
+    for (auto&& asyncStruct : _asyncStructs)
+        delete asyncStruct.second;
 
- Does process all response in addImageAsyncCallback consume more time?
- - Convert image to texture faster than load image from disk, so this isn't a
- problem.
+    for (auto&& texture : _textures)
+        texture.second->release();
+}
 
- Call unbindImageAsync(path) to prevent the call to the callback when the
- texture is loaded.
- */
-void TextureCache::addImageAsync(std::string_view path, const std::function<void(Texture2D*)>& callback)
+std::string TextureCache::getDescription() const
 {
-    addImageAsync(path, callback, path);
+    return fmt::format("<TextureCache | Number of textures = {}>", static_cast<int>(_textures.size()));
 }
 
 /**
  The addImageAsync logic follow the steps:
- - find the image has been add or not, if not add an AsyncStruct to _requestQueue  (GL thread)
- - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to
- _responseQueue (Load thread)
- - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL
- thread)
+ - find the image has been add or not, if not add an AsyncStruct to _requestQueue and start a decode task on the
+ JobSystem when less than _decodeConcurrency are running (GL thread)
+ - the decode tasks pop the AsyncStruct with the highest priority from _requestQueue, load res and fill image data to
+ AsyncStruct.image, then add AsyncStruct to _responseQueue, until _requestQueue is empty (JobSystem workers)
+ - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct, as
+ much as the upload budget allows per frame (GL thread)
 
  the Critical Area include these members:
- - _requestQueue: locked by _requestMutex
+ - _requestQueue, _runningDecodeTasks and the pending AsyncStruct priority: locked by _requestMutex
  - _responseQueue: locked by _responseMutex
 
  the object's life time:
  - AsyncStruct: construct and destruct in GL thread
- - image data: new in Load thread, delete in GL thread(by Image instance)
+ - image data: new in decode task, delete in GL thread(by Image instance)
 
  Note:
- - all AsyncStruct referenced in _asyncStructQueue, for unbind function use.
+ - all AsyncStruct referenced in _asyncStructs by full path, for deduplication and unbind function use.
+ - the responses come in decode completion order, not in request order.
 
  How to deal add image many times?
- - At first, this situation is abnormal, we only ensure the logic is correct.
  - If the image has been loaded, the after load image call will return immediately.
- - If the image request is in queue already, there will be more than one request in queue,
- - In addImageAsyncCallback, will deduplicate the request to ensure only create one texture.
+ - If the image request is in flight already, only the callback is added to it, so the file is decoded once.
 
- Does process all response in addImageAsyncCallback consume more time?
- - Convert image to texture faster than load image from disk, so this isn't a
- problem.
+ Call unbindImageAsync(path) to prevent the call to the callback when the
+ texture is loaded.
+ */
+void TextureCache::addImageAsync(std::string_view path, const std::function<void(Texture2D*)>& callback)
+{
+    addImageAsync(path, callback, path, 0);
+}
 
+/**
  The callbackKey allows to unbind the callback in cases where the loading of
  path is requested by several sources simultaneously. Each source can then
  unbind the callback independently as needed whilst a call to
@@ -174,6 +162,14 @@ void TextureCache::addImageAsync(std::string_view path, const std::function<void
 void TextureCache::addImageAsync(std::string_view path,
                                  const std::function<void(Texture2D*)>& callback,
                                  std::string_view callbackKey)
+{
+    addImageAsync(path, callback, callbackKey, 0);
+}
+
+void TextureCache::addImageAsync(std::string_view path,
+                                 const std::function<void(Texture2D*)>& callback,
+                                 std::string_view callbackKey,
+                                 int priority)
 {
     Texture2D* texture = nullptr;
 
@@ -190,6 +186,20 @@ void TextureCache::addImageAsync(std::string_view path,
         return;
     }
 
+    // the same file is in flight, share its decode
+    auto asyncIt = _asyncStructs.find(fullpath);
+    if (asyncIt != _asyncStructs.end())
+    {
+        auto asyncStruct = asyncIt->second;
+        asyncStruct->callbacks.emplace_back(AsyncStruct::Callback{callback, std::string{callbackKey}});
+        if (priority > asyncStruct->priority)
+        {
+            std::lock_guard<std::mutex> lock(_requestMutex);
+            asyncStruct->priority = priority;
+        }
+        return;
+    }
+
     // check if file exists
     if (fullpath.empty() || !FileUtils::getInstance()->isFileExist(fullpath))
     {
@@ -198,14 +208,6 @@ void TextureCache::addImageAsync(std::string_view path,
         return;
     }
 
-    // lazy init
-    if (_loadingThread == nullptr)
-    {
-        // create a new thread to load images
-        _needQuit      = false;
-        _loadingThread = new std::thread(&TextureCache::loadImage, this);
-    }
-
     if (0 == _asyncRefCount)
     {
         Director::getInstance()->getScheduler()->schedule(AX_SCHEDULE_SELECTOR(TextureCache::addImageAsyncCallBack),
@@ -215,81 +217,99 @@ void TextureCache::addImageAsync(std::string_view path,
     ++_asyncRefCount;
 
     // generate async struct
-    AsyncStruct* data = new AsyncStruct(fullpath, callback, callbackKey);
+    AsyncStruct* data = new AsyncStruct(fullpath, priority, ++_requestSequence);
+    data->callbacks.emplace_back(AsyncStruct::Callback{callback, std::string{callbackKey}});
+    _asyncStructs.emplace(data->filename, data);
 
-    // add async struct into queue
-    _asyncStructQueue.emplace_back(data);
-    std::unique_lock<std::mutex> ul(_requestMutex);
-    _requestQueue.emplace_back(data);
-    _sleepCondition.notify_one();
+    // add async struct into queue, and start a decode task if the concurrency allows
+    bool startTask = false;
+    {
+        std::lock_guard<std::mutex> lock(_requestMutex);
+        _needQuit = false;
+        _requestQueue.emplace_back(data);
+        if (_runningDecodeTasks < getAsyncDecodeConcurrency())
+        {
+            ++_runningDecodeTasks;
+            startTask = true;
+        }
+    }
+    if (startTask)
+        Director::getInstance()->getJobSystem()->enqueue([this] { loadImage(); });
 }
 
-void TextureCache::unbindImageAsync(std::string_view callbackKey)
+void TextureCache::setAsyncDecodeConcurrency(int concurrency)
 {
-    if (_asyncStructQueue.empty())
-    {
-        return;
-    }
+    _decodeConcurrency = concurrency;
+}
+
+int TextureCache::getAsyncDecodeConcurrency() const
+{
+    if (_decodeConcurrency > 0)
+        return _decodeConcurrency;
+    return (std::max)(1, Director::getInstance()->getJobSystem()->getThreadCount() / 2);
+}
 
-    for (auto&& asyncStruct : _asyncStructQueue)
+void TextureCache::unbindImageAsync(std::string_view callbackKey)
+{
+    for (auto&& asyncStruct : _asyncStructs)
     {
-        if (asyncStruct->callbackKey == callbackKey)
+        for (auto&& callback : asyncStruct.second->callbacks)
         {
-            asyncStruct->callback = nullptr;
+            if (callback.key == callbackKey)
+                callback.func = nullptr;
         }
     }
 }
 
 void TextureCache::unbindAllImageAsync()
 {
-    if (_asyncStructQueue.empty())
-    {
-        return;
-    }
-    for (auto&& asyncStruct : _asyncStructQueue)
+    for (auto&& asyncStruct : _asyncStructs)
     {
-        asyncStruct->callback = nullptr;
+        for (auto&& callback : asyncStruct.second->callbacks)
+            callback.func = nullptr;
     }
 }
 
 void TextureCache::loadImage()
 {
-    AsyncStruct* asyncStruct = nullptr;
-    while (!_needQuit)
+    for (;;)
     {
-        std::unique_lock<std::mutex> ul(_requestMutex);
-        // pop an AsyncStruct from request queue
-        if (_requestQueue.empty())
-        {
-            asyncStruct = nullptr;
-        }
-        else
+        AsyncStruct* asyncStruct = nullptr;
         {
-            asyncStruct = _requestQueue.front();
-            _requestQueue.pop_front();
+            std::unique_lock<std::mutex> ul(_requestMutex);
+            if (_needQuit || _requestQueue.empty())
+            {
+                // notify while locked, waitForQuit may destroy this as soon as the lock is released
+                --_runningDecodeTasks;
+                _sleepCondition.notify_all();
+                return;
+            }
+
+            // the highest priority first, the oldest one among equal priorities
+            auto it = std::max_element(_requestQueue.begin(), _requestQueue.end(),
+                                       [](const AsyncStruct* lhs, const AsyncStruct* rhs) {
+                if (lhs->priority != rhs->priority)
+                    return lhs->priority < rhs->priority;
+                return lhs->sequence > rhs->sequence;
+            });
+            asyncStruct = *it;
+            _requestQueue.erase(it);
         }
 
-        if (nullptr == asyncStruct)
         {
-            if (_needQuit)
-            {
-                break;
+            AX_TRACE_ZONE("TextureCache::decodeImage");
+
+            // load image
+            asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
+
+            // ETC1 ALPHA supports.
+            if (asyncStruct->loadSuccess && asyncStruct->image.getFileType() == Image::Format::ETC1 &&
+                !s_etc1AlphaFileSuffix.empty())
+            {  // check whether alpha texture exists & load it
+                auto alphaFile = asyncStruct->filename + s_etc1AlphaFileSuffix;
+                if (FileUtils::getInstance()->isFileExist(alphaFile))
+                    asyncStruct->imageAlpha.initWithImageFileThreadSafe(alphaFile);
             }
-            _sleepCondition.wait(ul);
-            continue;
-        }
-        ul.unlock();
-
-        // load image
-        asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
-
-        // ETC1 ALPHA supports.
-        if (asyncStruct->loadSuccess && asyncStruct->image.getFileType() == Image::Format::ETC1 &&
-            !s_etc1AlphaFileSuffix.empty())
-        {  // check whether alpha texture exists & load it
-            auto alphaFile = asyncStruct->filename + s_etc1AlphaFileSuffix;
-            if (FileUtils::getInstance()->isFileExist(alphaFile))
-                asyncStruct->imageAlpha.initWithImageFileThreadSafe(alphaFile);
         }
         // push the asyncStruct to response queue
         _responseMutex.lock();
@@ -300,6 +320,9 @@ void TextureCache::loadImage()
 
 void TextureCache::addImageAsyncCallBack(float /*dt*/)
 {
+    AX_TRACE_ZONE("TextureCache::addImageAsyncCallBack");
+
+    const auto start         = std::chrono::steady_clock::now();
     Texture2D* texture       = nullptr;
     AsyncStruct* asyncStruct = nullptr;
     while (true)
@@ -314,10 +337,6 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
         {
             asyncStruct = _responseQueue.front();
             _responseQueue.pop_front();
-
-            // the asyncStruct's sequence order in _asyncStructQueue must equal to the order in _responseQueue
-            AX_ASSERT(asyncStruct == _asyncStructQueue.front());
-            _asyncStructQueue.pop_front();
         }
         _responseMutex.unlock();
 
@@ -326,6 +345,8 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
             break;
         }
 
+        _asyncStructs.erase(asyncStruct->filename);
+
         // check the image has been convert to texture or not
         auto it = _textures.find(asyncStruct->filename);
         if (it != _textures.end())
@@ -366,15 +387,21 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
             }
         }
 
-        // call callback function
-        if (asyncStruct->callback)
+        // call callback functions
+        for (auto&& callback : asyncStruct->callbacks)
         {
-            (asyncStruct->callback)(texture);
+            if (callback.func)
+                callback.func(texture);
         }
 
         // release the asyncStruct
         delete asyncStruct;
         --_asyncRefCount;
+
+        // leave the remaining textures to the next frames
+        if (_uploadBudget > 0 &&
+            std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count() >= _uploadBudget)
+            break;
     }
 
     if (0 == _asyncRefCount)
@@ -455,6 +482,8 @@ Texture2D* TextureCache::addImage(std::string_view path, PixelFormat format)
 
     if (!texture)
     {
+        AX_TRACE_ZONE("TextureCache::addImage");
+
         // all images are handled by UIImage except PVR extension that is handled by our own handler
         do
         {
@@ -743,13 +772,10 @@ std::string TextureCache::getTextureFilePath(ax::Texture2D* texture) const
 
 void TextureCache::waitForQuit()
 {
-    // notify sub thread to quick
+    // stop the decode tasks after their current image and wait for them
     std::unique_lock<std::mutex> ul(_requestMutex);
     _needQuit = true;
-    _sleepCondition.notify_one();
-    ul.unlock();
-    if (_loadingThread)
-        _loadingThread->join();
+    _sleepCondition.wait(ul, [this] { return _runningDecodeTasks == 0; });
 }
 
 std::string TextureCache::getCachedTextureInfo() const
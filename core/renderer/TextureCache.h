@@ -31,7 +31,6 @@ THE SOFTWARE.
 #define __CCTEXTURE_CACHE_H__
 
 #include <mutex>
-#include <thread>
 #include <condition_variable>
 #include <queue>
 #include <string>
@@ -124,6 +123,31 @@ public:
                        const std::function<void(Texture2D*)>& callback,
                        std::string_view callbackKey);
 
+    /** Same as addImageAsync, the pending requests with a higher priority are decoded first.
+     * Requesting a file which is already being loaded only adds the callback, and raises the priority of the
+     * pending request if needed.
+     * @since axmol-2.2
+     */
+    void addImageAsync(std::string_view path,
+                       const std::function<void(Texture2D*)>& callback,
+                       std::string_view callbackKey,
+                       int priority);
+
+    /** Sets the max number of images decoded in parallel on the JobSystem by addImageAsync.
+     * @param concurrency The number of decode tasks, 0 or less means half of the JobSystem workers.
+     * @since axmol-2.2
+     */
+    void setAsyncDecodeConcurrency(int concurrency);
+    int getAsyncDecodeConcurrency() const;
+
+    /** Sets the time spent per frame to create the textures of the decoded images on the render thread,
+     * the remaining ones are created in the next frames. At least one texture is created per frame.
+     * @param seconds The time budget, 0 means no limit. The default is 4 milliseconds.
+     * @since axmol-2.2
+     */
+    void setAsyncUploadBudget(float seconds) { _uploadBudget = seconds; }
+    float getAsyncUploadBudget() const { return _uploadBudget; }
+
     /** Unbind a specified bound image asynchronous callback.
      * In the case an object who was bound to an image asynchronous callback was destroyed before the callback is
      * invoked, the object always need to unbind this callback manually.
@@ -233,21 +257,27 @@ public:
 protected:
     struct AsyncStruct;
 
-    std::thread* _loadingThread;
-
-    std::deque<AsyncStruct*> _asyncStructQueue;
-    std::deque<AsyncStruct*> _requestQueue;
+    // pending decodes, picked by priority by the decode tasks
+    std::vector<AsyncStruct*> _requestQueue;
     std::deque<AsyncStruct*> _responseQueue;
+    // all the requests in flight by full path, only accessed on the GL thread
+    hlookup::string_map<AsyncStruct*> _asyncStructs;
 
     std::mutex _requestMutex;
     std::mutex _responseMutex;
 
+    // signaled when a decode task ends, for waitForQuit
     std::condition_variable _sleepCondition;
 
     bool _needQuit;
 
     int _asyncRefCount;
 
+    int _decodeConcurrency;
+    int _runningDecodeTasks;
+    uint64_t _requestSequence;
+    float _uploadBudget;
+
     hlookup::string_map<Texture2D*> _textures;
 
     static std::string s_etc1AlphaFileSuffix;
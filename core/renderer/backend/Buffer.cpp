@@ -0,0 +1,83 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "Buffer.h"
+
+NS_AX_BACKEND_BEGIN
+
+namespace
+{
+// Keeps every region aligned for vertex attributes and 32-bit indices.
+constexpr std::size_t STREAM_REGION_ALIGNMENT = 16;
+}  // namespace
+
+void* Buffer::mapStream(std::size_t size, std::size_t& offset)
+{
+    AXASSERT(size && size <= _size, "Buffer: stream region overflow");
+
+    // Backends without a stream ring replace the whole buffer on every region
+    if (_streamData.empty())
+        _streamData.resize(_size);
+    _streamOffset = offset = 0;
+    return _streamData.data();
+}
+
+void Buffer::unmapStream(std::size_t size)
+{
+    if (size == 0)
+        return;
+
+    updateData(_streamData.data(), size);
+    _streamStats.uploadedBytes += size;
+}
+
+bool Buffer::reserveStreamRegion(std::size_t size)
+{
+    AXASSERT(size && size <= _size, "Buffer: stream region overflow");
+
+    bool fits = _streamCursor + size <= _size;
+    if (!fits)
+        _streamCursor = 0;
+
+    _streamOffset = _streamSegment * _size + _streamCursor;
+    return fits;
+}
+
+void Buffer::commitStreamRegion(std::size_t size)
+{
+    _streamCursor = (_streamCursor + size + STREAM_REGION_ALIGNMENT - 1) & ~(STREAM_REGION_ALIGNMENT - 1);
+    if (_streamCursor > _size)
+        _streamCursor = _size;
+    _streamStats.uploadedBytes += size;
+}
+
+int Buffer::advanceStreamSegment()
+{
+    _streamSegment = (_streamSegment + 1) % MAX_INFLIGHT_BUFFER;
+    _streamCursor  = 0;
+    return _streamSegment;
+}
+
+NS_AX_BACKEND_END
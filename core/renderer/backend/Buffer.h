@@ -27,6 +27,7 @@
 #include "Macros.h"
 #include "Types.h"
 #include "base/Object.h"
+#include "base/axstd.h"
 
 namespace ax
 {
@@ -42,6 +43,16 @@ NS_AX_BACKEND_BEGIN
  * @{
  */
 
+/**
+ * Counters of a BufferUsage::STREAM buffer, see Buffer::mapStream.
+ */
+struct BufferStreamStats
+{
+    std::size_t uploadedBytes = 0;  ///< bytes committed by unmapStream.
+    uint32_t stalls           = 0;  ///< times mapStream waited for the GPU to release a segment.
+    uint32_t orphans          = 0;  ///< times the storage was orphaned because a frame overflowed its segment.
+};
+
 /**
  * @brief Used to store vertex and index data data.
  */
@@ -74,6 +85,33 @@ public:
      */
     virtual void usingDefaultStoredData(bool needDefaultStoredData) = 0;
 
+    /**
+     * @brief Reserve a write-only region of a BufferUsage::STREAM buffer.
+     * A stream buffer holds MAX_INFLIGHT_BUFFER segments of getSize() bytes, one per frame in flight. Regions are
+     * reserved one after another in the segment of the current frame, so the GPU may still read the previous ones
+     * while the next is written. Backends return mapped storage when they can, otherwise a staging block which is
+     * copied by unmapStream.
+     * @param size Specifies the size in bytes to reserve, at most getSize().
+     * @param offset Receives the offset in bytes of the region in the buffer, to be passed to draw calls.
+     * @return A pointer to at least size writable bytes, valid until unmapStream.
+     */
+    virtual void* mapStream(std::size_t size, std::size_t& offset);
+
+    /**
+     * @brief Commit the region reserved by the last mapStream.
+     * @param size Specifies how many bytes were written, at most the reserved size.
+     */
+    virtual void unmapStream(std::size_t size);
+
+    /**
+     * @brief Move to the segment of the next frame, once the draws of the current frame have been submitted.
+     */
+    virtual void nextStreamFrame() {}
+
+    /** Counters of the stream buffer since the last resetStreamStats. */
+    const BufferStreamStats& getStreamStats() const { return _streamStats; }
+    void resetStreamStats() { _streamStats = {}; }
+
     /**
      * Get buffer size in bytes.
      * @return The buffer size in bytes.
@@ -92,9 +130,28 @@ protected:
 
     virtual ~Buffer() = default;
 
+    /**
+     * Reserve size bytes in the segment of the current frame and set _streamOffset to the region.
+     * @return false when the segment is full, the region then starts over at the beginning of the segment and the
+     * backend must orphan the storage or otherwise make sure the GPU is done with it.
+     */
+    bool reserveStreamRegion(std::size_t size);
+
+    /** Advance _streamCursor past the region committed by unmapStream. */
+    void commitStreamRegion(std::size_t size);
+
+    /** Select the segment of the next frame, returns its index. */
+    int advanceStreamSegment();
+
     BufferUsage _usage = BufferUsage::DYNAMIC;  ///< Buffer usage.
     BufferType _type   = BufferType::VERTEX;    ///< Buffer type.
     std::size_t _size  = 0;                     ///< buffer size in bytes.
+
+    axstd::pod_vector<uint8_t> _streamData;  ///< staging block of mapStream when storage can't be mapped.
+    BufferStreamStats _streamStats;
+    std::size_t _streamCursor = 0;  ///< write position in the current segment.
+    std::size_t _streamOffset = 0;  ///< offset in the buffer of the region reserved by mapStream.
+    int _streamSegment        = 0;
 };
 
 // end of _backend group
@@ -131,8 +131,9 @@ public:
     /**
      * Set a global buffer for all vertex shaders at the given bind point index 0.
      * @param buffer The vertex buffer to be setted in the buffer argument table.
+     * @param offset The offset in bytes of the first vertex, e.g. the one returned by Buffer::mapStream.
      */
-    virtual void setVertexBuffer(Buffer* buffer) = 0;
+    virtual void setVertexBuffer(Buffer* buffer, std::size_t offset = 0) = 0;
 
     /**
      * Set unifroms and textures
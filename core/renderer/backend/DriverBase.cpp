@@ -28,5 +28,19 @@
 NS_AX_BACKEND_BEGIN
 
 DriverBase* DriverBase::_instance = nullptr;
+DriverType DriverBase::_driverType = DriverType::Default;
+
+void DriverBase::setDriverType(DriverType type)
+{
+    AXASSERT(!_instance, "DriverBase::setDriverType must be called before the driver is created");
+#if !defined(AX_ENABLE_NULL_DRIVER)
+    if (type == DriverType::Null)
+    {
+        AXLOGW("The null driver is not available, build with AX_ENABLE_NULL_DRIVER");
+        return;
+    }
+#endif
+    _driverType = type;
+}
 
 NS_AX_BACKEND_END
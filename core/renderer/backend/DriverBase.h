@@ -47,6 +47,7 @@ class RenderTarget;
 
 class ProgramManager;
 class Program;
+struct ProgramBinary;
 
 enum class FeatureType : uint32_t
 {
@@ -61,7 +62,17 @@ enum class FeatureType : uint32_t
     VAO,
     MAPBUFFER,
     DEPTH24,
-    ASTC
+    ASTC,
+    ELEMENT_INDEX_UINT
+};
+
+/**
+ * The kind of driver created by DriverBase::getInstance().
+ */
+enum class DriverType : uint32_t
+{
+    Default,  // the platform render backend: OpenGL or Metal
+    Null,     // headless driver without GPU work, only available with AX_ENABLE_NULL_DRIVER
 };
 
 /**
@@ -84,6 +95,13 @@ public:
     static DriverBase* getInstance();
     static void destroyInstance();
 
+    /**
+     * Select the driver type created by the next getInstance() call.
+     * @note Must be called before the renderer is initialized, i.e. before Director::setGLView.
+     */
+    static void setDriverType(DriverType type);
+    static DriverType getDriverType() { return _driverType; }
+
     virtual ~DriverBase() = default;
 
     /**
@@ -145,6 +163,32 @@ public:
      */
     virtual Program* newProgram(std::string_view vertexShader, std::string_view fragmentShader) = 0;
 
+    /**
+     * Create a Program from the binary of an earlier launch, see Program::getBinary.
+     * @param binary The binary of a program linked from the same sources by the same driver.
+     * @return nullptr if the driver rejects the binary, i.e. after a driver update.
+     */
+    virtual Program* newProgram(std::string_view /*vertexShader*/,
+                                std::string_view /*fragmentShader*/,
+                                const ProgramBinary& /*binary*/)
+    {
+        return nullptr;
+    }
+
+    /**
+     * Create a Program whose compiling is only started, Program::isCompileCompleted polls it.
+     * Drivers which can't compile in the background compile it right away.
+     */
+    virtual Program* newProgramAsync(std::string_view vertexShader, std::string_view fragmentShader)
+    {
+        return newProgram(vertexShader, fragmentShader);
+    }
+
+    /**
+     * Whether Program::getBinary and newProgram with a binary are supported.
+     */
+    virtual bool isProgramBinarySupported() const { return false; }
+
     virtual void resetState() {};
 
     /// below is driver info
@@ -225,6 +269,7 @@ protected:
 
 private:
     static DriverBase* _instance;
+    static DriverType _driverType;
 };
 
 // end of _backend group
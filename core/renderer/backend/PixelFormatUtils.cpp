@@ -24,6 +24,7 @@
  ****************************************************************************/
 
 #include "PixelFormatUtils.h"
+#include "PixelKernels.h"
 #include "Macros.h"
 
 namespace ax
@@ -139,18 +140,6 @@ static void convertRG8ToRGB8(const unsigned char* data, size_t dataLen, unsigned
     }
 }
 
-// IIIIIIIIAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA
-static void convertRG8ToRGBA8(const unsigned char* data, size_t dataLen, unsigned char* outData)
-{
-    for (ssize_t i = 0, l = dataLen - 1; i < l; i += 2)
-    {
-        *outData++ = data[i];      // R
-        *outData++ = data[i + 1];      // G
-        *outData++ = data[i];      // B
-        *outData++ = data[i + 1];  // A
-    }
-}
-
 // IIIIIIII -> RRRRRGGGGGGBBBBB
 static void convertR8ToRGB565(const unsigned char* data, size_t dataLen, unsigned char* outData)
 {
@@ -247,29 +236,6 @@ static void convertRG8ToR8(const unsigned char* data, size_t dataLen, unsigned c
     }
 }
 
-// RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA
-static void convertRGB8ToRGBA8(const unsigned char* data, size_t dataLen, unsigned char* outData)
-{
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
-    {
-        *outData++ = data[i];      // R
-        *outData++ = data[i + 1];  // G
-        *outData++ = data[i + 2];  // B
-        *outData++ = 0xFF;         // A
-    }
-}
-
-// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBB
-static void convertRGBA8ToRGB8(const unsigned char* data, size_t dataLen, unsigned char* outData)
-{
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
-    {
-        *outData++ = data[i];      // R
-        *outData++ = data[i + 1];  // G
-        *outData++ = data[i + 2];  // B
-    }
-}
-
 // RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRGGGGGGBBBBB
 static void convertRGB8ToRGB565(const unsigned char* data, size_t dataLen, unsigned char* outData)
 {
@@ -282,18 +248,6 @@ static void convertRGB8ToRGB565(const unsigned char* data, size_t dataLen, unsig
     }
 }
 
-// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRGGGGGGBBBBB
-static void convertRGBA8ToRGB565(const unsigned char* data, size_t dataLen, unsigned char* outData)
-{
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
-    {
-        *out16++ = (data[i] & 0x00F8) << 8         // R
-                   | (data[i + 1] & 0x00FC) << 3   // G
-                   | (data[i + 2] & 0x00F8) >> 3;  // B
-    }
-}
-
 // RRRRRRRRGGGGGGGGBBBBBBBB -> AAAAAAAA
 static void convertRGB8ToR8(const unsigned char* data, size_t dataLen, unsigned char* outData)
 {
@@ -345,19 +299,6 @@ static void convertRGB8ToRGBA4(const unsigned char* data, size_t dataLen, unsign
     }
 }
 
-// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRGGGGBBBBAAAA
-static void convertRGBA8ToRGBA4(const unsigned char* data, size_t dataLen, unsigned char* outData)
-{
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
-    {
-        *out16++ = (data[i] & 0x00F0) << 8        // R
-                   | (data[i + 1] & 0x00F0) << 4  // G
-                   | (data[i + 2] & 0xF0)         // B
-                   | (data[i + 3] & 0xF0) >> 4;   // A
-    }
-}
-
 // RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRGGGGGBBBBBA
 static void convertRGB8ToRGB5A1(const unsigned char* data, size_t dataLen, unsigned char* outData)
 {
@@ -371,87 +312,6 @@ static void convertRGB8ToRGB5A1(const unsigned char* data, size_t dataLen, unsig
     }
 }
 
-// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRGGG GGBBBBBA
-static void convertRGBA8ToRGB5A1(const unsigned char* data, size_t dataLen, unsigned char* outData)
-{
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 4)
-    {
-        *out16++ = (data[i] & 0x00F8) << 8         // R
-                   | (data[i + 1] & 0x00F8) << 3   // G
-                   | (data[i + 2] & 0x00F8) >> 2   // B
-                   | (data[i + 3] & 0x0080) >> 7;  // A
-    }
-}
-
-static void convertRGB5A1ToRGBA8(const unsigned char* data, size_t dataLen, unsigned char* outData)
-{
-    uint16_t* inData      = (uint16_t*)data;
-    const size_t pixelLen = dataLen / 2;
-    uint16_t pixel;
-    for (size_t i = 0; i < pixelLen; i++)
-    {
-        pixel      = inData[i];
-        *outData++ = (pixel & (0x001F << 11)) >> 8;
-        *outData++ = (pixel & (0x001F << 6)) >> 3;
-        *outData++ = (pixel & (0x001F << 1)) << 2;
-        *outData++ = (pixel & 0x0001) * 255;
-    }
-}
-
-static void convertRGB565ToRGBA8(const unsigned char* data, size_t dataLen, unsigned char* outData)
-{
-    uint16_t* inData      = (uint16_t*)data;
-    const size_t pixelLen = dataLen / 2;
-    uint16_t pixel;
-    for (size_t i = 0; i < pixelLen; i++)
-    {
-        pixel      = inData[i];
-        *outData++ = (pixel & (0x001F << 11)) >> 8;
-        *outData++ = (pixel & (0x003F << 5)) >> 3;
-        *outData++ = (pixel & (0x001F)) << 3;
-        *outData++ = 0xFF;
-    }
-}
-
-static void convertRGBA4ToRGBA8(const unsigned char* data, size_t dataLen, unsigned char* outData)
-{
-    uint16_t* inData      = (uint16_t*)data;
-    const size_t pixelLen = dataLen / 2;
-    uint16_t pixel;
-    for (size_t i = 0; i < pixelLen; i++)
-    {
-        pixel      = inData[i];
-        *outData++ = ((pixel & 0xF000) >> 12) * 17;
-        *outData++ = ((pixel & 0x0F00) >> 8) * 17;
-        *outData++ = ((pixel & 0x00F0) >> 4) * 17;
-        *outData++ = ((pixel & 0x000F) * 17);
-    }
-}
-
-static void convertR8ToRGBA8(const unsigned char* data, size_t dataLen, unsigned char* outData)
-{
-    for (size_t i = 0; i < dataLen; i++)
-    {
-        *outData++ = data[i];
-        *outData++ = data[i];
-        *outData++ = data[i];
-        *outData++ = data[i];
-    }
-}
-
-static void convertBGRA8ToRGBA8(const unsigned char* data, size_t dataLen, unsigned char* outData)
-{
-    const size_t pixelCounts = dataLen / 4;
-    for (size_t i = 0; i < pixelCounts; i++)
-    {
-        *outData++ = data[i * 4 + 2];
-        *outData++ = data[i * 4 + 1];
-        *outData++ = data[i * 4 + 0];
-        *outData++ = data[i * 4 + 3];
-    }
-}
-
 // converter function end
 //////////////////////////////////////////////////////////////////////////
 
@@ -466,7 +326,7 @@ static ax::backend::PixelFormat convertR8ToFormat(const unsigned char* data,
     case PixelFormat::RGBA8:
         *outDataLen = dataLen * 4;
         *outData    = (unsigned char*)malloc(sizeof(unsigned char) * (*outDataLen));
-        convertR8ToRGBA8(data, dataLen, *outData);
+        PixelKernels::getKernels().convertR8ToRGBA8(data, dataLen, *outData);
         break;
     case PixelFormat::RGB8:
         *outDataLen = dataLen * 3;
@@ -526,7 +386,7 @@ static ax::backend::PixelFormat convertRG8ToFormat(const unsigned char* data,
     case PixelFormat::RGBA8:
         *outDataLen = dataLen * 2;
         *outData    = (unsigned char*)malloc(sizeof(unsigned char) * (*outDataLen));
-        convertRG8ToRGBA8(data, dataLen, *outData);
+        PixelKernels::getKernels().convertRG8ToRGBA8(data, dataLen, *outData);
         break;
     case PixelFormat::RGB8:
         *outDataLen = dataLen / 2 * 3;
@@ -582,7 +442,7 @@ static ax::backend::PixelFormat convertRGB8ToFormat(const unsigned char* data,
     case PixelFormat::RGBA8:
         *outDataLen = dataLen / 3 * 4;
         *outData    = (unsigned char*)malloc(sizeof(unsigned char) * (*outDataLen));
-        convertRGB8ToRGBA8(data, dataLen, *outData);
+        PixelKernels::getKernels().convertRGB8ToRGBA8(data, dataLen, *outData);
         break;
     case PixelFormat::RGB565:
         *outDataLen = dataLen / 3 * 2;
@@ -638,22 +498,22 @@ static ax::backend::PixelFormat convertRGBA8ToFormat(const unsigned char* data,
     case PixelFormat::RGB8:
         *outDataLen = dataLen / 4 * 3;
         *outData    = (unsigned char*)malloc(sizeof(unsigned char) * (*outDataLen));
-        convertRGBA8ToRGB8(data, dataLen, *outData);
+        PixelKernels::getKernels().convertRGBA8ToRGB8(data, dataLen, *outData);
         break;
     case PixelFormat::RGB565:
         *outDataLen = dataLen / 2;
         *outData    = (unsigned char*)malloc(sizeof(unsigned char) * (*outDataLen));
-        convertRGBA8ToRGB565(data, dataLen, *outData);
+        PixelKernels::getKernels().convertRGBA8ToRGB565(data, dataLen, *outData);
         break;
     case PixelFormat::RGBA4:
         *outDataLen = dataLen / 2;
         *outData    = (unsigned char*)malloc(sizeof(unsigned char) * (*outDataLen));
-        convertRGBA8ToRGBA4(data, dataLen, *outData);
+        PixelKernels::getKernels().convertRGBA8ToRGBA4(data, dataLen, *outData);
         break;
     case PixelFormat::RGB5A1:
         *outDataLen = dataLen / 2;
         *outData    = (unsigned char*)malloc(sizeof(unsigned char) * (*outDataLen));
-        convertRGBA8ToRGB5A1(data, dataLen, *outData);
+        PixelKernels::getKernels().convertRGBA8ToRGB5A1(data, dataLen, *outData);
         break;
     case PixelFormat::R8:
         *outDataLen = dataLen / 4;
@@ -694,7 +554,7 @@ static ax::backend::PixelFormat convertRGB5A1ToFormat(const unsigned char* data,
     case PixelFormat::RGBA8:
         *outDataLen = dataLen / 2 * 4;
         *outData    = (unsigned char*)malloc(sizeof(unsigned char) * (*outDataLen));
-        convertRGB5A1ToRGBA8(data, dataLen, *outData);
+        PixelKernels::getKernels().convertRGB5A1ToRGBA8(data, dataLen, *outData);
         break;
     case PixelFormat::RGB5A1:
         *outDataLen = dataLen;
@@ -728,7 +588,7 @@ static ax::backend::PixelFormat convertRGB565ToFormat(const unsigned char* data,
     case PixelFormat::RGBA8:
         *outDataLen = dataLen / 2 * 4;
         *outData    = (unsigned char*)malloc(sizeof(unsigned char) * (*outDataLen));
-        convertRGB565ToRGBA8(data, dataLen, *outData);
+        PixelKernels::getKernels().convertRGB565ToRGBA8(data, dataLen, *outData);
         break;
     case PixelFormat::RGB565:
         *outDataLen = dataLen;
@@ -762,7 +622,7 @@ static ax::backend::PixelFormat convertRGBA4ToFormat(const unsigned char* data,
     case PixelFormat::RGBA8:
         *outDataLen = dataLen / 2 * 4;
         *outData    = (unsigned char*)malloc(sizeof(unsigned char) * (*outDataLen));
-        convertRGBA4ToRGBA8(data, dataLen, *outData);
+        PixelKernels::getKernels().convertRGBA4ToRGBA8(data, dataLen, *outData);
         break;
     case PixelFormat::RGBA4:
         *outDataLen = dataLen;
@@ -796,7 +656,7 @@ static PixelFormat convertBGRA8ToFormat(const unsigned char* data,
     case PixelFormat::RGBA8:
         *outDataLen = dataLen;
         *outData    = (unsigned char*)malloc(sizeof(unsigned char) * (*outDataLen));
-        convertBGRA8ToRGBA8(data, dataLen, *outData);
+        PixelKernels::getKernels().convertBGRA8ToRGBA8(data, dataLen, *outData);
         break;
 
     default:
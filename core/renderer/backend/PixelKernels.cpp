@@ -0,0 +1,1101 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "renderer/backend/PixelKernels.h"
+#include "base/Macros.h"
+#include "math/Math.h"
+#include <algorithm>
+#include <atomic>
+
+#if defined(AX_SSE_INTRINSICS) && !defined(__EMSCRIPTEN__) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#    define AX_PIXEL_KERNELS_AVX2 1
+#    include <immintrin.h>
+#    if defined(_MSC_VER)
+#        include <intrin.h>
+#    endif
+#    if defined(_MSC_VER) && !defined(__clang__)
+#        define AX_TARGET_AVX2
+#    else
+#        define AX_TARGET_AVX2 __attribute__((target("avx2")))
+#    endif
+#else
+#    define AX_PIXEL_KERNELS_AVX2 0
+#endif
+
+namespace ax
+{
+
+namespace backend
+{
+namespace PixelKernels
+{
+
+//////////////////////////////////////////////////////////////////////////
+// scalar kernels, the reference of all the vectorized ones
+
+// c * (a + 1) >> 8, same as AX_RGB_PREMULTIPLY_ALPHA
+static void premultiplyAlphaRGBA8_scalar(unsigned char* data, size_t pixelCount)
+{
+    for (size_t i = 0; i < pixelCount; ++i, data += 4)
+    {
+        const unsigned a = data[3] + 1;
+        data[0]          = (data[0] * a) >> 8;
+        data[1]          = (data[1] * a) >> 8;
+        data[2]          = (data[2] * a) >> 8;
+    }
+}
+
+// (i * a + 1) >> 8
+static void premultiplyAlphaRG8_scalar(unsigned char* data, size_t pixelCount)
+{
+    for (size_t i = 0; i < pixelCount; ++i, data += 2)
+        data[0] = (data[0] * data[1] + 1) >> 8;
+}
+
+// min(255, ceil(c * 255 / a)) in integer, bit exact with the float ceil it replaced
+static void reversePremultipliedAlphaRGBA8_scalar(unsigned char* data, size_t pixelCount)
+{
+    for (size_t i = 0; i < pixelCount; ++i, data += 4)
+    {
+        const unsigned a = data[3];
+        if (a > 0)
+        {
+            data[0] = (std::min)(255u, (data[0] * 255u + a - 1) / a);
+            data[1] = (std::min)(255u, (data[1] * 255u + a - 1) / a);
+            data[2] = (std::min)(255u, (data[2] * 255u + a - 1) / a);
+        }
+    }
+}
+
+// IIIIIIII -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA
+static void convertR8ToRGBA8_scalar(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    for (size_t i = 0; i < dataLen; i++)
+    {
+        *outData++ = data[i];
+        *outData++ = data[i];
+        *outData++ = data[i];
+        *outData++ = data[i];
+    }
+}
+
+// IIIIIIIIAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA
+static void convertRG8ToRGBA8_scalar(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    for (ssize_t i = 0, l = dataLen - 1; i < l; i += 2)
+    {
+        *outData++ = data[i];      // R
+        *outData++ = data[i + 1];  // G
+        *outData++ = data[i];      // B
+        *outData++ = data[i + 1];  // A
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA
+static void convertRGB8ToRGBA8_scalar(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
+    {
+        *outData++ = data[i];      // R
+        *outData++ = data[i + 1];  // G
+        *outData++ = data[i + 2];  // B
+        *outData++ = 0xFF;         // A
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBB
+static void convertRGBA8ToRGB8_scalar(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
+    {
+        *outData++ = data[i];      // R
+        *outData++ = data[i + 1];  // G
+        *outData++ = data[i + 2];  // B
+    }
+}
+
+// BBBBBBBBGGGGGGGGRRRRRRRRAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA
+static void convertBGRA8ToRGBA8_scalar(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    const size_t pixelCounts = dataLen / 4;
+    for (size_t i = 0; i < pixelCounts; i++)
+    {
+        *outData++ = data[i * 4 + 2];
+        *outData++ = data[i * 4 + 1];
+        *outData++ = data[i * 4 + 0];
+        *outData++ = data[i * 4 + 3];
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRGGGGGGBBBBB
+static void convertRGBA8ToRGB565_scalar(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    unsigned short* out16 = (unsigned short*)outData;
+    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
+    {
+        *out16++ = (data[i] & 0x00F8) << 8         // R
+                   | (data[i + 1] & 0x00FC) << 3   // G
+                   | (data[i + 2] & 0x00F8) >> 3;  // B
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRGGGGBBBBAAAA
+static void convertRGBA8ToRGBA4_scalar(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    unsigned short* out16 = (unsigned short*)outData;
+    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
+    {
+        *out16++ = (data[i] & 0x00F0) << 8        // R
+                   | (data[i + 1] & 0x00F0) << 4  // G
+                   | (data[i + 2] & 0xF0)         // B
+                   | (data[i + 3] & 0xF0) >> 4;   // A
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRGGG GGBBBBBA
+static void convertRGBA8ToRGB5A1_scalar(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    unsigned short* out16 = (unsigned short*)outData;
+    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 4)
+    {
+        *out16++ = (data[i] & 0x00F8) << 8         // R
+                   | (data[i + 1] & 0x00F8) << 3   // G
+                   | (data[i + 2] & 0x00F8) >> 2   // B
+                   | (data[i + 3] & 0x0080) >> 7;  // A
+    }
+}
+
+static void convertRGB565ToRGBA8_scalar(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    uint16_t* inData      = (uint16_t*)data;
+    const size_t pixelLen = dataLen / 2;
+    uint16_t pixel;
+    for (size_t i = 0; i < pixelLen; i++)
+    {
+        pixel      = inData[i];
+        *outData++ = (pixel & (0x001F << 11)) >> 8;
+        *outData++ = (pixel & (0x003F << 5)) >> 3;
+        *outData++ = (pixel & (0x001F)) << 3;
+        *outData++ = 0xFF;
+    }
+}
+
+static void convertRGBA4ToRGBA8_scalar(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    uint16_t* inData      = (uint16_t*)data;
+    const size_t pixelLen = dataLen / 2;
+    uint16_t pixel;
+    for (size_t i = 0; i < pixelLen; i++)
+    {
+        pixel      = inData[i];
+        *outData++ = ((pixel & 0xF000) >> 12) * 17;
+        *outData++ = ((pixel & 0x0F00) >> 8) * 17;
+        *outData++ = ((pixel & 0x00F0) >> 4) * 17;
+        *outData++ = ((pixel & 0x000F) * 17);
+    }
+}
+
+static void convertRGB5A1ToRGBA8_scalar(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    uint16_t* inData      = (uint16_t*)data;
+    const size_t pixelLen = dataLen / 2;
+    uint16_t pixel;
+    for (size_t i = 0; i < pixelLen; i++)
+    {
+        pixel      = inData[i];
+        *outData++ = (pixel & (0x001F << 11)) >> 8;
+        *outData++ = (pixel & (0x001F << 6)) >> 3;
+        *outData++ = (pixel & (0x001F << 1)) << 2;
+        *outData++ = (pixel & 0x0001) * 255;
+    }
+}
+
+static const KernelTable s_scalarKernels = {
+    premultiplyAlphaRGBA8_scalar,  premultiplyAlphaRG8_scalar,  reversePremultipliedAlphaRGBA8_scalar,
+    convertR8ToRGBA8_scalar,       convertRG8ToRGBA8_scalar,    convertRGB8ToRGBA8_scalar,
+    convertRGBA8ToRGB8_scalar,     convertBGRA8ToRGBA8_scalar,  convertRGBA8ToRGB565_scalar,
+    convertRGBA8ToRGBA4_scalar,    convertRGBA8ToRGB5A1_scalar, convertRGB565ToRGBA8_scalar,
+    convertRGBA4ToRGBA8_scalar,    convertRGB5A1ToRGBA8_scalar,
+};
+
+// The vectorized kernels below process whole vectors and hand the remaining pixels to the scalar ones.
+
+#if defined(AX_SSE_INTRINSICS)
+//////////////////////////////////////////////////////////////////////////
+// SSE2 kernels, 4 RGBA8 pixels per vector
+
+// 16 bit lanes of 2 RGBA pixels, the alpha lanes are kept
+static inline __m128i premultiplyRGBA16_sse2(__m128i v)
+{
+    const __m128i alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    a         = _mm_add_epi16(a, _mm_set1_epi16(1));
+    __m128i c = _mm_srli_epi16(_mm_mullo_epi16(v, a), 8);
+    return _mm_or_si128(_mm_and_si128(alphaMask, v), _mm_andnot_si128(alphaMask, c));
+}
+
+static void premultiplyAlphaRGBA8_sse2(unsigned char* data, size_t pixelCount)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t i           = 0;
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        __m128i* p = (__m128i*)(data + i * 4);
+        __m128i px = _mm_loadu_si128(p);
+        __m128i lo = premultiplyRGBA16_sse2(_mm_unpacklo_epi8(px, zero));
+        __m128i hi = premultiplyRGBA16_sse2(_mm_unpackhi_epi8(px, zero));
+        _mm_storeu_si128(p, _mm_packus_epi16(lo, hi));
+    }
+    premultiplyAlphaRGBA8_scalar(data + i * 4, pixelCount - i);
+}
+
+// 16 bit lanes of 4 IA pixels, the alpha lanes are kept
+static inline __m128i premultiplyRG16_sse2(__m128i v)
+{
+    const __m128i alphaMask = _mm_set_epi16(-1, 0, -1, 0, -1, 0, -1, 0);
+    __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 3, 1, 1)), _MM_SHUFFLE(3, 3, 1, 1));
+    __m128i c = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(v, a), _mm_set1_epi16(1)), 8);
+    return _mm_or_si128(_mm_and_si128(alphaMask, v), _mm_andnot_si128(alphaMask, c));
+}
+
+static void premultiplyAlphaRG8_sse2(unsigned char* data, size_t pixelCount)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t i           = 0;
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        __m128i* p = (__m128i*)(data + i * 2);
+        __m128i px = _mm_loadu_si128(p);
+        __m128i lo = premultiplyRG16_sse2(_mm_unpacklo_epi8(px, zero));
+        __m128i hi = premultiplyRG16_sse2(_mm_unpackhi_epi8(px, zero));
+        _mm_storeu_si128(p, _mm_packus_epi16(lo, hi));
+    }
+    premultiplyAlphaRG8_scalar(data + i * 2, pixelCount - i);
+}
+
+// floor((c * 255 + a - 1) / a) is exact in float for all the results below 256
+static inline __m128i unpremultiplyChannel_sse2(__m128i c, __m128 a, __m128 bias)
+{
+    const __m128 k255 = _mm_set1_ps(255.0f);
+    __m128 q          = _mm_div_ps(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(c), k255), bias), a);
+    return _mm_cvttps_epi32(_mm_min_ps(q, k255));
+}
+
+static void reversePremultipliedAlphaRGBA8_sse2(unsigned char* data, size_t pixelCount)
+{
+    const __m128i mask8 = _mm_set1_epi32(0xFF);
+    const __m128i zero  = _mm_setzero_si128();
+    size_t i            = 0;
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        __m128i* p  = (__m128i*)(data + i * 4);
+        __m128i px  = _mm_loadu_si128(p);
+        __m128i a   = _mm_srli_epi32(px, 24);
+        __m128 af   = _mm_cvtepi32_ps(a);
+        __m128 bias = _mm_sub_ps(af, _mm_set1_ps(1.0f));
+        __m128i r   = unpremultiplyChannel_sse2(_mm_and_si128(px, mask8), af, bias);
+        __m128i g   = unpremultiplyChannel_sse2(_mm_and_si128(_mm_srli_epi32(px, 8), mask8), af, bias);
+        __m128i b   = unpremultiplyChannel_sse2(_mm_and_si128(_mm_srli_epi32(px, 16), mask8), af, bias);
+        __m128i res = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)),
+                                   _mm_or_si128(_mm_slli_epi32(b, 16), _mm_slli_epi32(a, 24)));
+        __m128i transparent = _mm_cmpeq_epi32(a, zero);
+        _mm_storeu_si128(p, _mm_or_si128(_mm_and_si128(transparent, px), _mm_andnot_si128(transparent, res)));
+    }
+    reversePremultipliedAlphaRGBA8_scalar(data + i * 4, pixelCount - i);
+}
+
+static void convertR8ToRGBA8_sse2(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    size_t i = 0;
+    for (; i + 16 <= dataLen; i += 16)
+    {
+        __m128i px = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i lo = _mm_unpacklo_epi8(px, px);
+        __m128i hi = _mm_unpackhi_epi8(px, px);
+        __m128i* o = (__m128i*)(outData + i * 4);
+        _mm_storeu_si128(o, _mm_unpacklo_epi16(lo, lo));
+        _mm_storeu_si128(o + 1, _mm_unpackhi_epi16(lo, lo));
+        _mm_storeu_si128(o + 2, _mm_unpacklo_epi16(hi, hi));
+        _mm_storeu_si128(o + 3, _mm_unpackhi_epi16(hi, hi));
+    }
+    convertR8ToRGBA8_scalar(data + i, dataLen - i, outData + i * 4);
+}
+
+static void convertRG8ToRGBA8_sse2(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    size_t i = 0;
+    for (; i + 16 <= dataLen; i += 16)
+    {
+        __m128i px = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i* o = (__m128i*)(outData + i * 2);
+        _mm_storeu_si128(o, _mm_unpacklo_epi16(px, px));
+        _mm_storeu_si128(o + 1, _mm_unpackhi_epi16(px, px));
+    }
+    convertRG8ToRGBA8_scalar(data + i, dataLen - i, outData + i * 2);
+}
+
+static void convertBGRA8ToRGBA8_sse2(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    const __m128i rbMask = _mm_set1_epi32(0x00FF00FF);
+    size_t i             = 0;
+    for (; i + 16 <= dataLen; i += 16)
+    {
+        __m128i px = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i rb = _mm_and_si128(px, rbMask);
+        __m128i ga = _mm_andnot_si128(rbMask, px);
+        rb         = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+        _mm_storeu_si128((__m128i*)(outData + i), _mm_or_si128(rb, ga));
+    }
+    convertBGRA8ToRGBA8_scalar(data + i, dataLen - i, outData + i);
+}
+
+// packs the low 16 bits of the 32 bit lanes
+static inline __m128i packLow16_sse2(__m128i lo, __m128i hi)
+{
+    lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+    hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+    return _mm_packs_epi32(lo, hi);
+}
+
+static inline __m128i packRGB565_sse2(__m128i px)
+{
+    __m128i r = _mm_slli_epi32(_mm_and_si128(px, _mm_set1_epi32(0xF8)), 8);
+    __m128i g = _mm_and_si128(_mm_srli_epi32(px, 5), _mm_set1_epi32(0x7E0));
+    __m128i b = _mm_and_si128(_mm_srli_epi32(px, 19), _mm_set1_epi32(0x1F));
+    return _mm_or_si128(_mm_or_si128(r, g), b);
+}
+
+static inline __m128i packRGBA4_sse2(__m128i px)
+{
+    __m128i r = _mm_slli_epi32(_mm_and_si128(px, _mm_set1_epi32(0xF0)), 8);
+    __m128i g = _mm_and_si128(_mm_srli_epi32(px, 4), _mm_set1_epi32(0xF00));
+    __m128i b = _mm_and_si128(_mm_srli_epi32(px, 16), _mm_set1_epi32(0xF0));
+    __m128i a = _mm_srli_epi32(px, 28);
+    return _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a));
+}
+
+static inline __m128i packRGB5A1_sse2(__m128i px)
+{
+    __m128i r = _mm_slli_epi32(_mm_and_si128(px, _mm_set1_epi32(0xF8)), 8);
+    __m128i g = _mm_and_si128(_mm_srli_epi32(px, 5), _mm_set1_epi32(0x7C0));
+    __m128i b = _mm_and_si128(_mm_srli_epi32(px, 18), _mm_set1_epi32(0x3E));
+    __m128i a = _mm_srli_epi32(px, 31);
+    return _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a));
+}
+
+template <__m128i (*pack)(__m128i), ConvertFunc scalar>
+static void convertRGBA8To16_sse2(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    size_t i = 0;
+    for (; i + 32 <= dataLen; i += 32)
+    {
+        __m128i lo = pack(_mm_loadu_si128((const __m128i*)(data + i)));
+        __m128i hi = pack(_mm_loadu_si128((const __m128i*)(data + i + 16)));
+        _mm_storeu_si128((__m128i*)(outData + i / 2), packLow16_sse2(lo, hi));
+    }
+    scalar(data + i, dataLen - i, outData + i / 2);
+}
+
+// 32 bit lanes with a 16 bit pixel each
+static inline __m128i unpackRGB565_sse2(__m128i p)
+{
+    __m128i r = _mm_srli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF800)), 8);
+    __m128i g = _mm_slli_epi32(_mm_and_si128(p, _mm_set1_epi32(0x7E0)), 5);
+    __m128i b = _mm_slli_epi32(_mm_and_si128(p, _mm_set1_epi32(0x1F)), 19);
+    return _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, _mm_set1_epi32((int)0xFF000000)));
+}
+
+// moves each nibble to the low half of its byte, then x * 17 == x | x << 4
+static inline __m128i unpackRGBA4_sse2(__m128i p)
+{
+    __m128i x = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 12), _mm_set1_epi32(0xF)),
+                             _mm_and_si128(p, _mm_set1_epi32(0xF00)));
+    x         = _mm_or_si128(x, _mm_and_si128(_mm_slli_epi32(p, 12), _mm_set1_epi32(0xF0000)));
+    x         = _mm_or_si128(x, _mm_srli_epi32(_mm_slli_epi32(p, 28), 4));
+    return _mm_or_si128(x, _mm_slli_epi32(x, 4));
+}
+
+static inline __m128i unpackRGB5A1_sse2(__m128i p)
+{
+    __m128i r = _mm_srli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF800)), 8);
+    __m128i g = _mm_slli_epi32(_mm_and_si128(p, _mm_set1_epi32(0x7C0)), 5);
+    __m128i b = _mm_slli_epi32(_mm_and_si128(p, _mm_set1_epi32(0x3E)), 18);
+    __m128i a = _mm_slli_epi32(_mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(p, _mm_set1_epi32(1))), 24);
+    return _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a));
+}
+
+template <__m128i (*unpack)(__m128i), ConvertFunc scalar>
+static void convert16ToRGBA8_sse2(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t i           = 0;
+    for (; i + 16 <= dataLen; i += 16)
+    {
+        __m128i px = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i* o = (__m128i*)(outData + i * 2);
+        _mm_storeu_si128(o, unpack(_mm_unpacklo_epi16(px, zero)));
+        _mm_storeu_si128(o + 1, unpack(_mm_unpackhi_epi16(px, zero)));
+    }
+    scalar(data + i, dataLen - i, outData + i * 2);
+}
+
+// SSE2 has no byte shuffle, RGB8 <-> RGBA8 stays scalar on this tier
+static const KernelTable s_sse2Kernels = {
+    premultiplyAlphaRGBA8_sse2,
+    premultiplyAlphaRG8_sse2,
+    reversePremultipliedAlphaRGBA8_sse2,
+    convertR8ToRGBA8_sse2,
+    convertRG8ToRGBA8_sse2,
+    convertRGB8ToRGBA8_scalar,
+    convertRGBA8ToRGB8_scalar,
+    convertBGRA8ToRGBA8_sse2,
+    convertRGBA8To16_sse2<packRGB565_sse2, convertRGBA8ToRGB565_scalar>,
+    convertRGBA8To16_sse2<packRGBA4_sse2, convertRGBA8ToRGBA4_scalar>,
+    convertRGBA8To16_sse2<packRGB5A1_sse2, convertRGBA8ToRGB5A1_scalar>,
+    convert16ToRGBA8_sse2<unpackRGB565_sse2, convertRGB565ToRGBA8_scalar>,
+    convert16ToRGBA8_sse2<unpackRGBA4_sse2, convertRGBA4ToRGBA8_scalar>,
+    convert16ToRGBA8_sse2<unpackRGB5A1_sse2, convertRGB5A1ToRGBA8_scalar>,
+};
+#endif  // AX_SSE_INTRINSICS
+
+#if AX_PIXEL_KERNELS_AVX2
+//////////////////////////////////////////////////////////////////////////
+// AVX2 kernels, 8 RGBA8 pixels per vector, selected at runtime
+
+static bool detectAVX2()
+{
+#    if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7)
+        return false;
+    __cpuid(regs, 1);
+    const int osxsaveAndAVX = (1 << 27) | (1 << 28);
+    if ((regs[2] & osxsaveAndAVX) != osxsaveAndAVX || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#    else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#    endif
+}
+
+AX_TARGET_AVX2 static inline __m256i premultiplyRGBA16_avx2(__m256i v)
+{
+    const __m256i alphaMask = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+    __m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(v, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    a         = _mm256_add_epi16(a, _mm256_set1_epi16(1));
+    __m256i c = _mm256_srli_epi16(_mm256_mullo_epi16(v, a), 8);
+    return _mm256_blendv_epi8(c, v, alphaMask);
+}
+
+AX_TARGET_AVX2 static void premultiplyAlphaRGBA8_avx2(unsigned char* data, size_t pixelCount)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i           = 0;
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        __m256i* p = (__m256i*)(data + i * 4);
+        __m256i px = _mm256_loadu_si256(p);
+        __m256i lo = premultiplyRGBA16_avx2(_mm256_unpacklo_epi8(px, zero));
+        __m256i hi = premultiplyRGBA16_avx2(_mm256_unpackhi_epi8(px, zero));
+        _mm256_storeu_si256(p, _mm256_packus_epi16(lo, hi));
+    }
+    premultiplyAlphaRGBA8_scalar(data + i * 4, pixelCount - i);
+}
+
+AX_TARGET_AVX2 static inline __m256i premultiplyRG16_avx2(__m256i v)
+{
+    const __m256i alphaMask = _mm256_set1_epi32((int)0xFFFF0000);
+    __m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(v, _MM_SHUFFLE(3, 3, 1, 1)), _MM_SHUFFLE(3, 3, 1, 1));
+    __m256i c = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(v, a), _mm256_set1_epi16(1)), 8);
+    return _mm256_blendv_epi8(c, v, alphaMask);
+}
+
+AX_TARGET_AVX2 static void premultiplyAlphaRG8_avx2(unsigned char* data, size_t pixelCount)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i           = 0;
+    for (; i + 16 <= pixelCount; i += 16)
+    {
+        __m256i* p = (__m256i*)(data + i * 2);
+        __m256i px = _mm256_loadu_si256(p);
+        __m256i lo = premultiplyRG16_avx2(_mm256_unpacklo_epi8(px, zero));
+        __m256i hi = premultiplyRG16_avx2(_mm256_unpackhi_epi8(px, zero));
+        _mm256_storeu_si256(p, _mm256_packus_epi16(lo, hi));
+    }
+    premultiplyAlphaRG8_scalar(data + i * 2, pixelCount - i);
+}
+
+AX_TARGET_AVX2 static inline __m256i unpremultiplyChannel_avx2(__m256i c, __m256 a, __m256 bias)
+{
+    const __m256 k255 = _mm256_set1_ps(255.0f);
+    __m256 q          = _mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(c), k255), bias), a);
+    return _mm256_cvttps_epi32(_mm256_min_ps(q, k255));
+}
+
+AX_TARGET_AVX2 static void reversePremultipliedAlphaRGBA8_avx2(unsigned char* data, size_t pixelCount)
+{
+    const __m256i mask8 = _mm256_set1_epi32(0xFF);
+    size_t i            = 0;
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        __m256i* p  = (__m256i*)(data + i * 4);
+        __m256i px  = _mm256_loadu_si256(p);
+        __m256i a   = _mm256_srli_epi32(px, 24);
+        __m256 af   = _mm256_cvtepi32_ps(a);
+        __m256 bias = _mm256_sub_ps(af, _mm256_set1_ps(1.0f));
+        __m256i r   = unpremultiplyChannel_avx2(_mm256_and_si256(px, mask8), af, bias);
+        __m256i g   = unpremultiplyChannel_avx2(_mm256_and_si256(_mm256_srli_epi32(px, 8), mask8), af, bias);
+        __m256i b   = unpremultiplyChannel_avx2(_mm256_and_si256(_mm256_srli_epi32(px, 16), mask8), af, bias);
+        __m256i res = _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)),
+                                      _mm256_or_si256(_mm256_slli_epi32(b, 16), _mm256_slli_epi32(a, 24)));
+        __m256i transparent = _mm256_cmpeq_epi32(a, _mm256_setzero_si256());
+        _mm256_storeu_si256(p, _mm256_blendv_epi8(res, px, transparent));
+    }
+    reversePremultipliedAlphaRGBA8_scalar(data + i * 4, pixelCount - i);
+}
+
+AX_TARGET_AVX2 static void convertR8ToRGBA8_avx2(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    size_t i = 0;
+    for (; i + 8 <= dataLen; i += 8)
+    {
+        __m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(data + i)));
+        v         = _mm256_or_si256(v, _mm256_slli_epi32(v, 8));
+        v         = _mm256_or_si256(v, _mm256_slli_epi32(v, 16));
+        _mm256_storeu_si256((__m256i*)(outData + i * 4), v);
+    }
+    convertR8ToRGBA8_scalar(data + i, dataLen - i, outData + i * 4);
+}
+
+AX_TARGET_AVX2 static void convertRG8ToRGBA8_avx2(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    size_t i = 0;
+    for (; i + 16 <= dataLen; i += 16)
+    {
+        __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(data + i)));
+        _mm256_storeu_si256((__m256i*)(outData + i * 2), _mm256_or_si256(v, _mm256_slli_epi32(v, 16)));
+    }
+    convertRG8ToRGBA8_scalar(data + i, dataLen - i, outData + i * 2);
+}
+
+AX_TARGET_AVX2 static void convertRGB8ToRGBA8_avx2(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,  //
+                                             0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m256i alpha   = _mm256_set1_epi32((int)0xFF000000);
+    const size_t pixelLen = dataLen / 3;
+    size_t i              = 0;
+    // the loads cover 4 bytes past the last 8 pixels
+    for (; i + 10 <= pixelLen; i += 8)
+    {
+        const unsigned char* src = data + i * 3;
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)src)),
+                                            _mm_loadu_si128((const __m128i*)(src + 12)), 1);
+        v         = _mm256_or_si256(_mm256_shuffle_epi8(v, shuffle), alpha);
+        _mm256_storeu_si256((__m256i*)(outData + i * 4), v);
+    }
+    convertRGB8ToRGBA8_scalar(data + i * 3, dataLen - i * 3, outData + i * 4);
+}
+
+AX_TARGET_AVX2 static void convertRGBA8ToRGB8_avx2(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,  //
+                                             0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    const size_t pixelLen = dataLen / 4;
+    size_t i              = 0;
+    // the stores cover 4 bytes past the last 8 pixels, they are written again by the next iteration
+    for (; i + 10 <= pixelLen; i += 8)
+    {
+        __m256i v = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(data + i * 4)), shuffle);
+        unsigned char* dst = outData + i * 3;
+        _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(v));
+        _mm_storeu_si128((__m128i*)(dst + 12), _mm256_extracti128_si256(v, 1));
+    }
+    convertRGBA8ToRGB8_scalar(data + i * 4, dataLen - i * 4, outData + i * 3);
+}
+
+AX_TARGET_AVX2 static void convertBGRA8ToRGBA8_avx2(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,  //
+                                             2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    size_t i              = 0;
+    for (; i + 32 <= dataLen; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+        _mm256_storeu_si256((__m256i*)(outData + i), _mm256_shuffle_epi8(v, shuffle));
+    }
+    convertBGRA8ToRGBA8_scalar(data + i, dataLen - i, outData + i);
+}
+
+AX_TARGET_AVX2 static inline __m256i packRGB565_avx2(__m256i px)
+{
+    __m256i r = _mm256_slli_epi32(_mm256_and_si256(px, _mm256_set1_epi32(0xF8)), 8);
+    __m256i g = _mm256_and_si256(_mm256_srli_epi32(px, 5), _mm256_set1_epi32(0x7E0));
+    __m256i b = _mm256_and_si256(_mm256_srli_epi32(px, 19), _mm256_set1_epi32(0x1F));
+    return _mm256_or_si256(_mm256_or_si256(r, g), b);
+}
+
+AX_TARGET_AVX2 static inline __m256i packRGBA4_avx2(__m256i px)
+{
+    __m256i r = _mm256_slli_epi32(_mm256_and_si256(px, _mm256_set1_epi32(0xF0)), 8);
+    __m256i g = _mm256_and_si256(_mm256_srli_epi32(px, 4), _mm256_set1_epi32(0xF00));
+    __m256i b = _mm256_and_si256(_mm256_srli_epi32(px, 16), _mm256_set1_epi32(0xF0));
+    __m256i a = _mm256_srli_epi32(px, 28);
+    return _mm256_or_si256(_mm256_or_si256(r, g), _mm256_or_si256(b, a));
+}
+
+AX_TARGET_AVX2 static inline __m256i packRGB5A1_avx2(__m256i px)
+{
+    __m256i r = _mm256_slli_epi32(_mm256_and_si256(px, _mm256_set1_epi32(0xF8)), 8);
+    __m256i g = _mm256_and_si256(_mm256_srli_epi32(px, 5), _mm256_set1_epi32(0x7C0));
+    __m256i b = _mm256_and_si256(_mm256_srli_epi32(px, 18), _mm256_set1_epi32(0x3E));
+    __m256i a = _mm256_srli_epi32(px, 31);
+    return _mm256_or_si256(_mm256_or_si256(r, g), _mm256_or_si256(b, a));
+}
+
+template <__m256i (*pack)(__m256i), ConvertFunc scalar>
+AX_TARGET_AVX2 static void convertRGBA8To16_avx2(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    size_t i = 0;
+    for (; i + 64 <= dataLen; i += 64)
+    {
+        // the values fit in 16 bits unsigned, packus keeps them and the lane interleave is undone by the permute
+        __m256i lo = pack(_mm256_loadu_si256((const __m256i*)(data + i)));
+        __m256i hi = pack(_mm256_loadu_si256((const __m256i*)(data + i + 32)));
+        __m256i v  = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256((__m256i*)(outData + i / 2), v);
+    }
+    scalar(data + i, dataLen - i, outData + i / 2);
+}
+
+AX_TARGET_AVX2 static inline __m256i unpackRGB565_avx2(__m256i p)
+{
+    __m256i r = _mm256_srli_epi32(_mm256_and_si256(p, _mm256_set1_epi32(0xF800)), 8);
+    __m256i g = _mm256_slli_epi32(_mm256_and_si256(p, _mm256_set1_epi32(0x7E0)), 5);
+    __m256i b = _mm256_slli_epi32(_mm256_and_si256(p, _mm256_set1_epi32(0x1F)), 19);
+    return _mm256_or_si256(_mm256_or_si256(r, g), _mm256_or_si256(b, _mm256_set1_epi32((int)0xFF000000)));
+}
+
+AX_TARGET_AVX2 static inline __m256i unpackRGBA4_avx2(__m256i p)
+{
+    __m256i x = _mm256_and_si256(_mm256_srli_epi32(p, 12), _mm256_set1_epi32(0xF));
+    x         = _mm256_or_si256(x, _mm256_and_si256(p, _mm256_set1_epi32(0xF00)));
+    x         = _mm256_or_si256(x, _mm256_and_si256(_mm256_slli_epi32(p, 12), _mm256_set1_epi32(0xF0000)));
+    x         = _mm256_or_si256(x, _mm256_srli_epi32(_mm256_slli_epi32(p, 28), 4));
+    return _mm256_or_si256(x, _mm256_slli_epi32(x, 4));
+}
+
+AX_TARGET_AVX2 static inline __m256i unpackRGB5A1_avx2(__m256i p)
+{
+    __m256i r = _mm256_srli_epi32(_mm256_and_si256(p, _mm256_set1_epi32(0xF800)), 8);
+    __m256i g = _mm256_slli_epi32(_mm256_and_si256(p, _mm256_set1_epi32(0x7C0)), 5);
+    __m256i b = _mm256_slli_epi32(_mm256_and_si256(p, _mm256_set1_epi32(0x3E)), 18);
+    __m256i a = _mm256_slli_epi32(_mm256_sub_epi32(_mm256_setzero_si256(), _mm256_and_si256(p, _mm256_set1_epi32(1))), 24);
+    return _mm256_or_si256(_mm256_or_si256(r, g), _mm256_or_si256(b, a));
+}
+
+template <__m256i (*unpack)(__m256i), ConvertFunc scalar>
+AX_TARGET_AVX2 static void convert16ToRGBA8_avx2(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    size_t i = 0;
+    for (; i + 16 <= dataLen; i += 16)
+    {
+        __m256i p = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(data + i)));
+        _mm256_storeu_si256((__m256i*)(outData + i * 2), unpack(p));
+    }
+    scalar(data + i, dataLen - i, outData + i * 2);
+}
+
+static const KernelTable s_avx2Kernels = {
+    premultiplyAlphaRGBA8_avx2,
+    premultiplyAlphaRG8_avx2,
+    reversePremultipliedAlphaRGBA8_avx2,
+    convertR8ToRGBA8_avx2,
+    convertRG8ToRGBA8_avx2,
+    convertRGB8ToRGBA8_avx2,
+    convertRGBA8ToRGB8_avx2,
+    convertBGRA8ToRGBA8_avx2,
+    convertRGBA8To16_avx2<packRGB565_avx2, convertRGBA8ToRGB565_scalar>,
+    convertRGBA8To16_avx2<packRGBA4_avx2, convertRGBA8ToRGBA4_scalar>,
+    convertRGBA8To16_avx2<packRGB5A1_avx2, convertRGBA8ToRGB5A1_scalar>,
+    convert16ToRGBA8_avx2<unpackRGB565_avx2, convertRGB565ToRGBA8_scalar>,
+    convert16ToRGBA8_avx2<unpackRGBA4_avx2, convertRGBA4ToRGBA8_scalar>,
+    convert16ToRGBA8_avx2<unpackRGB5A1_avx2, convertRGB5A1ToRGBA8_scalar>,
+};
+#endif  // AX_PIXEL_KERNELS_AVX2
+
+#if defined(AX_NEON_INTRINSICS)
+//////////////////////////////////////////////////////////////////////////
+// NEON kernels, 16 pixels per de-interleaved load
+
+static inline uint8x8_t premultiplyChannel_neon(uint8x8_t c, uint16x8_t a1)
+{
+    return vshrn_n_u16(vmulq_u16(vmovl_u8(c), a1), 8);
+}
+
+static void premultiplyAlphaRGBA8_neon(unsigned char* data, size_t pixelCount)
+{
+    const uint16x8_t one = vdupq_n_u16(1);
+    size_t i             = 0;
+    for (; i + 16 <= pixelCount; i += 16)
+    {
+        uint8x16x4_t px = vld4q_u8(data + i * 4);
+        uint16x8_t alo  = vaddw_u8(one, vget_low_u8(px.val[3]));
+        uint16x8_t ahi  = vaddw_u8(one, vget_high_u8(px.val[3]));
+        for (int c = 0; c < 3; ++c)
+            px.val[c] = vcombine_u8(premultiplyChannel_neon(vget_low_u8(px.val[c]), alo),
+                                    premultiplyChannel_neon(vget_high_u8(px.val[c]), ahi));
+        vst4q_u8(data + i * 4, px);
+    }
+    premultiplyAlphaRGBA8_scalar(data + i * 4, pixelCount - i);
+}
+
+static void premultiplyAlphaRG8_neon(unsigned char* data, size_t pixelCount)
+{
+    const uint16x8_t one = vdupq_n_u16(1);
+    size_t i             = 0;
+    for (; i + 16 <= pixelCount; i += 16)
+    {
+        uint8x16x2_t px = vld2q_u8(data + i * 2);
+        uint8x8_t lo    = vshrn_n_u16(vaddq_u16(vmull_u8(vget_low_u8(px.val[0]), vget_low_u8(px.val[1])), one), 8);
+        uint8x8_t hi    = vshrn_n_u16(vaddq_u16(vmull_u8(vget_high_u8(px.val[0]), vget_high_u8(px.val[1])), one), 8);
+        px.val[0]       = vcombine_u8(lo, hi);
+        vst2q_u8(data + i * 2, px);
+    }
+    premultiplyAlphaRG8_scalar(data + i * 2, pixelCount - i);
+}
+
+#    if AX_64BITS
+// floor((c * 255 + a - 1) / a) is exact in float for all the results below 256, vdivq_f32 is AArch64 only
+static inline uint32x4_t unpremultiplyChannel_neon(uint16x4_t c, float32x4_t a, float32x4_t bias)
+{
+    const float32x4_t k255 = vdupq_n_f32(255.0f);
+    float32x4_t q          = vdivq_f32(vmlaq_f32(bias, vcvtq_f32_u32(vmovl_u16(c)), k255), a);
+    return vcvtq_u32_f32(vminq_f32(q, k255));
+}
+
+static void reversePremultipliedAlphaRGBA8_neon(unsigned char* data, size_t pixelCount)
+{
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    size_t i              = 0;
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        uint8x8x4_t px     = vld4_u8(data + i * 4);
+        uint16x8_t a16     = vmovl_u8(px.val[3]);
+        float32x4_t alo    = vcvtq_f32_u32(vmovl_u16(vget_low_u16(a16)));
+        float32x4_t ahi    = vcvtq_f32_u32(vmovl_u16(vget_high_u16(a16)));
+        float32x4_t biaslo = vsubq_f32(alo, one);
+        float32x4_t biashi = vsubq_f32(ahi, one);
+        uint8x8_t transparent = vceq_u8(px.val[3], vdup_n_u8(0));
+        for (int c = 0; c < 3; ++c)
+        {
+            uint16x8_t c16 = vmovl_u8(px.val[c]);
+            uint16x8_t q   = vcombine_u16(vmovn_u32(unpremultiplyChannel_neon(vget_low_u16(c16), alo, biaslo)),
+                                          vmovn_u32(unpremultiplyChannel_neon(vget_high_u16(c16), ahi, biashi)));
+            px.val[c]      = vbsl_u8(transparent, px.val[c], vmovn_u16(q));
+        }
+        vst4_u8(data + i * 4, px);
+    }
+    reversePremultipliedAlphaRGBA8_scalar(data + i * 4, pixelCount - i);
+}
+#    endif
+
+static void convertR8ToRGBA8_neon(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    size_t i = 0;
+    for (; i + 16 <= dataLen; i += 16)
+    {
+        uint8x16_t v = vld1q_u8(data + i);
+        uint8x16x4_t px;
+        px.val[0] = px.val[1] = px.val[2] = px.val[3] = v;
+        vst4q_u8(outData + i * 4, px);
+    }
+    convertR8ToRGBA8_scalar(data + i, dataLen - i, outData + i * 4);
+}
+
+static void convertRG8ToRGBA8_neon(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    size_t i = 0;
+    for (; i + 32 <= dataLen; i += 32)
+    {
+        uint8x16x2_t v = vld2q_u8(data + i);
+        uint8x16x4_t px;
+        px.val[0] = px.val[2] = v.val[0];
+        px.val[1] = px.val[3] = v.val[1];
+        vst4q_u8(outData + i * 2, px);
+    }
+    convertRG8ToRGBA8_scalar(data + i, dataLen - i, outData + i * 2);
+}
+
+static void convertRGB8ToRGBA8_neon(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    const size_t pixelLen = dataLen / 3;
+    size_t i              = 0;
+    for (; i + 16 <= pixelLen; i += 16)
+    {
+        uint8x16x3_t v = vld3q_u8(data + i * 3);
+        uint8x16x4_t px;
+        px.val[0] = v.val[0];
+        px.val[1] = v.val[1];
+        px.val[2] = v.val[2];
+        px.val[3] = vdupq_n_u8(0xFF);
+        vst4q_u8(outData + i * 4, px);
+    }
+    convertRGB8ToRGBA8_scalar(data + i * 3, dataLen - i * 3, outData + i * 4);
+}
+
+static void convertRGBA8ToRGB8_neon(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    const size_t pixelLen = dataLen / 4;
+    size_t i              = 0;
+    for (; i + 16 <= pixelLen; i += 16)
+    {
+        uint8x16x4_t v = vld4q_u8(data + i * 4);
+        uint8x16x3_t px;
+        px.val[0] = v.val[0];
+        px.val[1] = v.val[1];
+        px.val[2] = v.val[2];
+        vst3q_u8(outData + i * 3, px);
+    }
+    convertRGBA8ToRGB8_scalar(data + i * 4, dataLen - i * 4, outData + i * 3);
+}
+
+static void convertBGRA8ToRGBA8_neon(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    size_t i = 0;
+    for (; i + 64 <= dataLen; i += 64)
+    {
+        uint8x16x4_t px = vld4q_u8(data + i);
+        uint8x16_t b    = px.val[0];
+        px.val[0]       = px.val[2];
+        px.val[2]       = b;
+        vst4q_u8(outData + i, px);
+    }
+    convertBGRA8ToRGBA8_scalar(data + i, dataLen - i, outData + i);
+}
+
+static inline uint16x8_t packRGB565_neon(uint8x8x4_t px)
+{
+    uint16x8_t r = vshll_n_u8(vand_u8(px.val[0], vdup_n_u8(0xF8)), 8);
+    uint16x8_t g = vshll_n_u8(vand_u8(px.val[1], vdup_n_u8(0xFC)), 3);
+    uint16x8_t b = vmovl_u8(vshr_n_u8(px.val[2], 3));
+    return vorrq_u16(vorrq_u16(r, g), b);
+}
+
+static inline uint16x8_t packRGBA4_neon(uint8x8x4_t px)
+{
+    uint16x8_t r = vshll_n_u8(vand_u8(px.val[0], vdup_n_u8(0xF0)), 8);
+    uint16x8_t g = vshll_n_u8(vand_u8(px.val[1], vdup_n_u8(0xF0)), 4);
+    uint16x8_t b = vmovl_u8(vand_u8(px.val[2], vdup_n_u8(0xF0)));
+    uint16x8_t a = vmovl_u8(vshr_n_u8(px.val[3], 4));
+    return vorrq_u16(vorrq_u16(r, g), vorrq_u16(b, a));
+}
+
+static inline uint16x8_t packRGB5A1_neon(uint8x8x4_t px)
+{
+    uint16x8_t r = vshll_n_u8(vand_u8(px.val[0], vdup_n_u8(0xF8)), 8);
+    uint16x8_t g = vshll_n_u8(vand_u8(px.val[1], vdup_n_u8(0xF8)), 3);
+    uint16x8_t b = vshll_n_u8(vshr_n_u8(px.val[2], 3), 1);
+    uint16x8_t a = vmovl_u8(vshr_n_u8(px.val[3], 7));
+    return vorrq_u16(vorrq_u16(r, g), vorrq_u16(b, a));
+}
+
+template <uint16x8_t (*pack)(uint8x8x4_t), ConvertFunc scalar>
+static void convertRGBA8To16_neon(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    size_t i = 0;
+    for (; i + 32 <= dataLen; i += 32)
+        vst1q_u16((uint16_t*)(outData + i / 2), pack(vld4_u8(data + i)));
+    scalar(data + i, dataLen - i, outData + i / 2);
+}
+
+static inline uint8x8x4_t unpackRGB565_neon(uint16x8_t p)
+{
+    uint8x8x4_t px;
+    px.val[0] = vand_u8(vshrn_n_u16(p, 8), vdup_n_u8(0xF8));
+    px.val[1] = vand_u8(vshrn_n_u16(p, 3), vdup_n_u8(0xFC));
+    px.val[2] = vshl_n_u8(vmovn_u16(p), 3);
+    px.val[3] = vdup_n_u8(0xFF);
+    return px;
+}
+
+static inline uint8x8x4_t unpackRGBA4_neon(uint16x8_t p)
+{
+    // x * 17 == x | x << 4
+    const uint8x8_t mask4 = vdup_n_u8(0x0F);
+    uint8x8x4_t px;
+    px.val[0] = vmovn_u16(vshrq_n_u16(p, 12));
+    px.val[1] = vand_u8(vshrn_n_u16(p, 8), mask4);
+    px.val[2] = vand_u8(vshrn_n_u16(p, 4), mask4);
+    px.val[3] = vand_u8(vmovn_u16(p), mask4);
+    for (int c = 0; c < 4; ++c)
+        px.val[c] = vorr_u8(px.val[c], vshl_n_u8(px.val[c], 4));
+    return px;
+}
+
+static inline uint8x8x4_t unpackRGB5A1_neon(uint16x8_t p)
+{
+    const uint8x8_t mask5 = vdup_n_u8(0xF8);
+    uint8x8_t low         = vmovn_u16(p);
+    uint8x8x4_t px;
+    px.val[0] = vand_u8(vshrn_n_u16(p, 8), mask5);
+    px.val[1] = vand_u8(vshrn_n_u16(p, 3), mask5);
+    px.val[2] = vand_u8(vshl_n_u8(low, 2), mask5);
+    px.val[3] = vtst_u8(low, vdup_n_u8(1));
+    return px;
+}
+
+template <uint8x8x4_t (*unpack)(uint16x8_t), ConvertFunc scalar>
+static void convert16ToRGBA8_neon(const unsigned char* data, size_t dataLen, unsigned char* outData)
+{
+    size_t i = 0;
+    for (; i + 16 <= dataLen; i += 16)
+        vst4_u8(outData + i * 2, unpack(vld1q_u16((const uint16_t*)(data + i))));
+    scalar(data + i, dataLen - i, outData + i * 2);
+}
+
+static const KernelTable s_neonKernels = {
+    premultiplyAlphaRGBA8_neon,
+    premultiplyAlphaRG8_neon,
+#    if AX_64BITS
+    reversePremultipliedAlphaRGBA8_neon,
+#    else
+    reversePremultipliedAlphaRGBA8_scalar,
+#    endif
+    convertR8ToRGBA8_neon,
+    convertRG8ToRGBA8_neon,
+    convertRGB8ToRGBA8_neon,
+    convertRGBA8ToRGB8_neon,
+    convertBGRA8ToRGBA8_neon,
+    convertRGBA8To16_neon<packRGB565_neon, convertRGBA8ToRGB565_scalar>,
+    convertRGBA8To16_neon<packRGBA4_neon, convertRGBA8ToRGBA4_scalar>,
+    convertRGBA8To16_neon<packRGB5A1_neon, convertRGBA8ToRGB5A1_scalar>,
+    convert16ToRGBA8_neon<unpackRGB565_neon, convertRGB565ToRGBA8_scalar>,
+    convert16ToRGBA8_neon<unpackRGBA4_neon, convertRGBA4ToRGBA8_scalar>,
+    convert16ToRGBA8_neon<unpackRGB5A1_neon, convertRGB5A1ToRGBA8_scalar>,
+};
+#endif  // AX_NEON_INTRINSICS
+
+//////////////////////////////////////////////////////////////////////////
+// dispatch
+
+static const KernelTable* s_kernelTables[(int)ISA::COUNT] = {
+    &s_scalarKernels,
+#if defined(AX_SSE_INTRINSICS)
+    &s_sse2Kernels,
+#else
+    nullptr,
+#endif
+#if AX_PIXEL_KERNELS_AVX2
+    &s_avx2Kernels,
+#else
+    nullptr,
+#endif
+#if defined(AX_NEON_INTRINSICS)
+    &s_neonKernels,
+#else
+    nullptr,
+#endif
+};
+
+static const char* s_isaNames[(int)ISA::COUNT] = {"scalar", "SSE2", "AVX2", "NEON"};
+
+static std::atomic<int> s_activeISA{-1};
+
+bool isSupported(ISA isa)
+{
+    switch (isa)
+    {
+    case ISA::SCALAR:
+        return true;
+#if defined(AX_SSE_INTRINSICS)
+    case ISA::SSE2:
+        return true;
+#endif
+#if AX_PIXEL_KERNELS_AVX2
+    case ISA::AVX2:
+    {
+        static const bool s_hasAVX2 = detectAVX2();
+        return s_hasAVX2;
+    }
+#endif
+#if defined(AX_NEON_INTRINSICS)
+    case ISA::NEON:
+#    if AX_64BITS
+        return true;
+#    else
+        return MathUtil::isNeon32Enabled();
+#    endif
+#endif
+    default:
+        return false;
+    }
+}
+
+ISA getISA()
+{
+    int isa = s_activeISA.load(std::memory_order_relaxed);
+    if (AX_UNLIKELY(isa < 0))
+    {
+        const ISA preferred[] = {ISA::AVX2, ISA::SSE2, ISA::NEON};
+        isa                   = (int)ISA::SCALAR;
+        for (auto candidate : preferred)
+        {
+            if (isSupported(candidate))
+            {
+                isa = (int)candidate;
+                break;
+            }
+        }
+        s_activeISA.store(isa, std::memory_order_relaxed);
+    }
+    return (ISA)isa;
+}
+
+bool setISA(ISA isa)
+{
+    if (!isSupported(isa))
+        return false;
+    s_activeISA.store((int)isa, std::memory_order_relaxed);
+    return true;
+}
+
+const KernelTable& getKernels()
+{
+    return *s_kernelTables[(int)getISA()];
+}
+
+const char* getISAName(ISA isa)
+{
+    return isa < ISA::COUNT ? s_isaNames[(int)isa] : "unknown";
+}
+
+}  // namespace PixelKernels
+}  // namespace backend
+}  // namespace ax
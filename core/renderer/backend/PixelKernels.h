@@ -0,0 +1,94 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "platform/PlatformMacros.h"
+
+namespace ax
+{
+
+namespace backend
+{
+/**
+ * Vectorized pixel kernels used by Image and PixelFormatUtils.
+ *
+ * Every kernel has a scalar implementation which is bit exact with the SIMD ones, the best kernels supported
+ * by the running CPU are selected on first use: SSE2 and NEON follow the engine ISA chosen at compile time,
+ * AVX2 is detected at runtime on x86.
+ */
+namespace PixelKernels
+{
+enum class ISA
+{
+    SCALAR,
+    SSE2,
+    AVX2,
+    NEON,
+    COUNT
+};
+
+/** Converts dataLen bytes of pixels to outData, same contract as the PixelFormatUtils converters. */
+typedef void (*ConvertFunc)(const unsigned char* data, size_t dataLen, unsigned char* outData);
+/** Processes pixelCount pixels in place. */
+typedef void (*InplaceFunc)(unsigned char* data, size_t pixelCount);
+
+struct KernelTable
+{
+    InplaceFunc premultiplyAlphaRGBA8;
+    InplaceFunc premultiplyAlphaRG8;
+    /** Pixels with zero alpha are left untouched. */
+    InplaceFunc reversePremultipliedAlphaRGBA8;
+
+    ConvertFunc convertR8ToRGBA8;
+    ConvertFunc convertRG8ToRGBA8;
+    ConvertFunc convertRGB8ToRGBA8;
+    ConvertFunc convertRGBA8ToRGB8;
+    ConvertFunc convertBGRA8ToRGBA8;
+    ConvertFunc convertRGBA8ToRGB565;
+    ConvertFunc convertRGBA8ToRGBA4;
+    ConvertFunc convertRGBA8ToRGB5A1;
+    ConvertFunc convertRGB565ToRGBA8;
+    ConvertFunc convertRGBA4ToRGBA8;
+    ConvertFunc convertRGB5A1ToRGBA8;
+};
+
+/** Gets the kernels of the active ISA. */
+AX_DLL const KernelTable& getKernels();
+
+/** Gets the active ISA, the best one supported by the running CPU unless setISA was called. */
+AX_DLL ISA getISA();
+
+/** Forces the kernels of the specified ISA, mainly for tests and benchmarks. Returns false if it is not supported. */
+AX_DLL bool setISA(ISA isa);
+
+AX_DLL bool isSupported(ISA isa);
+
+AX_DLL const char* getISAName(ISA isa);
+}  // namespace PixelKernels
+}  // namespace backend
+}  // namespace ax
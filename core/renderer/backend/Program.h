@@ -66,6 +66,15 @@ enum class VertexLayoutType
  * @{
  */
 
+/**
+ * The linked program as the driver can save and restore it, see Program::getBinary.
+ */
+struct ProgramBinary
+{
+    uint32_t format = 0;  ///< Driver specific, i.e. the GLenum of glGetProgramBinary.
+    std::vector<uint8_t> data;
+};
+
 /**
  * A program.
  */
@@ -169,7 +178,25 @@ public:
 
     inline VertexLayout* getVertexLayout() const { return _vertexLayout; }
 
+    /**
+     * Get the binary of the linked program, to restore it with DriverBase::newProgram on a later launch.
+     * @return false if the driver doesn't support program binaries.
+     */
+    virtual bool getBinary(ProgramBinary& /*binary*/) const { return false; }
+
+    /**
+     * Whether the driver finished compiling a program created by DriverBase::newProgramAsync,
+     * polling it doesn't wait for the driver.
+     */
+    virtual bool isCompileCompleted() const { return true; }
+
 protected:
+    /**
+     * Waits for the driver to compile a program created by DriverBase::newProgramAsync and
+     * reflects its attributes and uniforms, it must be called before the program is used.
+     * @return false if compiling failed.
+     */
+    virtual bool completeCompile() { return true; }
 
     void setProgramIds(uint32_t progType, uint64_t progId);
 
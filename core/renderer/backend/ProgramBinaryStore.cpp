@@ -0,0 +1,78 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ProgramBinaryStore.h"
+#include "platform/FileUtils.h"
+
+#include "fmt/format.h"
+
+NS_AX_BACKEND_BEGIN
+
+ProgramBinaryFileStore::ProgramBinaryFileStore(std::string_view directory) : _directory(directory)
+{
+    if (_directory.empty())
+        _directory = FileUtils::getInstance()->getWritablePath() + "programs/";
+    else if (_directory.back() != '/')
+        _directory.push_back('/');
+}
+
+std::string ProgramBinaryFileStore::getEntryPath(uint64_t key) const
+{
+    return fmt::format("{}{:016x}.bin", _directory, key);
+}
+
+bool ProgramBinaryFileStore::load(uint64_t key, std::vector<uint8_t>& entry)
+{
+    auto fileUtils = FileUtils::getInstance();
+    auto path      = getEntryPath(key);
+    if (!fileUtils->isFileExist(path))
+        return false;
+    return fileUtils->getContents(path, &entry) == FileUtils::Status::OK;
+}
+
+bool ProgramBinaryFileStore::save(uint64_t key, const std::vector<uint8_t>& entry)
+{
+    auto fileUtils = FileUtils::getInstance();
+    if (!_directoryCreated)
+        _directoryCreated = fileUtils->createDirectories(_directory);
+
+    // a partly written file must not take the place of the entry, i.e. when the app is killed meanwhile
+    auto path     = getEntryPath(key);
+    auto tempPath = path + ".tmp";
+    if (!FileUtils::writeBinaryToFile(entry.data(), entry.size(), tempPath))
+        return false;
+    if (fileUtils->isFileExist(path))
+        fileUtils->removeFile(path);
+    return fileUtils->renameFile(tempPath, path);
+}
+
+void ProgramBinaryFileStore::remove(uint64_t key)
+{
+    auto fileUtils = FileUtils::getInstance();
+    auto path      = getEntryPath(key);
+    if (fileUtils->isFileExist(path))
+        fileUtils->removeFile(path);
+}
+
+NS_AX_BACKEND_END
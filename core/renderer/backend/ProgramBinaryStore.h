@@ -0,0 +1,87 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "Macros.h"
+#include "platform/PlatformMacros.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+NS_AX_BACKEND_BEGIN
+/**
+ * @addtogroup _backend
+ * @{
+ */
+
+/**
+ * Keeps the binaries of linked programs between launches, see ProgramManager::setProgramBinaryStore.
+ * The entries are opaque to the store, ProgramManager checks them and removes the ones which are
+ * corrupted or were rejected by the driver.
+ */
+class AX_DLL ProgramBinaryStore
+{
+public:
+    virtual ~ProgramBinaryStore() = default;
+
+    /**
+     * Read an entry.
+     * @return false if there is no entry for key.
+     */
+    virtual bool load(uint64_t key, std::vector<uint8_t>& entry) = 0;
+
+    /** Write an entry, replacing any entry for key. */
+    virtual bool save(uint64_t key, const std::vector<uint8_t>& entry) = 0;
+
+    /** Remove the entry for key, if any. */
+    virtual void remove(uint64_t key) = 0;
+};
+
+/**
+ * Stores each entry in a file of a directory, by default programs/ in the writable path.
+ */
+class AX_DLL ProgramBinaryFileStore : public ProgramBinaryStore
+{
+public:
+    explicit ProgramBinaryFileStore(std::string_view directory = {});
+
+    bool load(uint64_t key, std::vector<uint8_t>& entry) override;
+    bool save(uint64_t key, const std::vector<uint8_t>& entry) override;
+    void remove(uint64_t key) override;
+
+    const std::string& getDirectory() const { return _directory; }
+
+protected:
+    std::string getEntryPath(uint64_t key) const;
+
+    std::string _directory;
+    bool _directoryCreated = false;
+};
+
+// end of _backend group
+/// @}
+NS_AX_BACKEND_END
@@ -29,12 +29,39 @@
 #include "renderer/Shaders.h"
 #include "base/Macros.h"
 #include "base/Configuration.h"
+#include "platform/FileUtils.h"
 
 #include "xxhash.h"
 #include <inttypes.h>
+#include <string.h>
 
 NS_AX_BACKEND_BEGIN
 
+namespace
+{
+// the header of a program binary store entry, followed by the binary
+struct ProgramBinaryHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint64_t checksum;  // of the binary
+    uint32_t format;
+    uint32_t size;
+};
+static_assert(sizeof(ProgramBinaryHeader) == 32, "ProgramBinaryHeader must not be padded");
+
+constexpr uint32_t PROGRAM_BINARY_MAGIC   = 0x42504158;  // 'XAPB'
+constexpr uint32_t PROGRAM_BINARY_VERSION = 1;
+
+void loadShaderSources(std::string_view vsName, std::string_view fsName, std::string& vertSource, std::string& fragSource)
+{
+    auto fileUtils = FileUtils::getInstance();
+    vertSource     = fileUtils->getStringFromFile(fileUtils->fullPathForFilename(vsName));
+    fragSource     = fileUtils->getStringFromFile(fileUtils->fullPathForFilename(fsName));
+}
+}  // namespace
+
 ProgramManager* ProgramManager::_sharedProgramManager = nullptr;
 
 ProgramManager* ProgramManager::getInstance()
@@ -68,6 +95,10 @@ ProgramManager::~ProgramManager()
     {
         AX_SAFE_RELEASE(program.second);
     }
+    for (auto&& pending : _pendingPrograms)
+    {
+        AX_SAFE_RELEASE(pending.second.program);
+    }
     AXLOGD("deallocing ProgramManager: {}", fmt::ptr(this));
     backend::ShaderCache::destroyInstance();
 }
@@ -164,6 +195,9 @@ bool ProgramManager::init()
 
     ProgramStateRegistry::getInstance()->registerProgram(ProgramType::HSV, TextureSamplerFlag::DUAL_SAMPLER,
                                                          ProgramType::HSV_DUAL_SAMPLER);
+
+    if (DriverBase::getInstance()->isProgramBinarySupported())
+        _binaryStore = std::make_unique<ProgramBinaryFileStore>();
     return true;
 }
 
@@ -203,25 +237,215 @@ Program* ProgramManager::loadProgram(std::string_view vsName,
     if (it != _cachedPrograms.end())
         return it->second;
 
+    // precompiled, wait for the driver to finish it
+    auto pendingIt = _pendingPrograms.find(progId);
+    if (pendingIt != _pendingPrograms.end())
+    {
+        auto pending = pendingIt->second;
+        _pendingPrograms.erase(pendingIt);
+        completePendingProgram(progId, pending);
+        return pending.program;
+    }
+
     AXLOGD("Loading shader: {} {}, {} ...", progId, vsName.data(), fsName.data());
 
-    auto fileUtils  = FileUtils::getInstance();
-    auto vertFile   = fileUtils->fullPathForFilename(vsName);
-    auto fragFile   = fileUtils->fullPathForFilename(fsName);
-    auto vertSource = fileUtils->getStringFromFile(vertFile);
-    auto fragSource = fileUtils->getStringFromFile(fragFile);
-    auto program    = backend::DriverBase::getInstance()->newProgram(vertSource, fragSource);
+    std::string vertSource, fragSource;
+    loadShaderSources(vsName, fsName, vertSource, fragSource);
+    uint64_t binaryKey = 0;
+    auto program       = newProgram(vertSource, fragSource, false, binaryKey);
 
     if (program)
     {
-        program->setProgramIds(progType, progId);
-        if (vlt < VertexLayoutType::Count)
-            program->setupVertexLayout(vlt);
-        _cachedPrograms.emplace(progId, program);
+        saveProgramBinary(binaryKey, program);
+        addProgram(program, progType, progId, vlt);
     }
     return program;
 }
 
+void ProgramManager::addProgram(Program* program, uint32_t progType, uint64_t progId, VertexLayoutType vlt)
+{
+    program->setProgramIds(progType, progId);
+    if (vlt < VertexLayoutType::Count)
+        program->setupVertexLayout(vlt);
+    _cachedPrograms.emplace(progId, program);
+}
+
+void ProgramManager::completePendingProgram(uint64_t progId, const PendingProgram& pending)
+{
+    // a program which failed to compile is kept like a synchronously loaded one, but its binary isn't
+    if (pending.program->completeCompile())
+        saveProgramBinary(pending.binaryKey, pending.program);
+    addProgram(pending.program, pending.progType, progId, pending.vlt);
+    ++_stats.asyncCompiled;
+}
+
+Program* ProgramManager::newProgram(std::string_view vertSource,
+                                    std::string_view fragSource,
+                                    bool async,
+                                    uint64_t& binaryKey)
+{
+    auto driver = DriverBase::getInstance();
+    binaryKey   = 0;
+    if (_binaryStore && driver->isProgramBinarySupported())
+    {
+        auto key = computeBinaryKey(vertSource, fragSource);
+        ProgramBinary binary;
+        if (loadProgramBinary(key, binary))
+        {
+            if (auto program = driver->newProgram(vertSource, fragSource, binary))
+            {
+                ++_stats.binaryHits;
+                return program;
+            }
+            // i.e. the driver was updated without changing its version string
+            AXLOGW("ProgramManager: the driver rejected the program binary {:016x}", key);
+            _binaryStore->remove(key);
+            ++_stats.binaryRejected;
+        }
+        ++_stats.binaryMisses;
+        binaryKey = key;
+    }
+    return async ? driver->newProgramAsync(vertSource, fragSource) : driver->newProgram(vertSource, fragSource);
+}
+
+uint64_t ProgramManager::computeBinaryKey(std::string_view vertSource, std::string_view fragSource)
+{
+    auto driver = DriverBase::getInstance();
+    XXH64_reset(_programIdGen, PROGRAM_BINARY_VERSION);
+    // separated by their terminating nulls, so moving text from one to the next changes the key
+    for (std::string_view part : {std::string_view{driver->getVendor()}, std::string_view{driver->getRenderer()},
+                                  std::string_view{driver->getVersion()}, std::string_view{driver->getShaderVersion()},
+                                  vertSource, fragSource})
+    {
+        XXH64_update(_programIdGen, part.data(), part.length());
+        XXH64_update(_programIdGen, "", 1);
+    }
+    return XXH64_digest(_programIdGen);
+}
+
+bool ProgramManager::loadProgramBinary(uint64_t binaryKey, ProgramBinary& binary)
+{
+    std::vector<uint8_t> entry;
+    if (!_binaryStore->load(binaryKey, entry))
+        return false;
+
+    ProgramBinaryHeader header;
+    bool valid = entry.size() > sizeof(header);
+    if (valid)
+    {
+        memcpy(&header, entry.data(), sizeof(header));
+        valid = header.magic == PROGRAM_BINARY_MAGIC && header.version == PROGRAM_BINARY_VERSION &&
+                header.key == binaryKey && header.size == entry.size() - sizeof(header) &&
+                header.checksum == XXH64(entry.data() + sizeof(header), header.size, 0);
+    }
+    if (!valid)
+    {
+        // truncated, i.e. by a full disk, or written by another engine version
+        AXLOGW("ProgramManager: removing the corrupted program binary {:016x}", binaryKey);
+        _binaryStore->remove(binaryKey);
+        ++_stats.binaryRejected;
+        return false;
+    }
+
+    binary.format = header.format;
+    binary.data.assign(entry.begin() + sizeof(header), entry.end());
+    return true;
+}
+
+void ProgramManager::saveProgramBinary(uint64_t binaryKey, Program* program)
+{
+    if (!binaryKey || !_binaryStore)
+        return;
+
+    ProgramBinary binary;
+    if (!program->getBinary(binary) || binary.data.empty())
+        return;
+
+    ProgramBinaryHeader header;
+    header.magic    = PROGRAM_BINARY_MAGIC;
+    header.version  = PROGRAM_BINARY_VERSION;
+    header.key      = binaryKey;
+    header.checksum = XXH64(binary.data.data(), binary.data.size(), 0);
+    header.format   = binary.format;
+    header.size     = static_cast<uint32_t>(binary.data.size());
+
+    std::vector<uint8_t> entry(sizeof(header) + binary.data.size());
+    memcpy(entry.data(), &header, sizeof(header));
+    memcpy(entry.data() + sizeof(header), binary.data.data(), binary.data.size());
+    if (_binaryStore->save(binaryKey, entry))
+        ++_stats.binarySaved;
+}
+
+void ProgramManager::setProgramBinaryStore(std::unique_ptr<ProgramBinaryStore> store)
+{
+    _binaryStore = std::move(store);
+}
+
+void ProgramManager::precompilePrograms(std::span<const uint64_t> progIds)
+{
+    std::string vertSource, fragSource;
+    for (auto progId : progIds)
+    {
+        if (_cachedPrograms.find(progId) != _cachedPrograms.end() ||
+            _pendingPrograms.find(progId) != _pendingPrograms.end())
+            continue;
+
+        const BuiltinRegInfo* info = nullptr;
+        uint32_t progType          = ProgramType::CUSTOM_PROGRAM;
+        if (progId < ProgramType::BUILTIN_COUNT)
+        {
+            info     = &_builtinRegistry[progId];
+            progType = static_cast<uint32_t>(progId);
+        }
+        else
+        {
+            auto it = _customRegistry.find(progId);
+            if (it != _customRegistry.end())
+                info = &it->second;
+        }
+        if (!info || info->vsName.empty() || info->fsName.empty())
+            continue;
+
+        loadShaderSources(info->vsName, info->fsName, vertSource, fragSource);
+        uint64_t binaryKey = 0;
+        if (auto program = newProgram(vertSource, fragSource, true, binaryKey))
+            _pendingPrograms.emplace(progId, PendingProgram{program, progType, info->vlt, binaryKey});
+    }
+}
+
+void ProgramManager::precompileBuiltinPrograms()
+{
+    uint64_t progIds[ProgramType::BUILTIN_COUNT];
+    for (uint64_t progId = 0; progId < ProgramType::BUILTIN_COUNT; ++progId)
+        progIds[progId] = progId;
+    precompilePrograms(progIds);
+}
+
+std::size_t ProgramManager::pollPrograms()
+{
+    for (auto it = _pendingPrograms.begin(); it != _pendingPrograms.end();)
+    {
+        if (!it->second.program->isCompileCompleted())
+        {
+            ++it;
+            continue;
+        }
+        auto progId  = it->first;
+        auto pending = it->second;
+        it           = _pendingPrograms.erase(it);
+        completePendingProgram(progId, pending);
+    }
+    return _pendingPrograms.size();
+}
+
+bool ProgramManager::isProgramReady(uint64_t progId) const
+{
+    if (_cachedPrograms.find(progId) != _cachedPrograms.end())
+        return true;
+    auto it = _pendingPrograms.find(progId);
+    return it != _pendingPrograms.end() && it->second.program->isCompileCompleted();
+}
+
 uint64_t ProgramManager::registerCustomProgram(std::string_view vsName,
                                                std::string_view fsName,
                                                VertexLayoutType vlt,
@@ -305,6 +529,11 @@ void ProgramManager::unloadAllPrograms()
         program.second->release();
     }
     _cachedPrograms.clear();
+    for (auto&& pending : _pendingPrograms)
+    {
+        pending.second.program->release();
+    }
+    _pendingPrograms.clear();
 }
 
 NS_AX_BACKEND_END
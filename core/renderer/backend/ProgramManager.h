@@ -29,7 +29,10 @@
 #include "base/Object.h"
 #include "platform/PlatformMacros.h"
 #include "Program.h"
+#include "ProgramBinaryStore.h"
 
+#include <memory>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <string_view>
@@ -43,6 +46,18 @@ NS_AX_BACKEND_BEGIN
  * @{
  */
 
+/**
+ * How programs were created since the ProgramManager was created.
+ */
+struct ProgramManagerStats
+{
+    uint32_t binaryHits     = 0;  ///< programs restored from the binary store.
+    uint32_t binaryMisses   = 0;  ///< programs compiled because the store had no binary for them.
+    uint32_t binaryRejected = 0;  ///< store entries removed because they were corrupted or rejected by the driver.
+    uint32_t binarySaved    = 0;  ///< binaries written to the store.
+    uint32_t asyncCompiled  = 0;  ///< precompiled programs which completed.
+};
+
 /**
  * Cache and reuse program object.
  */
@@ -103,6 +118,38 @@ public:
      * Unload all program objects from cache.
      */
     void unloadAllPrograms();
+
+    /**
+     * Sets where the binaries of linked programs are kept, so later launches skip compiling their shaders.
+     * By default a ProgramBinaryFileStore in the writable path, when the driver supports program binaries.
+     * The entries are keyed by the shader sources and the driver vendor, renderer and version, and are
+     * removed when they are corrupted or the driver rejects them.
+     * @param store nullptr disables the cache.
+     */
+    void setProgramBinaryStore(std::unique_ptr<ProgramBinaryStore> store);
+    ProgramBinaryStore* getProgramBinaryStore() const { return _binaryStore.get(); }
+
+    /**
+     * Starts compiling programs without waiting for the driver, i.e. at boot, so they are ready on first use.
+     * Programs with a cached binary are restored right away. Loading a program which is still compiling
+     * waits for it, pollPrograms tells when they are all ready.
+     * @param progIds builtin program types or ids returned by registerCustomProgram.
+     */
+    void precompilePrograms(std::span<const uint64_t> progIds);
+
+    /** Starts compiling all the builtin programs, see precompilePrograms. */
+    void precompileBuiltinPrograms();
+
+    /**
+     * Completes the precompiled programs the driver finished.
+     * @return the number of programs still compiling.
+     */
+    std::size_t pollPrograms();
+
+    /** Whether a program is loaded, or precompiled and finished by the driver. */
+    bool isProgramReady(uint64_t progId) const;
+
+    const ProgramManagerStats& getStats() const { return _stats; }
 #ifndef AX_CORE_PROFILE
     /**
      * Remove a program object from cache.
@@ -149,6 +196,16 @@ protected:
 
     uint64_t computeProgramId(std::string_view vsName, std::string_view fsName);
 
+    /**
+     * New a program from the cached binary of its sources, else from its sources.
+     * @param binaryKey Receives the key to save its binary with once compiled, 0 if there is no store.
+     */
+    Program* newProgram(std::string_view vertSource, std::string_view fragSource, bool async, uint64_t& binaryKey);
+    uint64_t computeBinaryKey(std::string_view vertSource, std::string_view fragSource);
+    bool loadProgramBinary(uint64_t binaryKey, ProgramBinary& binary);
+    void saveProgramBinary(uint64_t binaryKey, Program* program);
+    void addProgram(Program* program, uint32_t progType, uint64_t progId, VertexLayoutType vlt);
+
     struct BuiltinRegInfo
     {  // builtin shader name is literal string, so use std::string_view ok
         std::string_view vsName;
@@ -161,6 +218,20 @@ protected:
 
     std::unordered_map<int64_t, Program*> _cachedPrograms;  ///< The cached program object.
 
+    struct PendingProgram
+    {
+        Program* program;
+        uint32_t progType;
+        VertexLayoutType vlt;
+        uint64_t binaryKey;
+    };
+    std::unordered_map<int64_t, PendingProgram> _pendingPrograms;  ///< The precompiled programs still compiling.
+
+    void completePendingProgram(uint64_t progId, const PendingProgram& pending);
+
+    std::unique_ptr<ProgramBinaryStore> _binaryStore;
+    ProgramManagerStats _stats;
+
     XXH64_state_s* _programIdGen;
 
     static ProgramManager* _sharedProgramManager;  ///< A shared instance of the program cache.
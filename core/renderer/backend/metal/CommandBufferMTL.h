@@ -121,8 +121,9 @@ public:
     /**
      * Set a global buffer for all vertex shaders at the given bind point index 0.
      * @param buffer The buffer to set in the buffer argument table.
+     * @param offset The offset in bytes of the first vertex.
      */
-    void setVertexBuffer(Buffer* buffer) override;
+    void setVertexBuffer(Buffer* buffer, std::size_t offset = 0) override;
 
     /**
      * Set the uniform data at a given vertex and fragment buffer binding point 1
@@ -265,10 +265,10 @@ void CommandBufferMTL::setWinding(Winding winding)
     [_mtlRenderEncoder setFrontFacingWinding:toMTLWinding(winding)];
 }
 
-void CommandBufferMTL::setVertexBuffer(Buffer* buffer)
+void CommandBufferMTL::setVertexBuffer(Buffer* buffer, std::size_t offset)
 {
     // Vertex buffer is bound in index DEFAULT_ATTRIBS_BINDING_INDEX.
-    [_mtlRenderEncoder setVertexBuffer:static_cast<BufferMTL*>(buffer)->getMTLBuffer() offset:0 atIndex:DriverMTL::DEFAULT_ATTRIBS_BINDING_INDEX];
+    [_mtlRenderEncoder setVertexBuffer:static_cast<BufferMTL*>(buffer)->getMTLBuffer() offset:offset atIndex:DriverMTL::DEFAULT_ATTRIBS_BINDING_INDEX];
 }
 
 void CommandBufferMTL::setInstanceBuffer(Buffer* buffer) {
@@ -36,6 +36,9 @@
 #include "base/Macros.h"
 
 #include "renderer/backend/ProgramManager.h"
+#if defined(AX_ENABLE_NULL_DRIVER)
+#    include "renderer/backend/null/DriverNull.h"
+#endif
 
 NS_AX_BACKEND_BEGIN
 
@@ -392,7 +395,14 @@ id<CAMetalDrawable> DriverMTL::_currentDrawable = nil;
 DriverBase* DriverBase::getInstance()
 {
     if (!_instance)
-        _instance = new DriverMTL();
+    {
+#if defined(AX_ENABLE_NULL_DRIVER)
+        if (_driverType == DriverType::Null)
+            _instance = new DriverNull();
+        else
+#endif
+            _instance = new DriverMTL();
+    }
 
     return _instance;
 }
@@ -564,6 +574,9 @@ bool DriverMTL::checkForFeatureSupported(FeatureType feature)
     case FeatureType::ASTC:
         featureSupported = supportASTC(_featureSet);
         break;
+    case FeatureType::ELEMENT_INDEX_UINT:
+        featureSupported = true;
+        break;
     default:
         break;
     }
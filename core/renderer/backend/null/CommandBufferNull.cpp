@@ -0,0 +1,257 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "CommandBufferNull.h"
+#include "DriverNull.h"
+#include "../Buffer.h"
+#include "../RenderTarget.h"
+#include "renderer/PipelineDescriptor.h"
+
+NS_AX_BACKEND_BEGIN
+
+namespace
+{
+bool operator==(const BlendDescriptor& lhs, const BlendDescriptor& rhs)
+{
+    return lhs.writeMask == rhs.writeMask && lhs.blendEnabled == rhs.blendEnabled &&
+           lhs.rgbBlendOperation == rhs.rgbBlendOperation && lhs.alphaBlendOperation == rhs.alphaBlendOperation &&
+           lhs.sourceRGBBlendFactor == rhs.sourceRGBBlendFactor &&
+           lhs.destinationRGBBlendFactor == rhs.destinationRGBBlendFactor &&
+           lhs.sourceAlphaBlendFactor == rhs.sourceAlphaBlendFactor &&
+           lhs.destinationAlphaBlendFactor == rhs.destinationAlphaBlendFactor;
+}
+
+bool operator==(const DepthStencilDescriptor& lhs, const DepthStencilDescriptor& rhs)
+{
+    return lhs.flags == rhs.flags && lhs.depthCompareFunction == rhs.depthCompareFunction &&
+           lhs.frontFaceStencil == rhs.frontFaceStencil && lhs.backFaceStencil == rhs.backFaceStencil;
+}
+}  // namespace
+
+CommandBufferNull::CommandBufferNull(DriverNullStats* stats) : _stats(stats) {}
+
+CommandBufferNull::~CommandBufferNull()
+{
+    AX_SAFE_RELEASE_NULL(_programState);
+    AX_SAFE_RELEASE_NULL(_vertexBuffer);
+    AX_SAFE_RELEASE_NULL(_indexBuffer);
+    AX_SAFE_RELEASE_NULL(_instanceBuffer);
+}
+
+void CommandBufferNull::setDepthStencilState(DepthStencilState* depthStencilState)
+{
+    _depthStencilState = depthStencilState;
+}
+
+void CommandBufferNull::setRenderPipeline(RenderPipeline* /*renderPipeline*/) {}
+
+bool CommandBufferNull::beginFrame()
+{
+    return true;
+}
+
+void CommandBufferNull::beginRenderPass(const RenderTarget* /*renderTarget*/, const RenderPassDescriptor& /*descriptor*/)
+{
+    ++_stats->renderPasses;
+}
+
+void CommandBufferNull::updateDepthStencilState(const DepthStencilDescriptor& descriptor)
+{
+    if (_depthStencilState)
+        _depthStencilState->update(descriptor);
+
+    if (!(_depthStencilDescriptor == descriptor))
+    {
+        _depthStencilDescriptor = descriptor;
+        ++_stats->stateChanges;
+    }
+}
+
+void CommandBufferNull::updatePipelineState(const RenderTarget* /*rt*/, const PipelineDescriptor& descriptor)
+{
+    if (!(_blendDescriptor == descriptor.blendDescriptor))
+    {
+        _blendDescriptor = descriptor.blendDescriptor;
+        ++_stats->stateChanges;
+    }
+}
+
+void CommandBufferNull::setViewport(int x, int y, unsigned int w, unsigned int h)
+{
+    if (_viewport.x != x || _viewport.y != y || _viewport.width != w || _viewport.height != h)
+    {
+        _viewport.x      = x;
+        _viewport.y      = y;
+        _viewport.width  = w;
+        _viewport.height = h;
+        ++_stats->stateChanges;
+    }
+}
+
+void CommandBufferNull::setCullMode(CullMode mode)
+{
+    if (_cullMode != mode)
+    {
+        _cullMode = mode;
+        ++_stats->stateChanges;
+    }
+}
+
+void CommandBufferNull::setWinding(Winding winding)
+{
+    if (_winding != winding)
+    {
+        _winding = winding;
+        ++_stats->stateChanges;
+    }
+}
+
+void CommandBufferNull::setVertexBuffer(Buffer* buffer, std::size_t /*offset*/)
+{
+    if (buffer == nullptr || _vertexBuffer == buffer)
+        return;
+
+    buffer->retain();
+    AX_SAFE_RELEASE(_vertexBuffer);
+    _vertexBuffer = buffer;
+}
+
+void CommandBufferNull::setProgramState(ProgramState* programState)
+{
+    AX_SAFE_RETAIN(programState);
+    AX_SAFE_RELEASE(_programState);
+    _programState = programState;
+}
+
+void CommandBufferNull::setIndexBuffer(Buffer* buffer)
+{
+    if (buffer == nullptr || _indexBuffer == buffer)
+        return;
+
+    buffer->retain();
+    AX_SAFE_RELEASE(_indexBuffer);
+    _indexBuffer = buffer;
+}
+
+void CommandBufferNull::setInstanceBuffer(Buffer* buffer)
+{
+    if (buffer == nullptr || _instanceBuffer == buffer)
+        return;
+
+    buffer->retain();
+    AX_SAFE_RELEASE(_instanceBuffer);
+    _instanceBuffer = buffer;
+}
+
+void CommandBufferNull::countDraw(std::size_t count, int instanceCount)
+{
+    const Program* program = _programState ? _programState->getProgram() : nullptr;
+    if (program != _program)
+    {
+        _program = program;
+        ++_stats->pipelineSwitches;
+    }
+
+    ++_stats->drawCalls;
+    _stats->drawnVertices += count * instanceCount;
+
+    AX_SAFE_RELEASE_NULL(_programState);
+}
+
+void CommandBufferNull::drawArrays(PrimitiveType /*primitiveType*/,
+                                   std::size_t /*start*/,
+                                   std::size_t count,
+                                   bool /*wireframe*/)
+{
+    countDraw(count, 1);
+}
+
+void CommandBufferNull::drawElements(PrimitiveType /*primitiveType*/,
+                                     IndexFormat /*indexType*/,
+                                     std::size_t count,
+                                     std::size_t /*offset*/,
+                                     bool /*wireframe*/)
+{
+    countDraw(count, 1);
+}
+
+void CommandBufferNull::drawElementsInstanced(PrimitiveType /*primitiveType*/,
+                                              IndexFormat /*indexType*/,
+                                              std::size_t count,
+                                              std::size_t /*offset*/,
+                                              int instanceCount,
+                                              bool /*wireframe*/)
+{
+    countDraw(count, instanceCount);
+}
+
+void CommandBufferNull::endRenderPass()
+{
+    AX_SAFE_RELEASE_NULL(_indexBuffer);
+    AX_SAFE_RELEASE_NULL(_vertexBuffer);
+    AX_SAFE_RELEASE_NULL(_instanceBuffer);
+}
+
+void CommandBufferNull::endFrame()
+{
+    ++_stats->frames;
+}
+
+void CommandBufferNull::setScissorRect(bool isEnabled, float x, float y, float width, float height)
+{
+    if (_scissor.enabled != isEnabled ||
+        (isEnabled && (_scissor.x != x || _scissor.y != y || _scissor.width != width || _scissor.height != height)))
+    {
+        _scissor.enabled = isEnabled;
+        _scissor.x       = x;
+        _scissor.y       = y;
+        _scissor.width   = width;
+        _scissor.height  = height;
+        ++_stats->stateChanges;
+    }
+}
+
+void CommandBufferNull::readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback)
+{
+    // nothing was rasterized, hand out a cleared image of the expected size
+    PixelBufferDescriptor pbd;
+    if (rt->isDefaultRenderTarget())
+    {
+        pbd._width  = static_cast<int>(_viewport.width);
+        pbd._height = static_cast<int>(_viewport.height);
+    }
+    else if (auto colorAttachment = rt->_color[0].texture)
+    {
+        pbd._width  = colorAttachment->getWidth();
+        pbd._height = colorAttachment->getHeight();
+    }
+
+    const auto bufferSize = static_cast<size_t>(pbd._width) * pbd._height * 4;
+    if (auto wptr = bufferSize ? pbd._data.resize(bufferSize) : nullptr)
+        memset(wptr, 0, bufferSize);
+    callback(pbd);
+}
+
+NS_AX_BACKEND_END
@@ -0,0 +1,165 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "DriverNull.h"
+#include "BufferNull.h"
+#include "CommandBufferNull.h"
+#include "DepthStencilStateNull.h"
+#include "ProgramNull.h"
+#include "RenderPipelineNull.h"
+#include "ShaderModuleNull.h"
+#include "TextureNull.h"
+#include "../RenderTarget.h"
+#include "renderer/backend/ProgramManager.h"
+
+NS_AX_BACKEND_BEGIN
+
+DriverNull::DriverNull()
+{
+    _maxAttributes     = 16;
+    _maxTextureSize    = 16384;
+    _maxTextureUnits   = 16;
+    _maxSamplesAllowed = 4;
+}
+
+DriverNull::~DriverNull()
+{
+    ProgramManager::destroyInstance();
+}
+
+CommandBuffer* DriverNull::newCommandBuffer()
+{
+    return new CommandBufferNull(&_stats);
+}
+
+Buffer* DriverNull::newBuffer(std::size_t size, BufferType type, BufferUsage usage)
+{
+    return new BufferNull(size, type, usage, &_stats);
+}
+
+TextureBackend* DriverNull::newTexture(const TextureDescriptor& descriptor)
+{
+    switch (descriptor.textureType)
+    {
+    case TextureType::TEXTURE_2D:
+        return new Texture2DNull(descriptor, &_stats);
+    case TextureType::TEXTURE_CUBE:
+        return new TextureCubeNull(descriptor, &_stats);
+    default:
+        return nullptr;
+    }
+}
+
+RenderTarget* DriverNull::newDefaultRenderTarget()
+{
+    return new RenderTarget(true);
+}
+
+RenderTarget* DriverNull::newRenderTarget(TextureBackend* colorAttachment,
+                                          TextureBackend* depthAttachment,
+                                          TextureBackend* stencilAttachhment)
+{
+    auto rt = new RenderTarget(false);
+    RenderTarget::ColorAttachment colors{{colorAttachment, 0}};
+    rt->setColorAttachment(colors);
+    rt->setDepthAttachment(depthAttachment);
+    rt->setStencilAttachment(stencilAttachhment);
+    return rt;
+}
+
+ShaderModule* DriverNull::newShaderModule(ShaderStage stage, std::string_view /*source*/)
+{
+    return new ShaderModuleNull(stage);
+}
+
+DepthStencilState* DriverNull::newDepthStencilState()
+{
+    return new DepthStencilStateNull();
+}
+
+RenderPipeline* DriverNull::newRenderPipeline()
+{
+    return new RenderPipelineNull();
+}
+
+Program* DriverNull::newProgram(std::string_view vertexShader, std::string_view fragmentShader)
+{
+    ++_stats.programCompiles;
+    return new ProgramNull(vertexShader, fragmentShader);
+}
+
+Program* DriverNull::newProgram(std::string_view vertexShader,
+                                std::string_view fragmentShader,
+                                const ProgramBinary& binary)
+{
+    ProgramBinary expected;
+    ProgramNull::makeBinary(vertexShader, fragmentShader, expected);
+    if (!_programBinarySupported || binary.format != expected.format || binary.data != expected.data)
+        return nullptr;
+
+    ++_stats.programBinaries;
+    return new ProgramNull(vertexShader, fragmentShader);
+}
+
+Program* DriverNull::newProgramAsync(std::string_view vertexShader, std::string_view fragmentShader)
+{
+    ++_stats.programCompiles;
+    auto program = new ProgramNull(vertexShader, fragmentShader);
+    if (_programCompilesDeferred)
+        program->setCompileDeferredBy(this);
+    return program;
+}
+
+const char* DriverNull::getVendor() const
+{
+    return "axmol";
+}
+
+const char* DriverNull::getRenderer() const
+{
+    return "null";
+}
+
+const char* DriverNull::getVersion() const
+{
+    return "1.0";
+}
+
+bool DriverNull::checkForFeatureSupported(FeatureType feature)
+{
+    switch (feature)
+    {
+    case FeatureType::PACKED_DEPTH_STENCIL:
+    case FeatureType::VAO:
+    case FeatureType::MAPBUFFER:
+    case FeatureType::DEPTH24:
+    case FeatureType::ELEMENT_INDEX_UINT:
+        return true;
+    default:  // compressed formats: let the image loader decode to RGBA
+        return false;
+    }
+}
+
+NS_AX_BACKEND_END
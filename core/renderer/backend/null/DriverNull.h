@@ -0,0 +1,135 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "../DriverBase.h"
+
+NS_AX_BACKEND_BEGIN
+
+/**
+ * @addtogroup _null
+ * @{
+ */
+
+/**
+ * Counters recorded by the null driver, all objects created by one DriverNull share them.
+ */
+struct DriverNullStats
+{
+    uint64_t frames           = 0;  ///< endFrame calls.
+    uint64_t renderPasses     = 0;  ///< beginRenderPass calls.
+    uint64_t drawCalls        = 0;  ///< drawArrays, drawElements and drawElementsInstanced calls.
+    uint64_t drawnVertices    = 0;  ///< vertices or indices submitted by draw calls, per instance.
+    uint64_t bufferUploads    = 0;  ///< Buffer::updateData/updateSubData/unmapStream calls.
+    uint64_t textureUploads   = 0;  ///< Texture update calls.
+    uint64_t bytesUploaded    = 0;  ///< bytes sent to buffers and textures.
+    uint64_t stateChanges     = 0;  ///< effective fixed-function state changes: blend, depth stencil, cull, ...
+    uint64_t pipelineSwitches = 0;  ///< program changes between two draws.
+    uint64_t programCompiles  = 0;  ///< programs created from sources.
+    uint64_t programBinaries  = 0;  ///< programs restored from a binary.
+};
+
+/**
+ * A headless driver: resources live in system memory only and no GPU work is issued,
+ * the renderer runs its full CPU-side path and the driver counts what would have been submitted.
+ * Select it with DriverBase::setDriverType(DriverType::Null) or by creating a GLViewNull.
+ */
+class DriverNull : public DriverBase
+{
+public:
+    DriverNull();
+    ~DriverNull();
+
+    CommandBuffer* newCommandBuffer() override;
+
+    Buffer* newBuffer(std::size_t size, BufferType type, BufferUsage usage) override;
+
+    TextureBackend* newTexture(const TextureDescriptor& descriptor) override;
+
+    RenderTarget* newDefaultRenderTarget() override;
+    RenderTarget* newRenderTarget(TextureBackend* colorAttachment,
+                                  TextureBackend* depthAttachment,
+                                  TextureBackend* stencilAttachhment) override;
+
+    DepthStencilState* newDepthStencilState() override;
+
+    RenderPipeline* newRenderPipeline() override;
+
+    void setFrameBufferOnly(bool frameBufferOnly) override {}
+
+    Program* newProgram(std::string_view vertexShader, std::string_view fragmentShader) override;
+
+    /**
+     * Accepts the binaries returned by ProgramNull::getBinary for the same sources.
+     */
+    Program* newProgram(std::string_view vertexShader,
+                        std::string_view fragmentShader,
+                        const ProgramBinary& binary) override;
+
+    /**
+     * Off by default, so headless runs don't write a program binary cache to the writable path.
+     */
+    void setProgramBinarySupported(bool supported) { _programBinarySupported = supported; }
+    bool isProgramBinarySupported() const override { return _programBinarySupported; }
+
+    /**
+     * Compiles right away, unless deferred: the programs then report their compile as not completed
+     * until it is no longer deferred or ProgramManager waits for them.
+     */
+    Program* newProgramAsync(std::string_view vertexShader, std::string_view fragmentShader) override;
+
+    /**
+     * Keeps the programs of newProgramAsync compiling, so tests can see them pending.
+     */
+    void setProgramCompilesDeferred(bool deferred) { _programCompilesDeferred = deferred; }
+    bool isProgramCompilesDeferred() const { return _programCompilesDeferred; }
+
+    /// below is driver info API
+
+    const char* getVendor() const override;
+
+    const char* getRenderer() const override;
+
+    const char* getVersion() const override;
+
+    bool checkForFeatureSupported(FeatureType feature) override;
+
+    /** Counters accumulated since creation or the last resetStats() call. */
+    const DriverNullStats& getStats() const { return _stats; }
+    DriverNullStats& getStats() { return _stats; }
+
+    void resetStats() { _stats = DriverNullStats{}; }
+
+protected:
+    ShaderModule* newShaderModule(ShaderStage stage, std::string_view source) override;
+
+    DriverNullStats _stats;
+    bool _programBinarySupported  = false;
+    bool _programCompilesDeferred = false;
+};
+// end of _null group
+/// @}
+NS_AX_BACKEND_END
@@ -0,0 +1,416 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "ProgramNull.h"
+#include "DriverNull.h"
+#include "xxhash.h"
+
+#include <algorithm>
+#include <charconv>
+#include <vector>
+
+NS_AX_BACKEND_BEGIN
+
+namespace
+{
+struct GLSLType
+{
+    std::string_view name;
+    uint16_t size;   // bytes of one element
+    uint16_t align;  // std140 base alignment
+};
+
+// clang-format off
+constexpr GLSLType s_glslTypes[] = {
+    {"float"sv, 4, 4},   {"int"sv, 4, 4},    {"uint"sv, 4, 4},    {"bool"sv, 4, 4},
+    {"vec2"sv, 8, 8},    {"ivec2"sv, 8, 8},  {"uvec2"sv, 8, 8},   {"bvec2"sv, 8, 8},
+    {"vec3"sv, 12, 16},  {"ivec3"sv, 12, 16}, {"uvec3"sv, 12, 16}, {"bvec3"sv, 12, 16},
+    {"vec4"sv, 16, 16},  {"ivec4"sv, 16, 16}, {"uvec4"sv, 16, 16}, {"bvec4"sv, 16, 16},
+    {"mat2"sv, 32, 16},  {"mat3"sv, 48, 16},  {"mat4"sv, 64, 16},
+};
+// clang-format on
+
+constexpr std::string_view s_builtinUniformNames[UNIFORM_MAX] = {
+    UNIFORM_NAME_MVP_MATRIX, UNIFORM_NAME_TEXTURE,    UNIFORM_NAME_TEXTURE1,    UNIFORM_NAME_TEXTURE2,
+    UNIFORM_NAME_TEXTURE3,   UNIFORM_NAME_TEXT_COLOR, UNIFORM_NAME_EFFECT_TYPE, UNIFORM_NAME_EFFECT_COLOR,
+};
+
+constexpr std::string_view s_builtinAttributeNames[ATTRIBUTE_MAX] = {
+    ATTRIBUTE_NAME_POSITION,  ATTRIBUTE_NAME_COLOR,     ATTRIBUTE_NAME_TEXCOORD, ATTRIBUTE_NAME_TEXCOORD1,
+    ATTRIBUTE_NAME_TEXCOORD2, ATTRIBUTE_NAME_TEXCOORD3, ATTRIBUTE_NAME_NORMAL,   ATTRIBUTE_NAME_INSTANCE,
+};
+
+const GLSLType* findType(std::string_view name)
+{
+    for (auto& type : s_glslTypes)
+        if (type.name == name)
+            return &type;
+    return nullptr;
+}
+
+bool isSamplerType(std::string_view name)
+{
+    return name.find("sampler"sv) != std::string_view::npos;
+}
+
+bool isQualifier(std::string_view token)
+{
+    return token == "highp"sv || token == "mediump"sv || token == "lowp"sv || token == "flat"sv ||
+           token == "smooth"sv || token == "noperspective"sv || token == "centroid"sv || token == "invariant"sv ||
+           token == "precise"sv || token == "const"sv;
+}
+
+inline bool isIdentChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+inline int toInt(std::string_view token, int defaultValue)
+{
+    int value{defaultValue};
+    std::from_chars(token.data(), token.data() + token.size(), value);
+    return value;
+}
+
+inline unsigned int alignTo(unsigned int value, unsigned int alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/*
+ * Splits GLSL source into identifiers, numbers and single punctuation chars,
+ * comments and preprocessor lines are dropped.
+ */
+std::vector<std::string_view> tokenize(std::string_view source)
+{
+    std::vector<std::string_view> tokens;
+    bool lineStart = true;
+    for (size_t i = 0, n = source.size(); i < n;)
+    {
+        const char c = source[i];
+        if (c == '\n')
+        {
+            lineStart = true;
+            ++i;
+        }
+        else if (c == ' ' || c == '\t' || c == '\r')
+            ++i;
+        else if (c == '#' && lineStart)
+        {
+            i = source.find('\n', i);
+            if (i == std::string_view::npos)
+                break;
+        }
+        else if (c == '/' && i + 1 < n && source[i + 1] == '/')
+        {
+            i = source.find('\n', i);
+            if (i == std::string_view::npos)
+                break;
+        }
+        else if (c == '/' && i + 1 < n && source[i + 1] == '*')
+        {
+            i = source.find("*/"sv, i + 2);
+            if (i == std::string_view::npos)
+                break;
+            i += 2;
+        }
+        else
+        {
+            lineStart = false;
+            size_t end = i + 1;
+            if (isIdentChar(c))
+                while (end < n && isIdentChar(source[end]))
+                    ++end;
+            tokens.push_back(source.substr(i, end - i));
+            i = end;
+        }
+    }
+    return tokens;
+}
+
+/*
+ * Strips layout(...) and precision/interpolation qualifiers from a declaration,
+ * returns the explicit location if one was given.
+ */
+int stripQualifiers(std::vector<std::string_view>& decl)
+{
+    int location = -1;
+    std::vector<std::string_view> out;
+    out.reserve(decl.size());
+    for (size_t i = 0; i < decl.size(); ++i)
+    {
+        if (decl[i] == "layout"sv && i + 1 < decl.size() && decl[i + 1] == "("sv)
+        {
+            for (i += 2; i < decl.size() && decl[i] != ")"sv; ++i)
+            {
+                if (decl[i] == "location"sv && i + 2 < decl.size() && decl[i + 1] == "="sv)
+                    location = toInt(decl[i + 2], -1);
+            }
+        }
+        else if (!isQualifier(decl[i]))
+            out.push_back(decl[i]);
+    }
+    decl.swap(out);
+    return location;
+}
+
+/*
+ * Parses `type name[N], name2;` style member lists, invokes func(type, name, arrayCount) per name.
+ */
+template <typename _Fn>
+void forEachDeclarator(const std::vector<std::string_view>& decl, size_t first, _Fn&& func)
+{
+    if (first >= decl.size())
+        return;
+    const auto typeName = decl[first];
+    for (size_t i = first + 1; i < decl.size(); ++i)
+    {
+        if (decl[i] == ","sv)
+            continue;
+        const auto name = decl[i];
+        int count       = 1;
+        if (i + 1 < decl.size() && decl[i + 1] == "["sv)
+        {
+            count = i + 2 < decl.size() ? toInt(decl[i + 2], 1) : 1;
+            i += 3;  // skip [N]
+        }
+        func(typeName, name, count);
+    }
+}
+}  // namespace
+
+ProgramNull::ProgramNull(std::string_view vertexShader, std::string_view fragmentShader)
+    : Program(vertexShader, fragmentShader)
+{
+    reflect(_vertexShader, ShaderStage::VERTEX);
+    reflect(_fragmentShader, ShaderStage::FRAGMENT);
+    setBuiltinLocations();
+}
+
+bool ProgramNull::getBinary(ProgramBinary& binary) const
+{
+    makeBinary(_vertexShader, _fragmentShader, binary);
+    return true;
+}
+
+bool ProgramNull::isCompileCompleted() const
+{
+    return !_deferringDriver || !_deferringDriver->isProgramCompilesDeferred();
+}
+
+bool ProgramNull::completeCompile()
+{
+    _deferringDriver = nullptr;
+    return true;
+}
+
+void ProgramNull::makeBinary(std::string_view vertexShader, std::string_view fragmentShader, ProgramBinary& binary)
+{
+    const uint64_t hashes[] = {XXH64(vertexShader.data(), vertexShader.size(), 0),
+                               XXH64(fragmentShader.data(), fragmentShader.size(), 0)};
+    auto bytes              = reinterpret_cast<const uint8_t*>(hashes);
+
+    binary.format = 1;
+    binary.data.assign(bytes, bytes + sizeof(hashes));
+}
+
+void ProgramNull::reflect(std::string_view source, ShaderStage stage)
+{
+    const auto tokens = tokenize(source);
+
+    std::vector<std::string_view> decl;
+    int nextAttribLocation = static_cast<int>(_activeAttribs.size());
+
+    auto skipScope = [&tokens](size_t i) {  // i points after '{', returns index after the matching '}'
+        for (int depth = 1; i < tokens.size() && depth > 0; ++i)
+        {
+            if (tokens[i] == "{"sv)
+                ++depth;
+            else if (tokens[i] == "}"sv)
+                --depth;
+        }
+        return i;
+    };
+
+    auto addUniform = [this](std::string_view name, const UniformInfo& info) {
+        if (_activeUniformInfos.find(name) != _activeUniformInfos.end())
+            return;
+        _activeUniformInfos.emplace(name, info);
+        _maxLocation = _maxLocation <= info.location ? (info.location + 1) : _maxLocation;
+    };
+
+    for (size_t i = 0; i < tokens.size();)
+    {
+        decl.clear();
+        while (i < tokens.size() && tokens[i] != ";"sv && tokens[i] != "{"sv)
+            decl.push_back(tokens[i++]);
+        if (i >= tokens.size())
+            break;
+
+        const bool opensScope = tokens[i++] == "{"sv;
+        const int location    = stripQualifiers(decl);
+
+        if (opensScope)
+        {
+            if (decl.size() != 2 || decl[0] != "uniform"sv)
+            {  // function body or struct
+                i = skipScope(i);
+                continue;
+            }
+
+            // uniform block: std140 members packed into one region of the uniform buffer
+            const auto blockLocation = static_cast<int>(_totalBufferSize);
+            unsigned int offset      = 0;
+            std::vector<std::string_view> member;
+            while (i < tokens.size() && tokens[i] != "}"sv)
+            {
+                member.clear();
+                while (i < tokens.size() && tokens[i] != ";"sv && tokens[i] != "}"sv)
+                    member.push_back(tokens[i++]);
+                if (i < tokens.size() && tokens[i] == ";"sv)
+                    ++i;
+                stripQualifiers(member);
+                forEachDeclarator(member, 0, [&](std::string_view typeName, std::string_view name, int count) {
+                    auto type = findType(typeName);
+                    if (!type)
+                        return;
+                    const unsigned int align  = count > 1 ? 16u : type->align;
+                    const unsigned int stride = count > 1 ? alignTo(type->size, 16u) : type->size;
+                    offset                    = alignTo(offset, align);
+
+                    UniformInfo info;
+                    info.count    = count;
+                    info.size     = type->size;
+                    info.location = blockLocation;
+#if AX_GLES_PROFILE != 200
+                    info.bufferOffset = offset;
+#else
+                    info.bufferOffset = blockLocation + offset;
+#endif
+                    addUniform(name, info);
+                    offset += stride * count;
+                });
+            }
+            while (i < tokens.size() && tokens[i++] != ";"sv)  // skip '}' and the optional instance name
+                ;
+            _totalBufferSize += alignTo(offset, 16u);
+            continue;
+        }
+
+        if (decl.size() < 3)
+            continue;
+
+        if (decl[0] == "uniform"sv)
+        {
+            forEachDeclarator(decl, 1, [&](std::string_view typeName, std::string_view name, int count) {
+                UniformInfo info;
+                info.count = count;
+                if (isSamplerType(typeName))
+                {
+                    info.location     = _nextSamplerLocation++;
+                    info.bufferOffset = -1;
+                }
+                else if (auto type = findType(typeName))
+                {  // GLSL100 loose uniform
+                    info.size         = type->size;
+                    info.location     = 0;
+                    info.bufferOffset = static_cast<unsigned int>(_totalBufferSize);
+                    _totalBufferSize += type->size * count;
+                }
+                else
+                    return;
+                addUniform(name, info);
+            });
+        }
+        else if (stage == ShaderStage::VERTEX && (decl[0] == "in"sv || decl[0] == "attribute"sv))
+        {
+            auto type = findType(decl[1]);
+            AttributeBindInfo info;
+            info.location = location >= 0 ? location : nextAttribLocation;
+            info.size     = type ? type->size : 0;
+            nextAttribLocation = (std::max)(nextAttribLocation, info.location + 1);
+            _activeAttribs.emplace(decl[2], info);
+        }
+    }
+}
+
+void ProgramNull::setBuiltinLocations()
+{
+    for (uint32_t i = 0; i < ATTRIBUTE_MAX; ++i)
+        _builtinAttributeLocation[i] = getAttributeLocation(s_builtinAttributeNames[i]);
+
+    for (uint32_t i = 0; i < UNIFORM_MAX; ++i)
+        _builtinUniformLocation[i] = getUniformLocation(s_builtinUniformNames[i]);
+}
+
+UniformLocation ProgramNull::getUniformLocation(backend::Uniform name) const
+{
+    return _builtinUniformLocation[name];
+}
+
+UniformLocation ProgramNull::getUniformLocation(std::string_view uniform) const
+{
+    UniformLocation uniformLocation;
+    auto iter = _activeUniformInfos.find(uniform);
+    if (iter != _activeUniformInfos.end())
+    {
+        uniformLocation.vertStage.location = iter->second.location;
+        uniformLocation.vertStage.offset   = iter->second.bufferOffset;
+    }
+    return uniformLocation;
+}
+
+int ProgramNull::getAttributeLocation(Attribute name) const
+{
+    return _builtinAttributeLocation[name];
+}
+
+int ProgramNull::getAttributeLocation(std::string_view name) const
+{
+    auto iter = _activeAttribs.find(name);
+    return iter != _activeAttribs.end() ? iter->second.location : -1;
+}
+
+std::size_t ProgramNull::getUniformBufferSize(ShaderStage stage) const
+{
+#ifdef AX_USE_METAL
+    // the whole buffer is reported as vertex stage, see ProgramState::init
+    if (stage != ShaderStage::VERTEX)
+        return 0;
+#endif
+    return _totalBufferSize;
+}
+
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+const std::unordered_map<std::string, int> ProgramNull::getAllUniformsLocation() const
+{
+    std::unordered_map<std::string, int> locations;
+    for (auto& [name, info] : _activeUniformInfos)
+        locations.emplace(name, info.location);
+    return locations;
+}
+#endif
+
+NS_AX_BACKEND_END
@@ -0,0 +1,110 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "../Program.h"
+
+#include <unordered_map>
+
+NS_AX_BACKEND_BEGIN
+
+class DriverNull;
+
+/**
+ * @addtogroup _null
+ * @{
+ */
+
+/**
+ * A program without GPU object. Attributes, samplers and uniform blocks are reflected from the
+ * GLSL source with std140 packing, so ProgramState gets the same buffer layout as with the GL backend
+ * and batching behaves alike. Sources which are not GLSL (i.e. MSL) yield an empty reflection.
+ */
+class ProgramNull : public Program
+{
+public:
+    ProgramNull(std::string_view vertexShader, std::string_view fragmentShader);
+
+    UniformLocation getUniformLocation(std::string_view uniform) const override;
+    UniformLocation getUniformLocation(backend::Uniform name) const override;
+
+    int getAttributeLocation(std::string_view name) const override;
+    int getAttributeLocation(Attribute name) const override;
+
+    int getMaxVertexLocation() const override { return _maxLocation; }
+    int getMaxFragmentLocation() const override { return _maxLocation; }
+
+    const hlookup::string_map<AttributeBindInfo>& getActiveAttributes() const override { return _activeAttribs; }
+
+    std::size_t getUniformBufferSize(ShaderStage stage) const override;
+
+    const hlookup::string_map<UniformInfo>& getAllActiveUniformInfo(ShaderStage stage) const override
+    {
+        return _activeUniformInfos;
+    }
+
+    bool getBinary(ProgramBinary& binary) const override;
+
+    /**
+     * The binary of a null program is a hash of its sources, DriverNull rejects it for any other sources.
+     */
+    static void makeBinary(std::string_view vertexShader, std::string_view fragmentShader, ProgramBinary& binary);
+
+    bool isCompileCompleted() const override;
+
+    /**
+     * Completed once the driver no longer defers compiles, see DriverNull::setProgramCompilesDeferred.
+     */
+    void setCompileDeferredBy(const DriverNull* driver) { _deferringDriver = driver; }
+
+protected:
+    bool completeCompile() override;
+
+private:
+    void reflect(std::string_view source, ShaderStage stage);
+    void setBuiltinLocations();
+
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    int getMappedLocation(int location) const override { return location; }
+    int getOriginalLocation(int location) const override { return location; }
+    const std::unordered_map<std::string, int> getAllUniformsLocation() const override;
+#endif
+
+    hlookup::string_map<AttributeBindInfo> _activeAttribs;
+    hlookup::string_map<UniformInfo> _activeUniformInfos;
+
+    std::size_t _totalBufferSize = 0;
+    int _maxLocation             = -1;
+    int _nextSamplerLocation     = 0;
+
+    const DriverNull* _deferringDriver = nullptr;
+
+    UniformLocation _builtinUniformLocation[UNIFORM_MAX];
+    int _builtinAttributeLocation[Attribute::ATTRIBUTE_MAX];
+};
+// end of _null group
+/// @}
+NS_AX_BACKEND_END
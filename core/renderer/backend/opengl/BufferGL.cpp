@@ -42,16 +42,26 @@ GLenum toGLUsage(const BufferUsage& usage)
         return GL_STATIC_DRAW;
     case BufferUsage::DYNAMIC:
         return GL_DYNAMIC_DRAW;
+    case BufferUsage::STREAM:
+        return GL_STREAM_DRAW;
     default:
         return GL_DYNAMIC_DRAW;
     }
 }
+
+#if AX_GL_STREAM_SYNC
+// A frame that hasn't completed after that long won't, the storage is orphaned instead
+constexpr GLuint64 STREAM_WAIT_TIMEOUT = 1000000000ull;
+#endif
 }  // namespace
 
 BufferGL::BufferGL(std::size_t size, BufferType type, BufferUsage usage) : Buffer(size, type, usage)
 {
     glGenBuffers(1, &_buffer);
 
+    if (BufferUsage::STREAM == usage)
+        allocateStreamStorage();
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     _backToForegroundListener =
         EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) { this->reloadBuffer(); });
@@ -61,6 +71,9 @@ BufferGL::BufferGL(std::size_t size, BufferType type, BufferUsage usage) : Buffe
 
 BufferGL::~BufferGL()
 {
+#if AX_GL_STREAM_SYNC
+    deleteStreamFences();
+#endif
     if (_buffer)
         __gl->deleteBuffer(_type, _buffer);
 #if AX_ENABLE_CACHE_TEXTURE_DATA
@@ -81,6 +94,19 @@ void BufferGL::reloadBuffer()
 {
     glGenBuffers(1, &_buffer);
 
+    if (BufferUsage::STREAM == _usage)
+    {
+        // The fences belong to the lost context
+#if AX_GL_STREAM_SYNC
+        for (auto& fence : _streamFences)
+            fence = nullptr;
+        _streamWaitPending = false;
+        _streamMapped      = false;
+#endif
+        allocateStreamStorage();
+        return;
+    }
+
     if (!_needDefaultStoredData)
         return;
 
@@ -138,4 +164,126 @@ void BufferGL::updateSubData(const void* data, std::size_t offset, std::size_t s
     }
 }
 
+void BufferGL::allocateStreamStorage()
+{
+    // Also orphans the previous storage, the driver keeps it alive until the pending draws are done with it
+    _bufferAllocated = _size * MAX_INFLIGHT_BUFFER;
+    glBufferData(__gl->bindBuffer(_type, _buffer), _bufferAllocated, nullptr, GL_STREAM_DRAW);
+    CHECK_GL_ERROR_DEBUG();
+
+#if AX_GL_STREAM_SYNC
+    deleteStreamFences();
+#endif
+}
+
+void* BufferGL::mapStream(std::size_t size, std::size_t& offset)
+{
+    AXASSERT(BufferUsage::STREAM == _usage, "BufferGL: mapStream requires BufferUsage::STREAM");
+
+#if AX_GL_STREAM_SYNC
+    if (_streamWaitPending)
+        waitStreamSegment();
+#endif
+
+    if (!reserveStreamRegion(size))
+    {
+        allocateStreamStorage();
+        ++_streamStats.orphans;
+    }
+    offset = _streamOffset;
+
+#if AX_GL_STREAM_SYNC
+    // Nothing the GPU may still read overlaps the region: skip the implicit sync of the driver
+    auto data = glMapBufferRange(__gl->bindBuffer(_type, _buffer), _streamOffset, size,
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    CHECK_GL_ERROR_DEBUG();
+    if (data)
+    {
+        _streamMapped = true;
+        return data;
+    }
+#endif
+
+    if (_streamData.empty())
+        _streamData.resize(_size);
+    return _streamData.data();
+}
+
+void BufferGL::unmapStream(std::size_t size)
+{
+#if AX_GL_STREAM_SYNC
+    if (_streamMapped)
+    {
+        _streamMapped = false;
+        glUnmapBuffer(__gl->bindBuffer(_type, _buffer));
+        CHECK_GL_ERROR_DEBUG();
+        commitStreamRegion(size);
+        return;
+    }
+#endif
+
+    if (size)
+    {
+        glBufferSubData(__gl->bindBuffer(_type, _buffer), _streamOffset, size, _streamData.data());
+        CHECK_GL_ERROR_DEBUG();
+    }
+    commitStreamRegion(size);
+}
+
+void BufferGL::nextStreamFrame()
+{
+#if AX_GL_STREAM_SYNC
+    // An untouched segment keeps the fence of the frame which wrote it last
+    if (_streamCursor != 0)
+    {
+        auto& fence = _streamFences[_streamSegment];
+        if (fence)
+            glDeleteSync(fence);
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    _streamWaitPending = _streamFences[advanceStreamSegment()] != nullptr;
+#else
+    if (advanceStreamSegment() == 0)
+        allocateStreamStorage();
+#endif
+}
+
+#if AX_GL_STREAM_SYNC
+void BufferGL::waitStreamSegment()
+{
+    _streamWaitPending = false;
+
+    auto& fence = _streamFences[_streamSegment];
+    auto status = glClientWaitSync(fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED)
+    {
+        ++_streamStats.stalls;
+        status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, STREAM_WAIT_TIMEOUT);
+    }
+
+    glDeleteSync(fence);
+    fence = nullptr;
+
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+    {
+        allocateStreamStorage();
+        ++_streamStats.orphans;
+    }
+}
+
+void BufferGL::deleteStreamFences()
+{
+    for (auto& fence : _streamFences)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    _streamWaitPending = false;
+}
+#endif
+
 NS_AX_BACKEND_END
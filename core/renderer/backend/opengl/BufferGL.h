@@ -30,6 +30,14 @@
 
 #include <vector>
 
+// Unsynchronized mapping and fence sync are core in GL 3.3 and GLES 3.0, WebGL 2 has neither mapping nor blocking
+// waits: stream buffers upload with glBufferSubData and orphan their storage when the ring wraps there.
+#if AX_GLES_PROFILE != 200 && AX_TARGET_PLATFORM != AX_PLATFORM_WASM
+#    define AX_GL_STREAM_SYNC 1
+#else
+#    define AX_GL_STREAM_SYNC 0
+#endif
+
 NS_AX_BACKEND_BEGIN
 /**
  * @addtogroup _opengl
@@ -47,7 +55,7 @@ public:
      * @param type Specifies the target buffer object. The symbolic constant must be BufferType::VERTEX or
      * BufferType::INDEX.
      * @param usage Specifies the expected usage pattern of the data store. The symbolic constant must be
-     * BufferUsage::STATIC, BufferUsage::DYNAMIC.
+     * BufferUsage::STATIC, BufferUsage::DYNAMIC or BufferUsage::STREAM.
      */
     BufferGL(std::size_t size, BufferType type, BufferUsage usage);
     ~BufferGL();
@@ -78,6 +86,23 @@ public:
      */
     virtual void usingDefaultStoredData(bool needDefaultStoredData) override;
 
+    /**
+     * Reserve a region in the segment of the current frame, mapped unsynchronized when supported.
+     * Waits on the fence of the segment the first time it is written in a frame.
+     * @see Buffer::mapStream
+     */
+    void* mapStream(std::size_t size, std::size_t& offset) override;
+
+    /**
+     * Unmap the region, or upload the staging block with glBufferSubData.
+     */
+    void unmapStream(std::size_t size) override;
+
+    /**
+     * Fence the segment written this frame and move to the next one.
+     */
+    void nextStreamFrame() override;
+
     /**
      * Get buffer object.
      * @return Buffer object.
@@ -85,6 +110,16 @@ public:
     inline GLuint getHandler() const { return _buffer; }
 
 private:
+    void allocateStreamStorage();
+#if AX_GL_STREAM_SYNC
+    void waitStreamSegment();
+    void deleteStreamFences();
+
+    GLsync _streamFences[MAX_INFLIGHT_BUFFER] = {};
+    bool _streamWaitPending                   = false;
+    bool _streamMapped                        = false;
+#endif
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     void reloadBuffer();
     void fillBuffer(const void* data, std::size_t offset, std::size_t size);
@@ -202,9 +202,10 @@ void CommandBufferGL::setInstanceBuffer(Buffer* buffer)
     _instanceTransformBuffer = static_cast<BufferGL*>(buffer);
 }
 
-void CommandBufferGL::setVertexBuffer(Buffer* buffer)
+void CommandBufferGL::setVertexBuffer(Buffer* buffer, std::size_t offset)
 {
     assert(buffer != nullptr);
+    _vertexBufferOffset = offset;
     if (buffer == nullptr || _vertexBuffer == buffer)
         return;
 
@@ -343,7 +344,7 @@ void CommandBufferGL::bindVertexBuffer(uint32_t& usedBits) const
         __gl->enableVertexAttribArray(attribute.index);
         glVertexAttribPointer(attribute.index, UtilsGL::getGLAttributeSize(attribute.format),
                               UtilsGL::toGLAttributeType(attribute.format), attribute.needToBeNormallized,
-                              vertexLayout->getStride(), (GLvoid*)attribute.offset);
+                              vertexLayout->getStride(), (GLvoid*)(_vertexBufferOffset + attribute.offset));
         // non-instance attrib not use divisor, so clear to 0
         __gl->clearVertexAttribDivisor(attribute.index);
         usedBits |= (1 << attribute.index);
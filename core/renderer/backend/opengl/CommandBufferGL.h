@@ -116,8 +116,9 @@ public:
     /**
      * Set a global buffer for all vertex shaders at the given bind point index 0.
      * @param buffer The vertex buffer to be setted in the buffer argument table.
+     * @param offset The offset in bytes of the first vertex.
      */
-    void setVertexBuffer(Buffer* buffer) override;
+    void setVertexBuffer(Buffer* buffer, std::size_t offset = 0) override;
 
     /**
      * Set unifroms and textures
@@ -222,6 +223,7 @@ protected:
     void cleanResources();
 
     BufferGL* _vertexBuffer                   = nullptr;
+    std::size_t _vertexBufferOffset           = 0;
     ProgramState* _programState               = nullptr;
     BufferGL* _indexBuffer                    = nullptr;
     BufferGL* _instanceTransformBuffer        = nullptr;
@@ -35,6 +35,9 @@
 #include "RenderTargetGL.h"
 #include "MacrosGL.h"
 #include "renderer/backend/ProgramManager.h"
+#if defined(AX_ENABLE_NULL_DRIVER)
+#    include "renderer/backend/null/DriverNull.h"
+#endif
 #if !defined(__APPLE__) && AX_TARGET_PLATFORM != AX_PLATFORM_WINRT
 #    include "CommandBufferGLES2.h"
 #endif
@@ -84,7 +87,14 @@ static void GL_EnumAllExtensions(_Fty&& func)
 DriverBase* DriverBase::getInstance()
 {
     if (!_instance)
-        _instance = new DriverGL();
+    {
+#if defined(AX_ENABLE_NULL_DRIVER)
+        if (_driverType == DriverType::Null)
+            _instance = new DriverNull();
+        else
+#endif
+            _instance = new DriverGL();
+    }
 
     return _instance;
 }
@@ -169,6 +179,19 @@ DriverGL::DriverGL()
 
     glGetIntegerv(GL_FRAMEBUFFER_BINDING, &_defaultFBO);
 
+#if AX_GLES_PROFILE != 200
+    // some drivers, i.e. Mesa without a shader cache, report no formats
+    GLint numBinaryFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numBinaryFormats);
+    _programBinarySupported = numBinaryFormats > 0;
+#endif
+
+#if AX_GL_PARALLEL_SHADER_COMPILE
+    _parallelShaderCompile = hasExtension("GL_KHR_parallel_shader_compile"sv);
+    if (_parallelShaderCompile)
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);  // let the driver choose
+#endif
+
 #if AX_GLES_PROFILE != 200
     glGenVertexArrays(1, &_defaultVAO);
     glBindVertexArray(_defaultVAO);
@@ -252,6 +275,27 @@ Program* DriverGL::newProgram(std::string_view vertexShader, std::string_view fr
     return new ProgramGL(vertexShader, fragmentShader);
 }
 
+Program* DriverGL::newProgram(std::string_view vertexShader,
+                              std::string_view fragmentShader,
+                              const ProgramBinary& binary)
+{
+    if (!_programBinarySupported)
+        return nullptr;
+
+    auto program = new ProgramGL(vertexShader, fragmentShader, binary);
+    if (!program->getHandler())
+    {
+        program->release();
+        return nullptr;
+    }
+    return program;
+}
+
+Program* DriverGL::newProgramAsync(std::string_view vertexShader, std::string_view fragmentShader)
+{
+    return new ProgramGL(vertexShader, fragmentShader, true);
+}
+
 void DriverGL::resetState()
 {
     OpenGLState::reset();
@@ -539,6 +583,10 @@ bool DriverGL::checkForFeatureSupported(FeatureType feature)
     case FeatureType::ASTC:
         featureSupported = checkASTCRenderability();
         break;
+    case FeatureType::ELEMENT_INDEX_UINT:
+        // core in desktop GL and GLES3.0+, GLES2.0 requires extension
+        featureSupported = !_verInfo.es || _verInfo.major >= 3 || hasExtension("GL_OES_element_index_uint"sv);
+        break;
     default:
         break;
     }
@@ -29,6 +29,13 @@
 #include "OpenGLState.h"
 #include "base/hlookup.h"
 
+// KHR_parallel_shader_compile is loaded by glad, the native GLES headers of iOS and WinRT don't declare it
+#if defined(glMaxShaderCompilerThreadsKHR)
+#    define AX_GL_PARALLEL_SHADER_COMPILE 1
+#else
+#    define AX_GL_PARALLEL_SHADER_COMPILE 0
+#endif
+
 NS_AX_BACKEND_BEGIN
 /**
  * @addtogroup _opengl
@@ -97,6 +104,26 @@ public:
      */
     Program* newProgram(std::string_view vertexShader, std::string_view fragmentShader) override;
 
+    /**
+     * New a Program from a binary returned by Program::getBinary, not auto released.
+     * @return A Program instance, or nullptr if the driver rejects the binary.
+     */
+    Program* newProgram(std::string_view vertexShader,
+                        std::string_view fragmentShader,
+                        const ProgramBinary& binary) override;
+
+    /**
+     * New a Program whose link status isn't waited for, see Program::isCompileCompleted.
+     */
+    Program* newProgramAsync(std::string_view vertexShader, std::string_view fragmentShader) override;
+
+    bool isProgramBinarySupported() const override { return _programBinarySupported; }
+
+    /**
+     * Check whether the driver compiles and links on its own threads, GL_KHR_parallel_shader_compile.
+     */
+    bool isParallelShaderCompileSupported() const { return _parallelShaderCompile; }
+
     void resetState() override;
 
     /// below is driver info API
@@ -172,6 +199,8 @@ private:
 
     bool _textureCompressionAstc = false;
     bool _textureCompressionEtc2 = false;
+    bool _programBinarySupported = false;
+    bool _parallelShaderCompile  = false;
 };
 // end of _opengl group
 /// @}
@@ -34,6 +34,7 @@
 #include "yasio/byte_buffer.hpp"
 #include "renderer/backend/opengl/UtilsGL.h"
 #include "OpenGLState.h"
+#include "DriverGL.h"
 
 NS_AX_BACKEND_BEGIN
 
@@ -118,7 +119,7 @@ static void setUniform(bool isArray, GLuint location, unsigned int size, GLenum
 }
 #endif
 
-ProgramGL::ProgramGL(std::string_view vertexShader, std::string_view fragmentShader)
+ProgramGL::ProgramGL(std::string_view vertexShader, std::string_view fragmentShader, bool async)
     : Program(vertexShader, fragmentShader)
 {
     _vertexShaderModule   = static_cast<ShaderModuleGL*>(ShaderCache::getInstance()->newVertexShaderModule(_vertexShader));
@@ -127,6 +128,31 @@ ProgramGL::ProgramGL(std::string_view vertexShader, std::string_view fragmentSha
     AX_SAFE_RETAIN(_vertexShaderModule);
     AX_SAFE_RETAIN(_fragmentShaderModule);
     compileProgram();
+    if (!async)
+        completeCompile();
+}
+
+ProgramGL::ProgramGL(std::string_view vertexShader, std::string_view fragmentShader, const ProgramBinary& binary)
+    : Program(vertexShader, fragmentShader)
+{
+    // no shader modules, they are only created if the context is lost and the program must be rebuilt
+#if AX_GLES_PROFILE != 200
+    _program = glCreateProgram();
+    if (_program)
+        glProgramBinary(_program, binary.format, binary.data.data(), static_cast<GLsizei>(binary.data.size()));
+#else
+    AX_UNUSED_PARAM(binary);
+#endif
+    completeCompile();
+}
+
+bool ProgramGL::completeCompile()
+{
+    if (_compileCompleted)
+        return _program != 0;
+    _compileCompleted = true;
+
+    checkLinkStatus();
     computeUniformInfos();
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     for (const auto& uniform : _activeUniformInfos)
@@ -143,6 +169,44 @@ ProgramGL::ProgramGL(std::string_view vertexShader, std::string_view fragmentSha
 #endif
 
     setBuiltinLocations();
+    return _program != 0;
+}
+
+bool ProgramGL::isCompileCompleted() const
+{
+#if AX_GL_PARALLEL_SHADER_COMPILE
+    if (!_compileCompleted && _program &&
+        static_cast<DriverGL*>(DriverBase::getInstance())->isParallelShaderCompileSupported())
+    {
+        GLint completed = GL_FALSE;
+        glGetProgramiv(_program, GL_COMPLETION_STATUS_KHR, &completed);
+        return completed != GL_FALSE;
+    }
+#endif
+    return true;
+}
+
+bool ProgramGL::getBinary(ProgramBinary& binary) const
+{
+#if AX_GLES_PROFILE != 200
+    if (!_program || !_compileCompleted)
+        return false;
+
+    GLint length = 0;
+    glGetProgramiv(_program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return false;
+
+    GLenum format = 0;
+    binary.data.resize(static_cast<size_t>(length));
+    glGetProgramBinary(_program, length, &length, &format, binary.data.data());
+    binary.data.resize(static_cast<size_t>(length));
+    binary.format = format;
+    return length > 0;
+#else
+    AX_UNUSED_PARAM(binary);
+    return false;
+#endif
 }
 
 ProgramGL::~ProgramGL()
@@ -165,9 +229,19 @@ void ProgramGL::reloadProgram()
     _activeUniformInfos.clear();
     _mapToCurrentActiveLocation.clear();
     _mapToOriginalLocation.clear();
+    if (!_vertexShaderModule)
+    {
+        // restored from a binary, which doesn't survive the context
+        _vertexShaderModule = static_cast<ShaderModuleGL*>(ShaderCache::getInstance()->newVertexShaderModule(_vertexShader));
+        _fragmentShaderModule =
+            static_cast<ShaderModuleGL*>(ShaderCache::getInstance()->newFragmentShaderModule(_fragmentShader));
+        AX_SAFE_RETAIN(_vertexShaderModule);
+        AX_SAFE_RETAIN(_fragmentShaderModule);
+    }
     static_cast<ShaderModuleGL*>(_vertexShaderModule)->compileShader(backend::ShaderStage::VERTEX, _vertexShader);
     static_cast<ShaderModuleGL*>(_fragmentShaderModule)->compileShader(backend::ShaderStage::FRAGMENT, _fragmentShader);
     compileProgram();
+    checkLinkStatus();
     computeUniformInfos();
 
     for (const auto& uniform : _activeUniformInfos)
@@ -198,12 +272,33 @@ void ProgramGL::compileProgram()
     glAttachShader(_program, vertShader);
     glAttachShader(_program, fragShader);
 
+#if AX_GLES_PROFILE != 200
+    if (DriverBase::getInstance()->isProgramBinarySupported())
+        glProgramParameteri(_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
     glLinkProgram(_program);
+}
+
+void ProgramGL::checkLinkStatus()
+{
+    if (!_program)
+        return;
 
     GLint status = 0;
     glGetProgramiv(_program, GL_LINK_STATUS, &status);
     if (GL_FALSE == status)
     {
+        // a rejected binary isn't an error, ProgramManager compiles the sources instead
+        if (!_vertexShaderModule || !_fragmentShaderModule)
+        {
+            glDeleteProgram(_program);
+            _program = 0;
+            return;
+        }
+
+        _vertexShaderModule->checkCompileStatus(_vertexShader);
+        _fragmentShaderModule->checkCompileStatus(_fragmentShader);
+
         GLint errorInfoLen = 0;
         glGetProgramiv(_program, GL_INFO_LOG_LENGTH, &errorInfoLen);
         if (errorInfoLen > 1)
@@ -86,7 +86,12 @@ public:
      * @param vertexShader Specifes the vertex shader source.
      * @param fragmentShader Specifes the fragment shader source.
      */
-    ProgramGL(std::string_view vertexShader, std::string_view fragmentShader);
+    ProgramGL(std::string_view vertexShader, std::string_view fragmentShader, bool async = false);
+
+    /**
+     * Restore a program from a binary returned by getBinary, getHandler() is 0 if the driver rejects it.
+     */
+    ProgramGL(std::string_view vertexShader, std::string_view fragmentShader, const ProgramBinary& binary);
 
     ~ProgramGL();
 
@@ -163,8 +168,19 @@ public:
 
     void bindUniformBuffers(const char* buffer, size_t bufferSize);
 
+    bool getBinary(ProgramBinary& binary) const override;
+
+    /**
+     * Polls GL_COMPLETION_STATUS_KHR, without the extension the link is waited for by completeCompile.
+     */
+    bool isCompileCompleted() const override;
+
+protected:
+    bool completeCompile() override;
+
 private:
     void compileProgram();
+    void checkLinkStatus();
     void computeUniformInfos();
     void setBuiltinLocations();
 
@@ -200,6 +216,7 @@ private:
     std::size_t _totalBufferSize = 0;  // total uniform buffer size (all blocks)
 
     int _maxLocation = -1;
+    bool _compileCompleted = false;
     UniformLocation _builtinUniformLocation[UNIFORM_MAX];
     int _builtinAttributeLocation[Attribute::ATTRIBUTE_MAX];
 };
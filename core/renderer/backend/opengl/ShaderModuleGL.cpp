@@ -51,6 +51,12 @@ void ShaderModuleGL::compileShader(ShaderStage stage, std::string_view source)
 
     glShaderSource(_shader, 1, &sourcePtr, nullptr);
     glCompileShader(_shader);
+}
+
+bool ShaderModuleGL::checkCompileStatus(std::string_view source)
+{
+    if (!_shader)
+        return false;
 
     GLint status = 0;
     glGetShaderiv(_shader, GL_COMPILE_STATUS, &status);
@@ -73,7 +79,9 @@ void ShaderModuleGL::compileShader(ShaderStage stage, std::string_view source)
 
         deleteShader();
         AXASSERT(false, "Shader compile failed!");
+        return false;
     }
+    return true;
 }
 
 void ShaderModuleGL::deleteShader()
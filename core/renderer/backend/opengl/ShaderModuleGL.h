@@ -54,7 +54,9 @@ public:
     inline GLuint getShader() const { return _shader; }
 
 private:
+    /// Issues the compile without waiting for it, the status is checked by checkCompileStatus
     void compileShader(ShaderStage stage, std::string_view source);
+    bool checkCompileStatus(std::string_view source);
     void deleteShader();
 
     GLuint _shader = 0;
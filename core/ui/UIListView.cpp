@@ -48,6 +48,9 @@ ListView::ListView()
     , _curSelectedIndex(-1)
     , _innerContainerDoLayoutDirty(true)
     , _eventCallback(nullptr)
+    , _dataSource(nullptr)
+    , _preloadRatio(0.5f)
+    , _virtualizedItemsDirty(false)
 {
     this->setTouchEnabled(true);
 }
@@ -55,6 +58,7 @@ ListView::ListView()
 ListView::~ListView()
 {
     _items.clear();
+    _virtualizedItems.clear();
     AX_SAFE_RELEASE(_model);
 }
 
@@ -109,6 +113,21 @@ void ListView::onItemListChanged()
 
 void ListView::updateInnerContainerSize()
 {
+    if (_dataSource)
+    {
+        size_t length = _itemOffsets.size() - 1;
+        float total   = (length == 0) ? 0.0f : _itemOffsets.back() - _itemsMargin;
+        if (_direction == Direction::VERTICAL)
+        {
+            setInnerContainerSize(Vec2(_contentSize.width, (length == 0) ? 0.0f : total + _bottomPadding));
+        }
+        else if (_direction == Direction::HORIZONTAL)
+        {
+            setInnerContainerSize(Vec2((length == 0) ? 0.0f : total + _rightPadding, _contentSize.height));
+        }
+        return;
+    }
+
     switch (_direction)
     {
     case Direction::VERTICAL:
@@ -322,6 +341,13 @@ void ListView::removeChild(ax::Node* child, bool cleanup)
         }
         _items.eraseObject(widget);
         onItemListChanged();
+
+        auto iter = std::find_if(_virtualizedItems.begin(), _virtualizedItems.end(),
+                                 [widget](const VirtualizedItem& v) { return v.item == widget; });
+        if (iter != _virtualizedItems.end())
+        {
+            _virtualizedItems.erase(iter);
+        }
     }
 
     ScrollView::removeChild(child, cleanup);
@@ -338,6 +364,8 @@ void ListView::removeAllChildrenWithCleanup(bool cleanup)
     ScrollView::removeAllChildrenWithCleanup(cleanup);
     _curSelectedIndex = -1;
     _items.clear();
+    _virtualizedItems.clear();
+    _virtualizedItemsDirty = true;
     onItemListChanged();
 }
 
@@ -381,6 +409,12 @@ void ListView::removeAllItems()
 
 Widget* ListView::getItem(ssize_t index) const
 {
+    if (_dataSource)
+    {
+        auto iter = std::lower_bound(_virtualizedItems.begin(), _virtualizedItems.end(), index,
+                                     [](const VirtualizedItem& v, ssize_t i) { return v.index < i; });
+        return (iter != _virtualizedItems.end() && iter->index == index) ? iter->item : nullptr;
+    }
     if (index < 0 || index >= _items.size())
     {
         return nullptr;
@@ -399,6 +433,17 @@ ssize_t ListView::getIndex(Widget* item) const
     {
         return -1;
     }
+    if (_dataSource)
+    {
+        for (auto&& v : _virtualizedItems)
+        {
+            if (v.item == item)
+            {
+                return v.index;
+            }
+        }
+        return -1;
+    }
     return _items.getIndex(item);
 }
 
@@ -530,16 +575,17 @@ void ListView::setDirection(Direction dir)
     case Direction::BOTH:
         break;
     case Direction::VERTICAL:
-        setLayoutType(Type::VERTICAL);
+        setLayoutType(_dataSource ? Type::ABSOLUTE : Type::VERTICAL);
         break;
     case Direction::HORIZONTAL:
-        setLayoutType(Type::HORIZONTAL);
+        setLayoutType(_dataSource ? Type::ABSOLUTE : Type::HORIZONTAL);
         break;
     default:
         return;
         break;
     }
     ScrollView::setDirection(dir);
+    requestDoLayout();
 }
 
 void ListView::requestDoLayout()
@@ -549,6 +595,20 @@ void ListView::requestDoLayout()
 
 void ListView::doLayout()
 {
+    if (_dataSource)
+    {
+        // runs on every visit, so the items follow the inner container as it scrolls
+        if (_innerContainerDoLayoutDirty)
+        {
+            recycleVirtualizedItems();
+            updateItemOffsets();
+            updateInnerContainerSize();
+            _innerContainerDoLayoutDirty = false;
+        }
+        updateVirtualizedItems();
+        return;
+    }
+
     if (!_innerContainerDoLayoutDirty)
     {
         return;
@@ -566,6 +626,273 @@ void ListView::doLayout()
     _innerContainerDoLayoutDirty = false;
 }
 
+void ListView::setDataSource(ListViewDataSource* dataSource)
+{
+    if (_dataSource == dataSource)
+    {
+        return;
+    }
+    if (_dataSource)
+    {
+        recycleVirtualizedItems();
+        _reusableItems.clear();
+    }
+    else
+    {
+        removeAllItems();
+    }
+    _dataSource       = dataSource;
+    _curSelectedIndex = -1;
+    _itemOffsets.clear();
+
+    // virtualized items are placed by the list view itself, not by the linear layout of the inner container
+    if (_direction == Direction::VERTICAL)
+    {
+        setLayoutType(_dataSource ? Type::ABSOLUTE : Type::VERTICAL);
+    }
+    else if (_direction == Direction::HORIZONTAL)
+    {
+        setLayoutType(_dataSource ? Type::ABSOLUTE : Type::HORIZONTAL);
+    }
+    requestDoLayout();
+}
+
+void ListView::reloadData()
+{
+    if (_dataSource)
+    {
+        requestDoLayout();
+        doLayout();
+    }
+}
+
+Widget* ListView::dequeueItem(std::string_view reuseIdentifier)
+{
+    auto iter = _reusableItems.find(reuseIdentifier);
+    if (iter == _reusableItems.end() || iter->second.empty())
+    {
+        return nullptr;
+    }
+    Widget* item = iter->second.back();
+    item->retain();
+    iter->second.popBack();
+    item->autorelease();
+    return item;
+}
+
+void ListView::setPreloadRatio(float ratio)
+{
+    _preloadRatio          = std::max(ratio, 0.0f);
+    _virtualizedItemsDirty = true;
+}
+
+float ListView::getPreloadRatio() const
+{
+    return _preloadRatio;
+}
+
+void ListView::updateItemOffsets()
+{
+    ssize_t length = _dataSource->numberOfItemsInListView(this);
+    _itemOffsets.resize(length + 1);
+
+    float offset = (_direction == Direction::HORIZONTAL) ? _leftPadding : _topPadding;
+    for (ssize_t i = 0; i < length; ++i)
+    {
+        _itemOffsets[i] = offset;
+        offset += _dataSource->itemSizeForIndex(this, i) + _itemsMargin;
+    }
+    _itemOffsets[length] = offset;
+}
+
+void ListView::updateVirtualizedItems()
+{
+    const Vec2& position = _innerContainer->getPosition();
+    if (!_virtualizedItemsDirty && position == _virtualizedPosition)
+    {
+        return;
+    }
+    _virtualizedItemsDirty = false;
+    _virtualizedPosition   = position;
+
+    // the part of the inner container in view, measured like the item offsets
+    float viewStart, viewLength;
+    if (_direction == Direction::HORIZONTAL)
+    {
+        viewLength = _contentSize.width;
+        viewStart  = -position.x;
+    }
+    else
+    {
+        viewLength = _contentSize.height;
+        viewStart  = _innerContainer->getContentSize().height + position.y - viewLength;
+    }
+    float preload = viewLength * _preloadRatio;
+    float viewEnd = viewStart + viewLength + preload;
+    viewStart -= preload;
+
+    // the first item ending after the start of the range and the last one starting before its end
+    ssize_t first =
+        std::upper_bound(_itemOffsets.begin() + 1, _itemOffsets.end(), viewStart) - _itemOffsets.begin() - 1;
+    ssize_t last = std::lower_bound(_itemOffsets.begin(), _itemOffsets.end() - 1, viewEnd) - _itemOffsets.begin() - 1;
+
+    size_t count = 0;
+    for (size_t i = 0; i < _virtualizedItems.size(); ++i)
+    {
+        auto& v = _virtualizedItems[i];
+        if (v.index < first || v.index > last)
+        {
+            recycleVirtualizedItem(v.index, v.item, std::move(v.reuseIdentifier));
+        }
+        else if (count++ != i)
+        {
+            _virtualizedItems[count - 1] = std::move(v);
+        }
+    }
+    _virtualizedItems.erase(_virtualizedItems.begin() + count, _virtualizedItems.end());
+
+    // the items left are contiguous, create the missing ones on both sides
+    ssize_t keptFirst = _virtualizedItems.empty() ? last + 1 : _virtualizedItems.front().index;
+    ssize_t keptLast  = _virtualizedItems.empty() ? last : _virtualizedItems.back().index;
+    auto addItem      = [this](ssize_t index) {
+        Widget* item = _dataSource->itemAtIndex(this, index);
+        AXASSERT(nullptr != item, "ListViewDataSource::itemAtIndex can't return nullptr!");
+        ScrollView::addChild(item, static_cast<int>(index), item->getTag());
+        positionVirtualizedItem(item, index);
+        _virtualizedItems.emplace_back(
+            VirtualizedItem{index, item, std::string{_dataSource->reuseIdentifierForIndex(this, index)}});
+    };
+    for (ssize_t i = first; i < keptFirst; ++i)
+    {
+        addItem(i);
+    }
+    for (ssize_t i = keptLast + 1; i <= last; ++i)
+    {
+        addItem(i);
+    }
+    std::sort(_virtualizedItems.begin(), _virtualizedItems.end(),
+              [](const VirtualizedItem& a, const VirtualizedItem& b) { return a.index < b.index; });
+}
+
+void ListView::recycleVirtualizedItems()
+{
+    for (auto&& v : _virtualizedItems)
+    {
+        recycleVirtualizedItem(v.index, v.item, std::move(v.reuseIdentifier));
+    }
+    _virtualizedItems.clear();
+    _virtualizedItemsDirty = true;
+}
+
+void ListView::recycleVirtualizedItem(ssize_t index, Widget* item, std::string&& reuseIdentifier)
+{
+    _dataSource->itemWillRecycle(this, index, item);
+    _reusableItems[std::move(reuseIdentifier)].pushBack(item);
+    _innerContainer->removeChild(item, true);
+}
+
+void ListView::positionVirtualizedItem(Widget* item, ssize_t index)
+{
+    // the placement of the linear layout in a regular list view, paddings are its margins
+    const Vec2& innerSize = _innerContainer->getContentSize();
+    const Vec2& ap        = item->getAnchorPoint();
+    Vec2 size             = item->getBoundingBox().size;
+    Vec2 position;
+    if (_direction == Direction::HORIZONTAL)
+    {
+        position.x = _itemOffsets[index] + ap.x * size.width;
+        switch (_gravity)
+        {
+        case Gravity::BOTTOM:
+            position.y = ap.y * size.height;
+            break;
+        case Gravity::CENTER_VERTICAL:
+            position.y = innerSize.height / 2.0f - size.height * (0.5f - ap.y);
+            break;
+        default:
+            position.y = innerSize.height - (1.0f - ap.y) * size.height;
+            break;
+        }
+        position.y -= _topPadding;
+    }
+    else
+    {
+        position.y = innerSize.height - _itemOffsets[index] - (1.0f - ap.y) * size.height;
+        switch (_gravity)
+        {
+        case Gravity::RIGHT:
+            position.x = innerSize.width - (1.0f - ap.x) * size.width;
+            break;
+        case Gravity::CENTER_HORIZONTAL:
+            position.x = innerSize.width / 2.0f - size.width * (0.5f - ap.x);
+            break;
+        default:
+            position.x = ap.x * size.width;
+            break;
+        }
+        position.x += _leftPadding;
+    }
+    item->setPosition(position);
+}
+
+Vec2 ListView::calculateVirtualizedItemDestination(ssize_t itemIndex,
+                                                   const Vec2& positionRatioInView,
+                                                   const Vec2& itemAnchorPoint) const
+{
+    // the item may not exist yet, its extent comes from the offsets
+    float length     = _itemOffsets[itemIndex + 1] - _itemOffsets[itemIndex] - _itemsMargin;
+    Vec2 destination = _innerContainer->getPosition();
+    if (_direction == Direction::HORIZONTAL)
+    {
+        float itemPosition = _itemOffsets[itemIndex] + length * itemAnchorPoint.x;
+        destination.x      = _contentSize.width * positionRatioInView.x - itemPosition;
+    }
+    else
+    {
+        float itemPosition =
+            _innerContainer->getContentSize().height - _itemOffsets[itemIndex] - length * (1.0f - itemAnchorPoint.y);
+        destination.y = _contentSize.height * positionRatioInView.y - itemPosition;
+    }
+    return destination;
+}
+
+ssize_t ListView::getClosestVirtualizedItemIndex(const Vec2& targetPosition, const Vec2& itemAnchorPoint) const
+{
+    ssize_t length = static_cast<ssize_t>(_itemOffsets.size()) - 1;
+    if (length <= 0)
+    {
+        return -1;
+    }
+
+    // the anchors of the items measured like the item offsets, they grow with the index
+    bool horizontal    = (_direction == Direction::HORIZONTAL);
+    float anchor       = horizontal ? itemAnchorPoint.x : 1.0f - itemAnchorPoint.y;
+    float target       = horizontal ? targetPosition.x : _innerContainer->getContentSize().height - targetPosition.y;
+    auto anchorAtIndex = [&](ssize_t index) {
+        return _itemOffsets[index] + (_itemOffsets[index + 1] - _itemOffsets[index] - _itemsMargin) * anchor;
+    };
+
+    // the first item anchored at or after the target, or the last one, then the closer of it and its predecessor
+    ssize_t low = 0, high = length - 1;
+    while (low < high)
+    {
+        ssize_t mid = (low + high) / 2;
+        if (anchorAtIndex(mid) < target)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    if (low > 0 && target - anchorAtIndex(low - 1) < anchorAtIndex(low) - target)
+    {
+        --low;
+    }
+    return low;
+}
+
 void ListView::addEventListener(const ccListViewCallback& callback)
 {
     _eventCallback = callback;
@@ -675,6 +1002,12 @@ static Widget* findClosestItem(const Vec2& targetPosition,
 
 Widget* ListView::getClosestItemToPosition(const Vec2& targetPosition, const Vec2& itemAnchorPoint) const
 {
+    if (_dataSource)
+    {
+        // the children are only the items around the view, find the closest one by index from the layout
+        return getItem(getClosestVirtualizedItemIndex(targetPosition, itemAnchorPoint));
+    }
+
     if (_items.empty())
     {
         return nullptr;
@@ -813,14 +1146,26 @@ void ListView::jumpToPercentBothDirection(const Vec2& percent)
 
 void ListView::jumpToItem(ssize_t itemIndex, const Vec2& positionRatioInView, const Vec2& itemAnchorPoint)
 {
-    Widget* item = getItem(itemIndex);
-    if (item == nullptr)
+    Vec2 destination;
+    if (_dataSource)
     {
-        return;
+        doLayout();
+        if (itemIndex < 0 || itemIndex >= static_cast<ssize_t>(_itemOffsets.size()) - 1)
+        {
+            return;
+        }
+        destination = calculateVirtualizedItemDestination(itemIndex, positionRatioInView, itemAnchorPoint);
+    }
+    else
+    {
+        Widget* item = getItem(itemIndex);
+        if (item == nullptr)
+        {
+            return;
+        }
+        doLayout();
+        destination = calculateItemDestination(positionRatioInView, item, itemAnchorPoint);
     }
-    doLayout();
-
-    Vec2 destination = calculateItemDestination(positionRatioInView, item, itemAnchorPoint);
     if (!_bounceEnabled)
     {
         Vec2 delta         = destination - getInnerContainerPosition();
@@ -840,6 +1185,16 @@ void ListView::scrollToItem(ssize_t itemIndex,
                             const Vec2& itemAnchorPoint,
                             float timeInSec)
 {
+    if (_dataSource)
+    {
+        doLayout();
+        if (itemIndex >= 0 && itemIndex < static_cast<ssize_t>(_itemOffsets.size()) - 1)
+        {
+            startAutoScrollToDestination(
+                calculateVirtualizedItemDestination(itemIndex, positionRatioInView, itemAnchorPoint), timeInSec, true);
+        }
+        return;
+    }
     Widget* item = getItem(itemIndex);
     if (item == nullptr)
     {
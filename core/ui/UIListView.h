@@ -29,6 +29,7 @@ THE SOFTWARE.
 
 #include "ui/UIScrollView.h"
 #include "ui/GUIExport.h"
+#include "base/hlookup.h"
 
 /**
  * @addtogroup ui
@@ -40,12 +41,52 @@ namespace ax
 namespace ui
 {
 
+class ListView;
+
+/**
+ * Data source of a virtualized ListView.
+ * @see ListView::setDataSource
+ */
+class AX_GUI_DLL ListViewDataSource
+{
+public:
+    /**
+     * @js NA
+     * @lua NA
+     */
+    virtual ~ListViewDataSource() {}
+
+    /**
+     * Returns number of items in a given list view.
+     */
+    virtual ssize_t numberOfItemsInListView(ListView* listView) = 0;
+    /**
+     * Size of the item at given index along the scroll direction, the height of a row in a vertical list.
+     * It is queried for every item on reload to compute the size of the inner container, before the item exists.
+     */
+    virtual float itemSizeForIndex(ListView* listView, ssize_t idx) = 0;
+    /**
+     * An item instance for a given index, usually taken from `ListView::dequeueItem` and set up for the index.
+     */
+    virtual Widget* itemAtIndex(ListView* listView, ssize_t idx) = 0;
+    /**
+     * Reuse identifier of the item at given index. Items leaving the view are only handed out again by
+     * `ListView::dequeueItem` for the same identifier, so lists mixing item layouts give each layout its own.
+     */
+    virtual std::string_view reuseIdentifierForIndex(ListView* listView, ssize_t idx) { return ""sv; }
+    /**
+     * Called when an item leaves the view, right before it is removed and put into the reuse pool.
+     */
+    virtual void itemWillRecycle(ListView* listView, ssize_t idx, Widget* item) {}
+};
+
 /**
  *@brief ListView is a view group that displays a list of scrollable items.
  *The list items are inserted to the list by using `addChild` or  `insertDefaultItem`.
- * @warning The list item in ListView doesn't support cell reuse at the moment, if you have a large amount of data need
- *to be displayed, use  `TableView` instead. ListView is a subclass of  `ScrollView`, so it shares many features of
- *ScrollView.
+ *
+ * If you have a large amount of data need to be displayed, set a `ListViewDataSource` instead: only the items in view,
+ *plus a preload distance on both ends, are then created, and the items scrolled out of view are reused.
+ *ListView is a subclass of  `ScrollView`, so it shares many features of ScrollView.
  */
 class AX_GUI_DLL ListView : public ScrollView
 {
@@ -290,6 +331,48 @@ public:
      */
     float getBottomPadding() const;
 
+    /**
+     * @brief Switch the list view to virtualized mode, driven by a data source.
+     *
+     * Items are created on demand through `ListViewDataSource::itemAtIndex` and recycled once they scroll out of
+     * view, so only a screenful of them is alive whatever the number of rows. Items added with `pushBackCustomItem`
+     * and friends are removed, and magnetic scroll is not applied in this mode.
+     * Pass nullptr to leave virtualized mode. The data source is not retained.
+     * @param dataSource A data source, or nullptr.
+     */
+    void setDataSource(ListViewDataSource* dataSource);
+
+    /**
+     * @brief Query the data source of a virtualized list view.
+     * @return The data source, nullptr if the list view is not virtualized.
+     */
+    ListViewDataSource* getDataSource() const { return _dataSource; }
+
+    /**
+     * @brief Reload the item count and sizes from the data source and recreate the items in view.
+     * Call it whenever the data behind the list view changed.
+     */
+    void reloadData();
+
+    /**
+     * @brief Take an item out of the reuse pool of a virtualized list view.
+     * @param reuseIdentifier The identifier the item was recycled with.
+     * @return A recycled item, nullptr if none is available and the data source has to create one.
+     */
+    Widget* dequeueItem(std::string_view reuseIdentifier = ""sv);
+
+    /**
+     * @brief Set how far beyond each edge of the view the items of a virtualized list view are kept alive.
+     * @param ratio The distance as a ratio of the view length along the scroll direction, 0.5 by default.
+     */
+    void setPreloadRatio(float ratio);
+
+    /**
+     * @brief Query the preload distance of a virtualized list view.
+     * @return The distance as a ratio of the view length along the scroll direction.
+     */
+    float getPreloadRatio() const;
+
     // override methods
     void doLayout() override;
     void requestDoLayout() override;
@@ -444,6 +527,23 @@ protected:
 
     void startMagneticScroll();
 
+    void updateItemOffsets();
+    void updateVirtualizedItems();
+    void recycleVirtualizedItems();
+    void recycleVirtualizedItem(ssize_t index, Widget* item, std::string&& reuseIdentifier);
+    void positionVirtualizedItem(Widget* item, ssize_t index);
+    Vec2 calculateVirtualizedItemDestination(ssize_t itemIndex,
+                                             const Vec2& positionRatioInView,
+                                             const Vec2& itemAnchorPoint) const;
+    ssize_t getClosestVirtualizedItemIndex(const Vec2& targetPosition, const Vec2& itemAnchorPoint) const;
+
+    struct VirtualizedItem
+    {
+        ssize_t index;
+        Widget* item;
+        std::string reuseIdentifier;
+    };
+
 protected:
     Widget* _model;
 
@@ -465,6 +565,16 @@ protected:
 
     bool _innerContainerDoLayoutDirty;
     ccListViewCallback _eventCallback;
+
+    ListViewDataSource* _dataSource;
+    // start of every item from the leading padding, margin included, plus the end of the last one
+    std::vector<float> _itemOffsets;
+    // items in view, sorted by index; they are children of the inner container
+    std::vector<VirtualizedItem> _virtualizedItems;
+    hlookup::string_map<Vector<Widget*>> _reusableItems;
+    float _preloadRatio;
+    Vec2 _virtualizedPosition;
+    bool _virtualizedItemsDirty;
 };
 
 }  // namespace ui
@@ -814,6 +814,9 @@ int axlua_physics3d_Physics3DObject_setCollisionCallback(lua_State* L)
                 }
             }
             lua_rawset(Ls, -3);
+            lua_pushstring(Ls, "state");
+            lua_pushinteger(Ls, (lua_Integer)ci.state);
+            lua_rawset(Ls, -3);
             stack->executeFunctionByHandler(handler, 1);
         });
 
@@ -73,20 +73,30 @@ bool AppDelegate::applicationDidFinishLaunching()
     {
         std::string title = "Cpp Tests";
 #ifndef NDEBUG
-        title += " *Debug*",
+        title += " *Debug*";
 #endif
+#if defined(AX_ENABLE_NULL_DRIVER)
+        // headless run on GPU-less agents: no window and no GPU work, the null driver records counters
+        if (std::getenv("AXMOL_NULL_DRIVER"))
+            glView = GLViewNull::createWithRect(title, Rect(0, 0, g_resourceSize.width, g_resourceSize.height));
+#endif
+        if (!glView)
+        {
 #ifdef AX_PLATFORM_PC
-        glView = GLViewImpl::createWithRect(title, Rect(0, 0, g_resourceSize.width, g_resourceSize.height), 1.0F, true);
+            glView = GLViewImpl::createWithRect(title, Rect(0, 0, g_resourceSize.width, g_resourceSize.height), 1.0F,
+                                                true);
 #else
-        glView = GLViewImpl::createWithRect(title, Rect(0, 0, g_resourceSize.width, g_resourceSize.height));
+            glView = GLViewImpl::createWithRect(title, Rect(0, 0, g_resourceSize.width, g_resourceSize.height));
 #endif
+        }
         director->setGLView(glView);
     }
 
     director->setStatsDisplay(true);
 
 #ifdef AX_PLATFORM_PC
-    director->setAnimationInterval(1.0f / glfwGetVideoMode(glfwGetPrimaryMonitor())->refreshRate);
+    auto monitor = glfwGetPrimaryMonitor();
+    director->setAnimationInterval(monitor ? 1.0f / glfwGetVideoMode(monitor)->refreshRate : 1.0f / 60);
 #else
     director->setAnimationInterval(1.0f / 60);
 #endif
@@ -26,6 +26,7 @@
 #include "../testResource.h"
 #include "renderer/Renderer.h"
 #include "2d/FontAtlasCache.h"
+#include <chrono>
 
 using namespace ax;
 using namespace ui;
@@ -169,6 +170,7 @@ NewLabelTests::NewLabelTests()
     ADD_TEST_CASE(LabelIssueLineGap);
     ADD_TEST_CASE(LabelIssue17902);
     ADD_TEST_CASE(LabelLetterColorsTest);
+    ADD_TEST_CASE(LabelChurnBenchmark);
 };
 
 LabelFNTColorAndOpacity::LabelFNTColorAndOpacity()
@@ -3683,3 +3685,84 @@ void LabelLetterColorsTest::setLetterColors(ax::Label* label, const ax::Color3B&
             letter->setColor(color);
     }
 }
+
+//
+// LabelChurnBenchmark
+//
+LabelChurnBenchmark::LabelChurnBenchmark()
+{
+    auto size = Director::getInstance()->getWinSize();
+
+    // scores, timers and damage numbers, rewritten every frame
+    for (int i = 0; i < 300; ++i)
+    {
+        Label* label;
+        switch (i % 3)
+        {
+        case 0:
+            label = Label::createWithTTF("Score: 0", "fonts/arial.ttf", 12);
+            label->setAnchorPoint(Vec2::ANCHOR_MIDDLE_LEFT);
+            break;
+        case 1:
+            label = Label::createWithTTF("00:00.00", "fonts/arial.ttf", 12, Size::ZERO, TextHAlignment::CENTER);
+            break;
+        default:
+            // shrinks the longer numbers to its dimensions
+            label = Label::createWithTTF("0", "fonts/arial.ttf", 16, Size(40, 16), TextHAlignment::CENTER);
+            label->setOverflow(Label::Overflow::SHRINK);
+            break;
+        }
+        label->setPosition(Vec2(30 + (i % 15) * (size.width - 60) / 15, 40 + (i / 15) * (size.height - 120) / 20));
+        addChild(label);
+        _labels.push_back(label);
+    }
+
+    _resultLabel = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    _resultLabel->setPosition(Vec2(size.width / 2, size.height - 70));
+    addChild(_resultLabel, 1);
+
+    schedule(AX_CALLBACK_1(LabelChurnBenchmark::step, this), "step_key");
+}
+
+void LabelChurnBenchmark::step(float dt)
+{
+    ++_frame;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0, count = _labels.size(); i < count; ++i)
+    {
+        auto value = _frame * 7 + static_cast<int>(i) * 13;
+        switch (i % 3)
+        {
+        case 0:
+            _labels[i]->setString(fmt::format("Score: {}", value));
+            break;
+        case 1:
+            _labels[i]->setString(fmt::format("{:02}:{:02}.{:02}", value / 6000 % 60, value / 100 % 60, value % 100));
+            break;
+        default:
+            _labels[i]->setString(fmt::format("{}", value % 100000));
+            break;
+        }
+        // lays the label out now instead of on visit, to time it
+        _labels[i]->getContentSize();
+    }
+    _elapsedMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (++_measuredFrames == 60)
+    {
+        _resultLabel->setString(fmt::format("setString and layout of {} labels: {:.3f}ms per frame", _labels.size(),
+                                            _elapsedMs / _measuredFrames));
+        _elapsedMs      = 0.0;
+        _measuredFrames = 0;
+    }
+}
+
+std::string LabelChurnBenchmark::title() const
+{
+    return "Label churn benchmark";
+}
+
+std::string LabelChurnBenchmark::subtitle() const
+{
+    return "Only the changed tail of each string is laid out again";
+}
@@ -1030,4 +1030,24 @@ private:
     static void setLetterColors(ax::Label* label, const ax::Color3B& color);
 };
 
+class LabelChurnBenchmark : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelChurnBenchmark);
+
+    LabelChurnBenchmark();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    void step(float dt);
+
+    std::vector<ax::Label*> _labels;
+    ax::Label* _resultLabel;
+    int _frame          = 0;
+    double _elapsedMs   = 0.0;
+    int _measuredFrames = 0;
+};
+
 #endif
@@ -46,6 +46,8 @@ NavMeshTests::NavMeshTests()
 #else
     ADD_TEST_CASE(NavMeshBasicTestDemo);
     ADD_TEST_CASE(NavMeshAdvanceTestDemo);
+    ADD_TEST_CASE(NavMeshBuildTestDemo);
+    ADD_TEST_CASE(NavMeshAsyncQueryTestDemo);
 #endif
 };
 
@@ -436,4 +438,159 @@ void NavMeshAdvanceTestDemo::touchesEnded(const std::vector<ax::Touch*>& touches
     }
 }
 
+bool NavMeshBuildTestDemo::init()
+{
+    if (!NavMeshBasicTestDemo::init())
+        return false;
+
+    // the same scene as the baked navmesh, built at runtime instead
+    _geometry.addTriangles(Bundle3D::getTrianglesList("NavMesh/scene.obj"));
+    auto navMesh = NavMesh::create(_geometry);
+    if (!navMesh)
+        return false;
+    navMesh->setDebugDrawEnable(true);
+    setNavMesh(navMesh);
+
+    TTFConfig ttfConfig("fonts/arial.ttf", 15);
+    auto menuItem = MenuItemLabel::create(Label::createWithTTF(ttfConfig, "Rebuild Center Tiles"), [this](Object*) {
+        getNavMesh()->rebuildTiles(_geometry, AABB(Vec3(-10.0f, -10.0f, -10.0f), Vec3(10.0f, 10.0f, 10.0f)));
+        showBuildReport("rebuilt");
+    });
+    menuItem->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    menuItem->setPosition(Vec2(VisibleRect::left().x, VisibleRect::top().y - 50));
+    auto menu = Menu::create(menuItem, nullptr);
+    menu->setPosition(Vec2::ZERO);
+    addChild(menu);
+
+    _reportLabel = Label::createWithTTF(ttfConfig, "");
+    _reportLabel->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    _reportLabel->setPosition(Vec2(VisibleRect::left().x, VisibleRect::top().y - 130));
+    addChild(_reportLabel);
+    showBuildReport("built");
+
+    return true;
+}
+
+void NavMeshBuildTestDemo::showBuildReport(std::string_view what)
+{
+    const auto& report = getNavMesh()->getBuildReport();
+    float slowest = 0.0f, sum = 0.0f;
+    int layers    = 0;
+    for (auto&& tile : report.tiles)
+    {
+        slowest = std::max(slowest, tile.milliseconds);
+        sum += tile.milliseconds;
+        layers += tile.layers;
+    }
+    _reportLabel->setString(fmt::format(
+        "{} {} tiles, {} layers in {:.1f}ms\nrasterized in {:.1f}ms, {:.1f}ms of work, slowest tile {:.1f}ms", what,
+        report.tiles.size(), layers, report.totalMilliseconds, report.rasterizeMilliseconds, sum, slowest));
+}
+
+std::string NavMeshBuildTestDemo::subtitle() const
+{
+    return "Runtime Built Tiles";
+}
+
+NavMeshAsyncQueryTestDemo::NavMeshAsyncQueryTestDemo()
+    : _resultLabel(nullptr), _syncSeconds(0.0), _pendingQueries(0), _asyncFrames(0), _maxFrameDelta(0.0f)
+{}
+
+NavMeshAsyncQueryTestDemo::~NavMeshAsyncQueryTestDemo() {}
+
+bool NavMeshAsyncQueryTestDemo::init()
+{
+    if (!NavMeshBaseTestDemo::init())
+        return false;
+
+    TTFConfig ttfConfig("fonts/arial.ttf", 15);
+    auto menuItem = MenuItemLabel::create(Label::createWithTTF(ttfConfig, "Find 1000 Paths"),
+                                          [this](Object*) { runBenchmark(); });
+    menuItem->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    menuItem->setPosition(Vec2(VisibleRect::left().x, VisibleRect::top().y - 50));
+    auto menu = Menu::create(menuItem, nullptr);
+    menu->setPosition(Vec2::ZERO);
+    addChild(menu);
+
+    _resultLabel = Label::createWithTTF(ttfConfig, "");
+    _resultLabel->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    _resultLabel->setPosition(Vec2(VisibleRect::left().x, VisibleRect::top().y - 80));
+    addChild(_resultLabel);
+
+    return true;
+}
+
+void NavMeshAsyncQueryTestDemo::onEnter()
+{
+    NavMeshBaseTestDemo::onEnter();
+
+    // random endpoints dropped on the scene, shared by the blocking and the async runs
+    auto randomPoint = [this]() {
+        float x = ax::random(-50.0f, 50.0f);
+        float z = ax::random(-50.0f, 50.0f);
+        Physics3DWorld::HitResult result;
+        getPhysics3DWorld()->rayCast(Vec3(x, 50.0f, z), Vec3(x, -50.0f, z), &result);
+        return result.hitPosition;
+    };
+    _queries.clear();
+    for (int i = 0; i < 1000; ++i)
+        _queries.emplace_back(randomPoint(), randomPoint());
+}
+
+void NavMeshAsyncQueryTestDemo::runBenchmark()
+{
+    auto navMesh = getNavMesh();
+    if (_pendingQueries || !navMesh)
+        return;
+
+    std::vector<Vec3> pathPoints;
+    auto start = std::chrono::steady_clock::now();
+    for (auto&& query : _queries)
+    {
+        pathPoints.clear();
+        navMesh->findPath(query.first, query.second, pathPoints);
+    }
+    _syncSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    _pendingQueries = static_cast<int>(_queries.size());
+    _asyncFrames    = 0;
+    _maxFrameDelta  = 0.0f;
+    _asyncStart     = std::chrono::steady_clock::now();
+    for (auto&& query : _queries)
+    {
+        navMesh->findPathAsync(query.first, query.second, [this](const std::vector<Vec3>&) {
+            if (--_pendingQueries > 0)
+                return;
+            double asyncSeconds =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - _asyncStart).count();
+            _resultLabel->setString(fmt::format(
+                "blocking: {:.1f}ms in one frame, {:.0f} paths/s\n"
+                "async: {:.1f}ms over {} frames, {:.0f} paths/s, longest frame {:.1f}ms",
+                _syncSeconds * 1e3, _queries.size() / _syncSeconds, asyncSeconds * 1e3, _asyncFrames,
+                _queries.size() / asyncSeconds, _maxFrameDelta * 1e3f));
+        });
+    }
+    _resultLabel->setString("running...");
+}
+
+void NavMeshAsyncQueryTestDemo::update(float delta)
+{
+    NavMeshBaseTestDemo::update(delta);
+    if (_pendingQueries)
+    {
+        ++_asyncFrames;
+        _maxFrameDelta = std::max(_maxFrameDelta, delta);
+    }
+}
+
+std::string NavMeshAsyncQueryTestDemo::title() const
+{
+    return "Navigation Mesh Test";
+}
+
+std::string NavMeshAsyncQueryTestDemo::subtitle() const
+{
+    return "Async Path Queries";
+}
+
 #endif
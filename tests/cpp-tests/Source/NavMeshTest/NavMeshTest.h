@@ -29,7 +29,9 @@
 
 #include "../BaseTest.h"
 #include "navmesh/NavMesh.h"
+#include <chrono>
 #include <string>
+#include <vector>
 
 DEFINE_TEST_SUITE(NavMeshTests);
 
@@ -121,6 +123,51 @@ protected:
     ax::Label* _debugLabel;
 };
 
+class NavMeshBuildTestDemo : public NavMeshBasicTestDemo
+{
+public:
+    CREATE_FUNC(NavMeshBuildTestDemo);
+
+    // overrides
+    virtual bool init() override;
+    virtual std::string subtitle() const override;
+
+protected:
+    void showBuildReport(std::string_view what);
+
+protected:
+    ax::NavMeshGeometry _geometry;
+    ax::Label* _reportLabel;
+};
+
+class NavMeshAsyncQueryTestDemo : public NavMeshBaseTestDemo
+{
+public:
+    CREATE_FUNC(NavMeshAsyncQueryTestDemo);
+    NavMeshAsyncQueryTestDemo();
+    virtual ~NavMeshAsyncQueryTestDemo();
+
+    // overrides
+    virtual bool init() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onEnter() override;
+    virtual void update(float delta) override;
+
+protected:
+    void runBenchmark();
+
+protected:
+    ax::Label* _resultLabel;
+    std::vector<std::pair<ax::Vec3, ax::Vec3>> _queries;
+    std::chrono::steady_clock::time_point _asyncStart;
+    double _syncSeconds;
+    int _pendingQueries;
+    int _asyncFrames;
+    float _maxFrameDelta;
+};
+
 #endif
 
 #endif
@@ -28,6 +28,9 @@
 #include <chrono>
 #include <sstream>
 #include "renderer/backend/DriverBase.h"
+#if defined(AX_ENABLE_NULL_DRIVER)
+#    include "renderer/backend/null/DriverNull.h"
+#endif
 
 namespace
 {
@@ -93,6 +96,11 @@ NewRendererTests::NewRendererTests()
     ADD_TEST_CASE(RendererUniformBatch2);
     ADD_TEST_CASE(SpriteCreation);
     ADD_TEST_CASE(NonBatchSprites);
+    ADD_TEST_CASE(RendererBatchIndexFormat);
+    ADD_TEST_CASE(RendererSortBenchmark);
+#if defined(AX_ENABLE_NULL_DRIVER)
+    ADD_TEST_CASE(RendererNullDriverStats);
+#endif
 };
 
 std::string MultiSceneTest::title() const
@@ -958,6 +966,266 @@ std::string RendererUniformBatch2::subtitle() const
     return "Mixing different shader states should work ok";
 }
 
+RendererBatchIndexFormat::RendererBatchIndexFormat()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    _savedIndexFormat = Director::getInstance()->getRenderer()->getBatchIndexFormat();
+
+    auto parent = Node::create();
+    addChild(parent);
+
+    // 50K sprites sharing the same material, they can be batched in a single draw call with 32-bit indices
+    for (int i = 0; i < 50000; ++i)
+    {
+        auto sprite = Sprite::create("Images/grossini_dance_01.png");
+        sprite->setScale(0.1f, 0.1f);
+        float x = ((float)std::rand()) / RAND_MAX;
+        float y = ((float)std::rand()) / RAND_MAX;
+        sprite->setPosition(Vec2(x * s.width, y * s.height));
+        parent->addChild(sprite);
+    }
+
+    MenuItemFont::setFontName("fonts/arial.ttf");
+    MenuItemFont::setFontSize(30);
+    auto toggle = MenuItemToggle::createWithCallback(AX_CALLBACK_1(RendererBatchIndexFormat::switchIndexFormat, this),
+                                                     MenuItemFont::create("16-bit indices"),
+                                                     MenuItemFont::create("32-bit indices"), nullptr);
+    toggle->setSelectedIndex(_savedIndexFormat == backend::IndexFormat::U_INT ? 1 : 0);
+    auto menu = Menu::create(toggle, nullptr);
+    menu->setPosition(Vec2(s.width / 2, s.height - 100));
+    addChild(menu, 1);
+
+    _statsLabel = Label::createWithTTF(TTFConfig("fonts/arial.ttf", 24), "draw calls: ..");
+    _statsLabel->setColor(Color3B::YELLOW);
+    _statsLabel->enableOutline(Color4B::RED, 2);
+    _statsLabel->setPosition(Vec2(s.width / 2, s.height - 140));
+    addChild(_statsLabel, 1);
+
+    scheduleUpdate();
+}
+
+void RendererBatchIndexFormat::switchIndexFormat(Object* sender)
+{
+    auto toggle   = static_cast<MenuItemToggle*>(sender);
+    auto renderer = Director::getInstance()->getRenderer();
+    renderer->setBatchIndexFormat(toggle->getSelectedIndex() == 1 ? backend::IndexFormat::U_INT
+                                                                  : backend::IndexFormat::U_SHORT);
+    // device may not support 32-bit indices
+    toggle->setSelectedIndex(renderer->getBatchIndexFormat() == backend::IndexFormat::U_INT ? 1 : 0);
+}
+
+void RendererBatchIndexFormat::update(float dt)
+{
+    // stats of the last frame
+    auto renderer = Director::getInstance()->getRenderer();
+    _statsLabel->setString(fmt::format("draw calls: {}, vertices: {}\nuploaded: {} bytes, stream stalls: {}",
+                                       renderer->getDrawnBatches(), renderer->getDrawnVertices(),
+                                       renderer->getUploadedBytes(), renderer->getStreamStalls()));
+}
+
+void RendererBatchIndexFormat::onExit()
+{
+    Director::getInstance()->getRenderer()->setBatchIndexFormat(_savedIndexFormat);
+    MultiSceneTest::onExit();
+}
+
+std::string RendererBatchIndexFormat::title() const
+{
+    return "Batch Index Format";
+}
+
+std::string RendererBatchIndexFormat::subtitle() const
+{
+    return "50K sprites, 32-bit indices should need fewer draw calls";
+}
+
+namespace
+{
+class SortBenchmarkCommand : public TrianglesCommand
+{
+public:
+    SortBenchmarkCommand(float globalOrder, uint32_t materialID)
+    {
+        _globalOrder = globalOrder;
+        _materialID  = materialID;
+    }
+};
+
+// Draw calls the batcher would issue: a batch ends on a material change and at the end of each sub queue
+size_t countBatches(RenderQueue& queue)
+{
+    size_t batches = 0;
+    for (int group = 0; group < RenderQueue::QUEUE_COUNT; ++group)
+    {
+        uint32_t prevMaterialID = 0;
+        for (auto command : queue.getSubQueue(RenderQueue::QUEUE_GROUP(group)))
+        {
+            auto materialID = static_cast<TrianglesCommand*>(command)->getMaterialID();
+            if (materialID != prevMaterialID)
+                ++batches;
+            prevMaterialID = materialID;
+        }
+    }
+    return batches;
+}
+}  // namespace
+
+RendererSortBenchmark::RendererSortBenchmark()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    // 100K commands: 40% at global Z 0, the others spread over 16 global Z values, 8 materials
+    for (int i = 0; i < 100000; ++i)
+    {
+        float globalOrder = 0.f;
+        if (AXRANDOM_0_1() > 0.4f)
+            globalOrder = float(std::rand() % 16 - 8 + (std::rand() % 2));
+        _commands.emplace_back(new SortBenchmarkCommand(globalOrder, 1 + std::rand() % 8));
+    }
+
+    MenuItemFont::setFontName("fonts/arial.ttf");
+    MenuItemFont::setFontSize(30);
+    auto menu = Menu::create(
+        MenuItemFont::create("Run again", AX_CALLBACK_1(RendererSortBenchmark::runBenchmark, this)), nullptr);
+    menu->setPosition(Vec2(s.width / 2, s.height - 100));
+    addChild(menu, 1);
+
+    _resultLabel = Label::createWithTTF(TTFConfig("fonts/arial.ttf", 20), "");
+    _resultLabel->setColor(Color3B::YELLOW);
+    _resultLabel->enableOutline(Color4B::RED, 2);
+    _resultLabel->setPosition(Vec2(s.width / 2, s.height / 2));
+    addChild(_resultLabel, 1);
+
+    runBenchmark(nullptr);
+}
+
+RendererSortBenchmark::~RendererSortBenchmark()
+{
+    for (auto command : _commands)
+        delete command;
+}
+
+void RendererSortBenchmark::runBenchmark(Object* /*sender*/)
+{
+    constexpr int RUNS = 10;
+    using Clock        = std::chrono::steady_clock;
+
+    RenderQueue queue;
+    auto fillQueue = [this, &queue]() {
+        queue.clear();
+        for (auto command : _commands)
+            queue.emplace_back(command);
+    };
+
+    // The previous implementation of RenderQueue::sort
+    Clock::duration stableSortTime{};
+    auto byGlobalZ = [](RenderCommand* a, RenderCommand* b) { return a->getGlobalOrder() < b->getGlobalOrder(); };
+    for (int run = 0; run < RUNS; ++run)
+    {
+        fillQueue();
+        auto start = Clock::now();
+        std::stable_sort(queue.getSubQueue(RenderQueue::GLOBALZ_NEG).begin(),
+                         queue.getSubQueue(RenderQueue::GLOBALZ_NEG).end(), byGlobalZ);
+        std::stable_sort(queue.getSubQueue(RenderQueue::GLOBALZ_POS).begin(),
+                         queue.getSubQueue(RenderQueue::GLOBALZ_POS).end(), byGlobalZ);
+        stableSortTime += Clock::now() - start;
+    }
+    auto stableSortBatches = countBatches(queue);
+
+    auto timeSort = [&](bool byMaterial) {
+        Clock::duration total{};
+        for (int run = 0; run < RUNS; ++run)
+        {
+            fillQueue();
+            auto start = Clock::now();
+            queue.sort(byMaterial);
+            total += Clock::now() - start;
+        }
+        return total;
+    };
+    auto radixSortTime       = timeSort(false);
+    auto radixSortBatches    = countBatches(queue);
+    auto materialSortTime    = timeSort(true);
+    auto materialSortBatches = countBatches(queue);
+
+    auto ms = [](Clock::duration total) {
+        return std::chrono::duration<double, std::milli>(total).count() / RUNS;
+    };
+    auto result = fmt::format(
+        "std::stable_sort: {:.2f} ms, {} batches\nradix sort: {:.2f} ms, {} batches\n"
+        "radix sort by material: {:.2f} ms, {} batches",
+        ms(stableSortTime), stableSortBatches, ms(radixSortTime), radixSortBatches, ms(materialSortTime),
+        materialSortBatches);
+    _resultLabel->setString(result);
+    AXLOGI("RendererSortBenchmark: {}", result);
+}
+
+std::string RendererSortBenchmark::title() const
+{
+    return "RenderQueue Sort Benchmark";
+}
+
+std::string RendererSortBenchmark::subtitle() const
+{
+    return "100K commands, 17 global Z values, 8 materials";
+}
+
+#if defined(AX_ENABLE_NULL_DRIVER)
+RendererNullDriverStats::RendererNullDriverStats()
+{
+    Size s = Director::getInstance()->getWinSize();
+
+    // interleave textures and shaders so that the batcher has to split, like a real scene
+    const char* images[] = {"Images/grossini_dance_01.png", "Images/grossini_dance_02.png"};
+    for (int i = 0; i < 2000; ++i)
+    {
+        auto sprite = Sprite::create(images[(i / 10) % 2]);
+        if ((i / 50) % 2)
+            sprite->setProgramState(backend::ProgramType::GRAY_SCALE);
+        sprite->setScale(0.3f);
+        sprite->setPosition(Vec2(AXRANDOM_0_1() * s.width, AXRANDOM_0_1() * s.height));
+        addChild(sprite);
+    }
+
+    _statsLabel = Label::createWithTTF(TTFConfig("fonts/arial.ttf", 20), "");
+    _statsLabel->setColor(Color3B::YELLOW);
+    _statsLabel->enableOutline(Color4B::RED, 2);
+    _statsLabel->setPosition(Vec2(s.width / 2, s.height - 100));
+    addChild(_statsLabel, 1);
+
+    scheduleUpdate();
+}
+
+void RendererNullDriverStats::update(float dt)
+{
+    if (backend::DriverBase::getDriverType() != backend::DriverType::Null)
+    {
+        _statsLabel->setString("run with AXMOL_NULL_DRIVER=1 to see the null driver counters");
+        return;
+    }
+
+    // counters of the last frame
+    auto driver = static_cast<backend::DriverNull*>(backend::DriverBase::getInstance());
+    auto& stats = driver->getStats();
+    _statsLabel->setString(fmt::format(
+        "draw calls: {}, vertices: {}, uploads: {} ({} bytes)\nstate changes: {}, pipeline switches: {}",
+        stats.drawCalls, stats.drawnVertices, stats.bufferUploads + stats.textureUploads, stats.bytesUploaded,
+        stats.stateChanges, stats.pipelineSwitches));
+    driver->resetStats();
+}
+
+std::string RendererNullDriverStats::title() const
+{
+    return "Null Driver Counters";
+}
+
+std::string RendererNullDriverStats::subtitle() const
+{
+    return "2000 sprites, 2 textures, 2 shaders";
+}
+#endif
+
 NonBatchSprites::NonBatchSprites()
 {
     Size s         = Director::getInstance()->getWinSize();
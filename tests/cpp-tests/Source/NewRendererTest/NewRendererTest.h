@@ -242,6 +242,59 @@ protected:
     ax::backend::ProgramState* createSepiaProgramState();
 };
 
+class RendererBatchIndexFormat : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(RendererBatchIndexFormat);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+protected:
+    RendererBatchIndexFormat();
+
+    void switchIndexFormat(ax::Object* sender);
+
+    ax::Label* _statsLabel = nullptr;
+    ax::backend::IndexFormat _savedIndexFormat;
+};
+
+class RendererSortBenchmark : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(RendererSortBenchmark);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    RendererSortBenchmark();
+    virtual ~RendererSortBenchmark();
+
+    void runBenchmark(ax::Object* sender);
+
+    std::vector<ax::TrianglesCommand*> _commands;
+    ax::Label* _resultLabel = nullptr;
+};
+
+#if defined(AX_ENABLE_NULL_DRIVER)
+class RendererNullDriverStats : public MultiSceneTest
+{
+public:
+    CREATE_FUNC(RendererNullDriverStats);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void update(float dt) override;
+
+protected:
+    RendererNullDriverStats();
+
+    ax::Label* _statsLabel = nullptr;
+};
+#endif
+
 class NonBatchSprites : public MultiSceneTest
 {
 public:
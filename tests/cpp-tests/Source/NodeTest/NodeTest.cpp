@@ -73,6 +73,8 @@ CocosNodeTests::CocosNodeTests()
     ADD_TEST_CASE(Issue16100Test);
     ADD_TEST_CASE(Issue16735Test);
     ADD_TEST_CASE(NodeWorldSpace);
+    ADD_TEST_CASE(NodeParallelVisitTest);
+    ADD_TEST_CASE(NodeSubtreeCullingTest);
 }
 
 TestCocosNodeDemo::TestCocosNodeDemo(void) {}
@@ -1568,3 +1570,207 @@ std::string NodeWorldSpace::subtitle() const
 {
     return "Child sprite (small one) should always stay at the center of screen\nthe child sprite is a child of the moving parent sprite";
 }
+
+//------------------------------------------------------------------
+//
+// NodeParallelVisitTest
+//
+//------------------------------------------------------------------
+static const int s_parallelVisitThreads[] = {1, 2, 4, 8, -1};
+
+void NodeParallelVisitTest::onEnter()
+{
+    TestCocosNodeDemo::onEnter();
+
+    auto s = Director::getInstance()->getWinSize();
+
+    // 64 independent subtrees of 300 sprites, all of them are transformed every frame
+    _container = Node::create();
+    addChild(_container);
+    for (int i = 0; i < 64; ++i)
+    {
+        auto group = Node::create();
+        group->setPosition(Vec2((i % 8 + 0.5f) * s.width / 8, (i / 8 + 0.5f) * s.height / 8));
+        _container->addChild(group);
+        for (int j = 0; j < 300; ++j)
+        {
+            auto sprite = Sprite::create("Images/grossini_dance_01.png");
+            sprite->setScale(0.1f);
+            sprite->setPosition(Vec2(AXRANDOM_MINUS1_1() * 30, AXRANDOM_MINUS1_1() * 30));
+            group->addChild(sprite);
+        }
+    }
+
+    MenuItemFont::setFontSize(24);
+    auto toggle = MenuItemToggle::createWithCallback(
+        AX_CALLBACK_1(NodeParallelVisitTest::switchThreads, this), MenuItemFont::create("Serial visit"),
+        MenuItemFont::create("Parallel visit: 2 threads"), MenuItemFont::create("Parallel visit: 4 threads"),
+        MenuItemFont::create("Parallel visit: 8 threads"), MenuItemFont::create("Parallel visit: all threads"),
+        nullptr);
+    auto menu = Menu::create(toggle, nullptr);
+    menu->setPosition(Vec2(s.width / 2, s.height - 90));
+    addChild(menu, 1);
+
+    _statsLabel = Label::createWithTTF(TTFConfig("fonts/arial.ttf", 20), "visit: ..");
+    _statsLabel->setColor(Color3B::YELLOW);
+    _statsLabel->enableOutline(Color4B::RED, 2);
+    _statsLabel->setPosition(Vec2(s.width / 2, s.height - 120));
+    addChild(_statsLabel, 1);
+
+    // the scene visit happens between these events
+    auto dispatcher     = Director::getInstance()->getEventDispatcher();
+    _beforeDrawListener = dispatcher->addCustomEventListener(
+        Director::EVENT_BEFORE_DRAW, [this](EventCustom*) { _visitStart = std::chrono::steady_clock::now(); });
+    _afterVisitListener = dispatcher->addCustomEventListener(Director::EVENT_AFTER_VISIT, [this](EventCustom*) {
+        _visitTotalMs +=
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _visitStart).count();
+        ++_visitFrames;
+    });
+
+    scheduleUpdate();
+}
+
+void NodeParallelVisitTest::onExit()
+{
+    auto dispatcher = Director::getInstance()->getEventDispatcher();
+    dispatcher->removeEventListener(_beforeDrawListener);
+    dispatcher->removeEventListener(_afterVisitListener);
+
+    TestCocosNodeDemo::onExit();
+}
+
+void NodeParallelVisitTest::switchThreads(Object* sender)
+{
+    auto threads = s_parallelVisitThreads[static_cast<MenuItemToggle*>(sender)->getSelectedIndex()];
+    _container->setParallelVisitEnabled(threads != 1, threads);
+    _visitTotalMs = 0;
+    _visitFrames  = 0;
+}
+
+void NodeParallelVisitTest::update(float dt)
+{
+    _elapsed += dt;
+    for (auto&& group : _container->getChildren())
+        for (auto&& sprite : group->getChildren())
+            sprite->setRotation(_elapsed * 90);
+
+    if (_visitFrames >= 60)
+    {
+        _statsLabel->setString(fmt::format("scene visit: {:.3f} ms, worker threads: {}", _visitTotalMs / _visitFrames,
+                                           Director::getInstance()->getJobSystem()->getThreadCount()));
+        _visitTotalMs = 0;
+        _visitFrames  = 0;
+    }
+}
+
+std::string NodeParallelVisitTest::title() const
+{
+    return "Parallel visit";
+}
+
+std::string NodeParallelVisitTest::subtitle() const
+{
+    return "19200 sprites in 64 subtrees, visit time vs threads";
+}
+
+//------------------------------------------------------------------
+//
+// NodeSubtreeCullingTest
+//
+//------------------------------------------------------------------
+static const int s_cullingMapChunks = 20;
+static const int s_cullingChunkSize = 16;
+
+void NodeSubtreeCullingTest::onEnter()
+{
+    TestCocosNodeDemo::onEnter();
+
+    auto s = Director::getInstance()->getWinSize();
+
+    // a map of 20x20 chunks of 16x16 sprites, about 1/64 of it is on the screen
+    const float tileSize = s.width * 8 / (s_cullingMapChunks * s_cullingChunkSize);
+    _map                 = Node::create();
+    _map->setSubtreeCullingEnabled(true);
+    addChild(_map);
+    for (int i = 0; i < s_cullingMapChunks * s_cullingMapChunks; ++i)
+    {
+        auto chunk = Node::create();
+        chunk->setPosition(Vec2(i % s_cullingMapChunks, i / s_cullingMapChunks) * tileSize * s_cullingChunkSize);
+        _map->addChild(chunk);
+        for (int j = 0; j < s_cullingChunkSize * s_cullingChunkSize; ++j)
+        {
+            auto sprite = Sprite::create("Images/grossini_dance_01.png");
+            sprite->setScale(tileSize / sprite->getContentSize().height);
+            sprite->setPosition(Vec2(j % s_cullingChunkSize + 0.5f, j / s_cullingChunkSize + 0.5f) * tileSize);
+            chunk->addChild(sprite);
+        }
+    }
+
+    MenuItemFont::setFontSize(24);
+    auto toggle = MenuItemToggle::createWithCallback(AX_CALLBACK_1(NodeSubtreeCullingTest::switchCulling, this),
+                                                     MenuItemFont::create("Subtree culling: on"),
+                                                     MenuItemFont::create("Subtree culling: off"), nullptr);
+    auto menu   = Menu::create(toggle, nullptr);
+    menu->setPosition(Vec2(s.width / 2, s.height - 90));
+    addChild(menu, 1);
+
+    _statsLabel = Label::createWithTTF(TTFConfig("fonts/arial.ttf", 20), "visit: ..");
+    _statsLabel->setColor(Color3B::YELLOW);
+    _statsLabel->enableOutline(Color4B::RED, 2);
+    _statsLabel->setPosition(Vec2(s.width / 2, s.height - 120));
+    addChild(_statsLabel, 1);
+
+    // the scene visit happens between these events
+    auto dispatcher     = Director::getInstance()->getEventDispatcher();
+    _beforeDrawListener = dispatcher->addCustomEventListener(
+        Director::EVENT_BEFORE_DRAW, [this](EventCustom*) { _visitStart = std::chrono::steady_clock::now(); });
+    _afterVisitListener = dispatcher->addCustomEventListener(Director::EVENT_AFTER_VISIT, [this](EventCustom*) {
+        _visitTotalMs +=
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _visitStart).count();
+        ++_visitFrames;
+    });
+
+    scheduleUpdate();
+}
+
+void NodeSubtreeCullingTest::onExit()
+{
+    auto dispatcher = Director::getInstance()->getEventDispatcher();
+    dispatcher->removeEventListener(_beforeDrawListener);
+    dispatcher->removeEventListener(_afterVisitListener);
+
+    TestCocosNodeDemo::onExit();
+}
+
+void NodeSubtreeCullingTest::switchCulling(Object* sender)
+{
+    _map->setSubtreeCullingEnabled(!_map->isSubtreeCullingEnabled());
+    _visitTotalMs = 0;
+    _visitFrames  = 0;
+}
+
+void NodeSubtreeCullingTest::update(float dt)
+{
+    // scroll the map around, only the map transform changes so the chunk bounds stay cached
+    _elapsed += dt;
+    auto s = Director::getInstance()->getWinSize();
+    _map->setPosition(
+        Vec2(-s.width * 3.5f * (1 + sinf(_elapsed * 0.2f)), -s.height * 3.5f * (1 + cosf(_elapsed * 0.15f))));
+
+    if (_visitFrames >= 60)
+    {
+        _statsLabel->setString(fmt::format("scene visit: {:.3f} ms", _visitTotalMs / _visitFrames));
+        _visitTotalMs = 0;
+        _visitFrames  = 0;
+    }
+}
+
+std::string NodeSubtreeCullingTest::title() const
+{
+    return "Subtree culling";
+}
+
+std::string NodeSubtreeCullingTest::subtitle() const
+{
+    return "102400 sprites in 400 chunks on a scrolling map";
+}
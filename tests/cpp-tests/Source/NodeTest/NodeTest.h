@@ -369,4 +369,52 @@ public:
     virtual void onExit() override;
 };
 
+class NodeParallelVisitTest : public TestCocosNodeDemo
+{
+public:
+    CREATE_FUNC(NodeParallelVisitTest);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+protected:
+    void switchThreads(ax::Object* sender);
+
+    ax::Node* _container                         = nullptr;
+    ax::Label* _statsLabel                       = nullptr;
+    ax::EventListenerCustom* _beforeDrawListener = nullptr;
+    ax::EventListenerCustom* _afterVisitListener = nullptr;
+    std::chrono::steady_clock::time_point _visitStart;
+    double _visitTotalMs = 0;
+    int _visitFrames     = 0;
+    float _elapsed       = 0;
+};
+
+class NodeSubtreeCullingTest : public TestCocosNodeDemo
+{
+public:
+    CREATE_FUNC(NodeSubtreeCullingTest);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+protected:
+    void switchCulling(ax::Object* sender);
+
+    ax::Node* _map                               = nullptr;
+    ax::Label* _statsLabel                       = nullptr;
+    ax::EventListenerCustom* _beforeDrawListener = nullptr;
+    ax::EventListenerCustom* _afterVisitListener = nullptr;
+    std::chrono::steady_clock::time_point _visitStart;
+    double _visitTotalMs = 0;
+    int _visitFrames     = 0;
+    float _elapsed       = 0;
+};
+
 #endif
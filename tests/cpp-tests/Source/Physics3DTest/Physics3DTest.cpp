@@ -31,6 +31,8 @@
 #include "3d/Bundle3D.h"
 #include "physics3d/Physics3D.h"
 #include "Particle3D/PU/PUParticleSystem3D.h"
+
+#include <chrono>
 USING_NS_AX_EXT;
 using namespace ax;
 
@@ -65,6 +67,7 @@ Physics3DTests::Physics3DTests()
     ADD_TEST_CASE(Physics3DCollisionCallbackDemo);
     ADD_TEST_CASE(Physics3DColliderDemo);
     ADD_TEST_CASE(Physics3DTerrainDemo);
+    ADD_TEST_CASE(Physics3DContactStressDemo);
 #endif
 };
 
@@ -882,4 +885,77 @@ bool Physics3DColliderDemo::init()
     return true;
 }
 
+std::string Physics3DContactStressDemo::subtitle() const
+{
+    return "Physics3D Contact Stress (5000 bodies)";
+}
+
+bool Physics3DContactStressDemo::init()
+{
+    if (!Physics3DTestDemo::init())
+        return false;
+
+    // a world of its own, so that the demo can time its steps, without nodes to sync
+    Physics3DWorldDes worldDes;
+    _stressWorld = Physics3DWorld::create(&worldDes);
+    _stressWorld->retain();
+
+    Physics3DRigidBodyDes rbDes;
+    rbDes.mass  = 0.0f;
+    rbDes.shape = Physics3DShape::createBox(Vec3(120.0f, 1.0f, 120.0f));
+    _stressWorld->addPhysics3DObject(Physics3DRigidBody::create(&rbDes));
+
+    // 5000 boxes in a 20x25x10 grid, dropped onto the floor and onto each other
+    rbDes.mass  = 1.0f;
+    rbDes.shape = Physics3DShape::createBox(Vec3(0.8f, 0.8f, 0.8f));
+    for (int y = 0; y < 10; ++y)
+    {
+        for (int x = 0; x < 20; ++x)
+        {
+            for (int z = 0; z < 25; ++z)
+            {
+                rbDes.originalTransform.setIdentity();
+                rbDes.originalTransform.translate(Vec3(x * 1.2f - 12.0f, 2.0f + y * 1.0f, z * 1.2f - 15.0f));
+                _stressWorld->addPhysics3DObject(Physics3DRigidBody::create(&rbDes));
+            }
+        }
+    }
+
+    _stressWorld->setContactCallback([this](std::span<const Physics3DCollisionInfo> contacts) {
+        for (auto&& ci : contacts)
+            ++_contacts[(int)ci.state];
+    });
+
+    TTFConfig ttfConfig("fonts/arial.ttf", 12);
+    _stepLabel = Label::createWithTTF(ttfConfig, "");
+    _stepLabel->setPosition(VisibleRect::center());
+    this->addChild(_stepLabel);
+
+    scheduleUpdate();
+    return true;
+}
+
+void Physics3DContactStressDemo::update(float /*delta*/)
+{
+    auto start = std::chrono::steady_clock::now();
+    _stressWorld->stepSimulate(1.0f / 60);
+    _stepMilliseconds +=
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (++_steps == 30)
+    {
+        _stepLabel->setString(fmt::format("step {:.2f}ms\ncontacts per step: {} begin, {} persist, {} end",
+                                          _stepMilliseconds / _steps, _contacts[0] / _steps,
+                                          _contacts[1] / _steps, _contacts[2] / _steps));
+        _stepMilliseconds = 0;
+        _steps            = 0;
+        std::fill(std::begin(_contacts), std::end(_contacts), 0);
+    }
+}
+
+Physics3DContactStressDemo::~Physics3DContactStressDemo()
+{
+    AX_SAFE_RELEASE(_stressWorld);
+}
+
 #endif
@@ -159,6 +159,26 @@ public:
 private:
 };
 
+class Physics3DContactStressDemo : public Physics3DTestDemo
+{
+public:
+    CREATE_FUNC(Physics3DContactStressDemo);
+    Physics3DContactStressDemo(){};
+    virtual ~Physics3DContactStressDemo();
+
+    virtual std::string subtitle() const override;
+
+    virtual bool init() override;
+    virtual void update(float delta) override;
+
+private:
+    ax::Physics3DWorld* _stressWorld = nullptr;  // stepped and timed by the demo
+    ax::Label* _stepLabel            = nullptr;
+    double _stepMilliseconds         = 0;
+    int _steps                       = 0;
+    size_t _contacts[3]              = {};  // by ContactState
+};
+
 #endif
 
 #endif
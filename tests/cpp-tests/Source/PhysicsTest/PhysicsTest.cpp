@@ -2003,6 +2003,32 @@ void PhysicsDemoPyramidStackFixedUpdate::onEnter()
     }
 
     this->toggleDebug();
+
+    // at a low fixed rate the sprites stutter unless their transforms are interpolated between the steps
+    MenuItemFont::setFontSize(18);
+    auto item = MenuItemFont::create("Fixed rate: 50", [this](Object* sender) {
+        auto item = static_cast<MenuItemFont*>(sender);
+        if (_physicsWorld->getFixedUpdateRate() == 50)
+        {
+            _physicsWorld->setFixedUpdateRate(15);
+            item->setString("Fixed rate: 15");
+        }
+        else if (!_physicsWorld->isInterpolationEnabled())
+        {
+            _physicsWorld->setInterpolationEnabled(true);
+            item->setString("Fixed rate: 15, interpolated");
+        }
+        else
+        {
+            _physicsWorld->setFixedUpdateRate(50);
+            _physicsWorld->setInterpolationEnabled(false);
+            item->setString("Fixed rate: 50");
+        }
+    });
+
+    auto menu = Menu::create(item, nullptr);
+    this->addChild(menu);
+    menu->setPosition(Vec2(VisibleRect::left().x + 150, VisibleRect::top().y - 60));
 }
 
 std::string PhysicsDemoPyramidStackFixedUpdate::title() const
@@ -28,6 +28,10 @@
 #include "SpriteFrameCacheTest.h"
 
 #include <cassert>
+#include <chrono>
+#include <fstream>
+
+#include "2d/BinarySpriteSheetLoader.h"
 
 #include "NinePatchImageParser.h"
 
@@ -39,6 +43,7 @@ SpriteFrameCacheTests::SpriteFrameCacheTests()
     ADD_TEST_CASE(SpriteFrameCacheLoadMultipleTimes);
     ADD_TEST_CASE(SpriteFrameCacheFullCheck);
     ADD_TEST_CASE(SpriteFrameCacheJsonAtlasTest);
+    ADD_TEST_CASE(SpriteFrameCacheBinaryBenchmark);
 }
 
 SpriteFrameCachePixelFormatTest::SpriteFrameCachePixelFormatTest()
@@ -500,3 +505,120 @@ void SpriteFrameCacheJsonAtlasTest::loadSpriteFrames(std::string_view file,
     SpriteFrameCache::getInstance()->removeSpriteFramesFromFile(file);
     Director::getInstance()->getTextureCache()->removeTexture(texture);
 }
+
+#if AX_TARGET_PLATFORM == AX_PLATFORM_LINUX || AX_TARGET_PLATFORM == AX_PLATFORM_ANDROID
+static int64_t readStatusKB(std::string_view field)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.starts_with(field))
+            return std::strtoll(line.c_str() + field.length(), nullptr, 10);
+    }
+    return -1;
+}
+
+// resets VmHWM to the current resident size, Linux 4.0+
+static bool resetPeakMemory()
+{
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+    return clearRefs.good();
+}
+#endif
+
+SpriteFrameCacheBinaryBenchmark::SpriteFrameCacheBinaryBenchmark()
+{
+    // clang-format off
+    _plists = {
+        "animations/grossini.plist",        "animations/grossini_gray.plist",   "animations/grossini_blue.plist",
+        "animations/grossini_family.plist", "animations/grossini-aliases.plist", "animations/ghosts.plist",
+        "animations/grossini_anchors.plist", "Images/test_polygon.plist",        "Images/blocks9ss.plist",
+    };
+    // clang-format on
+
+    // converted like a build step would, next to each other in the writable path
+    auto fileUtils       = FileUtils::getInstance();
+    const auto directory = fileUtils->getWritablePath() + "binary_sheets/";
+    fileUtils->createDirectories(directory);
+    for (auto&& plist : _plists)
+    {
+        auto binary = directory + FileUtils::getPathBaseNameNoExtension(plist) + ".axsf";
+        if (BinarySpriteSheetLoader::convertFromPlist(plist, binary))
+            _binaries.emplace_back(std::move(binary));
+
+        // keep the textures loaded, so only reading the sheets is timed
+        auto metadata    = optValue(fileUtils->getValueMapFromFile(plist), "metadata"sv);
+        std::string texturePath;
+        if (metadata.getType() == Value::Type::MAP)
+            texturePath = optValue(metadata.asValueMap(), "textureFileName"sv).asString();
+        texturePath      = texturePath.empty() ? plist.substr(0, plist.find_last_of('.')) + ".png"
+                                               : fileUtils->fullPathFromRelativeFile(texturePath, plist);
+        if (auto texture = Director::getInstance()->getTextureCache()->addImage(texturePath))
+        {
+            texture->retain();
+            _textures.emplace_back(texture);
+        }
+    }
+
+    std::string report;
+    if (_binaries.size() != _plists.size() || _textures.size() != _plists.size())
+    {
+        report = "Couldn't convert the plists or load their textures";
+    }
+    else
+    {
+        const auto plist  = loadSheets(_plists, SpriteSheetFormat::PLIST);
+        const auto binary = loadSheets(_binaries, BinarySpriteSheetLoader::FORMAT);
+        auto peak         = [](int64_t kb) { return kb < 0 ? std::string{"n/a"} : fmt::format("{} KB", kb); };
+        report = fmt::format("{} sheets x 20\nplist: {:.2f} ms, peak +{}\nbinary: {:.2f} ms, peak +{}\n{:.1f}x faster",
+                             _plists.size(), plist.milliseconds, peak(plist.peakKB), binary.milliseconds,
+                             peak(binary.peakKB), plist.milliseconds / std::max(binary.milliseconds, 0.001));
+    }
+    AXLOGI("SpriteFrameCacheBinaryBenchmark: {}", report);
+
+    auto label = Label::createWithTTF(report, "fonts/arial.ttf", 16);
+    label->setAlignment(TextHAlignment::CENTER);
+    label->setPosition(VisibleRect::center());
+    addChild(label);
+}
+
+SpriteFrameCacheBinaryBenchmark::~SpriteFrameCacheBinaryBenchmark()
+{
+    for (auto texture : _textures)
+        texture->release();
+    FileUtils::getInstance()->removeDirectory(FileUtils::getInstance()->getWritablePath() + "binary_sheets/");
+}
+
+SpriteFrameCacheBinaryBenchmark::Result SpriteFrameCacheBinaryBenchmark::loadSheets(
+    const std::vector<std::string>& sheets,
+    uint32_t format)
+{
+    auto cache = SpriteFrameCache::getInstance();
+
+    int64_t baseKB = -1;
+#if AX_TARGET_PLATFORM == AX_PLATFORM_LINUX || AX_TARGET_PLATFORM == AX_PLATFORM_ANDROID
+    if (resetPeakMemory())
+        baseKB = readStatusKB("VmRSS:");
+#endif
+
+    std::chrono::steady_clock::duration elapsed{};
+    for (int round = 0; round < 20; ++round)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < sheets.size(); ++i)
+            cache->addSpriteFramesWithFile(sheets[i], _textures[i], format);
+        elapsed += std::chrono::steady_clock::now() - start;
+
+        for (auto&& sheet : sheets)
+            cache->removeSpriteFramesFromFile(sheet);
+    }
+
+    Result result{std::chrono::duration<double, std::milli>(elapsed).count(), -1};
+#if AX_TARGET_PLATFORM == AX_PLATFORM_LINUX || AX_TARGET_PLATFORM == AX_PLATFORM_ANDROID
+    if (baseKB >= 0)
+        result.peakKB = readStatusKB("VmHWM:") - baseKB;
+#endif
+    return result;
+}
@@ -91,3 +91,27 @@ private:
 
     ax::Label* infoLabel;
 };
+
+class SpriteFrameCacheBinaryBenchmark : public TestCase
+{
+public:
+    CREATE_FUNC(SpriteFrameCacheBinaryBenchmark);
+
+    virtual std::string title() const override { return "Binary sprite sheets"; }
+    virtual std::string subtitle() const override { return "Load time and peak memory, plist vs binary"; }
+
+    SpriteFrameCacheBinaryBenchmark();
+    ~SpriteFrameCacheBinaryBenchmark() override;
+
+private:
+    struct Result
+    {
+        double milliseconds;
+        int64_t peakKB;  // -1 where the platform can't tell
+    };
+    Result loadSheets(const std::vector<std::string>& sheets, uint32_t format);
+
+    std::vector<std::string> _plists;
+    std::vector<std::string> _binaries;
+    std::vector<ax::Texture2D*> _textures;
+};
@@ -30,6 +30,7 @@ TextureCacheTests::TextureCacheTests()
 {
     ADD_TEST_CASE(TextureCacheTest);
     ADD_TEST_CASE(TextureCacheUnbindTest);
+    ADD_TEST_CASE(TextureCacheAsyncBenchmark);
 }
 
 TextureCacheTest::TextureCacheTest() : _numberOfSprites(20), _numberOfLoadedSprites(0)
@@ -234,3 +235,95 @@ void TextureCacheUnbindTest::textureLoadedB(Texture2D* texture)
     s->setPosition(3 * size.width / 4, size.height / 2);
     this->addChild(s);
 }
+
+static const char* s_benchmarkImages[] = {
+    "Images/texture2048x2048.png",
+    "Images/background1.png",
+    "Images/background2.png",
+    "Images/background3.png",
+    "Images/HelloWorld.png",
+    "Images/blocks.png",
+    "Images/grossini.png",
+    "Images/grossini_dance_01.png",
+    "Images/grossini_dance_02.png",
+    "Images/grossini_dance_03.png",
+    "Images/grossini_dance_04.png",
+    "Images/grossini_dance_05.png",
+    "Images/grossini_dance_06.png",
+    "Images/grossini_dance_07.png",
+    "Images/grossini_dance_08.png",
+    "Images/grossini_dance_09.png",
+    "Images/grossini_dance_10.png",
+    "Images/grossini_dance_11.png",
+    "Images/grossini_dance_12.png",
+    "Images/grossini_dance_13.png",
+    "Images/grossini_dance_14.png",
+};
+
+static constexpr std::string_view s_benchmarkCallbackKey = "TextureCacheAsyncBenchmark"sv;
+
+TextureCacheAsyncBenchmark::~TextureCacheAsyncBenchmark()
+{
+    auto* cache = Director::getInstance()->getTextureCache();
+    cache->unbindImageAsync(s_benchmarkCallbackKey);
+    cache->setAsyncDecodeConcurrency(_savedConcurrency);
+}
+
+void TextureCacheAsyncBenchmark::onEnter()
+{
+    TestCase::onEnter();
+
+    auto size = Director::getInstance()->getWinSize();
+
+    _labelReport = Label::createWithTTF("", "fonts/arial.ttf", 15);
+    _labelReport->setPosition(Vec2(size.width / 2, size.height / 2));
+    this->addChild(_labelReport);
+
+    _savedConcurrency = Director::getInstance()->getTextureCache()->getAsyncDecodeConcurrency();
+
+    // 1, 2, 4 ... decode tasks, up to all the JobSystem workers
+    const int workers = Director::getInstance()->getJobSystem()->getThreadCount();
+    for (int tasks = 1; tasks < workers; tasks *= 2)
+        _concurrencies.push_back(tasks);
+    _concurrencies.push_back((std::max)(workers, 1));
+
+    runRound();
+}
+
+void TextureCacheAsyncBenchmark::runRound()
+{
+    if (_round >= _concurrencies.size())
+    {
+        _report += "done";
+        _labelReport->setString(_report);
+        return;
+    }
+
+    auto* cache = Director::getInstance()->getTextureCache();
+    for (auto path : s_benchmarkImages)
+        cache->removeTextureForKey(path);
+
+    cache->setAsyncDecodeConcurrency(_concurrencies[_round]);
+    _numberOfPending = static_cast<int>(AX_ARRAYSIZE(s_benchmarkImages));
+    _roundStart      = std::chrono::steady_clock::now();
+    for (auto path : s_benchmarkImages)
+        cache->addImageAsync(path, AX_CALLBACK_1(TextureCacheAsyncBenchmark::textureLoaded, this),
+                             s_benchmarkCallbackKey);
+}
+
+void TextureCacheAsyncBenchmark::textureLoaded(Texture2D* /*texture*/)
+{
+    if (--_numberOfPending > 0)
+        return;
+
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _roundStart).count();
+    auto line    = fmt::format("{} decode tasks: {:.1f} ms", _concurrencies[_round], elapsed);
+    AXLOGI("TextureCacheAsyncBenchmark: {}", line);
+    _report += line;
+    _report += '\n';
+    _labelReport->setString(_report);
+
+    // start the next round on the next frame, once the textures of this one are released
+    ++_round;
+    scheduleOnce([this](float) { runRound(); }, 0.0f, "next_round");
+}
@@ -26,6 +26,7 @@
 #define _TEXTURECACHE_TEST_H_
 
 #include "axmol.h"
+#include <chrono>
 #include "../BaseTest.h"
 
 DEFINE_TEST_SUITE(TextureCacheTests);
@@ -66,4 +67,29 @@ private:
     void textureLoadedB(ax::Texture2D* texture);
 };
 
+class TextureCacheAsyncBenchmark : public TestCase
+{
+public:
+    CREATE_FUNC(TextureCacheAsyncBenchmark);
+
+    ~TextureCacheAsyncBenchmark() override;
+
+    std::string title() const override { return "Async Loading Benchmark"; }
+    std::string subtitle() const override { return "addImageAsync wall time vs decode tasks"; }
+
+    void onEnter() override;
+
+private:
+    void runRound();
+    void textureLoaded(ax::Texture2D* texture);
+
+    ax::Label* _labelReport = nullptr;
+    std::string _report;
+    std::vector<int> _concurrencies;
+    size_t _round = 0;
+    int _numberOfPending = 0;
+    int _savedConcurrency = 0;
+    std::chrono::steady_clock::time_point _roundStart;
+};
+
 #endif  // _TEXTURECACHE_TEST_H_
@@ -68,6 +68,7 @@ FastTileMapTests::FastTileMapTests()
     ADD_TEST_CASE(TMXGIDObjectsTestNew);
     ADD_TEST_CASE(TileAnimTestNew);
     ADD_TEST_CASE(TileAnimTestNew2);
+    ADD_TEST_CASE(TMXStreamedLayerTestNew);
 }
 
 TileDemoNew::TileDemoNew()
@@ -1431,3 +1432,68 @@ void TileAnimTestNew2::onTouchBegan(const std::vector<ax::Touch*>& touches, ax::
     _animStarted = !_animStarted;
     map->setTileAnimEnabled(_animStarted);
 }
+
+//------------------------------------------------------------------
+//
+// TMXStreamedLayerTestNew
+//
+//------------------------------------------------------------------
+TMXStreamedLayerTestNew::TMXStreamedLayerTestNew()
+{
+    auto map = ax::FastTMXTiledMap::create("TileMaps/orthogonal-test2.tmx");
+    addChild(map, 0, kTagTileMap);
+
+    // a 4096x4096 layer repeating the tiles of the original layer, loaded chunk by chunk
+    auto layer   = map->getLayer("Layer 0");
+    _patternSize = layer->getLayerSize();
+    auto tiles   = layer->getTiles();
+    _pattern.assign(tiles, tiles + static_cast<size_t>(_patternSize.width * _patternSize.height));
+
+    layer->setTileChunkLoader(Vec2(4096, 4096), [this, layer](int chunkX, int chunkY, std::span<uint32_t> gids) {
+        const int chunkSize = layer->getChunkSize();
+        const int w         = static_cast<int>(_patternSize.width);
+        const int h         = static_cast<int>(_patternSize.height);
+        for (int y = 0; y < chunkSize; ++y)
+        {
+            for (int x = 0; x < chunkSize; ++x)
+            {
+                int patternX            = (chunkX * chunkSize + x) % w;
+                int patternY            = (chunkY * chunkSize + y) % h;
+                gids[y * chunkSize + x] = _pattern[patternX + patternY * w];
+            }
+        }
+        return true;
+    });
+
+    auto move = MoveBy::create(30, Vec2(-20000, 20000));
+    map->runAction(RepeatForever::create(Sequence::create(move, move->reverse(), nullptr)));
+
+    auto s = Director::getInstance()->getVisibleSize();
+    _label = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    _label->setPosition(Vec2(s.width / 2, 40));
+    addChild(_label, 1);
+
+    schedule(AX_SCHEDULE_SELECTOR(TMXStreamedLayerTestNew::updateMap), 0.1f);
+}
+
+void TMXStreamedLayerTestNew::updateMap(float dt)
+{
+    auto map   = static_cast<ax::FastTMXTiledMap*>(getChildByTag(kTagTileMap));
+    auto layer = map->getLayer("Layer 0");
+
+    // every change rebuilds the chunk of the tile only
+    Vec2 pos(floorf(AXRANDOM_0_1() * 4095), floorf(AXRANDOM_0_1() * 4095));
+    layer->setTileGID(_pattern[static_cast<int>(AXRANDOM_0_1() * (_pattern.size() - 1))], pos);
+
+    _label->setString(fmt::format("resident chunks: {}", layer->getResidentChunkCount()));
+}
+
+std::string TMXStreamedLayerTestNew::title() const
+{
+    return "TMX streamed 4096x4096 layer";
+}
+
+std::string TMXStreamedLayerTestNew::subtitle() const
+{
+    return "Only the chunks on screen are built";
+}
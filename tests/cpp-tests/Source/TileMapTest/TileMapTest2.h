@@ -363,4 +363,20 @@ public:
     void onTouchBegan(const std::vector<ax::Touch*>& touches, ax::Event* event);
 };
 
+class TMXStreamedLayerTestNew : public TileDemoNew
+{
+public:
+    CREATE_FUNC(TMXStreamedLayerTestNew);
+    TMXStreamedLayerTestNew();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    void updateMap(float dt);
+
+private:
+    std::vector<uint32_t> _pattern;
+    ax::Vec2 _patternSize;
+    ax::Label* _label = nullptr;
+};
+
 #endif
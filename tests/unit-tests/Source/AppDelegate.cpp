@@ -106,6 +106,10 @@ int AppDelegate::run(int argc, char** argv) {
     fflush(stdout);
 
     ax::Director::getInstance()->init();
+#if defined(AX_ENABLE_NULL_DRIVER)
+    // a windowless view on the null driver, for the tests creating textures or drawing frames
+    ax::Director::getInstance()->setGLView(GLViewNull::create("Unit Tests"));
+#endif
 
     doctest::Context context;
 
@@ -0,0 +1,246 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <doctest.h>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "2d/ActionManager.h"
+#include "2d/ActionInterval.h"
+#include "2d/ActionEase.h"
+#include "2d/ActionInstant.h"
+#include "2d/Node.h"
+
+USING_NS_AX;
+
+namespace
+{
+// the actions of the ActionsTest basic and ease scenes
+std::vector<Action*> createActions(int variant)
+{
+    switch (variant % 8)
+    {
+    case 0:
+        return {MoveTo::create(1.0f, Vec2(200, 100)), FadeTo::create(0.5f, 64)};
+    case 1:
+        return {MoveBy::create(0.8f, Vec2(-50, 30)), ScaleTo::create(1.2f, 2.0f, 0.5f)};
+    case 2:
+        return {RotateTo::create(0.7f, 90.0f), EaseIn::create(ScaleBy::create(1.0f, 1.5f), 2.5f)};
+    case 3:
+        return {RotateBy::create(1.1f, Vec3(10, 20, 30)), EaseBackOut::create(MoveTo::create(0.9f, Vec2(0, 300)))};
+    case 4:
+        return {EaseElasticOut::create(RotateBy::create(1.0f, 45.0f, -45.0f), 0.4f), FadeOut::create(0.6f)};
+    case 5:
+        return {EaseSineInOut::create(MoveBy::create(1.0f, Vec3(10, 20, 30))), FadeIn::create(0.3f)};
+    case 6:
+        // stepped: eases of eases, sequences and custom actions
+        return {EaseIn::create(EaseBounceOut::create(MoveBy::create(1.0f, Vec2(40, 40))), 2.0f),
+                Sequence::create(ScaleTo::create(0.5f, 3.0f), ScaleTo::create(0.5f, 1.0f), nullptr)};
+    default:
+        return {JumpBy::create(1.0f, Vec2(100, 0), 50, 2), MoveTo::create(0.0f, Vec2(7, 7))};
+    }
+}
+
+struct TweenScene
+{
+    explicit TweenScene(bool batching, int count)
+    {
+        manager = new ActionManager();
+        manager->setBatchingEnabled(batching);
+        nodes = std::make_unique<Node[]>(count);
+        size  = count;
+        for (int i = 0; i < count; ++i)
+        {
+            for (auto action : createActions(i))
+                manager->addAction(action, &nodes[i], false);
+        }
+    }
+    ~TweenScene()
+    {
+        manager->removeAllActions();
+        manager->release();
+    }
+
+    void step(float dt, int frames = 1)
+    {
+        for (int i = 0; i < frames; ++i)
+            manager->update(dt);
+    }
+
+    ActionManager* manager;
+    std::unique_ptr<Node[]> nodes;
+    int size;
+};
+
+void checkSameState(const Node& a, const Node& b)
+{
+    CHECK(a.getPosition3D().x == doctest::Approx(b.getPosition3D().x));
+    CHECK(a.getPosition3D().y == doctest::Approx(b.getPosition3D().y));
+    CHECK(a.getPosition3D().z == doctest::Approx(b.getPosition3D().z));
+    CHECK(a.getScaleX() == doctest::Approx(b.getScaleX()));
+    CHECK(a.getScaleY() == doctest::Approx(b.getScaleY()));
+    CHECK(a.getScaleZ() == doctest::Approx(b.getScaleZ()));
+    CHECK(a.getRotationSkewX() == doctest::Approx(b.getRotationSkewX()));
+    CHECK(a.getRotationSkewY() == doctest::Approx(b.getRotationSkewY()));
+    CHECK(a.getRotation3D().z == doctest::Approx(b.getRotation3D().z));
+    CHECK_EQ(a.getOpacity(), b.getOpacity());
+}
+
+double measureSeconds(int iterations, const std::function<void()>& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        func();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+}  // namespace
+
+TEST_SUITE("2d/ActionManager")
+{
+    TEST_CASE("batched_like_stepped")
+    {
+        TweenScene batched(true, 64);
+        TweenScene stepped(false, 64);
+
+        // uneven frames, some of which end exactly on a duration
+        for (float dt : {0.0f, 0.016f, 0.1f, 0.25f, 0.033f, 0.3f, 0.5f, 0.1f, 0.4f})
+        {
+            batched.step(dt);
+            stepped.step(dt);
+            for (int i = 0; i < batched.size; ++i)
+            {
+                CAPTURE(i);
+                CAPTURE(dt);
+                checkSameState(batched.nodes[i], stepped.nodes[i]);
+                CHECK_EQ(batched.manager->getNumberOfRunningActionsInTarget(&batched.nodes[i]),
+                         stepped.manager->getNumberOfRunningActionsInTarget(&stepped.nodes[i]));
+            }
+        }
+        CHECK_EQ(batched.manager->getNumberOfRunningActions(), 0);
+    }
+
+    TEST_CASE("pause_and_remove")
+    {
+        auto manager = new ActionManager();
+        Node a, b;
+
+        auto moveA = MoveTo::create(1.0f, Vec2(100, 0));
+        manager->addAction(moveA, &a, false);
+        manager->addAction(MoveTo::create(1.0f, Vec2(100, 0)), &b, true);
+
+        manager->update(0);
+        manager->update(0.5f);
+        CHECK_EQ(a.getPositionX(), doctest::Approx(50.0f));
+        CHECK_EQ(moveA->getElapsed(), doctest::Approx(0.5f));
+        CHECK_EQ(b.getPositionX(), 0.0f);
+
+        manager->pauseTarget(&a);
+        manager->resumeTarget(&b);
+        manager->update(0.25f);
+        CHECK_EQ(a.getPositionX(), doctest::Approx(50.0f));
+        CHECK_EQ(b.getPositionX(), 0.0f);  // first tick after the resume
+        manager->update(0.25f);
+        CHECK_EQ(b.getPositionX(), doctest::Approx(25.0f));
+
+        manager->resumeTarget(&a);
+        manager->removeAllActionsFromTarget(&b);
+        manager->update(0.5f);
+        CHECK_EQ(a.getPositionX(), doctest::Approx(100.0f));
+        CHECK_EQ(b.getPositionX(), doctest::Approx(25.0f));
+        CHECK_EQ(manager->getNumberOfRunningActions(), 0);
+
+        // a completed action may start the next one of the same target
+        auto next = CallFunc::create([manager, &a] { manager->addAction(FadeTo::create(0.5f, 0), &a, false); });
+        manager->addAction(Sequence::create(DelayTime::create(0.1f), next, nullptr), &a, false);
+        manager->update(0);
+        manager->update(0.1f);
+        manager->update(0);
+        manager->update(0.5f);
+        CHECK_EQ(a.getOpacity(), 0);
+        CHECK_EQ(manager->getNumberOfRunningActions(), 0);
+
+        manager->release();
+    }
+
+    TEST_CASE("newest_tween_wins")
+    {
+        Node nodes[2][4];
+        for (bool batching : {true, false})
+        {
+            auto manager = new ActionManager();
+            manager->setBatchingEnabled(batching);
+            auto& [a, b, c, d] = nodes[batching];
+
+            // removing an entry added before them must not reorder two tweens of the same node
+            auto removed = ScaleTo::create(1.0f, 3.0f);
+            manager->addAction(removed, &b, false);
+            manager->addAction(ScaleTo::create(1.0f, 2.0f), &a, false);
+            manager->addAction(ScaleTo::create(1.0f, 0.0f), &a, false);
+
+            // a stepped action added after a batchable one wins too
+            manager->addAction(ScaleTo::create(1.0f, 2.0f), &c, false);
+            manager->addAction(EaseIn::create(EaseOut::create(ScaleTo::create(1.0f, 0.0f), 1.0f), 1.0f), &c, false);
+
+            // overlapping moves stack, in the same order
+            manager->addAction(MoveTo::create(1.0f, Vec2(100, 0)), &d, false);
+            manager->addAction(EaseIn::create(MoveTo::create(1.0f, Vec2(-100, 50)), 2.0f), &d, false);
+
+            manager->update(0);
+            manager->removeAction(removed);
+            manager->update(0.5f);
+            CHECK(a.getScaleX() == doctest::Approx(0.5f));
+            CHECK(c.getScaleX() == doctest::Approx(0.5f));
+            manager->update(0.25f);
+            CHECK(a.getScaleX() == doctest::Approx(0.25f));
+            CHECK(c.getScaleX() == doctest::Approx(0.25f));
+
+            manager->removeAllActions();
+            manager->release();
+        }
+        for (int i = 0; i < 4; ++i)
+        {
+            CAPTURE(i);
+            checkSameState(nodes[true][i], nodes[false][i]);
+        }
+    }
+
+    TEST_CASE("benchmark")
+    {
+        // frames of simple tweens, as run by the ActionsTest scenes, once batched and once stepped
+        for (int count : {1000, 10000, 50000})
+        {
+            double seconds[2];
+            for (bool batching : {true, false})
+            {
+                TweenScene scene(batching, count);
+                scene.step(0);
+                seconds[batching] = measureSeconds(30, [&] { scene.step(1.0f / 240); });
+            }
+            MESSAGE(fmt::format("{} nodes: frame {:.3f}ms batched, {:.3f}ms stepped", count, seconds[1] * 1e3,
+                                seconds[0] * 1e3));
+        }
+    }
+}
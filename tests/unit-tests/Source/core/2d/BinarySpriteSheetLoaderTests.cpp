@@ -0,0 +1,353 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <string.h>
+#include "2d/BinarySpriteSheetLoader.h"
+#include "2d/SpriteFrameCache.h"
+#include "platform/FileUtils.h"
+#include "renderer/Texture2D.h"
+#include "fmt/format.h"
+
+USING_NS_AX;
+
+#if defined(AX_ENABLE_NULL_DRIVER)
+namespace
+{
+constexpr auto kFrameA     = "__test_sheet_a.png"sv;
+constexpr auto kFrameB     = "__test_sheet_b.png"sv;
+constexpr auto kFrameC     = "__test_sheet_c.png"sv;
+constexpr auto kAliasB     = "__test_sheet_b_alias.png"sv;
+constexpr auto kContentKey = "by#addSpriteFramesWithFileContent()"sv;
+
+// offsets of the header fields, see BinarySheetHeader
+constexpr std::size_t kVersionOffset       = 4;
+constexpr std::size_t kFrameCountOffset    = 8;
+constexpr std::size_t kTextureNameOffset   = 28;
+constexpr std::size_t kFramesOffsetOffset  = 36;
+constexpr std::size_t kNamesOffsetOffset   = 40;
+constexpr std::size_t kMeshSizeOffset      = 48;
+constexpr std::size_t kStringsOffsetOffset = 52;
+constexpr std::size_t kStringsSizeOffset   = 56;
+
+// sizes and field offsets of the frames and the names, see BinarySheetFrame and BinarySheetName
+constexpr std::size_t kFrameSize       = 60;
+constexpr std::size_t kFrameMeshOffset = 44;
+constexpr std::size_t kNameFrameOffset = 8;
+
+uint32_t readField(const std::vector<uint8_t>& sheet, std::size_t offset)
+{
+    uint32_t value;
+    memcpy(&value, sheet.data() + offset, sizeof(value));
+    return value;
+}
+
+void writeField(std::vector<uint8_t>& sheet, std::size_t offset, uint32_t value)
+{
+    memcpy(sheet.data() + offset, &value, sizeof(value));
+}
+
+ValueMap makeFrame(int format, const Rect& rect, bool rotated)
+{
+    ValueMap frame;
+    if (format == 0)
+    {
+        frame["x"]              = rect.origin.x;
+        frame["y"]              = rect.origin.y;
+        frame["width"]          = rect.size.width;
+        frame["height"]         = rect.size.height;
+        frame["offsetX"]        = 1.0f;
+        frame["offsetY"]        = -1.0f;
+        frame["originalWidth"]  = static_cast<int>(rect.size.width) + 2;
+        frame["originalHeight"] = static_cast<int>(rect.size.height) + 2;
+    }
+    else if (format == 1 || format == 2)
+    {
+        frame["frame"]      = fmt::format("{{{{{},{}}},{{{},{}}}}}", rect.origin.x, rect.origin.y, rect.size.width,
+                                          rect.size.height);
+        frame["offset"]     = "{1,-1}";
+        frame["sourceSize"] = fmt::format("{{{},{}}}", rect.size.width + 2, rect.size.height + 2);
+        if (format == 2)
+            frame["rotated"] = rotated;
+    }
+    else
+    {
+        frame["spriteSize"]       = fmt::format("{{{},{}}}", rect.size.width, rect.size.height);
+        frame["spriteOffset"]     = "{1,-1}";
+        frame["spriteSourceSize"] = fmt::format("{{{},{}}}", rect.size.width + 2, rect.size.height + 2);
+        frame["textureRect"]      = fmt::format("{{{{{},{}}},{{{},{}}}}}", rect.origin.x, rect.origin.y,
+                                                rect.size.width, rect.size.height);
+        frame["textureRotated"]   = rotated;
+    }
+    return frame;
+}
+
+// the dictionary of a plist sprite sheet in the given format, with a polygon frame and an alias in format 3
+ValueMap makePlist(int format)
+{
+    ValueMap frames;
+    frames[std::string{kFrameA}] = makeFrame(format, Rect(0, 0, 16, 16), false);
+    frames[std::string{kFrameB}] = makeFrame(format, Rect(16, 0, 8, 16), true);
+    if (format == 3)
+    {
+        frames[std::string{kFrameB}].asValueMap()["aliases"] = ValueVector{Value{std::string{kAliasB}}};
+
+        auto polygon          = makeFrame(format, Rect(32, 0, 16, 16), false);
+        polygon["vertices"]   = "0 0 16 0 16 16 0 16";
+        polygon["verticesUV"] = "32 0 48 0 48 16 32 16";
+        polygon["triangles"]  = "0 1 2 0 2 3";
+        polygon["anchor"]     = "{0.25,0.75}";
+        frames[std::string{kFrameC}] = std::move(polygon);
+    }
+
+    ValueMap metadata;
+    metadata["format"]          = format;
+    metadata["size"]            = "{64,64}";
+    metadata["textureFileName"] = "__test_sheet.png";
+
+    ValueMap plist;
+    plist["frames"]   = std::move(frames);
+    plist["metadata"] = std::move(metadata);
+    return plist;
+}
+
+std::vector<std::string_view> frameNames(int format)
+{
+    if (format == 3)
+        return {kFrameA, kFrameB, kFrameC};
+    return {kFrameA, kFrameB};
+}
+
+void checkSameFrame(SpriteFrame* frame, SpriteFrame* expected)
+{
+    REQUIRE(frame);
+    CHECK(frame->getRectInPixels().equals(expected->getRectInPixels()));
+    CHECK_EQ(frame->isRotated(), expected->isRotated());
+    CHECK_EQ(frame->getOffsetInPixels(), expected->getOffsetInPixels());
+    CHECK_EQ(frame->getOriginalSizeInPixels(), expected->getOriginalSizeInPixels());
+    REQUIRE_EQ(frame->hasAnchorPoint(), expected->hasAnchorPoint());
+    if (expected->hasAnchorPoint())
+        CHECK_EQ(frame->getAnchorPoint(), expected->getAnchorPoint());
+
+    REQUIRE_EQ(frame->hasPolygonInfo(), expected->hasPolygonInfo());
+    if (expected->hasPolygonInfo())
+    {
+        auto& triangles         = frame->getPolygonInfo().triangles;
+        auto& expectedTriangles = expected->getPolygonInfo().triangles;
+        REQUIRE_EQ(triangles.vertCount, expectedTriangles.vertCount);
+        REQUIRE_EQ(triangles.indexCount, expectedTriangles.indexCount);
+        for (unsigned int i = 0; i < triangles.vertCount; ++i)
+        {
+            CAPTURE(i);
+            CHECK_EQ(triangles.verts[i].vertices, expectedTriangles.verts[i].vertices);
+            CHECK_EQ(triangles.verts[i].texCoords.u, doctest::Approx(expectedTriangles.verts[i].texCoords.u));
+            CHECK_EQ(triangles.verts[i].texCoords.v, doctest::Approx(expectedTriangles.verts[i].texCoords.v));
+        }
+        for (unsigned int i = 0; i < triangles.indexCount; ++i)
+            CHECK_EQ(triangles.indices[i], expectedTriangles.indices[i]);
+    }
+}
+
+// a plist, its conversion and the texture of their frames, removed with the fixture
+struct SheetFixture
+{
+    SheetFixture()
+    {
+        auto directory = FileUtils::getInstance()->getWritablePath();
+        plistPath      = directory + "__test_sheet.plist";
+        binaryPath     = directory + "__test_sheet.axsf";
+
+        std::vector<uint8_t> pixels(64 * 64 * 4);
+        texture = new Texture2D();
+        texture->initWithData(pixels.data(), static_cast<ssize_t>(pixels.size()), backend::PixelFormat::RGBA8, 64, 64);
+    }
+    ~SheetFixture()
+    {
+        auto cache = SpriteFrameCache::getInstance();
+        cache->removeSpriteFramesFromFile(plistPath);
+        cache->removeSpriteFramesFromFile(binaryPath);
+        cache->removeSpriteFramesFromFile(kContentKey);
+        FileUtils::getInstance()->removeFile(plistPath);
+        FileUtils::getInstance()->removeFile(binaryPath);
+        texture->release();
+    }
+
+    // the frames loaded from the plist, then from its conversion are the same
+    void checkRoundTrip(int format)
+    {
+        auto cache = SpriteFrameCache::getInstance();
+        REQUIRE(FileUtils::getInstance()->writeValueMapToFile(makePlist(format), plistPath));
+        REQUIRE(BinarySpriteSheetLoader::convertFromPlist(plistPath, binaryPath));
+
+        cache->addSpriteFramesWithFile(plistPath, texture);
+        Vector<SpriteFrame*> expected;
+        for (auto name : frameNames(format))
+        {
+            auto frame = cache->findFrame(name);
+            REQUIRE(frame);
+            expected.pushBack(frame);
+        }
+        cache->removeSpriteFramesFromFile(plistPath);
+        REQUIRE_FALSE(cache->findFrame(kFrameA));
+
+        cache->addSpriteFramesWithFile(binaryPath, texture, SpriteSheetFormat::BINARY);
+        auto names = frameNames(format);
+        for (std::size_t i = 0; i < names.size(); ++i)
+        {
+            CAPTURE(names[i]);
+            checkSameFrame(cache->findFrame(names[i]), expected.at(i));
+        }
+        if (format == 3)
+            CHECK_EQ(cache->findFrame(kAliasB), cache->findFrame(kFrameB));
+    }
+
+    std::string plistPath;
+    std::string binaryPath;
+    Texture2D* texture = nullptr;
+};
+}  // namespace
+
+TEST_SUITE("2d/BinarySpriteSheetLoader")
+{
+    TEST_CASE("round_trip")
+    {
+        SheetFixture fixture;
+
+        SUBCASE("format_0")
+        {
+            fixture.checkRoundTrip(0);
+        }
+
+        SUBCASE("format_1")
+        {
+            fixture.checkRoundTrip(1);
+        }
+
+        SUBCASE("format_2")
+        {
+            fixture.checkRoundTrip(2);
+        }
+
+        SUBCASE("format_3")
+        {
+            fixture.checkRoundTrip(3);
+        }
+    }
+
+    TEST_CASE("rejects_corrupted")
+    {
+        SheetFixture fixture;
+        auto cache = SpriteFrameCache::getInstance();
+
+        std::vector<uint8_t> sheet;
+        REQUIRE(BinarySpriteSheetLoader::encodePlist(makePlist(3), sheet));
+
+        auto loads = [&](const std::vector<uint8_t>& content) {
+            Data data;
+            data.copy(content.data(), static_cast<ssize_t>(content.size()));
+            cache->addSpriteFramesWithFileContent(data, fixture.texture, SpriteSheetFormat::BINARY);
+            const bool loaded = cache->findFrame(kFrameA) != nullptr;
+            cache->removeSpriteFramesFromFile(kContentKey);
+            return loaded;
+        };
+        REQUIRE(loads(sheet));
+
+        SUBCASE("truncated_header")
+        {
+            sheet.resize(32);
+            CHECK_FALSE(loads(sheet));
+        }
+
+        SUBCASE("truncated_frames")
+        {
+            sheet.resize(readField(sheet, kFramesOffsetOffset) + kFrameSize);
+            CHECK_FALSE(loads(sheet));
+        }
+
+        SUBCASE("truncated_strings")
+        {
+            sheet.resize(sheet.size() - 4);
+            CHECK_FALSE(loads(sheet));
+        }
+
+        SUBCASE("version")
+        {
+            writeField(sheet, kVersionOffset, readField(sheet, kVersionOffset) - 1);
+            CHECK_FALSE(loads(sheet));
+        }
+
+        SUBCASE("frames_offset")
+        {
+            writeField(sheet, kFramesOffsetOffset, static_cast<uint32_t>(sheet.size()));
+            CHECK_FALSE(loads(sheet));
+        }
+
+        SUBCASE("misaligned_names")
+        {
+            writeField(sheet, kNamesOffsetOffset, readField(sheet, kNamesOffsetOffset) + 2);
+            CHECK_FALSE(loads(sheet));
+        }
+
+        SUBCASE("strings_size")
+        {
+            writeField(sheet, kStringsSizeOffset, readField(sheet, kStringsSizeOffset) + 4);
+            CHECK_FALSE(loads(sheet));
+        }
+
+        SUBCASE("texture_name")
+        {
+            writeField(sheet, kTextureNameOffset, readField(sheet, kStringsSizeOffset));
+            CHECK_FALSE(loads(sheet));
+        }
+
+        SUBCASE("name_frame")
+        {
+            writeField(sheet, readField(sheet, kNamesOffsetOffset) + kNameFrameOffset,
+                       readField(sheet, kFrameCountOffset));
+            CHECK_FALSE(loads(sheet));
+        }
+
+        SUBCASE("name_string")
+        {
+            // the string offset is the first field of a name
+            writeField(sheet, readField(sheet, kNamesOffsetOffset), readField(sheet, kStringsSizeOffset));
+            CHECK_FALSE(loads(sheet));
+        }
+
+        SUBCASE("polygon_mesh")
+        {
+            // the frames are in name order, the polygon frame is the last one
+            const auto meshField = readField(sheet, kFramesOffsetOffset) + 2 * kFrameSize + kFrameMeshOffset;
+            writeField(sheet, meshField, readField(sheet, kMeshSizeOffset) / 4);
+            CHECK_FALSE(loads(sheet));
+        }
+
+        SUBCASE("strings_offset")
+        {
+            writeField(sheet, kStringsOffsetOffset, static_cast<uint32_t>(sheet.size()));
+            CHECK_FALSE(loads(sheet));
+        }
+    }
+}
+#endif
@@ -0,0 +1,167 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <tuple>
+#include "2d/FastTMXLayer.h"
+#include "platform/FileUtils.h"
+#include "platform/Image.h"
+#include "renderer/backend/null/BufferNull.h"
+#include "fmt/format.h"
+
+USING_NS_AX;
+
+#if defined(AX_ENABLE_NULL_DRIVER)
+namespace
+{
+constexpr int kLayerSize = 8;
+constexpr int kChunkSize = 4;
+
+class ChunkedLayer : public FastTMXLayer
+{
+public:
+    // the quads of the whole layer in the order they are drawn
+    std::vector<V3F_C4B_T2F_Quad> getDrawnQuads()
+    {
+        updateTiles(Rect(-1e5f, -1e5f, 2e5f, 2e5f));
+        updateIndexBuffer();
+        updateProgramState();
+        updateDrawRanges();
+
+        std::vector<V3F_C4B_T2F_Quad> quads;
+        for (auto&& range : _drawRanges)
+        {
+            auto buffer = static_cast<backend::BufferNull*>(range.chunk->command->getVertexBuffer());
+            auto first  = reinterpret_cast<const V3F_C4B_T2F_Quad*>(buffer->getData()) + range.firstQuad;
+            quads.insert(quads.end(), first, first + range.quadCount);
+        }
+        return quads;
+    }
+
+    std::size_t getDrawCount() const { return _drawRanges.size(); }
+};
+
+// a layer filled with one tile, the tiles of the tileset are tileSize pixels on a grid of 16 pixels
+struct LayerFixture
+{
+    LayerFixture(int tileSize, bool automaticVertexZ)
+    {
+        auto fileUtils = FileUtils::getInstance();
+        auto directory = fileUtils->getWritablePath();
+        if (!directory.empty() && directory.back() == '/')
+            directory.pop_back();
+        imagePath = directory + "/__test_tiles.png";
+
+        std::vector<uint8_t> pixels(64 * 64 * 4, 0xff);
+        auto image = new Image();
+        image->initWithRawData(pixels.data(), static_cast<ssize_t>(pixels.size()), 64, 64, 8);
+        image->saveToFile(imagePath, false);
+        image->release();
+
+        std::string tiles;
+        for (int i = 0; i < kLayerSize * kLayerSize; ++i)
+            tiles += i ? ",1" : "1";
+        std::string properties;
+        if (automaticVertexZ)
+            properties = R"(<properties><property name="cc_vertexz" value="automatic"/></properties>)";
+
+        auto tmx = fmt::format(R"(<?xml version="1.0" encoding="UTF-8"?>
+<map version="1.10" orientation="orthogonal" width="{0}" height="{0}" tilewidth="16" tileheight="16">
+ <tileset firstgid="1" name="tiles" tilewidth="{1}" tileheight="{1}">
+  <image source="__test_tiles.png" width="64" height="64"/>
+ </tileset>
+ <layer id="1" name="ground" width="{0}" height="{0}">
+  {2}
+  <data encoding="csv">{3}</data>
+ </layer>
+</map>)",
+                               kLayerSize, tileSize, properties, tiles);
+
+        mapInfo = TMXMapInfo::createWithXML(tmx, directory);
+        REQUIRE(mapInfo != nullptr);
+        mapInfo->retain();
+        auto layerInfo = mapInfo->getLayers().at(0);
+
+        layer = new ChunkedLayer();
+        REQUIRE(layer->initWithTilesetInfo(mapInfo->getTilesets().at(0), layerInfo, mapInfo));
+        layerInfo->_ownTiles = false;
+        layer->setupTiles();
+        layer->setChunkSize(kChunkSize);
+    }
+    ~LayerFixture()
+    {
+        AX_SAFE_RELEASE(layer);
+        AX_SAFE_RELEASE(mapInfo);
+        FileUtils::getInstance()->removeFile(imagePath);
+    }
+
+    std::string imagePath;
+    TMXMapInfo* mapInfo = nullptr;
+    ChunkedLayer* layer = nullptr;
+};
+
+// the quads are drawn as the whole layer would draw them: by vertexZ, then row by row from the top, left to right
+void checkLayerOrder(const std::vector<V3F_C4B_T2F_Quad>& quads)
+{
+    REQUIRE_EQ(quads.size(), kLayerSize * kLayerSize);
+    auto order = [](const V3F_C4B_T2F_Quad& quad) {
+        return std::make_tuple(quad.bl.vertices.z, -quad.bl.vertices.y, quad.bl.vertices.x);
+    };
+    for (std::size_t i = 1; i < quads.size(); ++i)
+    {
+        CAPTURE(i);
+        CHECK(order(quads[i - 1]) < order(quads[i]));
+    }
+}
+}  // namespace
+
+TEST_SUITE("2d/FastTMXLayer")
+{
+    TEST_CASE("chunk_draw_order")
+    {
+        SUBCASE("grid_tiles")
+        {
+            // tiles don't overlap, each chunk is drawn at once
+            LayerFixture fixture(16, false);
+            auto quads = fixture.layer->getDrawnQuads();
+            CHECK_EQ(quads.size(), kLayerSize * kLayerSize);
+            CHECK_EQ(fixture.layer->getDrawCount(), 4);
+        }
+
+        SUBCASE("overhanging_tiles")
+        {
+            // a tile overlaps the tiles right of it and above it, also across the chunk seams
+            LayerFixture fixture(32, false);
+            checkLayerOrder(fixture.layer->getDrawnQuads());
+            CHECK_EQ(fixture.layer->getDrawCount(), kLayerSize * 2);
+        }
+
+        SUBCASE("automatic_vertex_z")
+        {
+            LayerFixture fixture(16, true);
+            checkLayerOrder(fixture.layer->getDrawnQuads());
+        }
+    }
+}
+#endif
@@ -0,0 +1,334 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#include <doctest.h>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "2d/FontAtlas.h"
+#include "2d/FontFreeType.h"
+#include "2d/Label.h"
+#include "2d/Scene.h"
+#include "base/Director.h"
+#include "base/Scheduler.h"
+
+USING_NS_AX;
+
+namespace
+{
+struct Box
+{
+    int x, y, width, height;
+};
+
+// glyph sized boxes, the tallest first as FontAtlas adds them
+std::vector<Box> createGlyphBoxes(int count)
+{
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> width(6, 40);
+    std::uniform_int_distribution<int> height(8, 44);
+    std::vector<Box> boxes;
+    for (int i = 0; i < count; ++i)
+        boxes.push_back(Box{0, 0, width(rng), height(rng)});
+    std::sort(boxes.begin(), boxes.end(), [](const Box& a, const Box& b) { return a.height > b.height; });
+    return boxes;
+}
+
+// the row shelf FontAtlas used before
+int countShelfPacked(const std::vector<Box>& boxes, int pageWidth, int pageHeight)
+{
+    int x = 0, y = 0, rowHeight = 0, count = 0;
+    for (auto&& box : boxes)
+    {
+        if (x + box.width > pageWidth)
+        {
+            y += rowHeight;
+            x         = 0;
+            rowHeight = 0;
+        }
+        if (y + box.height > pageHeight)
+            break;
+        rowHeight = std::max(rowHeight, box.height);
+        x += box.width;
+        ++count;
+    }
+    return count;
+}
+
+#if defined(AX_ENABLE_NULL_DRIVER)
+// an atlas without content scaling, which shows the page being filled
+class TestFontAtlas : public FontAtlas
+{
+public:
+    TestFontAtlas(Font* font, int pageSize) : FontAtlas(font, pageSize, pageSize, 1.0f) {}
+
+    int getCurrentPage() const { return _currentPage; }
+
+    // the pixels rendered for a glyph on the current page
+    std::vector<uint8_t> getGlyphPixels(char32_t charCode, int width, int height) const
+    {
+        auto& letter = _letterDefinitions.at(charCode);
+        int x        = static_cast<int>(letter.U) + _letterEdgeExtend / 2;
+        int y        = static_cast<int>(letter.V) + _letterEdgeExtend / 2;
+        std::vector<uint8_t> pixels;
+        for (int row = y; row < y + height; ++row)
+            pixels.insert(pixels.end(), _currentPageData + row * _width + x, _currentPageData + row * _width + x + width);
+        return pixels;
+    }
+};
+
+struct GlyphPixels
+{
+    int width  = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+};
+
+FontFreeType* createFont(int size)
+{
+    return FontFreeType::create(AX_UNIT_TESTS_FONT_FILE, size, GlyphCollection::DYNAMIC, ""sv);
+}
+
+// the glyphs rasterized one at a time by a font of their own
+std::unordered_map<char32_t, GlyphPixels> rasterizeGlyphs(const std::u32string& text, int size)
+{
+    auto font = createFont(size);
+    std::unordered_map<char32_t, GlyphPixels> glyphs;
+    for (auto charCode : text)
+    {
+        auto& glyph = glyphs[charCode];
+        Rect rect;
+        int xAdvance;
+        auto bitmap = font->getGlyphBitmap(charCode, glyph.width, glyph.height, rect, xAdvance);
+        if (bitmap)
+            glyph.pixels.assign(bitmap, bitmap + glyph.width * glyph.height);
+    }
+    return glyphs;
+}
+
+void checkGlyphPixels(TestFontAtlas* atlas, const std::u32string& text, int size)
+{
+    REQUIRE_EQ(atlas->getCurrentPage(), 0);
+    for (auto&& [charCode, glyph] : rasterizeGlyphs(text, size))
+    {
+        CAPTURE(static_cast<uint32_t>(charCode));
+        REQUIRE(atlas->getLetterDefinitions().count(charCode));
+        REQUIRE_FALSE(glyph.pixels.empty());
+        CHECK(atlas->getGlyphPixels(charCode, glyph.width, glyph.height) == glyph.pixels);
+    }
+}
+
+void drawFrames(int count)
+{
+    for (int i = 0; i < count; ++i)
+        Director::getInstance()->drawScene();
+}
+#endif
+}  // namespace
+
+TEST_SUITE("2d/FontAtlas")
+{
+    TEST_CASE("skyline_packs_without_overlap")
+    {
+        SkylinePacker packer;
+        packer.reset(256, 256);
+
+        auto boxes = createGlyphBoxes(400);
+        std::vector<Box> packed;
+        for (auto&& box : boxes)
+        {
+            Box placed = box;
+            if (packer.insert(box.width, box.height, placed.x, placed.y))
+                packed.push_back(placed);
+        }
+        REQUIRE(!packed.empty());
+
+        for (size_t i = 0; i < packed.size(); ++i)
+        {
+            auto& a = packed[i];
+            CAPTURE(i);
+            CHECK(a.x >= 0);
+            CHECK(a.y >= 0);
+            CHECK(a.x + a.width <= 256);
+            CHECK(a.y + a.height <= 256);
+            CHECK(a.y + a.height <= packer.getUsedHeight());
+            for (size_t j = i + 1; j < packed.size(); ++j)
+            {
+                auto& b = packed[j];
+                bool overlap = a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+                CHECK_FALSE(overlap);
+            }
+        }
+    }
+
+    TEST_CASE("skyline_fills_more_than_shelf")
+    {
+        auto boxes = createGlyphBoxes(2000);
+
+        SkylinePacker packer;
+        packer.reset(512, 512);
+        int skylineCount = 0;
+        int x, y;
+        for (auto&& box : boxes)
+        {
+            // without the sorting of a single batch, as glyphs arrive over time
+            if (packer.insert(box.width, box.height, x, y))
+                ++skylineCount;
+        }
+        int shelfCount = countShelfPacked(boxes, 512, 512);
+        MESSAGE(fmt::format("512x512 page: {} glyphs skyline, {} glyphs shelf", skylineCount, shelfCount));
+        CHECK(skylineCount >= shelfCount);
+    }
+
+    TEST_CASE("skyline_resumes_shelf")
+    {
+        // a page stored by the shelf packer, the current row starts at y 20 and is filled up to x 100
+        SkylinePacker packer;
+        packer.reset(512, 64, 100, 40, 20);
+        CHECK_EQ(packer.getUsedHeight(), 40);
+
+        int x, y;
+        REQUIRE(packer.insert(50, 10, x, y));
+        CHECK_EQ(x, 100);
+        CHECK_EQ(y, 20);
+
+        CHECK_FALSE(packer.insert(600, 10, x, y));
+        CHECK_FALSE(packer.insert(10, 65, x, y));
+        REQUIRE(packer.insert(512, 24, x, y));
+        CHECK_EQ(y, 40);
+        CHECK_FALSE(packer.insert(1, 1, x, y));
+    }
+
+#if defined(AX_ENABLE_NULL_DRIVER)
+    TEST_CASE("batched_rasterization")
+    {
+        // glyphs of all heights, so they are packed in another order than rasterized
+        const std::u32string text = U"AaBbQqWwgjy@%&0123.,";
+        auto font                 = createFont(32);
+        REQUIRE(font);
+        auto atlas = new TestFontAtlas(font, 512);
+
+        CHECK(atlas->prepareLetterDefinitions(text));
+        checkGlyphPixels(atlas, text, 32);
+
+        atlas->release();
+    }
+
+    TEST_CASE("async_rasterization")
+    {
+        const std::u32string text = U"HelloWorld!?";
+        auto font                 = createFont(28);
+        REQUIRE(font);
+        auto atlas = new TestFontAtlas(font, 512);
+
+        atlas->prepareLetterDefinitionsAsync(text);
+        auto scheduler = Director::getInstance()->getScheduler();
+        auto deadline  = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        auto ready     = [&] {
+            for (auto charCode : text)
+                if (!atlas->getLetterDefinitions().count(charCode))
+                    return false;
+            return true;
+        };
+        while (!ready() && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::yield();
+            scheduler->update(0);
+        }
+        REQUIRE(ready());
+        checkGlyphPixels(atlas, text, 28);
+
+        atlas->release();
+    }
+
+    TEST_CASE("page_eviction")
+    {
+        auto font = createFont(24);
+        REQUIRE(font);
+        auto atlas = new TestFontAtlas(font, 64);
+        atlas->setMaxPageCount(2);
+
+        // more than a page, which can't be evicted while the frame needing it lasts
+        const std::u32string first = U"ABCDEFGHIJKLMNOP";
+        atlas->prepareLetterDefinitions(first);
+        CHECK_EQ(atlas->getEvictionCount(), 0);
+        REQUIRE(atlas->getTextures().size() >= 2);
+
+        // the pages of the first glyphs are not used anymore
+        drawFrames(2);
+        const std::u32string second = U"QRSTUVWXYZ";
+        atlas->prepareLetterDefinitions(second);
+        CHECK(atlas->getEvictionCount() > 0);
+
+        size_t firstLeft = 0;
+        for (auto charCode : first)
+            firstLeft += atlas->getLetterDefinitions().count(charCode);
+        CHECK(firstLeft < first.size());
+        for (auto charCode : second)
+        {
+            CAPTURE(static_cast<uint32_t>(charCode));
+            REQUIRE(atlas->getLetterDefinitions().count(charCode));
+            CHECK(atlas->getTextures().count(atlas->getLetterDefinitions().at(charCode).textureID));
+        }
+
+        atlas->release();
+    }
+
+    TEST_CASE("drawn_page_kept")
+    {
+        auto director = Director::getInstance();
+        auto label    = Label::createWithTTF(TTFConfig(AX_UNIT_TESTS_FONT_FILE, 160), "AB");
+        REQUIRE(label);
+        label->setPosition(director->getVisibleSize() / 2);
+        auto scene = Scene::create();
+        scene->addChild(label);
+        if (director->getRunningScene())
+            director->replaceScene(scene);
+        else
+            director->runWithScene(scene);
+        drawFrames(2);
+
+        // the label is laid out once, then only drawn while new glyphs fill and evict the other pages
+        auto atlas = label->getFontAtlas();
+        atlas->setMaxPageCount(2);
+        const std::u32string glyphs = U"CDEFGHIJKLMNOPQRSTUVWXYZcdefghijklmnopqrstuvwxyz0123456789@#%&";
+        for (size_t i = 0; i < glyphs.size(); i += 6)
+        {
+            atlas->prepareLetterDefinitions(glyphs.substr(i, 6));
+            CHECK(atlas->getLetterDefinitions().count(U'A'));
+            CHECK(atlas->getLetterDefinitions().count(U'B'));
+            drawFrames(1);
+        }
+        CHECK(atlas->getEvictionCount() > 0);
+
+        atlas->setMaxPageCount(0);
+        director->replaceScene(Scene::create());
+        drawFrames(1);
+    }
+#endif
+}
@@ -0,0 +1,147 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "2d/Label.h"
+#include "2d/SpriteBatchNode.h"
+#include "renderer/TextureAtlas.h"
+
+USING_NS_AX;
+
+#if defined(AX_ENABLE_NULL_DRIVER)
+namespace
+{
+class LayoutLabel : public Label
+{
+public:
+    LayoutLabel(std::string_view text, int maxLineWidth, TextHAlignment alignment)
+    {
+        initWithTTF(TTFConfig(AX_UNIT_TESTS_FONT_FILE, 24), text, alignment, maxLineWidth);
+        layout();
+    }
+
+    void layout() { getContentSize(); }
+
+    int getReusedLetters() const { return _layoutCache.reusedLetters; }
+
+    // the letters and their quads are the ones of a label laid out from scratch
+    void checkLayoutEquals(const LayoutLabel& expected)
+    {
+        REQUIRE_EQ(_lengthOfString, expected._lengthOfString);
+        CHECK_EQ(_numberOfLines, expected._numberOfLines);
+        CHECK(_contentSize.width == doctest::Approx(expected._contentSize.width));
+        CHECK(_contentSize.height == doctest::Approx(expected._contentSize.height));
+
+        for (int i = 0; i < _lengthOfString; ++i)
+        {
+            CAPTURE(i);
+            auto& letter         = _lettersInfo[i];
+            auto& expectedLetter = expected._lettersInfo[i];
+            REQUIRE_EQ(letter.valid, expectedLetter.valid);
+            if (!letter.valid)
+                continue;
+            CHECK_EQ(letter.utf32Char, expectedLetter.utf32Char);
+            CHECK_EQ(letter.lineIndex, expectedLetter.lineIndex);
+            CHECK(letter.positionX == doctest::Approx(expectedLetter.positionX));
+            CHECK(letter.positionY == doctest::Approx(expectedLetter.positionY));
+
+            REQUIRE_EQ(letter.atlasIndex < 0, expectedLetter.atlasIndex < 0);
+            if (letter.atlasIndex < 0)
+                continue;
+            auto page          = _fontAtlas->getLetterDefinitions().at(letter.utf32Char).textureID;
+            auto& quad         = _batchNodes.at(page)->getTextureAtlas()->getQuads()[letter.atlasIndex];
+            auto& expectedQuad = expected._batchNodes.at(page)->getTextureAtlas()->getQuads()[expectedLetter.atlasIndex];
+            for (auto [vertex, expectedVertex] : {std::pair{&quad.bl, &expectedQuad.bl}, {&quad.tr, &expectedQuad.tr}})
+            {
+                CHECK(vertex->vertices.x == doctest::Approx(expectedVertex->vertices.x));
+                CHECK(vertex->vertices.y == doctest::Approx(expectedVertex->vertices.y));
+                CHECK(vertex->texCoords.u == doctest::Approx(expectedVertex->texCoords.u));
+                CHECK(vertex->texCoords.v == doctest::Approx(expectedVertex->texCoords.v));
+            }
+        }
+        for (ssize_t page = 0; page < _batchNodes.size() && page < expected._batchNodes.size(); ++page)
+        {
+            CHECK_EQ(_batchNodes.at(page)->getTextureAtlas()->getTotalQuads(),
+                     expected._batchNodes.at(page)->getTextureAtlas()->getTotalQuads());
+        }
+    }
+};
+
+// lays out before, then after incrementally, and compares it with after laid out from scratch
+int checkRelayout(std::string_view before,
+                  std::string_view after,
+                  int maxLineWidth          = 0,
+                  TextHAlignment alignment = TextHAlignment::LEFT)
+{
+    auto label = new LayoutLabel(before, maxLineWidth, alignment);
+    REQUIRE(label->getStringLength() > 0);
+    label->setString(after);
+    label->layout();
+    int reused = label->getReusedLetters();
+
+    auto expected = new LayoutLabel(after, maxLineWidth, alignment);
+    label->checkLayoutEquals(*expected);
+
+    expected->release();
+    label->release();
+    return reused;
+}
+}  // namespace
+
+TEST_SUITE("2d/Label")
+{
+    TEST_CASE("incremental_layout")
+    {
+        SUBCASE("append")
+        {
+            CHECK(checkRelayout("Score: 99", "Score: 99 and counting") > 0);
+            checkRelayout("Score: 99", "Score: 99 and counting", 0, TextHAlignment::CENTER);
+        }
+
+        SUBCASE("replace_tail")
+        {
+            checkRelayout("Time 00:59", "Time 01:00");
+            checkRelayout("Hello world", "Hello");
+        }
+
+        SUBCASE("insert_middle")
+        {
+            checkRelayout("Hello world", "Hello brave new world");
+            checkRelayout("Hello world", "Hello brave new world", 0, TextHAlignment::RIGHT);
+            checkRelayout("first line\nsecond line", "first line\ninserted\nsecond line");
+        }
+
+        SUBCASE("wrap")
+        {
+            checkRelayout("The quick brown fox", "The quick brown fox jumps over the lazy dog", 150);
+            checkRelayout("The quick brown fox", "The quick brown fox jumps over the lazy dog", 150,
+                          TextHAlignment::CENTER);
+            // the changed word doesn't fit its line anymore, or fits the previous one now
+            checkRelayout("aaa bbb ccc ddd eee", "aaa bbb cccccccccc ddd eee", 150);
+            checkRelayout("aaa bbbbbbbbbbbb ccc ddd", "aaa bb ccc ddd", 150);
+            checkRelayout("aaa bbb ccc ddd eee fff", "aaa bbb ddd eee fff", 100);
+        }
+    }
+}
+#endif
@@ -25,6 +25,8 @@
 #include <doctest.h>
 #include <float.h>
 #include "2d/Node.h"
+#include "base/Director.h"
+#include "renderer/Renderer.h"
 
 using namespace ax;
 
@@ -59,4 +61,152 @@ TEST_SUITE("2d/Node") {
         CHECK_EQ(200.0f, node.getPosition().x);
         CHECK_EQ(100.0f, node.getPosition().y);
     }
+
+    TEST_CASE("subtree_bounds") {
+        auto root  = new Node();
+        auto chunk = new Node();
+        auto a     = new Node();
+        auto b     = new Node();
+        root->addChild(chunk);
+        chunk->addChild(a);
+        chunk->addChild(b);
+        chunk->setPosition(100.0f, 100.0f);
+        a->setContentSize(Vec2(10.0f, 10.0f));
+        b->setContentSize(Vec2(20.0f, 20.0f));
+        b->setPosition(50.0f, 0.0f);
+
+        auto bounds = chunk->getSubtreeBoundingBox();
+        CHECK(bounds.equals(Rect(100.0f, 100.0f, 70.0f, 20.0f)));
+
+        SUBCASE("child_moved") {
+            b->setPosition(50.0f, 40.0f);
+            CHECK(chunk->getSubtreeBoundingBox().equals(Rect(100.0f, 100.0f, 70.0f, 60.0f)));
+        }
+
+        SUBCASE("child_scaled") {
+            a->setScale(-2.0f);
+            CHECK(chunk->getSubtreeBoundingBox().equals(Rect(80.0f, 80.0f, 90.0f, 40.0f)));
+        }
+
+        SUBCASE("child_hidden") {
+            b->setVisible(false);
+            CHECK(chunk->getSubtreeBoundingBox().equals(Rect(100.0f, 100.0f, 10.0f, 10.0f)));
+            b->setPosition(200.0f, 0.0f);
+            b->setVisible(true);
+            CHECK(chunk->getSubtreeBoundingBox().equals(Rect(100.0f, 100.0f, 220.0f, 20.0f)));
+        }
+
+        SUBCASE("child_added_removed") {
+            auto c = new Node();
+            c->setContentSize(Vec2(5.0f, 5.0f));
+            c->setPosition(-10.0f, -10.0f);
+            chunk->addChild(c);
+            c->release();
+            CHECK(chunk->getSubtreeBoundingBox().equals(Rect(90.0f, 90.0f, 80.0f, 30.0f)));
+            c->removeFromParentAndCleanup(false);
+            CHECK(chunk->getSubtreeBoundingBox().equals(bounds));
+        }
+
+        SUBCASE("grandchild_normalized_position") {
+            a->setContentSize(Vec2(10.0f, 10.0f));
+            auto c = new Node();
+            c->setContentSize(Vec2(1.0f, 1.0f));
+            a->addChild(c);
+            c->release();
+            c->setPositionNormalized(Vec2(1.0f, 1.0f));
+            CHECK(chunk->getSubtreeBoundingBox().equals(Rect(100.0f, 100.0f, 70.0f, 20.0f)));
+            a->setContentSize(Vec2(30.0f, 30.0f));
+            CHECK(chunk->getSubtreeBoundingBox().equals(Rect(100.0f, 100.0f, 70.0f, 31.0f)));
+        }
+
+        SUBCASE("unbounded_leaf") {
+            auto c = new Node();
+            chunk->addChild(c);
+            c->release();
+            CHECK(chunk->getSubtreeBoundingBox().equals(Rect::ZERO));
+            c->setContentSize(Vec2(1.0f, 1.0f));
+            CHECK(chunk->getSubtreeBoundingBox().equals(bounds));
+        }
+
+        a->release();
+        b->release();
+        chunk->release();
+        root->release();
+    }
+
+    TEST_CASE("parallel_visit_culled_subtree") {
+        struct DrawProbe : public Node
+        {
+            void draw(Renderer*, const Mat4&, uint32_t flags) override
+            {
+                ++draws;
+                drawFlags = flags;
+            }
+            int draws          = 0;
+            uint32_t drawFlags = 0;
+        };
+
+        auto director = Director::getInstance();
+        auto root     = new Node();
+        auto probe    = new DrawProbe();
+        auto other    = new Node();
+        root->setParallelVisitEnabled(true);
+        root->setSubtreeCullingEnabled(true);
+        root->addChild(probe);
+        root->addChild(other);
+        probe->setContentSize(Vec2(10.0f, 10.0f));
+        probe->setPosition(10.0f, 10.0f);
+        other->setContentSize(Vec2(10.0f, 10.0f));
+
+        auto visitWithView = [&](float left, uint32_t flags) {
+            Mat4 projection;
+            Mat4::createOrthographicOffCenter(left, left + 100.0f, 0.0f, 100.0f, -1024.0f, 1024.0f, &projection);
+            director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+            director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION, projection);
+            root->visit(nullptr, Mat4::IDENTITY, flags);
+            director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+        };
+
+        visitWithView(0.0f, Node::FLAGS_TRANSFORM_DIRTY);
+        CHECK_EQ(probe->draws, 1);
+
+        // the move is precomputed, but the subtree is culled before the transform is used
+        probe->setPosition(500.0f, 10.0f);
+        visitWithView(0.0f, 0);
+        CHECK_EQ(probe->draws, 1);
+
+        // scrolling the view dirties no transform, the move must still reach draw()
+        visitWithView(450.0f, 0);
+        CHECK_EQ(probe->draws, 2);
+        CHECK((probe->drawFlags & Node::FLAGS_TRANSFORM_DIRTY) != 0);
+        CHECK_EQ(probe->getNodeToWorldTransform().m[12], 500.0f);
+
+        visitWithView(450.0f, 0);
+        CHECK_EQ(probe->draws, 3);
+        CHECK((probe->drawFlags & Node::FLAGS_TRANSFORM_DIRTY) == 0);
+
+        probe->release();
+        other->release();
+        root->release();
+    }
+
+    TEST_CASE("culling_planes") {
+        Mat4 projection;
+        Mat4::createOrthographicOffCenter(0.0f, 100.0f, 0.0f, 100.0f, -1024.0f, 1024.0f, &projection);
+
+        CullingPlanes culling;
+        culling.init(projection);
+        CHECK(culling.intersects(Vec3(10.0f, 10.0f, 0.0f), Vec3(20.0f, 20.0f, 0.0f)));
+        CHECK(culling.intersects(Vec3(-10.0f, -10.0f, 0.0f), Vec3(1.0f, 1.0f, 0.0f)));
+        CHECK(culling.intersects(Vec3(-10.0f, -10.0f, 0.0f), Vec3(200.0f, 200.0f, 0.0f)));
+        CHECK_FALSE(culling.intersects(Vec3(101.0f, 10.0f, 0.0f), Vec3(120.0f, 20.0f, 0.0f)));
+        CHECK_FALSE(culling.intersects(Vec3(10.0f, -30.0f, 0.0f), Vec3(20.0f, -1.0f, 0.0f)));
+
+        // a node at (200, 0) is visible once the view scrolls to it
+        Mat4 view;
+        Mat4::createTranslation(-180.0f, 0.0f, 0.0f, &view);
+        culling.init(projection * view);
+        CHECK(culling.intersects(Vec3(200.0f, 10.0f, 0.0f), Vec3(210.0f, 20.0f, 0.0f)));
+        CHECK_FALSE(culling.intersects(Vec3(10.0f, 10.0f, 0.0f), Vec3(20.0f, 20.0f, 0.0f)));
+    }
 }
@@ -0,0 +1,112 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "2d/TMXXMLParser.h"
+
+using namespace ax;
+
+static const char* TMX_HEADER = R"(<?xml version="1.0" encoding="UTF-8"?>
+<map version="1.10" orientation="orthogonal" width="4" height="4" tilewidth="32" tileheight="32" infinite="1">
+ <tileset firstgid="1" name="tiles" tilewidth="32" tileheight="32">
+  <image source="tiles.png" width="128" height="128"/>
+ </tileset>
+)";
+
+TEST_SUITE("2d/TMXXMLParser") {
+    TEST_CASE("infinite_csv_chunks") {
+        std::string tmx = TMX_HEADER;
+        tmx += R"( <layer id="1" name="ground" width="4" height="4">
+  <data encoding="csv">
+   <chunk x="-2" y="0" width="2" height="2">
+1,2,
+3,4
+</chunk>
+   <chunk x="2" y="2" width="2" height="2">
+5,0,
+7,8
+</chunk>
+  </data>
+ </layer>
+</map>)";
+
+        auto mapInfo = TMXMapInfo::createWithXML(tmx, "");
+        REQUIRE(mapInfo != nullptr);
+        CHECK(mapInfo->isInfinite());
+        REQUIRE_EQ(mapInfo->getLayers().size(), 1);
+
+        // the chunks are merged into one layer covering x -2..4 and y 0..4
+        auto layer = mapInfo->getLayers().at(0);
+        CHECK_EQ(layer->_layerSize, Vec2(6, 4));
+        CHECK_EQ(layer->_offset, Vec2(-2, 0));
+        REQUIRE(layer->_tiles != nullptr);
+
+        const uint32_t expected[] = {
+            1, 2, 0, 0, 0, 0,
+            3, 4, 0, 0, 0, 0,
+            0, 0, 0, 0, 5, 0,
+            0, 0, 0, 0, 7, 8,
+        };
+        for (int i = 0; i < 24; ++i)
+            CHECK_EQ(layer->_tiles[i], expected[i]);
+    }
+
+    TEST_CASE("infinite_base64_and_xml_chunks") {
+        std::string tmx = TMX_HEADER;
+        tmx += R"( <layer id="1" name="base64" width="4" height="4">
+  <data encoding="base64">
+   <chunk x="0" y="-2" width="2" height="2">BQAAAAAAAAAHAAAACAAAAA==</chunk>
+  </data>
+ </layer>
+ <layer id="2" name="xml" width="4" height="4">
+  <data>
+   <chunk x="0" y="0" width="2" height="1">
+    <tile gid="3"/>
+    <tile gid="4"/>
+   </chunk>
+  </data>
+ </layer>
+</map>)";
+
+        auto mapInfo = TMXMapInfo::createWithXML(tmx, "");
+        REQUIRE(mapInfo != nullptr);
+        REQUIRE_EQ(mapInfo->getLayers().size(), 2);
+
+        // a 2x2 layer placed two rows above the map, its bottom edge is 4 rows above the bottom of the map
+        auto layer = mapInfo->getLayers().at(0);
+        CHECK_EQ(layer->_layerSize, Vec2(2, 2));
+        CHECK_EQ(layer->_offset, Vec2(0, -4));
+        REQUIRE(layer->_tiles != nullptr);
+        CHECK_EQ(layer->_tiles[0], 5);
+        CHECK_EQ(layer->_tiles[1], 0);
+        CHECK_EQ(layer->_tiles[2], 7);
+        CHECK_EQ(layer->_tiles[3], 8);
+
+        layer = mapInfo->getLayers().at(1);
+        CHECK_EQ(layer->_layerSize, Vec2(2, 1));
+        REQUIRE(layer->_tiles != nullptr);
+        CHECK_EQ(layer->_tiles[0], 3);
+        CHECK_EQ(layer->_tiles[1], 4);
+    }
+}
@@ -0,0 +1,103 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "AudioTestUtils.h"
+
+using namespace ax;
+using namespace audio_test;
+
+TEST_SUITE("audio/AudioStreamer")
+{
+    TEST_CASE("streaming_buffers")
+    {
+        AudioEngine::setStreamingBuffers(100, 5.0f);
+        CHECK_EQ(AudioEngine::getStreamingBufferCount(), 16);
+        CHECK_EQ(AudioEngine::getStreamingBufferTime(), doctest::Approx(1.0f));
+
+        AudioEngine::setStreamingBuffers(0, 0.0f);
+        CHECK_EQ(AudioEngine::getStreamingBufferCount(), 2);
+        CHECK_EQ(AudioEngine::getStreamingBufferTime(), doctest::Approx(0.01f));
+
+        AudioEngine::setStreamingBuffers(QUEUEBUFFER_NUM, QUEUEBUFFER_TIME_STEP);
+    }
+
+    TEST_CASE("one_thread_streams")
+    {
+        if (!initNullDevice())
+        {
+            MESSAGE("No OpenAL device, skipping");
+            return;
+        }
+
+        AudioEngine::setStreamingBuffers(4, 0.02f);
+        auto path = writeWav("__test_streamed.wav", 8, 2);
+
+        constexpr int streamCount = 16;
+        std::vector<AUDIO_ID> ids;
+        for (int i = 0; i < streamCount; ++i)
+        {
+            auto id = AudioEngine::play2d(path, true, 0.1f);
+            REQUIRE_NE(id, AudioEngine::INVALID_AUDIO_ID);
+            ids.push_back(id);
+        }
+
+        REQUIRE(pumpUntil([] { return AudioEngine::getStreamingStats().activeStreams == streamCount; }, 10.0));
+
+        // every stream keeps being refilled from the shared thread
+        auto before = AudioEngine::getStreamingStats();
+        pumpUntil([] { return false; }, 0.5);
+        auto after = AudioEngine::getStreamingStats();
+        CHECK_EQ(after.activeStreams, streamCount);
+        CHECK_GE(after.buffersQueued - before.buffersQueued, uint64_t(streamCount * 4));
+        for (auto id : ids)
+            CHECK_GT(AudioEngine::getCurrentTime(id), 0.0f);
+        MESSAGE("buffers queued: " << after.buffersQueued << ", underruns: " << after.underruns);
+
+        SUBCASE("stop")
+        {
+            AudioEngine::stop(ids.front());
+            CHECK_EQ(AudioEngine::getStreamingStats().activeStreams, streamCount - 1);
+        }
+
+        SUBCASE("play_to_end")
+        {
+            // the queued data plays out before the instance finishes
+            bool finished = false;
+            auto id       = ids.back();
+            AudioEngine::setLoop(id, false);
+            AudioEngine::setFinishCallback(id, [&finished](AUDIO_ID, std::string_view) { finished = true; });
+            REQUIRE(AudioEngine::setCurrentTime(id, AudioEngine::getDuration(id) - 0.2f));
+            CHECK(pumpUntil([&finished] { return finished; }, 5.0));
+            CHECK_EQ(AudioEngine::getStreamingStats().activeStreams, streamCount - 1);
+        }
+
+        AudioEngine::stopAll();
+        CHECK_EQ(AudioEngine::getStreamingStats().activeStreams, 0);
+
+        AudioEngine::end();
+        AudioEngine::setStreamingBuffers(QUEUEBUFFER_NUM, QUEUEBUFFER_TIME_STEP);
+        FileUtils::getInstance()->removeFile(path);
+    }
+}
@@ -0,0 +1,102 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "audio/AudioEngine.h"
+#include "base/Director.h"
+#include "base/Scheduler.h"
+#include "platform/FileUtils.h"
+
+namespace audio_test
+{
+// writes a 16-bit PCM sine wave at 44100Hz, with 2 channels a few seconds exceed the size AudioCache keeps in one
+// buffer so it's streamed
+inline std::string writeWav(std::string_view name, int seconds, uint16_t channels)
+{
+    const uint32_t sampleRate = 44100;
+    const uint32_t frames     = sampleRate * seconds;
+    const uint32_t dataSize   = frames * channels * sizeof(int16_t);
+
+    std::vector<uint8_t> wav(44 + dataSize);
+    auto put = [&wav](size_t offset, auto value) { memcpy(wav.data() + offset, &value, sizeof(value)); };
+    memcpy(wav.data(), "RIFF", 4);
+    put(4, uint32_t(36 + dataSize));
+    memcpy(wav.data() + 8, "WAVEfmt ", 8);
+    put(16, uint32_t(16));
+    put(20, uint16_t(1));  // PCM
+    put(22, channels);
+    put(24, sampleRate);
+    put(28, uint32_t(sampleRate * channels * sizeof(int16_t)));
+    put(32, uint16_t(channels * sizeof(int16_t)));
+    put(34, uint16_t(16));
+    memcpy(wav.data() + 36, "data", 4);
+    put(40, dataSize);
+
+    auto samples = reinterpret_cast<int16_t*>(wav.data() + 44);
+    for (uint32_t i = 0; i < frames; ++i)
+    {
+        for (uint16_t c = 0; c < channels; ++c)
+            samples[i * channels + c] = int16_t(8000 * std::sin(i * 2 * 3.14159265 * 440 / sampleRate));
+    }
+
+    auto path = ax::FileUtils::getInstance()->getWritablePath() + std::string{name};
+    ax::FileUtils::writeBinaryToFile(wav.data(), wav.size(), path);
+    return path;
+}
+
+// runs the scheduler, where AudioEngine updates its players, until pred returns true
+inline bool pumpUntil(const std::function<bool()>& pred, double timeout)
+{
+    auto scheduler = ax::Director::getInstance()->getScheduler();
+    auto start     = std::chrono::steady_clock::now();
+    while (!pred())
+    {
+        if (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > timeout)
+            return false;
+        scheduler->update(1.0f / 60);
+        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+    }
+    return true;
+}
+
+// outputs to OpenAL Soft's null device, which mixes in real time without any audio hardware
+inline bool initNullDevice()
+{
+#if defined(_WIN32)
+    _putenv_s("ALSOFT_DRIVERS", "null");
+#else
+    setenv("ALSOFT_DRIVERS", "null", 0);
+#endif
+    return ax::AudioEngine::lazyInit();
+}
+}  // namespace audio_test
@@ -0,0 +1,271 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include "AudioTestUtils.h"
+
+using namespace ax;
+using namespace audio_test;
+
+namespace
+{
+// checks no virtual voice is more important than a real one, and the inaudible instances are virtual
+void checkVoiceRanking(const std::vector<AUDIO_ID>& ids)
+{
+    std::pair<int, float> weakestReal{INT_MAX, 2.0f};
+    std::pair<int, float> strongestVirtual{INT_MIN, -1.0f};
+    for (auto id : ids)
+    {
+        if (AudioEngine::getState(id) == AudioEngine::AudioState::ERROR)
+            continue;
+
+        std::pair<int, float> importance{AudioEngine::getPriority(id), AudioEngine::getVolume(id)};
+        if (!AudioEngine::isVirtual(id))
+        {
+            CHECK_GT(importance.second, 0.0f);
+            weakestReal = (std::min)(weakestReal, importance);
+        }
+        else if (importance.second > 0.0f)
+            strongestVirtual = (std::max)(strongestVirtual, importance);
+    }
+    CHECK_FALSE(weakestReal < strongestVirtual);
+}
+}  // namespace
+
+TEST_SUITE("audio/AudioVoices")
+{
+    TEST_CASE("virtual_voices_stress")
+    {
+        if (!initNullDevice())
+        {
+            MESSAGE("No OpenAL device, skipping");
+            return;
+        }
+
+        // mono and short, so all the instances share the one buffer of its AudioCache
+        auto path = writeWav("__test_voices.wav", 2, 1);
+
+        constexpr int soundCount = 1000;
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<int> priorities(0, 9);
+        std::uniform_real_distribution<float> volumes(0.01f, 1.0f);
+
+        std::vector<AUDIO_ID> ids;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < soundCount; ++i)
+        {
+            AudioPlayerSettings settings;
+            settings.loop     = true;
+            settings.volume   = i % 10 == 0 ? 0.0f : volumes(rng);  // every tenth sound is inaudible
+            settings.priority = priorities(rng);
+
+            auto id = AudioEngine::play2d(path, settings);
+            REQUIRE_NE(id, AudioEngine::INVALID_AUDIO_ID);
+            ids.push_back(id);
+        }
+        MESSAGE("play2d x" << soundCount << ": "
+                           << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+                           << "ms");
+
+        // the sources go to the most important sounds once they are all loaded
+        auto allPlaying = [&ids] {
+            return std::all_of(ids.begin(), ids.end(), [](AUDIO_ID id) {
+                return AudioEngine::getState(id) == AudioEngine::AudioState::PLAYING;
+            });
+        };
+        REQUIRE(pumpUntil(allPlaying, 10.0));
+        pumpUntil([] { return false; }, 0.1);
+
+        auto stats         = AudioEngine::getVoiceStats();
+        const auto sources = stats.realVoices;
+        CHECK_GT(sources, 0);
+        CHECK_LT(sources, soundCount);
+        CHECK_EQ(stats.realVoices + stats.virtualVoices, soundCount);
+        checkVoiceRanking(ids);
+
+        SUBCASE("virtual_voices_advance")
+        {
+            auto it = std::find_if(ids.begin(), ids.end(), [](AUDIO_ID id) { return AudioEngine::isVirtual(id); });
+            REQUIRE(it != ids.end());
+            auto time = AudioEngine::getCurrentTime(*it);
+            pumpUntil([] { return false; }, 0.3);
+            CHECK_NE(AudioEngine::getCurrentTime(*it), doctest::Approx(time));
+        }
+
+        SUBCASE("virtual_voices_keep_wall_time")
+        {
+            // the virtual voices keep time with the real ones while the scheduler is slowed down
+            auto it = std::find_if(ids.begin(), ids.end(), [](AUDIO_ID id) { return AudioEngine::isVirtual(id); });
+            REQUIRE(it != ids.end());
+            auto scheduler = Director::getInstance()->getScheduler();
+            scheduler->setTimeScale(0.1f);
+            auto time  = AudioEngine::getCurrentTime(*it);
+            auto start = std::chrono::steady_clock::now();
+            pumpUntil([] { return false; }, 0.3);
+            const float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+            const float advance = std::fmod(AudioEngine::getCurrentTime(*it) - time + 2.0f, 2.0f);
+            scheduler->setTimeScale(1.0f);
+            CHECK_EQ(advance, doctest::Approx(elapsed).epsilon(0.2));
+        }
+
+        SUBCASE("steal")
+        {
+            // takes the source of the least important real voice right away
+            AudioPlayerSettings settings;
+            settings.loop     = true;
+            settings.priority = 100;
+            auto id           = AudioEngine::play2d(path, settings);
+            CHECK_FALSE(AudioEngine::isVirtual(id));
+            CHECK_EQ(AudioEngine::getVoiceStats().stolenVoices, stats.stolenVoices + 1);
+            CHECK_EQ(AudioEngine::getVoiceStats().realVoices, sources);
+
+            // a new sound less important than all the real voices starts virtual
+            settings.priority = -1;
+            CHECK(AudioEngine::isVirtual(AudioEngine::play2d(path, settings)));
+        }
+
+        SUBCASE("promote")
+        {
+            // the freed sources go to the next most important virtual voices
+            std::vector<AUDIO_ID> realIds;
+            std::copy_if(ids.begin(), ids.end(), std::back_inserter(realIds),
+                         [](AUDIO_ID id) { return !AudioEngine::isVirtual(id); });
+            for (auto id : realIds)
+                AudioEngine::stop(id);
+
+            CHECK_EQ(AudioEngine::getVoiceStats().realVoices, sources);
+            checkVoiceRanking(ids);
+        }
+
+        SUBCASE("pause_resume")
+        {
+            // a paused virtual voice keeps its playback position
+            auto id = ids[1];
+            AudioEngine::setPriority(id, -100);
+            AudioEngine::pause(id);
+            pumpUntil([] { return false; }, 0.1);
+            REQUIRE(AudioEngine::isVirtual(id));
+            auto time = AudioEngine::getCurrentTime(id);
+            pumpUntil([] { return false; }, 0.2);
+            CHECK_EQ(AudioEngine::getCurrentTime(id), doctest::Approx(time));
+
+            // and plays on a source again as soon as it's resumed
+            AudioEngine::setPriority(id, 100);
+            AudioEngine::resume(id);
+            CHECK_FALSE(AudioEngine::isVirtual(id));
+        }
+
+        AudioEngine::stopAll();
+        stats = AudioEngine::getVoiceStats();
+        CHECK_EQ(stats.realVoices + stats.virtualVoices, 0);
+
+        AudioEngine::end();
+        FileUtils::getInstance()->removeFile(path);
+    }
+
+    TEST_CASE("streamed_voices")
+    {
+        if (!initNullDevice())
+        {
+            MESSAGE("No OpenAL device, skipping");
+            return;
+        }
+
+        auto path = writeWav("__test_voices.wav", 2, 1);
+        // long and stereo, so it's streamed
+        auto streamedPath = writeWav("__test_streamed_voice.wav", 8, 2);
+
+        // more looped sounds than sources, so the sources get recycled between voices
+        constexpr int soundCount = 100;
+        AudioPlayerSettings settings;
+        settings.loop = true;
+        std::vector<AUDIO_ID> ids;
+        for (int i = 0; i < soundCount; ++i)
+        {
+            auto id = AudioEngine::play2d(path, settings);
+            REQUIRE_NE(id, AudioEngine::INVALID_AUDIO_ID);
+            ids.push_back(id);
+        }
+        auto allPlaying = [&ids] {
+            return std::all_of(ids.begin(), ids.end(), [](AUDIO_ID id) {
+                return AudioEngine::getState(id) == AudioEngine::AudioState::PLAYING;
+            });
+        };
+        REQUIRE(pumpUntil(allPlaying, 10.0));
+        REQUIRE_GT(AudioEngine::getVoiceStats().virtualVoices, 0);
+
+        AUDIO_ID streamed = AudioEngine::INVALID_AUDIO_ID;
+        auto isPlaying    = [&streamed] {
+            return AudioEngine::getState(streamed) == AudioEngine::AudioState::PLAYING;
+        };
+
+        SUBCASE("virtual_first")
+        {
+            // less important than all the real voices, it starts virtual
+            settings.priority = -1;
+            streamed          = AudioEngine::play2d(streamedPath, settings);
+            REQUIRE(pumpUntil(isPlaying, 10.0));
+            CHECK(AudioEngine::isVirtual(streamed));
+            pumpUntil([] { return false; }, 0.3);
+        }
+
+        SUBCASE("virtualized")
+        {
+            // streams from the start on a stolen source, then loses it
+            settings.priority = 100;
+            streamed          = AudioEngine::play2d(streamedPath, settings);
+            REQUIRE(pumpUntil(isPlaying, 10.0));
+            CHECK_FALSE(AudioEngine::isVirtual(streamed));
+            pumpUntil([] { return false; }, 0.3);
+            CHECK_EQ(AudioEngine::getStreamingStats().activeStreams, 1);
+
+            AudioEngine::setPriority(streamed, -1);
+            REQUIRE(pumpUntil([&streamed] { return AudioEngine::isVirtual(streamed); }, 1.0));
+            CHECK_EQ(AudioEngine::getStreamingStats().activeStreams, 0);
+        }
+
+        // given a source another voice left stopped, it streams on from its playback position
+        AudioEngine::setPriority(streamed, 100);
+        REQUIRE(pumpUntil([&streamed] { return !AudioEngine::isVirtual(streamed); }, 1.0));
+        auto time = AudioEngine::getCurrentTime(streamed);
+        CHECK_GT(time, 0.2f);
+
+        pumpUntil([] { return false; }, 0.5);
+        REQUIRE(isPlaying());
+        CHECK_FALSE(AudioEngine::isVirtual(streamed));
+        CHECK_GT(AudioEngine::getCurrentTime(streamed), time);
+        CHECK_EQ(AudioEngine::getStreamingStats().activeStreams, 1);
+
+        AudioEngine::stopAll();
+        AudioEngine::end();
+        FileUtils::getInstance()->removeFile(path);
+        FileUtils::getInstance()->removeFile(streamedPath);
+    }
+}
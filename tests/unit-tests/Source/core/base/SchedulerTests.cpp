@@ -0,0 +1,416 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <doctest.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "base/Scheduler.h"
+
+USING_NS_AX;
+
+namespace
+{
+// the interval timer algorithm of Timer::update, what the scheduler did for every timer of every frame
+class ReferenceTimer : public Timer
+{
+public:
+    ReferenceTimer(float interval, unsigned int repeat, float delay) { setupTimerWithInterval(interval, repeat, delay); }
+
+    void trigger(float dt) override
+    {
+        ++triggers;
+        lastDt = dt;
+    }
+    void cancel() override { cancelled = true; }
+
+    int triggers    = 0;
+    float lastDt    = 0;
+    bool cancelled  = false;
+};
+
+struct Counter
+{
+    int triggers = 0;
+    float lastDt = 0;
+    ccSchedulerFunc callback()
+    {
+        return [this](float dt) {
+            ++triggers;
+            lastDt = dt;
+        };
+    }
+};
+
+void step(Scheduler* scheduler, float dt, int frames = 1)
+{
+    for (int i = 0; i < frames; ++i)
+        scheduler->update(dt);
+}
+
+double measureSeconds(int iterations, const std::function<void()>& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        func();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+}  // namespace
+
+TEST_SUITE("base/Scheduler")
+{
+    TEST_CASE("interval")
+    {
+        auto scheduler = new Scheduler();
+        int target;
+        Counter counter;
+        scheduler->schedule(counter.callback(), &target, 0.25f, false, "interval");
+        CHECK(scheduler->isScheduled("interval", &target));
+
+        // the first update starts the timer
+        step(scheduler, 0.125f);
+        CHECK_EQ(counter.triggers, 0);
+        step(scheduler, 0.125f);
+        CHECK_EQ(counter.triggers, 0);
+        step(scheduler, 0.125f);
+        CHECK_EQ(counter.triggers, 1);
+        CHECK_EQ(counter.lastDt, 0.25f);
+        step(scheduler, 0.125f, 6);
+        CHECK_EQ(counter.triggers, 4);
+
+        // late frames catch up
+        step(scheduler, 1.0f);
+        CHECK_EQ(counter.triggers, 8);
+
+        scheduler->unschedule("interval", &target);
+        CHECK_FALSE(scheduler->isScheduled("interval", &target));
+        step(scheduler, 1.0f);
+        CHECK_EQ(counter.triggers, 8);
+        scheduler->release();
+    }
+
+    TEST_CASE("delay_and_repeat")
+    {
+        auto scheduler = new Scheduler();
+        int target;
+        Counter counter;
+        scheduler->schedule(counter.callback(), &target, 0.25f, 2, 0.5f, false, "repeat");
+
+        step(scheduler, 0.25f, 3);
+        CHECK_EQ(counter.triggers, 1);
+        CHECK_EQ(counter.lastDt, 0.5f);
+        step(scheduler, 0.25f, 2);
+        CHECK_EQ(counter.triggers, 3);
+        CHECK_EQ(counter.lastDt, 0.25f);
+        CHECK_FALSE(scheduler->isScheduled("repeat", &target));
+        step(scheduler, 1.0f);
+        CHECK_EQ(counter.triggers, 3);
+        scheduler->release();
+    }
+
+    TEST_CASE("every_frame")
+    {
+        auto scheduler = new Scheduler();
+        int target;
+        Counter counter, delayed;
+        scheduler->schedule(counter.callback(), &target, 0, false, "frame");
+        scheduler->schedule(delayed.callback(), &target, 0, 3, 0.5f, false, "delayed");
+
+        step(scheduler, 0.125f);
+        CHECK_EQ(counter.triggers, 0);
+        step(scheduler, 0.125f, 3);
+        CHECK_EQ(counter.triggers, 3);
+        CHECK_EQ(counter.lastDt, 0.125f);
+        CHECK_EQ(delayed.triggers, 0);
+
+        // the delay trigger is followed by one with the rest of the frame, as in Timer::update
+        step(scheduler, 0.375f);
+        CHECK_EQ(delayed.triggers, 2);
+        CHECK_EQ(delayed.lastDt, 0.25f);
+        step(scheduler, 0.125f, 4);
+        CHECK_EQ(delayed.triggers, 4);
+        CHECK_FALSE(scheduler->isScheduled("delayed", &target));
+        CHECK_EQ(counter.triggers, 8);
+        scheduler->release();
+    }
+
+    TEST_CASE("selector")
+    {
+        struct Target : public Object
+        {
+            void tick(float) { ++triggers; }
+            void tock(float) { ++triggers; }
+            int triggers = 0;
+        } target;
+
+        auto scheduler = new Scheduler();
+        scheduler->schedule(AX_SCHEDULE_SELECTOR(Target::tick), &target, 0.25f, false);
+        scheduler->schedule(AX_SCHEDULE_SELECTOR(Target::tock), &target, 0.5f, false);
+        CHECK(scheduler->isScheduled(AX_SCHEDULE_SELECTOR(Target::tick), &target));
+        step(scheduler, 0.25f, 5);
+        CHECK_EQ(target.triggers, 6);
+
+        scheduler->unschedule(AX_SCHEDULE_SELECTOR(Target::tick), &target);
+        CHECK_FALSE(scheduler->isScheduled(AX_SCHEDULE_SELECTOR(Target::tick), &target));
+        CHECK(scheduler->isScheduled(AX_SCHEDULE_SELECTOR(Target::tock), &target));
+        step(scheduler, 0.25f, 2);
+        CHECK_EQ(target.triggers, 7);
+        scheduler->unscheduleAllForTarget(&target);
+        CHECK_FALSE(scheduler->isScheduled(AX_SCHEDULE_SELECTOR(Target::tock), &target));
+        scheduler->release();
+    }
+
+    TEST_CASE("unschedule_in_callback")
+    {
+        auto scheduler = new Scheduler();
+        int target;
+        int first = 0, second = 0;
+        scheduler->schedule(
+            [&](float) {
+                ++first;
+                scheduler->unschedule("first", &target);
+                scheduler->unschedule("second", &target);
+            },
+            &target, 0.25f, false, "first");
+        scheduler->schedule([&](float) { ++second; }, &target, 0.25f, false, "second");
+
+        // both are due in the same frame, the first one runs first since it was scheduled first
+        step(scheduler, 0.25f, 4);
+        CHECK_EQ(first, 1);
+        CHECK_EQ(second, 0);
+
+        int third = 0;
+        scheduler->schedule([&](float) { ++third; scheduler->unscheduleAllForTarget(&target); }, &target, 0.25f,
+                            false, "third");
+        scheduler->schedule([&](float) { ++third; }, &target, 0.25f, false, "fourth");
+        step(scheduler, 0.25f, 4);
+        CHECK_EQ(third, 1);
+        scheduler->release();
+    }
+
+    TEST_CASE("reschedule_in_callback")
+    {
+        auto scheduler = new Scheduler();
+        int target;
+        int first = 0, second = 0;
+
+        // the key of a timer running its last trigger can be scheduled again
+        scheduler->schedule(
+            [&](float) {
+                ++first;
+                scheduler->schedule([&](float) { ++second; }, &target, 0.25f, 0, 0, false, "timer");
+            },
+            &target, 0.25f, 0, 0, false, "timer");
+        step(scheduler, 0.25f, 2);
+        CHECK_EQ(first, 1);
+        CHECK(scheduler->isScheduled("timer", &target));
+        step(scheduler, 0.25f);
+        CHECK_EQ(second, 1);
+        CHECK_FALSE(scheduler->isScheduled("timer", &target));
+
+        // scheduling a running key again restarts it
+        Counter counter;
+        scheduler->schedule(counter.callback(), &target, 0.25f, false, "restart");
+        step(scheduler, 0.25f, 2);
+        CHECK_EQ(counter.triggers, 1);
+        scheduler->schedule(counter.callback(), &target, 1.0f, false, "restart");
+        step(scheduler, 0.25f, 4);
+        CHECK_EQ(counter.triggers, 1);
+        step(scheduler, 0.25f);
+        CHECK_EQ(counter.triggers, 2);
+        CHECK_EQ(counter.lastDt, 1.0f);
+        scheduler->release();
+    }
+
+    TEST_CASE("pause_resume")
+    {
+        auto scheduler = new Scheduler();
+        int target;
+        Counter counter;
+        scheduler->schedule(counter.callback(), &target, 0.5f, false, "paused");
+        step(scheduler, 0.25f, 2);
+
+        scheduler->pauseTarget(&target);
+        CHECK(scheduler->isTargetPaused(&target));
+        step(scheduler, 1.0f, 3);
+        CHECK_EQ(counter.triggers, 0);
+
+        // the time left before the pause is kept
+        scheduler->resumeTarget(&target);
+        step(scheduler, 0.25f);
+        CHECK_EQ(counter.triggers, 1);
+        step(scheduler, 0.25f, 2);
+        CHECK_EQ(counter.triggers, 2);
+
+        auto paused = scheduler->pauseAllTargets();
+        CHECK_EQ(paused.count(&target), 1);
+        step(scheduler, 1.0f);
+        CHECK_EQ(counter.triggers, 2);
+        scheduler->resumeTargets(paused);
+        step(scheduler, 0.5f);
+        CHECK_EQ(counter.triggers, 3);
+
+        // a target scheduled as paused doesn't start before it's resumed
+        int other;
+        Counter otherCounter;
+        scheduler->schedule(otherCounter.callback(), &other, 0.25f, true, "paused");
+        step(scheduler, 1.0f, 2);
+        CHECK_EQ(otherCounter.triggers, 0);
+        scheduler->resumeTarget(&other);
+        step(scheduler, 0.25f);
+        CHECK_EQ(otherCounter.triggers, 1);
+        scheduler->release();
+    }
+
+    TEST_CASE("time_scale")
+    {
+        auto scheduler = new Scheduler();
+        int target;
+        Counter counter;
+        scheduler->setTimeScale(2.0f);
+        scheduler->schedule(counter.callback(), &target, 0.5f, false, "scaled");
+        step(scheduler, 0.25f, 3);
+        CHECK_EQ(counter.triggers, 2);
+        scheduler->release();
+    }
+
+    TEST_CASE("long_intervals")
+    {
+        // these timers start in the higher levels of the wheel and move down as it turns
+        auto scheduler = new Scheduler();
+        int target;
+        Counter minutes, hours, days;
+        scheduler->schedule(minutes.callback(), &target, 300.0f, false, "minutes");
+        scheduler->schedule(hours.callback(), &target, 7200.0f, false, "hours");
+        scheduler->schedule(days.callback(), &target, 172800.0f, false, "days");
+        step(scheduler, 0);
+
+        step(scheduler, 60.0f, 4);
+        CHECK_EQ(minutes.triggers, 0);
+        step(scheduler, 60.0f);
+        CHECK_EQ(minutes.triggers, 1);
+        step(scheduler, 60.0f, 115);
+        CHECK_EQ(minutes.triggers, 24);
+        CHECK_EQ(hours.triggers, 1);
+
+        step(scheduler, 3600.0f, 46);
+        CHECK_EQ(hours.triggers, 24);
+        CHECK_EQ(days.triggers, 1);
+        CHECK_EQ(minutes.triggers, 576);
+        scheduler->release();
+    }
+
+    TEST_CASE("random_timers")
+    {
+        // timers and frames on a 1/64s grid, so both algorithms see the same times
+        std::mt19937 rng(12345);
+        auto grid = [&](int max) { return static_cast<float>(std::uniform_int_distribution<int>(0, max)(rng)) / 64; };
+
+        auto scheduler = new Scheduler();
+        int target;
+        std::vector<Counter> counters(2000);
+        std::vector<ReferenceTimer*> references;
+        for (size_t i = 0; i < counters.size(); ++i)
+        {
+            float interval = grid(640);
+            float delay    = i % 3 == 0 ? grid(320) : 0;
+            unsigned int repeat = i % 2 ? AX_REPEAT_FOREVER : std::uniform_int_distribution<unsigned int>(0, 10)(rng);
+            scheduler->schedule(counters[i].callback(), &target, interval, repeat, delay, false,
+                                fmt::format("timer{}", i));
+            references.emplace_back(new ReferenceTimer(interval, repeat, delay));
+        }
+
+        for (int frame = 0; frame < 1000; ++frame)
+        {
+            float dt = grid(8);
+            scheduler->update(dt);
+            for (auto timer : references)
+            {
+                if (!timer->cancelled)
+                    timer->update(dt);
+            }
+        }
+
+        for (size_t i = 0; i < counters.size(); ++i)
+        {
+            CAPTURE(i);
+            CHECK_EQ(counters[i].triggers, references[i]->triggers);
+            CHECK_EQ(counters[i].lastDt, references[i]->lastDt);
+            CHECK_EQ(scheduler->isScheduled(fmt::format("timer{}", i), &target), !references[i]->cancelled);
+            references[i]->release();
+        }
+        scheduler->release();
+    }
+
+    TEST_CASE("benchmark")
+    {
+        // idle frames: long timers of which a few trigger per frame, then schedule and unschedule all of them
+        for (int count : {10000, 100000, 1000000})
+        {
+            std::mt19937 rng(count);
+            std::uniform_real_distribution<float> intervals(1.0f, 60.0f);
+            std::vector<int> targets(1000);
+            std::vector<std::string> keys(count / targets.size());
+            for (size_t i = 0; i < keys.size(); ++i)
+                keys[i] = fmt::format("t{}", i);
+
+            int triggers   = 0;
+            auto callback  = [&triggers](float) { ++triggers; };
+            auto scheduler = new Scheduler();
+
+            auto scheduleSeconds = measureSeconds(1, [&] {
+                for (int i = 0; i < count; ++i)
+                    scheduler->schedule(callback, &targets[i % targets.size()], intervals(rng), false,
+                                        keys[i / targets.size()]);
+            });
+            scheduler->update(0);
+            auto frameSeconds = measureSeconds(120, [&] { scheduler->update(1.0f / 60); });
+            auto unscheduleSeconds = measureSeconds(1, [&] {
+                for (int i = 0; i < count; ++i)
+                    scheduler->unschedule(keys[i / targets.size()], &targets[i % targets.size()]);
+            });
+            scheduler->release();
+
+            // what a frame cost when every timer was updated
+            std::vector<ReferenceTimer*> references;
+            for (int i = 0; i < count; ++i)
+            {
+                references.emplace_back(new ReferenceTimer(intervals(rng), AX_REPEAT_FOREVER, 0));
+                references.back()->update(0);
+            }
+            auto referenceSeconds = measureSeconds(10, [&] {
+                for (auto timer : references)
+                    timer->update(1.0f / 60);
+            });
+            for (auto timer : references)
+                timer->release();
+
+            MESSAGE(fmt::format("{} timers: frame {:.3f}ms (updating every timer {:.3f}ms), schedule {:.0f}ns, "
+                                "unschedule {:.0f}ns per timer",
+                                count, frameSeconds * 1e3, referenceSeconds * 1e3, scheduleSeconds * 1e9 / count,
+                                unscheduleSeconds * 1e9 / count));
+        }
+    }
+}
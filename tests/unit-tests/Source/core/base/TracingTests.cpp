@@ -0,0 +1,174 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <thread>
+#include <vector>
+#include <unordered_set>
+#include "base/Tracing.h"
+#include "rapidjson/document.h"
+
+USING_NS_AX;
+
+namespace
+{
+rapidjson::Document parseTrace()
+{
+    rapidjson::Document doc;
+    auto json = Tracer::toChromeTrace();
+    doc.Parse(json.c_str(), json.length());
+    REQUIRE_FALSE(doc.HasParseError());
+    REQUIRE(doc.HasMember("traceEvents"));
+    return doc;
+}
+
+std::vector<const rapidjson::Value*> findEvents(const rapidjson::Document& doc, std::string_view name, char phase)
+{
+    std::vector<const rapidjson::Value*> result;
+    for (auto& event : doc["traceEvents"].GetArray())
+    {
+        if (event["ph"].GetString()[0] == phase && name == event["name"].GetString())
+            result.push_back(&event);
+    }
+    return result;
+}
+}  // namespace
+
+TEST_SUITE("base/Tracing")
+{
+    TEST_CASE("disabled")
+    {
+        Tracer::stop();
+        Tracer::clear();
+        {
+            AX_TRACE_ZONE("disabled");
+        }
+        CHECK_EQ(Tracer::getEventCount(), 0);
+    }
+
+    TEST_CASE("nested_zones")
+    {
+        Tracer::clear();
+        Tracer::start();
+        {
+            AX_TRACE_ZONE("outer");
+            {
+                AX_TRACE_ZONE("inner");
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        Tracer::stop();
+
+        auto doc   = parseTrace();
+        auto outer = findEvents(doc, "outer", 'X');
+        auto inner = findEvents(doc, "inner", 'X');
+        REQUIRE_EQ(outer.size(), 1);
+        REQUIRE_EQ(inner.size(), 1);
+
+        auto outerStart = (*outer[0])["ts"].GetDouble();
+        auto innerStart = (*inner[0])["ts"].GetDouble();
+        CHECK_EQ((*outer[0])["tid"].GetInt(), (*inner[0])["tid"].GetInt());
+        CHECK_GE(innerStart, outerStart);
+        CHECK_GE((*inner[0])["dur"].GetDouble(), 1000.0);
+        CHECK_LE(innerStart + (*inner[0])["dur"].GetDouble(), outerStart + (*outer[0])["dur"].GetDouble());
+    }
+
+    TEST_CASE("threads")
+    {
+        Tracer::clear();
+        Tracer::start();
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+        {
+            threads.emplace_back([i] {
+                Tracer::setThreadName("worker-" + std::to_string(i));
+                for (int k = 0; k < 100; ++k)
+                {
+                    AX_TRACE_ZONE("work");
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        Tracer::stop();
+
+        auto doc = parseTrace();
+        auto work = findEvents(doc, "work", 'X');
+        CHECK_EQ(work.size(), 400);
+
+        std::unordered_set<int> tids;
+        for (auto event : work)
+            tids.insert((*event)["tid"].GetInt());
+        CHECK_EQ(tids.size(), 4);
+
+        auto names = findEvents(doc, "thread_name", 'M');
+        int workers = 0;
+        for (auto event : names)
+        {
+            std::string_view name = (*event)["args"]["name"].GetString();
+            if (name.starts_with("worker-"))
+            {
+                ++workers;
+                CHECK(tids.contains((*event)["tid"].GetInt()));
+            }
+        }
+        CHECK_EQ(workers, 4);
+
+        // buffers of exited threads are released by clear
+        Tracer::clear();
+        CHECK_EQ(findEvents(parseTrace(), "work", 'X').size(), 0);
+    }
+
+    TEST_CASE("ring_overwrite")
+    {
+        static constexpr TraceZoneInfo zone{"ring", __FILE__, __LINE__};
+
+        Tracer::clear();
+        Tracer::start(64);
+        std::thread([] {
+            for (int64_t i = 0; i < 1000; ++i)
+                Tracer::record(&zone, i * 1000, i * 1000 + 1);
+        }).join();
+        Tracer::stop();
+
+        auto doc    = parseTrace();
+        auto events = findEvents(doc, "ring", 'X');
+        REQUIRE_EQ(events.size(), 64);
+
+        // only the newest events are kept
+        double minTs = 1e9, maxTs = 0;
+        for (auto event : events)
+        {
+            minTs = (std::min)(minTs, (*event)["ts"].GetDouble());
+            maxTs = (std::max)(maxTs, (*event)["ts"].GetDouble());
+        }
+        CHECK_EQ(maxTs - minTs, doctest::Approx(63.0));
+
+        // restore the default capacity for buffers created later
+        Tracer::clear();
+        Tracer::start();
+        Tracer::stop();
+    }
+}
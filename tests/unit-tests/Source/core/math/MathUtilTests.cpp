@@ -157,6 +157,48 @@ TEST_SUITE("math/MathUtil")
             for (int i = 0; i < count; ++i)
                 CHECK_EQ(expected[i], dst[i]);
         }
+#endif
+    }
+
+    TEST_CASE("transformIndices32")
+    {
+        auto count = 43;
+        std::vector<uint16_t> src(count);
+        std::vector<uint32_t> expected(count);
+
+        // offset beyond 16 bits, the results must not wrap around
+        uint32_t offset = 70000;
+
+        for (int i = 0; i < count; ++i)
+        {
+            src[i]      = 65535 - i;
+            expected[i] = src[i] + offset;
+        }
+
+        SUBCASE("MathUtilC")
+        {
+            std::vector<uint32_t> dst(count);
+            MathUtilC::transformIndices(dst.data(), src.data(), count, offset);
+            for (int i = 0; i < count; ++i)
+                CHECK_EQ(expected[i], dst[i]);
+        }
+
+#if defined(AX_NEON_INTRINSICS) && AX_64BITS
+        SUBCASE("MathUtilNeon")
+        {
+            std::vector<uint32_t> dst(count);
+            MathUtilNeon::transformIndices(dst.data(), src.data(), count, offset);
+            for (int i = 0; i < count; ++i)
+                CHECK_EQ(expected[i], dst[i]);
+        }
+#elif defined(AX_SSE_INTRINSICS)
+        SUBCASE("MathUtilSSE")
+        {
+            std::vector<uint32_t> dst(count);
+            MathUtilSSE::transformIndices(dst.data(), src.data(), count, offset);
+            for (int i = 0; i < count; ++i)
+                CHECK_EQ(expected[i], dst[i]);
+        }
 #endif
     }
 }
@@ -0,0 +1,243 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <doctest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "network/HttpClient.h"
+#include "yasio/xxsocket.hpp"
+
+using namespace ax;
+using namespace ax::network;
+
+namespace
+{
+/* Stand-in HTTP/1.1 server on loopback, answers every request with a tiny body and
+ * honours "Connection: close", counts accepted connections.
+ * With dropIdleConnections it closes every connection after one response without telling
+ * the client, like a server whose keep-alive timeout is shorter than ours */
+class LocalHttpServer
+{
+public:
+    explicit LocalHttpServer(u_short port, bool dropIdleConnections = false)
+        : _dropIdleConnections(dropIdleConnections)
+    {
+        _listener.pserve("127.0.0.1", port);
+        _acceptThread = std::thread([this] {
+            for (;;)
+            {
+                auto peer = _listener.accept();
+                if (!peer.is_open() || _stopping)
+                    break;
+                ++_acceptedConnections;
+                std::lock_guard<std::mutex> lck(_peersMutex);
+                _peers.emplace_back(std::make_unique<yasio::xxsocket>(std::move(peer)));
+                _peerThreads.emplace_back(&LocalHttpServer::serve, this, _peers.back().get());
+            }
+        });
+    }
+
+    ~LocalHttpServer()
+    {
+        _stopping = true;
+        _listener.shutdown();
+        _listener.close();
+        _acceptThread.join();
+
+        std::lock_guard<std::mutex> lck(_peersMutex);
+        for (auto& peer : _peers)
+            peer->shutdown();
+        for (auto& t : _peerThreads)
+            t.join();
+    }
+
+    int getAcceptedConnections() const { return _acceptedConnections; }
+    int getServedRequests() const { return _servedRequests; }
+
+private:
+    void serve(yasio::xxsocket* peer)
+    {
+        std::string buffer;
+        char chunk[4096];
+        bool open = true;
+        while (open)
+        {
+            int n = peer->recv(chunk, sizeof(chunk));
+            if (n <= 0)
+                break;
+            buffer.append(chunk, n);
+
+            size_t pos;
+            while (open && (pos = buffer.find("\r\n\r\n")) != std::string::npos)
+            {
+                const bool close = buffer.substr(0, pos).find("Connection: close") != std::string::npos;
+                buffer.erase(0, pos + 4);
+
+                std::string reply = "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 5\r\n";
+                if (close)
+                    reply += "Connection: close\r\n";
+                reply += "\r\nhello";
+                ++_servedRequests;
+                peer->send(reply.data(), static_cast<int>(reply.size()));
+                open = !close && !_dropIdleConnections;
+            }
+        }
+        peer->shutdown();
+    }
+
+    const bool _dropIdleConnections;
+    yasio::xxsocket _listener;
+    std::thread _acceptThread;
+    std::mutex _peersMutex;
+    std::vector<std::unique_ptr<yasio::xxsocket>> _peers;
+    std::vector<std::thread> _peerThreads;
+    std::atomic<bool> _stopping{false};
+    std::atomic<int> _acceptedConnections{0};
+    std::atomic<int> _servedRequests{0};
+};
+
+constexpr u_short SERVER_PORT = 18661;
+
+struct BurstResult
+{
+    int succeeded        = 0;
+    unsigned connections = 0;
+    double elapsedMs     = 0;
+};
+
+BurstResult sendBurst(HttpClient* client, int count)
+{
+    std::atomic<int> finished{0};
+    std::atomic<int> succeeded{0};
+
+    auto openedBefore = client->getOpenedConnectionCount();
+    auto start        = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+        auto request = new HttpRequest();
+        request->setUrl(fmt::format("http://127.0.0.1:{}/item/{}", SERVER_PORT, i));
+        request->setRequestType(HttpRequest::Type::GET);
+        request->setResponseCallback([&](HttpClient*, HttpResponse* response) {
+            if (response->getResponseCode() == 200 && response->getResponseData()->size() == 5)
+                ++succeeded;
+            ++finished;
+        });
+        client->send(request);
+        request->release();
+    }
+
+    auto deadline = start + std::chrono::seconds(10);
+    while (finished < count && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+    BurstResult result;
+    result.elapsedMs   = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    result.succeeded   = succeeded;
+    result.connections = client->getOpenedConnectionCount() - openedBefore;
+
+    // wait for the callbacks referencing the counters above
+    while (finished < count)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return result;
+}
+}  // namespace
+
+TEST_SUITE("network/HttpClient")
+{
+    TEST_CASE("keep_alive")
+    {
+        LocalHttpServer server(SERVER_PORT);
+
+        auto client = HttpClient::getInstance();
+        client->setDispatchOnWorkThread(true);
+
+        constexpr int BURST = 64;
+
+        client->setKeepAliveEnabled(false);
+        auto closed = sendBurst(client, BURST);
+        CHECK_EQ(closed.succeeded, BURST);
+        CHECK_EQ(closed.connections, BURST);
+
+        client->setKeepAliveEnabled(true);
+        auto pooled = sendBurst(client, BURST);
+        CHECK_EQ(pooled.succeeded, BURST);
+        CHECK_LE(pooled.connections, (unsigned)HttpClient::MAX_CHANNELS);
+
+        // a second burst is served by the idle connections of the first one
+        auto reused = sendBurst(client, BURST);
+        CHECK_EQ(reused.succeeded, BURST);
+        CHECK_LE(pooled.connections + reused.connections, (unsigned)HttpClient::MAX_CHANNELS);
+        CHECK_EQ(server.getAcceptedConnections(), closed.connections + pooled.connections + reused.connections);
+
+        MESSAGE(fmt::format("{} requests, connection: close {} connections {:.2f}ms, keep-alive {} connections "
+                            "{:.2f}ms, warm keep-alive {} connections {:.2f}ms",
+                            BURST, closed.connections, closed.elapsedMs, pooled.connections, pooled.elapsedMs,
+                            reused.connections, reused.elapsedMs));
+
+        HttpClient::destroyInstance();
+    }
+
+    TEST_CASE("pipelining")
+    {
+        LocalHttpServer server(SERVER_PORT);
+
+        auto client = HttpClient::getInstance();
+        client->setDispatchOnWorkThread(true);
+        client->setPipeliningDepth(4);
+
+        constexpr int BURST = 128;
+        auto result         = sendBurst(client, BURST);
+        CHECK_EQ(result.succeeded, BURST);
+        CHECK_LE(result.connections, (unsigned)HttpClient::MAX_CHANNELS);
+        CHECK_EQ(server.getServedRequests(), BURST);
+
+        MESSAGE(fmt::format("{} requests, pipelining depth 4: {} connections {:.2f}ms", BURST, result.connections,
+                            result.elapsedMs));
+
+        HttpClient::destroyInstance();
+    }
+
+    TEST_CASE("stale_connection_retry")
+    {
+        LocalHttpServer server(SERVER_PORT, true);
+
+        auto client = HttpClient::getInstance();
+        client->setDispatchOnWorkThread(true);
+
+        // requests racing with the server closing the idle connection are resent on a new one
+        constexpr int BURST = 64;
+        for (int i = 0; i < 4; ++i)
+        {
+            auto result = sendBurst(client, BURST);
+            CHECK_EQ(result.succeeded, BURST);
+        }
+        CHECK_EQ(server.getServedRequests(), BURST * 4);
+
+        HttpClient::destroyInstance();
+    }
+}
@@ -0,0 +1,66 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "2d/Scene.h"
+
+#if defined(AX_ENABLE_PHYSICS)
+#    include "physics/PhysicsBody.h"
+#    include "physics/PhysicsWorld.h"
+
+using namespace ax;
+
+TEST_SUITE("physics/PhysicsBody")
+{
+    TEST_CASE("user_overrides_simulated_rotation")
+    {
+        auto scene = Scene::createWithPhysics();
+        REQUIRE(scene);
+        auto world = scene->getPhysicsWorld();
+        world->setAutoStep(false);
+        world->setGravity(Vec2::ZERO);
+
+        auto node = Node::create();
+        node->setContentSize(Vec2(10.0f, 10.0f));
+        node->setPosition(100.0f, 100.0f);
+        scene->addChild(node);
+        auto body = PhysicsBody::createBox(Vec2(10.0f, 10.0f));
+        node->setPhysicsBody(body);
+        world->step(1.0f / 60);
+        CHECK(node->getRotation() == doctest::Approx(0.0f));
+
+        // the simulation turns the node by 30 degrees
+        body->setAngularVelocity(-M_PI / 6);
+        world->step(1.0f);
+        CHECK(node->getRotation() == doctest::Approx(30.0f));
+
+        // turning it back to where the body was before must reach the body
+        body->setAngularVelocity(0.0f);
+        node->setRotation(0.0f);
+        world->step(1.0f / 60);
+        CHECK(node->getRotation() == doctest::Approx(0.0f));
+        CHECK(body->getRotation() == doctest::Approx(0.0f));
+    }
+}
+#endif
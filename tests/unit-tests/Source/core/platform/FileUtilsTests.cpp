@@ -117,6 +117,26 @@ TEST_SUITE("platform/FileUtils") {
     }
 
 
+    TEST_CASE("loadResourceIndex") {
+        auto indexPath = fu->getWritablePath() + "axmol-resource-index.txt";
+        REQUIRE(fu->writeStringToFile("# index\r\ntext/only_in_index.txt\r\n", indexPath));
+        REQUIRE(fu->loadResourceIndex(indexPath));
+        CHECK(fu->isResourceIndexLoaded());
+
+        // lookups are answered by the index without probing the disk
+        CHECK(fu->fullPathForFilename("text/only_in_index.txt") ==
+              fu->getDefaultResourceRootPath() + "text/only_in_index.txt");
+        CHECK(fu->fullPathForFilename("text/123.txt") == "");
+        CHECK(fu->fullPathForFilename("text/../text/123.txt") != "");
+
+        fu->unloadResourceIndex();
+        CHECK(not fu->isResourceIndexLoaded());
+        CHECK(fu->fullPathForFilename("text/only_in_index.txt") == "");
+        CHECK(fu->fullPathForFilename("text/123.txt") != "");
+        CHECK(fu->removeFile(indexPath));
+    }
+
+
     TEST_CASE("isDirectoryExist") {
         CHECK(fu->isDirectoryExist("text"));
         CHECK(fu->isDirectoryExist(fu->fullPathForDirectory("text")));
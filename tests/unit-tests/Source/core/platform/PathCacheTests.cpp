@@ -0,0 +1,258 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "platform/PathCache.h"
+#include "fmt/format.h"
+
+using namespace ax;
+
+namespace
+{
+std::vector<std::string> makeKeys(int count)
+{
+    std::vector<std::string> keys;
+    for (int i = 0; i < count; ++i)
+        keys.emplace_back(fmt::format("textures/level{}/sprite_{}.png", i % 7, i));
+    return keys;
+}
+
+// Runs lookups of all keys from the given number of threads, returns the lookups per second
+template <typename _Lookup>
+double measureLookups(int threadCount, const std::vector<std::string>& keys, _Lookup&& lookup)
+{
+    constexpr int kRounds = 50;
+
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&] {
+            std::string value;
+            for (int r = 0; r < kRounds; ++r)
+                for (auto& key : keys)
+                    lookup(key, value);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(threadCount) * kRounds * keys.size() / seconds;
+}
+}  // namespace
+
+TEST_SUITE("platform/PathCache")
+{
+    TEST_CASE("find")
+    {
+        PathCache cache;
+        std::string value;
+        CHECK_FALSE(cache.find("a.png", value));
+
+        cache.emplace("a.png", "/res/a.png");
+        REQUIRE(cache.find("a.png", value));
+        CHECK_EQ(value, "/res/a.png");
+
+        // existing entries are kept
+        cache.emplace("a.png", "/other/a.png");
+        REQUIRE(cache.find("a.png", value));
+        CHECK_EQ(value, "/res/a.png");
+        CHECK_EQ(cache.size(), 1);
+    }
+
+    TEST_CASE("grow")
+    {
+        PathCache cache;
+        auto keys = makeKeys(5000);
+        for (auto& key : keys)
+            cache.emplace(key, "/res/" + key);
+        CHECK_EQ(cache.size(), keys.size());
+
+        std::string value;
+        for (auto& key : keys)
+        {
+            REQUIRE(cache.find(key, value));
+            CHECK_EQ(value, "/res/" + key);
+        }
+        CHECK_FALSE(cache.contains("textures/missing.png"));
+
+        auto map = cache.toMap();
+        CHECK_EQ(map.size(), keys.size());
+        CHECK_EQ(map["textures/level0/sprite_0.png"], "/res/textures/level0/sprite_0.png");
+    }
+
+    TEST_CASE("clear")
+    {
+        PathCache cache;
+        cache.emplace("a.png", "/res/a.png");
+        cache.clear();
+        CHECK_EQ(cache.size(), 0);
+        CHECK_FALSE(cache.contains("a.png"));
+
+        cache.emplace("a.png", "/hd/a.png");
+        std::string value;
+        REQUIRE(cache.find("a.png", value));
+        CHECK_EQ(value, "/hd/a.png");
+    }
+
+    TEST_CASE("concurrent")
+    {
+        PathCache cache;
+        auto keys = makeKeys(4000);
+
+        std::atomic<int> mismatches{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&, t] {
+                std::string value;
+                for (size_t i = t; i < keys.size() + t; ++i)
+                {
+                    auto& key = keys[i % keys.size()];
+                    if (cache.find(key, value))
+                    {
+                        if (value != "/res/" + key)
+                            ++mismatches;
+                    }
+                    else
+                        cache.emplace(key, "/res/" + key);
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        CHECK_EQ(mismatches.load(), 0);
+        CHECK_EQ(cache.size(), keys.size());
+    }
+
+    TEST_CASE("concurrent_clear")
+    {
+        // retired generations are freed while lookups keep running, run under a sanitizer to catch a premature free
+        PathCache cache;
+        auto keys = makeKeys(500);
+
+        std::atomic<bool> done{false};
+        std::atomic<int> mismatches{0};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 3; ++t)
+        {
+            readers.emplace_back([&] {
+                std::string value;
+                while (!done.load())
+                {
+                    for (auto& key : keys)
+                    {
+                        if (cache.find(key, value) && value != "/res/" + key)
+                            ++mismatches;
+                    }
+                }
+            });
+        }
+
+        for (int round = 0; round < 200; ++round)
+        {
+            for (auto& key : keys)
+                cache.emplace(key, "/res/" + key);
+            cache.clear();
+        }
+        done = true;
+        for (auto& reader : readers)
+            reader.join();
+
+        CHECK_EQ(mismatches.load(), 0);
+        CHECK_EQ(cache.size(), 0);
+    }
+
+    TEST_CASE("reclaim_under_lookups" * doctest::timeout(30))
+    {
+        // lookups never stop, there's no moment without a lookup in flight for the writer to free a generation
+        PathCache cache;
+        auto keys = makeKeys(500);
+
+        std::atomic<bool> done{false};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t)
+        {
+            readers.emplace_back([&] {
+                std::string value;
+                while (!done.load())
+                {
+                    for (auto& key : keys)
+                        cache.find(key, value);
+                }
+            });
+        }
+
+        for (int round = 0; round < 100; ++round)
+        {
+            for (auto& key : keys)
+                cache.emplace(key, "/res/" + key);
+            cache.clear();
+        }
+
+        // the last cleared generation is freed while the lookups keep running
+        auto start = std::chrono::steady_clock::now();
+        while (cache.isReclaimPending() && std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+            cache.emplace(keys[0], "/res/" + keys[0]);
+        CHECK_FALSE(cache.isReclaimPending());
+
+        done = true;
+        for (auto& reader : readers)
+            reader.join();
+    }
+
+    TEST_CASE("benchmark")
+    {
+        auto keys = makeKeys(2000);
+
+        PathCache cache;
+        hlookup::string_map<std::string> lockedMap;
+        std::mutex mutex;
+        for (auto& key : keys)
+        {
+            cache.emplace(key, "/res/" + key);
+            lockedMap.emplace(key, "/res/" + key);
+        }
+
+        const int maxThreads = (std::max)(2, (std::min)(8, static_cast<int>(std::thread::hardware_concurrency())));
+        for (int threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            auto lockFree = measureLookups(threads, keys, [&](const std::string& key, std::string& value) {
+                cache.find(key, value);
+            });
+            auto locked = measureLookups(threads, keys, [&](const std::string& key, std::string& value) {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto it = lockedMap.find(key);
+                if (it != lockedMap.end())
+                    value = it->second;
+            });
+            MESSAGE(fmt::format("{} threads: PathCache {:.1f}M lookups/s, mutex map {:.1f}M lookups/s", threads,
+                                lockFree / 1e6, locked / 1e6));
+        }
+    }
+}
@@ -0,0 +1,89 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "renderer/backend/DriverBase.h"
+
+#if defined(AX_ENABLE_NULL_DRIVER)
+#    include "renderer/backend/null/BufferNull.h"
+#    include "renderer/backend/null/DriverNull.h"
+
+using namespace ax::backend;
+
+TEST_SUITE("renderer/BufferNull")
+{
+    TEST_CASE("stream")
+    {
+        constexpr std::size_t segmentSize = 256;
+
+        DriverNullStats stats;
+        auto buffer = new BufferNull(segmentSize, BufferType::VERTEX, BufferUsage::STREAM, &stats);
+
+        auto write = [buffer](std::size_t size, uint8_t value) {
+            std::size_t offset = 0;
+            auto data          = static_cast<uint8_t*>(buffer->mapStream(size, offset));
+            memset(data, value, size);
+            buffer->unmapStream(size);
+            return offset;
+        };
+
+        SUBCASE("regions")
+        {
+            CHECK_EQ(write(100, 1), 0);
+            // regions are 16 bytes aligned
+            CHECK_EQ(write(40, 2), 112);
+            CHECK_EQ(write(16, 3), 160);
+            CHECK_EQ(buffer->getData()[99], 1);
+            CHECK_EQ(buffer->getData()[112], 2);
+            CHECK_EQ(buffer->getStreamStats().uploadedBytes, 156);
+            CHECK_EQ(stats.bufferUploads, 3);
+            CHECK_EQ(stats.bytesUploaded, 156);
+        }
+
+        SUBCASE("segments")
+        {
+            for (std::size_t frame = 0; frame < MAX_INFLIGHT_BUFFER + 1; ++frame)
+            {
+                CHECK_EQ(write(64, uint8_t(frame)), (frame % MAX_INFLIGHT_BUFFER) * segmentSize);
+                CHECK_EQ(write(64, uint8_t(frame)), (frame % MAX_INFLIGHT_BUFFER) * segmentSize + 64);
+                buffer->nextStreamFrame();
+            }
+            CHECK_EQ(buffer->getStreamStats().orphans, 0);
+        }
+
+        SUBCASE("overflow")
+        {
+            CHECK_EQ(write(200, 1), 0);
+            // doesn't fit the rest of the segment: starts over
+            CHECK_EQ(write(100, 2), 0);
+            CHECK_EQ(buffer->getStreamStats().orphans, 1);
+
+            buffer->resetStreamStats();
+            CHECK_EQ(buffer->getStreamStats().uploadedBytes, 0);
+        }
+
+        buffer->release();
+    }
+}
+#endif
@@ -0,0 +1,335 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include <doctest.h>
+#include "renderer/backend/PixelKernels.h"
+#include "platform/Image.h"
+#include "math/FastRNG.h"
+#include "fmt/format.h"
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+USING_NS_AX;
+using namespace ax::backend;
+
+namespace
+{
+// The implementations Image used before the kernels, the vectorized versions must match them bit by bit.
+void referencePremultiplyRGBA8(unsigned char* data, size_t pixelCount)
+{
+    unsigned int* fourBytes = (unsigned int*)data;
+    for (size_t i = 0; i < pixelCount; i++)
+    {
+        uint8_t* p   = data + i * 4;
+        fourBytes[i] = AX_RGB_PREMULTIPLY_ALPHA(p[0], p[1], p[2], p[3]);
+    }
+}
+
+void referencePremultiplyRG8(unsigned char* data, size_t pixelCount)
+{
+    uint16_t* twoBytes = (uint16_t*)data;
+    for (size_t i = 0; i < pixelCount; i++)
+    {
+        uint8_t* p  = data + i * 2;
+        twoBytes[i] = ((p[0] * p[1] + 1) >> 8) | (p[1] << 8);
+    }
+}
+
+uint8_t clamp(int x)
+{
+    return (uint8_t)(x >= 0 ? (x < 255 ? x : 255) : 0);
+}
+
+void referenceReversePremultipliedAlpha(unsigned char* data, size_t pixelCount)
+{
+    unsigned int* fourBytes = (unsigned int*)data;
+    for (size_t i = 0; i < pixelCount; i++)
+    {
+        uint8_t* p = data + i * 4;
+        if (p[3] > 0)
+        {
+            fourBytes[i] = clamp(int(std::ceil((p[0] * 255.0f) / p[3]))) |
+                           clamp(int(std::ceil((p[1] * 255.0f) / p[3]))) << 8 |
+                           clamp(int(std::ceil((p[2] * 255.0f) / p[3]))) << 16 | p[3] << 24;
+        }
+    }
+}
+
+// every (color, alpha) pair, the three color channels are permuted so they don't share a lane pattern
+std::vector<unsigned char> makeAllPairsRGBA8()
+{
+    std::vector<unsigned char> data(256 * 256 * 4);
+    for (int a = 0; a < 256; ++a)
+    {
+        for (int c = 0; c < 256; ++c)
+        {
+            auto p = &data[(a * 256 + c) * 4];
+            p[0]   = c;
+            p[1]   = 255 - c;
+            p[2]   = c ^ 0x55;
+            p[3]   = a;
+        }
+    }
+    return data;
+}
+
+std::vector<unsigned char> makeRandomData(size_t size)
+{
+    FastRNG rng;
+    std::vector<unsigned char> data(size);
+    for (auto& byte : data)
+        byte = static_cast<unsigned char>(rng.next());
+    return data;
+}
+
+std::vector<PixelKernels::ISA> getSupportedISAs()
+{
+    std::vector<PixelKernels::ISA> isas;
+    for (int i = 0; i < (int)PixelKernels::ISA::COUNT; ++i)
+    {
+        if (PixelKernels::isSupported((PixelKernels::ISA)i))
+            isas.push_back((PixelKernels::ISA)i);
+    }
+    return isas;
+}
+
+// restores the default kernels when a test case ends
+struct ISAGuard
+{
+    PixelKernels::ISA isa = PixelKernels::getISA();
+    ~ISAGuard() { PixelKernels::setISA(isa); }
+};
+
+// input and output bytes per pixel of every converter in the kernel table
+struct ConverterInfo
+{
+    const char* name;
+    PixelKernels::ConvertFunc PixelKernels::KernelTable::*func;
+    size_t inBpp;
+    size_t outBpp;
+};
+
+const ConverterInfo s_converters[] = {
+    {"R8ToRGBA8", &PixelKernels::KernelTable::convertR8ToRGBA8, 1, 4},
+    {"RG8ToRGBA8", &PixelKernels::KernelTable::convertRG8ToRGBA8, 2, 4},
+    {"RGB8ToRGBA8", &PixelKernels::KernelTable::convertRGB8ToRGBA8, 3, 4},
+    {"RGBA8ToRGB8", &PixelKernels::KernelTable::convertRGBA8ToRGB8, 4, 3},
+    {"BGRA8ToRGBA8", &PixelKernels::KernelTable::convertBGRA8ToRGBA8, 4, 4},
+    {"RGBA8ToRGB565", &PixelKernels::KernelTable::convertRGBA8ToRGB565, 4, 2},
+    {"RGBA8ToRGBA4", &PixelKernels::KernelTable::convertRGBA8ToRGBA4, 4, 2},
+    {"RGBA8ToRGB5A1", &PixelKernels::KernelTable::convertRGBA8ToRGB5A1, 4, 2},
+    {"RGB565ToRGBA8", &PixelKernels::KernelTable::convertRGB565ToRGBA8, 2, 4},
+    {"RGBA4ToRGBA8", &PixelKernels::KernelTable::convertRGBA4ToRGBA8, 2, 4},
+    {"RGB5A1ToRGBA8", &PixelKernels::KernelTable::convertRGB5A1ToRGBA8, 2, 4},
+};
+
+template <typename _Func>
+double measureBytesPerSecond(size_t bytes, _Func&& func)
+{
+    const int rounds = 20;
+    func();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i)
+        func();
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds > 0 ? bytes * rounds / seconds : 0.0;
+}
+}  // namespace
+
+TEST_SUITE("renderer/PixelKernels")
+{
+    TEST_CASE("dispatch")
+    {
+        ISAGuard guard;
+        CHECK(PixelKernels::isSupported(PixelKernels::ISA::SCALAR));
+        CHECK(PixelKernels::isSupported(guard.isa));
+        CHECK_FALSE(PixelKernels::setISA(PixelKernels::ISA::COUNT));
+        CHECK(PixelKernels::getISA() == guard.isa);
+
+        for (auto isa : getSupportedISAs())
+        {
+            CHECK(PixelKernels::setISA(isa));
+            CHECK(PixelKernels::getISA() == isa);
+        }
+        MESSAGE(fmt::format("default pixel kernels: {}", PixelKernels::getISAName(guard.isa)));
+    }
+
+    TEST_CASE("premultiply_exhaustive")
+    {
+        ISAGuard guard;
+        const auto source = makeAllPairsRGBA8();
+
+        auto expectedRGBA = source;
+        referencePremultiplyRGBA8(expectedRGBA.data(), expectedRGBA.size() / 4);
+        std::vector<unsigned char> sourceRG(256 * 256 * 2);
+        for (int a = 0; a < 256; ++a)
+        {
+            for (int c = 0; c < 256; ++c)
+            {
+                sourceRG[(a * 256 + c) * 2]     = c;
+                sourceRG[(a * 256 + c) * 2 + 1] = a;
+            }
+        }
+        auto expectedRG = sourceRG;
+        referencePremultiplyRG8(expectedRG.data(), expectedRG.size() / 2);
+
+        for (auto isa : getSupportedISAs())
+        {
+            CAPTURE(PixelKernels::getISAName(isa));
+            PixelKernels::setISA(isa);
+
+            auto rgba = source;
+            PixelKernels::getKernels().premultiplyAlphaRGBA8(rgba.data(), rgba.size() / 4);
+            CHECK(rgba == expectedRGBA);
+
+            auto rg = sourceRG;
+            PixelKernels::getKernels().premultiplyAlphaRG8(rg.data(), rg.size() / 2);
+            CHECK(rg == expectedRG);
+        }
+    }
+
+    TEST_CASE("reverse_premultiplied_exhaustive")
+    {
+        ISAGuard guard;
+        const auto source = makeAllPairsRGBA8();
+        auto expected     = source;
+        referenceReversePremultipliedAlpha(expected.data(), expected.size() / 4);
+
+        for (auto isa : getSupportedISAs())
+        {
+            CAPTURE(PixelKernels::getISAName(isa));
+            PixelKernels::setISA(isa);
+
+            auto data = source;
+            PixelKernels::getKernels().reversePremultipliedAlphaRGBA8(data.data(), data.size() / 4);
+            CHECK(data == expected);
+        }
+    }
+
+    TEST_CASE("odd_lengths")
+    {
+        ISAGuard guard;
+        const auto source = makeRandomData(4 * 131 + 8);
+
+        // every size around the vector widths, at an unaligned offset
+        for (size_t pixels = 0; pixels <= 131; ++pixels)
+        {
+            auto expectedRGBA = source;
+            referencePremultiplyRGBA8(expectedRGBA.data() + 1, pixels);
+            auto expectedRG = source;
+            referencePremultiplyRG8(expectedRG.data() + 1, pixels);
+            auto expectedReverse = source;
+            referenceReversePremultipliedAlpha(expectedReverse.data() + 1, pixels);
+
+            for (auto isa : getSupportedISAs())
+            {
+                CAPTURE(PixelKernels::getISAName(isa));
+                CAPTURE(pixels);
+                PixelKernels::setISA(isa);
+                auto& kernels = PixelKernels::getKernels();
+
+                auto data = source;
+                kernels.premultiplyAlphaRGBA8(data.data() + 1, pixels);
+                CHECK(data == expectedRGBA);
+
+                data = source;
+                kernels.premultiplyAlphaRG8(data.data() + 1, pixels);
+                CHECK(data == expectedRG);
+
+                data = source;
+                kernels.reversePremultipliedAlphaRGBA8(data.data() + 1, pixels);
+                CHECK(data == expectedReverse);
+            }
+        }
+    }
+
+    TEST_CASE("converters")
+    {
+        ISAGuard guard;
+        const auto source = makeRandomData(4 * 131 + 8);
+        PixelKernels::setISA(PixelKernels::ISA::SCALAR);
+        const auto scalar = PixelKernels::getKernels();
+
+        for (auto& converter : s_converters)
+        {
+            for (size_t pixels = 0; pixels <= 131; ++pixels)
+            {
+                const size_t inLen = pixels * converter.inBpp;
+                // guard bytes past the end catch overruns
+                std::vector<unsigned char> expected(pixels * converter.outBpp + 16, 0xCD);
+                (scalar.*converter.func)(source.data() + 1, inLen, expected.data());
+
+                for (auto isa : getSupportedISAs())
+                {
+                    CAPTURE(PixelKernels::getISAName(isa));
+                    CAPTURE(converter.name);
+                    CAPTURE(pixels);
+                    PixelKernels::setISA(isa);
+
+                    std::vector<unsigned char> out(expected.size(), 0xCD);
+                    (PixelKernels::getKernels().*converter.func)(source.data() + 1, inLen, out.data());
+                    CHECK(out == expected);
+                }
+            }
+        }
+    }
+
+    TEST_CASE("benchmark")
+    {
+        ISAGuard guard;
+        const size_t pixels = 1024 * 1024;
+        const auto source   = makeRandomData(pixels * 4);
+        std::vector<unsigned char> data = source;
+        std::vector<unsigned char> out(pixels * 4);
+
+        for (auto isa : getSupportedISAs())
+        {
+            PixelKernels::setISA(isa);
+            auto& kernels = PixelKernels::getKernels();
+
+            auto premultiply = measureBytesPerSecond(data.size(), [&] {
+                data = source;
+                kernels.premultiplyAlphaRGBA8(data.data(), pixels);
+            });
+            auto reverse = measureBytesPerSecond(data.size(), [&] {
+                data = source;
+                kernels.reversePremultipliedAlphaRGBA8(data.data(), pixels);
+            });
+            auto swizzle = measureBytesPerSecond(
+                source.size(), [&] { kernels.convertBGRA8ToRGBA8(source.data(), source.size(), out.data()); });
+            auto pack565 = measureBytesPerSecond(
+                source.size(), [&] { kernels.convertRGBA8ToRGB565(source.data(), source.size(), out.data()); });
+            auto dropAlpha = measureBytesPerSecond(
+                source.size(), [&] { kernels.convertRGBA8ToRGB8(source.data(), source.size(), out.data()); });
+
+            MESSAGE(fmt::format(
+                "{}: premultiply {:.0f}MB/s, reverse premultiply {:.0f}MB/s, BGRA8->RGBA8 {:.0f}MB/s, "
+                "RGBA8->RGB565 {:.0f}MB/s, RGBA8->RGB8 {:.0f}MB/s",
+                PixelKernels::getISAName(isa), premultiply / 1e6, reverse / 1e6, swizzle / 1e6, pack565 / 1e6,
+                dropAlpha / 1e6));
+        }
+    }
+}
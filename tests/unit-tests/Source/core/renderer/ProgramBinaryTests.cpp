@@ -0,0 +1,116 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "renderer/backend/ProgramBinaryStore.h"
+#include "platform/FileUtils.h"
+
+using namespace ax;
+using namespace ax::backend;
+
+TEST_SUITE("renderer/ProgramBinary")
+{
+    TEST_CASE("file_store")
+    {
+        auto directory = FileUtils::getInstance()->getWritablePath() + "__test_programs";
+        ProgramBinaryFileStore store(directory);
+        CHECK_EQ(store.getDirectory(), directory + "/");
+
+        const uint64_t key = 0x0123456789abcdefULL;
+        std::vector<uint8_t> entry;
+        CHECK_FALSE(store.load(key, entry));
+
+        REQUIRE(store.save(key, {1, 2, 3, 4}));
+        REQUIRE(store.load(key, entry));
+        CHECK_EQ(entry, std::vector<uint8_t>{1, 2, 3, 4});
+
+        SUBCASE("replace")
+        {
+            REQUIRE(store.save(key, {5, 6}));
+            REQUIRE(store.load(key, entry));
+            CHECK_EQ(entry, std::vector<uint8_t>{5, 6});
+            CHECK_FALSE(FileUtils::getInstance()->isFileExist(store.getDirectory() + "0123456789abcdef.bin.tmp"));
+        }
+
+        SUBCASE("remove")
+        {
+            store.remove(key);
+            CHECK_FALSE(store.load(key, entry));
+            store.remove(key);  // no entry, no-op
+        }
+
+        FileUtils::getInstance()->removeDirectory(store.getDirectory());
+    }
+}
+
+#if defined(AX_ENABLE_NULL_DRIVER)
+#    include "renderer/backend/null/DriverNull.h"
+#    include "ProgramTestUtils.h"
+
+using namespace program_test;
+
+TEST_SUITE("renderer/ProgramBinary")
+{
+    TEST_CASE("null_driver")
+    {
+        DriverNull driver;
+        auto program = driver.newProgram(vertexShader, fragmentShader);
+        CHECK_EQ(driver.getStats().programCompiles, 1);
+
+        ProgramBinary binary;
+        REQUIRE(program->getBinary(binary));
+        CHECK_FALSE(binary.data.empty());
+
+        SUBCASE("unsupported")
+        {
+            CHECK_FALSE(driver.isProgramBinarySupported());
+            CHECK_EQ(driver.newProgram(vertexShader, fragmentShader, binary), nullptr);
+        }
+
+        SUBCASE("restore")
+        {
+            driver.setProgramBinarySupported(true);
+            auto restored = driver.newProgram(vertexShader, fragmentShader, binary);
+            REQUIRE(restored);
+            CHECK_EQ(driver.getStats().programBinaries, 1);
+            CHECK_EQ(restored->getAttributeLocation(Attribute::POSITION),
+                     program->getAttributeLocation(Attribute::POSITION));
+            restored->release();
+        }
+
+        SUBCASE("reject")
+        {
+            driver.setProgramBinarySupported(true);
+            CHECK_EQ(driver.newProgram(vertexShader, otherFragmentShader, binary), nullptr);
+
+            auto corrupted = binary;
+            corrupted.data[0] ^= 0xff;
+            CHECK_EQ(driver.newProgram(vertexShader, fragmentShader, corrupted), nullptr);
+            CHECK_EQ(driver.getStats().programBinaries, 0);
+        }
+
+        program->release();
+    }
+}
+#endif
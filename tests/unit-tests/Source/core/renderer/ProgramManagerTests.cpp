@@ -0,0 +1,374 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "renderer/backend/DriverBase.h"
+
+#if defined(AX_ENABLE_NULL_DRIVER)
+#    include <map>
+#    include <string.h>
+#    include "renderer/backend/ProgramManager.h"
+#    include "renderer/backend/null/DriverNull.h"
+#    include "renderer/backend/null/ProgramNull.h"
+#    include "platform/FileUtils.h"
+#    include "ProgramTestUtils.h"
+
+using namespace ax;
+using namespace ax::backend;
+using namespace program_test;
+
+namespace
+{
+// offsets of the fields of a store entry header, see ProgramManager::saveProgramBinary
+constexpr std::size_t kMagicOffset   = 0;
+constexpr std::size_t kVersionOffset = 4;
+constexpr std::size_t kKeyOffset     = 8;
+constexpr std::size_t kSizeOffset    = 28;
+constexpr std::size_t kHeaderSize    = 32;
+
+struct StoreEntries
+{
+    std::map<uint64_t, std::vector<uint8_t>> entries;
+    int removes = 0;
+};
+
+// keeps the entries in memory, outliving the managers which share them
+class MemoryProgramBinaryStore : public ProgramBinaryStore
+{
+public:
+    explicit MemoryProgramBinaryStore(StoreEntries& entries) : _entries(entries) {}
+
+    bool load(uint64_t key, std::vector<uint8_t>& entry) override
+    {
+        auto it = _entries.entries.find(key);
+        if (it == _entries.entries.end())
+            return false;
+        entry = it->second;
+        return true;
+    }
+
+    bool save(uint64_t key, const std::vector<uint8_t>& entry) override
+    {
+        _entries.entries[key] = entry;
+        return true;
+    }
+
+    void remove(uint64_t key) override
+    {
+        if (_entries.entries.erase(key))
+            ++_entries.removes;
+    }
+
+private:
+    StoreEntries& _entries;
+};
+
+class TestProgramManager : public ProgramManager
+{
+public:
+    explicit TestProgramManager(StoreEntries& entries)
+    {
+        setProgramBinaryStore(std::make_unique<MemoryProgramBinaryStore>(entries));
+    }
+
+    using ProgramManager::computeBinaryKey;
+    using ProgramManager::loadProgramBinary;
+    using ProgramManager::newProgram;
+    using ProgramManager::saveProgramBinary;
+};
+
+// the shader files of the custom programs, removed with the fixture
+struct ShaderFiles
+{
+    ShaderFiles()
+    {
+        auto fileUtils = FileUtils::getInstance();
+        auto directory = fileUtils->getWritablePath();
+        vsPath         = directory + "__test_program.vert";
+        fsPath         = directory + "__test_program.frag";
+        otherFsPath    = directory + "__test_program_other.frag";
+        fileUtils->writeStringToFile(vertexShader, vsPath);
+        fileUtils->writeStringToFile(fragmentShader, fsPath);
+        fileUtils->writeStringToFile(otherFragmentShader, otherFsPath);
+    }
+    ~ShaderFiles()
+    {
+        auto fileUtils = FileUtils::getInstance();
+        fileUtils->removeFile(vsPath);
+        fileUtils->removeFile(fsPath);
+        fileUtils->removeFile(otherFsPath);
+    }
+
+    std::string vsPath;
+    std::string fsPath;
+    std::string otherFsPath;
+};
+
+// the null driver with program binaries on, restored as it was when done
+struct NullDriverFixture
+{
+    NullDriverFixture()
+    {
+        REQUIRE(DriverBase::getDriverType() == DriverType::Null);
+        driver = static_cast<DriverNull*>(DriverBase::getInstance());
+        driver->setProgramBinarySupported(true);
+        driver->resetStats();
+    }
+    ~NullDriverFixture()
+    {
+        driver->setProgramBinarySupported(false);
+        driver->setProgramCompilesDeferred(false);
+    }
+
+    DriverNull* driver = nullptr;
+};
+
+void writeField(std::vector<uint8_t>& entry, std::size_t offset, uint32_t value)
+{
+    memcpy(entry.data() + offset, &value, sizeof(value));
+}
+}  // namespace
+
+TEST_SUITE("renderer/ProgramManager")
+{
+    TEST_CASE("binary_key")
+    {
+        NullDriverFixture fixture;
+        StoreEntries store;
+        TestProgramManager manager(store);
+
+        auto key = manager.computeBinaryKey(vertexShader, fragmentShader);
+        CHECK_EQ(manager.computeBinaryKey(vertexShader, fragmentShader), key);
+        CHECK_NE(manager.computeBinaryKey(vertexShader, otherFragmentShader), key);
+        CHECK_NE(manager.computeBinaryKey(fragmentShader, vertexShader), key);
+        // moving text from one source to the other changes the key
+        CHECK_NE(manager.computeBinaryKey("ab"sv, "c"sv), manager.computeBinaryKey("a"sv, "bc"sv));
+    }
+
+    TEST_CASE("load_binary")
+    {
+        NullDriverFixture fixture;
+        StoreEntries store;
+        TestProgramManager manager(store);
+
+        auto key     = manager.computeBinaryKey(vertexShader, fragmentShader);
+        auto program = fixture.driver->newProgram(vertexShader, fragmentShader);
+        manager.saveProgramBinary(key, program);
+        program->release();
+        REQUIRE_EQ(store.entries.size(), 1);
+        CHECK_EQ(manager.getStats().binarySaved, 1);
+
+        ProgramBinary expected;
+        ProgramNull::makeBinary(vertexShader, fragmentShader, expected);
+        ProgramBinary binary;
+        REQUIRE(manager.loadProgramBinary(key, binary));
+        CHECK_EQ(binary.format, expected.format);
+        CHECK_EQ(binary.data, expected.data);
+        CHECK_EQ(manager.getStats().binaryRejected, 0);
+
+        auto& entry = store.entries[key];
+        CHECK_EQ(entry.size(), kHeaderSize + expected.data.size());
+
+        // each corrupted entry is rejected and removed from the store
+        SUBCASE("magic") { writeField(entry, kMagicOffset, 0x12345678); }
+        SUBCASE("version") { writeField(entry, kVersionOffset, 0); }
+        SUBCASE("key") { entry[kKeyOffset] ^= 0xff; }
+        SUBCASE("size") { writeField(entry, kSizeOffset, static_cast<uint32_t>(expected.data.size() + 1)); }
+        SUBCASE("truncated") { entry.pop_back(); }
+        SUBCASE("header_only") { entry.resize(kHeaderSize); }
+        SUBCASE("checksum") { entry.back() ^= 0xff; }
+
+        CHECK_FALSE(manager.loadProgramBinary(key, binary));
+        CHECK_EQ(manager.getStats().binaryRejected, 1);
+        CHECK_EQ(store.removes, 1);
+        CHECK(store.entries.empty());
+
+        // no entry is a miss, not a rejection
+        CHECK_FALSE(manager.loadProgramBinary(key, binary));
+        CHECK_EQ(manager.getStats().binaryRejected, 1);
+    }
+
+    TEST_CASE("binary_cache")
+    {
+        NullDriverFixture fixture;
+        ShaderFiles files;
+        StoreEntries store;
+        auto driver = fixture.driver;
+
+        {
+            TestProgramManager manager(store);
+            REQUIRE(manager.loadProgram(files.vsPath, files.fsPath));
+            CHECK_EQ(manager.getStats().binaryMisses, 1);
+            CHECK_EQ(manager.getStats().binarySaved, 1);
+            CHECK_EQ(driver->getStats().programCompiles, 1);
+            CHECK_EQ(store.entries.size(), 1);
+        }
+        auto key = store.entries.begin()->first;
+
+        SUBCASE("hit")
+        {
+            // a later launch restores the program instead of compiling it
+            TestProgramManager manager(store);
+            auto program = manager.loadProgram(files.vsPath, files.fsPath);
+            REQUIRE(program);
+            CHECK_EQ(manager.getStats().binaryHits, 1);
+            CHECK_EQ(manager.getStats().binaryMisses, 0);
+            CHECK_EQ(manager.getStats().binarySaved, 0);
+            CHECK_EQ(driver->getStats().programBinaries, 1);
+            CHECK_EQ(driver->getStats().programCompiles, 1);
+            CHECK(program->getAttributeLocation(Attribute::POSITION) >= 0);
+        }
+
+        SUBCASE("corrupted")
+        {
+            store.entries[key].back() ^= 0xff;
+            TestProgramManager manager(store);
+            REQUIRE(manager.loadProgram(files.vsPath, files.fsPath));
+            CHECK_EQ(manager.getStats().binaryRejected, 1);
+            CHECK_EQ(manager.getStats().binaryMisses, 1);
+            CHECK_EQ(store.removes, 1);
+            CHECK_EQ(driver->getStats().programCompiles, 2);
+
+            // compiled again and saved in place of the corrupted entry
+            CHECK_EQ(manager.getStats().binarySaved, 1);
+            ProgramBinary binary;
+            CHECK(manager.loadProgramBinary(key, binary));
+        }
+
+        SUBCASE("stale_version")
+        {
+            // written by another engine version
+            writeField(store.entries[key], kVersionOffset, 0);
+            TestProgramManager manager(store);
+            REQUIRE(manager.loadProgram(files.vsPath, files.fsPath));
+            CHECK_EQ(manager.getStats().binaryHits, 0);
+            CHECK_EQ(manager.getStats().binaryRejected, 1);
+            CHECK_EQ(store.removes, 1);
+            CHECK_EQ(driver->getStats().programCompiles, 2);
+            CHECK_EQ(driver->getStats().programBinaries, 0);
+            CHECK_EQ(manager.getStats().binarySaved, 1);
+        }
+
+        SUBCASE("rejected_by_driver")
+        {
+            // a valid entry the driver no longer accepts, i.e. after a driver update
+            TestProgramManager manager(store);
+            auto other = driver->newProgram(vertexShader, otherFragmentShader);
+            manager.saveProgramBinary(key, other);
+            other->release();
+            driver->resetStats();
+
+            uint64_t binaryKey = 0;
+            auto program       = manager.newProgram(vertexShader, fragmentShader, false, binaryKey);
+            REQUIRE(program);
+            CHECK_EQ(binaryKey, key);
+            CHECK_EQ(manager.getStats().binaryRejected, 1);
+            CHECK_EQ(manager.getStats().binaryMisses, 1);
+            CHECK_EQ(manager.getStats().binaryHits, 0);
+            CHECK_EQ(store.removes, 1);
+            CHECK(store.entries.empty());
+            CHECK_EQ(driver->getStats().programCompiles, 1);
+            program->release();
+        }
+
+        SUBCASE("unsupported")
+        {
+            driver->setProgramBinarySupported(false);
+            TestProgramManager manager(store);
+            uint64_t binaryKey = 1;
+            auto program       = manager.newProgram(vertexShader, fragmentShader, false, binaryKey);
+            REQUIRE(program);
+            CHECK_EQ(binaryKey, 0);
+            CHECK_EQ(manager.getStats().binaryHits, 0);
+            CHECK_EQ(manager.getStats().binaryMisses, 0);
+            program->release();
+        }
+    }
+
+    TEST_CASE("precompile")
+    {
+        NullDriverFixture fixture;
+        ShaderFiles files;
+        StoreEntries store;
+        auto driver = fixture.driver;
+        TestProgramManager manager(store);
+
+        const uint64_t progIds[] = {manager.registerCustomProgram(files.vsPath, files.fsPath),
+                                    manager.registerCustomProgram(files.vsPath, files.otherFsPath)};
+        REQUIRE(progIds[0] != 0);
+        REQUIRE(progIds[1] != 0);
+
+        driver->setProgramCompilesDeferred(true);
+        manager.precompilePrograms(progIds);
+        CHECK_EQ(driver->getStats().programCompiles, 2);
+        CHECK_EQ(manager.pollPrograms(), 2);
+        CHECK_FALSE(manager.isProgramReady(progIds[0]));
+        CHECK_FALSE(manager.isProgramReady(progIds[1]));
+        CHECK_EQ(manager.getStats().asyncCompiled, 0);
+        CHECK(store.entries.empty());
+
+        // precompiling again doesn't start another compile
+        manager.precompilePrograms(progIds);
+        CHECK_EQ(driver->getStats().programCompiles, 2);
+
+        // loading a pending program waits for it
+        auto first = manager.loadProgram(progIds[0]);
+        REQUIRE(first);
+        CHECK(first->isCompileCompleted());
+        CHECK(manager.isProgramReady(progIds[0]));
+        CHECK_EQ(manager.getStats().asyncCompiled, 1);
+        CHECK_EQ(manager.getStats().binarySaved, 1);
+        CHECK_EQ(manager.pollPrograms(), 1);
+
+        // the driver finishes the other one
+        driver->setProgramCompilesDeferred(false);
+        CHECK(manager.isProgramReady(progIds[1]));
+        CHECK_EQ(manager.pollPrograms(), 0);
+        CHECK_EQ(manager.getStats().asyncCompiled, 2);
+        CHECK_EQ(manager.getStats().binarySaved, 2);
+        CHECK_EQ(store.entries.size(), 2);
+
+        auto second = manager.loadProgram(progIds[1]);
+        REQUIRE(second);
+        CHECK_EQ(static_cast<uint64_t>(second->getProgramId()), progIds[1]);
+        CHECK_EQ(manager.loadProgram(progIds[0]), first);
+        CHECK_EQ(driver->getStats().programCompiles, 2);
+
+        SUBCASE("cached_binary")
+        {
+            // programs with a binary are restored right away, even while compiles are deferred
+            TestProgramManager restored(store);
+            REQUIRE_EQ(restored.registerCustomProgram(files.vsPath, files.fsPath), progIds[0]);
+            REQUIRE_EQ(restored.registerCustomProgram(files.vsPath, files.otherFsPath), progIds[1]);
+            driver->setProgramCompilesDeferred(true);
+            restored.precompilePrograms(progIds);
+            CHECK_EQ(restored.pollPrograms(), 0);
+            CHECK(restored.isProgramReady(progIds[0]));
+            CHECK(restored.isProgramReady(progIds[1]));
+            CHECK_EQ(restored.getStats().binaryHits, 2);
+            CHECK_EQ(driver->getStats().programCompiles, 2);
+        }
+    }
+}
+#endif
@@ -0,0 +1,122 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "renderer/backend/DriverBase.h"
+
+#if defined(AX_ENABLE_NULL_DRIVER)
+#    include "renderer/backend/null/ProgramNull.h"
+
+using namespace ax::backend;
+
+namespace
+{
+constexpr auto vertexShader = R"(#version 310 es
+layout(location = 0) in vec4 a_position;
+layout(location = 2) in vec2 a_texCoord;
+in vec4 a_color;
+
+layout(location = 0) out vec2 v_texCoord;
+
+layout(std140) uniform vs_ub {
+    mat4 u_MVPMatrix;
+    vec3 u_offset;  // vec3 is 16 bytes aligned
+    float u_time;   // packed into the vec3 tail
+    vec2 u_weights[3];
+};
+
+void main()
+{
+    /* a { block } inside function bodies must be skipped */
+    if (u_time > 0.0) { v_texCoord = a_texCoord; }
+    gl_Position = u_MVPMatrix * a_position;
+}
+)"sv;
+
+constexpr auto fragmentShader = R"(#version 310 es
+precision highp float;
+layout(location = 0) in vec2 v_texCoord;
+layout(location = 0) out vec4 FragColor;
+
+layout(std140) uniform fs_ub {
+    vec4 u_textColor;
+};
+
+uniform sampler2D u_tex0;
+uniform sampler2D u_tex1;
+
+void main()
+{
+    FragColor = texture(u_tex0, v_texCoord) * u_textColor;
+}
+)"sv;
+
+int bufferOffset(const UniformLocation& location)
+{
+#if AX_GLES_PROFILE != 200
+    return location.vertStage.location + location.vertStage.offset;
+#else
+    return location.vertStage.offset;
+#endif
+}
+}  // namespace
+
+TEST_SUITE("renderer/ProgramNull")
+{
+    TEST_CASE("reflection")
+    {
+        auto program = new ProgramNull(vertexShader, fragmentShader);
+
+        SUBCASE("attributes")
+        {
+            CHECK_EQ(program->getActiveAttributes().size(), 3);
+            CHECK_EQ(program->getAttributeLocation(Attribute::POSITION), 0);
+            CHECK_EQ(program->getAttributeLocation(Attribute::TEXCOORD), 2);
+            CHECK_EQ(program->getAttributeLocation(Attribute::COLOR), 3);
+            CHECK_EQ(program->getAttributeLocation(Attribute::NORMAL), -1);
+            CHECK_EQ(program->getAttributeLocation("v_texCoord"), -1);
+        }
+
+        SUBCASE("std140_uniform_blocks")
+        {
+            CHECK_EQ(program->getUniformBufferSize(ShaderStage::VERTEX), 144);
+            CHECK_EQ(bufferOffset(program->getUniformLocation(Uniform::MVP_MATRIX)), 0);
+            CHECK_EQ(bufferOffset(program->getUniformLocation("u_offset")), 64);
+            CHECK_EQ(bufferOffset(program->getUniformLocation("u_time")), 76);
+            CHECK_EQ(bufferOffset(program->getUniformLocation("u_weights")), 80);
+            CHECK_EQ(bufferOffset(program->getUniformLocation(Uniform::TEXT_COLOR)), 128);
+            CHECK_FALSE(program->getUniformLocation("u_unknown"));
+        }
+
+        SUBCASE("samplers")
+        {
+            CHECK_EQ(program->getUniformLocation(Uniform::TEXTURE).vertStage.location, 0);
+            CHECK_EQ(program->getUniformLocation(Uniform::TEXTURE1).vertStage.location, 1);
+            CHECK_FALSE(program->getUniformLocation(Uniform::TEXTURE2));
+        }
+
+        program->release();
+    }
+}
+#endif
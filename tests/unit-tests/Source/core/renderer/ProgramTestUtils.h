@@ -0,0 +1,58 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <string_view>
+
+namespace program_test
+{
+// a minimal program, the drivers only compare the sources
+inline constexpr std::string_view vertexShader = R"(#version 310 es
+layout(location = 0) in vec4 a_position;
+void main()
+{
+    gl_Position = a_position;
+}
+)";
+
+inline constexpr std::string_view fragmentShader = R"(#version 310 es
+precision highp float;
+layout(location = 0) out vec4 FragColor;
+void main()
+{
+    FragColor = vec4(1.0);
+}
+)";
+
+// differs from fragmentShader, so it makes another program
+inline constexpr std::string_view otherFragmentShader = R"(#version 310 es
+precision highp float;
+layout(location = 0) out vec4 FragColor;
+void main()
+{
+    FragColor = vec4(0.5);
+}
+)";
+}  // namespace program_test
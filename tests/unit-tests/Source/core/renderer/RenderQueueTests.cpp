@@ -0,0 +1,141 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "renderer/Renderer.h"
+#include "renderer/TrianglesCommand.h"
+#include "math/FastRNG.h"
+
+USING_NS_AX;
+
+namespace
+{
+class TestCommand : public TrianglesCommand
+{
+public:
+    TestCommand(float globalOrder, uint32_t materialID, float depth = 0.f)
+    {
+        _globalOrder = globalOrder;
+        _materialID  = materialID;
+        _depth       = depth;
+        _is3D        = depth != 0.f;
+    }
+};
+
+// Any command which isn't a batchable TrianglesCommand
+class BarrierCommand : public RenderCommand
+{
+public:
+    BarrierCommand() { _type = RenderCommand::Type::CALLBACK_COMMAND; }
+};
+
+std::vector<RenderCommand*> subQueue(RenderQueue& queue, RenderQueue::QUEUE_GROUP group)
+{
+    return queue.getSubQueue(group);
+}
+}  // namespace
+
+TEST_SUITE("renderer/RenderQueue")
+{
+    TEST_CASE("sort")
+    {
+        FastRNG rng;
+        std::vector<std::unique_ptr<TestCommand>> commands;
+        RenderQueue queue;
+
+        SUBCASE("global_z")
+        {
+            // enough commands for the radix sort
+            for (int i = 0; i < 1000; ++i)
+            {
+                float z = float(rng.range(-4, 4));
+                commands.emplace_back(std::make_unique<TestCommand>(z == 0 ? 0.5f : z, rng.range(1, 5)));
+                queue.emplace_back(commands.back().get());
+            }
+
+            auto expectedNeg = subQueue(queue, RenderQueue::GLOBALZ_NEG);
+            auto expectedPos = subQueue(queue, RenderQueue::GLOBALZ_POS);
+            auto byGlobalZ   = [](RenderCommand* a, RenderCommand* b) { return a->getGlobalOrder() < b->getGlobalOrder(); };
+            std::stable_sort(expectedNeg.begin(), expectedNeg.end(), byGlobalZ);
+            std::stable_sort(expectedPos.begin(), expectedPos.end(), byGlobalZ);
+
+            queue.sort();
+            CHECK(subQueue(queue, RenderQueue::GLOBALZ_NEG) == expectedNeg);
+            CHECK(subQueue(queue, RenderQueue::GLOBALZ_POS) == expectedPos);
+        }
+
+        SUBCASE("depth")
+        {
+            for (int i = 0; i < 200; ++i)
+            {
+                commands.emplace_back(std::make_unique<TestCommand>(0.f, 1, -rng.rangef(1.f, 100.f)));
+                queue.emplace_back(commands.back().get());
+            }
+
+            queue.sort();
+            auto& sorted = queue.getSubQueue(RenderQueue::TRANSPARENT_3D);
+            REQUIRE_EQ(sorted.size(), 200);
+            for (size_t i = 1; i < sorted.size(); ++i)
+                CHECK_GE(sorted[i - 1]->getDepth(), sorted[i]->getDepth());
+        }
+
+        SUBCASE("by_material")
+        {
+            BarrierCommand barrier;
+
+            const uint32_t materials[] = {1, 2, 1, 2, 3, 1, 2};
+            for (auto material : materials)
+            {
+                commands.emplace_back(std::make_unique<TestCommand>(0.f, material));
+                queue.emplace_back(commands.back().get());
+            }
+            queue.emplace_back(&barrier);
+            for (auto material : materials)
+            {
+                commands.emplace_back(std::make_unique<TestCommand>(0.f, material));
+                queue.emplace_back(commands.back().get());
+            }
+
+            auto unsorted = subQueue(queue, RenderQueue::GLOBALZ_ZERO);
+            queue.sort();
+            CHECK(subQueue(queue, RenderQueue::GLOBALZ_ZERO) == unsorted);
+
+            queue.sort(true);
+            auto& sorted = queue.getSubQueue(RenderQueue::GLOBALZ_ZERO);
+            REQUIRE_EQ(sorted.size(), 15);
+            CHECK_EQ(sorted[7], &barrier);
+
+            // 3 batches on each side of the barrier, in submission order within a material
+            const uint32_t expected[] = {1, 1, 1, 2, 2, 2, 3};
+            for (int i = 0; i < 7; ++i)
+            {
+                CHECK_EQ(static_cast<TrianglesCommand*>(sorted[i])->getMaterialID(), expected[i]);
+                CHECK_EQ(static_cast<TrianglesCommand*>(sorted[i + 8])->getMaterialID(), expected[i]);
+            }
+            CHECK_EQ(sorted[0], commands[0].get());
+            CHECK_EQ(sorted[1], commands[2].get());
+            CHECK_EQ(sorted[2], commands[5].get());
+        }
+    }
+}
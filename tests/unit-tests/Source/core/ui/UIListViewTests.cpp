@@ -0,0 +1,188 @@
+/****************************************************************************
+
+Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+https://axmol.dev/
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#include <doctest.h>
+#include "ui/UIListView.h"
+
+USING_NS_AX;
+using namespace ax::ui;
+
+namespace
+{
+class RowSource : public ListViewDataSource
+{
+public:
+    explicit RowSource(ssize_t rows) : rows(rows) {}
+
+    ssize_t numberOfItemsInListView(ListView*) override { return rows; }
+    float itemSizeForIndex(ListView*, ssize_t idx) override { return idx % 3 == 0 ? 60.0f : 30.0f; }
+    Widget* itemAtIndex(ListView* listView, ssize_t idx) override
+    {
+        Widget* item = listView->dequeueItem();
+        if (!item)
+        {
+            item = Widget::create();
+            ++created;
+        }
+        item->setContentSize(Vec2(100, itemSizeForIndex(listView, idx)));
+        return item;
+    }
+    void itemWillRecycle(ListView*, ssize_t, Widget*) override { ++recycled; }
+
+    ssize_t rows;
+    int created  = 0;
+    int recycled = 0;
+};
+
+RefPtr<ListView> createListView()
+{
+    RefPtr<ListView> listView = ListView::create();
+    listView->setContentSize(Vec2(200, 300));
+    listView->setItemsMargin(5);
+    listView->setPadding(4, 6, 8, 10);
+    listView->setGravity(ListView::Gravity::CENTER_HORIZONTAL);
+    return listView;
+}
+}  // namespace
+
+TEST_SUITE("ui/ListView")
+{
+    TEST_CASE("virtualized_like_regular")
+    {
+        RowSource source(20);
+        auto regular = createListView();
+        for (ssize_t i = 0; i < source.rows; ++i)
+            regular->pushBackCustomItem(source.itemAtIndex(regular, i));
+        regular->forceDoLayout();
+
+        auto virtualized = createListView();
+        virtualized->setPreloadRatio(10.0f);
+        virtualized->setDataSource(&source);
+        virtualized->reloadData();
+
+        CHECK_EQ(virtualized->getInnerContainerSize(), regular->getInnerContainerSize());
+        CHECK_EQ(virtualized->getInnerContainer()->getChildrenCount(), source.rows);
+        for (ssize_t i = 0; i < source.rows; ++i)
+        {
+            CAPTURE(i);
+            REQUIRE(virtualized->getItem(i) != nullptr);
+            CHECK_EQ(virtualized->getIndex(virtualized->getItem(i)), i);
+            CHECK(virtualized->getItem(i)->getPosition().x == doctest::Approx(regular->getItem(i)->getPosition().x));
+            CHECK(virtualized->getItem(i)->getPosition().y == doctest::Approx(regular->getItem(i)->getPosition().y));
+        }
+        CHECK(virtualized->getItems().empty());
+    }
+
+    TEST_CASE("items_stay_flat")
+    {
+        for (ssize_t rows : {100, 10000, 100000})
+        {
+            CAPTURE(rows);
+            RowSource source(rows);
+            auto listView = createListView();
+            listView->setDataSource(&source);
+            listView->reloadData();
+
+            // 300 points in view and 150 preloaded on both ends, rows of 35 points at least
+            const ssize_t maxItems = 600 / 35 + 2;
+            CHECK(listView->getInnerContainer()->getChildrenCount() <= maxItems);
+
+            for (ssize_t index : {rows / 2, rows - 1, ssize_t{0}, rows / 3})
+            {
+                CAPTURE(index);
+                listView->jumpToItem(index, Vec2::ANCHOR_MIDDLE, Vec2::ANCHOR_MIDDLE);
+                listView->doLayout();
+                CHECK(listView->getInnerContainer()->getChildrenCount() <= maxItems);
+                REQUIRE(listView->getItem(index) != nullptr);
+            }
+
+            // an item away from both ends lands in the middle of the view
+            Widget* item = listView->getItem(rows / 3);
+            CHECK(item->getPosition().y + listView->getInnerContainerPosition().y == doctest::Approx(150.0f));
+
+            for (int percent = 0; percent <= 100; percent += 5)
+            {
+                listView->jumpToPercentVertical(static_cast<float>(percent));
+                listView->doLayout();
+            }
+            // items scrolled out of view were reused
+            CHECK(source.created <= 2 * maxItems);
+            CHECK(source.recycled > 0);
+        }
+    }
+
+    TEST_CASE("virtualized_items_in_current_view")
+    {
+        RowSource source(20);
+        auto regular = createListView();
+        for (ssize_t i = 0; i < source.rows; ++i)
+            regular->pushBackCustomItem(source.itemAtIndex(regular, i));
+        regular->forceDoLayout();
+
+        auto virtualized = createListView();
+        virtualized->setDataSource(&source);
+        virtualized->reloadData();
+
+        for (ssize_t index = 0; index < source.rows; ++index)
+        {
+            CAPTURE(index);
+            regular->jumpToItem(index, Vec2::ANCHOR_MIDDLE, Vec2::ANCHOR_MIDDLE);
+            virtualized->jumpToItem(index, Vec2::ANCHOR_MIDDLE, Vec2::ANCHOR_MIDDLE);
+            virtualized->doLayout();
+
+            REQUIRE(virtualized->getCenterItemInCurrentView() != nullptr);
+            CHECK_EQ(virtualized->getIndex(virtualized->getCenterItemInCurrentView()),
+                     regular->getIndex(regular->getCenterItemInCurrentView()));
+            REQUIRE(virtualized->getTopmostItemInCurrentView() != nullptr);
+            CHECK_EQ(virtualized->getIndex(virtualized->getTopmostItemInCurrentView()),
+                     regular->getIndex(regular->getTopmostItemInCurrentView()));
+            REQUIRE(virtualized->getBottommostItemInCurrentView() != nullptr);
+            CHECK_EQ(virtualized->getIndex(virtualized->getBottommostItemInCurrentView()),
+                     regular->getIndex(regular->getBottommostItemInCurrentView()));
+        }
+
+        // an item away from both ends is centered by jumpToItem
+        virtualized->jumpToItem(10, Vec2::ANCHOR_MIDDLE, Vec2::ANCHOR_MIDDLE);
+        virtualized->doLayout();
+        CHECK_EQ(virtualized->getIndex(virtualized->getCenterItemInCurrentView()), 10);
+    }
+
+    TEST_CASE("leave_virtualized_mode")
+    {
+        RowSource source(1000);
+        auto listView = createListView();
+        listView->setDataSource(&source);
+        listView->reloadData();
+        CHECK(listView->getInnerContainer()->getChildrenCount() > 0);
+
+        listView->setDataSource(nullptr);
+        CHECK_EQ(listView->getInnerContainer()->getChildrenCount(), 0);
+        listView->pushBackCustomItem(Widget::create());
+        listView->forceDoLayout();
+        CHECK_EQ(listView->getItems().size(), 1);
+        CHECK_EQ(listView->getLayoutType(), Layout::Type::VERTICAL);
+    }
+}